@@ -156,6 +156,12 @@ NvBootSeRsaPssSignatureVerify(NvU8 RsaKeySlot, NvU32 RsaKeySizeBits, NvU32 *pInp
  * Note: While the CMAC algorithm supports AES key sizes of 128, 192, or
  * 256-bits, the subkeys K1 and K2 are always equal to the AES block size
  * which is 128-bits.
+ *
+ * Note: K1 is cached per key slot, so only the first call for a key slot
+ * uses the SE. The entry is dropped when the key of the slot is written
+ * through NvBootSeKeySlotWriteKeyIV() or NvBootSeAesDecryptKeyIntoKeySlot().
+ * On a cache hit the IVs of the key slot are left as they are, which is
+ * fine for NvBootSeAesCmacHashBlocks() as it clears them on FirstChunk.
  */
 void NvBootSeAesCmacGenerateSubkey (
         NvU8 KeySlot,
@@ -163,6 +169,14 @@ void NvBootSeAesCmacGenerateSubkey (
         NvU32 *pK1,
         NvU32 *pK2);
 
+/**
+ * Forget the AES-CMAC subkeys cached by NvBootSeAesCmacGenerateSubkey().
+ *
+ * Called when the SE is reset, and before the Boot ROM exits so that no
+ * subkey derived from the SBK is left in IRAM.
+ */
+void NvBootSeAesCmacClearSubkeyCache(void);
+
 /**
  * AES-CMAC hash AES-block size chunks of data.
  *
@@ -37,6 +37,12 @@ extern "C"
  */
 enum {NVBOOT_USB_MAX_TXFR_SIZE_BYTES = 4096};
 
+/*
+ * Maximum data received by one NvBootUsbfReceiveStart() on the Bulk OUT
+ * endpoint. The receive is primed once, as a chain of DTDs.
+ */
+enum {NVBOOT_USB_MAX_RECEIVE_SIZE_BYTES = 65536};
+
 /*
  * USB buffers alignment is 4K Bytes and this must be allocated in IRAM
  */
@@ -318,8 +324,11 @@ NvBootUsbfReceive(
  *           refer to the ep status codes.
  *
  * @param pDataBuf pointer to a memory buffer into which data
- *        from the host will be stored. This buffer must be 4K bytes in IRAM 
- 8        and must be aligned to 4K bytes.
+ *        from the host will be stored. This buffer must be in IRAM but
+ *        need not be aligned; up to NVBOOT_USB_MAX_RECEIVE_SIZE_BYTES are
+ *        received per call, as one prime of a chain of DTDs. A chain of
+ *        more than one DTD takes whole packets only, so a request above
+ *        one DTD may complete short of a packet; receive the rest next.
  * @param ReceiveSizeBytes Contains the maximum number of
  *        bytes that can be stored in pDatabuf. 
  *
@@ -524,6 +524,9 @@ NvBootMainConfigureAesEnginesForExit( NvBool IsWarmBoot0 )
     // redundant but there is no harm in doing so.
     NvBootSeLockSbk();
 
+    // Do not leave the AES-CMAC subkeys of the SBK and SSK behind in IRAM.
+    NvBootSeAesCmacClearSubkeyCache();
+
     // Handle SE engine disables.  For WarmBoot, restore the disable state
     // recored in the PMC register.  For all others, clear the PMC disable
     // bit.
@@ -46,6 +46,8 @@ typedef struct NvBootRcmStateRec
     NvU8                    DecryptionKeySlotNum;
     NvU8                    CMACHashKeySlotNum;
     NvBool                  FirstMessageProcessed;
+    NvBool                  IsHashStreaming; /* CMAC fed during receive */
+    NvU32                   HashedBlocks; /* AES blocks fed to the CMAC */
 } NvBootRcmState;
 
 typedef struct NvBootRcmSeInputLinkedListRec
@@ -86,6 +88,8 @@ NV_CT_ASSERT((sizeof(NvBootRcmMsg) - offsetof(NvBootRcmMsg, RandomAesBlock) & 0x
 static NvBootRcmState s_State;
 static NvBootRcmMsg   s_Msg;
 static NvBootRcmSeInputLinkedList   s_SeInputLL;
+static NvU32          s_CmacK1[NVBOOT_SE_AES_BLOCK_LENGTH];
+static NvU32          s_CmacK2[NVBOOT_SE_AES_BLOCK_LENGTH];
 
 static void        CompressRcmVersion(NvU32 OriginalVersion, NvU16 *CompressedVersion);
 static NvBootError SendUniqueId(void);
@@ -93,6 +97,9 @@ static NvBootError SendResponse(NvU32 Response);
 static void        HandleError(NvU32 Response);
 static NvBool      IsEntryPointWithinPayload(void);
 static NvBootError ReceiveMessage(void);
+static NvBool      CanStreamHash(void);
+static void        HashStart(void);
+static void        HashBlocks(NvU32 BlocksReady, NvBool Last);
 static void        ComputeHash(void);
 static void        Decrypt(void);
 static NvBootError Validate(void);
@@ -237,43 +244,101 @@ IsEntryPointWithinPayload(void)
 
 /**
  * Begin by storing the received data into the header structure.
- * Once the header is complete, the remaining data fills the 96KB starting at
- * 0x40008000.
+ * Once the header is complete, the remaining data fills the payload area
+ * starting at NVBOOT_RCM_DLOAD_BASE_ADDRESS.
+ *
+ * Until the header is complete, each USB read lands in the bounce buffer and
+ * is copied out, splitting the read at the header/payload boundary.  Every
+ * read after that is primed directly on the payload area, so payload bytes
+ * are written once by the USB controller and never copied.  Direct reads
+ * never request more than the bytes left in the message, so the controller
+ * cannot write past the end of the message.  Each direct read asks for up
+ * to NVBOOT_USB_MAX_RECEIVE_SIZE_BYTES, which the port primes only once.
+ *
+ * When the CMAC key is already settled by the header, the CMAC is fed to the
+ * SE as the payload lands, so the SE hashes one read while the host sends
+ * the next.  The last block is always left for ComputeHash().
  *
  * Notes:
- *   BytesLeftInMessage refers to data remaining to be copied.
+ *   BytesLeftInMessage refers to data remaining to be received.
  *   BytesRead counts the amount of data that has been read from USB.
- *   ReadFromPort is true on all cycles of the while() loop where there is
- *     reading from USB.
+ *   IsDirect is true on all cycles of the while() loop where the read
+ *     targets the payload area rather than the bounce buffer.
  */
 static NvBootError ReceiveMessage(void)
 {
     NvU32        BytesLeftInMessage = NVBOOT_RCM_MIN_MSG_LENGTH;
     NvU32        TotalBytesReceived = 0;
     NvBool       IsDefaultLength    = NV_TRUE;
-    NvBool       ReadFromPort;
+    NvBool       IsDirect;
     NvU32        BytesRead          = 0;
     NvU32        BytesToCopy;
     NvU8        *Dst                = (NvU8*)&s_Msg;
     NvU8        *Src;
+    NvU32        Offset; /* to the start of the hashed area of the message */
     NvBootError  e;
     NvBootRCMPort_T *pRcmPort = NvBootRcmGetPortHandle();
 
+    Offset = (NvU8*)&(s_Msg.RandomAesBlock) - (NvU8*)&s_Msg;
+    s_State.IsHashStreaming = NV_FALSE;
+
     while (BytesLeftInMessage > 0)
     {
-        /* Swap buffers */
-        s_State.BufferIndex ^= 1;
+        /* Once the header is in s_Msg, receive straight into the payload. */
+        IsDirect = (TotalBytesReceived >= sizeof(NvBootRcmMsg));
 
-        /* Initiate read from USB if more data is expected */
-        ReadFromPort = (BytesLeftInMessage > BytesRead);
-        if (ReadFromPort)
+        if (IsDirect)
+            pRcmPort->ReceiveStart(Dst, NV_MIN(BytesLeftInMessage,
+                                               NVBOOT_USB_MAX_RECEIVE_SIZE_BYTES));
+        else
             pRcmPort->ReceiveStart(Buffer[s_State.BufferIndex],
                                    NVBOOT_BUFFER_LENGTH);
 
+        /* Spin wait for USB read to complete */
+        /* Note: Timeout value is not used by Synopsys driver.
+         * Setting a high value for future RCM ports.
+         * The buffer passed is used by Synopsys driver for pending control transfers.
+         * Going forward, RCM ports should use internal resources for this purpose.
+         */
+        e = pRcmPort->ReceivePoll(&BytesRead, 0xFFFFFFFF,Buffer[s_State.BufferIndex]);
+        if ( e == NvBootError_EpNotConfigured)
+        {
+            // Endpoint will be un-configured only it reset occurs,
+            // If reset occurs, need do re-enumearation
+            return e;
+        }
+        else if (e != NvBootError_Success)
+        {
+            HandleError(NvBootRcmResponse_UsbError);
+            return e;
+        }
+
+        if (IsDirect)
+        {
+            /* The data is already in place; only account for it. */
+            if (BytesRead > BytesLeftInMessage)
+            {
+                HandleError(NvBootRcmResponse_XferOverflow);
+                return NvBootError_ValidationFailure;
+            }
+
+            Dst                += BytesRead;
+            TotalBytesReceived += BytesRead;
+            BytesLeftInMessage -= BytesRead;
+
+            /* Feed the new blocks unless the SE is still on the last ones. */
+            if (s_State.IsHashStreaming && !NvBootSeIsEngineBusy())
+            {
+                HashBlocks((TotalBytesReceived - Offset) >>
+                           NVBOOT_SE_AES_BLOCK_LENGTH_LOG2,
+                           NV_FALSE);
+            }
+            continue;
+        }
+
         /* Process the buffer that completed. */
-        Src = Buffer[s_State.BufferIndex ^ 1];
+        Src = Buffer[s_State.BufferIndex];
 
-        /* Copy data into the destination(s) */
         if ((BytesRead > 0) &&
             (TotalBytesReceived < sizeof(NvBootRcmMsg)))
         {
@@ -293,7 +358,7 @@ static NvBootError ReceiveMessage(void)
 
             if (TotalBytesReceived == sizeof(NvBootRcmMsg))
             {
-                /* Switch to storing data in the 224KB of iRAM */
+                /* Switch to storing data in the payload area of iRAM */
                 Dst = (NvU8*)(NVBOOT_RCM_DLOAD_BASE_ADDRESS);
             }
 
@@ -310,9 +375,16 @@ static NvBootError ReceiveMessage(void)
                     TotalBytesReceived;
                 IsDefaultLength = NV_FALSE;
             }
+
+            /* Start the CMAC on the header while the payload arrives. */
+            if ((TotalBytesReceived == sizeof(NvBootRcmMsg)) && CanStreamHash())
+            {
+                HashStart();
+                s_State.IsHashStreaming = NV_TRUE;
+            }
         }
 
-        /* Copy any remaining data to Dst */
+        /* Copy the start of the payload that shared a read with the header */
         BytesToCopy = NV_MIN(BytesLeftInMessage, BytesRead);
         memcpy(Dst, Src, BytesToCopy);
 
@@ -330,46 +402,64 @@ static NvBootError ReceiveMessage(void)
             HandleError(NvBootRcmResponse_XferOverflow);
             return NvBootError_ValidationFailure;
         }
-
-        /* Spin wait for USB read to complete */
-        if (ReadFromPort)
-        {
-            /* Note: Timeout value is not used by Synopsys driver.
-             * Setting a high value for future RCM ports.
-             * The buffer passed is used by Synopsys driver for pending control transfers.
-             * Going forward, RCM ports should use internal resources for this purpose.
-             */
-            e = pRcmPort->ReceivePoll(&BytesRead, 0xFFFFFFFF,Buffer[s_State.BufferIndex]);
-            if ( e == NvBootError_EpNotConfigured)
-            {
-                // Endpoint will be un-configured only it reset occurs,
-                // If reset occurs, need do re-enumearation
-                return e;
-            }
-            else if (e != NvBootError_Success)
-            {
-                HandleError(NvBootRcmResponse_UsbError);
-                return e;
-            }
-        }
     }
 
     /* Message was successfully received. */
     return  NvBootError_Success;
 }
 
+/**
+ * The CMAC can be fed during ReceiveMessage() only when the key slot does
+ * not depend on this message.  That is the case for every message in the
+ * AES modes except a first message that selects secure provisioning, whose
+ * keys are loaded by ProcessMsgForSecureProvisioning() once it is in.
+ */
+static NvBool
+CanStreamHash(void)
+{
+    if (s_State.RcmOpMode == NvBootFuseOperatingMode_OdmProductionSecurePKC)
+        return NV_FALSE;
+
+    if (s_State.FirstMessageProcessed == NV_TRUE)
+        return NV_TRUE;
+
+    return (NvBootFuseIsSecureProvisioningMode(s_Msg.SecProvisioningKeyNum_Insecure)
+            == NvBootError_SecProvisioningDisabled);
+}
+
 static void
-ComputeHash(void)
+HashStart(void)
+{
+    /* A receive that failed part way may have left an operation running. */
+    while(NvBootSeIsEngineBusy())
+        ;
+
+    /*
+     * The SE driver caches the subkeys per key slot, so this only uses the
+     * engine for the first message, or after the key slot was rewritten.
+     */
+    NvBootSeAesCmacGenerateSubkey(s_State.CMACHashKeySlotNum,
+                                  s_State.ValidationKeySize,
+                                  &s_CmacK1[0],
+                                  &s_CmacK2[0]);
+
+    s_State.HashedBlocks = 0;
+}
+
+/**
+ * Feed the AES blocks of the hashed area up to BlocksReady to the CMAC.
+ * Blocks are counted from RandomAesBlock; the first HeaderBlocks of them live
+ * in s_Msg and the rest at NVBOOT_RCM_DLOAD_BASE_ADDRESS.  Unless Last is
+ * set, the final block of the message is held back, as the CMAC needs it
+ * for the subkey step.  Returns without waiting for the SE, except that the
+ * header is always hashed before any payload block is started.
+ */
+static void
+HashBlocks(NvU32 BlocksReady, NvBool Last)
 {
-    NvBool      First = NV_TRUE;
-    NvBool      Last  = NV_FALSE;
     NvU32       HeaderBlocks;
     NvU32       TotalBlocks;
-    NvU8       *Src = (NvU8*)&(s_Msg.RandomAesBlock);
     NvU32       Offset; /* to the start of the hashed area of the message */
-    static NvU32 K1[NVBOOT_SE_AES_BLOCK_LENGTH];
-    static NvU32 K2[NVBOOT_SE_AES_BLOCK_LENGTH];
-    static NvBool firstTimeVisit = NV_TRUE;
 
     Offset       = (NvU8*)&(s_Msg.RandomAesBlock) - (NvU8*)&s_Msg;
     HeaderBlocks = (sizeof(NvBootRcmMsg) - Offset) >>
@@ -377,46 +467,68 @@ ComputeHash(void)
     TotalBlocks  = (s_Msg.LengthInsecure - Offset) >>
         NVBOOT_SE_AES_BLOCK_LENGTH_LOG2;
 
-    if (firstTimeVisit)
+    if (!Last)
+        BlocksReady = NV_MIN(BlocksReady, TotalBlocks - 1);
+
+    if (s_State.HashedBlocks < HeaderBlocks)
     {
-        NvBootSeAesCmacGenerateSubkey(s_State.CMACHashKeySlotNum,
-                                      s_State.ValidationKeySize,
-                                      &K1[0],
-                                      &K2[0]);
-        firstTimeVisit = NV_FALSE;
+        NvBootSeAesCmacHashBlocks(&s_CmacK1[0],
+                                  &s_CmacK2[0],
+                                  (NvU32 *) &(s_Msg.RandomAesBlock),
+                                  (NvU8 *) &(s_State.ComputedSignature.CryptoHash),
+                                  s_State.CMACHashKeySlotNum,
+                                  s_State.ValidationKeySize,
+                                  HeaderBlocks,
+                                  NV_TRUE,
+                                  NV_FALSE);
+        s_State.HashedBlocks = HeaderBlocks;
+
+        /* Wait for completion */
+        while(NvBootSeIsEngineBusy())
+            ;
     }
 
-    NvBootSeAesCmacHashBlocks(&K1[0],
-                              &K2[0],
-                              (NvU32 *) Src,
+    if (BlocksReady <= s_State.HashedBlocks)
+        return;
+
+    NvBootSeAesCmacHashBlocks(&s_CmacK1[0],
+                              &s_CmacK2[0],
+                              (NvU32 *) (NVBOOT_RCM_DLOAD_BASE_ADDRESS +
+                                         ((s_State.HashedBlocks - HeaderBlocks) <<
+                                          NVBOOT_SE_AES_BLOCK_LENGTH_LOG2)),
                               (NvU8 *) &(s_State.ComputedSignature.CryptoHash),
                               s_State.CMACHashKeySlotNum,
                               s_State.ValidationKeySize,
-                              HeaderBlocks,
-                              First,
+                              BlocksReady - s_State.HashedBlocks,
+                              NV_FALSE,
                               Last);
+    s_State.HashedBlocks = BlocksReady;
+}
 
-    /* Wait for completion */
+static void
+ComputeHash(void)
+{
+    NvU32       Offset; /* to the start of the hashed area of the message */
+
+    Offset = (NvU8*)&(s_Msg.RandomAesBlock) - (NvU8*)&s_Msg;
+
+    /* Hash whatever ReceiveMessage() has not already fed to the SE. */
+    if (!s_State.IsHashStreaming)
+        HashStart();
+
+    /* The last block is processed without checking for a busy SE. */
     while(NvBootSeIsEngineBusy())
         ;
 
-    First = NV_FALSE;
-    Last = NV_TRUE;
-    Src = (NvU8*)(NVBOOT_RCM_DLOAD_BASE_ADDRESS);
-
-    NvBootSeAesCmacHashBlocks(&K1[0],
-                              &K2[0],
-                              (NvU32 *) Src,
-                              (NvU8 *)  &(s_State.ComputedSignature.CryptoHash),
-                              s_State.CMACHashKeySlotNum,
-                              s_State.ValidationKeySize,
-                              TotalBlocks - HeaderBlocks,
-                              First,
-                              Last);
+    HashBlocks((s_Msg.LengthInsecure - Offset) >>
+               NVBOOT_SE_AES_BLOCK_LENGTH_LOG2,
+               NV_TRUE);
 
     /* Wait for completion */
     while(NvBootSeIsEngineBusy())
         ;
+
+    s_State.IsHashStreaming = NV_FALSE;
 }
 
 static void
@@ -84,6 +84,19 @@
 // buffer number
 NV_ALIGN (4) static SeLinkedList s_InputLinkedList;
 
+// AES-CMAC subkeys, indexed by SE key slot. L = AES(K, 0) costs an engine
+// operation and two IV writes, but only changes when the key slot is
+// rewritten, so K1 is kept once derived for the reader, RCM, the BCT and
+// warm boot to share. K2 is one shift away from K1 and is not stored.
+typedef struct SeAesCmacSubkeyCacheRec
+{
+    NvU32   ValidSlots;     // bit n set: K1[n] was derived for KeySize[n]
+    NvU8    KeySize[NvBootSeAesKeySlot_Num];
+    NvU32   K1[NvBootSeAesKeySlot_Num][NVBOOT_SE_AES_BLOCK_LENGTH];
+} SeAesCmacSubkeyCache;
+
+NV_ALIGN (4) static SeAesCmacSubkeyCache s_CmacSubkeyCache;
+
 
 // ---------------------Private Functions Declaration---------------------------
 static void
@@ -101,6 +114,13 @@ NvBootSeLeftShiftOneBit(NvU8 *in_buf, NvU32 size)
     }
 }
 
+// Drop the cached CMAC subkey of a key slot whose key is being written.
+static void
+SeAesCmacInvalidateSubkey(NvU8 KeySlot)
+{
+    s_CmacSubkeyCache.ValidSlots &= ~(1U << KeySlot);
+}
+
 static void
 NvBootSeClearSrkSecureScratch()
 {
@@ -491,6 +511,9 @@ NvBootSeInitializeSE(void)
     NvBootResetSetEnable(NvBootResetDeviceId_SeId, NV_TRUE);
     NvBootResetSetEnable(NvBootResetDeviceId_SeId, NV_FALSE);
 
+    // No key slot has been written since the reset.
+    NvBootSeAesCmacClearSubkeyCache();
+
     return;
 }
 
@@ -1583,6 +1606,8 @@ void NvBootSeKeySlotWriteKeyIV(NvU8 KeySlot, NvU8 KeySize, NvU8 KeyType, NvU32 *
         case    SE_CRYPTO_KEYIV_PKT_WORD_QUAD_KEYS_4_7:
             KeyIvSel = SE_CRYPTO_KEYIV_PKT_KEYIV_SEL_KEY;
             IvSel = 0; // Don't care in this case.
+            // The CMAC subkeys derived from the old key are stale.
+            SeAesCmacInvalidateSubkey(KeySlot);
             break;
         case    SE_CRYPTO_KEYIV_PKT_WORD_QUAD_ORIGINAL_IVS:
             KeyIvSel = SE_CRYPTO_KEYIV_PKT_KEYIV_SEL_IV;
@@ -2092,6 +2117,16 @@ void NvBootSeAesCmacGenerateSubkey(NvU8 KeySlot, NvU8 KeySize, NvU32 *pK1, NvU32
                (KeySize == SE_MODE_PKT_AESMODE_KEY192) ||
                (KeySize == SE_MODE_PKT_AESMODE_KEY256) );
 
+    // K1 is cached until the key slot is written again.
+    if ((s_CmacSubkeyCache.ValidSlots & (1U << KeySlot)) &&
+        (s_CmacSubkeyCache.KeySize[KeySlot] == KeySize))
+    {
+        NvBootUtilMemcpy(pK1,
+                         &s_CmacSubkeyCache.K1[KeySlot][0],
+                         NVBOOT_SE_AES_BLOCK_LENGTH_BYTES);
+        goto DeriveK2;
+    }
+
     // AES block of zeroes.
     NvBootUtilMemset(&ConstZero, 0, NVBOOT_SE_AES_BLOCK_LENGTH_BYTES);
 
@@ -2155,6 +2190,13 @@ void NvBootSeAesCmacGenerateSubkey(NvU8 KeySlot, NvU8 KeySize, NvU32 *pK1, NvU32
     if(msbL)
         *(pK + NVBOOT_SE_AES_BLOCK_LENGTH_BYTES - 1) ^= NVBOOT_SE_AES_CMAC_CONST_RB;
 
+    NvBootUtilMemcpy(&s_CmacSubkeyCache.K1[KeySlot][0],
+                     pK1,
+                     NVBOOT_SE_AES_BLOCK_LENGTH_BYTES);
+    s_CmacSubkeyCache.KeySize[KeySlot] = KeySize;
+    s_CmacSubkeyCache.ValidSlots |= (1U << KeySlot);
+
+DeriveK2:
     // if MSB(K1) is equal to 0
     // then K2 := K1 << 1;
     // else K2 := (K1 << 1) XOR const_Rb;
@@ -2169,6 +2211,11 @@ void NvBootSeAesCmacGenerateSubkey(NvU8 KeySlot, NvU8 KeySize, NvU32 *pK1, NvU32
     return;
 }
 
+void NvBootSeAesCmacClearSubkeyCache(void)
+{
+    NvBootUtilMemset(&s_CmacSubkeyCache, 0, sizeof(s_CmacSubkeyCache));
+}
+
 void
 NvBootSeAesCmacHashBlocks (NvU32 *pK1, NvU32 *pK2, NvU32 *pInputMessage, NvU8 *pHash, NvU8 KeySlot, NvU8 KeySize, NvU32 NumBlocks, NvBool FirstChunk, NvBool LastChunk)
 {
@@ -2179,7 +2226,6 @@ NvBootSeAesCmacHashBlocks (NvU32 *pK1, NvU32 *pK2, NvU32 *pInputMessage, NvU8 *p
     NvU32   i;
     NvU32   LastBlockBuffer[NVBOOT_SE_AES_BLOCK_LENGTH];
     NvU32   SeConfigReg;
-    SeLinkedList InputLinkedList;
     SingleSeLinkedList OutputLinkedList;
 
     NV_ASSERT(pK1 != NULL);
@@ -2224,9 +2270,9 @@ NvBootSeAesCmacHashBlocks (NvU32 *pK1, NvU32 *pK2, NvU32 *pInputMessage, NvU8 *p
                 // instead of ORIGINAL IV since we just cleared the IVs above.
                 NvBootSeSetupOpMode(SE_OP_MODE_AES_CMAC_HASH, NV_TRUE, NV_FALSE, SE_CONFIG_0_DST_HASH_REG, KeySlot, KeySize);
                 // Generate an input linked list.
-                NvBootSeGenerateLinkedList(&InputLinkedList, pInputMessage, ByteOffsetToLastBlock);
+                NvBootSeGenerateLinkedList(&s_InputLinkedList, pInputMessage, ByteOffsetToLastBlock);
                 // Set address of input linked list.
-                NvBootSetSeReg(SE_IN_LL_ADDR_0, (NvU32) &InputLinkedList);
+                NvBootSetSeReg(SE_IN_LL_ADDR_0, (NvU32) &s_InputLinkedList);
 
                 // The SE_CRYPTO_LAST_BLOCK_0 value is calculated by the following formula
                 // given in the SE IAS section 3.2.3.1 AES Input Data Size.
@@ -2260,9 +2306,9 @@ NvBootSeAesCmacHashBlocks (NvU32 *pK1, NvU32 *pK2, NvU32 *pInputMessage, NvU8 *p
             NvBootSeSetupOpMode(SE_OP_MODE_AES_CMAC_HASH, NV_TRUE, NV_FALSE, SE_CONFIG_0_DST_MEMORY, KeySlot, KeySize);
             // Generate an input linked list.
             //static NvBootSeGenerateLinkedList(SeLinkedList *pLinkedList, NvU32 *pStartAddress, NvU32 MessageSize)
-            NvBootSeGenerateLinkedList(&InputLinkedList, LastBlockBuffer, NVBOOT_SE_AES_BLOCK_LENGTH_BYTES);
+            NvBootSeGenerateLinkedList(&s_InputLinkedList, LastBlockBuffer, NVBOOT_SE_AES_BLOCK_LENGTH_BYTES);
             // Set address of input linked list.
-            NvBootSetSeReg(SE_IN_LL_ADDR_0, (NvU32) &InputLinkedList);
+            NvBootSetSeReg(SE_IN_LL_ADDR_0, (NvU32) &s_InputLinkedList);
 
             // The SE_CRYPTO_LAST_BLOCK_0 value is calculated by the following formula
             // given in the SE IAS section 3.2.3.1 AES Input Data Size.
@@ -2300,11 +2346,12 @@ NvBootSeAesCmacHashBlocks (NvU32 *pK1, NvU32 *pK2, NvU32 *pInputMessage, NvU8 *p
             // Set IV to UPDATED_IV because we are continuing a previous AES
             // operation.
             NvBootSeSetupOpMode(SE_OP_MODE_AES_CMAC_HASH, NV_TRUE, NV_FALSE, SE_CONFIG_0_DST_HASH_REG, KeySlot, KeySize);
-            // Generate an input linked list.
+            // Generate an input linked list. This operation is left running
+            // when we return, so the list must not live on the stack.
             //static NvBootSeGenerateLinkedList(SeLinkedList *pLinkedList, NvU32 *pStartAddress, NvU32 MessageSize)
-            NvBootSeGenerateLinkedList(&InputLinkedList, pInputMessage, NumBlocks*NVBOOT_SE_AES_BLOCK_LENGTH_BYTES);
+            NvBootSeGenerateLinkedList(&s_InputLinkedList, pInputMessage, NumBlocks*NVBOOT_SE_AES_BLOCK_LENGTH_BYTES);
             // Set address of input linked list.
-            NvBootSetSeReg(SE_IN_LL_ADDR_0, (NvU32) &InputLinkedList);
+            NvBootSetSeReg(SE_IN_LL_ADDR_0, (NvU32) &s_InputLinkedList);
 
             // The SE_CRYPTO_LAST_BLOCK_0 value is calculated by the following formula
             // given in the SE IAS section 3.2.3.1 AES Input Data Size.
@@ -2471,6 +2518,9 @@ void NvBootSeAesDecryptKeyIntoKeySlot (
                (TargetKeySize == SE_MODE_PKT_AESMODE_KEY256) );
     NV_ASSERT(Src != NULL);
 
+    // The target key slot gets a new key.
+    SeAesCmacInvalidateSubkey(TargetKeySlot);
+
     // Initialize SE source IV slot OriginalIv[127:0] to zero
     NvBootSeKeySlotWriteKeyIV(SourceKeySlot,
                       SE_MODE_PKT_AESMODE_KEY128,
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * host_clock.h - Simulated microsecond timer for the host harnesses.
+ *
+ * NvBootUtilGetTimeUS() reads TMRUS by address, not through NV_READ32().
+ * HostClockInit() maps host memory at that address, so the unmodified
+ * nvboot_util.c reads a counter that only moves when a harness calls
+ * HostClockAdvance(). Code that busy-waits on the timer would therefore
+ * spin forever; models advance the clock from their task and poll stubs.
+ */
+
+#ifndef INCLUDED_HOST_CLOCK_H
+#define INCLUDED_HOST_CLOCK_H
+
+#include "nvcommon.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/** Maps the timer and sets it to 0. Aborts if the address is taken. */
+void HostClockInit(void);
+
+/** Moves the timer forward by Us microseconds. */
+void HostClockAdvance(NvU32 Us);
+
+/** Current value of the timer. */
+NvU32 HostClockNow(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // INCLUDED_HOST_CLOCK_H
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * host_regs.h - Register model shared by the host harnesses.
+ *
+ * With NV_DEF_ENVIRONMENT_SUPPORTS_SIM set, NV_READ32() and NV_WRITE32()
+ * call NvRead32() and NvWrite32(), which host_regs.c defines. Addresses
+ * below HOST_REG_SPACE_START are host memory and are accessed directly.
+ * Above it, each register keeps the last value written, unless a harness
+ * hooks its range to model a controller.
+ */
+
+#ifndef INCLUDED_HOST_REGS_H
+#define INCLUDED_HOST_REGS_H
+
+#include "nvcommon.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define HOST_REG_SPACE_START 0x40000000
+
+typedef NvU32 (*HostRegReadFn)(NvU32 Addr);
+typedef void (*HostRegWriteFn)(NvU32 Addr, NvU32 Data);
+
+/**
+ * Routes the accesses to [Base, Base + Size) to Read and Write. Either may
+ * be NULL to keep the default behavior for that direction.
+ */
+void HostRegHook(NvU32 Base, NvU32 Size, HostRegReadFn Read, HostRegWriteFn Write);
+
+/** Reads or sets a register without going through the hooks. */
+NvU32 HostRegPeek(NvU32 Addr);
+void HostRegPoke(NvU32 Addr, NvU32 Data);
+
+/** Forgets every register value and hook. */
+void HostRegReset(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // INCLUDED_HOST_REGS_H
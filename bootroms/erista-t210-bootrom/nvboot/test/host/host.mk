@@ -0,0 +1,33 @@
+#
+# Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+# 
+# NVIDIA Corporation and its licensors retain all intellectual property
+# and proprietary rights in and to this software and related documentation
+# and any modifications thereto.  Any use, reproduction, disclosure or
+# distribution of this software and related documentation without an express
+# license agreement from NVIDIA Corporation is strictly prohibited.
+#
+
+# Shared settings for the host harnesses. A harness Makefile sets HOST_DIR
+# to the path of this directory and includes this file.
+#
+# The Boot ROM code is 32-bit and casts pointers to NvU32, so harnesses are
+# linked without PIE and keep the buffers they hand it in static storage,
+# which then sits below 4GB.
+
+NVBOOT      := $(HOST_DIR)/../..
+BR          := $(NVBOOT)/..
+
+HOST_CFLAGS := -O2 -g -Wall -fno-pie -fcommon \
+               -Wno-pointer-to-int-cast -Wno-int-to-pointer-cast \
+               -DNV_DEF_ENVIRONMENT_SUPPORTS_SIM=1 \
+               -include $(HOST_DIR)/include/host_snapshot.h \
+               -I$(HOST_DIR)/include -I$(HOST_DIR)/common \
+               -I$(NVBOOT)/include/t210 -I$(BR)/include/t210 -I$(BR)/include/sw
+HOST_LDFLAGS := -no-pie
+HOST_REGS   := $(HOST_DIR)/common/host_regs.c
+
+# $(call host-old-src,FILE,OUT) extracts FILE as it was at git revision
+# $(OLD_REV) into OUT, to build the code from before a change next to the
+# current one.
+host-old-src = git -C $(dir $(1)) show $(OLD_REV):./$(notdir $(1)) > $(2)
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * arapb_misc.h - Host stand-in for the generated APB_MISC register header,
+ * with only the fields the host builds use.
+ */
+
+#ifndef INCLUDED_ARAPB_MISC_H
+#define INCLUDED_ARAPB_MISC_H
+
+#define APB_MISC_GP_HIDREV_0                                    0x804
+#define APB_MISC_GP_HIDREV_0_HIDFAM_RANGE                       3:0
+#define APB_MISC_GP_HIDREV_0_MAJORREV_RANGE                     7:4
+#define APB_MISC_GP_HIDREV_0_CHIPID_RANGE                       15:8
+#define APB_MISC_GP_HIDREV_0_MINORREV_RANGE                     19:16
+
+#endif // INCLUDED_ARAPB_MISC_H
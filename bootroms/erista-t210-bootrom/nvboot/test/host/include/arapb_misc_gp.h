@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * arapb_misc_gp.h - Host stand-in for the generated APB_MISC_GP register
+ * header, with only the fields the host builds use.
+ */
+
+#ifndef INCLUDED_ARAPB_MISC_GP_H
+#define INCLUDED_ARAPB_MISC_GP_H
+
+#define APB_MISC_GP_HIDREV_0_CHIPID_DEFAULT                     0x21
+
+#endif // INCLUDED_ARAPB_MISC_GP_H
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * arapbpm.h - Host stand-in for the generated PMC register header, with
+ * only the fields the host builds use. The offsets follow the T210
+ * layout; no host model decodes them.
+ */
+
+#ifndef INCLUDED_ARAPBPM_H
+#define INCLUDED_ARAPBPM_H
+
+#define APBDEV_PMC_SECURE_SCRATCH4_0                            0x0c0
+#define APBDEV_PMC_SECURE_SCRATCH5_0                            0x0c4
+#define APBDEV_PMC_SECURE_SCRATCH6_0                            0x224
+#define APBDEV_PMC_SECURE_SCRATCH7_0                            0x228
+#define APBDEV_PMC_SCRATCH43_0                                  0x22c
+
+#define APBDEV_PMC_DEBUG_AUTHENTICATION_0_SW_DEFAULT_VAL        0
+
+#endif // INCLUDED_ARAPBPM_H
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * arclk_rst.h - Host stand-in for the generated CAR register header, with
+ * only the fields the host builds use.
+ *
+ * The enable and reset bits fill the clock and reset ids of
+ * nvboot_clocks_int.h and nvboot_reset_int.h. The values follow T210.
+ */
+
+#ifndef INCLUDED_ARCLK_RST_H
+#define INCLUDED_ARCLK_RST_H
+
+#define CLK_RST_CONTROLLER_OSC_CTRL_0_OSC_FREQ_OSC13            0
+#define CLK_RST_CONTROLLER_OSC_CTRL_0_OSC_FREQ_OSC16P8          1
+#define CLK_RST_CONTROLLER_OSC_CTRL_0_OSC_FREQ_OSC19P2          4
+#define CLK_RST_CONTROLLER_OSC_CTRL_0_OSC_FREQ_OSC38P4          5
+#define CLK_RST_CONTROLLER_OSC_CTRL_0_OSC_FREQ_OSC12            8
+#define CLK_RST_CONTROLLER_OSC_CTRL_0_OSC_FREQ_OSC48            9
+#define CLK_RST_CONTROLLER_OSC_CTRL_0_OSC_FREQ_OSC26            12
+
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_L_0_CLK_ENB_CPU_SHIFT    0
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_L_0_CLK_ENB_UARTA_SHIFT  6
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_L_0_CLK_ENB_I2C1_SHIFT   12
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_L_0_CLK_ENB_SDMMC4_SHIFT 15
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_L_0_CLK_ENB_USBD_SHIFT   22
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_H_0_CLK_ENB_MEM_SHIFT    0
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_H_0_CLK_ENB_AHBDMA_SHIFT 1
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_H_0_CLK_ENB_APBDMA_SHIFT 2
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_H_0_CLK_ENB_PMC_SHIFT    6
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_H_0_CLK_ENB_SPI1_SHIFT   9
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_H_0_CLK_ENB_SPI2_SHIFT   12
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_H_0_CLK_ENB_SPI3_SHIFT   14
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_H_0_CLK_ENB_I2C5_SHIFT   15
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_H_0_CLK_ENB_I2C2_SHIFT   22
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_H_0_CLK_ENB_EMC_SHIFT    25
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_U_0_CLK_ENB_I2C3_SHIFT   3
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_U_0_CLK_ENB_XUSB_HOST_SHIFT 25
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_V_0_CLK_ENB_I2C4_SHIFT   7
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_V_0_CLK_ENB_SATA_OOB_SHIFT 27
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_V_0_CLK_ENB_SATA_SHIFT   28
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_V_0_CLK_ENB_SE_SHIFT     31
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_W_0_CLK_ENB_XUSB_SHIFT   15
+#define CLK_RST_CONTROLLER_CLK_OUT_ENB_Y_0_CLK_ENB_QSPI_SHIFT   19
+
+#define CLK_RST_CONTROLLER_RST_DEVICES_L_0_SWR_CPU_RST_SHIFT    0
+#define CLK_RST_CONTROLLER_RST_DEVICES_L_0_SWR_COP_RST_SHIFT    1
+#define CLK_RST_CONTROLLER_RST_DEVICES_L_0_SWR_UARTA_RST_SHIFT  6
+#define CLK_RST_CONTROLLER_RST_DEVICES_L_0_SWR_I2C1_RST_SHIFT   12
+#define CLK_RST_CONTROLLER_RST_DEVICES_L_0_SWR_SDMMC4_RST_SHIFT 15
+#define CLK_RST_CONTROLLER_RST_DEVICES_L_0_SWR_USBD_RST_SHIFT   22
+#define CLK_RST_CONTROLLER_RST_DEVICES_H_0_SWR_MEM_RST_SHIFT    0
+#define CLK_RST_CONTROLLER_RST_DEVICES_H_0_SWR_AHBDMA_RST_SHIFT 1
+#define CLK_RST_CONTROLLER_RST_DEVICES_H_0_SWR_APBDMA_RST_SHIFT 2
+#define CLK_RST_CONTROLLER_RST_DEVICES_H_0_SWR_SPI1_RST_SHIFT   9
+#define CLK_RST_CONTROLLER_RST_DEVICES_H_0_SWR_SPI2_RST_SHIFT   12
+#define CLK_RST_CONTROLLER_RST_DEVICES_H_0_SWR_SPI3_RST_SHIFT   14
+#define CLK_RST_CONTROLLER_RST_DEVICES_H_0_SWR_I2C5_RST_SHIFT   15
+#define CLK_RST_CONTROLLER_RST_DEVICES_H_0_SWR_I2C2_RST_SHIFT   22
+#define CLK_RST_CONTROLLER_RST_DEVICES_H_0_SWR_EMC_RST_SHIFT    25
+#define CLK_RST_CONTROLLER_RST_DEVICES_U_0_SWR_I2C3_RST_SHIFT   3
+#define CLK_RST_CONTROLLER_RST_DEVICES_U_0_SWR_XUSB_HOST_RST_SHIFT 25
+#define CLK_RST_CONTROLLER_RST_DEVICES_U_0_SWR_XUSB_DEV_RST_SHIFT 31
+#define CLK_RST_CONTROLLER_RST_DEVICES_V_0_SWR_I2C4_RST_SHIFT   7
+#define CLK_RST_CONTROLLER_RST_DEVICES_V_0_SWR_SATA_OOB_RST_SHIFT 27
+#define CLK_RST_CONTROLLER_RST_DEVICES_V_0_SWR_SATA_RST_SHIFT   28
+#define CLK_RST_CONTROLLER_RST_DEVICES_V_0_SWR_SE_RST_SHIFT     31
+#define CLK_RST_CONTROLLER_RST_DEVICES_W_0_SWR_SATACOLD_RST_SHIFT 1
+#define CLK_RST_CONTROLLER_RST_DEVICES_W_0_SWR_XUSB_PADCTL_RST_SHIFT 14
+#define CLK_RST_CONTROLLER_RST_DEVICES_W_0_SWR_XUSB_SS_RST_SHIFT 28
+#define CLK_RST_CONTROLLER_RST_DEVICES_Y_0_SWR_QSPI_RST_SHIFT   19
+
+#define CLK_RST_CONTROLLER_SCLK_BURST_POLICY_0                  0x028
+#define CLK_RST_CONTROLLER_SCLK_BURST_POLICY_0_SWAKEUP_RUN_SOURCE_RANGE 7:4
+#define CLK_RST_CONTROLLER_SCLK_BURST_POLICY_0_SWAKEUP_RUN_SOURCE_PLLP_OUT2 4
+#define CLK_RST_CONTROLLER_PLLM_BASE_0                          0x090
+#define CLK_RST_CONTROLLER_PLLM_MISC2_0                         0x09c
+#define CLK_RST_CONTROLLER_PLLP_BASE_0                          0x0a0
+#define CLK_RST_CONTROLLER_PLLP_MISC_0                          0x0ac
+#define CLK_RST_CONTROLLER_PLLU_BASE_0                          0x0c0
+#define CLK_RST_CONTROLLER_PLLU_MISC_0                          0x0cc
+#define CLK_RST_CONTROLLER_PLLX_BASE_0                          0x0e0
+#define CLK_RST_CONTROLLER_PLLX_MISC_0                          0x0e4
+#define CLK_RST_CONTROLLER_PLLE_BASE_0                          0x0e8
+#define CLK_RST_CONTROLLER_PLLE_MISC_0                          0x0ec
+#define CLK_RST_CONTROLLER_CLK_SOURCE_SPI2_0                    0x118
+#define CLK_RST_CONTROLLER_CLK_SOURCE_I2C1_0                    0x124
+#define CLK_RST_CONTROLLER_CLK_SOURCE_I2C5_0                    0x128
+#define CLK_RST_CONTROLLER_CLK_SOURCE_SPI1_0                    0x134
+#define CLK_RST_CONTROLLER_CLK_SOURCE_SDMMC4_0                  0x164
+#define CLK_RST_CONTROLLER_CLK_SOURCE_UARTA_0                   0x178
+#define CLK_RST_CONTROLLER_CLK_SOURCE_I2C2_0                    0x198
+#define CLK_RST_CONTROLLER_CLK_SOURCE_I2C3_0                    0x1b8
+#define CLK_RST_CONTROLLER_CLK_SOURCE_SPI3_0                    0x1bc
+#define CLK_RST_CONTROLLER_CLK_SOURCE_I2C4_0                    0x3c4
+#define CLK_RST_CONTROLLER_CLK_SOURCE_SATA_OOB_0                0x420
+#define CLK_RST_CONTROLLER_CLK_SOURCE_SATA_0                    0x424
+#define CLK_RST_CONTROLLER_CLK_SOURCE_SE_0                      0x42c
+#define CLK_RST_CONTROLLER_CLK_SOURCE_SE_0_SE_CLK_SRC_PLLP_OUT0 0
+#define CLK_RST_CONTROLLER_PLLREFE_BASE_0                       0x4c4
+#define CLK_RST_CONTROLLER_PLLREFE_MISC_0                       0x4c8
+#define CLK_RST_CONTROLLER_PLLC4_BASE_0                         0x5a4
+#define CLK_RST_CONTROLLER_PLLC4_MISC_0                         0x5a8
+
+#endif // INCLUDED_ARCLK_RST_H
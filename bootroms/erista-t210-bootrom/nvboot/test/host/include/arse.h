@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * arse.h - Host stand-in for the generated SE register header, with only
+ * the fields the host builds use.
+ *
+ * The register offsets, fields and encodings follow the T210 SE layout;
+ * host SE models decode them through the same names as the driver.
+ */
+
+#ifndef INCLUDED_ARSE_H
+#define INCLUDED_ARSE_H
+
+#ifndef _MK_ENUM_CONST
+  #define _MK_ENUM_CONST(_constant_) (_constant_ ## UL)
+#endif
+
+#define ARSE_SECURE                                             _MK_ENUM_CONST(0)
+#define ARSE_SHA256_HASH_SIZE                                   256
+#define ARSE_TZRAM_BYTE_SIZE                                    65536
+#define ARSE_TZRAM_CARVEOUT_ADDR_SE1                            0x7c04c000
+#define ARSE_TZRAM_CARVEOUT_ADDR_SE2                            0x7c04d000
+#define ARSE_TZRAM_CARVEOUT_BYTE_SIZE                           4096
+
+#define SE_MODE_PKT_AESMODE_KEY128                              _MK_ENUM_CONST(0)
+#define SE_MODE_PKT_AESMODE_KEY192                              _MK_ENUM_CONST(1)
+#define SE_MODE_PKT_AESMODE_KEY256                              _MK_ENUM_CONST(2)
+#define SE_MODE_PKT_SHAMODE_SHA1                                _MK_ENUM_CONST(0)
+#define SE_MODE_PKT_SHAMODE_SHA224                              _MK_ENUM_CONST(4)
+#define SE_MODE_PKT_SHAMODE_SHA256                              _MK_ENUM_CONST(5)
+#define SE_MODE_PKT_SHAMODE_SHA384                              _MK_ENUM_CONST(6)
+#define SE_MODE_PKT_SHAMODE_SHA512                              _MK_ENUM_CONST(7)
+
+#define SE_CRYPTO_KEYIV_PKT_WORD_QUAD_KEYS_0_3                  _MK_ENUM_CONST(0)
+#define SE_CRYPTO_KEYIV_PKT_WORD_QUAD_KEYS_4_7                  _MK_ENUM_CONST(1)
+#define SE_CRYPTO_KEYIV_PKT_WORD_QUAD_ORIGINAL_IVS              _MK_ENUM_CONST(2)
+#define SE_CRYPTO_KEYIV_PKT_WORD_QUAD_UPDATED_IVS               _MK_ENUM_CONST(3)
+#define SE_CRYPTO_KEYIV_PKT_KEY_INDEX_SHIFT                     4
+#define SE_CRYPTO_KEYIV_PKT_KEYIV_SEL_SHIFT                     3
+#define SE_CRYPTO_KEYIV_PKT_KEYIV_SEL_KEY                       _MK_ENUM_CONST(0)
+#define SE_CRYPTO_KEYIV_PKT_KEYIV_SEL_IV                        _MK_ENUM_CONST(1)
+#define SE_CRYPTO_KEYIV_PKT_IV_SEL_SHIFT                        2
+#define SE_CRYPTO_KEYIV_PKT_IV_SEL_ORIGINAL                     _MK_ENUM_CONST(0)
+#define SE_CRYPTO_KEYIV_PKT_IV_SEL_UPDATED                      _MK_ENUM_CONST(1)
+#define SE_CRYPTO_KEYIV_PKT_KEY_WORD_SHIFT                      0
+#define SE_CRYPTO_KEYIV_PKT_IV_WORD_SHIFT                       0
+
+#define SE_RSA_KEY_PKT_KEY_SLOT_SHIFT                           7
+#define SE_RSA_KEY_PKT_EXPMOD_SEL_SHIFT                         6
+#define SE_RSA_KEY_PKT_INPUT_MODE_SHIFT                         8
+#define SE_RSA_KEY_PKT_INPUT_MODE_DMA                           _MK_ENUM_CONST(1)
+#define SE_RSA_KEY_PKT_WORD_ADDR_SHIFT                          0
+#define SE_RSA_KEY_PKT_WORD_ADDR_FIELD                          (0x3f << 0)
+
+#define SE_SE_SECURITY_0                                        0x000
+#define SE_SE_SECURITY_0_RESET_VAL                              0x00010005
+#define SE_SE_SECURITY_0_SE_HARD_SETTING_SHIFT                  0
+#define SE_SE_SECURITY_0_SE_HARD_SETTING_FIELD                  (0x1 << 0)
+#define SE_SE_SECURITY_0_SE_HARD_SETTING_RANGE                  0:0
+#define SE_SE_SECURITY_0_SE_ENG_DIS_FIELD                       (0x1 << 1)
+#define SE_SE_SECURITY_0_SE_ENG_DIS_RANGE                       1:1
+#define SE_SE_SECURITY_0_SE_ENG_DIS_TRUE                        _MK_ENUM_CONST(1)
+#define SE_SE_SECURITY_0_PERKEY_SETTING_SHIFT                   2
+#define SE_SE_SECURITY_0_PERKEY_SETTING_FIELD                   (0x1 << 2)
+#define SE_SE_SECURITY_0_PERKEY_SETTING_RANGE                   2:2
+#define SE_SE_SECURITY_0_CTX_SAVE_TZ_LOCK_RANGE                 4:4
+#define SE_SE_SECURITY_0_SE_TZ_LOCK_SOFT_FIELD                  (0x1 << 5)
+#define SE_SE_SECURITY_0_SE_SOFT_SETTING_SHIFT                  16
+#define SE_SE_SECURITY_0_SE_SOFT_SETTING_RANGE                  16:16
+
+#define SE_TZRAM_SECURITY_0                                     0x004
+#define SE_TZRAM_SECURITY_0_TZRAM_SETTING_SHIFT                 0
+#define SE_TZRAM_SECURITY_0_TZRAM_ENG_DIS_RANGE                 1:1
+#define SE_TZRAM_SECURITY_0_TZRAM_ENG_DIS_TRUE                  _MK_ENUM_CONST(1)
+
+#define SE_OPERATION_0                                          0x008
+#define SE_OPERATION_0_OP_RANGE                                 2:0
+#define SE_OPERATION_0_OP_START                                 _MK_ENUM_CONST(1)
+
+#define SE_INT_STATUS_0                                         0x010
+
+#define SE_CONFIG_0                                             0x014
+#define SE_CONFIG_0_ENC_MODE_RANGE                              31:24
+#define SE_CONFIG_0_ENC_MODE_DEFAULT                            _MK_ENUM_CONST(0)
+#define SE_CONFIG_0_DEC_MODE_RANGE                              23:16
+#define SE_CONFIG_0_DEC_MODE_DEFAULT                            _MK_ENUM_CONST(0)
+#define SE_CONFIG_0_ENC_ALG_RANGE                               15:12
+#define SE_CONFIG_0_ENC_ALG_NOP                                 _MK_ENUM_CONST(0)
+#define SE_CONFIG_0_ENC_ALG_AES_ENC                             _MK_ENUM_CONST(1)
+#define SE_CONFIG_0_ENC_ALG_SHA                                 _MK_ENUM_CONST(3)
+#define SE_CONFIG_0_ENC_ALG_RSA                                 _MK_ENUM_CONST(4)
+#define SE_CONFIG_0_DEC_ALG_RANGE                               11:8
+#define SE_CONFIG_0_DEC_ALG_NOP                                 _MK_ENUM_CONST(0)
+#define SE_CONFIG_0_DEC_ALG_AES_DEC                             _MK_ENUM_CONST(1)
+#define SE_CONFIG_0_DST_RANGE                                   4:2
+#define SE_CONFIG_0_DST_MEMORY                                  _MK_ENUM_CONST(0)
+#define SE_CONFIG_0_DST_HASH_REG                                _MK_ENUM_CONST(1)
+#define SE_CONFIG_0_DST_KEYTABLE                                _MK_ENUM_CONST(2)
+#define SE_CONFIG_0_DST_RSA_REG                                 _MK_ENUM_CONST(4)
+
+#define SE_IN_LL_ADDR_0                                         0x018
+#define SE_OUT_LL_ADDR_0                                        0x024
+#define SE_HASH_RESULT_0                                        0x030
+
+#define SE_CTX_SAVE_AUTO_0                                      0x074
+#define SE_CTX_SAVE_AUTO_0_ENABLE_RANGE                         0:0
+#define SE_CTX_SAVE_AUTO_0_ENABLE_YES                           _MK_ENUM_CONST(1)
+#define SE_CTX_SAVE_AUTO_0_LOCK_RANGE                           8:8
+#define SE_CTX_SAVE_AUTO_0_LOCK_YES                             _MK_ENUM_CONST(1)
+
+#define SE_SHA_CONFIG_0                                         0x200
+#define SE_SHA_CONFIG_0_HW_INIT_HASH_RANGE                      0:0
+#define SE_SHA_CONFIG_0_HW_INIT_HASH_DISABLE                    _MK_ENUM_CONST(0)
+#define SE_SHA_CONFIG_0_HW_INIT_HASH_ENABLE                     _MK_ENUM_CONST(1)
+#define SE_SHA_MSG_LENGTH_0                                     0x204
+#define SE_SHA_MSG_LENGTH_1                                     0x208
+#define SE_SHA_MSG_LENGTH_2                                     0x20c
+#define SE_SHA_MSG_LENGTH_3                                     0x210
+#define SE_SHA_MSG_LEFT_0                                       0x214
+#define SE_SHA_MSG_LEFT_1                                       0x218
+#define SE_SHA_MSG_LEFT_2                                       0x21c
+#define SE_SHA_MSG_LEFT_3                                       0x220
+
+#define SE_CRYPTO_SECURITY_PERKEY_0                             0x280
+#define SE_CRYPTO_KEYTABLE_ACCESS_0                             0x284
+#define SE_CRYPTO_KEYTABLE_ACCESS_0_RESET_VAL                   0x0000007f
+#define SE_CRYPTO_KEYTABLE_ACCESS_0_KEYREAD_RANGE               0:0
+#define SE_CRYPTO_KEYTABLE_ACCESS_0_KEYREAD_DISABLE             _MK_ENUM_CONST(0)
+#define SE_CRYPTO_KEYTABLE_ACCESS_0_KEYUPDATE_RANGE             1:1
+#define SE_CRYPTO_KEYTABLE_ACCESS_0_KEYUPDATE_DISABLE           _MK_ENUM_CONST(0)
+#define SE_CRYPTO_KEYTABLE_ACCESS_0_OIVREAD_RANGE               2:2
+#define SE_CRYPTO_KEYTABLE_ACCESS_0_OIVREAD_DISABLE             _MK_ENUM_CONST(0)
+#define SE_CRYPTO_KEYTABLE_ACCESS_0_OIVUPDATE_RANGE             3:3
+#define SE_CRYPTO_KEYTABLE_ACCESS_0_OIVUPDATE_DISABLE           _MK_ENUM_CONST(0)
+#define SE_CRYPTO_KEYTABLE_ACCESS_0_UIVREAD_RANGE               4:4
+#define SE_CRYPTO_KEYTABLE_ACCESS_0_UIVREAD_DISABLE             _MK_ENUM_CONST(0)
+#define SE_CRYPTO_KEYTABLE_ACCESS_0_UIVUPDATE_RANGE             5:5
+#define SE_CRYPTO_KEYTABLE_ACCESS_0_UIVUPDATE_DISABLE           _MK_ENUM_CONST(0)
+#define SE_CRYPTO_KEYTABLE_ACCESS_1                             0x288
+#define SE_CRYPTO_KEYTABLE_ACCESS_2                             0x28c
+#define SE_CRYPTO_KEYTABLE_ACCESS_3                             0x290
+#define SE_CRYPTO_KEYTABLE_ACCESS_4                             0x294
+#define SE_CRYPTO_KEYTABLE_ACCESS_5                             0x298
+#define SE_CRYPTO_KEYTABLE_ACCESS_6                             0x29c
+#define SE_CRYPTO_KEYTABLE_ACCESS_7                             0x2a0
+#define SE_CRYPTO_KEYTABLE_ACCESS_8                             0x2a4
+#define SE_CRYPTO_KEYTABLE_ACCESS_9                             0x2a8
+#define SE_CRYPTO_KEYTABLE_ACCESS_10                            0x2ac
+#define SE_CRYPTO_KEYTABLE_ACCESS_11                            0x2b0
+#define SE_CRYPTO_KEYTABLE_ACCESS_12                            0x2b4
+#define SE_CRYPTO_KEYTABLE_ACCESS_13                            0x2b8
+#define SE_CRYPTO_KEYTABLE_ACCESS_14                            0x2bc
+#define SE_CRYPTO_KEYTABLE_ACCESS_15                            0x2c0
+
+#define SE_CRYPTO_CONFIG_0                                      0x304
+#define SE_CRYPTO_CONFIG_0_HASH_ENB_RANGE                       0:0
+#define SE_CRYPTO_CONFIG_0_HASH_ENB_DISABLE                     _MK_ENUM_CONST(0)
+#define SE_CRYPTO_CONFIG_0_HASH_ENB_ENABLE                      _MK_ENUM_CONST(1)
+#define SE_CRYPTO_CONFIG_0_XOR_POS_RANGE                        2:1
+#define SE_CRYPTO_CONFIG_0_XOR_POS_BYPASS                       _MK_ENUM_CONST(0)
+#define SE_CRYPTO_CONFIG_0_XOR_POS_TOP                          _MK_ENUM_CONST(2)
+#define SE_CRYPTO_CONFIG_0_XOR_POS_BOTTOM                       _MK_ENUM_CONST(3)
+#define SE_CRYPTO_CONFIG_0_VCTRAM_SEL_RANGE                     6:5
+#define SE_CRYPTO_CONFIG_0_VCTRAM_SEL_INIT_AESOUT               _MK_ENUM_CONST(2)
+#define SE_CRYPTO_CONFIG_0_VCTRAM_SEL_INIT_PREV_MEMORY          _MK_ENUM_CONST(3)
+#define SE_CRYPTO_CONFIG_0_IV_SELECT_RANGE                      7:7
+#define SE_CRYPTO_CONFIG_0_IV_SELECT_ORIGINAL                   _MK_ENUM_CONST(0)
+#define SE_CRYPTO_CONFIG_0_IV_SELECT_UPDATED                    _MK_ENUM_CONST(1)
+#define SE_CRYPTO_CONFIG_0_CORE_SEL_RANGE                       8:8
+#define SE_CRYPTO_CONFIG_0_CORE_SEL_DECRYPT                     _MK_ENUM_CONST(0)
+#define SE_CRYPTO_CONFIG_0_CORE_SEL_ENCRYPT                     _MK_ENUM_CONST(1)
+#define SE_CRYPTO_CONFIG_0_KEY_INDEX_SHIFT                      24
+#define SE_CRYPTO_CONFIG_0_KEY_INDEX_FIELD                      (0xf << 24)
+#define SE_CRYPTO_CONFIG_0_MEMIF_RANGE                          31:31
+#define SE_CRYPTO_CONFIG_0_MEMIF_AHB                            _MK_ENUM_CONST(0)
+
+#define SE_CRYPTO_LAST_BLOCK_0                                  0x318
+#define SE_CRYPTO_KEYTABLE_ADDR_0                               0x31c
+#define SE_CRYPTO_KEYTABLE_DATA_0                               0x320
+#define SE_CRYPTO_KEYTABLE_DST_0                                0x330
+#define SE_CRYPTO_KEYTABLE_DST_0_KEY_INDEX_RANGE                11:8
+#define SE_CRYPTO_KEYTABLE_DST_0_WORD_QUAD_RANGE                1:0
+#define SE_CRYPTO_KEYTABLE_DST_0_WORD_QUAD_KEYS_0_3             _MK_ENUM_CONST(0)
+#define SE_CRYPTO_KEYTABLE_DST_0_WORD_QUAD_KEYS_4_7             _MK_ENUM_CONST(1)
+
+#define SE_RSA_CONFIG_0                                         0x408
+#define SE_RSA_CONFIG_0_KEY_SLOT_RANGE                          0:0
+#define SE_RSA_KEY_SIZE_0                                       0x40c
+#define SE_RSA_KEY_SIZE_0_VAL_WIDTH_512                         _MK_ENUM_CONST(0)
+#define SE_RSA_KEY_SIZE_0_VAL_WIDTH_1024                        _MK_ENUM_CONST(1)
+#define SE_RSA_KEY_SIZE_0_VAL_WIDTH_1536                        _MK_ENUM_CONST(2)
+#define SE_RSA_KEY_SIZE_0_VAL_WIDTH_2048                        _MK_ENUM_CONST(3)
+#define SE_RSA_EXP_SIZE_0                                       0x410
+#define SE_RSA_SECURITY_PERKEY_0                                0x440
+#define SE_RSA_KEYTABLE_ACCESS_0                                0x444
+#define SE_RSA_KEYTABLE_ACCESS_1                                0x448
+#define SE_RSA_KEYTABLE_ADDR_0                                  0x458
+#define SE_RSA_KEYTABLE_ADDR_0_PKT_FIELD                        (0x1ff << 0)
+#define SE_RSA_KEYTABLE_DATA_0                                  0x45c
+
+#define SE_STATUS_0                                             0x800
+#define SE_STATUS_0_STATE_RANGE                                 1:0
+#define SE_STATUS_0_STATE_IDLE                                  _MK_ENUM_CONST(0)
+#define SE_STATUS_0_STATE_BUSY                                  _MK_ENUM_CONST(1)
+#define SE_STATUS_0_MEM_INTERFACE_RANGE                         2:2
+#define SE_STATUS_0_MEM_INTERFACE_IDLE                          _MK_ENUM_CONST(0)
+
+#endif // INCLUDED_ARSE_H
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * arusb.h - Host stand-in for the generated USB2 controller header, with
+ * only the fields the host builds use.
+ *
+ * The register offsets and fields follow the ChipIdea device controller
+ * the USB2D block is built on. The queue heads sit in controller memory;
+ * the stand-in puts them one page above the registers, where the usbf
+ * harness maps host memory.
+ */
+
+#ifndef INCLUDED_ARUSB_H
+#define INCLUDED_ARUSB_H
+
+#define USB2_CONTROLLER_USB2D_USBCMD_0                          0x130
+#define USB2_CONTROLLER_USB2D_USBCMD_0_RS_RANGE                 0:0
+#define USB2_CONTROLLER_USB2D_USBCMD_0_RS_STOP                  0
+#define USB2_CONTROLLER_USB2D_USBCMD_0_RS_RUN                   1
+
+#define USB2_CONTROLLER_USB2D_USBSTS_0                          0x134
+#define USB2_CONTROLLER_USB2D_USBSTS_0_UI_RANGE                 0:0
+#define USB2_CONTROLLER_USB2D_USBSTS_0_UI_INT                   1
+#define USB2_CONTROLLER_USB2D_USBSTS_0_UEI_RANGE                1:1
+#define USB2_CONTROLLER_USB2D_USBSTS_0_UEI_ERROR                1
+#define USB2_CONTROLLER_USB2D_USBSTS_0_PCI_RANGE                2:2
+#define USB2_CONTROLLER_USB2D_USBSTS_0_PCI_PORT_CHANGE          1
+#define USB2_CONTROLLER_USB2D_USBSTS_0_FRI_RANGE                3:3
+#define USB2_CONTROLLER_USB2D_USBSTS_0_FRI_ROLLOVER             1
+#define USB2_CONTROLLER_USB2D_USBSTS_0_SEI_RANGE                4:4
+#define USB2_CONTROLLER_USB2D_USBSTS_0_SEI_ERROR                1
+#define USB2_CONTROLLER_USB2D_USBSTS_0_AAI_RANGE                5:5
+#define USB2_CONTROLLER_USB2D_USBSTS_0_AAI_ADVANCED             1
+#define USB2_CONTROLLER_USB2D_USBSTS_0_URI_RANGE                6:6
+#define USB2_CONTROLLER_USB2D_USBSTS_0_URI_USB_RESET            1
+#define USB2_CONTROLLER_USB2D_USBSTS_0_SRI_RANGE                7:7
+#define USB2_CONTROLLER_USB2D_USBSTS_0_SRI_SOF_RCVD             1
+#define USB2_CONTROLLER_USB2D_USBSTS_0_SLI_RANGE                8:8
+#define USB2_CONTROLLER_USB2D_USBSTS_0_SLI_SUSPENDED            1
+
+#define USB2_CONTROLLER_USB2D_PERIODICLISTBASE_0                0x144
+#define USB2_CONTROLLER_USB2D_PERIODICLISTBASE_0_RESET_VAL      0
+#define USB2_CONTROLLER_USB2D_PERIODICLISTBASE_0_USBADR_RANGE   31:25
+
+#define USB2_CONTROLLER_USB2D_ASYNCLISTADDR_0                   0x148
+
+#define USB2_CONTROLLER_USB2D_HOSTPC1_DEVLC_0                   0x1b4
+#define USB2_CONTROLLER_USB2D_HOSTPC1_DEVLC_0_ASUS_RANGE        17:17
+#define USB2_CONTROLLER_USB2D_HOSTPC1_DEVLC_0_ASUS_DISABLE      0
+#define USB2_CONTROLLER_USB2D_HOSTPC1_DEVLC_0_PSPD_RANGE        26:25
+
+#define USB2_CONTROLLER_USB2D_ENDPTSETUPSTAT_0                  0x208
+#define USB2_CONTROLLER_USB2D_ENDPTSETUPSTAT_0_ENDPTSETUPSTAT0_RANGE 0:0
+#define USB2_CONTROLLER_USB2D_ENDPTSETUPSTAT_0_ENDPTSETUPSTAT0_SETUP_RCVD 1
+
+#define USB2_CONTROLLER_USB2D_ENDPTPRIME_0                      0x20c
+#define USB2_CONTROLLER_USB2D_ENDPTFLUSH_0                      0x210
+#define USB2_CONTROLLER_USB2D_ENDPTSTATUS_0                     0x214
+#define USB2_CONTROLLER_USB2D_ENDPTCOMPLETE_0                   0x218
+
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL0_0                      0x21c
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL0_0_RXS_RANGE            0:0
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL0_0_RXS_EP_OK            0
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL0_0_RXS_EP_STALL         1
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL0_0_RXT_RANGE            3:2
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL0_0_RXT_CTRL             0
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL0_0_RXE_RANGE            7:7
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL0_0_RXE_ENABLE           1
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL0_0_TXS_RANGE            16:16
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL0_0_TXS_EP_OK            0
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL0_0_TXS_EP_STALL         1
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL0_0_TXT_RANGE            19:18
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL0_0_TXT_CTRL             0
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL0_0_TXE_RANGE            23:23
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL0_0_TXE_ENABLE           1
+
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0                      0x220
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_RXS_RANGE            0:0
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_RXS_EP_OK            0
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_RXT_RANGE            3:2
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_RXT_BULK             2
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_RXR_RANGE            6:6
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_RXR_RESET_PID_SEQ    1
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_RXE_RANGE            7:7
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_RXE_ENABLE           1
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_TXS_RANGE            16:16
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_TXS_EP_OK            0
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_TXT_RANGE            19:18
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_TXT_BULK             2
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_TXR_RANGE            22:22
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_TXR_RESET_PID_SEQ    1
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_TXE_RANGE            23:23
+#define USB2_CONTROLLER_USB2D_ENDPTCTRL1_0_TXE_ENABLE           1
+
+// Queue head fields. The driver reads each one out of the word that has it.
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_IOC_RANGE     15:15
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_IOC_ENABLE    1
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_MAX_PACKET_LENGTH_RANGE 26:16
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_ZLT_RANGE     29:29
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_ZLT_ZERO_LENGTH_TERM_DISABLED 1
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_NEXT_DTD_PTR_RANGE 31:5
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_TERMINATE_RANGE 0:0
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_TERMINATE_CLEAR 0
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_TERMINATE_SET 1
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_TOTAL_BYTES_RANGE 30:16
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_ACTIVE_RANGE  7:7
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_ACTIVE_SET    1
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_HALTED_RANGE  6:6
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_HALTED_SET    1
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_DATA_BUFFER_ERROR_RANGE 5:5
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_DATA_BUFFER_ERROR_SET 1
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_TRANSACTION_ERROR_RANGE 3:3
+#define USB2_CONTROLLER_USB2D_DEVICE_QUEUE_HEAD_0_TRANSACTION_ERROR_SET 1
+
+#define USB2_CONTROLLER_USB2D_DEVICE_TRANSFER_DESCRIPTOR_0_TERMINATE_RANGE 0:0
+#define USB2_CONTROLLER_USB2D_DEVICE_TRANSFER_DESCRIPTOR_0_TERMINATE_SET 1
+#define USB2_CONTROLLER_USB2D_DEVICE_TRANSFER_DESCRIPTOR_0_TOTAL_BYTES_RANGE 30:16
+#define USB2_CONTROLLER_USB2D_DEVICE_TRANSFER_DESCRIPTOR_0_ACTIVE_RANGE 7:7
+#define USB2_CONTROLLER_USB2D_DEVICE_TRANSFER_DESCRIPTOR_0_ACTIVE_SET 1
+
+#define USB2_QH_USB2D_QH_EP_0_OUT_0                             0x1000
+
+#endif // INCLUDED_ARUSB_H
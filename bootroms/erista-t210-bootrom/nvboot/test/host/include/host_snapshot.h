@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * host_snapshot.h - Forced into every host harness build.
+ *
+ * This tree is a snapshot: some generated headers are missing. The host
+ * build defines what the sources use from them here.
+ */
+
+#ifndef INCLUDED_HOST_SNAPSHOT_H
+#define INCLUDED_HOST_SNAPSHOT_H
+
+// Address map entries from the missing generated headers.
+#define NV_ADDRESS_MAP_IROM_BASE                             0x00100000
+#define NV_ADDRESS_MAP_IROM_SIZE                             0x00018000
+#define NV_ADDRESS_MAP_IRAM_A_BASE                           0x40000000
+#define NV_ADDRESS_MAP_IRAM_D_LIMIT                          0x4003ffff
+#define NV_ADDRESS_MAP_DATAMEM_IRAM_D_LIMIT                  0x4003ffff
+#define NV_ADDRESS_MAP_TMRUS_BASE                            0x60005010
+#define NV_ADDRESS_MAP_CAR_BASE                              0x60006000
+#define NV_ADDRESS_MAP_APB_MISC_BASE                         0x70000000
+#define NV_ADDRESS_MAP_PMC_BASE                              0x7000e400
+#define NV_ADDRESS_MAP_SE_BASE                               0x70012000
+#define NV_ADDRESS_MAP_TZRAM_BASE                            0x7c010000
+#define NV_ADDRESS_MAP_USB_BASE                              0x7d000000
+
+#endif // INCLUDED_HOST_SNAPSHOT_H
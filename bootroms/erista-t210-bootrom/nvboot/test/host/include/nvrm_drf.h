@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * nvrm_drf.h - Host stand-in for the register field macros, with only the
+ * ones the host builds use. A field range is written "high:low", which
+ * the ?: operator splits.
+ */
+
+#ifndef INCLUDED_NVRM_DRF_H
+#define INCLUDED_NVRM_DRF_H
+
+#define NV_FIELD_LOWBIT(x)      (0?x)
+#define NV_FIELD_HIGHBIT(x)     (1?x)
+#define NV_FIELD_SIZE(x)        (NV_FIELD_HIGHBIT(x) - NV_FIELD_LOWBIT(x) + 1)
+#define NV_FIELD_SHIFT(x)       ((0?x) % 32)
+#define NV_FIELD_MASK(x)        (0xFFFFFFFFUL >> (31 - ((1?x) % 32) + ((0?x) % 32)))
+#define NV_FIELD_SHIFTMASK(x)   (NV_FIELD_MASK(x) << (NV_FIELD_SHIFT(x)))
+
+#define NV_RESETVAL(d,r)        (d##_##r##_0_RESET_VAL)
+
+#define NV_DRF_DEF(d,r,f,c) \
+    ((d##_##r##_0_##f##_##c) << NV_FIELD_SHIFT(d##_##r##_0_##f##_RANGE))
+#define NV_DRF_NUM(d,r,f,n) \
+    (((n) & NV_FIELD_MASK(d##_##r##_0_##f##_RANGE)) << \
+     NV_FIELD_SHIFT(d##_##r##_0_##f##_RANGE))
+#define NV_DRF_VAL(d,r,f,v) \
+    (((v) >> NV_FIELD_SHIFT(d##_##r##_0_##f##_RANGE)) & \
+     NV_FIELD_MASK(d##_##r##_0_##f##_RANGE))
+#define NV_FLD_SET_DRF_NUM(d,r,f,n,v) \
+    (((v) & ~NV_FIELD_SHIFTMASK(d##_##r##_0_##f##_RANGE)) | NV_DRF_NUM(d,r,f,n))
+#define NV_FLD_SET_DRF_DEF(d,r,f,c,v) \
+    (((v) & ~NV_FIELD_SHIFTMASK(d##_##r##_0_##f##_RANGE)) | NV_DRF_DEF(d,r,f,c))
+
+#endif // INCLUDED_NVRM_DRF_H
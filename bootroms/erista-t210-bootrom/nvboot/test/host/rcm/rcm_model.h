@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * rcm_model.h - The SE model behind rcm/nvboot_rcm.c in the host harness.
+ *
+ * rcm_se_model.c implements the AES calls of nvboot_se_int.h that the RCM
+ * code makes: key slot writes, CBC decryption and the AES-CMAC steps. The
+ * block cipher is a stand-in, a keyed Feistel network, not AES: the
+ * harness checks which blocks reach the engine, in which order and with
+ * which key slot and subkey, and the host side signs its messages with the
+ * same cipher.
+ *
+ * The model keeps a clock in nanoseconds, shared with the port model of
+ * rcm_test.c. With an SE rate set, each AES operation keeps the engine busy
+ * for its bytes at that rate, every NvBootSeIsEngineBusy() poll that finds
+ * it busy costs RCM_MODEL_POLL_NS, and an operation started while the
+ * engine is still busy is counted as a fault. With no rate set, operations
+ * complete at once and the clock does not move.
+ */
+
+#ifndef INCLUDED_RCM_MODEL_H
+#define INCLUDED_RCM_MODEL_H
+
+#include "nvcommon.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define RCM_MODEL_KEY_BYTES     32
+#define RCM_MODEL_BLOCK_BYTES   16
+#define RCM_MODEL_POLL_NS       20
+
+/** Clears every key slot and the operation counts. */
+void RcmSeModelReset(void);
+
+/** Loads Key into a key slot, as the fuses would for the SBK. */
+void RcmSeModelSetKey(NvU32 Slot, const NvU8 *Key);
+
+/** Operations and AES blocks the engine has been given since the reset. */
+NvU32 RcmSeModelOps(void);
+NvU32 RcmSeModelBlocks(void);
+
+/** Sets the engine rate in MB/s; 0 completes every operation at once. */
+void RcmSeModelSetRate(NvU32 MBPerSecond);
+
+/** CMAC operations started, and operations started while busy. */
+NvU32 RcmSeModelCmacOps(void);
+NvU32 RcmSeModelBusyFaults(void);
+
+/** The time the last CMAC operation that produced a hash completes. */
+NvU64 RcmSeModelHashDone(void);
+
+/** The model clock, and moving it forward to Ns if it is behind. */
+NvU64 RcmModelNow(void);
+void RcmModelAdvanceTo(NvU64 Ns);
+
+/** Host side: CBC-encrypts Bytes of Data in place with Key, from IV 0. */
+void RcmModelCbcEncrypt(const NvU8 *Key, NvU8 *Data, NvU32 Bytes);
+
+/** Host side: the AES-CMAC of Bytes of Data with Key. */
+void RcmModelCmac(const NvU8 *Key, const NvU8 *Data, NvU32 Bytes, NvU8 *Mac);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // INCLUDED_RCM_MODEL_H
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * rcm_se_model.c - Function level model of the SE AES calls made by
+ * rcm/nvboot_rcm.c. See rcm_model.h.
+ *
+ * Each key slot holds a key, an original IV and an updated IV, as on the
+ * engine: a first operation starts from the original IV, or from zero for
+ * the CMAC, and every operation leaves its chaining value in the updated
+ * IV for the next one. The result of an operation is written when it is
+ * started, from the memory as it is then; the clock only decides how long
+ * the engine then reports itself busy.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvcommon.h"
+#include "arse.h"
+#include "nvboot_error.h"
+#include "nvboot_se_aes.h"
+#include "nvboot_se_int.h"
+#include "rcm_model.h"
+
+#define ROUNDS 8
+
+typedef struct
+{
+    NvU8 Key[RCM_MODEL_KEY_BYTES];
+    NvU8 OriginalIv[RCM_MODEL_BLOCK_BYTES];
+    NvU8 UpdatedIv[RCM_MODEL_BLOCK_BYTES];
+} ModelKeySlot;
+
+static ModelKeySlot s_Slots[NvBootSeAesKeySlot_Num];
+static NvU32 s_Ops;
+static NvU32 s_Blocks;
+static NvU32 s_CmacOps;
+static NvU32 s_BusyFaults;
+static NvU32 s_Rate;
+static NvU64 s_Now;
+static NvU64 s_BusyUntil;
+static NvU64 s_HashDone;
+
+/* The splitmix64 finalizer, as the round function. */
+static NvU64 Mix(NvU64 x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+static NvU64 RoundKey(const NvU8 *Key, int Round)
+{
+    NvU64 k;
+
+    memcpy(&k, Key + 8 * (Round & 3), sizeof(k));
+    return k + (NvU64)Round * 0x9e3779b97f4a7c15ull;
+}
+
+static void Cipher(const NvU8 *Key, const NvU8 *In, NvU8 *Out, NvBool Decrypt)
+{
+    NvU64 l, r, t;
+    int i, Round;
+
+    memcpy(&l, In, 8);
+    memcpy(&r, In + 8, 8);
+    for (i = 0; i < ROUNDS; i++)
+    {
+        Round = Decrypt ? ROUNDS - 1 - i : i;
+        if (Decrypt)
+        {
+            t = r;
+            r = l;
+            l = t ^ Mix(l ^ RoundKey(Key, Round));
+        }
+        else
+        {
+            t = l;
+            l = r;
+            r = t ^ Mix(r ^ RoundKey(Key, Round));
+        }
+    }
+    memcpy(Out, &l, 8);
+    memcpy(Out + 8, &r, 8);
+}
+
+static void Xor(NvU8 *Dst, const NvU8 *Src)
+{
+    int i;
+
+    for (i = 0; i < RCM_MODEL_BLOCK_BYTES; i++)
+        Dst[i] ^= Src[i];
+}
+
+/* Multiplication by x in GF(2^128), as RFC 4493 derives the subkeys. */
+static void Double(const NvU8 *In, NvU8 *Out)
+{
+    NvU8 Carry = In[0] & 0x80;
+    int i;
+
+    for (i = 0; i < RCM_MODEL_BLOCK_BYTES - 1; i++)
+        Out[i] = (In[i] << 1) | (In[i + 1] >> 7);
+    Out[RCM_MODEL_BLOCK_BYTES - 1] = In[RCM_MODEL_BLOCK_BYTES - 1] << 1;
+    if (Carry)
+        Out[RCM_MODEL_BLOCK_BYTES - 1] ^= 0x87;
+}
+
+static ModelKeySlot *Slot(NvU8 KeySlot)
+{
+    if (KeySlot >= NvBootSeAesKeySlot_Num)
+    {
+        fprintf(stderr, "rcm: key slot %u out of range\n", KeySlot);
+        abort();
+    }
+    return &s_Slots[KeySlot];
+}
+
+/* Starts an operation on NumBlocks blocks; returns when it completes. */
+static NvU64 Start(NvU32 NumBlocks)
+{
+    if (s_Now < s_BusyUntil)
+    {
+        s_BusyFaults++;
+        s_Now = s_BusyUntil;
+    }
+    s_BusyUntil = s_Now;
+    if (s_Rate)
+        s_BusyUntil += (NvU64)NumBlocks * RCM_MODEL_BLOCK_BYTES * 1000 / s_Rate;
+    s_Ops++;
+    s_Blocks += NumBlocks;
+    return s_BusyUntil;
+}
+
+void RcmSeModelReset(void)
+{
+    memset(s_Slots, 0, sizeof(s_Slots));
+    s_Ops = 0;
+    s_Blocks = 0;
+    s_CmacOps = 0;
+    s_BusyFaults = 0;
+    s_Now = 0;
+    s_BusyUntil = 0;
+    s_HashDone = 0;
+}
+
+void RcmSeModelSetRate(NvU32 MBPerSecond)
+{
+    s_Rate = MBPerSecond;
+}
+
+void RcmSeModelSetKey(NvU32 Slot, const NvU8 *Key)
+{
+    memcpy(s_Slots[Slot].Key, Key, RCM_MODEL_KEY_BYTES);
+}
+
+NvU32 RcmSeModelOps(void)
+{
+    return s_Ops;
+}
+
+NvU32 RcmSeModelBlocks(void)
+{
+    return s_Blocks;
+}
+
+NvU32 RcmSeModelCmacOps(void)
+{
+    return s_CmacOps;
+}
+
+NvU32 RcmSeModelBusyFaults(void)
+{
+    return s_BusyFaults;
+}
+
+NvU64 RcmSeModelHashDone(void)
+{
+    return s_HashDone;
+}
+
+NvU64 RcmModelNow(void)
+{
+    return s_Now;
+}
+
+void RcmModelAdvanceTo(NvU64 Ns)
+{
+    if (s_Now < Ns)
+        s_Now = Ns;
+}
+
+void RcmModelCbcEncrypt(const NvU8 *Key, NvU8 *Data, NvU32 Bytes)
+{
+    NvU8 Iv[RCM_MODEL_BLOCK_BYTES] = { 0 };
+    NvU32 i;
+
+    for (i = 0; i < Bytes; i += RCM_MODEL_BLOCK_BYTES)
+    {
+        Xor(Data + i, Iv);
+        Cipher(Key, Data + i, Data + i, NV_FALSE);
+        memcpy(Iv, Data + i, RCM_MODEL_BLOCK_BYTES);
+    }
+}
+
+void RcmModelCmac(const NvU8 *Key, const NvU8 *Data, NvU32 Bytes, NvU8 *Mac)
+{
+    NvU8 L[RCM_MODEL_BLOCK_BYTES] = { 0 };
+    NvU8 K1[RCM_MODEL_BLOCK_BYTES];
+    NvU8 x[RCM_MODEL_BLOCK_BYTES] = { 0 };
+    NvU32 i;
+
+    Cipher(Key, L, L, NV_FALSE);
+    Double(L, K1);
+    for (i = 0; i < Bytes; i += RCM_MODEL_BLOCK_BYTES)
+    {
+        Xor(x, Data + i);
+        if (i + RCM_MODEL_BLOCK_BYTES == Bytes)
+            Xor(x, K1);
+        Cipher(Key, x, x, NV_FALSE);
+    }
+    memcpy(Mac, x, RCM_MODEL_BLOCK_BYTES);
+}
+
+NvBool NvBootSeIsEngineBusy(void)
+{
+    if (s_Now >= s_BusyUntil)
+        return NV_FALSE;
+    s_Now += RCM_MODEL_POLL_NS;
+    return NV_TRUE;
+}
+
+void NvBootSeKeySlotWriteKeyIV(NvU8 KeySlot, NvU8 KeySize, NvU8 KeyType, NvU32 *KeyData)
+{
+    ModelKeySlot *pSlot = Slot(KeySlot);
+    NvU32 Bytes = 16 + 8 * KeySize;
+
+    switch (KeyType)
+    {
+        case SE_CRYPTO_KEYIV_PKT_WORD_QUAD_KEYS_0_3:
+            memcpy(pSlot->Key, KeyData, Bytes);
+            break;
+        case SE_CRYPTO_KEYIV_PKT_WORD_QUAD_KEYS_4_7:
+            memcpy(pSlot->Key + 16, KeyData, 16);
+            break;
+        case SE_CRYPTO_KEYIV_PKT_WORD_QUAD_ORIGINAL_IVS:
+            if (KeyData)
+                memcpy(pSlot->OriginalIv, KeyData, RCM_MODEL_BLOCK_BYTES);
+            else
+                memset(pSlot->OriginalIv, 0, RCM_MODEL_BLOCK_BYTES);
+            break;
+        default:
+            if (KeyData)
+                memcpy(pSlot->UpdatedIv, KeyData, RCM_MODEL_BLOCK_BYTES);
+            else
+                memset(pSlot->UpdatedIv, 0, RCM_MODEL_BLOCK_BYTES);
+            break;
+    }
+}
+
+void NvBootSeAesDecrypt(
+        NvU8     KeySlot,
+        NvU8     KeySize,
+        NvBool   First,
+        NvU32    NumBlocks,
+        NvU8    *Src,
+        NvU8    *Dst)
+{
+    ModelKeySlot *pSlot = Slot(KeySlot);
+    NvU8 Iv[RCM_MODEL_BLOCK_BYTES];
+    NvU8 In[RCM_MODEL_BLOCK_BYTES];
+    NvU32 i;
+
+    memcpy(Iv, First ? pSlot->OriginalIv : pSlot->UpdatedIv, sizeof(Iv));
+    for (i = 0; i < NumBlocks; i++)
+    {
+        memcpy(In, Src + i * RCM_MODEL_BLOCK_BYTES, sizeof(In));
+        Cipher(pSlot->Key, In, Dst + i * RCM_MODEL_BLOCK_BYTES, NV_TRUE);
+        Xor(Dst + i * RCM_MODEL_BLOCK_BYTES, Iv);
+        memcpy(Iv, In, sizeof(Iv));
+    }
+    memcpy(pSlot->UpdatedIv, Iv, sizeof(Iv));
+    Start(NumBlocks);
+}
+
+void NvBootSeAesCmacGenerateSubkey(
+        NvU8 KeySlot,
+        NvU8 KeySize,
+        NvU32 *pK1,
+        NvU32 *pK2)
+{
+    ModelKeySlot *pSlot = Slot(KeySlot);
+    NvU8 L[RCM_MODEL_BLOCK_BYTES] = { 0 };
+
+    Cipher(pSlot->Key, L, L, NV_FALSE);
+    Double(L, (NvU8 *)pK1);
+    Double((NvU8 *)pK1, (NvU8 *)pK2);
+
+    /* The driver waits for the subkey before it returns. */
+    s_Now = Start(1);
+}
+
+/* Only whole blocks reach the CMAC in RCM, so the last one takes K1. */
+void NvBootSeAesCmacHashBlocks(
+        NvU32 *pK1,
+        NvU32 *pK2,
+        NvU32 *pInputMessage,
+        NvU8 *pHash,
+        NvU8 KeySlot,
+        NvU8 KeySize,
+        NvU32 NumBlocks,
+        NvBool FirstChunk,
+        NvBool LastChunk)
+{
+    ModelKeySlot *pSlot = Slot(KeySlot);
+    const NvU8 *In = (const NvU8 *)pInputMessage;
+    NvU8 x[RCM_MODEL_BLOCK_BYTES];
+    NvU32 i;
+
+    if (FirstChunk)
+        memset(x, 0, sizeof(x));
+    else
+        memcpy(x, pSlot->UpdatedIv, sizeof(x));
+    for (i = 0; i < NumBlocks; i++)
+    {
+        Xor(x, In + i * RCM_MODEL_BLOCK_BYTES);
+        if (LastChunk && (i == NumBlocks - 1))
+            Xor(x, (const NvU8 *)pK1);
+        Cipher(pSlot->Key, x, x, NV_FALSE);
+    }
+    memcpy(pSlot->UpdatedIv, x, sizeof(x));
+    s_CmacOps++;
+    if (LastChunk)
+    {
+        memcpy(pHash, x, sizeof(x));
+        s_HashDone = Start(NumBlocks);
+    }
+    else
+    {
+        Start(NumBlocks);
+    }
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * rcm_stubs.c - The functions nvboot_rcm.c calls only in PKC mode or for a
+ * wrapped provisioning key. The harness runs neither, so reaching any of
+ * these aborts.
+ *
+ * The symbols are defined without their headers, so that one macro fits
+ * all of them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MODEL_STUB(Name)                                        \
+    void Name(void)                                             \
+    {                                                           \
+        fprintf(stderr, "rcm: %s called\n", #Name);             \
+        abort();                                                \
+    }
+
+MODEL_STUB(NvBootFuseGetPublicKeyHash)
+MODEL_STUB(NvBootSeAesDecryptKeyIntoKeySlot)
+MODEL_STUB(NvBootSeRsaPssSignatureVerify)
+MODEL_STUB(NvBootSeRsaWriteKey)
+MODEL_STUB(NvBootSeSHAHash)
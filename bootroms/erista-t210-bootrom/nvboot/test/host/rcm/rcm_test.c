@@ -0,0 +1,719 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of the RCM message receive, rcm/nvboot_rcm.c, over a loopback
+ * USB port.
+ *
+ * NvBootRcm() runs unmodified, with the SE model of rcm_se_model.c. The
+ * port model sends the host's message in 512-byte packets into whatever
+ * buffer the RCM code primes, up to the receive size of the port. A
+ * receive ends when it is full or on a short packet, and the host ends
+ * each of its writes with a short packet. A packet that does not fit in
+ * the primed buffer fails the receive, as a babble would.
+ *
+ * "check" signs DownloadExecute messages with the model cipher and checks
+ * that each one is accepted with the payload in place, for every receive
+ * size, message length and host write size, in NvProduction and in ODM
+ * secure SBK mode, and that bad messages are rejected. It then runs the
+ * port at a USB rate and the SE model at an engine rate, and checks that
+ * the CMAC is fed to the engine during the receive where the key is known
+ * from the header, but not for a first message that selects secure
+ * provisioning, and that no operation is started on a busy engine.
+ * "bench" prints the bytes the RCM code copies with the CPU and the port
+ * receives it starts per message, and the time from the last byte on the
+ * bus to the end of the CMAC. Both run the code of OLD_REV as well when it
+ * is built in.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <sys/mman.h>
+
+#include "nvcommon.h"
+#include "nvboot_error.h"
+#include "nvboot_bit.h"
+#include "nvboot_config_int.h"
+#include "nvboot_fuse_int.h"
+#include "nvboot_rcm.h"
+#include "nvboot_rcm_int.h"
+#include "nvboot_rcm_port_int.h"
+#include "nvboot_se_aes.h"
+#include "rcm_model.h"
+
+#define HEADER          sizeof(NvBootRcmMsg)
+#define OFFSET          offsetof(NvBootRcmMsg, RandomAesBlock)
+#define PACKET          512
+#define OVERSEND        PACKET
+#define CANARY          0xa5
+#define ONE_SHOT        0xffffffff
+#define USB_RATE        40      /* MB/s, the bench and the timed checks */
+#define PROVISIONING_KEY_NUM    20
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "rcm: %s:%d: %s\n", __FILE__, __LINE__,     \
+                    #Cond);                                             \
+        }                                                               \
+    } while (0)
+
+typedef NvBootError (*RcmFn)(NvBool IsForced,
+                             NvBool *IsFactorySecureProvisioning,
+                             NvU32 *RcmSecureDebugControl,
+                             NvU32 *EntryPoint);
+
+#if HOST_HAVE_OLD
+NvBootError OldNvBootRcm(NvBool IsForced,
+                         NvBool *IsFactorySecureProvisioning,
+                         NvU32 *RcmSecureDebugControl,
+                         NvU32 *EntryPoint);
+#endif
+
+static const struct
+{
+    const char *Name;
+    RcmFn Rcm;
+} s_Versions[] =
+{
+    { "new", NvBootRcm },
+#if HOST_HAVE_OLD
+    { "old", OldNvBootRcm },
+#endif
+};
+
+#define NUM_VERSIONS (sizeof(s_Versions) / sizeof(s_Versions[0]))
+
+/* Loopback port: the host side and the last receive the device primed. */
+typedef struct
+{
+    const NvU8 *Data;
+    NvU32 Bytes;
+    NvU32 Pos;
+    NvU32 WriteBytes;
+    NvU32 MaxReceive;
+    NvU8 *RxBuffer;
+    NvU32 RxBytes;
+    NvU32 Receives;
+    NvU32 IdsSent;
+    NvU32 Responses;
+    NvU32 Response;
+    NvU32 Stalls;
+    NvU32 Split;            /* a message boundary the host writes stop at */
+    NvU32 UsbRate;          /* MB/s, 0 for no time on the bus */
+    NvU64 StartNs;          /* when the last receive was primed */
+    NvU64 LinkNs;           /* when the bus is done with the last packet */
+    NvU64 LastByteNs;       /* when the last byte of the host data landed */
+    NvU32 CmacOpsAtSplit;   /* CMAC operations before the second message */
+    NvU32 CmacOpsAtEnd;     /* CMAC operations before the last byte */
+} LoopbackPort;
+
+static LoopbackPort s_Loop;
+static NvBootRCMPort_T s_Port;
+
+/* Globals of the Boot ROM that nvboot_rcm.c uses. */
+NvBootInfoTable BootInfoTable;
+NvU32 NvBootBootromVersionAddress[3];
+static NvU8 s_BufferMemory[2][NVBOOT_BUFFER_LENGTH] __attribute__((aligned(4096)));
+NvU8 *Buffer[2] = { s_BufferMemory[0], s_BufferMemory[1] };
+
+static NvBootFuseOperatingMode s_OpMode;
+static NvU8 s_Key[RCM_MODEL_KEY_BYTES];
+static NvU8 s_HostMsg[2 * NVBOOT_RCM_MAX_MSG_LENGTH + OVERSEND];
+static NvU8 s_Expected[NVBOOT_BL_IRAM_SIZE];
+static NvU32 s_CopyBytes;
+static NvU32 s_Split;
+static NvU32 s_UsbRate;
+
+/* The secure provisioning keys at the end of IROM. */
+static NvBootAes256Key *const s_ProvisioningKeys =
+    (NvBootAes256Key *)NVBOOT_FACTORY_SECURE_PROVISIONING_KEYS_START;
+
+/*
+ * nvboot_rcm.o has its memcpy() calls renamed to this at build time, so
+ * that the copies the CPU makes can be counted.
+ */
+void *RcmCountedMemcpy(void *Dst, const void *Src, size_t Bytes)
+{
+    s_CopyBytes += Bytes;
+    return memcpy(Dst, Src, Bytes);
+}
+
+void NvBootWdtReload(NvU32 WatchdogTimeout)
+{
+}
+
+void NvBootFuseGetOperatingMode(NvBootFuseOperatingMode *pMode)
+{
+    *pMode = s_OpMode;
+}
+
+void NvBootFuseGetUniqueId(NvBootECID *pId)
+{
+    pId->ECID_0 = 0x12345678;
+    pId->ECID_1 = 0x9abcdef0;
+    pId->ECID_2 = 0x0fedcba9;
+    pId->ECID_3 = 0;
+}
+
+/* As fuse/nvboot_fuse.c with the anti-cloning fuse not burnt. */
+NvBootError NvBootFuseIsSecureProvisioningMode(NvU32 SecProvisioningKeyNum)
+{
+    if ((s_OpMode != NvBootFuseOperatingMode_NvProduction) ||
+        (SecProvisioningKeyNum ==
+         NvBootSeAesSecProvisioningKey_SecProvisiningDisabled))
+        return NvBootError_SecProvisioningDisabled;
+    if ((SecProvisioningKeyNum >= NvBootSeAesSecProvisioningKey_RegularKeyStart) &&
+        (SecProvisioningKeyNum <= NvBootSeAesSecProvisioningKey_RegularKeyEnd))
+        return NvBootError_SecProvisioningEnabled;
+    return NvBootError_SecProvisioningInvalidKeyInput;
+}
+
+NvU32 NvBootFuseGetSecureProvisionIndex(void)
+{
+    return 0;
+}
+
+NvBootError NvBootFuseGetSecureProvisioningIndexValidity(void)
+{
+    return NvBootError_SecProvisioningAntiCloningKeyDisabled;
+}
+
+static NvBootError LoopInit(void)
+{
+    return NvBootError_Success;
+}
+
+static NvBootError LoopConnect(NvU8 *OptionalBuffer)
+{
+    return NvBootError_Success;
+}
+
+static NvBootError LoopReceiveStart(NvU8 *Buffer, NvU32 Bytes)
+{
+    s_Loop.RxBuffer = Buffer;
+    s_Loop.RxBytes = NV_MIN(Bytes, s_Loop.MaxReceive);
+    s_Loop.Receives++;
+    s_Loop.StartNs = RcmModelNow();
+    return NvBootError_Success;
+}
+
+static NvBootError LoopReceivePoll(NvU32 *pBytesReceived, NvU32 TimeoutMs,
+                                   NvU8 *OptionalBuffer)
+{
+    NvU32 Received = 0;
+    NvU32 WriteEnd;
+    NvU32 Packet;
+
+    NvU64 Done;
+
+    *pBytesReceived = 0;
+    if (s_Loop.Pos == s_Loop.Bytes)
+        return NvBootError_HwTimeOut;
+    if (s_Loop.Split && (s_Loop.Pos == s_Loop.Split))
+        s_Loop.CmacOpsAtSplit = RcmSeModelCmacOps();
+
+    while ((Received < s_Loop.RxBytes) && (s_Loop.Pos < s_Loop.Bytes))
+    {
+        WriteEnd = s_Loop.Bytes;
+        if (s_Loop.WriteBytes != ONE_SHOT)
+            WriteEnd = NV_MIN(WriteEnd, (s_Loop.Pos / s_Loop.WriteBytes + 1) *
+                                        s_Loop.WriteBytes);
+        if (s_Loop.Pos < s_Loop.Split)
+            WriteEnd = NV_MIN(WriteEnd, s_Loop.Split);
+        Packet = NV_MIN(PACKET, WriteEnd - s_Loop.Pos);
+        if (Packet > s_Loop.RxBytes - Received)
+            return NvBootError_TxferFailed;
+
+        memcpy(s_Loop.RxBuffer + Received, s_Loop.Data + s_Loop.Pos, Packet);
+        Received += Packet;
+        s_Loop.Pos += Packet;
+
+        // The host ends a message with a short or zero length packet.
+        if ((Packet < PACKET) || (s_Loop.Pos == s_Loop.Split))
+            break;
+    }
+
+    // The host sends as soon as the receive is primed and the bus is free.
+    if (s_Loop.UsbRate)
+    {
+        Done = (s_Loop.LinkNs > s_Loop.StartNs) ? s_Loop.LinkNs :
+                                                  s_Loop.StartNs;
+        Done += (NvU64)Received * 1000 / s_Loop.UsbRate;
+        s_Loop.LinkNs = Done;
+        RcmModelAdvanceTo(Done);
+    }
+    if (s_Loop.Pos == s_Loop.Bytes)
+    {
+        s_Loop.LastByteNs = RcmModelNow();
+        s_Loop.CmacOpsAtEnd = RcmSeModelCmacOps();
+    }
+    *pBytesReceived = Received;
+    return NvBootError_Success;
+}
+
+static NvBootError LoopReceive(NvU8 *Buffer, NvU32 Bytes, NvU32 *pBytesReceived)
+{
+    LoopReceiveStart(Buffer, Bytes);
+    return LoopReceivePoll(pBytesReceived, 0, NULL);
+}
+
+static NvBootError LoopTransferStart(NvU8 *Buffer, NvU32 Bytes)
+{
+    s_Loop.IdsSent++;
+    return NvBootError_Success;
+}
+
+static NvBootError LoopTransferPoll(NvU32 *pBytesTransferred, NvU32 TimeoutMs,
+                                    NvU8 *OptionalBuffer)
+{
+    *pBytesTransferred = sizeof(NvBootECID);
+    return NvBootError_Success;
+}
+
+static NvBootError LoopTransfer(NvU8 *Buffer, NvU32 Bytes, NvU32 *pBytesTransferred)
+{
+    memcpy(&s_Loop.Response, Buffer, sizeof(s_Loop.Response));
+    s_Loop.Responses++;
+    *pBytesTransferred = Bytes;
+    return NvBootError_Success;
+}
+
+static NvBootError LoopHandleError(void)
+{
+    s_Loop.Stalls++;
+    return NvBootError_Success;
+}
+
+NvBootRCMPort_T *NvBootRcmGetPortHandle(void)
+{
+    return &s_Port;
+}
+
+static void MapIram(void)
+{
+    void *p;
+
+    p = mmap((void *)NVBOOT_BL_IRAM_START, NVBOOT_BL_IRAM_SIZE,
+             PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (p != (void *)NVBOOT_BL_IRAM_START)
+    {
+        fprintf(stderr, "rcm: cannot map IRAM at 0x%x\n", NVBOOT_BL_IRAM_START);
+        exit(1);
+    }
+}
+
+/* The page at the end of IROM that holds the provisioning keys. */
+static void MapIromKeys(void)
+{
+    void *p;
+
+    p = mmap((void *)NVBOOT_FACTORY_SECURE_PROVISIONING_KEYS_START, 0x1000,
+             PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (p != (void *)NVBOOT_FACTORY_SECURE_PROVISIONING_KEYS_START)
+    {
+        fprintf(stderr, "rcm: cannot map IROM at 0x%x\n",
+                NVBOOT_FACTORY_SECURE_PROVISIONING_KEYS_START);
+        exit(1);
+    }
+}
+
+static void SetUp(void)
+{
+    NvU8 *pKeys;
+    int i;
+
+    MapIram();
+    MapIromKeys();
+
+    s_Port.Context.PortId = RCM_USB_OTG;
+    s_Port.Init = LoopInit;
+    s_Port.Connect = LoopConnect;
+    s_Port.ReceiveStart = LoopReceiveStart;
+    s_Port.ReceivePoll = LoopReceivePoll;
+    s_Port.Receive = LoopReceive;
+    s_Port.TransferStart = LoopTransferStart;
+    s_Port.TransferPoll = LoopTransferPoll;
+    s_Port.Transfer = LoopTransfer;
+    s_Port.HandleError = LoopHandleError;
+
+    for (i = 0; i < RCM_MODEL_KEY_BYTES; i++)
+        s_Key[i] = 0x11 * (i + 1);
+
+    pKeys = (NvU8 *)s_ProvisioningKeys;
+    for (i = 0; i < 64 * sizeof(NvBootAes256Key); i++)
+        pKeys[i] = i * 7 + 3;
+}
+
+/* The length of a message with PayloadBytes of payload, padding included. */
+static NvU32 MessageLength(NvU32 PayloadBytes)
+{
+    NvU32 Length = HEADER + PayloadBytes;
+
+    Length += (NVBOOT_SE_AES_BLOCK_LENGTH_BYTES -
+               (Length - OFFSET) % NVBOOT_SE_AES_BLOCK_LENGTH_BYTES) %
+              NVBOOT_SE_AES_BLOCK_LENGTH_BYTES;
+    while (Length < NVBOOT_RCM_MIN_MSG_LENGTH)
+        Length += NVBOOT_SE_AES_BLOCK_LENGTH_BYTES;
+    return Length;
+}
+
+/*
+ * Builds a signed message at pHost, with the SBK or, for a KeyNum other
+ * than 0, with that secure provisioning key. For DownloadExecute the plain
+ * payload area it should leave is put in s_Expected. Returns its length.
+ */
+static NvU32 BuildMessageAt(NvU8 *pHost, NvU32 Opcode, NvU32 PayloadBytes,
+                            NvU32 KeyNum, NvBool Encrypt)
+{
+    NvBootRcmMsg *pMsg = (NvBootRcmMsg *)pHost;
+    NvU32 Length = MessageLength(PayloadBytes);
+    const NvU8 *Key = KeyNum ? (const NvU8 *)&s_ProvisioningKeys[KeyNum] :
+                               s_Key;
+    NvU32 i;
+
+    memset(pHost, 0, Length);
+    for (i = 0; i < PayloadBytes; i++)
+        pHost[HEADER + i] = rand();
+    if (Length > HEADER + PayloadBytes)
+        pHost[HEADER + PayloadBytes] = 0x80;
+    for (i = 0; i < sizeof(pMsg->RandomAesBlock.hash) / sizeof(NvU32); i++)
+        pMsg->RandomAesBlock.hash[i] = rand();
+
+    pMsg->LengthInsecure = Length;
+    pMsg->LengthSecure = Length;
+    pMsg->PayloadLength = PayloadBytes;
+    pMsg->Opcode = Opcode;
+    pMsg->SecProvisioningKeyNum_Insecure = KeyNum;
+    pMsg->SecProvisioningKeyNum_Secure = KeyNum;
+    pMsg->Args.DownloadData.EntryPoint = NVBOOT_RCM_DLOAD_BASE_ADDRESS;
+    pMsg->Padding[0] = 0x80;
+    if (Opcode == NvBootRcmOpcode_DownloadExecute)
+        memcpy(s_Expected, pHost + HEADER, Length - HEADER);
+
+    if (Encrypt)
+        RcmModelCbcEncrypt(Key, pHost + OFFSET, Length - OFFSET);
+    RcmModelCmac(Key, pHost + OFFSET, Length - OFFSET,
+                 (NvU8 *)&pMsg->Signature.CryptoHash);
+    return Length;
+}
+
+/* A DownloadExecute message in s_HostMsg, signed with the SBK. */
+static NvU32 BuildMessage(NvU32 PayloadBytes, NvBool Encrypt)
+{
+    return BuildMessageAt(s_HostMsg, NvBootRcmOpcode_DownloadExecute,
+                          PayloadBytes, 0, Encrypt);
+}
+
+/* Sends Bytes of s_HostMsg to one version of NvBootRcm(). */
+static NvBootError Run(RcmFn Rcm, NvU32 Bytes, NvU32 WriteBytes,
+                       NvU32 MaxReceive, NvU32 *pEntryPoint)
+{
+    NvBool IsFactorySecureProvisioning;
+    NvU32 SecureDebugControl;
+
+    memset(&s_Loop, 0, sizeof(s_Loop));
+    s_Loop.Data = s_HostMsg;
+    s_Loop.Bytes = Bytes;
+    s_Loop.WriteBytes = WriteBytes;
+    s_Loop.MaxReceive = MaxReceive;
+    s_Loop.Split = s_Split;
+    s_Loop.UsbRate = s_UsbRate;
+    s_Port.Context.Initialized = NV_TRUE;
+    s_Port.Context.Connected = NV_FALSE;
+
+    RcmSeModelReset();
+    RcmSeModelSetKey(NvBootSeAesKeySlot_SBK_AES_Decrypt, s_Key);
+    RcmSeModelSetKey(NvBootSeAesKeySlot_SBK_AES_CMAC_Hash, s_Key);
+
+    memset((void *)NVBOOT_BL_IRAM_START, CANARY, NVBOOT_BL_IRAM_SIZE);
+    s_CopyBytes = 0;
+    *pEntryPoint = 0;
+    return Rcm(NV_FALSE, &IsFactorySecureProvisioning, &SecureDebugControl,
+               pEntryPoint);
+}
+
+/* The payload area after Length - HEADER bytes is untouched. */
+static NvBool IsCanaryIntact(NvU32 Length)
+{
+    const NvU8 *p = (const NvU8 *)NVBOOT_BL_IRAM_START;
+    NvU32 i;
+
+    for (i = Length - HEADER; i < NVBOOT_BL_IRAM_SIZE; i++)
+    {
+        if (p[i] != CANARY)
+            return NV_FALSE;
+    }
+    return NV_TRUE;
+}
+
+static void CheckDelivery(void)
+{
+    static const NvU32 MaxReceives[] = { 4096, 16384, 65536 };
+    static const NvU32 WriteSizes[] = { 512, 4096, 65536, ONE_SHOT };
+    const NvU32 Payloads[] =
+    {
+        1, 3001, 65543, NVBOOT_BL_IRAM_SIZE - NVBOOT_SE_AES_BLOCK_LENGTH_BYTES
+    };
+    static const NvBootFuseOperatingMode Modes[] =
+    {
+        NvBootFuseOperatingMode_NvProduction,
+        NvBootFuseOperatingMode_OdmProductionSecureSBK,
+    };
+    NvU32 m, r, p, w, v, Length, EntryPoint;
+    NvBootError e;
+
+    for (m = 0; m < sizeof(Modes) / sizeof(Modes[0]); m++)
+    for (r = 0; r < sizeof(MaxReceives) / sizeof(MaxReceives[0]); r++)
+    for (p = 0; p < sizeof(Payloads) / sizeof(Payloads[0]); p++)
+    for (w = 0; w < sizeof(WriteSizes) / sizeof(WriteSizes[0]); w++)
+    {
+        s_OpMode = Modes[m];
+        Length = BuildMessage(Payloads[p],
+            s_OpMode == NvBootFuseOperatingMode_OdmProductionSecureSBK);
+
+        for (v = 0; v < NUM_VERSIONS; v++)
+        {
+            e = Run(s_Versions[v].Rcm, Length, WriteSizes[w], MaxReceives[r],
+                    &EntryPoint);
+            CHECK(e == NvBootError_Success);
+            CHECK(EntryPoint == NVBOOT_RCM_DLOAD_BASE_ADDRESS);
+            CHECK(s_Loop.Pos == Length);
+            CHECK(s_Loop.IdsSent == 1);
+            CHECK((s_Loop.Responses == 1) &&
+                  (s_Loop.Response == NvBootRcmResponse_Success));
+            CHECK(!memcmp((void *)NVBOOT_BL_IRAM_START, s_Expected,
+                          Length - HEADER));
+            CHECK(IsCanaryIntact(Length));
+            if (e != NvBootError_Success)
+                fprintf(stderr, "rcm: %s mode %u, receive %u, payload %u, "
+                        "write %u: error 0x%x\n", s_Versions[v].Name,
+                        s_OpMode, MaxReceives[r], Payloads[p], WriteSizes[w],
+                        e);
+        }
+
+        // Only the reads up to the end of the header use the bounce buffer.
+        e = Run(NvBootRcm, Length, WriteSizes[w], MaxReceives[r], &EntryPoint);
+        CHECK(s_CopyBytes <= NV_MIN(MaxReceives[r], NVBOOT_BUFFER_LENGTH));
+    }
+}
+
+static void CheckErrors(void)
+{
+    NvU32 v, Length, EntryPoint;
+    NvBootRcmMsg *pMsg = (NvBootRcmMsg *)s_HostMsg;
+    NvBootError e;
+
+    s_OpMode = NvBootFuseOperatingMode_OdmProductionSecureSBK;
+    for (v = 0; v < NUM_VERSIONS; v++)
+    {
+        // The host sends a packet more than the message: nothing lands past
+        // the end of the message, and the message is refused.
+        Length = BuildMessage(4096, NV_TRUE);
+        memset(s_HostMsg + Length, 0x5a, OVERSEND);
+        e = Run(s_Versions[v].Rcm, Length + OVERSEND, ONE_SHOT, 65536,
+                &EntryPoint);
+        CHECK(e != NvBootError_Success);
+        CHECK(EntryPoint == 0);
+        CHECK(IsCanaryIntact(Length));
+
+        // An insecure length below the minimum stops the receive.
+        Length = BuildMessage(20000, NV_TRUE);
+        pMsg->LengthInsecure = NVBOOT_RCM_MIN_MSG_LENGTH - 16;
+        e = Run(s_Versions[v].Rcm, Length, ONE_SHOT, 65536, &EntryPoint);
+        CHECK(e == NvBootError_ValidationFailure);
+        CHECK(s_Loop.Response == NvBootRcmResponse_InvalidInsecureLength);
+        CHECK(s_Loop.Pos < Length);
+
+        // A payload byte changed after signing fails the CMAC.
+        Length = BuildMessage(20000, NV_TRUE);
+        s_HostMsg[HEADER + 12345] ^= 1;
+        e = Run(s_Versions[v].Rcm, Length, 4096, 4096, &EntryPoint);
+        CHECK(e == NvBootError_ValidationFailure);
+        CHECK(s_Loop.Response == NvBootRcmResponse_HashCheckFailed);
+        CHECK(EntryPoint == 0);
+    }
+}
+
+/*
+ * With the bus and the engine timed: the CMAC is started before the last
+ * byte lands wherever the key is known from the header and the message
+ * needs a read after the first payload read, and no operation is started
+ * on a busy engine. Three kinds of run: a message under the SBK; a first
+ * message that selects secure provisioning, whose keys are loaded only
+ * after the receive; and a Sync under a provisioning key followed by a
+ * DownloadExecute under the same key, which can be streamed.
+ */
+static void CheckStreaming(void)
+{
+    static const NvU32 SeRates[] = { 100, 400 };
+    static const NvU32 MaxReceives[] = { 4096, 16384, 65536 };
+    const NvU32 Payloads[] =
+    {
+        3001, 65543, NVBOOT_BL_IRAM_SIZE - NVBOOT_SE_AES_BLOCK_LENGTH_BYTES
+    };
+    NvU32 s, r, p, k, v, First, Length, EntryPoint;
+    NvBool IsStreamed, CanStream;
+    NvBootError e;
+
+    s_UsbRate = USB_RATE;
+    for (s = 0; s < sizeof(SeRates) / sizeof(SeRates[0]); s++)
+    for (r = 0; r < sizeof(MaxReceives) / sizeof(MaxReceives[0]); r++)
+    for (p = 0; p < sizeof(Payloads) / sizeof(Payloads[0]); p++)
+    for (k = 0; k < 3; k++)
+    {
+        RcmSeModelSetRate(SeRates[s]);
+        First = 0;
+        if (k == 0)
+        {
+            s_OpMode = NvBootFuseOperatingMode_OdmProductionSecureSBK;
+            Length = BuildMessage(Payloads[p], NV_TRUE);
+        }
+        else
+        {
+            s_OpMode = NvBootFuseOperatingMode_NvProduction;
+            if (k == 2)
+                First = BuildMessageAt(s_HostMsg, NvBootRcmOpcode_Sync, 0,
+                                       PROVISIONING_KEY_NUM, NV_TRUE);
+            Length = First + BuildMessageAt(s_HostMsg + First,
+                                            NvBootRcmOpcode_DownloadExecute,
+                                            Payloads[p], PROVISIONING_KEY_NUM,
+                                            NV_TRUE);
+        }
+        s_Split = First;
+
+        for (v = 0; v < NUM_VERSIONS; v++)
+        {
+            // Code that derives the CMAC subkeys only once per process
+            // keeps those of the SBK, so other versions run under it only.
+            if ((k != 0) && (s_Versions[v].Rcm != NvBootRcm))
+                continue;
+
+            e = Run(s_Versions[v].Rcm, Length, ONE_SHOT, MaxReceives[r],
+                    &EntryPoint);
+            CHECK(e == NvBootError_Success);
+            CHECK(s_Loop.Responses == (k == 2 ? 2 : 1));
+            CHECK(!memcmp((void *)NVBOOT_BL_IRAM_START, s_Expected,
+                          Length - First - HEADER));
+            CHECK(RcmSeModelBusyFaults() == 0);
+
+            IsStreamed = s_Loop.CmacOpsAtEnd > s_Loop.CmacOpsAtSplit;
+            CanStream = (s_Versions[v].Rcm == NvBootRcm) && (k != 1) &&
+                        (Length - First > NV_MIN(MaxReceives[r],
+                                                 NVBOOT_BUFFER_LENGTH) +
+                                          MaxReceives[r]);
+            CHECK(IsStreamed == CanStream);
+            if (e != NvBootError_Success)
+                fprintf(stderr, "rcm: %s run %u, SE %u MB/s, receive %u, "
+                        "payload %u: error 0x%x\n", s_Versions[v].Name, k,
+                        SeRates[s], MaxReceives[r], Payloads[p], e);
+        }
+    }
+    s_UsbRate = 0;
+    s_Split = 0;
+    RcmSeModelSetRate(0);
+}
+
+static int Check(void)
+{
+    CheckDelivery();
+    CheckErrors();
+    CheckStreaming();
+
+    printf("rcm: %u checks, %u failures\n", s_Cases, s_Failures);
+    return s_Failures != 0;
+}
+
+/* The time from the last byte of the message on the bus to the CMAC. */
+static int BenchLatency(NvU32 Length)
+{
+    static const NvU32 SeRates[] = { 100, 400 };
+    static const NvU32 MaxReceives[] = { 4096, 16384, 65536 };
+    NvU32 s, r, v, EntryPoint;
+    NvBootError e;
+
+    printf("\nCMAC end after the last byte, same message at %u MB/s USB\n",
+           USB_RATE);
+    printf("  %-8s %12s %12s %12s\n", "version", "SE MB/s", "receive size",
+           "us");
+    s_UsbRate = USB_RATE;
+    for (v = 0; v < NUM_VERSIONS; v++)
+    for (s = 0; s < sizeof(SeRates) / sizeof(SeRates[0]); s++)
+    for (r = 0; r < sizeof(MaxReceives) / sizeof(MaxReceives[0]); r++)
+    {
+        RcmSeModelSetRate(SeRates[s]);
+        e = Run(s_Versions[v].Rcm, Length, ONE_SHOT, MaxReceives[r],
+                &EntryPoint);
+        if (e != NvBootError_Success)
+        {
+            fprintf(stderr, "rcm: %s failed with 0x%x\n",
+                    s_Versions[v].Name, e);
+            return 1;
+        }
+        printf("  %-8s %12u %12u %12.1f\n", s_Versions[v].Name, SeRates[s],
+               MaxReceives[r],
+               (RcmSeModelHashDone() - s_Loop.LastByteNs) / 1000.0);
+    }
+    s_UsbRate = 0;
+    RcmSeModelSetRate(0);
+    return 0;
+}
+
+/* CPU copy bytes and port receives for the largest message. */
+static int Bench(void)
+{
+    static const NvU32 MaxReceives[] = { 4096, 16384, 65536 };
+    NvU32 Payload = NVBOOT_BL_IRAM_SIZE - NVBOOT_SE_AES_BLOCK_LENGTH_BYTES;
+    NvU32 r, v, Length, EntryPoint;
+    NvBootError e;
+
+    s_OpMode = NvBootFuseOperatingMode_NvProduction;
+    Length = BuildMessage(Payload, NV_FALSE);
+
+    printf("CPU copies per %u-byte message, sent in one write\n", Length);
+    printf("  %-8s %12s %12s %12s\n", "version", "receive size",
+           "copy bytes", "receives");
+    for (v = 0; v < NUM_VERSIONS; v++)
+    {
+        for (r = 0; r < sizeof(MaxReceives) / sizeof(MaxReceives[0]); r++)
+        {
+            e = Run(s_Versions[v].Rcm, Length, ONE_SHOT, MaxReceives[r],
+                    &EntryPoint);
+            if (e != NvBootError_Success)
+            {
+                fprintf(stderr, "rcm: %s failed with 0x%x\n",
+                        s_Versions[v].Name, e);
+                return 1;
+            }
+            printf("  %-8s %12u %12u %12u\n", s_Versions[v].Name,
+                   MaxReceives[r], s_CopyBytes, s_Loop.Receives);
+        }
+    }
+    return BenchLatency(Length);
+}
+
+int main(int argc, char **argv)
+{
+    SetUp();
+
+    if ((argc > 1) && !strcmp(argv[1], "bench"))
+        return Bench();
+    return Check();
+}
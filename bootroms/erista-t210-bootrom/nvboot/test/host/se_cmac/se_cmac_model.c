@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * The SE AES engine model; see se_cmac_model.h.
+ *
+ * The model counts as errors the operations it does not implement, which
+ * the driver paths it runs do not use either: both or neither of the AES
+ * encrypt and decrypt algorithms, a destination other than memory or the
+ * key table, an input list of more than one buffer or a buffer that is
+ * not the SE_CRYPTO_LAST_BLOCK count of blocks, and more than one block
+ * to the key table.
+ *
+ * The AES is a plain byte-wise FIPS-197 implementation; se_cmac_test.c
+ * checks it against the FIPS-197 examples through the driver.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvcommon.h"
+#include "nvrm_drf.h"
+#include "arse.h"
+#include "nvboot_clocks_int.h"
+#include "nvboot_reset_int.h"
+#include "nvboot_se_aes.h"
+#include "nvboot_se_int.h"
+#include "host_regs.h"
+#include "se_cmac_model.h"
+
+#define SE_APERTURE         0x1000
+#define SE_REG(Reg)         (NV_ADDRESS_MAP_SE_BASE + (Reg))
+
+#define KEY_WORDS           (SE_MODEL_KEY_BYTES / 4)
+#define IV_WORDS            (SE_MODEL_BLOCK_BYTES / 4)
+#define MAX_ROUND_KEYS      (15 * SE_MODEL_BLOCK_BYTES)
+
+typedef struct
+{
+    NvU32 Key[KEY_WORDS];
+    NvU32 OriginalIv[IV_WORDS];
+    NvU32 UpdatedIv[IV_WORDS];
+} ModelKeySlot;
+
+static ModelKeySlot s_Slots[NvBootSeAesKeySlot_Num];
+static SeModelStats s_Stats;
+
+static NvU8 s_Sbox[256];
+static NvU8 s_InvSbox[256];
+
+static NvU8 Xtime(NvU8 x)
+{
+    return (NvU8)((x << 1) ^ ((x & 0x80) ? 0x1b : 0));
+}
+
+static NvU8 Mul(NvU8 a, NvU8 b)
+{
+    NvU8 p = 0;
+
+    while (b)
+    {
+        if (b & 1)
+            p ^= a;
+        a = Xtime(a);
+        b >>= 1;
+    }
+    return p;
+}
+
+/* The S-box from the inverse in GF(2^8) and the affine map of FIPS-197. */
+static void MakeSbox(void)
+{
+    NvU32 x;
+
+    for (x = 0; x < 256; x++)
+    {
+        NvU8 Inv = 0;
+        NvU8 s;
+        NvU32 y;
+
+        for (y = 1; x && y < 256; y++)
+        {
+            if (Mul((NvU8)x, (NvU8)y) == 1)
+            {
+                Inv = (NvU8)y;
+                break;
+            }
+        }
+        s = Inv ^ (NvU8)((Inv << 1) | (Inv >> 7)) ^
+            (NvU8)((Inv << 2) | (Inv >> 6)) ^
+            (NvU8)((Inv << 3) | (Inv >> 5)) ^
+            (NvU8)((Inv << 4) | (Inv >> 4)) ^ 0x63;
+        s_Sbox[x] = s;
+        s_InvSbox[s] = (NvU8)x;
+    }
+}
+
+/* Expands Key into the round keys and returns the number of rounds. */
+static NvU32 ExpandKey(const NvU8 *Key, NvU32 KeySize, NvU8 *pRoundKeys)
+{
+    NvU32 Nk = (KeySize == SE_MODE_PKT_AESMODE_KEY256) ? 8 :
+               (KeySize == SE_MODE_PKT_AESMODE_KEY192) ? 6 : 4;
+    NvU32 Rounds = Nk + 6;
+    NvU8 Rcon = 1;
+    NvU32 i;
+
+    if (!s_Sbox[0])
+        MakeSbox();
+    memcpy(pRoundKeys, Key, 4 * Nk);
+    for (i = Nk; i < 4 * (Rounds + 1); i++)
+    {
+        NvU8 t[4];
+        NvU32 j;
+
+        memcpy(t, pRoundKeys + 4 * (i - 1), 4);
+        if (i % Nk == 0)
+        {
+            NvU8 First = t[0];
+
+            t[0] = s_Sbox[t[1]] ^ Rcon;
+            t[1] = s_Sbox[t[2]];
+            t[2] = s_Sbox[t[3]];
+            t[3] = s_Sbox[First];
+            Rcon = Xtime(Rcon);
+        }
+        else if (Nk > 6 && i % Nk == 4)
+        {
+            for (j = 0; j < 4; j++)
+                t[j] = s_Sbox[t[j]];
+        }
+        for (j = 0; j < 4; j++)
+            pRoundKeys[4 * i + j] = pRoundKeys[4 * (i - Nk) + j] ^ t[j];
+    }
+    return Rounds;
+}
+
+static void AddRoundKey(NvU8 *s, const NvU8 *pRoundKey)
+{
+    NvU32 i;
+
+    for (i = 0; i < SE_MODEL_BLOCK_BYTES; i++)
+        s[i] ^= pRoundKey[i];
+}
+
+/* ShiftRows, or its inverse, over the column-major state. */
+static void ShiftRows(NvU8 *s, NvBool Inverse)
+{
+    NvU8 t[SE_MODEL_BLOCK_BYTES];
+    NvU32 r;
+    NvU32 c;
+
+    for (r = 0; r < 4; r++)
+    {
+        for (c = 0; c < 4; c++)
+        {
+            if (Inverse)
+                t[4 * ((c + r) % 4) + r] = s[4 * c + r];
+            else
+                t[4 * c + r] = s[4 * ((c + r) % 4) + r];
+        }
+    }
+    memcpy(s, t, sizeof(t));
+}
+
+static void MixColumns(NvU8 *s, NvBool Inverse)
+{
+    static const NvU8 Forward[4] = { 2, 3, 1, 1 };
+    static const NvU8 Backward[4] = { 14, 11, 13, 9 };
+    const NvU8 *m = Inverse ? Backward : Forward;
+    NvU32 c;
+    NvU32 r;
+
+    for (c = 0; c < 4; c++)
+    {
+        NvU8 a[4];
+
+        memcpy(a, s + 4 * c, 4);
+        for (r = 0; r < 4; r++)
+        {
+            s[4 * c + r] = Mul(a[r], m[0]) ^ Mul(a[(r + 1) % 4], m[1]) ^
+                           Mul(a[(r + 2) % 4], m[2]) ^ Mul(a[(r + 3) % 4], m[3]);
+        }
+    }
+}
+
+void SeModelAesEncrypt(const NvU8 *Key, NvU32 KeySize, const NvU8 *In, NvU8 *Out)
+{
+    NvU8 w[MAX_ROUND_KEYS];
+    NvU8 s[SE_MODEL_BLOCK_BYTES];
+    NvU32 Rounds = ExpandKey(Key, KeySize, w);
+    NvU32 Round;
+    NvU32 i;
+
+    memcpy(s, In, sizeof(s));
+    AddRoundKey(s, w);
+    for (Round = 1; Round <= Rounds; Round++)
+    {
+        for (i = 0; i < SE_MODEL_BLOCK_BYTES; i++)
+            s[i] = s_Sbox[s[i]];
+        ShiftRows(s, NV_FALSE);
+        if (Round < Rounds)
+            MixColumns(s, NV_FALSE);
+        AddRoundKey(s, w + SE_MODEL_BLOCK_BYTES * Round);
+    }
+    memcpy(Out, s, sizeof(s));
+}
+
+void SeModelAesDecrypt(const NvU8 *Key, NvU32 KeySize, const NvU8 *In, NvU8 *Out)
+{
+    NvU8 w[MAX_ROUND_KEYS];
+    NvU8 s[SE_MODEL_BLOCK_BYTES];
+    NvU32 Rounds = ExpandKey(Key, KeySize, w);
+    NvU32 Round;
+    NvU32 i;
+
+    memcpy(s, In, sizeof(s));
+    AddRoundKey(s, w + SE_MODEL_BLOCK_BYTES * Rounds);
+    for (Round = Rounds; Round >= 1; Round--)
+    {
+        ShiftRows(s, NV_TRUE);
+        for (i = 0; i < SE_MODEL_BLOCK_BYTES; i++)
+            s[i] = s_InvSbox[s[i]];
+        AddRoundKey(s, w + SE_MODEL_BLOCK_BYTES * (Round - 1));
+        if (Round > 1)
+            MixColumns(s, NV_TRUE);
+    }
+    memcpy(Out, s, sizeof(s));
+}
+
+/* A write of SE_CRYPTO_KEYTABLE_DATA, to the word SE_CRYPTO_KEYTABLE_ADDR selects. */
+static void WriteKeyTable(NvU32 Data)
+{
+    NvU32 Pkt = HostRegPeek(SE_REG(SE_CRYPTO_KEYTABLE_ADDR_0));
+    ModelKeySlot *pSlot = &s_Slots[(Pkt >> SE_CRYPTO_KEYIV_PKT_KEY_INDEX_SHIFT) &
+                                   (NvBootSeAesKeySlot_Num - 1)];
+    NvU32 Word;
+
+    s_Stats.KeyTableWrites++;
+    if (((Pkt >> SE_CRYPTO_KEYIV_PKT_KEYIV_SEL_SHIFT) & 1) ==
+        SE_CRYPTO_KEYIV_PKT_KEYIV_SEL_KEY)
+    {
+        Word = (Pkt >> SE_CRYPTO_KEYIV_PKT_KEY_WORD_SHIFT) & (KEY_WORDS - 1);
+        pSlot->Key[Word] = Data;
+        return;
+    }
+
+    Word = (Pkt >> SE_CRYPTO_KEYIV_PKT_IV_WORD_SHIFT) & (IV_WORDS - 1);
+    if (((Pkt >> SE_CRYPTO_KEYIV_PKT_IV_SEL_SHIFT) & 1) ==
+        SE_CRYPTO_KEYIV_PKT_IV_SEL_ORIGINAL)
+        pSlot->OriginalIv[Word] = Data;
+    else
+        pSlot->UpdatedIv[Word] = Data;
+}
+
+/* Runs the AES-CBC operation SE_CONFIG and SE_CRYPTO_CONFIG describe. */
+static void Start(void)
+{
+    NvU32 Config = HostRegPeek(SE_REG(SE_CONFIG_0));
+    NvU32 Crypto = HostRegPeek(SE_REG(SE_CRYPTO_CONFIG_0));
+    NvU32 Blocks = HostRegPeek(SE_REG(SE_CRYPTO_LAST_BLOCK_0)) + 1;
+    NvBool Encrypt = NV_DRF_VAL(SE, CONFIG, ENC_ALG, Config) ==
+                     SE_CONFIG_0_ENC_ALG_AES_ENC;
+    NvBool Decrypt = NV_DRF_VAL(SE, CONFIG, DEC_ALG, Config) ==
+                     SE_CONFIG_0_DEC_ALG_AES_DEC;
+    NvU32 KeySize = Encrypt ? NV_DRF_VAL(SE, CONFIG, ENC_MODE, Config) :
+                              NV_DRF_VAL(SE, CONFIG, DEC_MODE, Config);
+    NvU32 Dst = NV_DRF_VAL(SE, CONFIG, DST, Config);
+    ModelKeySlot *pSlot = &s_Slots[(Crypto & SE_CRYPTO_CONFIG_0_KEY_INDEX_FIELD) >>
+                                   SE_CRYPTO_CONFIG_0_KEY_INDEX_SHIFT];
+    SingleSeLinkedList *pIn;
+    SingleSeLinkedList *pOut = NULL;
+    NvU8 Iv[SE_MODEL_BLOCK_BYTES];
+    NvU8 Block[SE_MODEL_BLOCK_BYTES];
+    NvU8 *pSrc;
+    NvU8 *pDst = NULL;
+    NvU32 i;
+    NvU32 j;
+
+    s_Stats.Ops++;
+    pIn = (SingleSeLinkedList *)(uintptr_t)HostRegPeek(SE_REG(SE_IN_LL_ADDR_0));
+    if (Dst == SE_CONFIG_0_DST_MEMORY)
+        pOut = (SingleSeLinkedList *)(uintptr_t)HostRegPeek(SE_REG(SE_OUT_LL_ADDR_0));
+    if (Encrypt == Decrypt ||
+        (Dst != SE_CONFIG_0_DST_MEMORY && Dst != SE_CONFIG_0_DST_KEYTABLE) ||
+        pIn->LastBufferNumber != 0 ||
+        pIn->LLElement.BufferByteSize != Blocks * SE_MODEL_BLOCK_BYTES ||
+        (pOut && (pOut->LastBufferNumber != 0 ||
+                  pOut->LLElement.BufferByteSize < Blocks * SE_MODEL_BLOCK_BYTES)) ||
+        (Dst == SE_CONFIG_0_DST_KEYTABLE && Blocks != 1))
+    {
+        s_Stats.Errors++;
+        return;
+    }
+
+    memcpy(Iv, NV_DRF_VAL(SE, CRYPTO_CONFIG, IV_SELECT, Crypto) ==
+               SE_CRYPTO_CONFIG_0_IV_SELECT_ORIGINAL ?
+               pSlot->OriginalIv : pSlot->UpdatedIv, sizeof(Iv));
+    pSrc = (NvU8 *)(uintptr_t)pIn->LLElement.StartByteAddress;
+    if (pOut)
+        pDst = (NvU8 *)(uintptr_t)pOut->LLElement.StartByteAddress;
+    for (i = 0; i < Blocks; i++)
+    {
+        const NvU8 *pKey = (const NvU8 *)pSlot->Key;
+
+        if (Encrypt)
+        {
+            for (j = 0; j < SE_MODEL_BLOCK_BYTES; j++)
+                Block[j] = pSrc[j] ^ Iv[j];
+            SeModelAesEncrypt(pKey, KeySize, Block, Block);
+            memcpy(Iv, Block, sizeof(Iv));
+        }
+        else
+        {
+            SeModelAesDecrypt(pKey, KeySize, pSrc, Block);
+            for (j = 0; j < SE_MODEL_BLOCK_BYTES; j++)
+                Block[j] ^= Iv[j];
+            memcpy(Iv, pSrc, sizeof(Iv));
+        }
+        if (pDst)
+        {
+            memcpy(pDst, Block, sizeof(Block));
+            pDst += SE_MODEL_BLOCK_BYTES;
+        }
+        pSrc += SE_MODEL_BLOCK_BYTES;
+    }
+    memcpy(pSlot->UpdatedIv, Iv, sizeof(Iv));
+    s_Stats.Blocks += Blocks;
+
+    if (Dst == SE_CONFIG_0_DST_KEYTABLE)
+    {
+        NvU32 KeyDst = HostRegPeek(SE_REG(SE_CRYPTO_KEYTABLE_DST_0));
+        ModelKeySlot *pTarget =
+            &s_Slots[NV_DRF_VAL(SE, CRYPTO_KEYTABLE_DST, KEY_INDEX, KeyDst)];
+        NvU32 Quad = NV_DRF_VAL(SE, CRYPTO_KEYTABLE_DST, WORD_QUAD, KeyDst);
+
+        memcpy(&pTarget->Key[Quad * IV_WORDS], Block, sizeof(Block));
+    }
+}
+
+static NvU32 ReadReg(NvU32 Addr)
+{
+    s_Stats.RegReads++;
+    if (Addr == SE_REG(SE_STATUS_0))
+        return SE_STATUS_0_STATE_IDLE;
+    return HostRegPeek(Addr);
+}
+
+static void WriteReg(NvU32 Addr, NvU32 Data)
+{
+    s_Stats.RegWrites++;
+    HostRegPoke(Addr, Data);
+    if (Addr == SE_REG(SE_CRYPTO_KEYTABLE_DATA_0))
+        WriteKeyTable(Data);
+    else if (Addr == SE_REG(SE_OPERATION_0) &&
+             NV_DRF_VAL(SE, OPERATION, OP, Data) == SE_OPERATION_0_OP_START)
+        Start();
+}
+
+void SeModelReset(void)
+{
+    HostRegReset();
+    memset(s_Slots, 0, sizeof(s_Slots));
+    memset(&s_Stats, 0, sizeof(s_Stats));
+    HostRegHook(NV_ADDRESS_MAP_SE_BASE, SE_APERTURE, ReadReg, WriteReg);
+    /* NvBootSeInitializeSE() expects the AVP on PLLP_OUT2. */
+    HostRegPoke(NV_ADDRESS_MAP_CAR_BASE + CLK_RST_CONTROLLER_SCLK_BURST_POLICY_0,
+                NV_DRF_DEF(CLK_RST_CONTROLLER, SCLK_BURST_POLICY,
+                           SWAKEUP_RUN_SOURCE, PLLP_OUT2));
+}
+
+const NvU8 *SeModelKey(NvU32 Slot)
+{
+    return (const NvU8 *)s_Slots[Slot].Key;
+}
+
+const NvU8 *SeModelOriginalIv(NvU32 Slot)
+{
+    return (const NvU8 *)s_Slots[Slot].OriginalIv;
+}
+
+NvU64 SeModelCycles(const SeModelStats *pStats)
+{
+    return (NvU64)(pStats->RegReads + pStats->RegWrites) * SE_MODEL_REG_CYCLES +
+           (NvU64)pStats->Ops * SE_MODEL_START_CYCLES +
+           (NvU64)pStats->Blocks * SE_MODEL_BLOCK_CYCLES;
+}
+
+const SeModelStats *SeModelGetStats(void)
+{
+    return &s_Stats;
+}
+
+void SeModelClearStats(void)
+{
+    memset(&s_Stats, 0, sizeof(s_Stats));
+}
+
+/* The clock and reset calls of NvBootSeInitializeSE(). */
+void NvBootClocksConfigureClock(NvBootClocksClockId ClockId, NvU32 Divider,
+                                NvU32 Source)
+{
+}
+
+void NvBootClocksSetEnable(NvBootClocksClockId ClockId, NvBool Enable)
+{
+}
+
+void NvBootResetSetEnable(const NvBootResetDeviceId DeviceId, const NvBool Enable)
+{
+    if (DeviceId == NvBootResetDeviceId_SeId && Enable)
+        s_Stats.Resets++;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * se_cmac_model.h - Register model of the SE AES engine behind
+ * se/nvboot_se.c in the host harness.
+ *
+ * The model hooks the SE aperture in host_regs. It keeps the key table of
+ * NvBootSeAesKeySlot_Num slots, each with a 256-bit key and an original
+ * and an updated IV, written through SE_CRYPTO_KEYTABLE_ADDR and
+ * SE_CRYPTO_KEYTABLE_DATA. On START it decodes SE_CONFIG and
+ * SE_CRYPTO_CONFIG and runs AES-CBC, encrypt or decrypt, over the blocks
+ * of the input linked list, to memory through the output linked list or
+ * to a quarter of a key slot through SE_CRYPTO_KEYTABLE_DST. The updated
+ * IV of the slot is left at the last cipher block, as the engine does.
+ * The engine is idle again as soon as an operation starts.
+ *
+ * Every access, key table write and operation is counted, and so are the
+ * configurations the model does not implement. SE cycles are estimated
+ * from SE_MODEL_REG_CYCLES per access, SE_MODEL_START_CYCLES per
+ * operation and SE_MODEL_BLOCK_CYCLES per AES block; these costs are
+ * assumptions, not measurements.
+ */
+
+#ifndef INCLUDED_SE_CMAC_MODEL_H
+#define INCLUDED_SE_CMAC_MODEL_H
+
+#include "nvcommon.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define SE_MODEL_KEY_BYTES          32
+#define SE_MODEL_BLOCK_BYTES        16
+#define SE_MODEL_REG_CYCLES         20
+#define SE_MODEL_START_CYCLES       800
+#define SE_MODEL_BLOCK_CYCLES       22
+
+typedef struct
+{
+    NvU32 RegReads;
+    NvU32 RegWrites;
+    NvU32 KeyTableWrites;
+    NvU32 Ops;
+    NvU32 Blocks;
+    /* SE resets through NvBootResetSetEnable(). */
+    NvU32 Resets;
+    /* Operations the model does not implement; see se_cmac_model.c. */
+    NvU32 Errors;
+} SeModelStats;
+
+/** Clears the key table and the counts, and hooks the registers. */
+void SeModelReset(void);
+
+/** Key and original IV of a key slot, as the engine holds them. */
+const NvU8 *SeModelKey(NvU32 Slot);
+const NvU8 *SeModelOriginalIv(NvU32 Slot);
+
+/**
+ * Host side: one AES block with a key of KeySize, a SE_MODE_PKT_AESMODE
+ * value, through the same cipher as the engine.
+ */
+void SeModelAesEncrypt(const NvU8 *Key, NvU32 KeySize, const NvU8 *In, NvU8 *Out);
+void SeModelAesDecrypt(const NvU8 *Key, NvU32 KeySize, const NvU8 *In, NvU8 *Out);
+
+/** SE cycles for the counts in pStats, at the assumed costs. */
+NvU64 SeModelCycles(const SeModelStats *pStats);
+
+const SeModelStats *SeModelGetStats(void);
+void SeModelClearStats(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // INCLUDED_SE_CMAC_MODEL_H
@@ -0,0 +1,541 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of the AES-CMAC subkeys of se/nvboot_se.c:
+ * NvBootSeAesCmacGenerateSubkey() and the key slot writes that change
+ * what it must return.
+ *
+ * The driver is built unchanged over the engine model of se_cmac_model.c.
+ * Every set of subkeys it returns is compared with K1 and K2 derived on
+ * the host side from the key the model holds in the slot, per RFC 4493.
+ *
+ * "check" runs the FIPS-197 examples through NvBootSeAesEncrypt(), the
+ * subkeys of RFC 4493 section 4, and random keys of each size in each key
+ * slot. It checks that a second derivation for the same key and size
+ * takes no engine operation, and that a key written through
+ * NvBootSeKeySlotWriteKeyIV() or NvBootSeAesDecryptKeyIntoKeySlot(), a
+ * change of key size, NvBootSeInitializeSE() and
+ * NvBootSeAesCmacClearSubkeyCache() each make the next one derive again,
+ * while an IV write does not. It then runs the derivations of four boot
+ * paths, as the BCT, reader, RCM and warm boot code make them. "bench"
+ * prints the engine operations, key table writes, SE accesses and SE
+ * cycles of each path.
+ *
+ * The RCM rows call the driver as HashStart() of rcm/nvboot_rcm.c does:
+ * for every message. Built with HOST_OLD, the harness runs the driver of
+ * OLD_REV, which derives the subkeys on every call, and HashStart() as it
+ * was at OLD_REV, which derived them for the first message only and kept
+ * them after a secure provisioning key had replaced the SBK.
+ *
+ * The driver casts the linked lists and blocks on its stack to NvU32, so
+ * the test runs on a thread whose stack is in static storage, below 4GB.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvcommon.h"
+#include "nvboot_error.h"
+#include "arse.h"
+#include "nvboot_se_aes.h"
+#include "nvboot_se_int.h"
+#include "se_cmac_model.h"
+
+#define BLOCK               SE_MODEL_BLOCK_BYTES
+#define KEY128              SE_MODE_PKT_AESMODE_KEY128
+#define KEY192              SE_MODE_PKT_AESMODE_KEY192
+#define KEY256              SE_MODE_PKT_AESMODE_KEY256
+#define CMAC_RB             0x87
+#define STACK_BYTES         (1024 * 1024)
+
+#define SBK_SLOT            NvBootSeAesKeySlot_SBK
+#define SBK_CMAC_SLOT       NvBootSeAesKeySlot_SBK_AES_CMAC_Hash
+#define WRAP_SLOT           NvBootSeAesKeySlot_Secure_Provisioning_KeyWrapKey_Decrypt
+#define FSKP_CMAC_SLOT      NvBootSeAesKeySlot_Secure_Provisioning_Key_CMAC_Hash
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "se_cmac: %s:%d: %s\n", __FILE__,           \
+                    __LINE__, #Cond);                                   \
+        }                                                               \
+    } while (0)
+
+/* The buffers stay in static storage, below 4GB; see host.mk. */
+static NvU8 s_Stack[STACK_BYTES] __attribute__((aligned(4096)));
+static NvU8 s_Src[2 * BLOCK] __attribute__((aligned(4)));
+static NvU8 s_Dst[2 * BLOCK] __attribute__((aligned(4)));
+static NvU32 s_KeyWords[SE_MODEL_KEY_BYTES / 4];
+
+static NvU32 s_Seed = 0x5e0c3ac1;
+
+static NvU32 Random(void)
+{
+    s_Seed = s_Seed * 1103515245 + 12345;
+    return s_Seed >> 8;
+}
+
+static NvU32 KeyBytes(NvU32 KeySize)
+{
+    return (KeySize == KEY256) ? 32 : (KeySize == KEY192) ? 24 : 16;
+}
+
+static void Hex(const char *pHex, NvU8 *pOut)
+{
+    NvU32 i;
+
+    for (i = 0; pHex[2 * i]; i++)
+    {
+        unsigned Byte;
+
+        sscanf(pHex + 2 * i, "%2x", &Byte);
+        pOut[i] = (NvU8)Byte;
+    }
+}
+
+static void WriteKey(NvU32 Slot, NvU32 KeySize, const NvU8 *Key)
+{
+    memcpy(s_KeyWords, Key, KeyBytes(KeySize));
+    NvBootSeKeySlotWriteKeyIV(Slot, KeySize,
+                              SE_CRYPTO_KEYIV_PKT_WORD_QUAD_KEYS_0_3,
+                              s_KeyWords);
+}
+
+static void WriteRandomKey(NvU32 Slot, NvU32 KeySize)
+{
+    NvU8 Key[SE_MODEL_KEY_BYTES];
+    NvU32 i;
+
+    for (i = 0; i < sizeof(Key); i++)
+        Key[i] = (NvU8)Random();
+    WriteKey(Slot, KeySize, Key);
+}
+
+/* Left shift of a block by one bit, with Rb folded in for a carry out. */
+static void Double(const NvU8 *In, NvU8 *Out)
+{
+    NvU32 i;
+
+    for (i = 0; i < BLOCK; i++)
+        Out[i] = (NvU8)(In[i] << 1) | ((i + 1 < BLOCK) ? In[i + 1] >> 7 : 0);
+    if (In[0] & 0x80)
+        Out[BLOCK - 1] ^= CMAC_RB;
+}
+
+/* K1 and K2 of RFC 4493 for the key the model holds in Slot. */
+static void RefSubkeys(NvU32 Slot, NvU32 KeySize, NvU8 *K1, NvU8 *K2)
+{
+    static const NvU8 Zero[BLOCK];
+    NvU8 L[BLOCK];
+
+    SeModelAesEncrypt(SeModelKey(Slot), KeySize, Zero, L);
+    Double(L, K1);
+    Double(K1, K2);
+}
+
+/*
+ * Derives the subkeys of Slot through the driver. Returns NV_TRUE if they
+ * match the reference, and the engine operations it took in *pOps.
+ */
+static NvBool Subkeys(NvU32 Slot, NvU32 KeySize, NvU32 *pOps)
+{
+    const SeModelStats *pStats = SeModelGetStats();
+    NvU32 K1[BLOCK / 4];
+    NvU32 K2[BLOCK / 4];
+    NvU8 Ref1[BLOCK];
+    NvU8 Ref2[BLOCK];
+    NvU32 Ops = pStats->Ops;
+
+    NvBootSeAesCmacGenerateSubkey(Slot, KeySize, K1, K2);
+    if (pOps)
+        *pOps = pStats->Ops - Ops;
+    RefSubkeys(Slot, KeySize, Ref1, Ref2);
+    return !memcmp(K1, Ref1, BLOCK) && !memcmp(K2, Ref2, BLOCK);
+}
+
+/* Engine operations of a second derivation: none once cached. */
+#if HOST_OLD
+#define CACHED_OPS          1
+#else
+#define CACHED_OPS          0
+#endif
+
+static void Boot(void)
+{
+    static const NvU8 Sbk[BLOCK] = { 0x5b, 0x1e, 0x07 };
+
+    SeModelReset();
+    NvBootSeInitializeSE();
+    /* The SBK, in its decrypt and its CMAC slot, as nvboot_main.c does. */
+    WriteKey(SBK_SLOT, KEY128, Sbk);
+    WriteKey(SBK_CMAC_SLOT, KEY128, Sbk);
+}
+
+/* FIPS-197 appendix C, one block through the driver with IV 0. */
+static void CheckAes(void)
+{
+    static const struct
+    {
+        NvU32 KeySize;
+        const char *Out;
+    } Cases[] = {
+        { KEY128, "69c4e0d86a7b0430d8cdb78070b4c55a" },
+        { KEY192, "dda97ca4864cdfe06eaf70a0ec0d7191" },
+        { KEY256, "8ea2b7ca516745bfeafc49904b496089" },
+    };
+    NvU8 Key[SE_MODEL_KEY_BYTES];
+    NvU8 Expected[BLOCK];
+    NvU8 Back[BLOCK];
+    NvU32 c;
+    NvU32 i;
+
+    for (i = 0; i < sizeof(Key); i++)
+        Key[i] = (NvU8)i;
+    for (c = 0; c < sizeof(Cases) / sizeof(Cases[0]); c++)
+    {
+        Boot();
+        Hex("00112233445566778899aabbccddeeff", s_Src);
+        Hex(Cases[c].Out, Expected);
+        WriteKey(NvBootSeAesKeySlot_0, Cases[c].KeySize, Key);
+        NvBootSeKeySlotWriteKeyIV(NvBootSeAesKeySlot_0, KEY128,
+                                  SE_CRYPTO_KEYIV_PKT_WORD_QUAD_ORIGINAL_IVS, 0);
+        NvBootSeAesEncrypt(NvBootSeAesKeySlot_0, Cases[c].KeySize, NV_TRUE, 1,
+                           s_Src, s_Dst);
+        CHECK(!memcmp(s_Dst, Expected, BLOCK));
+        SeModelAesDecrypt(Key, Cases[c].KeySize, Expected, Back);
+        CHECK(!memcmp(Back, s_Src, BLOCK));
+        CHECK(SeModelGetStats()->Errors == 0);
+    }
+}
+
+/* RFC 4493 section 4: K1 and K2 of the AES-128 example key. */
+static void CheckRfc4493(void)
+{
+    NvU8 Key[BLOCK];
+    NvU8 K1[BLOCK];
+    NvU8 K2[BLOCK];
+    NvU32 Got1[BLOCK / 4];
+    NvU32 Got2[BLOCK / 4];
+    const SeModelStats *pStats = SeModelGetStats();
+    NvU32 i;
+
+    Boot();
+    Hex("2b7e151628aed2a6abf7158809cf4f3c", Key);
+    Hex("fbeed618357133667c85e08f7236a8de", K1);
+    Hex("f7ddac306ae266ccf90bc11ee46d513b", K2);
+    WriteKey(SBK_CMAC_SLOT, KEY128, Key);
+    for (i = 0; i < 2; i++)
+    {
+        SeModelClearStats();
+        memset(Got1, 0, sizeof(Got1));
+        memset(Got2, 0, sizeof(Got2));
+        NvBootSeAesCmacGenerateSubkey(SBK_CMAC_SLOT, KEY128, Got1, Got2);
+        CHECK(!memcmp(Got1, K1, BLOCK));
+        CHECK(!memcmp(Got2, K2, BLOCK));
+        CHECK(pStats->Ops == (i ? CACHED_OPS : 1));
+        CHECK(pStats->KeyTableWrites == (i ? 8 * CACHED_OPS : 8));
+    }
+}
+
+/* Random keys of each size in each slot, derived twice. */
+static void CheckSlots(void)
+{
+    static const NvU32 Sizes[] = { KEY128, KEY192, KEY256 };
+    NvU32 Slot;
+    NvU32 s;
+    NvU32 Ops;
+
+    Boot();
+    for (s = 0; s < sizeof(Sizes) / sizeof(Sizes[0]); s++)
+    {
+        for (Slot = 0; Slot < NvBootSeAesKeySlot_Num; Slot++)
+            WriteRandomKey(Slot, Sizes[s]);
+        for (Slot = 0; Slot < NvBootSeAesKeySlot_Num; Slot++)
+        {
+            CHECK(Subkeys(Slot, Sizes[s], &Ops) && Ops == 1);
+        }
+        for (Slot = 0; Slot < NvBootSeAesKeySlot_Num; Slot++)
+        {
+            CHECK(Subkeys(Slot, Sizes[s], &Ops) && Ops == CACHED_OPS);
+        }
+    }
+    CHECK(SeModelGetStats()->Errors == 0);
+}
+
+/* What makes the next derivation go to the engine again, and what not. */
+static void CheckInvalidation(void)
+{
+    NvU8 Wrapped[2 * BLOCK];
+    NvU8 Fskp[2 * BLOCK];
+    NvU32 Ops;
+    NvU32 i;
+
+    Boot();
+    WriteRandomKey(FSKP_CMAC_SLOT, KEY256);
+    CHECK(Subkeys(SBK_CMAC_SLOT, KEY128, &Ops) && Ops == 1);
+    CHECK(Subkeys(FSKP_CMAC_SLOT, KEY256, &Ops) && Ops == 1);
+
+    /* A new key in the slot. */
+    WriteRandomKey(SBK_CMAC_SLOT, KEY128);
+    CHECK(Subkeys(SBK_CMAC_SLOT, KEY128, &Ops) && Ops == 1);
+    CHECK(Subkeys(FSKP_CMAC_SLOT, KEY256, &Ops) && Ops == CACHED_OPS);
+
+    /* A key write through the upper word quad. */
+    for (i = 0; i < 4; i++)
+        s_KeyWords[i] = Random();
+    NvBootSeKeySlotWriteKeyIV(FSKP_CMAC_SLOT, KEY128,
+                              SE_CRYPTO_KEYIV_PKT_WORD_QUAD_KEYS_4_7,
+                              s_KeyWords);
+    CHECK(Subkeys(FSKP_CMAC_SLOT, KEY256, &Ops) && Ops == 1);
+
+    /* The same key, used at another size. */
+    WriteRandomKey(FSKP_CMAC_SLOT, KEY256);
+    CHECK(Subkeys(FSKP_CMAC_SLOT, KEY256, &Ops) && Ops == 1);
+    CHECK(Subkeys(FSKP_CMAC_SLOT, KEY128, &Ops) && Ops == 1);
+    CHECK(Subkeys(FSKP_CMAC_SLOT, KEY128, &Ops) && Ops == CACHED_OPS);
+
+    /* IVs do not change the subkeys. */
+    for (i = 0; i < 4; i++)
+        s_KeyWords[i] = Random();
+    NvBootSeKeySlotWriteKeyIV(SBK_CMAC_SLOT, KEY128,
+                              SE_CRYPTO_KEYIV_PKT_WORD_QUAD_ORIGINAL_IVS,
+                              s_KeyWords);
+    NvBootSeKeySlotWriteKeyIV(SBK_CMAC_SLOT, KEY128,
+                              SE_CRYPTO_KEYIV_PKT_WORD_QUAD_UPDATED_IVS,
+                              s_KeyWords);
+    CHECK(Subkeys(SBK_CMAC_SLOT, KEY128, &Ops) && Ops == CACHED_OPS);
+
+    /*
+     * A key unwrapped into the slot, as for secure provisioning. The
+     * unwrapping key only has its IVs written.
+     */
+    WriteRandomKey(WRAP_SLOT, KEY128);
+    CHECK(Subkeys(WRAP_SLOT, KEY128, &Ops) && Ops == 1);
+    for (i = 0; i < sizeof(Fskp); i++)
+        Fskp[i] = (NvU8)Random();
+    SeModelAesEncrypt(SeModelKey(WRAP_SLOT), KEY128, Fskp, Wrapped);
+    for (i = 0; i < BLOCK; i++)
+        Wrapped[BLOCK + i] = Fskp[BLOCK + i] ^ Wrapped[i];
+    SeModelAesEncrypt(SeModelKey(WRAP_SLOT), KEY128, Wrapped + BLOCK,
+                      Wrapped + BLOCK);
+    memcpy(s_Src, Wrapped, sizeof(Wrapped));
+    NvBootSeAesDecryptKeyIntoKeySlot(WRAP_SLOT, KEY128, FSKP_CMAC_SLOT,
+                                     KEY256, s_Src);
+    CHECK(!memcmp(SeModelKey(FSKP_CMAC_SLOT), Fskp, sizeof(Fskp)));
+    CHECK(Subkeys(FSKP_CMAC_SLOT, KEY256, &Ops) && Ops == 1);
+    CHECK(Subkeys(WRAP_SLOT, KEY128, &Ops) && Ops == CACHED_OPS);
+
+    /* SE reset, and the clear on the way out of the Boot ROM. */
+    NvBootSeInitializeSE();
+    CHECK(SeModelGetStats()->Resets == 2);
+    CHECK(Subkeys(SBK_CMAC_SLOT, KEY128, &Ops) && Ops == 1);
+#if !HOST_OLD
+    NvBootSeAesCmacClearSubkeyCache();
+    CHECK(Subkeys(SBK_CMAC_SLOT, KEY128, &Ops) && Ops == 1);
+#endif
+    CHECK(SeModelGetStats()->Errors == 0);
+}
+
+/*
+ * The derivations of a boot path, from the SE set up with the SBK: the
+ * calls the BCT, reader, RCM and warm boot code make.
+ */
+typedef struct
+{
+    const char *Name;
+    /* 4 BCT copies, 2 bootloaders of 4 objects, as reader validation. */
+    NvBool Coldboot;
+    /* RCM messages with the SBK, then with a 256-bit provisioning key. */
+    NvU32 SbkMessages;
+    NvU32 FskpMessages;
+    /* The recovery code of warm boot. */
+    NvBool WarmBoot;
+    /* Engine operations and wrong subkeys, for the current code. */
+    NvU32 Ops;
+    NvU32 Wrong;
+#if HOST_OLD
+    NvU32 OldOps;
+    NvU32 OldWrong;
+#endif
+} BootPath;
+
+static const BootPath s_Paths[] = {
+#if HOST_OLD
+#define PATH(Name, Cold, Sbk, Fskp, Wb, Ops, Wrong, OldOps, OldWrong) \
+    { Name, Cold, Sbk, Fskp, Wb, Ops, Wrong, OldOps, OldWrong }
+#else
+#define PATH(Name, Cold, Sbk, Fskp, Wb, Ops, Wrong, OldOps, OldWrong) \
+    { Name, Cold, Sbk, Fskp, Wb, Ops, Wrong }
+#endif
+    PATH("cold boot, 4 BCTs, 8 objects", NV_TRUE, 0, 0, NV_FALSE, 1, 0, 12, 0),
+    PATH("RCM, 16 messages",             NV_FALSE, 16, 0, NV_FALSE, 1, 0, 1, 0),
+    PATH("RCM, 16, FSKP key, 8",         NV_FALSE, 16, 8, NV_FALSE, 4, 0, 3, 8),
+    PATH("warm boot",                    NV_FALSE, 0, 0, NV_TRUE, 1, 0, 1, 0),
+#undef PATH
+};
+
+/* HashStart() of rcm/nvboot_rcm.c, and of OLD_REV under HOST_OLD. */
+static NvBool s_RcmFirstVisit;
+static NvU32 s_RcmK1[BLOCK / 4];
+static NvU32 s_RcmK2[BLOCK / 4];
+
+static NvBool RcmHashStart(NvU32 Slot, NvU32 KeySize)
+{
+    NvU8 Ref1[BLOCK];
+    NvU8 Ref2[BLOCK];
+
+#if HOST_OLD
+    if (s_RcmFirstVisit)
+    {
+        NvBootSeAesCmacGenerateSubkey(Slot, KeySize, s_RcmK1, s_RcmK2);
+        s_RcmFirstVisit = NV_FALSE;
+    }
+#else
+    NvBootSeAesCmacGenerateSubkey(Slot, KeySize, s_RcmK1, s_RcmK2);
+#endif
+    RefSubkeys(Slot, KeySize, Ref1, Ref2);
+    return !memcmp(s_RcmK1, Ref1, BLOCK) && !memcmp(s_RcmK2, Ref2, BLOCK);
+}
+
+/* Runs a boot path and returns the calls whose subkeys were wrong. */
+static NvU32 RunPath(const BootPath *pPath)
+{
+    NvU8 Wrapped[2 * BLOCK];
+    NvU32 Wrong = 0;
+    NvU32 i;
+
+    Boot();
+    s_RcmFirstVisit = NV_TRUE;
+    SeModelClearStats();
+
+    if (pPath->Coldboot)
+    {
+        for (i = 0; i < 4 + 2 * 4; i++)
+            Wrong += !Subkeys(SBK_CMAC_SLOT, KEY128, NULL);
+    }
+    for (i = 0; i < pPath->SbkMessages; i++)
+        Wrong += !RcmHashStart(SBK_CMAC_SLOT, KEY128);
+    if (pPath->FskpMessages)
+    {
+        /*
+         * The message switches the validation to a 256-bit key, unwrapped
+         * with the key wrap key into the provisioning CMAC slot.
+         */
+        for (i = 0; i < sizeof(Wrapped); i++)
+            Wrapped[i] = (NvU8)Random();
+        memcpy(s_Src, Wrapped, sizeof(Wrapped));
+        WriteRandomKey(WRAP_SLOT, KEY128);
+        NvBootSeAesDecryptKeyIntoKeySlot(WRAP_SLOT, KEY128, FSKP_CMAC_SLOT,
+                                         KEY256, s_Src);
+        for (i = 0; i < pPath->FskpMessages; i++)
+            Wrong += !RcmHashStart(FSKP_CMAC_SLOT, KEY256);
+    }
+    if (pPath->WarmBoot)
+        Wrong += !Subkeys(SBK_SLOT, KEY128, NULL);
+    return Wrong;
+}
+
+static void CheckPaths(void)
+{
+    NvU32 p;
+
+    for (p = 0; p < sizeof(s_Paths) / sizeof(s_Paths[0]); p++)
+    {
+        const BootPath *pPath = &s_Paths[p];
+        NvU32 Wrong = RunPath(pPath);
+
+#if HOST_OLD
+        CHECK(Wrong == pPath->OldWrong);
+        CHECK(SeModelGetStats()->Ops == pPath->OldOps);
+#else
+        CHECK(Wrong == pPath->Wrong);
+        CHECK(SeModelGetStats()->Ops == pPath->Ops);
+#endif
+        CHECK(SeModelGetStats()->Errors == 0);
+    }
+}
+
+static int Check(const char *Label)
+{
+    CheckAes();
+    CheckRfc4493();
+    CheckSlots();
+    CheckInvalidation();
+    CheckPaths();
+
+    printf("%s: %u checks, %u failures\n", Label, s_Cases, s_Failures);
+    return s_Failures != 0;
+}
+
+static int Bench(const char *Label)
+{
+    const SeModelStats *pStats = SeModelGetStats();
+    NvU32 p;
+
+    printf("%s: AES-CMAC subkeys per boot path, %u/%u/%u SE cycles per "
+           "access/operation/block\n", Label, SE_MODEL_REG_CYCLES,
+           SE_MODEL_START_CYCLES, SE_MODEL_BLOCK_CYCLES);
+    printf("  %-30s %6s %4s %9s %9s %8s\n", "path", "wrong", "ops",
+           "KT writes", "accesses", "cycles");
+    for (p = 0; p < sizeof(s_Paths) / sizeof(s_Paths[0]); p++)
+    {
+        NvU32 Wrong = RunPath(&s_Paths[p]);
+
+        printf("  %-30s %6u %4u %9u %9u %8llu\n", s_Paths[p].Name, Wrong,
+               pStats->Ops, pStats->KeyTableWrites,
+               pStats->RegReads + pStats->RegWrites,
+               (unsigned long long)SeModelCycles(pStats));
+    }
+    return 0;
+}
+
+typedef struct
+{
+    NvBool Bench;
+    const char *Label;
+    int Result;
+} TestRun;
+
+static void *RunTest(void *pArg)
+{
+    TestRun *pRun = pArg;
+
+    pRun->Result = pRun->Bench ? Bench(pRun->Label) : Check(pRun->Label);
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    TestRun Run;
+    pthread_attr_t Attr;
+    pthread_t Thread;
+
+    Run.Bench = (argc > 1) && !strcmp(argv[1], "bench");
+    Run.Label = argc > 2 ? argv[2] : "se_cmac";
+    Run.Result = 1;
+    if (pthread_attr_init(&Attr) ||
+        pthread_attr_setstack(&Attr, s_Stack, sizeof(s_Stack)) ||
+        pthread_create(&Thread, &Attr, RunTest, &Run) ||
+        pthread_join(Thread, NULL))
+    {
+        fprintf(stderr, "se_cmac: cannot start the test thread\n");
+        return 1;
+    }
+    return Run.Result;
+}
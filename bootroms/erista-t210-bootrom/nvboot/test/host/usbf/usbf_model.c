@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * The USB2 device controller model; see usbf_model.h.
+ *
+ * The model counts as errors what real hardware would not catch but would
+ * get wrong: a prime of an endpoint that is still primed, or whose queue
+ * head has no active DTD to load; a DTD that is not 32-byte aligned; and a
+ * packet that would go past the page of the fifth buffer pointer, or
+ * through a buffer pointer that is not page aligned.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "nvcommon.h"
+#include "nvrm_drf.h"
+#include "arusb.h"
+#include "nvboot_usbf_hw.h"
+#include "host_regs.h"
+#include "usbf_model.h"
+
+#define USB_BASE        NV_ADDRESS_MAP_USB_BASE
+#define QH_BASE         (USB_BASE + USB2_QH_USB2D_QH_EP_0_OUT_0)
+#define PAGE_BYTES      4096
+#define NUM_QHS         (2 * 16)
+
+#define REG(Name)       (USB_BASE + USB2_CONTROLLER_USB2D_##Name##_0)
+
+#define DTD_TERMINATE   0x1
+#define DTD_PTR_MASK    0xffffffe0
+#define TOKEN_ACTIVE    USB_DTD_DRF_DEF(ACTIVE, SET)
+#define TOKEN_HALTED    USB_DQH_DRF_DEF(HALTED, SET)
+#define TOKEN_BYTES(Token) \
+    NV_DRF_VAL(USB2_CONTROLLER_USB2D, DEVICE_TRANSFER_DESCRIPTOR, \
+               TOTAL_BYTES, Token)
+#define TOKEN_SET_BYTES(Token, Bytes) \
+    (((Token) & ~NV_FIELD_SHIFTMASK( \
+        USB2_CONTROLLER_USB2D_DEVICE_TRANSFER_DESCRIPTOR_0_TOTAL_BYTES_RANGE)) | \
+     USB_DTD_DRF_NUM(TOTAL_BYTES, Bytes))
+
+/* Endpoint 1 OUT, the bulk OUT endpoint, in the endpoint bit masks. */
+#define BULK_OUT_BIT    (USB_EP_OUT_MASK << 1)
+
+/* The fields of a setup packet, for the two requests the host makes. */
+#define SETUP_SET_ADDRESS       0x05
+#define SETUP_SET_CONFIGURATION 0x09
+#define DEVICE_ADDRESS          1
+/* From the end of a bus reset or a control transfer to the next setup. */
+#define SETUP_GAP_NS            10000
+
+typedef struct
+{
+    const NvU8 *Data;
+    NvU32 Bytes;
+    NvU32 Sent;
+} ModelWrite;
+
+static UsbfModelLink s_Link;
+static UsbfModelStats s_Stats;
+static NvU64 s_Now;
+
+static NvU32 s_UsbSts;
+static NvU32 s_SetupStat;
+static NvU32 s_EpStatus;
+static NvU32 s_EpComplete;
+static NvU32 s_SetupsSent;
+/* When the host sends its next setup packet; 0 while it waits. */
+static NvU64 s_NextSetupNs;
+
+static ModelWrite s_Writes[USBF_MODEL_MAX_WRITES];
+static NvU32 s_WriteHead;
+static NvU32 s_WriteTail;
+/* When the host sends the next bulk OUT packet, or tries to. */
+static NvU64 s_NextPacketNs;
+/* The bytes of the DTD in each overlay, as it was loaded. */
+static NvU32 s_DtdBytes[NUM_QHS];
+/* The last bulk OUT prime or packet. */
+static NvU64 s_ProgressNs;
+
+static NvBootUsbDevQueueHead *QueueHead(NvU32 Index)
+{
+    return &((NvBootUsbDevQueueHead *)(uintptr_t)QH_BASE)[Index];
+}
+
+static NvBootUsbDevTransDesc *Dtd(NvU32 Addr)
+{
+    return (NvBootUsbDevTransDesc *)(uintptr_t)Addr;
+}
+
+/* The queue head of the endpoint with bit Bit in the endpoint masks. */
+static NvU32 QueueHeadIndex(NvU32 Bit)
+{
+    return (Bit < 16) ? 2 * Bit : 2 * (Bit - 16) + 1;
+}
+
+/*
+ * Loads the DTD Link points to into the overlay of queue head Index.
+ * Returns NV_FALSE if the link terminates or the DTD is not active, which
+ * stops the endpoint.
+ */
+static NvBool LoadDtd(NvU32 Index, NvU32 Link)
+{
+    NvBootUsbDevQueueHead *pQh = QueueHead(Index);
+    NvBootUsbDevTransDesc *pDtd;
+    NvU32 i;
+
+    if (Link & DTD_TERMINATE)
+        return NV_FALSE;
+    if (Link & ~DTD_PTR_MASK & ~DTD_TERMINATE)
+        s_Stats.Errors++;
+    pDtd = Dtd(Link & DTD_PTR_MASK);
+    if (!(pDtd->DtdToken & TOKEN_ACTIVE))
+        return NV_FALSE;
+
+    pQh->CurrentDTDPtr = Link & DTD_PTR_MASK;
+    pQh->NextDTDPtr = pDtd->NextDtd;
+    pQh->DtdToken = pDtd->DtdToken;
+    for (i = 0; i < USBF_MAX_BUFFER_PTRS; i++)
+        pQh->BufferPtrs[i] = pDtd->BufPtrs[i];
+    s_DtdBytes[Index] = TOKEN_BYTES(pDtd->DtdToken);
+    return NV_TRUE;
+}
+
+/* Writes the overlay back to its DTD and loads the next one. */
+static NvBool RetireDtd(NvU32 Bit)
+{
+    NvU32 Index = QueueHeadIndex(Bit);
+    NvBootUsbDevQueueHead *pQh = QueueHead(Index);
+    NvBootUsbDevTransDesc *pDtd = Dtd(pQh->CurrentDTDPtr);
+
+    pQh->DtdToken &= ~TOKEN_ACTIVE;
+    pDtd->DtdToken = pQh->DtdToken;
+    s_EpComplete |= 1 << Bit;
+    if (LoadDtd(Index, pQh->NextDTDPtr))
+    {
+        if (Bit == 1)
+            s_Stats.DtdsLoaded++;
+        return NV_TRUE;
+    }
+    s_EpStatus &= ~(1 << Bit);
+    return NV_FALSE;
+}
+
+static void Prime(NvU32 Bit)
+{
+    NvU32 Index = QueueHeadIndex(Bit);
+    NvBootUsbDevQueueHead *pQh = QueueHead(Index);
+
+    if (s_EpStatus & (1 << Bit))
+    {
+        s_Stats.Errors++;
+        return;
+    }
+    if (!LoadDtd(Index, pQh->NextDTDPtr))
+    {
+        s_Stats.Errors++;
+        return;
+    }
+    s_EpStatus |= 1 << Bit;
+
+    if (Bit == 1)
+    {
+        s_Stats.Primes++;
+        s_Stats.DtdsLoaded++;
+        s_ProgressNs = s_Now;
+        if (s_NextPacketNs < s_Now)
+            s_NextPacketNs = s_Now;
+        return;
+    }
+
+    // The host takes or sends the data stage and the status stage of a
+    // control transfer at once.
+    do
+    {
+        pQh->DtdToken = TOKEN_SET_BYTES(pQh->DtdToken, 0);
+    } while (RetireDtd(Bit));
+    if (Bit == 16)
+        s_NextSetupNs = s_Now + SETUP_GAP_NS;
+}
+
+/* The host address of byte Offset of the DTD in the overlay of pQh. */
+static NvU8 *DmaAddress(NvBootUsbDevQueueHead *pQh, NvU32 Offset)
+{
+    NvU32 Pos = (pQh->BufferPtrs[0] & (PAGE_BYTES - 1)) + Offset;
+    NvU32 Page = Pos / PAGE_BYTES;
+
+    if (Page == 0)
+        return (NvU8 *)(uintptr_t)(pQh->BufferPtrs[0] + Offset);
+    if ((Page >= USBF_MAX_BUFFER_PTRS) ||
+        (pQh->BufferPtrs[Page] & (PAGE_BYTES - 1)))
+        return NULL;
+    return (NvU8 *)(uintptr_t)(pQh->BufferPtrs[Page] + Pos % PAGE_BYTES);
+}
+
+/*
+ * Sends the next bulk OUT packet of the host at time At, or has it NAKed.
+ * Returns the time to the next try.
+ */
+static NvU32 SendPacket(NvU64 At)
+{
+    NvBootUsbDevQueueHead *pQh = QueueHead(QueueHeadIndex(1));
+    ModelWrite *pWrite = &s_Writes[s_WriteHead % USBF_MODEL_MAX_WRITES];
+    NvU32 Bytes = NV_MIN(pWrite->Bytes - pWrite->Sent, USBF_MODEL_MAX_PACKET);
+    NvU32 Left;
+    NvU32 Offset;
+    NvU32 i;
+    NvU8 *p;
+
+    if (!(s_EpStatus & BULK_OUT_BIT) || !(pQh->DtdToken & TOKEN_ACTIVE))
+    {
+        s_Stats.Naks++;
+        return s_Link.RetryNs;
+    }
+
+    Left = TOKEN_BYTES(pQh->DtdToken);
+    if (Bytes > Left)
+    {
+        // A babble halts the endpoint; the host sends the packet again
+        // after the driver has primed it anew.
+        s_Stats.Babbles++;
+        pQh->DtdToken = (pQh->DtdToken & ~TOKEN_ACTIVE) | TOKEN_HALTED;
+        Dtd(pQh->CurrentDTDPtr)->DtdToken = pQh->DtdToken;
+        s_EpStatus &= ~BULK_OUT_BIT;
+        return s_Link.RetryNs;
+    }
+
+    Offset = s_DtdBytes[QueueHeadIndex(1)] - Left;
+    for (i = 0; i < Bytes; i++)
+    {
+        p = DmaAddress(pQh, Offset + i);
+        if (p == NULL)
+        {
+            s_Stats.Errors++;
+            break;
+        }
+        *p = pWrite->Data[pWrite->Sent + i];
+    }
+
+    if (s_Stats.Packets == 0)
+        s_Stats.FirstPacketNs = At;
+    s_Stats.LastPacketNs = At + s_Link.PacketNs;
+    s_Stats.Packets++;
+    s_Stats.BytesAccepted += Bytes;
+    s_ProgressNs = At;
+    pWrite->Sent += Bytes;
+    if (pWrite->Sent == pWrite->Bytes)
+        s_WriteHead++;
+
+    pQh->DtdToken = TOKEN_SET_BYTES(pQh->DtdToken, Left - Bytes);
+    if ((Left == Bytes) || (Bytes < USBF_MODEL_MAX_PACKET))
+        RetireDtd(1);
+    return s_Link.PacketNs;
+}
+
+/* Hands the next setup packet of the enumeration to endpoint 0 OUT. */
+static void SendSetup(void)
+{
+    static const NvU8 Setups[][USB_SETUP_PKT_SIZE] =
+    {
+        { 0x00, SETUP_SET_ADDRESS, DEVICE_ADDRESS, 0, 0, 0, 0, 0 },
+        { 0x00, SETUP_SET_CONFIGURATION, 1, 0, 0, 0, 0, 0 },
+    };
+    NvBootUsbDevQueueHead *pQh = QueueHead(0);
+
+    if (s_SetupsSent == sizeof(Setups) / sizeof(Setups[0]))
+        return;
+    memcpy((void *)&pQh->setupBuffer0, Setups[s_SetupsSent],
+           USB_SETUP_PKT_SIZE);
+    s_SetupsSent++;
+    s_SetupStat = USB_DRF_DEF(ENDPTSETUPSTAT, ENDPTSETUPSTAT0, SETUP_RCVD);
+}
+
+/* Runs the host up to the current time. */
+static void RunHost(void)
+{
+    while ((s_WriteHead != s_WriteTail) && (s_NextPacketNs <= s_Now))
+        s_NextPacketNs += SendPacket(s_NextPacketNs);
+}
+
+static void Advance(NvU64 Ns)
+{
+    s_Now += Ns;
+    RunHost();
+    if (s_NextSetupNs && (s_NextSetupNs <= s_Now))
+    {
+        s_NextSetupNs = 0;
+        SendSetup();
+    }
+    if (s_Now - s_ProgressNs > USBF_MODEL_STALL_NS)
+    {
+        fprintf(stderr, "usbf: no bulk OUT progress for %llu ms\n",
+                (unsigned long long)(USBF_MODEL_STALL_NS / 1000000));
+        abort();
+    }
+}
+
+static NvU32 ReadReg(NvU32 Addr)
+{
+    Advance(USBF_MODEL_REG_NS);
+    switch (Addr)
+    {
+        case REG(USBSTS):
+            return s_UsbSts;
+        case REG(ENDPTSETUPSTAT):
+            return s_SetupStat;
+        case REG(ENDPTPRIME):
+        case REG(ENDPTFLUSH):
+            return 0;
+        case REG(ENDPTSTATUS):
+            return s_EpStatus;
+        case REG(ENDPTCOMPLETE):
+            return s_EpComplete;
+        case REG(HOSTPC1_DEVLC):
+            return NV_FLD_SET_DRF_NUM(USB2_CONTROLLER_USB2D, HOSTPC1_DEVLC,
+                                      PSPD, NvBootUsbfPortSpeed_High,
+                                      HostRegPeek(Addr));
+        default:
+            return HostRegPeek(Addr);
+    }
+}
+
+static void WriteReg(NvU32 Addr, NvU32 Data)
+{
+    NvU32 Bit;
+
+    Advance(USBF_MODEL_REG_NS);
+    switch (Addr)
+    {
+        case REG(USBSTS):
+            if (Data & s_UsbSts & USB_DRF_DEF(USBSTS, URI, USB_RESET))
+                s_NextSetupNs = s_Now + SETUP_GAP_NS;
+            s_UsbSts &= ~Data;
+            break;
+        case REG(ENDPTSETUPSTAT):
+            s_SetupStat &= ~Data;
+            break;
+        case REG(ENDPTPRIME):
+            for (Bit = 0; Bit < 32; Bit++)
+            {
+                if (Data & (1 << Bit))
+                    Prime(Bit);
+            }
+            break;
+        case REG(ENDPTFLUSH):
+            s_EpStatus &= ~Data;
+            break;
+        case REG(ENDPTCOMPLETE):
+            s_EpComplete &= ~Data;
+            break;
+        default:
+            HostRegPoke(Addr, Data);
+            break;
+    }
+}
+
+static void MapQueueHeads(void)
+{
+    static NvBool s_Mapped;
+    void *p;
+
+    if (s_Mapped)
+        return;
+    p = mmap((void *)(uintptr_t)QH_BASE, PAGE_BYTES, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (p != (void *)(uintptr_t)QH_BASE)
+    {
+        fprintf(stderr, "usbf: cannot map the queue heads at 0x%x\n",
+                QH_BASE);
+        exit(1);
+    }
+    s_Mapped = NV_TRUE;
+}
+
+void UsbfModelReset(const UsbfModelLink *pLink)
+{
+    MapQueueHeads();
+    memset((void *)(uintptr_t)QH_BASE, 0, PAGE_BYTES);
+
+    s_Link = *pLink;
+    memset(&s_Stats, 0, sizeof(s_Stats));
+    s_Now = 0;
+    s_EpStatus = 0;
+    s_EpComplete = 0;
+    s_SetupStat = 0;
+    s_SetupsSent = 0;
+    s_NextSetupNs = 0;
+    s_WriteHead = 0;
+    s_WriteTail = 0;
+    s_NextPacketNs = 0;
+    s_ProgressNs = 0;
+
+    // The host resets the bus and the port comes up at high speed.
+    s_UsbSts = USB_DRF_DEF(USBSTS, URI, USB_RESET) |
+               USB_DRF_DEF(USBSTS, PCI, PORT_CHANGE);
+
+    HostRegReset();
+    HostRegHook(USB_BASE, USB2_QH_USB2D_QH_EP_0_OUT_0, ReadReg, WriteReg);
+}
+
+void UsbfModelHostWrite(const NvU8 *Data, NvU32 Bytes)
+{
+    ModelWrite *pWrite;
+
+    if (s_WriteTail - s_WriteHead == USBF_MODEL_MAX_WRITES)
+    {
+        fprintf(stderr, "usbf: too many host writes\n");
+        abort();
+    }
+    if (s_WriteHead == s_WriteTail)
+    {
+        // The writes are recycled once the device has taken them all.
+        s_WriteHead = s_WriteTail = 0;
+        if (s_NextPacketNs < s_Now)
+            s_NextPacketNs = s_Now;
+    }
+    pWrite = &s_Writes[s_WriteTail++ % USBF_MODEL_MAX_WRITES];
+    pWrite->Data = Data;
+    pWrite->Bytes = Bytes;
+    pWrite->Sent = 0;
+}
+
+void UsbfModelBusy(NvU32 Ns)
+{
+    Advance(Ns);
+}
+
+NvU32 UsbfModelHostPending(void)
+{
+    NvU32 Bytes = 0;
+    NvU32 i;
+
+    for (i = s_WriteHead; i != s_WriteTail; i++)
+    {
+        Bytes += s_Writes[i % USBF_MODEL_MAX_WRITES].Bytes -
+                 s_Writes[i % USBF_MODEL_MAX_WRITES].Sent;
+    }
+    return Bytes;
+}
+
+NvU64 UsbfModelNow(void)
+{
+    return s_Now;
+}
+
+NvU32 UsbfModelAddress(void)
+{
+    return NV_DRF_VAL(USB2_CONTROLLER_USB2D, PERIODICLISTBASE, USBADR,
+                      HostRegPeek(REG(PERIODICLISTBASE)));
+}
+
+const UsbfModelStats *UsbfModelGetStats(void)
+{
+    return &s_Stats;
+}
+
+/* Linked in place of NvBootUtilWaitUS(): the wait moves the model clock. */
+void __wrap_NvBootUtilWaitUS(NvU32 Us)
+{
+    Advance((NvU64)Us * 1000);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * usbf_model.h - The USB2 device controller model behind usbf/nvboot_usbf.c
+ * in the host harness.
+ *
+ * usbf_model.c hooks the USB2D registers and maps host memory for the
+ * queue heads, where arusb.h puts them. Behind the registers it runs the
+ * ChipIdea side of the queue heads and DTD lists: a prime loads the first
+ * DTD into the queue head overlay, packets count down its total bytes there
+ * and are written through its page pointers, and a DTD that is full or
+ * ends on a short packet is written back and the next one on its NextDtd
+ * link is loaded. A flush stops the endpoint and leaves the overlay as it
+ * is. Control transfers complete as soon as they are primed.
+ *
+ * A host on the other side of a high-speed link enumerates the device by
+ * SET_ADDRESS and SET_CONFIGURATION, then sends its bulk OUT writes in max
+ * packets, one every UsbfModelLink.PacketNs. A write ends with a short
+ * packet unless its length is a multiple of the max packet. When the
+ * endpoint has no active DTD the packet is NAKed, and the host tries again
+ * UsbfModelLink.RetryNs later, for the NAK and PING rounds.
+ *
+ * Time is kept in nanoseconds. The CPU side moves it by USBF_MODEL_REG_NS
+ * per controller register access and by the waits of the driver. The costs
+ * are assumptions, not measurements. A driver that waits on the endpoint
+ * for USBF_MODEL_STALL_NS while the host has nothing to send, or is NAKed
+ * all along, would hang; the model aborts instead.
+ */
+
+#ifndef INCLUDED_USBF_MODEL_H
+#define INCLUDED_USBF_MODEL_H
+
+#include "nvcommon.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define USBF_MODEL_REG_NS       100
+#define USBF_MODEL_MAX_PACKET   512
+#define USBF_MODEL_MAX_WRITES   256
+#define USBF_MODEL_STALL_NS     1000000000ULL
+
+typedef struct
+{
+    /* From one bulk OUT packet to the next, and from a NAK to the retry. */
+    NvU32 PacketNs;
+    NvU32 RetryNs;
+} UsbfModelLink;
+
+typedef struct
+{
+    /* Bulk OUT bytes the device accepted, and its packets. */
+    NvU32 BytesAccepted;
+    NvU32 Packets;
+    /* Bulk OUT primes, and the DTDs the controller loaded for them. */
+    NvU32 Primes;
+    NvU32 DtdsLoaded;
+    /* Packets NAKed because no DTD was active. */
+    NvU32 Naks;
+    /* Packets larger than what was left of the active DTD. */
+    NvU32 Babbles;
+    /* Start of the first and end of the last bulk OUT packet. */
+    NvU64 FirstPacketNs;
+    NvU64 LastPacketNs;
+    /* Contract violations found by the model; see usbf_model.c. */
+    NvU32 Errors;
+} UsbfModelStats;
+
+/**
+ * Maps the queue heads, hooks the registers and brings up a host that
+ * resets the bus and enumerates the device, with the clock at 0.
+ */
+void UsbfModelReset(const UsbfModelLink *pLink);
+
+/** Queues a bulk OUT write of Bytes from Data, which must stay valid. */
+void UsbfModelHostWrite(const NvU8 *Data, NvU32 Bytes);
+
+/** Keeps the CPU busy with other work for Ns, while the bus goes on. */
+void UsbfModelBusy(NvU32 Ns);
+
+/** Bytes of the queued writes the device has not accepted yet. */
+NvU32 UsbfModelHostPending(void);
+
+/** The model clock, in nanoseconds. */
+NvU64 UsbfModelNow(void);
+
+/** The device address the host set, 0 before SET_ADDRESS. */
+NvU32 UsbfModelAddress(void);
+
+const UsbfModelStats *UsbfModelGetStats(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // INCLUDED_USBF_MODEL_H
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * usbf_stubs.c - The functions usbf/nvboot_usbf.c calls outside enumeration
+ * by SET_ADDRESS and SET_CONFIGURATION and the bulk OUT receive: the SKU
+ * for the device descriptor. The harness never asks for that, so reaching
+ * it aborts.
+ *
+ * The symbols are defined without their headers, so that one macro fits
+ * all of them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MODEL_STUB(Name)                                        \
+    void Name(void)                                             \
+    {                                                           \
+        fprintf(stderr, "usbf: %s called\n", #Name);            \
+        abort();                                                \
+    }
+
+MODEL_STUB(NvBootFuseGetSkuRaw)
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of the bulk OUT receive of usbf/nvboot_usbf.c, through the
+ * functions the RCM port of rcm/nvboot_rcm_port.c calls for RCM_USB_OTG:
+ * SetupUsb(), NvBootUsbfReceiveStart() and WaitForUsbRecvComplete().
+ *
+ * The driver is built unchanged over the controller model of usbf_model.c.
+ * Each case enumerates the device and then receives a message the way the
+ * RCM code does, one receive after the other until it has all the bytes.
+ *
+ * "check" sends random messages of lengths around the DTD and chain sizes,
+ * into buffers at several offsets into a page, in one host write, in
+ * writes that each end with a short packet, and in writes of random
+ * length. It checks that every byte lands in place and nothing around the
+ * message is touched, with a CPU that waits on each receive and with one
+ * that is busy elsewhere while DTDs behind a short packet fill. For a
+ * message in one write it also checks that each receive primes the
+ * endpoint once for a whole chain, and that no packet ever babbles. "bench" prints the time per MB of a
+ * message in one write at high speed, for several times the CPU spends
+ * on other work after starting each receive.
+ *
+ * Built with HOST_OLD, the harness runs the same messages over the driver
+ * of OLD_REV, which primes one DTD of at most 4KB per receive.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvcommon.h"
+#include "nvboot_error.h"
+#include "nvboot_bit.h"
+#include "nvboot_usbf_int.h"
+#include "nvboot_usbf_hw.h"
+#include "usbf_model.h"
+
+#if HOST_OLD
+#define RECEIVE_BYTES       NVBOOT_USB_MAX_TXFR_SIZE_BYTES
+#else
+#define RECEIVE_BYTES       NVBOOT_USB_MAX_RECEIVE_SIZE_BYTES
+#endif
+
+#define MAX_MESSAGE         200001
+#define BENCH_BYTES         (1024 * 1024)
+#define BENCH_RETRY_NS      30000
+#define PAGE_BYTES          4096
+#define CANARY              0xa5
+#define GUARD_BYTES         PAGE_BYTES
+/* 13 packets of 512 bytes per 125us microframe. */
+#define HIGH_SPEED_NS       (125000 / 13)
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "usbf: %s:%d: %s\n", __FILE__, __LINE__,    \
+                    #Cond);                                             \
+        }                                                               \
+    } while (0)
+
+/* Defined by nvboot_usbf_common.c, which the harness does not build. */
+NvBootUsbfContext s_UsbfContext;
+NvBootUsbfContext *s_pUsbfCtxt = &s_UsbfContext;
+NvBootInfoTable BootInfoTable;
+
+/* The buffers stay in static storage, below 4GB; see host.mk. */
+static NvU8 s_Buffer[GUARD_BYTES + BENCH_BYTES + GUARD_BYTES]
+    __attribute__((aligned(PAGE_BYTES)));
+static NvU8 s_EnumBuffer[NVBOOT_USB_MAX_TXFR_SIZE_BYTES]
+    __attribute__((aligned(PAGE_BYTES)));
+static NvU8 s_HostMsg[BENCH_BYTES];
+
+void NvBootWdtStop(void)
+{
+}
+
+static NvBool Connect(NvU32 PacketNs, NvU32 RetryNs)
+{
+    UsbfModelLink Link;
+
+    Link.PacketNs = PacketNs;
+    Link.RetryNs = RetryNs;
+    UsbfModelReset(&Link);
+
+    memset(&s_UsbfContext, 0, sizeof(s_UsbfContext));
+    s_UsbfContext.UsbBaseAddr = NV_ADDRESS_MAP_USB_BASE;
+    s_UsbfContext.UsbControllerEnabled = NV_TRUE;
+    return (SetupUsb(s_EnumBuffer) == NvBootError_Success) &&
+           (UsbfModelAddress() != 0);
+}
+
+/*
+ * Receives Bytes into pDst as the RCM code does, one receive at a time,
+ * with the CPU busy for BusyNs after starting each one.
+ */
+static NvBootError Receive(NvU8 *pDst, NvU32 Bytes, NvU32 BusyNs,
+                           NvU32 *pReceives)
+{
+    NvBootError e;
+    NvU32 Got = 0;
+    NvU32 n;
+
+    *pReceives = 0;
+    while (Got < Bytes)
+    {
+        NvBootUsbfReceiveStart(pDst + Got, Bytes - Got);
+        UsbfModelBusy(BusyNs);
+        e = WaitForUsbRecvComplete(&n, 0, s_EnumBuffer);
+        (*pReceives)++;
+        if (e != NvBootError_Success)
+            return e;
+        if ((n == 0) || (n > Bytes - Got))
+            return NvBootError_TxferFailed;
+        Got += n;
+    }
+    return NvBootError_Success;
+}
+
+static void BuildMessage(NvU32 Length)
+{
+    NvU32 i;
+
+    for (i = 0; i < Length; i++)
+        s_HostMsg[i] = rand();
+}
+
+/* Queues the message in writes of WriteBytes, or of random length if 0. */
+static void HostWrites(NvU32 Length, NvU32 WriteBytes)
+{
+    NvU32 Sent = 0;
+    NvU32 Bytes;
+
+    while (Sent < Length)
+    {
+        Bytes = WriteBytes ? WriteBytes : 1 + rand() % (40 * 1024);
+        Bytes = NV_MIN(Bytes, Length - Sent);
+        UsbfModelHostWrite(s_HostMsg + Sent, Bytes);
+        Sent += Bytes;
+    }
+}
+
+static NvBool IsGuardIntact(const NvU8 *p, NvU32 Bytes)
+{
+    NvU32 i;
+
+    for (i = 0; i < Bytes; i++)
+    {
+        if (p[i] != CANARY)
+            return NV_FALSE;
+    }
+    return NV_TRUE;
+}
+
+/*
+ * Receives a message in one write takes: one per RECEIVE_BYTES, and one
+ * more for the part of the last packet a chain of DTDs leaves over.
+ */
+static NvU32 ExpectedReceives(NvU32 Length)
+{
+    NvU32 Receives = (Length + RECEIVE_BYTES - 1) / RECEIVE_BYTES;
+#if !HOST_OLD
+    NvU32 Last = Length - (Receives - 1) * RECEIVE_BYTES;
+
+    if ((Last > USBF_DTD_MAX_BYTES) && (Last % USB_HIGH_SPEED_PKT_SIZE_BYTES))
+        Receives++;
+#endif
+    return Receives;
+}
+
+static void CheckMessages(void)
+{
+    static const NvU32 Lengths[] =
+    {
+        1, 511, 512, 513, 4095, 4096, 4097, 16383, 16384, 16385,
+        16384 + 512, 3 * 16384 - 1, 65535, 65536, 65537, 131072 + 1000,
+        MAX_MESSAGE
+    };
+    static const NvU32 Offsets[] = { 0, 4, 0x2a8, 4092 };
+    /* One write; writes ending short; max packet multiples; random. */
+    static const NvU32 Writes[] = { MAX_MESSAGE, 1000, 16384, 0 };
+    /* A CPU that waits on the receive, and one busy for 20 packets. */
+    static const NvU32 BusyNs[] = { 0, 20 * HIGH_SPEED_NS };
+    const UsbfModelStats *pStats = UsbfModelGetStats();
+    NvU32 l, o, w, b, Length, Receives;
+    NvU8 *pDst;
+    NvBootError e;
+
+    for (b = 0; b < sizeof(BusyNs) / sizeof(BusyNs[0]); b++)
+    for (l = 0; l < sizeof(Lengths) / sizeof(Lengths[0]); l++)
+    for (o = 0; o < sizeof(Offsets) / sizeof(Offsets[0]); o++)
+    for (w = 0; w < sizeof(Writes) / sizeof(Writes[0]); w++)
+    {
+        Length = Lengths[l];
+        pDst = s_Buffer + GUARD_BYTES + Offsets[o];
+        memset(s_Buffer, CANARY, GUARD_BYTES + MAX_MESSAGE + 2 * PAGE_BYTES);
+        BuildMessage(Length);
+
+        if (!Connect(HIGH_SPEED_NS, HIGH_SPEED_NS))
+        {
+            CHECK(!"enumeration");
+            continue;
+        }
+        HostWrites(Length, Writes[w]);
+        e = Receive(pDst, Length, BusyNs[b], &Receives);
+
+        CHECK(e == NvBootError_Success);
+        CHECK(!memcmp(pDst, s_HostMsg, Length));
+        CHECK(IsGuardIntact(s_Buffer, pDst - s_Buffer));
+        CHECK(IsGuardIntact(pDst + Length, PAGE_BYTES));
+        CHECK(UsbfModelHostPending() == 0);
+        CHECK(pStats->Errors == 0);
+        /* No packet of the next write straddles the end of a chain, even
+         * when a busy CPU lets it reach the last DTD. */
+        CHECK(pStats->Babbles == 0);
+        if (Writes[w] >= Length)
+        {
+            CHECK(Receives == ExpectedReceives(Length));
+            CHECK(pStats->Primes == Receives);
+        }
+    }
+}
+
+static int Check(const char *Label)
+{
+    CheckMessages();
+
+    printf("%s: %u checks, %u failures\n", Label, s_Cases, s_Failures);
+    return s_Failures != 0;
+}
+
+/*
+ * Time per MB of a message in one write, at high speed, with the CPU busy
+ * for a while after starting each receive as the RCM code is when it
+ * works on the data of the last one.
+ */
+static int Bench(const char *Label)
+{
+    static const NvU32 BusyNs[] = { 0, 20000, 100000, 400000 };
+    const UsbfModelStats *pStats = UsbfModelGetStats();
+    NvU32 b, Receives;
+    NvU64 Start;
+    NvU64 Ns;
+    NvBootError e;
+
+    BuildMessage(BENCH_BYTES);
+
+    printf("%s: %u-byte message in one write, high speed, retry %u us\n",
+           Label, BENCH_BYTES, BENCH_RETRY_NS / 1000);
+    printf("  %8s %9s %9s %8s %8s %7s\n", "busy us", "us per MB", "MB/s",
+           "receives", "DTDs", "NAKs");
+    for (b = 0; b < sizeof(BusyNs) / sizeof(BusyNs[0]); b++)
+    {
+        if (!Connect(HIGH_SPEED_NS, BENCH_RETRY_NS))
+        {
+            fprintf(stderr, "usbf: enumeration failed\n");
+            return 1;
+        }
+        Start = UsbfModelNow();
+        UsbfModelHostWrite(s_HostMsg, BENCH_BYTES);
+        e = Receive(s_Buffer, BENCH_BYTES, BusyNs[b], &Receives);
+        if ((e != NvBootError_Success) || pStats->Errors ||
+            memcmp(s_Buffer, s_HostMsg, BENCH_BYTES))
+        {
+            fprintf(stderr, "usbf: receive failed\n");
+            return 1;
+        }
+        Ns = UsbfModelNow() - Start;
+        printf("  %8u %9.1f %9.1f %8u %8u %7u\n", BusyNs[b] / 1000,
+               Ns / 1000.0, BENCH_BYTES * 1000.0 / Ns, Receives,
+               pStats->DtdsLoaded, pStats->Naks);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if ((argc > 1) && !strcmp(argv[1], "bench"))
+        return Bench(argc > 2 ? argv[2] : "usbf");
+    return Check(argc > 2 ? argv[2] : "usbf");
+}
@@ -290,6 +290,29 @@ NvBootUsbfHwTxfrStart(
     NvU32 maxTxfrBytes,
     NvBool WaitForTxfrComplete);
 
+/**
+ * Sets up a DTD for Bytes of data at Addr, terminating the DTD list.
+ */
+static void
+NvBootUsbfHwFillDtd(
+    NvBootUsbDevTransDesc *pUsbDevTxfrDesc,
+    NvU32 Addr,
+    NvU32 Bytes);
+
+/**
+ * Returns NV_TRUE if a short packet retired a Bulk OUT DTD before the
+ * last one of the chain.
+ */
+static NvBool NvBootUsbfHwBulkOutChainEndedShort(void);
+
+/**
+ * Once the Bulk OUT endpoint is flushed after a short packet, moves the
+ * data that went on landing in later DTDs of the chain down to follow the
+ * short one, and rewrites the DTD tokens to describe the data as received
+ * in one piece.
+ */
+static void NvBootUsbfHwBulkOutChainCompact(void);
+
 /**
  * Clears any pending transfer on an endpoint.
  */
@@ -664,13 +687,13 @@ void NvBootUsbfReceiveStart(NvU8 *pDataBuf, NvU32 DataSize)
     NV_ASSERT(s_pUsbfCtxt);
     NV_ASSERT(s_pUsbfCtxt->UsbControllerEnabled);
     NV_ASSERT(pDataBuf);
-    // Address must be 4K bytes aligned
-    NV_ASSERT(!(PTR_TO_ADDR(pDataBuf)&(NVBOOT_USB_BUFFER_ALIGNMENT-1)));
+    // Address need not be aligned: RCM receives the payload in place, and
+    // the DTD page pointers let the transfer cross one page boundary.
 
-    // Check resquest size is more than the USB buffer size
-    if (DataSize > NVBOOT_USB_MAX_TXFR_SIZE_BYTES)
+    // Check resquest size is more than one chain of DTDs
+    if (DataSize > NVBOOT_USB_MAX_RECEIVE_SIZE_BYTES)
     {
-        DataSize = NVBOOT_USB_MAX_TXFR_SIZE_BYTES;
+        DataSize = NVBOOT_USB_MAX_RECEIVE_SIZE_BYTES;
     }
 
     // Initiate the recieve operation and come out
@@ -681,7 +704,11 @@ void NvBootUsbfReceiveStart(NvU8 *pDataBuf, NvU32 DataSize)
 NvU32 NvBootUsbfGetBytesReceived(void)
 {
     NvBootUsbfEpStatus EpStatus;
-    NvBootUsbDevQueueHead *pQueueHead = NULL;
+    NvBootUsbDevTransDesc *pUsbDevTxfrDesc;
+    NvU32 BytesLeft;
+    NvU32 DtdBytes;
+    NvU32 BytesReceived = 0;
+    NvU32 Dtd;
 
     // Validating the parameters 
     NV_ASSERT(s_pUsbfCtxt);
@@ -693,11 +720,20 @@ NvU32 NvBootUsbfGetBytesReceived(void)
     // Update the buffer and bytes recived only if transfer is completed
     if (EpStatus == NvBootUsbfEpStatus_TxfrComplete)
     {
-        // Temporary pointer to queue head.
-        pQueueHead = &s_pUsbDescriptorBuf->pQueueHead[USB_EP_BULK_OUT];
-        // Get the actual bytes transfered by USB controller
-        return (s_pUsbDescriptorBuf->BytesRequestedForEp[USB_EP_BULK_OUT] -
-                USB_DQH_DRF_VAL(TOTAL_BYTES, pQueueHead->DtdToken));
+        // Add up the bytes each DTD of the chain took in, up to the one
+        // a short packet ended.
+        BytesLeft = s_pUsbDescriptorBuf->BytesRequestedForEp[USB_EP_BULK_OUT];
+        for (Dtd = 0; Dtd < s_pUsbDescriptorBuf->BulkOutDtdCount; Dtd++)
+        {
+            pUsbDevTxfrDesc = &s_pUsbDescriptorBuf->BulkOutDtdChain[Dtd];
+            DtdBytes = NV_MIN(BytesLeft, USBF_DTD_MAX_BYTES);
+            BytesReceived += DtdBytes -
+                USB_DTD_DRF_VAL(TOTAL_BYTES, pUsbDevTxfrDesc->DtdToken);
+            if (USB_DTD_DRF_VAL(TOTAL_BYTES, pUsbDevTxfrDesc->DtdToken))
+                break;
+            BytesLeft -= DtdBytes;
+        }
+        return BytesReceived;
     }
 
     // return 0 if transfer is not happend
@@ -1271,6 +1307,9 @@ NvBootUsbfHwTxfrStart(
     NvBootUsbDevQueueHead *pUsbDevQueueHead;
     NvBootUsbfEpStatus EpStatus;
     NvU32 regVal;
+    NvU32 Dtd;
+    NvU32 DtdBytes;
+    NvU32 PacketBytes;
 
     // Clear leftover transfer, if any.before starting the transaction
     NvBootUsbfHwTxfrClear(pUsbFuncCtxt, EndPoint);
@@ -1286,10 +1325,21 @@ NvBootUsbfHwTxfrStart(
         pUsbDevQueueHead->EpCapabilities = USB_DQH_DRF_DEF(IOC, ENABLE);
     }
     // setup the Q head with Max packet length and zero length terminate
+    PacketBytes = NvBootUsbfHwGetPacketSize(pUsbFuncCtxt, EndPoint);
     pUsbDevQueueHead->EpCapabilities |= (USB_DQH_DRF_NUM(MAX_PACKET_LENGTH,
-                        NvBootUsbfHwGetPacketSize( pUsbFuncCtxt, EndPoint))|
+                        PacketBytes)|
                         USB_DQH_DRF_DEF(ZLT, ZERO_LENGTH_TERM_DISABLED));
 
+    // Once a short packet has retired a DTD of a Bulk OUT chain, the host's
+    // next transfer lands in the DTDs behind it. A chain of more than one
+    // DTD therefore takes whole packets only, so that no packet can
+    // straddle its end and halt the endpoint. The rest of the request is
+    // left to the next receive.
+    if ((EndPoint == USB_EP_BULK_OUT) && (maxTxfrBytes > USBF_DTD_MAX_BYTES))
+    {
+        maxTxfrBytes -= maxTxfrBytes % PacketBytes;
+    }
+
     // Don't to terminate the next DTD pointer by writing 0 = Clear
     // we will assign the DTD pointer after configuring DTD
     pUsbDevQueueHead->NextDTDPtr = USB_DQH_DRF_DEF(TERMINATE, CLEAR);
@@ -1298,18 +1348,41 @@ NvBootUsbfHwTxfrStart(
     //Store the Bytes requested by client
     s_pUsbDescriptorBuf->BytesRequestedForEp[EndPoint] = maxTxfrBytes;
 
-    // Reference to DTD for configureation.
-    pUsbDevTxfrDesc = &s_pUsbDescriptorBuf->pDataTransDesc[EndPoint];
-    // clear the DTD before configuration
-    NvBootUtilMemset(pUsbDevTxfrDesc, 0, sizeof(NvBootUsbDevTransDesc));
-
-    // Setup the DTD
-    pUsbDevTxfrDesc->NextDtd = USB_DTD_DRF_DEF(TERMINATE, SET);
-    // Set number of bytes to transfer in DTD.and set status to active
-    pUsbDevTxfrDesc->DtdToken = USB_DTD_DRF_DEF(ACTIVE, SET)|
-                                USB_DTD_DRF_NUM(TOTAL_BYTES, maxTxfrBytes);
-    // Assign buffer pointer to DTD.
-    pUsbDevTxfrDesc->BufPtrs[0] = PTR_TO_ADDR(pDataBuf);
+    if (EndPoint == USB_EP_BULK_OUT)
+    {
+        // Link one DTD per USBF_DTD_MAX_BYTES, so that the controller moves
+        // from one to the next without the endpoint being primed again.
+        pUsbDevTxfrDesc = &s_pUsbDescriptorBuf->BulkOutDtdChain[0];
+        Dtd = 0;
+        do
+        {
+            DtdBytes = NV_MIN(maxTxfrBytes - Dtd * USBF_DTD_MAX_BYTES,
+                              USBF_DTD_MAX_BYTES);
+            NvBootUsbfHwFillDtd(&pUsbDevTxfrDesc[Dtd],
+                                PTR_TO_ADDR(pDataBuf) + Dtd * USBF_DTD_MAX_BYTES,
+                                DtdBytes);
+            if (Dtd > 0)
+            {
+                // The link has the layout of the queue head's next DTD pointer.
+                pUsbDevTxfrDesc[Dtd - 1].NextDtd =
+                    USB_DQH_DRF_DEF(TERMINATE, CLEAR) |
+                    USB_DQH_DRF_NUM(NEXT_DTD_PTR,
+                                    (PTR_TO_ADDR(&pUsbDevTxfrDesc[Dtd]) >>
+                                    USB_DQH_FLD_SHIFT_VAL(NEXT_DTD_PTR)));
+            }
+            Dtd++;
+        } while ((Dtd < USBF_MAX_BULK_OUT_DTDS) &&
+                 (Dtd * USBF_DTD_MAX_BYTES < maxTxfrBytes));
+        s_pUsbDescriptorBuf->BulkOutDtdCount = Dtd;
+        s_pUsbDescriptorBuf->BulkOutBufAddr = PTR_TO_ADDR(pDataBuf);
+    }
+    else
+    {
+        // Reference to DTD for configureation.
+        pUsbDevTxfrDesc = &s_pUsbDescriptorBuf->pDataTransDesc[EndPoint];
+        NvBootUsbfHwFillDtd(pUsbDevTxfrDesc, PTR_TO_ADDR(pDataBuf),
+                            maxTxfrBytes);
+    }
 
     ///Next DTD address need to program only upper 27 bits
     pUsbDevQueueHead->NextDTDPtr |= USB_DQH_DRF_NUM(NEXT_DTD_PTR,
@@ -1346,6 +1419,125 @@ NvBootUsbfHwTxfrStart(
 }
 
 
+static void
+NvBootUsbfHwFillDtd(
+    NvBootUsbDevTransDesc *pUsbDevTxfrDesc,
+    NvU32 Addr,
+    NvU32 Bytes)
+{
+    NvU32 Page;
+
+    // clear the DTD before configuration
+    NvBootUtilMemset(pUsbDevTxfrDesc, 0, sizeof(NvBootUsbDevTransDesc));
+
+    // Setup the DTD
+    pUsbDevTxfrDesc->NextDtd = USB_DTD_DRF_DEF(TERMINATE, SET);
+    // Set number of bytes to transfer in DTD.and set status to active
+    pUsbDevTxfrDesc->DtdToken = USB_DTD_DRF_DEF(ACTIVE, SET)|
+                                USB_DTD_DRF_NUM(TOTAL_BYTES, Bytes);
+    // Assign buffer pointer to DTD. The first pointer carries the offset
+    // into its page; the rest name the following pages, so that a buffer
+    // which is not page aligned may cross into the next page.
+    pUsbDevTxfrDesc->BufPtrs[0] = Addr;
+    for (Page = 1; Page < USBF_MAX_BUFFER_PTRS; Page++)
+    {
+        pUsbDevTxfrDesc->BufPtrs[Page] =
+            (Addr & ~(NVBOOT_USB_BUFFER_ALIGNMENT - 1)) +
+            (Page * NVBOOT_USB_BUFFER_ALIGNMENT);
+    }
+}
+
+
+static NvBool NvBootUsbfHwBulkOutChainEndedShort(void)
+{
+    NvBootUsbDevTransDesc *pUsbDevTxfrDesc;
+    NvU32 Dtd;
+
+    // The controller retires a DTD on a short packet and goes on to the
+    // next one, which would wait for more data from the host.
+    for (Dtd = 0; Dtd + 1 < s_pUsbDescriptorBuf->BulkOutDtdCount; Dtd++)
+    {
+        pUsbDevTxfrDesc = &s_pUsbDescriptorBuf->BulkOutDtdChain[Dtd];
+        if (USB_DTD_DRF_VAL(ACTIVE, pUsbDevTxfrDesc->DtdToken))
+            return NV_FALSE;
+        if (USB_DTD_DRF_VAL(TOTAL_BYTES, pUsbDevTxfrDesc->DtdToken))
+            return NV_TRUE;
+    }
+    return NV_FALSE;
+}
+
+
+static void NvBootUsbfHwBulkOutChainCompact(void)
+{
+    NvBootUsbDevTransDesc *pUsbDevTxfrDesc;
+    NvBootUsbDevQueueHead *pQueueHead;
+    NvU8 *pSrc;
+    NvU8 *pDst;
+    NvU32 BytesLeft;
+    NvU32 DtdBytes;
+    NvU32 DtdLeft;
+    NvU32 Received;
+    NvU32 Total = 0;
+    NvU32 Dtd;
+    NvU32 i;
+
+    pQueueHead = &s_pUsbDescriptorBuf->pQueueHead[USB_EP_BULK_OUT];
+
+    // The host goes on sending its next transfer once a short packet has
+    // retired a DTD, and the controller puts it in the next DTD of the
+    // chain, at its 16KB offset. Move it down so the data stays in order.
+    BytesLeft = s_pUsbDescriptorBuf->BytesRequestedForEp[USB_EP_BULK_OUT];
+    for (Dtd = 0; Dtd < s_pUsbDescriptorBuf->BulkOutDtdCount; Dtd++)
+    {
+        pUsbDevTxfrDesc = &s_pUsbDescriptorBuf->BulkOutDtdChain[Dtd];
+        DtdBytes = NV_MIN(BytesLeft, USBF_DTD_MAX_BYTES);
+        BytesLeft -= DtdBytes;
+
+        DtdLeft = DtdBytes;
+        if (!USB_DTD_DRF_VAL(ACTIVE, pUsbDevTxfrDesc->DtdToken))
+        {
+            DtdLeft = USB_DTD_DRF_VAL(TOTAL_BYTES, pUsbDevTxfrDesc->DtdToken);
+        }
+        else if ((USB_DQH_DRF_VAL(NEXT_DTD_PTR, pQueueHead->CurrentDTDPtr) <<
+                  USB_DQH_FLD_SHIFT_VAL(NEXT_DTD_PTR)) ==
+                 PTR_TO_ADDR(pUsbDevTxfrDesc))
+        {
+            // The flush stopped this DTD; its progress is in the queue head,
+            // whose current DTD pointer has the layout of the next one.
+            DtdLeft = USB_DQH_DRF_VAL(TOTAL_BYTES, pQueueHead->DtdToken);
+        }
+        Received = DtdBytes - DtdLeft;
+
+        // Byte by byte, upwards: the data may only move down and the two
+        // ranges may overlap.
+        pSrc = (NvU8 *)(s_pUsbDescriptorBuf->BulkOutBufAddr +
+                        Dtd * USBF_DTD_MAX_BYTES);
+        pDst = (NvU8 *)(s_pUsbDescriptorBuf->BulkOutBufAddr + Total);
+        if (pDst != pSrc)
+        {
+            for (i = 0; i < Received; i++)
+                pDst[i] = pSrc[i];
+        }
+        Total += Received;
+    }
+
+    // Describe the data as if the chain had filled its DTDs in order, so
+    // that the first DTD not full marks the end of it. Doing this again
+    // moves nothing.
+    BytesLeft = s_pUsbDescriptorBuf->BytesRequestedForEp[USB_EP_BULK_OUT];
+    for (Dtd = 0; Dtd < s_pUsbDescriptorBuf->BulkOutDtdCount; Dtd++)
+    {
+        pUsbDevTxfrDesc = &s_pUsbDescriptorBuf->BulkOutDtdChain[Dtd];
+        DtdBytes = NV_MIN(BytesLeft, USBF_DTD_MAX_BYTES);
+        BytesLeft -= DtdBytes;
+        Received = NV_MIN(Total, DtdBytes);
+        Total -= Received;
+        pUsbDevTxfrDesc->DtdToken =
+            USB_DTD_DRF_NUM(TOTAL_BYTES, DtdBytes - Received);
+    }
+}
+
+
 static NvBootError
 NvBootUsbfHwTxfrWait(
     NvBootUsbfContext *pUsbFuncCtxt,
@@ -1565,6 +1757,13 @@ NvBootUsbfHwTxfrClear (
                 &s_pUsbDescriptorBuf->pDataTransDesc[EndPoint],
                 0,
                 sizeof(NvBootUsbDevTransDesc));
+    if (EndPoint == USB_EP_BULK_OUT)
+    {
+        NvBootUtilMemset(&s_pUsbDescriptorBuf->BulkOutDtdChain[0], 0,
+                         sizeof(s_pUsbDescriptorBuf->BulkOutDtdChain));
+        s_pUsbDescriptorBuf->BulkOutDtdCount = 0;
+        s_pUsbDescriptorBuf->BulkOutBufAddr = 0;
+    }
     // clear the transfer descriptor for this endpoint
     NvBootUtilMemset(&s_pUsbDescriptorBuf->pQueueHead[EndPoint],
                         0, sizeof(NvBootUsbDevQueueHead));
@@ -1629,6 +1828,18 @@ NvBootUsbfHwEpGetStatus(
             EpStatus = NvBootUsbfEpStatus_TxfrFail;
             goto Exit;
         }
+        // A short packet ends a Bulk OUT receive even if DTDs of the chain
+        // are left; flush them, then gather what reached them already.
+        // What the host sends after the flush goes to the next receive.
+        if ((EndPoint == USB_EP_BULK_OUT) &&
+            s_pUsbDescriptorBuf->EpConfigured[EndPoint] &&
+            NvBootUsbfHwBulkOutChainEndedShort())
+        {
+            NvBootUsbfHwEndPointFlush(EndPoint);
+            NvBootUsbfHwBulkOutChainCompact();
+            EpStatus = NvBootUsbfEpStatus_TxfrComplete;
+            goto Exit;
+        }
         // If endpoint active, check to see if it has completed an operation.
         if ((USB_REG_RD(ENDPTPRIME) & USB_EP_NUM_TO_WORD_MASK(EndPoint)) ||
             (USB_REG_RD(ENDPTSTATUS) & USB_EP_NUM_TO_WORD_MASK(EndPoint)) )
@@ -232,6 +232,15 @@ enum {USBF_MAX_DTDS = 4};
 /* maximum H/W buffers pointers in the descriptors */
 enum {USBF_MAX_BUFFER_PTRS = 5};
 
+/* maximum DTDs chained on the Bulk OUT endpoint for one receive */
+enum {USBF_MAX_BULK_OUT_DTDS = 4};
+
+/*
+ * Bytes described by one chained DTD. Its buffer pointers always cover
+ * 4 full pages, whatever the offset of the buffer into the first page.
+ */
+enum {USBF_DTD_MAX_BYTES = 4 * 4096};
+
 /*
  * NvBootUsbfPortSpeed -- Defines the USB Port Speed
  */
@@ -303,6 +312,9 @@ typedef enum
 #define USB_DTD_DRF_NUM(field, number) \
     NV_DRF_NUM(USB2_CONTROLLER_USB2D, DEVICE_TRANSFER_DESCRIPTOR, field, number) 
 
+#define USB_DTD_DRF_VAL(field, value) \
+    NV_DRF_VAL(USB2_CONTROLLER_USB2D, DEVICE_TRANSFER_DESCRIPTOR, field, value) 
+
 
 /* Defines for USB IF registers read and writes */
 #define USBIF_REG_RD(base, reg)\
@@ -474,12 +486,19 @@ typedef struct NvBootUsbDescriptorDataRec
     // device transfer decriptor pointer.
     // All the Transfer Descriptors must be 32byte aligned
     NvBootUsbDevTransDesc pDataTransDesc[USBF_MAX_DTDS];
+    // DTDs for the Bulk OUT endpoint, linked one after the other so that
+    // a receive larger than one DTD is primed only once.
+    NvBootUsbDevTransDesc BulkOutDtdChain[USBF_MAX_BULK_OUT_DTDS];
     // The EndPoint Queue Head List MUST be aligned to a 2k boundary.
     NvBootUsbDevQueueHead *pQueueHead;
     // This variable is used to indicate EP is configured or not
     volatile NvU32 EpConfigured[USBF_MAX_EP_COUNT];
     // This variable is used for storing the bytes requested
     volatile NvU32 BytesRequestedForEp[USBF_MAX_EP_COUNT];
+    // Number of DTDs in the Bulk OUT chain.
+    volatile NvU32 BulkOutDtdCount;
+    // Address of the buffer the Bulk OUT chain receives into.
+    volatile NvU32 BulkOutBufAddr;
 
 } NvBootUsbDescriptorData; 
 
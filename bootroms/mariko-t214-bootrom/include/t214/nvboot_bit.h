@@ -368,6 +368,25 @@ typedef union NvBootSecondaryDeviceStatusRec
 
 } NvBootSecondaryDeviceStatus;
 
+/**
+ * Defines the statistics of the device manager read-ahead cache.
+ *
+ * The hit rate is NumHits / NumReads.
+ */
+typedef struct NvBootReadAheadStatusRec
+{
+    /// Specifies the number of reads issued through the device manager.
+    NvU32 NumReads;
+
+    /// Specifies the number of reads served, fully or partially, from the
+    /// read-ahead cache.
+    NvU32 NumHits;
+
+    /// Specifies the number of bytes copied out of the read-ahead cache
+    /// instead of being read from the device.
+    NvU32 BytesSaved;
+} NvBootReadAheadStatus;
+
 /*
  * Boot time logging
  */
@@ -398,6 +417,35 @@ typedef struct NvBootFlowLogRec
     NvU32	NvBootFlowFuncStatus; // function exit status
 } NvBootFlowLog;
 
+/**
+ * Set in the CheckPoint of a task timing entry that times the wait in the
+ * poll hook of the task with that checkpoint: from the return of the task
+ * to the poll that found it complete. Other tasks run during the wait, so
+ * it overlaps with their entries.
+ */
+#define NVBOOT_TASK_TIMING_POLL_WAIT 0x8000
+
+/**
+ * Defines the execution time statistics of one dispatcher checkpoint.
+ *
+ * Unlike BootFlowLog, the table does not wrap: each checkpoint ID owns one
+ * entry for the whole boot, and IDs seen after the table is full are only
+ * counted in TaskTimingDropped.
+ */
+typedef struct NvBootTaskTimingRec
+{
+    /// Specifies the checkpoint ID of the task, 0 if the entry is unused.
+    NvU16 CheckPoint;
+
+    /// Specifies the number of times the task ran.
+    NvU16 Count;
+
+    /// Specifies the shortest, longest and latest run time in microseconds.
+    NvU32 MinUs;
+    NvU32 MaxUs;
+    NvU32 LastUs;
+} NvBootTaskTiming;
+
  /**
   * Defines the status codes pertaining to BootROM flow.
  *  Each important component state is logged as the BR proceeds  
@@ -712,6 +760,18 @@ typedef struct NvBootInfoTableRec
     /// memory following the BCT.
     NvU32               SafeStartAddr;
 
+    /// Specifies the statistics of the device manager read-ahead cache.
+    NvBootReadAheadStatus ReadAheadStatus;
+
+    /// Specifies the number of task runs not recorded in TaskTiming
+    /// because the table was full.
+    NvU32               TaskTimingDropped;
+
+    /// Specifies the run time statistics of the tasks executed by the
+    /// non-secure and secure dispatchers, in order of first execution.
+    /// Must stay the last field: NvBootMainSecureInit() preserves it.
+    NvBootTaskTiming    TaskTiming[NVBOOT_TASK_TIMING_DEPTH];
+
 } NvBootInfoTable;
 
 #if defined(__cplusplus)
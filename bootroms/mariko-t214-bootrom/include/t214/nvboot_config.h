@@ -121,7 +121,7 @@ extern "C"
 /**
  * Defines the maximum size needed by the BIT.
  */
-#define NVBOOT_BIT_REQUIRED_SIZE 1124
+#define NVBOOT_BIT_REQUIRED_SIZE 1652
 
 /**
  * Defines the maximum number of bootloader descriptions in the BCT.
@@ -167,6 +167,11 @@ extern "C"
  */
 #define NVBOOT_FLOW_LOG_DEPTH  40
 
+/*
+ * Defines the number of checkpoints with timing statistics in the BIT
+ */
+#define NVBOOT_TASK_TIMING_DEPTH  32
+
 /**
  * Defines the maximum number of blocks to search for BCTs.
  *
@@ -168,6 +168,24 @@ typedef struct NvBootAesCmacHashParamsRec
     NvU32 K2[NVBOOT_AES_BLOCK_LENGTH_WORDS]; //__attribute__((aligned(NVBOOT_CRYPTO_BUFFER_ALIGNMENT)));
 } NvBootAesCmacHashParams;
 
+/**
+ * Defines the state of an incremental AES-CMAC computation.
+ *
+ * The last block of data seen is held back in Pending until more data
+ * arrives or the MAC is finalized, since only the last block is combined
+ * with K1 (complete block) or K2 (padded block).
+ */
+typedef struct NvBootAesCmacContextRec
+{
+    NvBootAesCmacHashParams Subkeys;
+    NvU8 *KeySchedule;
+    NvBootAesKeySize KeySize;
+    /// Specifies the CBC-MAC of the blocks processed so far.
+    NvU32 Chain[NVBOOT_AES_BLOCK_LENGTH_WORDS];
+    NvU32 Pending[NVBOOT_AES_BLOCK_LENGTH_WORDS];
+    NvU32 PendingBytes;
+} NvBootAesCmacContext;
+
 typedef struct NvBootAesParamsRec
 {
     //NvBootCryptoMgrAesCryptoStatus Status;
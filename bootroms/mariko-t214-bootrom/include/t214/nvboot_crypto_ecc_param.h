@@ -287,6 +287,13 @@ static const NvBootEccPrimeFieldParamsP256 EccPrimeFieldParamsP256_NIST_P256 =
         0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
         0x01, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,
     },
+    .b =
+    {
+        0x4B, 0x60, 0xD2, 0x27, 0x3E, 0x3C, 0xCE, 0x3B,
+        0xF6, 0xB0, 0x53, 0xCC, 0xB0, 0x06, 0x1D, 0x65,
+        0xBC, 0x86, 0x98, 0x76, 0x55, 0xBD, 0xEB, 0xB3,
+        0xE7, 0x93, 0x3A, 0xAA, 0xD8, 0x35, 0xC6, 0x5A,
+    },
     .n =
     {
         0x51, 0x25, 0x63, 0xFC, 0xC2, 0xCA, 0xB9, 0xF3,
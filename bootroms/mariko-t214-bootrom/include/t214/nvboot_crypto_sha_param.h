@@ -72,6 +72,12 @@ enum {NVBOOT_SHA256_LENGTH_BYTES = SHA_256 / 8};
  */
 enum {NVBOOT_SHA256_LENGTH_WORDS = NVBOOT_SHA256_LENGTH_BYTES / 4};
 
+/**
+ * Defines the length of a SHA256 message block in bytes
+ *
+ */
+enum {NVBOOT_SHA256_BLOCK_BYTES = 64};
+
 enum {NVBOOT_SHA2_MAX_BYTE_SIZE = SHA_512 / 8};
 
 typedef struct NvBootSha256HashDigestRec
@@ -75,9 +75,26 @@ NV_CT_ASSERT(sizeof(NvBootConfigTable) == NVBOOT_BCT_REQUIRED_SIZE);
  * Make sure MainBCT starts at SYSRAM location TBD.
  */
 NV_CT_ASSERT(sizeof(NvBootInfoTable) >  0x80);
-NV_CT_ASSERT(sizeof(NvBootInfoTable) <= 0x500);
+NV_CT_ASSERT(sizeof(NvBootInfoTable) <= 0x700);
 NV_CT_ASSERT(sizeof(NvBootInfoTable) == NVBOOT_BIT_REQUIRED_SIZE);
 
+/*
+ * The BIT, the BCT and the crypto buffers follow each other in the 16 KB
+ * .IRAM region of nvboot.ld (0x40000000 - 0x40003FFF), ahead of .data,
+ * .bss and the stack. nvboot.ld checks the final layout; this catches a
+ * BIT or BCT that leaves no room for the crypto manager buffers.
+ */
+NV_CT_ASSERT(sizeof(NvBootInfoTable) + sizeof(NvBootConfigTable) +
+             sizeof(NvBootCryptoMgrBuffers) <= 0x4000);
+
+/*
+ * NvBootMainSecureInit() clears the BIT up to TaskTimingDropped only, so the
+ * task timing fields must be the last ones.
+ */
+NV_CT_ASSERT(offsetof(NvBootInfoTable, TaskTiming) +
+             sizeof(((NvBootInfoTable *)0)->TaskTiming) ==
+             sizeof(NvBootInfoTable));
+
 /*
  * NcBootDevParams size is 64 bytes
  */
@@ -381,7 +398,6 @@ ReadOneBct(NvBootContext *Context, const NvU32 Block, const NvU32 Page)
     // Point to global variabl already initialized.
     NvBootConfigTable      *Bct = pBootConfigTable;
     NvBootDevMgr *DevMgr;
-    NvBootDeviceStatus      ReadStatus;
 
     NV_ASSERT(Context != NULL);
 
@@ -404,18 +420,12 @@ ReadOneBct(NvBootContext *Context, const NvU32 Block, const NvU32 Page)
     // Inititialize SecureProvisioningMode to disabled.
     Context->FactorySecureProvisioningMode = NV_FALSE;
 
-    /* Initiate the bct read. */
-    NV_BOOT_CHECK_ERROR(DevMgr->Callbacks->Read(Block,
-                                   Page,
-                                   sizeof(NvBootConfigTable),
-                                   (uint8_t*)Bct));
-
-    // Poll till Status changes from ReadInProgress.
-    while((ReadStatus = DevMgr->Callbacks->QueryStatus()) == \
-           NvBootDeviceStatus_ReadInProgress);
-
-    if(ReadStatus != NvBootDeviceStatus_Idle)
-        return NvBootError_DeviceReadError;
+    /* Read the bct. */
+    NV_BOOT_CHECK_ERROR(NvBootDevMgrRead(DevMgr,
+                                         Block,
+                                         Page,
+                                         sizeof(NvBootConfigTable),
+                                         (uint8_t*)Bct));
 
     // Load the Pcp if necessary.
     e = NvBootCryptoMgrSetOemPcp(&Bct->Pcp);
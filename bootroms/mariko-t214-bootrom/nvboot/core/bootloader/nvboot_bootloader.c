@@ -70,7 +70,6 @@ LoadOneBootLoader(
     // Default to "fail", subsequent functions can set to pass.
     volatile NvBootError e = NvBootInitializeNvBootError();
     NvBootDevMgr *DevMgr;
-    NvBootDeviceStatus      ReadStatus;
     NvBootOemBootBinaryHeader *OemBootBinaryHeader;
     uint32_t HeaderSize = sizeof(NvBootOemBootBinaryHeader);
 
@@ -82,18 +81,14 @@ LoadOneBootLoader(
     uint32_t PageSize= 1<<DevMgr->PageSizeLog2;
     uint32_t PagesPerBlock = 1<< (DevMgr->BlockSizeLog2-DevMgr->PageSizeLog2);
     
-    /// Read and Parse Oem header. Read a complete page. Bootloader is expected to follow OemBootBinaryHeader
-    NV_BOOT_CHECK_ERROR(DevMgr->Callbacks->Read(BlInfo->StartBlock,
-                                   BlInfo->StartPage,
-                                   HeaderSize,
-                                   &FirstPageBuffer[0]));
-
-    /// Poll till Status changes from ReadInProgress.
-    while((ReadStatus = DevMgr->Callbacks->QueryStatus()) == \
-           NvBootDeviceStatus_ReadInProgress);
-
-    if(ReadStatus != NvBootDeviceStatus_Idle)
-        return NvBootError_DeviceReadError;
+    /// Read and Parse Oem header. Read a complete page. Bootloader is expected to follow OemBootBinaryHeader.
+    /// The device manager reads ahead past the header, so the start of the bootloader is
+    /// served from its cache below.
+    NV_BOOT_CHECK_ERROR(NvBootDevMgrRead(DevMgr,
+                                         BlInfo->StartBlock,
+                                         BlInfo->StartPage,
+                                         ALIGN_ADDR(HeaderSize, PageSize),
+                                         &FirstPageBuffer[0]));
 
     // Cast Header pointer to buffer just read.
     OemBootBinaryHeader = (NvBootOemBootBinaryHeader*)&FirstPageBuffer[0];
@@ -155,22 +150,17 @@ LoadOneBootLoader(
         if ((e_IramBlCheck != NvBootError_Success) && (e_SdramBlCheck != NvBootError_Success))
             return NvBootError_Invalid_Bl_Load_Address;
         
-        /// Initiate the bootloader read.
-        NV_BOOT_CHECK_ERROR(DevMgr->Callbacks->Read(NextBlock,
-                                       NextPage,
-                                       BlLengthRemaining,
-                                       (uint8_t*)(OemMb1LoadAddress+BlFirstPageBytes)));
-
-        /// Poll till Status changes from ReadInProgress.
-        while((ReadStatus = DevMgr->Callbacks->QueryStatus()) == \
-               NvBootDeviceStatus_ReadInProgress);
-
-        if(ReadStatus != NvBootDeviceStatus_Idle)
-            return NvBootError_DeviceReadError;
+        /// Read the rest of the bootloader.
+        NV_BOOT_CHECK_ERROR(NvBootDevMgrRead(DevMgr,
+                                             NextBlock,
+                                             NextPage,
+                                             BlLengthRemaining,
+                                             (uint8_t*)(OemMb1LoadAddress+BlFirstPageBytes)));
     }
     
-    /// Authenticate Oem Mb1 Package
-    e  = NvBootCryptoMgrAuthBlPackage(OemBootBinaryHeader, (uint32_t*)OemMb1LoadAddress);
+    /// Authenticate and decrypt Oem Mb1 Package. An encrypted package is
+    /// hashed on SE1 while SE2 decrypts the chunks already hashed.
+    e  = NvBootCryptoMgrAuthDecryptBlPackage(OemBootBinaryHeader, (uint32_t*)OemMb1LoadAddress);
     if(e != NvBootError_Success)
     {
         /// Introduces code distance between error detection and response.
@@ -188,9 +178,7 @@ LoadOneBootLoader(
         return e;
     }
 
-    /// Decrypt Oem Mb1 Package
-    NV_BOOT_CHECK_ERROR(NvBootCryptoMgrDecryptBlPackage(OemBootBinaryHeader, (uint32_t*)OemMb1LoadAddress));
-
+    /// Oem Mb1 Package was decrypted along with its authentication.
     FI_counter1 += COUNTER1;
 
     /// Check BCT <--> OEM Boot Binary Header version binding.
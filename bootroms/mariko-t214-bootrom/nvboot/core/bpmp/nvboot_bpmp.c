@@ -616,7 +616,9 @@ NvBootMainSecureInit()
 {
     NvBootUtilMemset(&Context, 0, sizeof(NvBootContext));
     NvBootUtilMemset( (void*) &__bct_start, 0, sizeof(NvBootConfigTable) );
-    NvBootUtilMemset( (void*) &__bit_start, 0, sizeof(NvBootInfoTable) );
+    // Keep the task timings recorded by the non-secure dispatcher.
+    NvBootUtilMemset( (void*) &__bit_start, 0,
+                      offsetof(NvBootInfoTable, TaskTimingDropped) );
 
     // Init security related context.
     Context.FactorySecureProvisioningMode = 0;
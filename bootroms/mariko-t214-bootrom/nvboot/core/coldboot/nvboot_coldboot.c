@@ -21,6 +21,7 @@
 #include "nvboot_devmgr_int.h"
 #include "nvboot_fuse_int.h"
 #include "nvboot_hacks_int.h"
+#include "nvboot_oem_boot_binary_header.h"
 #include "nvboot_irom_patch_int.h"
 #include "nvboot_pmc_int.h"
 #include "nvboot_sdram_int.h"
@@ -40,8 +41,17 @@ extern NvBootContext     Context;
 /* Function Prototypes */
 static NvBootError SetupBootDevice(NvBootContext *Context);
 // static void        MapFusesToCryptoOps(NvBootContext *Context);
+static NvBootError StartSdramPll(NvBootContext *Context);
 static NvBootError SetupSdram(NvBootContext *Context);
 
+/*
+ * State handed from NvBootColdBootSdramBegin() to NvBootColdBootSdramComplete().
+ * s_SdramParams is NULL if there is no SDRAM to initialize.
+ */
+static NvBootSdramParams *s_SdramParams;
+static NvBool             s_PllmStarted;
+static NvU32              s_PllmStableTime;
+
 /**
  *  Attempt to disambiguate how a strap maps to a device.
  *  Strap (type NvBootStrapDevSel)
@@ -193,27 +203,29 @@ static NvBootError SetupBootDevice(NvBootContext *Context)
 }
 
 /**
- * SetupSdram(): Initialize the SDRAM.
+ * StartSdramPll(): Select the SDRAM parameter set and start PLLM if the EMC
+ * runs from it. Does not wait for PLLM to lock; SetupSdram() does.
  *
  * @param[in] Context Pointer to the boot context.
  *
- * @retval NvBootError_Success SDRAM is ready for use or there were no
+ * @retval NvBootError_Success PLLM is locking, not needed, or there were no
  * SDRAM sets provided.
  * @retval NvBootError_IllegalParameter Strap value for SDRAM parameter
  * selection >= the number of sets in the BCT.
- * @retval TODO Errors from NvBootSdramInitFromParams
- * @retval TODO Errors from NvBootSdramQueryInitStatus
  */
-static NvBootError SetupSdram(NvBootContext *Context)
+static NvBootError StartSdramPll(NvBootContext *Context)
 {
     NvU8 SdramIndex = 0;
-    NvU32 StableTime, Misc1, Misc2;
+    NvU32 Misc1, Misc2;
     NvBootSdramParams *Params = NULL;
     NvU32 RegData = 0;
     (void)Context;
 
     NV_ASSERT(Context != NULL);
 
+    s_SdramParams = NULL;
+    s_PllmStarted = NV_FALSE;
+
     /* Do nothing if there are no SDRAM sets in the BCT. */
     if (pBootConfigTable->NumSdramSets == 0)
         return NvBootError_Success;
@@ -253,22 +265,48 @@ static NvBootError SetupSdram(NvBootContext *Context)
         Misc2 = NV_DRF_NUM(MISC2, CLK_RST_CONTROLLER_PLLM_MISC2, PLLM_KVCO, Params->PllMKVCO) | \
                 NV_DRF_NUM(MISC2, CLK_RST_CONTROLLER_PLLM_MISC2, PLLM_KCP, Params->PllMKCP);
         
-        // Start PLLM for EMC/MC
-        // TODO: Move PLL init & wait for reduced latency.
+        // Start PLLM for EMC/MC. The lock wait is in SetupSdram() so that
+        // other tasks can run while PLLM locks.
         NvBootClocksStartPll(NvBootClocksPllId_PllM, 
                              Params->PllMInputDivider,           // M
                              Params->PllMFeedbackDivider,        // N
                              Params->PllMPostDivider,            // P
                              Misc1,
                              Misc2,
-                             &StableTime);
+                             &s_PllmStableTime);
 
-        // Poll for PLLM lock bit and timeout on polling loop
-        while (!NvBootClocksIsPllStable(NvBootClocksPllId_PllM, StableTime));
+        s_PllmStarted = NV_TRUE;
     }
 
+    s_SdramParams = Params;
+
+    return NvBootError_Success;
+}
+
+/**
+ * SetupSdram(): Initialize the SDRAM with the parameter set selected by
+ * StartSdramPll().
+ *
+ * @param[in] Context Pointer to the boot context.
+ *
+ * @retval NvBootError_Success SDRAM is ready for use or there were no
+ * SDRAM sets provided.
+ */
+static NvBootError SetupSdram(NvBootContext *Context)
+{
+    (void)Context;
+
+    NV_ASSERT(Context != NULL);
+
+    if (s_SdramParams == NULL)
+        return NvBootError_Success;
+
+    // Poll for PLLM lock bit and timeout on polling loop
+    if (s_PllmStarted)
+        while (!NvBootClocksIsPllStable(NvBootClocksPllId_PllM, s_PllmStableTime));
+
     /* Initialize the SDRAM. */
-    NvBootSdramInit(Params);
+    NvBootSdramInit(s_SdramParams);
     
     BootInfoTable.SdramInitialized = NV_TRUE;
 
@@ -348,11 +386,48 @@ NvBootError NvBootColdBootReadBct()
 }
 
 /**
- * Perform dram initialization.
+ * First half of dram initialization: start PLLM without waiting for lock.
+ * The bootloader header prefetch does not use DRAM (reader buffers and the
+ * read-ahead cache are in IRAM), so it runs between this and
+ * NvBootColdBootSdramComplete().
+ *
+ * @retval NvBootError_Success, PLLM started or not needed.
+ */
+NvBootError NvBootColdBootSdramBegin()
+{
+    NvBootError e = NvBootError_Success;
+
+    NV_BOOT_CHECK_ERROR_CLEANUP(StartSdramPll(&Context));
+
+ fail:
+#if NVBOOT_SPIN_WAIT_AT_END
+    NV_BOOT_SPIN_WAIT()
+#endif
+    return e;
+}
+
+/**
+ * Poll hook of NvBootColdBootSdramBegin() for the secure dispatcher.
+ *
+ * @retval NvBootError_Busy, PLLM is still locking.
+ * @retval NvBootError_Success, PLLM is locked or was not started.
+ */
+NvBootError NvBootColdBootSdramPoll()
+{
+    if (s_PllmStarted &&
+        !NvBootClocksIsPllStable(NvBootClocksPllId_PllM, s_PllmStableTime))
+        return NvBootError_Busy;
+
+    return NvBootError_Success;
+}
+
+/**
+ * Second half of dram initialization: wait for PLLM lock and initialize
+ * the SDRAM.
  *
  * @retval NvBootError_Success, dram initialized.
  */
-NvBootError NvBootColdBootSetupSdram()
+NvBootError NvBootColdBootSdramComplete()
 {
     NvBootError e = NvBootError_Success;
    /*
@@ -368,7 +443,6 @@ NvBootError NvBootColdBootSetupSdram()
     NV_BOOT_SPIN_WAIT()
 #endif
     return e;
-
 }
 
 /**
@@ -423,6 +497,30 @@ NvBootError NvBootColdBootReInit()
 
 }
 
+/**
+ * Read the OEM header of the first bootloader into the device manager's
+ * read-ahead cache, so that NvBootColdBootLoadBl() does not wait on the
+ * device for it. Runs while PLLM locks, before the reinit, with the device
+ * settings the BCT was read with; the reinit keeps the cached pages.
+ *
+ * @retval NvBootError_Success, always; a failed prefetch is retried by
+ * the bootloader load.
+ */
+NvBootError NvBootColdBootPrefetchBl()
+{
+    NvBootLoaderInfo *BlInfo;
+
+    if (pBootConfigTable->BootLoadersUsed == 0)
+        return NvBootError_Success;
+
+    BlInfo = &(pBootConfigTable->BootLoader[0]);
+
+    return NvBootDevMgrPrefetch(&(Context.DevMgr),
+                                BlInfo->StartBlock,
+                                BlInfo->StartPage,
+                                sizeof(NvBootOemBootBinaryHeader));
+}
+
 /**
  * Read and validate bootloader (MB1/BL).
  *
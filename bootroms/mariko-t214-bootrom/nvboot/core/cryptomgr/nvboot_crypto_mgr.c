@@ -1136,6 +1136,124 @@ NvBootError NvBootCryptoMgrDecryptBlPackage(const NvBootOemBootBinaryHeader *Oem
     return e;
 }
 
+NvBootError NvBootCryptoMgrAuthDecryptBlPackage(const NvBootOemBootBinaryHeader *OemHeader, uint32_t *BlBinary)
+{
+    // The pipeline needs the BEK in both SE instances. The FSKP key is only
+    // loaded into SE1, so FSKP and unencrypted packages take the sequential
+    // path.
+    if((s_CryptoMgrContext.EncryptionScheme != CryptoAlgo_AES) ||
+       (Context.FactorySecureProvisioningMode != false) ||
+       (OemHeader->Length == 0))
+    {
+        NvBootError e = NvBootCryptoMgrAuthBlPackage(OemHeader, BlBinary);
+        if(e != NvBootError_Success)
+            return e;
+        return NvBootCryptoMgrDecryptBlPackage(OemHeader, BlBinary);
+    }
+
+    if(s_CryptoMgrContext.IsOemBootBinaryHeaderAuthenticated != OEM_HEADER_AUTHENTICATED)
+    {
+        return NvBootError_CryptoMgr_OemBootBinaryHeader_NotAuthenticated;
+    }
+
+    // Sanintize the load address and length, even though the header
+    // is authenticated.
+    NvBootError e_SdramBlCheck = NvBootValidateAddress(DramRange, OemHeader->LoadAddress, OemHeader->Length);
+    NvBootError e_IramBlCheck = NvBootValidateAddress(BlRamRange, OemHeader->LoadAddress, OemHeader->Length);
+
+    // If all of the range checks above fail, then return error and don't copy.
+    if((e_SdramBlCheck != NvBootError_Success) && (e_IramBlCheck != NvBootError_Success))
+        return NvBootError_Invalid_Bl_Size_And_Or_Destination;
+
+    // The package is decrypted in place, so check the buffer as well.
+    e_SdramBlCheck = NvBootValidateAddress(DramRange, (uint32_t) BlBinary, OemHeader->Length);
+    e_IramBlCheck = NvBootValidateAddress(BlRamRange, (uint32_t) BlBinary, OemHeader->Length);
+
+    if((e_SdramBlCheck != NvBootError_Success) && (e_IramBlCheck != NvBootError_Success))
+        return NvBootError_Invalid_Bl_Size_And_Or_Destination;
+
+    uint8_t * const Package = (uint8_t *) BlBinary;
+    const uint32_t Length = OemHeader->Length;
+    const uint32_t NumChunks = NV_ICEIL(Length, NVBOOT_CRYPTO_BL_PIPELINE_CHUNK_BYTES);
+    uint32_t Chunk;
+    uint32_t Offset;
+    uint32_t ChunkBytes;
+
+    // Default to "fail", subsequent functions can set to pass.
+    NvBootError e = NvBootInitializeNvBootError();
+    if(e == NvBootError_Success)
+        do_exception();
+
+    // ShaDevMgr and AesDevMgr drive SE1 only, and their calls block until
+    // the engine is done. Overlapping the two instances needs per-instance,
+    // non-blocking starts, so the SE instance functions are used directly,
+    // as for the key loading in NvBootCryptoMgrLoadOemAesKeys().
+
+    // Clear IVs of the SE2 keyslot before decrypt.
+    NvBootSeInstanceKeySlotWriteKeyIV(NvBootSeInstance_Se2, AES_DEVICE_KEYSLOT_BEK,
+        SE_MODE_PKT_AESMODE_KEY128, SE_CRYPTO_KEYIV_PKT_WORD_QUAD_ORIGINAL_IVS, 0);
+    NvBootSeInstanceKeySlotWriteKeyIV(NvBootSeInstance_Se2, AES_DEVICE_KEYSLOT_BEK,
+        SE_MODE_PKT_AESMODE_KEY128, SE_CRYPTO_KEYIV_PKT_WORD_QUAD_UPDATED_IVS, 0);
+
+    // Step k hashes ciphertext chunk k on SE1 while SE2 decrypts chunk k-1
+    // in place. Chunk k-1 is already hashed by then, and the two engines
+    // never touch the same chunk at once.
+    for(Chunk = 0; Chunk <= NumChunks; Chunk++)
+    {
+        if(Chunk < NumChunks)
+        {
+            Offset = Chunk * NVBOOT_CRYPTO_BL_PIPELINE_CHUNK_BYTES;
+            ChunkBytes = NV_MIN(Length - Offset, NVBOOT_CRYPTO_BL_PIPELINE_CHUNK_BYTES);
+            NvBootSeInstanceSHA256HashChunkStart(NvBootSeInstance_Se1,
+                                                 (NvU32 *) &Package[Offset],
+                                                 ChunkBytes,
+                                                 Length,
+                                                 Length - Offset,
+                                                 (NvU32 *) &s_CryptoMgr_Buffers.Calculated_BlHash);
+        }
+
+        if(Chunk > 0)
+        {
+            Offset = (Chunk - 1) * NVBOOT_CRYPTO_BL_PIPELINE_CHUNK_BYTES;
+            ChunkBytes = NV_MIN(Length - Offset, NVBOOT_CRYPTO_BL_PIPELINE_CHUNK_BYTES);
+            NvBootSeInstanceAesDecryptStart(NvBootSeInstance_Se2,
+                                            AES_DEVICE_KEYSLOT_BEK,
+                                            NvBootSeKeySizeConv(s_CryptoMgrContext.AesKeySize),
+                                            Chunk == 1,
+                                            NV_ICEIL(ChunkBytes, NVBOOT_AES_BLOCK_LENGTH_BYTES),
+                                            &Package[Offset],
+                                            &Package[Offset]);
+            while(NvBootSeInstanceIsEngineBusy(NvBootSeInstance_Se2, &Package[Offset]))
+                ;
+        }
+
+        while(NvBootSeInstanceIsEngineBusy(NvBootSeInstance_Se1,
+                                           (NvU8 *) &s_CryptoMgr_Buffers.Calculated_BlHash))
+            ;
+    }
+
+    // Compare the calculated hash with the OemBinaryHash in the OemHeader.
+    FI_bool compare_result = FI_FALSE;
+    compare_result = NvBootUtilCompareConstTimeFI(&s_CryptoMgr_Buffers.Calculated_BlHash,
+                                                &s_CryptoMgr_Buffers.OemBootBinaryHash,
+                                                sizeof(NvBootSha256HashDigest));
+    if(compare_result == FI_TRUE)
+        e = NvBootError_Success;
+    else
+        e = NvBootError_CryptoMgr_BlBinaryPackage_Auth_Error;
+
+    // Double check the compare result as FI mitigation.
+    if((e != NvBootError_Success) || (compare_result != FI_TRUE))
+    {
+        // The package was decrypted before the hash was known. Don't leave
+        // unauthenticated plaintext behind.
+        NvBootUtilMemset(Package, 0, Length);
+        return NvBootError_CryptoMgr_BlBinaryPackage_Auth_Error;
+    }
+
+    return e;
+}
+
 NvBootError NvBootCryptoMgrOemAuthSc7Fw(const NvBootWb0RecoveryHeader *Sc7Header)
 {
     // Default to "fail", subsequent functions can set to pass.
@@ -1242,6 +1360,90 @@ NvBootError NvBootCryptoMgrOemDecryptSc7Fw(const NvBootWb0RecoveryHeader *Sc7Hea
     return e;
 }
 
+void NvBootCryptoMgrOemRcmHashStart(const NvBootRcmMsg *RcmMsg)
+{
+    // A receive that failed part way may have left a chunk running.
+    while(NvBootSeInstanceIsEngineBusy(NvBootSeInstance_Se1,
+                                       (NvU8 *) &s_CryptoMgr_Buffers.Calculated_RcmHash))
+        ;
+
+    // Never leave a digest of an earlier message behind.
+    NvBootUtilMemset(&s_CryptoMgr_Buffers.Calculated_RcmHash, 0, sizeof(NvBootSha256HashDigest));
+    s_CryptoMgrContext.RcmHashState = RCM_HASH_NONE;
+    s_CryptoMgrContext.RcmHashedBytes = 0;
+
+    if(s_CryptoMgrContext.AuthenticationScheme != CryptoAlgo_RSA_RSASSA_PSS)
+        return;
+
+    if(NvBootValidateAddress(RcmMsgRange, (uint32_t) RcmMsg, RcmMsg->LengthInsecure) != NvBootError_Success)
+        return;
+
+    s_CryptoMgrContext.RcmHashLength = RcmMsg->LengthInsecure - OFFSET_RCM_SIGNED_SECT(RcmMsg);
+    s_CryptoMgrContext.RcmHashState = RCM_HASH_STREAMING;
+}
+
+void NvBootCryptoMgrOemRcmHashUpdate(const NvBootRcmMsg *RcmMsg, uint32_t BytesReceived)
+{
+    uint8_t * const SignedSection = (uint8_t *) RcmMsg + OFFSET_RCM_SIGNED_SECT(RcmMsg);
+    uint32_t Ready;
+    uint32_t ChunkBytes;
+
+    if(s_CryptoMgrContext.RcmHashState != RCM_HASH_STREAMING)
+        return;
+
+    if(BytesReceived <= OFFSET_RCM_SIGNED_SECT(RcmMsg))
+        return;
+
+    // Don't stall the USB receive on the SE; the next round catches up.
+    if(NvBootSeInstanceIsEngineBusy(NvBootSeInstance_Se1,
+                                    (NvU8 *) &s_CryptoMgr_Buffers.Calculated_RcmHash))
+        return;
+
+    // Hold back the last byte so that Finish always has a last chunk.
+    Ready = NV_MIN(BytesReceived - OFFSET_RCM_SIGNED_SECT(RcmMsg),
+                   s_CryptoMgrContext.RcmHashLength - 1);
+    if(Ready <= s_CryptoMgrContext.RcmHashedBytes)
+        return;
+
+    ChunkBytes = (Ready - s_CryptoMgrContext.RcmHashedBytes) & ~(NVBOOT_SHA256_BLOCK_BYTES - 1);
+    if(ChunkBytes == 0)
+        return;
+
+    NvBootSeInstanceSHA256HashChunkStart(NvBootSeInstance_Se1,
+                                         (NvU32 *) &SignedSection[s_CryptoMgrContext.RcmHashedBytes],
+                                         ChunkBytes,
+                                         s_CryptoMgrContext.RcmHashLength,
+                                         s_CryptoMgrContext.RcmHashLength - s_CryptoMgrContext.RcmHashedBytes,
+                                         (NvU32 *) &s_CryptoMgr_Buffers.Calculated_RcmHash);
+    s_CryptoMgrContext.RcmHashedBytes += ChunkBytes;
+}
+
+void NvBootCryptoMgrOemRcmHashFinish(const NvBootRcmMsg *RcmMsg)
+{
+    uint8_t * const SignedSection = (uint8_t *) RcmMsg + OFFSET_RCM_SIGNED_SECT(RcmMsg);
+
+    if(s_CryptoMgrContext.RcmHashState != RCM_HASH_STREAMING)
+        return;
+
+    while(NvBootSeInstanceIsEngineBusy(NvBootSeInstance_Se1,
+                                       (NvU8 *) &s_CryptoMgr_Buffers.Calculated_RcmHash))
+        ;
+
+    NvBootSeInstanceSHA256HashChunkStart(NvBootSeInstance_Se1,
+                                         (NvU32 *) &SignedSection[s_CryptoMgrContext.RcmHashedBytes],
+                                         s_CryptoMgrContext.RcmHashLength - s_CryptoMgrContext.RcmHashedBytes,
+                                         s_CryptoMgrContext.RcmHashLength,
+                                         s_CryptoMgrContext.RcmHashLength - s_CryptoMgrContext.RcmHashedBytes,
+                                         (NvU32 *) &s_CryptoMgr_Buffers.Calculated_RcmHash);
+
+    while(NvBootSeInstanceIsEngineBusy(NvBootSeInstance_Se1,
+                                       (NvU8 *) &s_CryptoMgr_Buffers.Calculated_RcmHash))
+        ;
+
+    s_CryptoMgrContext.RcmHashedBytes = s_CryptoMgrContext.RcmHashLength;
+    s_CryptoMgrContext.RcmHashState = RCM_HASH_DONE;
+}
+
 NvBootError NvBootCryptoMgrOemAuthRcmPayload(const NvBootRcmMsg *RcmMsg)
 {
     // Default to "fail", subsequent functions can set to pass.
@@ -1267,6 +1469,15 @@ NvBootError NvBootCryptoMgrOemAuthRcmPayload(const NvBootRcmMsg *RcmMsg)
         s_CryptoMgr_Buffers.RsaPssContext.RsaKeySlot = CRYPTOMGR_RSA_PUBLIC_KEY_SLOT;
         s_CryptoMgr_Buffers.RsaPssContext.RsaKey = &s_CryptoMgr_Buffers.Pcp.RsaPublicParams.RsaPublicKey;
         s_CryptoMgr_Buffers.RsaPssContext.InputMessageIsHashed = false;
+        // Use the digest computed while the message was received, if any.
+        // It is good for this one verification only.
+        if((s_CryptoMgrContext.RcmHashState == RCM_HASH_DONE) &&
+           (s_CryptoMgrContext.RcmHashLength == AuthSize))
+        {
+            s_CryptoMgr_Buffers.RsaPssContext.InputMessageIsHashed = true;
+            s_CryptoMgr_Buffers.RsaPssContext.InputMessageShaHash = (uint32_t *) &s_CryptoMgr_Buffers.Calculated_RcmHash;
+        }
+        s_CryptoMgrContext.RcmHashState = RCM_HASH_NONE;
         s_CryptoMgr_Buffers.RsaPssContext.InputMessage = (uint32_t *) ((uint32_t) RcmMsg + OFFSET_RCM_SIGNED_SECT(RcmMsg));
         s_CryptoMgr_Buffers.RsaPssContext.InputMessageLengthBytes = AuthSize;
         s_CryptoMgr_Buffers.RsaPssContext.InputSignature = (NvBootCryptoRsaSsaPssSig *) &RcmMsg->Signatures.RsaSsaPssSig;
@@ -18,6 +18,7 @@
 #include "nvcommon.h"
 
 #include "nvboot_config.h"
+#include "nvboot_config_int.h"
 #include "nvboot_devmgr_int.h"
 #include "nvboot_error.h"
 #include "nvboot_context_int.h"
@@ -39,6 +40,9 @@
 #include "nvboot_usb3_int.h"
 #endif
 #include "nvboot_prod_uart_int.h"
+#if NVENABLE_HOST_FILE_SUPPORT
+#include "nvboot_host_file_int.h"
+#endif
 
 /*
  * nvboot_devmgr.c - Implementation of the device manager and support code.
@@ -48,12 +52,22 @@
  * Function prototypes
  */
 static NvBootError InitDevice(NvBootDevMgr *DevMgr, NvU32 ParamIndex);
+static NvBootError
+ReadDevice(NvBootDevMgr *DevMgr,
+           const NvU32   StartPage,
+           const NvU32   Len,
+           uint8_t      *Dest);
+
+extern NvBootInfoTable BootInfoTable;
 
 /*
  * Static Data
  */
 NvBootDevContext s_DeviceContext;
 
+/* Backing store of the read-ahead cache. */
+static NvU8 s_ReadAheadCache[NVBOOT_DEVMGR_CACHE_SIZE] __attribute__((aligned(4)));
+
 const NvBootDevMgrCallbacks s_DeviceCallbacks[] = 
 {   
     //device type is as per the definition in t35/bootrom/include/t35/nvboot_bct.h
@@ -145,9 +159,32 @@ const NvBootDevMgrCallbacks s_DeviceCallbacks[] =
         NvBootFoosShutdown,
         NvBootFoosGetReaderBuffersBase
     },
+#elif NVENABLE_HOST_FILE_SUPPORT
+    /* NvBootDevType_Foos has no drivers */
+    { 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+#endif
+
+#if NVENABLE_HOST_FILE_SUPPORT
+    {
+        /* Callbacks for the file-backed host device */
+        (NvBootDeviceGetParams)NvBootHostFileGetParams,
+        (NvBootDeviceValidateParams)NvBootHostFileValidateParams,
+        (NvBootDeviceGetBlockSizes)NvBootHostFileGetBlockSizes,
+        (NvBootDeviceInit)NvBootHostFileInit,
+        NvBootHostFileReadPage,
+        NvBootHostFileQueryStatus,
+        NvBootHostFileShutdown,
+        NvBootHostFileGetReaderBuffersBase,
+        NULL
+    },
 #endif
 };
 
+#if NVENABLE_HOST_FILE_SUPPORT
+NV_CT_ASSERT(sizeof(s_DeviceCallbacks) / sizeof(s_DeviceCallbacks[0]) ==
+             NvBootDevType_HostFile + 1);
+#endif
+
 
 /*
  * Function implementations
@@ -191,6 +228,202 @@ InitDevice(NvBootDevMgr *DevMgr, NvU32 ParamIndex)
                                      &DevMgr->BlockSizeLog2,
                                      &DevMgr->PageSizeLog2);
 
+    /* Nothing has been read from this device yet. */
+    DevMgr->Cache.StartPage = 0;
+    DevMgr->Cache.NumBytes  = 0;
+
+    return NvBootError_Success;
+}
+
+/**
+ * ReadDevice(): Read from the device and poll until the read completes.
+ *
+ * @param[in] DevMgr Pointer to the device manager structure
+ * @param[in] StartPage First page to read, counted from block 0, page 0.
+ * @param[in] Len Number of bytes to read
+ * @param[out] Dest Destination of the data
+ *
+ * @retval NvBootError_Success The data was read.
+ * @retval NvBootError_DeviceReadError The device reported a failed read.
+ * @retval TODO Error codes from Read() callback
+ */
+static NvBootError
+ReadDevice(NvBootDevMgr *DevMgr,
+           const NvU32   StartPage,
+           const NvU32   Len,
+           uint8_t      *Dest)
+{
+    NvBootError        e;
+    NvBootDeviceStatus ReadStatus;
+    NvU32              PagesPerBlockLog2;
+
+    PagesPerBlockLog2 = DevMgr->BlockSizeLog2 - DevMgr->PageSizeLog2;
+
+    NV_BOOT_CHECK_ERROR(DevMgr->Callbacks->Read(
+                            StartPage >> PagesPerBlockLog2,
+                            StartPage & ((1 << PagesPerBlockLog2) - 1),
+                            Len,
+                            Dest));
+
+    /* Poll till Status changes from ReadInProgress. */
+    while((ReadStatus = DevMgr->Callbacks->QueryStatus()) == \
+           NvBootDeviceStatus_ReadInProgress);
+
+    if(ReadStatus != NvBootDeviceStatus_Idle)
+        return NvBootError_DeviceReadError;
+
+    return NvBootError_Success;
+}
+
+/**
+ * NvBootDevMgrRead(): Read data from the device through the read-ahead
+ * cache and wait for the read to complete.
+ *
+ * @param[in] DevMgr Pointer to the device manager
+ * @param[in] Block Number of the block from which to read
+ * @param[in] Page Number of the page within the block from which to read
+ * @param[in] Len Number of bytes to read
+ * @param[out] Dest Destination of the data
+ *
+ * @retval NvBootError_Success The data was read.
+ * @retval NvBootError_DeviceReadError The device reported a failed read.
+ * @retval TODO Error codes from Read() callback
+ *
+ * Leading pages that are held by the cache are copied out of it. If the
+ * rest of the request, rounded up to whole pages, leaves room in the cache
+ * for at least one more page, the read is widened by up to
+ * NVBOOT_DEVMGR_READ_AHEAD_PAGES pages and goes through the cache. Larger
+ * requests are read straight into Dest. Because the widened read may run
+ * past the end of the media, a failure of it is retried without read-ahead.
+ */
+NvBootError
+NvBootDevMgrRead(NvBootDevMgr *DevMgr,
+                 const NvU32   Block,
+                 const NvU32   Page,
+                 const NvU32   Len,
+                 uint8_t      *Dest)
+{
+    NvBootError e;
+    NvU32       PageSize;
+    NvU32       StartPage;
+    NvU32       Remaining;
+    NvU32       Offset;
+    NvU32       Bytes;
+    NvU32       FillBytes;
+    NvBootDevMgrCache *Cache;
+
+    NV_ASSERT(DevMgr != NULL);
+    NV_ASSERT(Dest != NULL);
+
+    Cache     = &DevMgr->Cache;
+    PageSize  = 1 << DevMgr->PageSizeLog2;
+    StartPage = (Block << (DevMgr->BlockSizeLog2 - DevMgr->PageSizeLog2)) +
+                Page;
+    Remaining = Len;
+
+    BootInfoTable.ReadAheadStatus.NumReads++;
+
+    /* Serve the leading pages from the cache. */
+    if ((Cache->NumBytes != 0) &&
+        (StartPage >= Cache->StartPage) &&
+        (StartPage < Cache->StartPage + (Cache->NumBytes >> DevMgr->PageSizeLog2)))
+    {
+        Offset = (StartPage - Cache->StartPage) << DevMgr->PageSizeLog2;
+        Bytes  = NV_MIN(Remaining, Cache->NumBytes - Offset);
+
+        NvBootUtilMemcpy(Dest, &s_ReadAheadCache[Offset], Bytes);
+
+        BootInfoTable.ReadAheadStatus.NumHits++;
+        BootInfoTable.ReadAheadStatus.BytesSaved += Bytes;
+
+        /* Only whole pages are left in the cache past a partial copy. */
+        Dest      += Bytes;
+        Remaining -= Bytes;
+        StartPage += Bytes >> DevMgr->PageSizeLog2;
+    }
+
+    if (Remaining == 0)
+        return NvBootError_Success;
+
+    /* Reads that leave no room for read-ahead bypass the cache. */
+    FillBytes = ALIGN_ADDR(Remaining, PageSize);
+    if (FillBytes + PageSize > sizeof(s_ReadAheadCache))
+        return ReadDevice(DevMgr, StartPage, Remaining, Dest);
+
+    FillBytes = NV_MIN(FillBytes + (NVBOOT_DEVMGR_READ_AHEAD_PAGES * PageSize),
+                       sizeof(s_ReadAheadCache) & ~(PageSize - 1));
+
+    /* The cache is overwritten; drop it before the device touches it. */
+    Cache->NumBytes = 0;
+
+    e = ReadDevice(DevMgr, StartPage, FillBytes, &s_ReadAheadCache[0]);
+    if (e != NvBootError_Success)
+        return ReadDevice(DevMgr, StartPage, Remaining, Dest);
+
+    Cache->StartPage = StartPage;
+    Cache->NumBytes  = FillBytes;
+
+    NvBootUtilMemcpy(Dest, &s_ReadAheadCache[0], Remaining);
+
+    return NvBootError_Success;
+}
+
+/**
+ * NvBootDevMgrPrefetch(): Fill the read-ahead cache ahead of a read.
+ *
+ * @param[in] DevMgr Pointer to the device manager
+ * @param[in] Block Number of the block from which to read
+ * @param[in] Page Number of the page within the block from which to read
+ * @param[in] Len Number of bytes the later read will request
+ *
+ * @retval NvBootError_Success The cache holds the pages, or the prefetch
+ * was skipped because they do not fit or could not be read.
+ *
+ * This lets a task issue the device read of e.g. the bootloader header
+ * while an unrelated wait (PLLM lock) is pending, instead of in the
+ * critical path of the bootloader load.
+ */
+NvBootError
+NvBootDevMgrPrefetch(NvBootDevMgr *DevMgr,
+                     const NvU32   Block,
+                     const NvU32   Page,
+                     const NvU32   Len)
+{
+    NvBootError e;
+    NvU32       PageSize;
+    NvU32       StartPage;
+    NvU32       FillBytes;
+    NvBootDevMgrCache *Cache;
+
+    NV_ASSERT(DevMgr != NULL);
+
+    Cache     = &DevMgr->Cache;
+    PageSize  = 1 << DevMgr->PageSizeLog2;
+    StartPage = (Block << (DevMgr->BlockSizeLog2 - DevMgr->PageSizeLog2)) +
+                Page;
+
+    /* Nothing to do if the cache already starts with these pages. */
+    if ((Cache->NumBytes != 0) && (Cache->StartPage == StartPage) &&
+        (Cache->NumBytes >= Len))
+        return NvBootError_Success;
+
+    /* Same sizing as NvBootDevMgrRead(), so the later read hits. */
+    FillBytes = ALIGN_ADDR(Len, PageSize);
+    if (FillBytes + PageSize > sizeof(s_ReadAheadCache))
+        return NvBootError_Success;
+
+    FillBytes = NV_MIN(FillBytes + (NVBOOT_DEVMGR_READ_AHEAD_PAGES * PageSize),
+                       sizeof(s_ReadAheadCache) & ~(PageSize - 1));
+
+    Cache->NumBytes = 0;
+
+    e = ReadDevice(DevMgr, StartPage, FillBytes, &s_ReadAheadCache[0]);
+    if (e != NvBootError_Success)
+        return NvBootError_Success;
+
+    Cache->StartPage = StartPage;
+    Cache->NumBytes  = FillBytes;
+
     return NvBootError_Success;
 }
 
@@ -208,6 +441,9 @@ InitDevice(NvBootDevMgr *DevMgr, NvU32 ParamIndex)
  * @retval NvBootError_InvalidDevParams The device's ValidataParams callback
  * returned false.
  * @retval TODO Error codes from Init() callback
+ *
+ * The new parameters change how the device is driven, not what it holds, so
+ * the read-ahead cache is kept unless they report a different geometry.
  */
 NvBootError
 NvBootDevMgrReinitDevice(NvBootDevMgr    *DevMgr,
@@ -218,6 +454,8 @@ NvBootDevMgrReinitDevice(NvBootDevMgr    *DevMgr,
     NvBool                 ValidParams;
     NvBootError            e = NvBootError_Success;
     NvBootDevParams       *Params;
+    NvU32                  BlockSizeLog2;
+    NvU32                  PageSizeLog2;
 
     NV_ASSERT(DevMgr != NULL);
     NV_ASSERT(BctParams != NULL);
@@ -238,6 +476,15 @@ NvBootDevMgrReinitDevice(NvBootDevMgr    *DevMgr,
     /* Initialize the device */
     NV_BOOT_CHECK_ERROR(DevMgr->Callbacks->Init(Params, &s_DeviceContext));
 
+    /* Pages read ahead under another geometry are at other addresses. */
+    DevMgr->Callbacks->GetBlockSizes(Params, &BlockSizeLog2, &PageSizeLog2);
+    if ((BlockSizeLog2 != DevMgr->BlockSizeLog2) ||
+        (PageSizeLog2 != DevMgr->PageSizeLog2))
+    {
+        DevMgr->Cache.StartPage = 0;
+        DevMgr->Cache.NumBytes  = 0;
+    }
+
     return NvBootError_Success;
 }
 
@@ -309,4 +556,5 @@ NvBootDevMgrShutdown(NvBootDevMgr *DevMgr)
 
     /* Shutdown the device manager. */
     DevMgr->Callbacks   = NULL;
+    DevMgr->Cache.NumBytes = 0;
 }
@@ -21,6 +21,7 @@
 
 
 void FT_NONSECURE UpdateBootFlowTracker(NvU32 Init, NvU32 Exit, NvU32 Id, NvU32 Status);
+void FT_NONSECURE UpdateTaskTiming(NvU32 Id, NvU32 Us);
 
 
 extern NvBootInfoTable  BootInfoTable;
@@ -36,7 +37,14 @@ int FT_NONSECURE NvBootNonsecureDispatcher()
 
     BootInfoTable.BootROMtracker = NvBootFlowStatus_NonSecureDispatcherEntry;
 
-    //setup BootInfoTable log
+    // setup BootInfoTable log. The task timing table is the only part of
+    // the BIT kept by NvBootMainSecureInit(), so start it from scratch here.
+    BootInfoTable.TaskTimingDropped = 0;
+    for (i=0; i<NVBOOT_TASK_TIMING_DEPTH; i++)
+    {
+        BootInfoTable.TaskTiming[i].CheckPoint = 0;
+        BootInfoTable.TaskTiming[i].Count = 0;
+    }
 
     for (i=0; i<cnt; i++)
     {
@@ -45,6 +53,8 @@ int FT_NONSECURE NvBootNonsecureDispatcher()
         funcStartTick = NvBootUtilGetTimeUS();
         (*func)();
         stat.nTicks = NvBootUtilGetTimeUS() - funcStartTick;
+
+        UpdateTaskTiming(stat.curCheckPoint, stat.nTicks);
     }
 
     BootInfoTable.BootROMtracker = NvBootFlowStatus_NonSecureDispatcherExit;
@@ -52,6 +62,33 @@ int FT_NONSECURE NvBootNonsecureDispatcher()
     return 0;
 }
 
+/**
+ * IsTaskReady(): Check whether the dependencies of task Index are complete.
+ *
+ * @param[in] Task Task entry
+ * @param[in] Index Index of the task in its list
+ * @param[in] DoneMask Tasks of the list that have completed
+ */
+static NvBool IsTaskReady(const NvBootTask *Task, int Index, NvU32 DoneMask)
+{
+    NvU32 Deps;
+
+    if (Task->depMask == 0)
+        Deps = (1U << Index) - 1;
+    else
+        Deps = Task->depMask & ~TASK_DEPS_VALID;
+
+    return ((DoneMask & Deps) == Deps) ? NV_TRUE : NV_FALSE;
+}
+
+/**
+ * NvBootSecureDispatcher(): Run a task list.
+ *
+ * Tasks are started in list order as their dependencies complete. While a
+ * task waits in its poll hook, later tasks that do not depend on it are
+ * started, so independent hardware waits overlap. Lists without explicit
+ * dependencies run strictly in order, exactly as before.
+ */
 NvBootError NvBootSecureDispatcher(NvBootTaskListId TaskListId)
 {
     int i = 0;
@@ -59,6 +96,11 @@ NvBootError NvBootSecureDispatcher(NvBootTaskListId TaskListId)
     volatile NvBootError Error = NvBootError_NotInitialized;
     volatile NvBootDispatchStat stat;
     int cnt;
+    int nDone = 0;
+    NvU32 StartedMask = 0;
+    volatile NvU32 DoneMask = 0;
+    NvU32 PollStartUs[TASK_MAX_PER_LIST];
+    NvBool Progress;
     NvBootError (*func)(void);
     unsigned long funcStartTick;
     
@@ -69,41 +111,107 @@ NvBootError NvBootSecureDispatcher(NvBootTaskListId TaskListId)
         
     TaskPtr = GetPtrTasks(TaskListId);
     cnt = GetCntTasks(TaskListId);
+    if(cnt > TASK_MAX_PER_LIST)
+        return NvBootError_IllegalParameter;
     
-    for (i=0; i<cnt; i++)
+    while (nDone < cnt)
     {
-        func = TaskPtr[i].funcPtr;
-        stat.curCheckPoint = TaskPtr[i].checkPoint;
-        funcStartTick = NvBootUtilGetTimeUS();
-        // Introduce a random delay by looping n cycles, n in range 0-1023
-        NvBootRngWaitRandomLoop(INSTRUCTION_DELAY_ENTROPY_BITS);
+        Progress = NV_FALSE;
 
-        Error = (*func)();
-        // Handle fault detection right away.
-        if(Error == NvBootError_Fault_Injection_Detection)
+        // Start the first task whose dependencies are complete.
+        for (i=0; i<cnt; i++)
         {
-            do_exception();
-            do_exception();
-            do_exception();
+            if((StartedMask & (1U << i)) || !IsTaskReady(&TaskPtr[i], i, DoneMask))
+                continue;
+
+            func = TaskPtr[i].funcPtr;
+            stat.curCheckPoint = TaskPtr[i].checkPoint;
+            funcStartTick = NvBootUtilGetTimeUS();
+            // Introduce a random delay by looping n cycles, n in range 0-1023
+            NvBootRngWaitRandomLoop(INSTRUCTION_DELAY_ENTROPY_BITS);
+
+            Error = (*func)();
+            // Handle fault detection right away.
+            if(Error == NvBootError_Fault_Injection_Detection)
+            {
+                do_exception();
+                do_exception();
+                do_exception();
+            }
+            
+            stat.nTicks = NvBootUtilGetTimeUS() - funcStartTick;
+            
+            UpdateBootFlowTracker(funcStartTick, stat.nTicks, stat.curCheckPoint, (NvU32)(Error));
+            UpdateTaskTiming(stat.curCheckPoint, stat.nTicks);
+
+            if(Error != NvBootError_Success)
+                return Error;
+
+            NvBootRngWaitRandomLoop(INSTRUCTION_DELAY_ENTROPY_BITS);
+
+            // Double check the error returned as FI mitigation.
+            if(Error != NvBootError_Success)
+                return Error;
+
+            StartedMask |= (1U << i);
+            if(TaskPtr[i].pollPtr == NULL)
+            {
+                DoneMask |= (1U << i);
+                nDone++;
+            }
+            else
+            {
+                PollStartUs[i] = NvBootUtilGetTimeUS();
+            }
+            Progress = NV_TRUE;
+            break;
         }
-        
-        stat.nTicks = NvBootUtilGetTimeUS() - funcStartTick;
-        
-        UpdateBootFlowTracker(funcStartTick, stat.nTicks, stat.curCheckPoint, (NvU32)(Error));
 
-        if(Error != NvBootError_Success)
-            return Error;
+        // Give every task waiting on hardware a chance to complete.
+        for (i=0; i<cnt; i++)
+        {
+            if(!(StartedMask & (1U << i)) || (DoneMask & (1U << i)))
+                continue;
+
+            Error = TaskPtr[i].pollPtr();
+            if(Error == NvBootError_Busy)
+                continue;
+
+            if(Error == NvBootError_Fault_Injection_Detection)
+            {
+                do_exception();
+                do_exception();
+                do_exception();
+            }
 
-        NvBootRngWaitRandomLoop(INSTRUCTION_DELAY_ENTROPY_BITS);
+            if(Error != NvBootError_Success)
+            {
+                UpdateBootFlowTracker(NvBootUtilGetTimeUS(), 0, TaskPtr[i].checkPoint, (NvU32)(Error));
+                return Error;
+            }
 
-        // Double check the error returned as FI mitigation.
-        if(Error != NvBootError_Success)
-            return Error;
+            // Double check the error returned as FI mitigation.
+            if(Error != NvBootError_Success)
+                return Error;
+
+            // The wait is not part of the task's own run time.
+            UpdateTaskTiming(TaskPtr[i].checkPoint | NVBOOT_TASK_TIMING_POLL_WAIT,
+                             NvBootUtilGetTimeUS() - PollStartUs[i]);
+
+            DoneMask |= (1U << i);
+            nDone++;
+            Progress = NV_TRUE;
+        }
+
+        // Nothing can start and nothing is waiting: the dependencies of the
+        // list can never be met.
+        if(!Progress && (StartedMask == DoneMask))
+            return NvBootError_IllegalParameter;
     }
     
     // Double check that the dispatcher executed all tasks in the table.
     int cnt_verify = GetCntTasks(TaskListId);
-    if(i != cnt_verify)
+    if((nDone != cnt_verify) || (DoneMask != ((1U << cnt_verify) - 1)))
     {
         do_exception();
         do_exception();
@@ -127,3 +235,43 @@ void FT_NONSECURE UpdateBootFlowTracker(NvU32 Init, NvU32 Exit, NvU32 Id, NvU32
     NvBootFlowCnt++;
 }
 
+/**
+ * UpdateTaskTiming(): Account Us microseconds of run time to checkpoint Id
+ * in the BIT task timing table.
+ */
+void FT_NONSECURE UpdateTaskTiming(NvU32 Id, NvU32 Us)
+{
+    NvBootTaskTiming *Timing;
+    NvU32 i;
+
+    for (i = 0; i < NVBOOT_TASK_TIMING_DEPTH; i++)
+    {
+        Timing = &BootInfoTable.TaskTiming[i];
+
+        if (Timing->Count == 0)
+        {
+            // First run of this checkpoint: claim the free entry.
+            Timing->CheckPoint = (NvU16)Id;
+            Timing->MinUs = Us;
+            Timing->MaxUs = Us;
+            break;
+        }
+
+        if (Timing->CheckPoint == (NvU16)Id)
+            break;
+    }
+
+    if (i == NVBOOT_TASK_TIMING_DEPTH)
+    {
+        BootInfoTable.TaskTimingDropped++;
+        return;
+    }
+
+    if (Timing->Count != 0xFFFF)
+        Timing->Count++;
+    if (Us < Timing->MinUs)
+        Timing->MinUs = Us;
+    if (Us > Timing->MaxUs)
+        Timing->MaxUs = Us;
+    Timing->LastUs = Us;
+}
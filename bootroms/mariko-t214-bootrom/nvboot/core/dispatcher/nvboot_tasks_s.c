@@ -70,7 +70,12 @@ static const NvBootTask ColdBootTasks[] = {
     { &NvBootSeEnableAtomicSeContextSave, 0x101},
     { &NvBootColdBootInit, 		0x102 },
     { &NvBootColdBootReadBct, 	0x103 },
-    { &NvBootColdBootSetupSdram, 0x104 },
+    // The bootloader header is read while PLLM locks; it does not use DRAM.
+    // The boot device reinit stays after SDRAM init.
+    // 0x104 was the undivided SDRAM setup; its halves have their own IDs.
+    { &NvBootColdBootSdramBegin, 0x108, 0, &NvBootColdBootSdramPoll },
+    { &NvBootColdBootPrefetchBl, 0x109, TASK_DEPS(TASK_DEP(2)) },
+    { &NvBootColdBootSdramComplete, 0x10a, TASK_DEPS(TASK_DEP(3)) },
     { &NvBootColdBootReInit,	0x105 },
     { &NvBootColdBootLoadBl, 	0x106 },
     // NV FEK in the SE key slot is wiped out by default SE keys generation.
@@ -104,6 +109,9 @@ static const NvBootTask WarmBootTasks[] = {
 };
 
 
+NV_CT_ASSERT(sizeof(NvBootTask) == TASK_ENTRY);
+NV_CT_ASSERT(sizeof(ColdBootTasks)/TASK_ENTRY <= TASK_MAX_PER_LIST);
+
 // Supported array of task lists in Bootrom.
 static const NvBootTaskLists TaskLists[] =  { {CryptoInitTasks, (sizeof(CryptoInitTasks)/TASK_ENTRY)},
                                               {ColdBootTasks, (sizeof(ColdBootTasks)/TASK_ENTRY)},
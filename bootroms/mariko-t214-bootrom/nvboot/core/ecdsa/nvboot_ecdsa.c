@@ -0,0 +1,537 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+#include <stddef.h>
+#include "nvboot_crypto_pkc_ecdsa_int.h"
+#include "nvboot_crypto_ecc_param.h"
+#include "nvboot_sha_devmgr_int.h"
+#include "nvboot_util_int.h"
+#include "nvboot_rng_int.h"
+#include "nvboot_bpmp_int.h"
+
+/**
+ * Software ECDSA P-256 verification.
+ *
+ * Integers are eight 32-bit little-endian limbs. Field elements mod p and
+ * scalars mod n are kept in Montgomery form (R = 2^256) and multiplied
+ * with the same CIOS routine; -p^-1 mod 2^32 is 1 for P-256.
+ *
+ * Points use Jacobian coordinates (x = X/Z^2, y = Y/Z^3) with the a = -3
+ * doubling formula. u1*G + u2*Q is computed with Shamir's trick over the
+ * table {G, Q, G+Q}: one doubling per bit and one addition per non-zero
+ * bit pair. The x coordinate is never converted to affine form; instead
+ * X is compared with r*Z^2 (and (r+n)*Z^2), which avoids an inversion
+ * mod p.
+ *
+ * Only built when NVENABLE_SW_ECDSA_SUPPORT=1 and the ecdsa core library is
+ * enabled; nothing in the boot flow calls it yet.
+ */
+
+#define ECC_P256_WORDS 8
+
+typedef struct EcdsaJacobianPointRec
+{
+    NvU32 X[ECC_P256_WORDS];
+    NvU32 Y[ECC_P256_WORDS];
+    NvU32 Z[ECC_P256_WORDS]; // Z == 0 is the point at infinity.
+} EcdsaJacobianPoint;
+
+typedef struct EcdsaModulusRec
+{
+    NvU32 M[ECC_P256_WORDS];
+    NvU32 R2[ECC_P256_WORDS];   // R^2 mod M
+    NvU32 N0Inv;                // -M^-1 mod 2^32
+} EcdsaModulus;
+
+static const EcdsaModulus s_P256p =
+{
+    {
+        0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000,
+        0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF,
+    },
+    {
+        0x00000003, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFB,
+        0xFFFFFFFE, 0xFFFFFFFF, 0xFFFFFFFD, 0x00000004,
+    },
+    0x00000001,
+};
+
+static const EcdsaModulus s_P256n =
+{
+    {
+        0xFC632551, 0xF3B9CAC2, 0xA7179E84, 0xBCE6FAAD,
+        0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF,
+    },
+    {
+        0xBE79EEA2, 0x83244C95, 0x49BD6FA6, 0x4699799C,
+        0x2B6BEC59, 0x2845B239, 0xF3D95620, 0x66E12D94,
+    },
+    0xEE00BC4F,
+};
+
+static void LoadLe(NvU32 *Words, const uint8_t *Bytes)
+{
+    NvU32 i;
+
+    for (i = 0; i < ECC_P256_WORDS; i++)
+    {
+        Words[i] = (NvU32)Bytes[4 * i] |
+                   ((NvU32)Bytes[4 * i + 1] << 8) |
+                   ((NvU32)Bytes[4 * i + 2] << 16) |
+                   ((NvU32)Bytes[4 * i + 3] << 24);
+    }
+}
+
+/* The digest is a big-endian octet string (FIPS 180-4). */
+static void LoadDigest(NvU32 *Words, const uint8_t *Bytes)
+{
+    NvU32 i;
+    const uint8_t *p;
+
+    for (i = 0; i < ECC_P256_WORDS; i++)
+    {
+        p = &Bytes[4 * (ECC_P256_WORDS - 1 - i)];
+        Words[i] = ((NvU32)p[0] << 24) | ((NvU32)p[1] << 16) |
+                   ((NvU32)p[2] << 8)  |  (NvU32)p[3];
+    }
+}
+
+static bool IsZero(const NvU32 *A)
+{
+    NvU32 Acc = 0;
+    NvU32 i;
+
+    for (i = 0; i < ECC_P256_WORDS; i++)
+        Acc |= A[i];
+    return Acc == 0;
+}
+
+/* A >= B */
+static bool IsGe(const NvU32 *A, const NvU32 *B)
+{
+    NvU32 i;
+
+    for (i = ECC_P256_WORDS; i > 0; i--)
+    {
+        if (A[i - 1] != B[i - 1])
+            return A[i - 1] > B[i - 1];
+    }
+    return true;
+}
+
+/* R = A + B, returning the carry. R may alias A or B. */
+static NvU32 Add(NvU32 *R, const NvU32 *A, const NvU32 *B)
+{
+    NvU64 Sum;
+    NvU32 Carry = 0;
+    NvU32 i;
+
+    for (i = 0; i < ECC_P256_WORDS; i++)
+    {
+        Sum = (NvU64)A[i] + B[i] + Carry;
+        R[i] = (NvU32)Sum;
+        Carry = (NvU32)(Sum >> 32);
+    }
+    return Carry;
+}
+
+/* R = A - B, returning the borrow. R may alias A or B. */
+static NvU32 Sub(NvU32 *R, const NvU32 *A, const NvU32 *B)
+{
+    NvU64 Diff;
+    NvU32 Borrow = 0;
+    NvU32 i;
+
+    for (i = 0; i < ECC_P256_WORDS; i++)
+    {
+        Diff = (NvU64)A[i] - B[i] - Borrow;
+        R[i] = (NvU32)Diff;
+        Borrow = (NvU32)(Diff >> 32) & 1;
+    }
+    return Borrow;
+}
+
+static void ModAdd(NvU32 *R, const NvU32 *A, const NvU32 *B, const EcdsaModulus *Mod)
+{
+    if ((Add(R, A, B) != 0) || IsGe(R, Mod->M))
+        Sub(R, R, Mod->M);
+}
+
+static void ModSub(NvU32 *R, const NvU32 *A, const NvU32 *B, const EcdsaModulus *Mod)
+{
+    if (Sub(R, A, B) != 0)
+        Add(R, R, Mod->M);
+}
+
+/* R = A * B * 2^-256 mod M (CIOS). R may alias A or B. A, B < M. */
+static void MontMul(NvU32 *R, const NvU32 *A, const NvU32 *B, const EcdsaModulus *Mod)
+{
+    NvU32 t[ECC_P256_WORDS + 2];
+    NvU64 Sum;
+    NvU32 Carry;
+    NvU32 m;
+    NvU32 i;
+    NvU32 j;
+
+    for (j = 0; j < ECC_P256_WORDS + 2; j++)
+        t[j] = 0;
+
+    for (i = 0; i < ECC_P256_WORDS; i++)
+    {
+        Carry = 0;
+        for (j = 0; j < ECC_P256_WORDS; j++)
+        {
+            Sum = (NvU64)A[j] * B[i] + t[j] + Carry;
+            t[j] = (NvU32)Sum;
+            Carry = (NvU32)(Sum >> 32);
+        }
+        Sum = (NvU64)t[ECC_P256_WORDS] + Carry;
+        t[ECC_P256_WORDS] = (NvU32)Sum;
+        t[ECC_P256_WORDS + 1] = (NvU32)(Sum >> 32);
+
+        m = t[0] * Mod->N0Inv;
+        Sum = (NvU64)m * Mod->M[0] + t[0];
+        Carry = (NvU32)(Sum >> 32);
+        for (j = 1; j < ECC_P256_WORDS; j++)
+        {
+            Sum = (NvU64)m * Mod->M[j] + t[j] + Carry;
+            t[j - 1] = (NvU32)Sum;
+            Carry = (NvU32)(Sum >> 32);
+        }
+        Sum = (NvU64)t[ECC_P256_WORDS] + Carry;
+        t[ECC_P256_WORDS - 1] = (NvU32)Sum;
+        t[ECC_P256_WORDS] = t[ECC_P256_WORDS + 1] + (NvU32)(Sum >> 32);
+    }
+
+    if ((t[ECC_P256_WORDS] != 0) || IsGe(t, Mod->M))
+        Sub(t, t, Mod->M);
+
+    for (j = 0; j < ECC_P256_WORDS; j++)
+        R[j] = t[j];
+}
+
+static void ToMont(NvU32 *R, const NvU32 *A, const EcdsaModulus *Mod)
+{
+    MontMul(R, A, Mod->R2, Mod);
+}
+
+/* R = 2^256 mod M, i.e. 1 in Montgomery form. M > 2^255. */
+static void MontOne(NvU32 *R, const EcdsaModulus *Mod)
+{
+    NvU32 Zero[ECC_P256_WORDS] = { 0 };
+
+    Sub(R, Zero, Mod->M);
+}
+
+/*
+ * R = A^-1 in Montgomery form, by Fermat: A^(M-2). A is in Montgomery
+ * form and non-zero.
+ */
+static void MontInv(NvU32 *R, const NvU32 *A, const EcdsaModulus *Mod)
+{
+    NvU32 Exp[ECC_P256_WORDS];
+    NvU32 Two[ECC_P256_WORDS] = { 2 };
+    NvU32 Acc[ECC_P256_WORDS];
+    NvU32 Bit;
+
+    Sub(Exp, Mod->M, Two);
+    MontOne(Acc, Mod);
+
+    for (Bit = 32 * ECC_P256_WORDS; Bit > 0; Bit--)
+    {
+        MontMul(Acc, Acc, Acc, Mod);
+        if ((Exp[(Bit - 1) / 32] >> ((Bit - 1) % 32)) & 1)
+            MontMul(Acc, Acc, A, Mod);
+    }
+
+    NvBootUtilMemcpy(R, Acc, sizeof(Acc));
+}
+
+#define FpMul(R, A, B) MontMul(R, A, B, &s_P256p)
+#define FpAdd(R, A, B) ModAdd(R, A, B, &s_P256p)
+#define FpSub(R, A, B) ModSub(R, A, B, &s_P256p)
+
+/* R = 2P, dbl-2001-b for a = -3. R may alias P. */
+static void PointDouble(EcdsaJacobianPoint *R, const EcdsaJacobianPoint *P)
+{
+    NvU32 Delta[ECC_P256_WORDS];
+    NvU32 Gamma[ECC_P256_WORDS];
+    NvU32 Beta[ECC_P256_WORDS];
+    NvU32 Alpha[ECC_P256_WORDS];
+    NvU32 t[ECC_P256_WORDS];
+    NvU32 u[ECC_P256_WORDS];
+
+    if (IsZero(P->Z))
+    {
+        *R = *P;
+        return;
+    }
+
+    FpMul(Delta, P->Z, P->Z);
+    FpMul(Gamma, P->Y, P->Y);
+    FpMul(Beta, P->X, Gamma);
+
+    // Alpha = 3 * (X - Delta) * (X + Delta)
+    FpSub(t, P->X, Delta);
+    FpAdd(u, P->X, Delta);
+    FpMul(t, t, u);
+    FpAdd(Alpha, t, t);
+    FpAdd(Alpha, Alpha, t);
+
+    // Z3 = (Y + Z)^2 - Gamma - Delta
+    FpAdd(t, P->Y, P->Z);
+    FpMul(t, t, t);
+    FpSub(t, t, Gamma);
+    FpSub(R->Z, t, Delta);
+
+    // X3 = Alpha^2 - 8 * Beta
+    FpAdd(Beta, Beta, Beta);
+    FpAdd(Beta, Beta, Beta);          // 4 * Beta
+    FpMul(t, Alpha, Alpha);
+    FpSub(t, t, Beta);
+    FpSub(R->X, t, Beta);
+
+    // Y3 = Alpha * (4 * Beta - X3) - 8 * Gamma^2
+    FpSub(t, Beta, R->X);
+    FpMul(t, Alpha, t);
+    FpMul(u, Gamma, Gamma);
+    FpAdd(u, u, u);
+    FpAdd(u, u, u);
+    FpAdd(u, u, u);
+    FpSub(R->Y, t, u);
+}
+
+/* R = P + Q, add-2007-bl. R may alias P or Q. */
+static void PointAdd(EcdsaJacobianPoint *R,
+                     const EcdsaJacobianPoint *P,
+                     const EcdsaJacobianPoint *Q)
+{
+    NvU32 Z1Z1[ECC_P256_WORDS];
+    NvU32 Z2Z2[ECC_P256_WORDS];
+    NvU32 U1[ECC_P256_WORDS];
+    NvU32 S1[ECC_P256_WORDS];
+    NvU32 H[ECC_P256_WORDS];
+    NvU32 Rr[ECC_P256_WORDS];
+    NvU32 I[ECC_P256_WORDS];
+    NvU32 J[ECC_P256_WORDS];
+    NvU32 t[ECC_P256_WORDS];
+
+    if (IsZero(P->Z))
+    {
+        *R = *Q;
+        return;
+    }
+    if (IsZero(Q->Z))
+    {
+        *R = *P;
+        return;
+    }
+
+    FpMul(Z1Z1, P->Z, P->Z);
+    FpMul(Z2Z2, Q->Z, Q->Z);
+    FpMul(U1, P->X, Z2Z2);
+    FpMul(H, Q->X, Z1Z1);
+    FpSub(H, H, U1);                    // H = U2 - U1
+
+    FpMul(S1, P->Y, Q->Z);
+    FpMul(S1, S1, Z2Z2);
+    FpMul(Rr, Q->Y, P->Z);
+    FpMul(Rr, Rr, Z1Z1);
+    FpSub(Rr, Rr, S1);
+    FpAdd(Rr, Rr, Rr);                  // r = 2 * (S2 - S1)
+
+    if (IsZero(H))
+    {
+        if (IsZero(Rr))
+        {
+            PointDouble(R, P);
+        }
+        else
+        {
+            // P = -Q
+            NvBootUtilMemset(R, 0, sizeof(*R));
+        }
+        return;
+    }
+
+    // Z3 = ((Z1 + Z2)^2 - Z1Z1 - Z2Z2) * H, before P and Q may be overwritten.
+    FpAdd(t, P->Z, Q->Z);
+    FpMul(t, t, t);
+    FpSub(t, t, Z1Z1);
+    FpSub(t, t, Z2Z2);
+    FpMul(R->Z, t, H);
+
+    FpAdd(I, H, H);
+    FpMul(I, I, I);                     // I = (2H)^2
+    FpMul(J, H, I);                     // J = H * I
+    FpMul(U1, U1, I);                   // V = U1 * I
+
+    // X3 = r^2 - J - 2V
+    FpMul(t, Rr, Rr);
+    FpSub(t, t, J);
+    FpSub(t, t, U1);
+    FpSub(R->X, t, U1);
+
+    // Y3 = r * (V - X3) - 2 * S1 * J
+    FpSub(t, U1, R->X);
+    FpMul(t, Rr, t);
+    FpMul(S1, S1, J);
+    FpAdd(S1, S1, S1);
+    FpSub(R->Y, t, S1);
+}
+
+/* y^2 == x^3 - 3x + b, with x and y in Montgomery form. */
+static bool IsOnCurve(const NvU32 *X, const NvU32 *Y)
+{
+    NvU32 B[ECC_P256_WORDS];
+    NvU32 Lhs[ECC_P256_WORDS];
+    NvU32 Rhs[ECC_P256_WORDS];
+    NvU32 t[ECC_P256_WORDS];
+
+    LoadLe(B, EccPrimeFieldParamsP256_NIST_P256.b);
+    ToMont(B, B, &s_P256p);
+
+    FpMul(Lhs, Y, Y);
+
+    FpMul(Rhs, X, X);
+    FpMul(Rhs, Rhs, X);
+    FpAdd(t, X, X);
+    FpAdd(t, t, X);
+    FpSub(Rhs, Rhs, t);
+    FpAdd(Rhs, Rhs, B);
+
+    return NvBootUtilCompareConstTime(Lhs, Rhs, sizeof(Lhs));
+}
+
+/* R = u1 * G + u2 * Q (Shamir's trick). Table[i] = bit0 G + bit1 Q. */
+static void DoubleScalarMul(EcdsaJacobianPoint *R,
+                            const NvU32 *u1,
+                            const NvU32 *u2,
+                            const EcdsaJacobianPoint *Table)
+{
+    NvU32 Bit;
+    NvU32 Index;
+
+    NvBootUtilMemset(R, 0, sizeof(*R));
+
+    for (Bit = 32 * ECC_P256_WORDS; Bit > 0; Bit--)
+    {
+        PointDouble(R, R);
+
+        Index = ((u1[(Bit - 1) / 32] >> ((Bit - 1) % 32)) & 1) |
+                (((u2[(Bit - 1) / 32] >> ((Bit - 1) % 32)) & 1) << 1);
+        if (Index != 0)
+            PointAdd(R, R, &Table[Index]);
+    }
+}
+
+NvBootError NvBootCryptoEcdsaVerify(NvBootCryptoEcdsaContext *EcdsaContext, NvBootShaDevMgr *ShaDevMgr)
+{
+    // Table[0] is unused; Table[1] = G, Table[2] = Q, Table[3] = G + Q.
+    EcdsaJacobianPoint Table[4];
+    EcdsaJacobianPoint Rp;
+    NvU32 r[ECC_P256_WORDS];
+    NvU32 s[ECC_P256_WORDS];
+    NvU32 EPrime[ECC_P256_WORDS];   // e', the hash reduced mod n
+    NvU32 w[ECC_P256_WORDS];
+    NvU32 u1[ECC_P256_WORDS];
+    NvU32 u2[ECC_P256_WORDS];
+    NvU32 t[ECC_P256_WORDS];
+    NvU32 Z2[ECC_P256_WORDS];
+    uint32_t Digest[NVBOOT_SHA256_LENGTH_WORDS];
+    FI_bool Match;
+
+    NvBootError e = NvBootInitializeNvBootError();
+    if(e == NvBootError_Success)
+        do_exception();
+
+    // Step 1. r and s must be integers in [1, n-1].
+    LoadLe(r, EcdsaContext->InputSignature->r);
+    LoadLe(s, EcdsaContext->InputSignature->s);
+    if(IsZero(r) || IsZero(s) || IsGe(r, s_P256n.M) || IsGe(s, s_P256n.M))
+        return NvBootError_CryptoMgr_Ecdsa_R_S_Out_Of_Range;
+
+    // The public key must be a point on the curve with coordinates < p.
+    NvBootUtilMemset(Table, 0, sizeof(Table));
+    LoadLe(Table[2].X, EcdsaContext->PublicKey->x);
+    LoadLe(Table[2].Y, EcdsaContext->PublicKey->y);
+    if(IsGe(Table[2].X, s_P256p.M) || IsGe(Table[2].Y, s_P256p.M))
+        return NvBootError_IllegalParameter;
+    ToMont(Table[2].X, Table[2].X, &s_P256p);
+    ToMont(Table[2].Y, Table[2].Y, &s_P256p);
+    MontOne(Table[2].Z, &s_P256p);
+    if(IsOnCurve(Table[2].X, Table[2].Y) == false)
+        return NvBootError_IllegalParameter;
+
+    // Step 2. e' = leftmost 256 bits of Hash(M), reduced mod n.
+    if(EcdsaContext->InputMessageIsHashed == false)
+    {
+        e = ShaDevMgr->ShaDevMgrCallbacks->ShaHash(EcdsaContext->InputMessage,
+                                                   EcdsaContext->InputMessageLengthBytes,
+                                                   (uint32_t *) &Digest,
+                                                   &ShaDevMgr->ShaConfig);
+        if(e != NvBootError_Success)
+            return e;
+    }
+    else
+    {
+        NvBootUtilMemcpy(&Digest, EcdsaContext->InputMessageShaHash, sizeof(Digest));
+    }
+    LoadDigest(EPrime, (const uint8_t *) &Digest);
+    if(IsGe(EPrime, s_P256n.M))
+        Sub(EPrime, EPrime, s_P256n.M);
+
+    // Step 3. w = s^-1 mod n, u1 = e' * w mod n, u2 = r * w mod n.
+    // w is in Montgomery form, so one more Montgomery multiply by a plain
+    // operand gives a plain result.
+    ToMont(w, s, &s_P256n);
+    MontInv(w, w, &s_P256n);
+    MontMul(u1, EPrime, w, &s_P256n);
+    MontMul(u2, r, w, &s_P256n);
+
+    // Step 4. R = u1 * G + u2 * Q.
+    LoadLe(Table[1].X, EccPrimeFieldParamsP256_NIST_P256.Gx);
+    LoadLe(Table[1].Y, EccPrimeFieldParamsP256_NIST_P256.Gy);
+    ToMont(Table[1].X, Table[1].X, &s_P256p);
+    ToMont(Table[1].Y, Table[1].Y, &s_P256p);
+    MontOne(Table[1].Z, &s_P256p);
+    PointAdd(&Table[3], &Table[1], &Table[2]);
+
+    DoubleScalarMul(&Rp, u1, u2, Table);
+    if(IsZero(Rp.Z))
+        return NvBootError_CryptoMgr_Ecdsa_Invalid_R_is_O;
+
+    // Step 5. v = x_R mod n must equal r. x_R = X / Z^2 < p, so x_R mod n
+    // is r if X == r * Z^2, or (when r + n < p) X == (r + n) * Z^2.
+    FpMul(Z2, Rp.Z, Rp.Z);
+    ToMont(t, r, &s_P256p);
+    FpMul(t, t, Z2);
+    Match = NvBootUtilCompareConstTimeFI(t, Rp.X, sizeof(t));
+
+    if((Add(u1, r, s_P256n.M) == 0) && (IsGe(u1, s_P256p.M) == false))
+    {
+        ToMont(t, u1, &s_P256p);
+        FpMul(t, t, Z2);
+        if(NvBootUtilCompareConstTimeFI(t, Rp.X, sizeof(t)) == FI_TRUE)
+            Match = FI_TRUE;
+    }
+
+    // Add random delay before the final check, as for RSASSA-PSS.
+    NvBootRngWaitRandomLoop(INSTRUCTION_DELAY_ENTROPY_BITS);
+
+    if(Match != FI_TRUE)
+    {
+        return NvBootError_CryptoMgr_Ecdsa_Invalid_Sig;
+    }
+    else
+    {
+        return NvBootError_Success;
+    }
+}
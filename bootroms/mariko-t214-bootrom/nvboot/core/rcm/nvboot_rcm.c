@@ -182,6 +182,9 @@ static NvBool IsValidInsecureLength(NvBootRcmMsg *pRcmMsg)
  * Once the header is complete, the remaining data fills the 96KB starting at
  * 0x40008000.
  *
+ * Once the header is in, the SHA-256 of the signed section is started on
+ * the SE between reads, so it runs while the host sends the next chunk.
+ *
  * Notes:
  *   BytesLeftInMessage refers to data remaining to be copied.
  *   BytesRead counts the amount of data that has been read from USB.
@@ -235,14 +238,20 @@ NvBootError ReceiveMessage(NvBootRcmMsg *pRcmMsgHeader)
                     HandleError(NvBootRcmResponse_InvalidInsecureLength);
                     return NvBootError_ValidationFailure;
                 }
+                NvBootCryptoMgrOemRcmHashStart(pRcmMsgHeader);
             }
         }
         // Check if we read the whole RCM Msg.        
         if(RcmHeaderRead && (TotalBytesRead >= RcmMsgAndPayloadLen))
             RcmMsgAndPayloadComplete = 1;
+        else if(RcmHeaderRead)
+            // Hash what is in while the next read lands.
+            NvBootCryptoMgrOemRcmHashUpdate(pRcmMsgHeader, TotalBytesRead);
         
     }
 
+    NvBootCryptoMgrOemRcmHashFinish(pRcmMsgHeader);
+
     /* Message was successfully received. */
     return  NvBootError_Success;
 }
@@ -582,7 +591,11 @@ NvBootError NvBootRCMInit(void)
         return NvBootError_RcmDebugRcm;
     }
 
+#if NVENABLE_HOST_RCM_SUPPORT
+    e = NvBootRcmSetupPortHandle(RCM_HOST);
+#else
     e = NvBootRcmSetupPortHandle(RCM_XUSB);
+#endif
     if(e != NvBootError_Success)
         return e;
 
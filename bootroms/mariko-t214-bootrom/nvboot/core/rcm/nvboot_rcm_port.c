@@ -10,6 +10,9 @@
 #include "nvboot_rcm_port_int.h"
 #include "nvboot_usbf_int.h"
 #include "nvboot_xusb_dev_int.h"
+#if NVENABLE_HOST_RCM_SUPPORT
+#include "nvboot_host_rcm_int.h"
+#endif
 #include "nvboot_error.h"
 static NvBootRCMPort_T sRCMPort;
 
@@ -29,6 +32,22 @@ NvBootError NvBootRcmSetupPortHandle(NvBootRCMPortID_T RcmPortId)
         sRCMPort.Transfer            = (RCMPortTransfer_T)NvBootXusbDeviceTransmit;
         sRCMPort.HandleError         = (RCMPortHandleError_T)NvBootXusbHandleError;
     }
+#if NVENABLE_HOST_RCM_SUPPORT
+    else if(RcmPortId == RCM_HOST)
+    {
+        sRCMPort.Context.PortId      = RCM_HOST;
+        sRCMPort.GetClockTable       = (RCMPortGetClockTable_T)NvBootHostRcmGetClockTable;
+        sRCMPort.Init                = (RCMPortInit_T)NvBootHostRcmInit;
+        sRCMPort.Connect             = (RCMPortConnect_T)NvBootHostRcmConnect;
+        sRCMPort.ReceiveStart        = (RCMPortReceiveStart_T)NvBootHostRcmReceiveStart;
+        sRCMPort.ReceivePoll         = (RCMPortReceivePoll_T)NvBootHostRcmReceivePoll;
+        sRCMPort.Receive             = (RCMPortReceive_T)NvBootHostRcmReceive;
+        sRCMPort.TransferStart       = (RCMPortTransferStart_T)NvBootHostRcmTransferStart;
+        sRCMPort.TransferPoll        = (RCMPortTransferPoll_T)NvBootHostRcmTransferPoll;
+        sRCMPort.Transfer            = (RCMPortTransfer_T)NvBootHostRcmTransfer;
+        sRCMPort.HandleError         = (RCMPortHandleError_T)NvBootHostRcmHandleError;
+    }
+#endif
     else
         return NvBootError_InvalidParameter;
     return NvBootError_Success;
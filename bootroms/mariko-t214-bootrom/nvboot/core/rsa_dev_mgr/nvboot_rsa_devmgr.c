@@ -12,6 +12,9 @@
 #include "nvboot_rsa_devmgr_int.h"
 #include "nvboot_hardware_access_int.h"
 #include "nvboot_se_rsa_dev_int.h"
+#if NVENABLE_SW_RSA_SUPPORT
+#include "nvboot_sw_rsa_dev_int.h"
+#endif
 
 NvBootRsaDevMgrCallbacks s_RsaDevMgrCallbacks[] =
 {
@@ -26,10 +29,54 @@ NvBootRsaDevMgrCallbacks s_RsaDevMgrCallbacks[] =
                 .IsDeviceBusy = NvBootSeRsaDevIsEngineBusy,
                 .ShutdownDevice = NULL,
         },
+        {
+                // PKA1, not supported.
+                .InitDevice = NULL,
+                .GetNumKeySlots = NULL,
+                .IsValidKeySlot = NULL,
+                .IsValidKeySize = NULL,
+                .GetKey = NULL,
+                .SetKey = NULL,
+                .RsaModularExponentiation = NULL,
+                .IsDeviceBusy = NULL,
+                .ShutdownDevice = NULL,
+        },
+#if NVENABLE_SW_RSA_SUPPORT
+        {
+                // SW engine
+                .InitDevice = NvBootSwRsaDevInit,
+                .GetNumKeySlots = NvBootSwRsaDevNumKeySlots,
+                .IsValidKeySlot = NvBootSwRsaDevIsValidKeySlot,
+                .IsValidKeySize = NvBootSwRsaDevIsValidKeySize,
+                .GetKey = NvBootSwRsaDevGetKey,
+                .SetKey = NvBootSwRsaDevSetKey,
+                .RsaModularExponentiation = NvBootSwRsaDevModularExponentiation,
+                .IsDeviceBusy = NvBootSwRsaDevIsEngineBusy,
+                .ShutdownDevice = NvBootSwRsaDevShutdown,
+        },
+#else
+        {
+                // SW engine, not built.
+                .InitDevice = NULL,
+                .GetNumKeySlots = NULL,
+                .IsValidKeySlot = NULL,
+                .IsValidKeySize = NULL,
+                .GetKey = NULL,
+                .SetKey = NULL,
+                .RsaModularExponentiation = NULL,
+                .IsDeviceBusy = NULL,
+                .ShutdownDevice = NULL,
+        },
+#endif
 };
 
 NvBootError NvBootRsaDevMgrInit(NvBootRsaDevMgr *RsaDevMgr, NvBootRsaDeviceList RsaDevice)
 {
+    // PKA1 only holds its index in the table.
+    if((RsaDevice >= NvBootRsaDevice_Num) ||
+       (s_RsaDevMgrCallbacks[RsaDevice].InitDevice == NULL))
+        return NvBootError_DeviceUnsupported;
+
     RsaDevMgr->RsaDevMgrCallbacks = &(s_RsaDevMgrCallbacks[RsaDevice]);
 
     RsaDevMgr->RsaDevMgrCallbacks->InitDevice();
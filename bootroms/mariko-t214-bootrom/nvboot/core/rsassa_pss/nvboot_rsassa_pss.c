@@ -56,20 +56,12 @@ MGF1 is a Mask Generation Function based on a hash function.
 #define MAX_MGF_MASKLEN (NVBOOT_RSA_MAX_MODULUS_SIZE_BYTES - RSASSA_PSS_HASH_FUNCTION_SIZE_BYTES - 1)
 
 /**
- * The size of the T buffer which holds the calculated mask should be of size
- * Ceil(maskLen / hLen) * hLen bytes (i.e. the number of iterations of the loop possible
- * times the hLen size).
- * In the case of a 2048-bit RSA key and SHA256, this should be
- * Ceil(223/32) * 32 bytes = 224 bytes.
- *
- * Note, maskLen can be less than 224, so only place maskLen bytes into the
- * T buffer.
+ * The mask T = Hash(mgfSeed||0) || Hash(mgfSeed||1) || ... is never stored.
+ * Each hLen block is xored into DB as soon as it is hashed, so the verify
+ * step 8 (DB = maskedDB xor dbMask) is done in the same pass and neither a
+ * T buffer nor a dbMask buffer is needed.
  */
-#define T_BUF_SIZE_BYTES (NV_ICEIL(MAX_MGF_MASKLEN, RSASSA_PSS_HASH_FUNCTION_SIZE_BYTES) * RSASSA_PSS_HASH_FUNCTION_SIZE_BYTES)
-#define T_BUF_SIZE_WORDS NV_ICEIL(T_BUF_SIZE_BYTES, 4)
-uint8_t VT_CRYPTO_BUFFER T_Buf[T_BUF_SIZE_BYTES] __attribute__((aligned(4)));
-
-NvBootError NvBootCryptoRsaSsaPssMGF(uint8_t *mgfSeed, uint32_t maskLen, uint8_t *dbMaskBuffer, NvBootShaDevMgr *ShaDevMgr)
+NvBootError NvBootCryptoRsaSsaPssMGF(uint8_t *mgfSeed, uint32_t maskLen, const uint8_t *maskedDBBuffer, uint8_t *DBBuffer, NvBootShaDevMgr *ShaDevMgr)
 {
     // Step 1. If maskLen > 2^32 hLen, output "mask too long" and stop.
     // maskLen is uint32_t, can not be > 2^32 hLen.
@@ -93,25 +85,26 @@ NvBootError NvBootCryptoRsaSsaPssMGF(uint8_t *mgfSeed, uint32_t maskLen, uint8_t
     // Therefore "loops" below is NOT the number of iterations.
     // The number of iterations is loops + 1.
     const uint32_t loops = (NV_ICEIL(maskLen, hLen)) - 1;
-    //NV debug NvBootPrintf("NvBootCryptoRsaSsaPssMGF(). hLen: %d. loop iterations: %d. maskLen: %d\r\n", hLen, loops+1, maskLen);
     // hashInputBuffer is the buffer for (mgfSeed || C), C accounts for the +1.
     uint32_t hashInputBuffer[RsaSsaPssHashFunctionSizeWords + 1];
+    // One hLen block of T.
+    uint32_t T[RSASSA_PSS_HASH_FUNCTION_SIZE_WORDS];
+    uint32_t offset;
+    uint32_t i;
     // Initialze e to a non-success value. Double check that it is not success before proceeding.
     NvBootError e = NvBootInitializeNvBootError();
     if(e == NvBootError_Success)
         do_exception();
 
-#if 1
-    NvBootUtilMemset(T_Buf, 0, T_BUF_SIZE_BYTES);
-    T_Buf[0xbe] = 0x01;
-#endif
+    // The seed part of (mgfSeed || C) is the same for every block.
+    NvBootUtilMemcpy((uint32_t *) &hashInputBuffer, mgfSeed, hLen);
+
     // MGF1 says "For counter from 0 to Ceil(maskLen/hLen)-1"
     // i.e.  loop from 0 to Ceil(223/32)-1 inclusive
     //       loop from 0 to 6 inclusive
     //       (i.e. 7 loops)
     for(counter = 0; counter <= loops; counter++)
     {
-        NvBootUtilMemcpy((uint32_t *) &hashInputBuffer, mgfSeed, hLen);
         hashInputBuffer[(hLen / 4) + 1 - 1] = NvBootUtilSwapBytesInNvU32(counter);
 
         e = NvBootInitializeNvBootError();
@@ -120,15 +113,18 @@ NvBootError NvBootCryptoRsaSsaPssMGF(uint8_t *mgfSeed, uint32_t maskLen, uint8_t
 
         e = ShaDevMgr->ShaDevMgrCallbacks->ShaHash((uint32_t *) &hashInputBuffer,
                                                 hLen + 4,
-                                                (uint32_t *) &T_Buf[counter*hLen],
+                                                (uint32_t *) &T,
                                                 &ShaDevMgr->ShaConfig);
         if(e != NvBootError_Success)
             return e;
-        //NV debug NvBootPrintf("MGF: copying into offset %d of T_Buf. Iteration %d.\r\n", counter*hLen, counter);
+
+        // DB = maskedDB xor T, up to maskLen bytes.
+        offset = counter * hLen;
+        for(i = 0; (i < hLen) && ((offset + i) < maskLen); i++)
+        {
+            DBBuffer[offset + i] = maskedDBBuffer[offset + i] ^ ((uint8_t *) &T)[i];
+        }
     }
-    // Fill the dbMaskBuffer from the T_Buf, up to maskLen bytes.
-    NvBootUtilMemcpy(dbMaskBuffer, &T_Buf, maskLen);
-    //NV debug NvBootPrintf("NvBootCryptoRsaSsaPssMGF(): T_Buf size: %d. bytes copied %d\r\n", sizeof(T_Buf), maskLen);
     return NvBootError_Success;
 }
 
@@ -174,11 +170,6 @@ uint8_t VT_CRYPTO_BUFFER *maskedDB; // Pointing to where EM points.
 uint8_t VT_CRYPTO_BUFFER *H; // Need to offset this by maskedDBLen before usage; See code below.
 // DB is the result of maskedDB xor dbMask, it becomes masked DB in the encoding step.
 uint8_t VT_CRYPTO_BUFFER DB[NVBOOT_RSA_MAX_MODULUS_SIZE_BYTES] __attribute__((aligned(4))); // DB is a subset of EM.
-// The buffer for the output of the mask generation function. The buffer size
-// required is maskLen = maskedDBLen = emLen - hLen - 1. Use emLen as the buffer size,
-// since the size of the MGF output will always be smaller than emLen. The PKCS spec
-// calls the MGF output the "dbMask", with length of maskLen.
-uint8_t VT_CRYPTO_BUFFER dbMask[NVBOOT_RSA_MAX_MODULUS_SIZE_BYTES] __attribute__((aligned(4)));
 // mHash is the result of Hash(M).
 uint32_t VT_CRYPTO_BUFFER mHash[RSASSA_PSS_HASH_FUNCTION_SIZE_WORDS];
 
@@ -452,27 +443,20 @@ NvBootError NvBootCryptoRsaSsaPssVerify(NvBootCryptoRsaSsaPssContext *RsaSsaPssC
     //                    = 223
     // mgfSeed = H = hLen = 32 octets
     // maskedDBLen is also maskLen = emLen - hLen - 1.
-    // dbMaskBuffer = maskLen
-    //uint8_t dbMask[maskedDBLen] __attribute__((aligned(4)));
+    // Step 8. Let DB = maskedDB XOR dbMask
+    // The MGF xors each mask block into DB as it is generated.
     e = NvBootInitializeNvBootError(); // default to non-success.
     if(e == NvBootError_Success)
         do_exception();
 
-    // Zero out the whole dbMask buffer, not just maskedDBLen.
-    NvBootUtilMemset(dbMask, 0, sizeof(dbMask));
-    e = NvBootCryptoRsaSsaPssMGF(H, maskedDBLen, (uint8_t *) &dbMask, ShaDevMgr);
+    // Zero out the whole DB buffer, not just maskedDBLen.
+    NvBootUtilMemset(DB, 0, sizeof(DB));
+    e = NvBootCryptoRsaSsaPssMGF(H, maskedDBLen, maskedDB, DB, ShaDevMgr);
     if(e != NvBootError_Success)
     {
         return NvBootError_RsaPssVerify_Inconsistent_MGF;
     }
 
-    // Step 8. Let DB = maskedDB XOR dbMask
-    //anw uint8_t DB[maskedDBLen] __attribute__((aligned(4)));
-    for(uint32_t i = 0; i < maskedDBLen; i++)
-    {
-        DB[i] = maskedDB[i] ^ dbMask[i];
-    }
-
     // Step 9. Set the leftmost 8emLen - emBits bits of the leftmost
     // octet in DB to zero.
     DB[0] &= ~(0xFF << (8 - LowestBits));
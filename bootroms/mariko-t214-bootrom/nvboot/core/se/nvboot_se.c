@@ -290,35 +290,24 @@ static NvU32 SeCreateCryptoKeyIvPkt(NvU8 KeySlot, NvU8 KeyIvSel, NvU8 KeyWord, N
  * @param SeLinkedList  Pointer to SeLinkedList struct
  * @param pStartAddress Pointer to start address of data to be processed by the SE
  * @param MessageSize   Size in bytes of the data to be processed by the SE
+ *
+ * @return NvBootError_IllegalParameter if MessageSize is 0 or too large, in
+ *         which case the list must not be handed to the SE.
  */
-static void NvBootSeGenerateLinkedList(SeLinkedList *pLinkedList, NvU32 *pStartAddress, NvU32 MessageSize) 
+static NvBootError NvBootSeGenerateLinkedList(SeLinkedList *pLinkedList, NvU32 *pStartAddress, NvU32 MessageSize) 
 {
-    
-    NvU32 i;
-    const NvU32 NumBuffers = NV_ICEIL(MessageSize, NVBOOT_SE_LL_MAX_BUFFER_SIZE_BYTES);
+    SeLinkedListElement Segment;
+    NvU32 TotalSize;
+    NvBootError e;
 
-    NV_ASSERT(NumBuffers > 0);
     NV_ASSERT(MessageSize <= NVBOOT_SE_LL_MAX_SIZE_BYTES);
 
-    // The first entry of the linked list is the "last buffer number", which
-    // begins with buffer 0. 
-    // For example, if there are two linked list buffers, the last buffer number
-    // is buffer 1. 
-    pLinkedList->LastBufferNumber = NumBuffers - 1;
-    
-    for(i = 0; i < NumBuffers; i++)
-    {
-        // Fill linked list buffer element with address of message and size. 
-        pLinkedList->LLElement[i].StartByteAddress = (NvU32) pStartAddress;
-        pLinkedList->LLElement[i].BufferByteSize = MessageSize > NVBOOT_SE_LL_MAX_BUFFER_SIZE_BYTES ?
-                    NVBOOT_SE_LL_MAX_BUFFER_SIZE_BYTES : MessageSize;
-
-        pStartAddress += NVBOOT_SE_LL_MAX_BUFFER_SIZE_WORDS;
+    Segment.StartByteAddress = (NvU32) pStartAddress;
+    Segment.BufferByteSize = MessageSize;
+    e = NvBootSeGenerateScatterLinkedList(pLinkedList, &Segment, 1, &TotalSize);
+    NV_ASSERT(e == NvBootError_Success);
 
-        // Subtract the maximum buffer size for every buffer except the last. 
-        if(MessageSize > NVBOOT_SE_LL_MAX_BUFFER_SIZE_BYTES)
-            MessageSize -= NVBOOT_SE_LL_MAX_BUFFER_SIZE_BYTES;
-    }
+    return e;
 }
 // --------------------- Static Buffers ----------------------------------------
 
@@ -1158,6 +1147,69 @@ NvBootError NvBootSeInstanceRsaModularExp(NvBootSeInstance SeInstance, NvU8 RsaK
     return NvBootError_Success;
 }
 
+/**
+ * Build one SE input linked list from NumSegments memory segments, in
+ * order. See nvboot_se_int.h.
+ */
+NvBootError
+NvBootSeGenerateScatterLinkedList(
+        SeLinkedList *pLinkedList,
+        const SeLinkedListElement *pSegments,
+        NvU32 NumSegments,
+        NvU32 *pMessageSizeBytes)
+{
+    NvU32 Segment;
+    NvU32 NumBuffers = 0;
+    NvU32 Address;
+    NvU32 BytesLeft;
+    NvU32 BufferSize;
+    NvU32 TotalSize = 0;
+
+    NV_ASSERT(pLinkedList != NULL);
+    NV_ASSERT(pSegments != NULL);
+    NV_ASSERT(pMessageSizeBytes != NULL);
+
+    for(Segment = 0; Segment < NumSegments; Segment++)
+    {
+        Address = pSegments[Segment].StartByteAddress;
+        BytesLeft = pSegments[Segment].BufferByteSize;
+
+        if(BytesLeft == 0)
+            return NvBootError_IllegalParameter;
+
+        // Segments larger than one linked list buffer take several
+        // consecutive buffers.
+        while(BytesLeft > 0)
+        {
+            if(NumBuffers == NVBOOT_SE_LL_MAX_NUM_BUFFERS)
+                return NvBootError_IllegalParameter;
+
+            BufferSize = BytesLeft > NVBOOT_SE_LL_MAX_BUFFER_SIZE_BYTES ?
+                         NVBOOT_SE_LL_MAX_BUFFER_SIZE_BYTES : BytesLeft;
+
+            pLinkedList->LLElement[NumBuffers].StartByteAddress = Address;
+            pLinkedList->LLElement[NumBuffers].BufferByteSize = BufferSize;
+            NumBuffers++;
+
+            Address += BufferSize;
+            BytesLeft -= BufferSize;
+            TotalSize += BufferSize;
+        }
+    }
+
+    if(NumBuffers == 0)
+        return NvBootError_IllegalParameter;
+
+    // The first entry of the linked list is the "last buffer number", which
+    // begins with buffer 0. 
+    // For example, if there are two linked list buffers, the last buffer number
+    // is buffer 1. 
+    pLinkedList->LastBufferNumber = NumBuffers - 1;
+    *pMessageSizeBytes = TotalSize;
+
+    return NvBootError_Success;
+}
+
 /**
  *
  * HashAlgorithm must be a supported algorithm. Use SE_MODE_PKT_SHAMODE to
@@ -1183,12 +1235,14 @@ NvBootError NvBootSeInstanceRsaModularExp(NvBootSeInstance SeInstance, NvU8 RsaK
  * If an input linked list is specified as an input, this function assumes 
  * the input linked list is correctly formatted. If pInputLinkList is specified, 
  * pInputMessage is effectively a don't care, but must still be non-NULL.
+ * NvBootSeGenerateScatterLinkedList() builds such a list from a set of
+ * segments; pass the total size it returns as InputMessageSizeBytes.
  *
  * pOutDestination should be a buffer of appropriate digest size or NULL if
  * the result is to be output to the SE_HASH_RESULT* registers. 
  *
  */
-void
+NvBootError
 NvBootSeSHAHash(NvU32 *pInputMessage, NvU32 InputMessageSizeBytes, NvU32 *pInputLinkedList, NvU32 *pOutputDestination, NvU8 HashAlgorithm)
 {
     NvU32   SeConfigReg = 0;
@@ -1207,6 +1261,7 @@ NvBootSeSHAHash(NvU32 *pInputMessage, NvU32 InputMessageSizeBytes, NvU32 *pInput
     NvU32   InputMessageBytesLeft = InputMessageSizeBytes;
     NvBool  First = NV_TRUE;
     NvBool  Last = NV_FALSE;
+    NvBootError e;
 
     NV_ASSERT(pInputMessage != NULL);
     NV_ASSERT( (HashAlgorithm == SE_MODE_PKT_SHAMODE_SHA1) ||
@@ -1219,7 +1274,7 @@ NvBootSeSHAHash(NvU32 *pInputMessage, NvU32 InputMessageSizeBytes, NvU32 *pInput
     if(InputMessageSizeBytes == 0)
     {
         NvBootUtilMemcpy(pOutputDestination, &Sha256NullStringDigest, NVBOOT_SHA256_LENGTH_BYTES);
-        return;
+        return NvBootError_Success;
     }
 
     // SHA operation is specified by programming SE_CONFIG.DEC_ALG to NOP and 
@@ -1277,10 +1332,12 @@ NvBootSeSHAHash(NvU32 *pInputMessage, NvU32 InputMessageSizeBytes, NvU32 *pInput
         {
             // Set up input the linked list, up to the maximum input
             // linked list size specified by NVBOOT_SE_LL_MAX_SIZE_BYTES. 
-            NvBootSeGenerateLinkedList(&s_InputLinkedList, 
-                                       pInputMessage, 
-                                       InputMessageBytesLeft > NVBOOT_SE_LL_MAX_SIZE_BYTES ?
-                                       NVBOOT_SE_LL_MAX_SIZE_BYTES : InputMessageBytesLeft);
+            e = NvBootSeGenerateLinkedList(&s_InputLinkedList, 
+                                           pInputMessage, 
+                                           InputMessageBytesLeft > NVBOOT_SE_LL_MAX_SIZE_BYTES ?
+                                           NVBOOT_SE_LL_MAX_SIZE_BYTES : InputMessageBytesLeft);
+            if(e != NvBootError_Success)
+                return e;
 
             // Program SE_IN_LL_ADDR with pointer to s_InputLinkedList
             NvBootSetSeReg(SE_IN_LL_ADDR_0, (NvU32) &s_InputLinkedList);
@@ -1374,6 +1431,89 @@ NvBootSeSHAHash(NvU32 *pInputMessage, NvU32 InputMessageSizeBytes, NvU32 *pInput
             ;
     }
 
+    return NvBootError_Success;
+}
+
+void
+NvBootSeInstanceSHA256HashChunkStart(
+        NvBootSeInstance SeInstance,
+        NvU32   *pChunk,
+        NvU32    ChunkSizeBytes,
+        NvU32    MessageSizeBytes,
+        NvU32    MessageBytesLeft,
+        NvU32   *pOutputDestination)
+{
+    NvU32   SeConfigReg = 0;
+    NvU64   MessageSizeBits = (NvU64) MessageSizeBytes * 8;
+    NvU64   MessageSizeBitsLeft = (NvU64) MessageBytesLeft * 8;
+    const NvBool First = (MessageBytesLeft == MessageSizeBytes);
+    const NvBool Last = (ChunkSizeBytes == MessageBytesLeft);
+
+    NV_ASSERT(pChunk != NULL);
+    NV_ASSERT(pOutputDestination != NULL);
+    NV_ASSERT(ChunkSizeBytes > 0);
+    NV_ASSERT(ChunkSizeBytes <= MessageBytesLeft);
+    NV_ASSERT(ChunkSizeBytes < NVBOOT_SE_LL_MAX_BUFFER_SIZE_BYTES);
+    // Intermediate chunks must end on a SHA-256 block (64 bytes) boundary.
+    NV_ASSERT(Last || ((ChunkSizeBytes % 64) == 0));
+
+    SeConfigReg = NV_FLD_SET_DRF_NUM(SE, CONFIG, ENC_MODE, SE_MODE_PKT_SHAMODE_SHA256, SeConfigReg);
+    SeConfigReg = NV_FLD_SET_DRF_DEF(SE, CONFIG, DEC_ALG, NOP, SeConfigReg);
+    SeConfigReg = NV_FLD_SET_DRF_DEF(SE, CONFIG, ENC_ALG, SHA, SeConfigReg);
+    // Intermediate results stay in SE_HASH_RESULT*; only the last chunk
+    // writes the digest to memory.
+    if(Last)
+    {
+        SeConfigReg = NV_FLD_SET_DRF_DEF(SE, CONFIG, DST, MEMORY, SeConfigReg);
+    }
+    else
+    {
+        SeConfigReg = NV_FLD_SET_DRF_DEF(SE, CONFIG, DST, HASH_REG, SeConfigReg);
+    }
+    NvBootSetSeInstanceReg(SeInstance, SE_CONFIG_0, SeConfigReg);
+
+    if(First)
+    {
+        SeConfigReg = NV_DRF_DEF(SE, SHA_CONFIG, HW_INIT_HASH, ENABLE);
+    }
+    else
+    {
+        SeConfigReg = NV_DRF_DEF(SE, SHA_CONFIG, HW_INIT_HASH, DISABLE);
+    }
+    NvBootSetSeInstanceReg(SeInstance, SE_SHA_CONFIG_0, SeConfigReg);
+
+    // SE_SHA_MSG_LENGTH is the total message length and SE_SHA_MSG_LEFT
+    // what remains including this chunk, both in bits. The BR handles
+    // messages below 4GB, so words 2-3 are zero.
+    NvBootSetSeInstanceReg(SeInstance, SE_SHA_MSG_LENGTH_0, (NvU32) MessageSizeBits);
+    NvBootSetSeInstanceReg(SeInstance, SE_SHA_MSG_LENGTH_1, (NvU32) (MessageSizeBits >> 32));
+    NvBootSetSeInstanceReg(SeInstance, SE_SHA_MSG_LENGTH_2, 0);
+    NvBootSetSeInstanceReg(SeInstance, SE_SHA_MSG_LENGTH_3, 0);
+    NvBootSetSeInstanceReg(SeInstance, SE_SHA_MSG_LEFT_0, (NvU32) MessageSizeBitsLeft);
+    NvBootSetSeInstanceReg(SeInstance, SE_SHA_MSG_LEFT_1, (NvU32) (MessageSizeBitsLeft >> 32));
+    NvBootSetSeInstanceReg(SeInstance, SE_SHA_MSG_LEFT_2, 0);
+    NvBootSetSeInstanceReg(SeInstance, SE_SHA_MSG_LEFT_3, 0);
+
+    InputLinkedList[SeInstance].LastBufferNumber = 0;
+    InputLinkedList[SeInstance].LLElement.StartByteAddress = (NvU32) pChunk;
+    InputLinkedList[SeInstance].LLElement.BufferByteSize = ChunkSizeBytes;
+    NvBootSetSeInstanceReg(SeInstance, SE_IN_LL_ADDR_0, (NvU32) &InputLinkedList[SeInstance]);
+
+    if(Last)
+    {
+        OutputLinkedList[SeInstance].LastBufferNumber = 0;
+        OutputLinkedList[SeInstance].LLElement.StartByteAddress = (NvU32) pOutputDestination;
+        OutputLinkedList[SeInstance].LLElement.BufferByteSize = ARSE_SHA256_HASH_SIZE / 8;
+        NvBootSetSeInstanceReg(SeInstance, SE_OUT_LL_ADDR_0, (NvU32) &OutputLinkedList[SeInstance]);
+    }
+
+    /**
+     * Issue START command in SE_OPERATION.OP
+     */
+    SeConfigReg = NV_DRF_DEF(SE, OPERATION, OP, START);
+    NvBootSetSeInstanceReg(SeInstance, SE_OPERATION_0, SeConfigReg);
+
+    // The caller polls NvBootSeInstanceIsEngineBusy() before the next chunk.
     return;
 }
 
@@ -2445,7 +2585,7 @@ void NvBootSeAesCmacGenerateSubkey(NvU8 KeySlot, NvU8 KeySize, NvU32 *pK1, NvU32
     return;
 }
 
-void
+NvBootError
 NvBootSeAesCmacHashBlocks (NvU32 *pK1, NvU32 *pK2, NvU32 *pInputMessage, NvU8 *pHash, NvU8 KeySlot, NvU8 KeySize, NvU32 NumBlocks, NvBool FirstChunk, NvBool LastChunk)
 {
 
@@ -2455,6 +2595,7 @@ NvBootSeAesCmacHashBlocks (NvU32 *pK1, NvU32 *pK2, NvU32 *pInputMessage, NvU8 *p
     NvU32   SeConfigReg;
     SeLinkedList InputLinkedList;
     SingleSeLinkedList OutputLinkedList;
+    NvBootError e;
 
     NV_ASSERT(pK1 != NULL);
     NV_ASSERT(pK2 != NULL);
@@ -2533,7 +2674,9 @@ NvBootSeAesCmacHashBlocks (NvU32 *pK1, NvU32 *pK2, NvU32 *pInputMessage, NvU8 *p
                 // instead of ORIGINAL IV since we just cleared the IVs above.
                 NvBootSeSetupOpMode(SE_OP_MODE_AES_CMAC_HASH, NV_TRUE, NV_FALSE, SE_CONFIG_0_DST_HASH_REG, KeySlot, KeySize);
                 // Generate an input linked list.
-                NvBootSeGenerateLinkedList(&InputLinkedList, pInputMessage, ByteOffsetToLastBlock);
+                e = NvBootSeGenerateLinkedList(&InputLinkedList, pInputMessage, ByteOffsetToLastBlock);
+                if(e != NvBootError_Success)
+                    return e;
                 // Set address of input linked list.
                 NvBootSetSeReg(SE_IN_LL_ADDR_0, (NvU32) &InputLinkedList);
 
@@ -2572,7 +2715,9 @@ NvBootSeAesCmacHashBlocks (NvU32 *pK1, NvU32 *pK2, NvU32 *pInputMessage, NvU8 *p
             NvBootSeSetupOpMode(SE_OP_MODE_AES_CMAC_HASH, NV_TRUE, NV_FALSE, SE_CONFIG_0_DST_MEMORY, KeySlot, KeySize);
             // Generate an input linked list.
             //static NvBootSeGenerateLinkedList(SeLinkedList *pLinkedList, NvU32 *pStartAddress, NvU32 MessageSize)
-            NvBootSeGenerateLinkedList(&InputLinkedList, LastBlockBuffer, NVBOOT_SE_AES_BLOCK_LENGTH_BYTES);
+            e = NvBootSeGenerateLinkedList(&InputLinkedList, LastBlockBuffer, NVBOOT_SE_AES_BLOCK_LENGTH_BYTES);
+            if(e != NvBootError_Success)
+                return e;
             // Set address of input linked list.
             NvBootSetSeReg(SE_IN_LL_ADDR_0, (NvU32) &InputLinkedList);
 
@@ -2614,7 +2759,9 @@ NvBootSeAesCmacHashBlocks (NvU32 *pK1, NvU32 *pK2, NvU32 *pInputMessage, NvU8 *p
             NvBootSeSetupOpMode(SE_OP_MODE_AES_CMAC_HASH, NV_TRUE, NV_FALSE, SE_CONFIG_0_DST_HASH_REG, KeySlot, KeySize);
             // Generate an input linked list.
             //static NvBootSeGenerateLinkedList(SeLinkedList *pLinkedList, NvU32 *pStartAddress, NvU32 MessageSize)
-            NvBootSeGenerateLinkedList(&InputLinkedList, pInputMessage, NumBlocks*NVBOOT_SE_AES_BLOCK_LENGTH_BYTES);
+            e = NvBootSeGenerateLinkedList(&InputLinkedList, pInputMessage, NumBlocks*NVBOOT_SE_AES_BLOCK_LENGTH_BYTES);
+            if(e != NvBootError_Success)
+                return e;
             // Set address of input linked list.
             NvBootSetSeReg(SE_IN_LL_ADDR_0, (NvU32) &InputLinkedList);
 
@@ -2632,6 +2779,8 @@ NvBootSeAesCmacHashBlocks (NvU32 *pK1, NvU32 *pK2, NvU32 *pInputMessage, NvU8 *p
             NvBootSetSeReg(SE_OPERATION_0, SeConfigReg);
         }
     }
+
+    return NvBootError_Success;
 }
 
 void NvBootSeAesDecrypt (
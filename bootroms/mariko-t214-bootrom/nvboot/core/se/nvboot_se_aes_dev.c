@@ -201,16 +201,14 @@ NvBootError NvBootSeAesCmacHash(NvBootAesDeviceCmacContext *AesCmacContext)
 
 //    NvBootSeAesCmacHashBlocks (NvU32 *pK1, NvU32 *pK2, NvU32 *pInputMessage, NvU8 *pHash, NvU8 KeySlot, NvU8 KeySize, NvU32 NumBlocks, NvBool FirstChunk, NvBool LastChunk)
 
-    NvBootSeAesCmacHashBlocks(AesCmacContext->pK1,
-                              AesCmacContext->pK2,
-                              AesCmacContext->pInputMessage,
-                              (uint8_t *)AesCmacContext->pHash,
-                              AesCmacContext->KeySlot,
-                              NvBootSeKeySizeConv(AesCmacContext->KeySize),
-                              AesCmacContext->NumBlocks,
-                              AesCmacContext->FirstChunk,
-                              AesCmacContext->LastChunk);
-
-    return NvBootError_Success;
+    return NvBootSeAesCmacHashBlocks(AesCmacContext->pK1,
+                                     AesCmacContext->pK2,
+                                     AesCmacContext->pInputMessage,
+                                     (uint8_t *)AesCmacContext->pHash,
+                                     AesCmacContext->KeySlot,
+                                     NvBootSeKeySizeConv(AesCmacContext->KeySize),
+                                     AesCmacContext->NumBlocks,
+                                     AesCmacContext->FirstChunk,
+                                     AesCmacContext->LastChunk);
 }
 
@@ -105,9 +105,7 @@ NvBootError NvBootSeShaDevShaHash(const uint32_t *InputMessage, uint32_t InputMe
     if(NvBootSeShaIsValidShaDigestSize(ShaConfig->ShaDigestSize) == false)
         return NvBootError_Unsupported_SHA_DigestSize;
 
-    NvBootSeSHAHash((uint32_t *) InputMessage, InputMessageLength, NULL, Hash, ConvertSeShaDigestSizeToSeFormat(ShaConfig->ShaDigestSize));
-
-    return NvBootError_Success;
+    return NvBootSeSHAHash((uint32_t *) InputMessage, InputMessageLength, NULL, Hash, ConvertSeShaDigestSizeToSeFormat(ShaConfig->ShaDigestSize));
 }
 
 /**
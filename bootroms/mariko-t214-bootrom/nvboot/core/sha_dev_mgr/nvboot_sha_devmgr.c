@@ -26,8 +26,22 @@ NvBootShaDevMgrCallbacks s_ShaDevMgrCallbacks[] =
                 .ShaHash = NvBootSeShaDevShaHash,
                 .ShutdownDevice = NvBootSeShaDeviceShutdown,
         },
+#if NVENABLE_SW_SHA_SUPPORT
         {
                 // SW engine
+                .InitDevice = NvBootSwShaDevInit,
+                .GetShaFamily = NvBootSwShaGetShaFamily,
+                .SetShaFamily = NvBootSwShaSetShaFamily,
+                .GetDigestSize = NvBootSwShaGetDigestSize,
+                .SetDigestSize = NvBootSwShaSetShaDigestSize,
+                .IsValidShaFamily = NvBootSwShaIsValidShaFamily,
+                .IsValidDigestSize = NvBootSwShaIsValidShaDigestSize,
+                .ShaHash = NvBootSwShaDevShaHash,
+                .ShutdownDevice = NvBootSwShaDeviceShutdown,
+        },
+#else
+        {
+                // SW engine, not built.
                 .InitDevice = NULL,
                 .GetShaFamily = NULL,
                 .SetShaFamily = NULL,
@@ -38,10 +52,15 @@ NvBootShaDevMgrCallbacks s_ShaDevMgrCallbacks[] =
                 .ShaHash = NULL,
                 .ShutdownDevice = NULL,
         },
+#endif
 };
 
 NvBootError NvBootShaDevMgrInit(NvBootShaDevMgr *ShaDevMgr, NvBootShaDeviceList ShaDevice)
 {
+    if((ShaDevice >= NvBootShaDevice_Num) ||
+       (s_ShaDevMgrCallbacks[ShaDevice].InitDevice == NULL))
+        return NvBootError_DeviceUnsupported;
+
     ShaDevMgr->ShaDevMgrCallbacks = &(s_ShaDevMgrCallbacks[ShaDevice]);
 
     ShaDevMgr->ShaDevMgrCallbacks->InitDevice(&ShaDevMgr->ShaConfig);
@@ -45,6 +45,7 @@ REDISTRIBUTION OF THIS SOFTWARE.
 
 #include "nvtypes.h"
 #include "nvboot_crypto_aes_param.h"
+#include "nvboot_config_int.h"
 #include "nvboot_sw_aes_int.h"
 #include "nvboot_util_int.h"
 #include <stdio.h>
@@ -53,11 +54,17 @@ REDISTRIBUTION OF THIS SOFTWARE.
 
 #define NVAES_STATECOLS 4     // Nb, number of columns in the state & expanded key. Always 4.
 
+#if NVBOOT_SW_AES_TTABLE && NVBOOT_SW_AES_CT
+#error "NVBOOT_SW_AES_TTABLE and NVBOOT_SW_AES_CT are exclusive"
+#endif
+
+#if !NVBOOT_SW_AES_TTABLE && !NVBOOT_SW_AES_CT
 static void ShiftRows       (uint8_t *state);
 static void InvShiftRows    (uint8_t *state);
 static void MixSubColumns   (uint8_t *state);
 static void InvMixSubColumns(uint8_t *state);
 static void AddRoundKey     (NvU32 *state, NvU32 *key);
+#endif
 
 typedef struct NvAesRefContext_Rec
 {
@@ -99,6 +106,7 @@ static void SetAesKeySize(
     }
 }
 
+#if !NVBOOT_SW_AES_CT
 static const uint8_t s_Sbox[256] __attribute__((aligned (NVBOOT_CRYPTO_BUFFER_ALIGNMENT))) =
 {                // forward s-box
     0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5,
@@ -170,6 +178,633 @@ static const uint8_t s_InvSbox[256]  __attribute__ ((aligned (NVBOOT_CRYPTO_BUFF
     0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26,
     0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d
 };
+#endif
+
+// little-endian word access to state and key schedule bytes
+#define GETWORD(p) \
+    ((NvU32)(p)[0] | ((NvU32)(p)[1] << 8) | \
+     ((NvU32)(p)[2] << 16) | ((NvU32)(p)[3] << 24))
+
+#define PUTWORD(p, w) \
+    do { \
+        (p)[0] = (uint8_t)(w); \
+        (p)[1] = (uint8_t)((w) >> 8); \
+        (p)[2] = (uint8_t)((w) >> 16); \
+        (p)[3] = (uint8_t)((w) >> 24); \
+    } while (0)
+
+#if NVBOOT_SW_AES_TTABLE
+
+/*
+ * Word-oriented AES: one table lookup per state byte per round does
+ * SubBytes, ShiftRows and MixColumns at once. Only the row 0 tables are
+ * stored; rows 1-3 are the same entries rotated by 8, 16 and 24 bits,
+ * which the ARM barrel shifter applies for free.
+ *
+ * A state column is held in a word with row 0 in the low byte, i.e. the
+ * little-endian load of the 4 state bytes.
+ */
+static const NvU32 s_Te0[256] __attribute__ ((aligned (NVBOOT_CRYPTO_BUFFER_ALIGNMENT))) =
+{        // {2, 1, 1, 3} * Sbox[x], row 0 in the low byte
+    0xa56363c6, 0x847c7cf8, 0x997777ee, 0x8d7b7bf6,
+    0x0df2f2ff, 0xbd6b6bd6, 0xb16f6fde, 0x54c5c591,
+    0x50303060, 0x03010102, 0xa96767ce, 0x7d2b2b56,
+    0x19fefee7, 0x62d7d7b5, 0xe6abab4d, 0x9a7676ec,
+    0x45caca8f, 0x9d82821f, 0x40c9c989, 0x877d7dfa,
+    0x15fafaef, 0xeb5959b2, 0xc947478e, 0x0bf0f0fb,
+    0xecadad41, 0x67d4d4b3, 0xfda2a25f, 0xeaafaf45,
+    0xbf9c9c23, 0xf7a4a453, 0x967272e4, 0x5bc0c09b,
+    0xc2b7b775, 0x1cfdfde1, 0xae93933d, 0x6a26264c,
+    0x5a36366c, 0x413f3f7e, 0x02f7f7f5, 0x4fcccc83,
+    0x5c343468, 0xf4a5a551, 0x34e5e5d1, 0x08f1f1f9,
+    0x937171e2, 0x73d8d8ab, 0x53313162, 0x3f15152a,
+    0x0c040408, 0x52c7c795, 0x65232346, 0x5ec3c39d,
+    0x28181830, 0xa1969637, 0x0f05050a, 0xb59a9a2f,
+    0x0907070e, 0x36121224, 0x9b80801b, 0x3de2e2df,
+    0x26ebebcd, 0x6927274e, 0xcdb2b27f, 0x9f7575ea,
+    0x1b090912, 0x9e83831d, 0x742c2c58, 0x2e1a1a34,
+    0x2d1b1b36, 0xb26e6edc, 0xee5a5ab4, 0xfba0a05b,
+    0xf65252a4, 0x4d3b3b76, 0x61d6d6b7, 0xceb3b37d,
+    0x7b292952, 0x3ee3e3dd, 0x712f2f5e, 0x97848413,
+    0xf55353a6, 0x68d1d1b9, 0x00000000, 0x2cededc1,
+    0x60202040, 0x1ffcfce3, 0xc8b1b179, 0xed5b5bb6,
+    0xbe6a6ad4, 0x46cbcb8d, 0xd9bebe67, 0x4b393972,
+    0xde4a4a94, 0xd44c4c98, 0xe85858b0, 0x4acfcf85,
+    0x6bd0d0bb, 0x2aefefc5, 0xe5aaaa4f, 0x16fbfbed,
+    0xc5434386, 0xd74d4d9a, 0x55333366, 0x94858511,
+    0xcf45458a, 0x10f9f9e9, 0x06020204, 0x817f7ffe,
+    0xf05050a0, 0x443c3c78, 0xba9f9f25, 0xe3a8a84b,
+    0xf35151a2, 0xfea3a35d, 0xc0404080, 0x8a8f8f05,
+    0xad92923f, 0xbc9d9d21, 0x48383870, 0x04f5f5f1,
+    0xdfbcbc63, 0xc1b6b677, 0x75dadaaf, 0x63212142,
+    0x30101020, 0x1affffe5, 0x0ef3f3fd, 0x6dd2d2bf,
+    0x4ccdcd81, 0x140c0c18, 0x35131326, 0x2fececc3,
+    0xe15f5fbe, 0xa2979735, 0xcc444488, 0x3917172e,
+    0x57c4c493, 0xf2a7a755, 0x827e7efc, 0x473d3d7a,
+    0xac6464c8, 0xe75d5dba, 0x2b191932, 0x957373e6,
+    0xa06060c0, 0x98818119, 0xd14f4f9e, 0x7fdcdca3,
+    0x66222244, 0x7e2a2a54, 0xab90903b, 0x8388880b,
+    0xca46468c, 0x29eeeec7, 0xd3b8b86b, 0x3c141428,
+    0x79dedea7, 0xe25e5ebc, 0x1d0b0b16, 0x76dbdbad,
+    0x3be0e0db, 0x56323264, 0x4e3a3a74, 0x1e0a0a14,
+    0xdb494992, 0x0a06060c, 0x6c242448, 0xe45c5cb8,
+    0x5dc2c29f, 0x6ed3d3bd, 0xefacac43, 0xa66262c4,
+    0xa8919139, 0xa4959531, 0x37e4e4d3, 0x8b7979f2,
+    0x32e7e7d5, 0x43c8c88b, 0x5937376e, 0xb76d6dda,
+    0x8c8d8d01, 0x64d5d5b1, 0xd24e4e9c, 0xe0a9a949,
+    0xb46c6cd8, 0xfa5656ac, 0x07f4f4f3, 0x25eaeacf,
+    0xaf6565ca, 0x8e7a7af4, 0xe9aeae47, 0x18080810,
+    0xd5baba6f, 0x887878f0, 0x6f25254a, 0x722e2e5c,
+    0x241c1c38, 0xf1a6a657, 0xc7b4b473, 0x51c6c697,
+    0x23e8e8cb, 0x7cdddda1, 0x9c7474e8, 0x211f1f3e,
+    0xdd4b4b96, 0xdcbdbd61, 0x868b8b0d, 0x858a8a0f,
+    0x907070e0, 0x423e3e7c, 0xc4b5b571, 0xaa6666cc,
+    0xd8484890, 0x05030306, 0x01f6f6f7, 0x120e0e1c,
+    0xa36161c2, 0x5f35356a, 0xf95757ae, 0xd0b9b969,
+    0x91868617, 0x58c1c199, 0x271d1d3a, 0xb99e9e27,
+    0x38e1e1d9, 0x13f8f8eb, 0xb398982b, 0x33111122,
+    0xbb6969d2, 0x70d9d9a9, 0x898e8e07, 0xa7949433,
+    0xb69b9b2d, 0x221e1e3c, 0x92878715, 0x20e9e9c9,
+    0x49cece87, 0xff5555aa, 0x78282850, 0x7adfdfa5,
+    0x8f8c8c03, 0xf8a1a159, 0x80898909, 0x170d0d1a,
+    0xdabfbf65, 0x31e6e6d7, 0xc6424284, 0xb86868d0,
+    0xc3414182, 0xb0999929, 0x772d2d5a, 0x110f0f1e,
+    0xcbb0b07b, 0xfc5454a8, 0xd6bbbb6d, 0x3a16162c,
+};
+
+static const NvU32 s_Td0[256] __attribute__ ((aligned (NVBOOT_CRYPTO_BUFFER_ALIGNMENT))) =
+{        // {e, 9, d, b} * InvSbox[x], row 0 in the low byte
+    0x50a7f451, 0x5365417e, 0xc3a4171a, 0x965e273a,
+    0xcb6bab3b, 0xf1459d1f, 0xab58faac, 0x9303e34b,
+    0x55fa3020, 0xf66d76ad, 0x9176cc88, 0x254c02f5,
+    0xfcd7e54f, 0xd7cb2ac5, 0x80443526, 0x8fa362b5,
+    0x495ab1de, 0x671bba25, 0x980eea45, 0xe1c0fe5d,
+    0x02752fc3, 0x12f04c81, 0xa397468d, 0xc6f9d36b,
+    0xe75f8f03, 0x959c9215, 0xeb7a6dbf, 0xda595295,
+    0x2d83bed4, 0xd3217458, 0x2969e049, 0x44c8c98e,
+    0x6a89c275, 0x78798ef4, 0x6b3e5899, 0xdd71b927,
+    0xb64fe1be, 0x17ad88f0, 0x66ac20c9, 0xb43ace7d,
+    0x184adf63, 0x82311ae5, 0x60335197, 0x457f5362,
+    0xe07764b1, 0x84ae6bbb, 0x1ca081fe, 0x942b08f9,
+    0x58684870, 0x19fd458f, 0x876cde94, 0xb7f87b52,
+    0x23d373ab, 0xe2024b72, 0x578f1fe3, 0x2aab5566,
+    0x0728ebb2, 0x03c2b52f, 0x9a7bc586, 0xa50837d3,
+    0xf2872830, 0xb2a5bf23, 0xba6a0302, 0x5c8216ed,
+    0x2b1ccf8a, 0x92b479a7, 0xf0f207f3, 0xa1e2694e,
+    0xcdf4da65, 0xd5be0506, 0x1f6234d1, 0x8afea6c4,
+    0x9d532e34, 0xa055f3a2, 0x32e18a05, 0x75ebf6a4,
+    0x39ec830b, 0xaaef6040, 0x069f715e, 0x51106ebd,
+    0xf98a213e, 0x3d06dd96, 0xae053edd, 0x46bde64d,
+    0xb58d5491, 0x055dc471, 0x6fd40604, 0xff155060,
+    0x24fb9819, 0x97e9bdd6, 0xcc434089, 0x779ed967,
+    0xbd42e8b0, 0x888b8907, 0x385b19e7, 0xdbeec879,
+    0x470a7ca1, 0xe90f427c, 0xc91e84f8, 0x00000000,
+    0x83868009, 0x48ed2b32, 0xac70111e, 0x4e725a6c,
+    0xfbff0efd, 0x5638850f, 0x1ed5ae3d, 0x27392d36,
+    0x64d90f0a, 0x21a65c68, 0xd1545b9b, 0x3a2e3624,
+    0xb1670a0c, 0x0fe75793, 0xd296eeb4, 0x9e919b1b,
+    0x4fc5c080, 0xa220dc61, 0x694b775a, 0x161a121c,
+    0x0aba93e2, 0xe52aa0c0, 0x43e0223c, 0x1d171b12,
+    0x0b0d090e, 0xadc78bf2, 0xb9a8b62d, 0xc8a91e14,
+    0x8519f157, 0x4c0775af, 0xbbdd99ee, 0xfd607fa3,
+    0x9f2601f7, 0xbcf5725c, 0xc53b6644, 0x347efb5b,
+    0x7629438b, 0xdcc623cb, 0x68fcedb6, 0x63f1e4b8,
+    0xcadc31d7, 0x10856342, 0x40229713, 0x2011c684,
+    0x7d244a85, 0xf83dbbd2, 0x1132f9ae, 0x6da129c7,
+    0x4b2f9e1d, 0xf330b2dc, 0xec52860d, 0xd0e3c177,
+    0x6c16b32b, 0x99b970a9, 0xfa489411, 0x2264e947,
+    0xc48cfca8, 0x1a3ff0a0, 0xd82c7d56, 0xef903322,
+    0xc74e4987, 0xc1d138d9, 0xfea2ca8c, 0x360bd498,
+    0xcf81f5a6, 0x28de7aa5, 0x268eb7da, 0xa4bfad3f,
+    0xe49d3a2c, 0x0d927850, 0x9bcc5f6a, 0x62467e54,
+    0xc2138df6, 0xe8b8d890, 0x5ef7392e, 0xf5afc382,
+    0xbe805d9f, 0x7c93d069, 0xa92dd56f, 0xb31225cf,
+    0x3b99acc8, 0xa77d1810, 0x6e639ce8, 0x7bbb3bdb,
+    0x097826cd, 0xf418596e, 0x01b79aec, 0xa89a4f83,
+    0x656e95e6, 0x7ee6ffaa, 0x08cfbc21, 0xe6e815ef,
+    0xd99be7ba, 0xce366f4a, 0xd4099fea, 0xd67cb029,
+    0xafb2a431, 0x31233f2a, 0x3094a5c6, 0xc066a235,
+    0x37bc4e74, 0xa6ca82fc, 0xb0d090e0, 0x15d8a733,
+    0x4a9804f1, 0xf7daec41, 0x0e50cd7f, 0x2ff69117,
+    0x8dd64d76, 0x4db0ef43, 0x544daacc, 0xdf0496e4,
+    0xe3b5d19e, 0x1b886a4c, 0xb81f2cc1, 0x7f516546,
+    0x04ea5e9d, 0x5d358c01, 0x737487fa, 0x2e410bfb,
+    0x5a1d67b3, 0x52d2db92, 0x335610e9, 0x1347d66d,
+    0x8c61d79a, 0x7a0ca137, 0x8e14f859, 0x893c13eb,
+    0xee27a9ce, 0x35c961b7, 0xede51ce1, 0x3cb1477a,
+    0x59dfd29c, 0x3f73f255, 0x79ce1418, 0xbf37c773,
+    0xeacdf753, 0x5baafd5f, 0x146f3ddf, 0x86db4478,
+    0x81f3afca, 0x3ec468b9, 0x2c342438, 0x5f40a3c2,
+    0x72c31d16, 0x0c25e2bc, 0x8b493c28, 0x41950dff,
+    0x7101a839, 0xdeb30c08, 0x9ce4b4d8, 0x90c15664,
+    0x6184cb7b, 0x70b632d5, 0x745c6c48, 0x4257b8d0,
+};
+
+#define ROTL(x, n)  (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define B0(x) ((x) & 0xff)
+#define B1(x) (((x) >> 8) & 0xff)
+#define B2(x) (((x) >> 16) & 0xff)
+#define B3(x) ((x) >> 24)
+
+// InvMixColumns of one round key word, needed by the equivalent inverse
+// cipher. Td0[Sbox[b]] is InvMixColumns of b in row 0.
+static NvU32
+InvMixColumnWord(NvU32 w)
+{
+    return        s_Td0[s_Sbox[B0(w)]]       ^
+             ROTL(s_Td0[s_Sbox[B1(w)]],  8)  ^
+             ROTL(s_Td0[s_Sbox[B2(w)]], 16)  ^
+             ROTL(s_Td0[s_Sbox[B3(w)]], 24);
+}
+
+#elif NVBOOT_SW_AES_CT
+
+/*
+ * Bitsliced AES: the state of two blocks is spread over 8 words, word i
+ * holding bit i of every byte, so that SubBytes is a fixed sequence of
+ * logic operations (the Boyar-Peralta S-box circuit) instead of table
+ * lookups indexed by secret data. Execution time does not depend on the
+ * key or the data. Both lanes are always computed; single block calls
+ * leave the second lane empty.
+ *
+ * Lane 0 is in the even bits and lane 1 in the odd bits of each word after
+ * CtOrtho().
+ */
+
+#define CT_SWAPN(cl, ch, s, x, y) \
+    do { \
+        NvU32 a_ = (x), b_ = (y); \
+        (x) = (a_ & (NvU32)(cl)) | ((b_ & (NvU32)(cl)) << (s)); \
+        (y) = ((a_ & (NvU32)(ch)) >> (s)) | (b_ & (NvU32)(ch)); \
+    } while (0)
+
+#define CT_SWAP2(x, y) CT_SWAPN(0x55555555, 0xAAAAAAAA, 1, x, y)
+#define CT_SWAP4(x, y) CT_SWAPN(0x33333333, 0xCCCCCCCC, 2, x, y)
+#define CT_SWAP8(x, y) CT_SWAPN(0x0F0F0F0F, 0xF0F0F0F0, 4, x, y)
+
+// convert between 4-word-per-block and bitsliced layout (self-inverse)
+static void
+CtOrtho(NvU32 *q)
+{
+    CT_SWAP2(q[0], q[1]);
+    CT_SWAP2(q[2], q[3]);
+    CT_SWAP2(q[4], q[5]);
+    CT_SWAP2(q[6], q[7]);
+
+    CT_SWAP4(q[0], q[2]);
+    CT_SWAP4(q[1], q[3]);
+    CT_SWAP4(q[4], q[6]);
+    CT_SWAP4(q[5], q[7]);
+
+    CT_SWAP8(q[0], q[4]);
+    CT_SWAP8(q[1], q[5]);
+    CT_SWAP8(q[2], q[6]);
+    CT_SWAP8(q[3], q[7]);
+}
+
+// SubBytes on all 32 bytes, as a boolean circuit (Boyar and Peralta,
+// "A depth-16 circuit for the AES S-box", 2011).
+static void
+CtSbox(NvU32 *q)
+{
+    NvU32 x0, x1, x2, x3, x4, x5, x6, x7;
+    NvU32 y1, y2, y3, y4, y5, y6, y7, y8, y9;
+    NvU32 y10, y11, y12, y13, y14, y15, y16, y17, y18, y19;
+    NvU32 y20, y21;
+    NvU32 z0, z1, z2, z3, z4, z5, z6, z7, z8, z9;
+    NvU32 z10, z11, z12, z13, z14, z15, z16, z17;
+    NvU32 t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+    NvU32 t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+    NvU32 t20, t21, t22, t23, t24, t25, t26, t27, t28, t29;
+    NvU32 t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+    NvU32 t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+    NvU32 t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+    NvU32 t60, t61, t62, t63, t64, t65, t66, t67;
+    NvU32 s0, s1, s2, s3, s4, s5, s6, s7;
+
+    x0 = q[7];
+    x1 = q[6];
+    x2 = q[5];
+    x3 = q[4];
+    x4 = q[3];
+    x5 = q[2];
+    x6 = q[1];
+    x7 = q[0];
+
+    // top linear transformation
+    y14 = x3 ^ x5;
+    y13 = x0 ^ x6;
+    y9 = x0 ^ x3;
+    y8 = x0 ^ x5;
+    t0 = x1 ^ x2;
+    y1 = t0 ^ x7;
+    y4 = y1 ^ x3;
+    y12 = y13 ^ y14;
+    y2 = y1 ^ x0;
+    y5 = y1 ^ x6;
+    y3 = y5 ^ y8;
+    t1 = x4 ^ y12;
+    y15 = t1 ^ x5;
+    y20 = t1 ^ x1;
+    y6 = y15 ^ x7;
+    y10 = y15 ^ t0;
+    y11 = y20 ^ y9;
+    y7 = x7 ^ y11;
+    y17 = y10 ^ y11;
+    y19 = y10 ^ y8;
+    y16 = t0 ^ y11;
+    y21 = y13 ^ y16;
+    y18 = x0 ^ y16;
+
+    // non-linear section
+    t2 = y12 & y15;
+    t3 = y3 & y6;
+    t4 = t3 ^ t2;
+    t5 = y4 & x7;
+    t6 = t5 ^ t2;
+    t7 = y13 & y16;
+    t8 = y5 & y1;
+    t9 = t8 ^ t7;
+    t10 = y2 & y7;
+    t11 = t10 ^ t7;
+    t12 = y9 & y11;
+    t13 = y14 & y17;
+    t14 = t13 ^ t12;
+    t15 = y8 & y10;
+    t16 = t15 ^ t12;
+    t17 = t4 ^ t14;
+    t18 = t6 ^ t16;
+    t19 = t9 ^ t14;
+    t20 = t11 ^ t16;
+    t21 = t17 ^ y20;
+    t22 = t18 ^ y19;
+    t23 = t19 ^ y21;
+    t24 = t20 ^ y18;
+
+    t25 = t21 ^ t22;
+    t26 = t21 & t23;
+    t27 = t24 ^ t26;
+    t28 = t25 & t27;
+    t29 = t28 ^ t22;
+    t30 = t23 ^ t24;
+    t31 = t22 ^ t26;
+    t32 = t31 & t30;
+    t33 = t32 ^ t24;
+    t34 = t23 ^ t33;
+    t35 = t27 ^ t33;
+    t36 = t24 & t35;
+    t37 = t36 ^ t34;
+    t38 = t27 ^ t36;
+    t39 = t29 & t38;
+    t40 = t25 ^ t39;
+
+    t41 = t40 ^ t37;
+    t42 = t29 ^ t33;
+    t43 = t29 ^ t40;
+    t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;
+    z1 = t37 & y6;
+    z2 = t33 & x7;
+    z3 = t43 & y16;
+    z4 = t40 & y1;
+    z5 = t29 & y7;
+    z6 = t42 & y11;
+    z7 = t45 & y17;
+    z8 = t41 & y10;
+    z9 = t44 & y12;
+    z10 = t37 & y3;
+    z11 = t33 & y4;
+    z12 = t43 & y13;
+    z13 = t40 & y5;
+    z14 = t29 & y2;
+    z15 = t42 & y9;
+    z16 = t45 & y14;
+    z17 = t41 & y8;
+
+    // bottom linear transformation
+    t46 = z15 ^ z16;
+    t47 = z10 ^ z11;
+    t48 = z5 ^ z13;
+    t49 = z9 ^ z10;
+    t50 = z2 ^ z12;
+    t51 = z2 ^ z5;
+    t52 = z7 ^ z8;
+    t53 = z0 ^ z3;
+    t54 = z6 ^ z7;
+    t55 = z16 ^ z17;
+    t56 = z12 ^ t48;
+    t57 = t50 ^ t53;
+    t58 = z4 ^ t46;
+    t59 = z3 ^ t54;
+    t60 = t46 ^ t57;
+    t61 = z14 ^ t57;
+    t62 = t52 ^ t58;
+    t63 = t49 ^ t58;
+    t64 = z4 ^ t59;
+    t65 = t61 ^ t62;
+    t66 = z1 ^ t63;
+    s0 = t59 ^ t63;
+    s6 = t56 ^ ~t62;
+    s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65;
+    s3 = t53 ^ t66;
+    s4 = t51 ^ t66;
+    s5 = t47 ^ t65;
+    s1 = t64 ^ ~s3;
+    s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+// inverse affine transform of the S-box, applied around CtSbox() to get
+// InvSubBytes
+static void
+CtInvAffine(NvU32 *q)
+{
+    NvU32 q0, q1, q2, q3, q4, q5, q6, q7;
+
+    q0 = ~q[0];
+    q1 = ~q[1];
+    q2 = q[2];
+    q3 = q[3];
+    q4 = q[4];
+    q5 = ~q[5];
+    q6 = ~q[6];
+    q7 = q[7];
+    q[7] = q1 ^ q4 ^ q6;
+    q[6] = q0 ^ q3 ^ q5;
+    q[5] = q7 ^ q2 ^ q4;
+    q[4] = q6 ^ q1 ^ q3;
+    q[3] = q5 ^ q0 ^ q2;
+    q[2] = q4 ^ q7 ^ q1;
+    q[1] = q3 ^ q6 ^ q0;
+    q[0] = q2 ^ q5 ^ q7;
+}
+
+static void
+CtInvSbox(NvU32 *q)
+{
+    CtInvAffine(q);
+    CtSbox(q);
+    CtInvAffine(q);
+}
+
+// ck is one round key as left by NvAesExpandKey(): the bitsliced key with
+// each pair of words folded into one, since both lanes use the same key
+static void
+CtAddRoundKey(NvU32 *q, const uint8_t *ck)
+{
+    int i;
+    NvU32 x, y;
+
+    for (i = 0; i < 4; i++)
+    {
+        x = y = GETWORD(ck + 4 * i);
+        x &= 0x55555555;
+        y &= 0xAAAAAAAA;
+        q[2 * i]     ^= x | (x << 1);
+        q[2 * i + 1] ^= y | (y >> 1);
+    }
+}
+
+static void
+CtShiftRows(NvU32 *q)
+{
+    int i;
+    NvU32 x;
+
+    for (i = 0; i < 8; i++)
+    {
+        x = q[i];
+        q[i] = (x & 0x000000FF)
+             | ((x & 0x0000FC00) >> 2) | ((x & 0x00000300) << 6)
+             | ((x & 0x00F00000) >> 4) | ((x & 0x000F0000) << 4)
+             | ((x & 0xC0000000) >> 6) | ((x & 0x3F000000) << 2);
+    }
+}
+
+static void
+CtInvShiftRows(NvU32 *q)
+{
+    int i;
+    NvU32 x;
+
+    for (i = 0; i < 8; i++)
+    {
+        x = q[i];
+        q[i] = (x & 0x000000FF)
+             | ((x & 0x00003F00) << 2) | ((x & 0x0000C000) >> 6)
+             | ((x & 0x000F0000) << 4) | ((x & 0x00F00000) >> 4)
+             | ((x & 0x03000000) << 6) | ((x & 0xFC000000) >> 2);
+    }
+}
+
+#define CT_ROT8(x)  (((x) >> 8) | ((x) << 24))
+#define CT_ROT16(x) (((x) << 16) | ((x) >> 16))
+
+static void
+CtMixColumns(NvU32 *q)
+{
+    NvU32 q0, q1, q2, q3, q4, q5, q6, q7;
+    NvU32 r0, r1, r2, r3, r4, r5, r6, r7;
+
+    q0 = q[0]; q1 = q[1]; q2 = q[2]; q3 = q[3];
+    q4 = q[4]; q5 = q[5]; q6 = q[6]; q7 = q[7];
+    r0 = CT_ROT8(q0); r1 = CT_ROT8(q1); r2 = CT_ROT8(q2); r3 = CT_ROT8(q3);
+    r4 = CT_ROT8(q4); r5 = CT_ROT8(q5); r6 = CT_ROT8(q6); r7 = CT_ROT8(q7);
+
+    q[0] = q7 ^ r7 ^ r0 ^ CT_ROT16(q0 ^ r0);
+    q[1] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ CT_ROT16(q1 ^ r1);
+    q[2] = q1 ^ r1 ^ r2 ^ CT_ROT16(q2 ^ r2);
+    q[3] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ CT_ROT16(q3 ^ r3);
+    q[4] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ CT_ROT16(q4 ^ r4);
+    q[5] = q4 ^ r4 ^ r5 ^ CT_ROT16(q5 ^ r5);
+    q[6] = q5 ^ r5 ^ r6 ^ CT_ROT16(q6 ^ r6);
+    q[7] = q6 ^ r6 ^ r7 ^ CT_ROT16(q7 ^ r7);
+}
+
+static void
+CtInvMixColumns(NvU32 *q)
+{
+    NvU32 q0, q1, q2, q3, q4, q5, q6, q7;
+    NvU32 r0, r1, r2, r3, r4, r5, r6, r7;
+
+    q0 = q[0]; q1 = q[1]; q2 = q[2]; q3 = q[3];
+    q4 = q[4]; q5 = q[5]; q6 = q[6]; q7 = q[7];
+    r0 = CT_ROT8(q0); r1 = CT_ROT8(q1); r2 = CT_ROT8(q2); r3 = CT_ROT8(q3);
+    r4 = CT_ROT8(q4); r5 = CT_ROT8(q5); r6 = CT_ROT8(q6); r7 = CT_ROT8(q7);
+
+    q[0] = q5 ^ q6 ^ q7 ^ r0 ^ r5 ^ r7 ^ CT_ROT16(q0 ^ q5 ^ q6 ^ r0 ^ r5);
+    q[1] = q0 ^ q5 ^ r0 ^ r1 ^ r5 ^ r6 ^ r7 ^ CT_ROT16(q1 ^ q5 ^ q7 ^ r1 ^ r5 ^ r6);
+    q[2] = q0 ^ q1 ^ q6 ^ r1 ^ r2 ^ r6 ^ r7 ^ CT_ROT16(q0 ^ q2 ^ q6 ^ r2 ^ r6 ^ r7);
+    q[3] = q0 ^ q1 ^ q2 ^ q5 ^ q6 ^ r0 ^ r2 ^ r3 ^ r5
+         ^ CT_ROT16(q0 ^ q1 ^ q3 ^ q5 ^ q6 ^ q7 ^ r0 ^ r3 ^ r5 ^ r7);
+    q[4] = q1 ^ q2 ^ q3 ^ q5 ^ r1 ^ r3 ^ r4 ^ r5 ^ r6 ^ r7
+         ^ CT_ROT16(q1 ^ q2 ^ q4 ^ q5 ^ q7 ^ r1 ^ r4 ^ r5 ^ r6);
+    q[5] = q2 ^ q3 ^ q4 ^ q6 ^ r2 ^ r4 ^ r5 ^ r6 ^ r7
+         ^ CT_ROT16(q2 ^ q3 ^ q5 ^ q6 ^ r2 ^ r5 ^ r6 ^ r7);
+    q[6] = q3 ^ q4 ^ q5 ^ q7 ^ r3 ^ r5 ^ r6 ^ r7
+         ^ CT_ROT16(q3 ^ q4 ^ q6 ^ q7 ^ r3 ^ r6 ^ r7);
+    q[7] = q4 ^ q5 ^ q6 ^ r4 ^ r6 ^ r7 ^ CT_ROT16(q4 ^ q5 ^ q7 ^ r4 ^ r7);
+}
+
+// SubWord() on the word w[0..3] of the key expansion
+static void
+CtSubWord(uint8_t *w)
+{
+    NvU32 q[8];
+    int i;
+
+    for (i = 0; i < 8; i++)
+        q[i] = GETWORD(w);
+    CtOrtho(q);
+    CtSbox(q);
+    CtOrtho(q);
+    PUTWORD(w, q[0]);
+
+    memset(q, 0, sizeof(q));
+}
+
+// bitslice the Nr + 1 round keys of expkey in place, same key in both lanes,
+// folded to NVAES_STATECOLS words per round for CtAddRoundKey()
+static void
+CtKeySchedule(uint8_t *expkey, NvU32 Nr)
+{
+    NvU32 round;
+    NvU32 q[8];
+    int i;
+
+    for (round = 0; round <= Nr; round++)
+    {
+        for (i = 0; i < 4; i++)
+            q[2 * i] = q[2 * i + 1] = GETWORD(expkey + 4 * i);
+        CtOrtho(q);
+        for (i = 0; i < 4; i++)
+            PUTWORD(expkey + 4 * i,
+                    (q[2 * i] & 0x55555555) | (q[2 * i + 1] & 0xAAAAAAAA));
+
+        expkey += NVAES_STATECOLS * 4;
+    }
+
+    memset(q, 0, sizeof(q));
+}
+
+// load up to two blocks into the bitsliced state; in1 may be NULL
+static void
+CtLoad(NvU32 *q, const uint8_t *in0, const uint8_t *in1)
+{
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        q[2 * i]     = GETWORD(in0 + 4 * i);
+        q[2 * i + 1] = (in1 != NULL) ? GETWORD(in1 + 4 * i) : 0;
+    }
+    CtOrtho(q);
+}
+
+static void
+CtStore(NvU32 *q, uint8_t *out0, uint8_t *out1)
+{
+    int i;
+
+    CtOrtho(q);
+    for (i = 0; i < 4; i++)
+    {
+        PUTWORD(out0 + 4 * i, q[2 * i]);
+        if (out1 != NULL)
+            PUTWORD(out1 + 4 * i, q[2 * i + 1]);
+    }
+}
+
+#define CT_RK(expkey, round) ((expkey) + NVAES_STATECOLS * 4 * (round))
+
+static void
+CtEncrypt(const uint8_t *expkey, NvU32 Nr, NvU32 *q)
+{
+    NvU32 round;
+
+    CtAddRoundKey(q, CT_RK(expkey, 0));
+    for (round = 1; round < Nr; round++)
+    {
+        CtSbox(q);
+        CtShiftRows(q);
+        CtMixColumns(q);
+        CtAddRoundKey(q, CT_RK(expkey, round));
+    }
+    CtSbox(q);
+    CtShiftRows(q);
+    CtAddRoundKey(q, CT_RK(expkey, Nr));
+}
+
+static void
+CtDecrypt(const uint8_t *expkey, NvU32 Nr, NvU32 *q)
+{
+    NvU32 round;
+
+    CtAddRoundKey(q, CT_RK(expkey, Nr));
+    for (round = Nr - 1; round > 0; round--)
+    {
+        CtInvShiftRows(q);
+        CtInvSbox(q);
+        CtAddRoundKey(q, CT_RK(expkey, round));
+        CtInvMixColumns(q);
+    }
+    CtInvShiftRows(q);
+    CtInvSbox(q);
+    CtAddRoundKey(q, CT_RK(expkey, 0));
+}
+
+#else
 
 // combined Xtimes2[Sbox[]]
 static const uint8_t s_Xtime2Sbox[256]  __attribute__ ((aligned (NVBOOT_CRYPTO_BUFFER_ALIGNMENT))) =
@@ -578,16 +1213,24 @@ AddRoundKey(NvU32 *state, NvU32 *key)
         state[idx] ^= key[idx];
 }
 
+#endif // NVBOOT_SW_AES_TTABLE / NVBOOT_SW_AES_CT
+
 static const uint8_t s_Rcon[11] __attribute__ ((aligned (NVBOOT_CRYPTO_BUFFER_ALIGNMENT))) =
 {
     0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
 };
 
-// produce NVAES_STATECOLS bytes for each round
+// produce NVAES_STATECOLS bytes for each round; the constant-time build
+// leaves them bitsliced
 void
 NvAesExpandKey(uint8_t *key, uint8_t *expkey, NvBootAesKeySize KeySize)
 {
+#if NVBOOT_SW_AES_CT
+    uint8_t  tmp[4];
+    uint8_t  tmp0, tmp1, tmp2, tmp3;
+#else
     uint8_t  tmp0, tmp1, tmp2, tmp3, tmp4;
+#endif
     NvU32 idx;
     //anw NvU32 i; //anw
 
@@ -604,6 +1247,33 @@ NvAesExpandKey(uint8_t *key, uint8_t *expkey, NvBootAesKeySize KeySize)
         tmp1 = expkey[4*idx - 3];
         tmp2 = expkey[4*idx - 2];
         tmp3 = expkey[4*idx - 1];
+#if NVBOOT_SW_AES_CT
+        if (!(idx % ctx.Nk) || (ctx.Nk > 6 && idx % ctx.Nk == 4))
+        {
+            // no key-indexed table lookups
+            if (!(idx % ctx.Nk))
+            {
+                tmp[0] = tmp1;
+                tmp[1] = tmp2;
+                tmp[2] = tmp3;
+                tmp[3] = tmp0;
+            }
+            else
+            {
+                tmp[0] = tmp0;
+                tmp[1] = tmp1;
+                tmp[2] = tmp2;
+                tmp[3] = tmp3;
+            }
+            CtSubWord(tmp);
+            tmp0 = tmp[0];
+            tmp1 = tmp[1];
+            tmp2 = tmp[2];
+            tmp3 = tmp[3];
+            if (!(idx % ctx.Nk))
+                tmp0 ^= s_Rcon[idx/ctx.Nk];
+        }
+#else
         if (!(idx % ctx.Nk))
         {
             tmp4 = tmp3;
@@ -619,6 +1289,7 @@ NvAesExpandKey(uint8_t *key, uint8_t *expkey, NvBootAesKeySize KeySize)
             tmp2 = s_Sbox[tmp2];
             tmp3 = s_Sbox[tmp3];
         }
+#endif
 
         expkey[4*idx+0] = expkey[4*idx - 4*ctx.Nk + 0] ^ tmp0;
         expkey[4*idx+1] = expkey[4*idx - 4*ctx.Nk + 1] ^ tmp1;
@@ -626,6 +1297,11 @@ NvAesExpandKey(uint8_t *key, uint8_t *expkey, NvBootAesKeySize KeySize)
         expkey[4*idx+3] = expkey[4*idx - 4*ctx.Nk + 3] ^ tmp3;
     }
 
+#if NVBOOT_SW_AES_CT
+    // bitslice once here rather than on every block
+    CtKeySchedule(expkey, ctx.Nr);
+    memset(tmp, 0, sizeof(tmp));
+#endif
 
 #if 0
 NvAuPrintf("expkey:\n");
@@ -636,6 +1312,158 @@ NvAuPrintf("expkey:\n");
 #endif
 }
 
+#if NVBOOT_SW_AES_TTABLE
+
+// encrypt one 128 bit block
+void
+NvAesEncrypt(uint8_t *in, uint8_t *expkey, uint8_t *out, NvBootAesKeySize KeySize)
+{
+    NvU32 s0, s1, s2, s3;
+    NvU32 t0, t1, t2, t3;
+    NvU32 round;
+    uint8_t *rk = expkey;
+
+    // Update parameters Nk and Nr
+    SetAesKeySize(&ctx, KeySize);
+
+    s0 = GETWORD(in +  0) ^ GETWORD(rk +  0);
+    s1 = GETWORD(in +  4) ^ GETWORD(rk +  4);
+    s2 = GETWORD(in +  8) ^ GETWORD(rk +  8);
+    s3 = GETWORD(in + 12) ^ GETWORD(rk + 12);
+
+    for (round = 1; round < ctx.Nr; round++)
+    {
+        rk += NVAES_STATECOLS * 4;
+
+        t0 = s_Te0[B0(s0)] ^ ROTL(s_Te0[B1(s1)], 8) ^
+             ROTL(s_Te0[B2(s2)], 16) ^ ROTL(s_Te0[B3(s3)], 24) ^ GETWORD(rk +  0);
+        t1 = s_Te0[B0(s1)] ^ ROTL(s_Te0[B1(s2)], 8) ^
+             ROTL(s_Te0[B2(s3)], 16) ^ ROTL(s_Te0[B3(s0)], 24) ^ GETWORD(rk +  4);
+        t2 = s_Te0[B0(s2)] ^ ROTL(s_Te0[B1(s3)], 8) ^
+             ROTL(s_Te0[B2(s0)], 16) ^ ROTL(s_Te0[B3(s1)], 24) ^ GETWORD(rk +  8);
+        t3 = s_Te0[B0(s3)] ^ ROTL(s_Te0[B1(s0)], 8) ^
+             ROTL(s_Te0[B2(s1)], 16) ^ ROTL(s_Te0[B3(s2)], 24) ^ GETWORD(rk + 12);
+
+        s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+    }
+
+    // last round has no MixColumns
+    rk += NVAES_STATECOLS * 4;
+
+    t0 = (NvU32)s_Sbox[B0(s0)] | ((NvU32)s_Sbox[B1(s1)] << 8) |
+         ((NvU32)s_Sbox[B2(s2)] << 16) | ((NvU32)s_Sbox[B3(s3)] << 24);
+    t1 = (NvU32)s_Sbox[B0(s1)] | ((NvU32)s_Sbox[B1(s2)] << 8) |
+         ((NvU32)s_Sbox[B2(s3)] << 16) | ((NvU32)s_Sbox[B3(s0)] << 24);
+    t2 = (NvU32)s_Sbox[B0(s2)] | ((NvU32)s_Sbox[B1(s3)] << 8) |
+         ((NvU32)s_Sbox[B2(s0)] << 16) | ((NvU32)s_Sbox[B3(s1)] << 24);
+    t3 = (NvU32)s_Sbox[B0(s3)] | ((NvU32)s_Sbox[B1(s0)] << 8) |
+         ((NvU32)s_Sbox[B2(s1)] << 16) | ((NvU32)s_Sbox[B3(s2)] << 24);
+
+    t0 ^= GETWORD(rk +  0);
+    t1 ^= GETWORD(rk +  4);
+    t2 ^= GETWORD(rk +  8);
+    t3 ^= GETWORD(rk + 12);
+
+    PUTWORD(out +  0, t0);
+    PUTWORD(out +  4, t1);
+    PUTWORD(out +  8, t2);
+    PUTWORD(out + 12, t3);
+}
+
+// decrypt one 128 bit block using the equivalent inverse cipher
+// (fips-197 5.3.5) with the encryption key schedule.
+void
+NvAesDecrypt(uint8_t *in, uint8_t *expkey, uint8_t *out, NvBootAesKeySize KeySize)
+{
+    NvU32 s0, s1, s2, s3;
+    NvU32 t0, t1, t2, t3;
+    NvU32 round;
+    uint8_t *rk;
+
+    // Update parameters Nk and Nr
+    SetAesKeySize(&ctx, KeySize);
+
+    rk = expkey + ctx.Nr * NVAES_STATECOLS * 4;
+
+    s0 = GETWORD(in +  0) ^ GETWORD(rk +  0);
+    s1 = GETWORD(in +  4) ^ GETWORD(rk +  4);
+    s2 = GETWORD(in +  8) ^ GETWORD(rk +  8);
+    s3 = GETWORD(in + 12) ^ GETWORD(rk + 12);
+
+    for (round = ctx.Nr - 1; round > 0; round--)
+    {
+        rk -= NVAES_STATECOLS * 4;
+
+        t0 = s_Td0[B0(s0)] ^ ROTL(s_Td0[B1(s3)], 8) ^
+             ROTL(s_Td0[B2(s2)], 16) ^ ROTL(s_Td0[B3(s1)], 24) ^
+             InvMixColumnWord(GETWORD(rk +  0));
+        t1 = s_Td0[B0(s1)] ^ ROTL(s_Td0[B1(s0)], 8) ^
+             ROTL(s_Td0[B2(s3)], 16) ^ ROTL(s_Td0[B3(s2)], 24) ^
+             InvMixColumnWord(GETWORD(rk +  4));
+        t2 = s_Td0[B0(s2)] ^ ROTL(s_Td0[B1(s1)], 8) ^
+             ROTL(s_Td0[B2(s0)], 16) ^ ROTL(s_Td0[B3(s3)], 24) ^
+             InvMixColumnWord(GETWORD(rk +  8));
+        t3 = s_Td0[B0(s3)] ^ ROTL(s_Td0[B1(s2)], 8) ^
+             ROTL(s_Td0[B2(s1)], 16) ^ ROTL(s_Td0[B3(s0)], 24) ^
+             InvMixColumnWord(GETWORD(rk + 12));
+
+        s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+    }
+
+    // last round has no InvMixColumns
+    rk = expkey;
+
+    t0 = (NvU32)s_InvSbox[B0(s0)] | ((NvU32)s_InvSbox[B1(s3)] << 8) |
+         ((NvU32)s_InvSbox[B2(s2)] << 16) | ((NvU32)s_InvSbox[B3(s1)] << 24);
+    t1 = (NvU32)s_InvSbox[B0(s1)] | ((NvU32)s_InvSbox[B1(s0)] << 8) |
+         ((NvU32)s_InvSbox[B2(s3)] << 16) | ((NvU32)s_InvSbox[B3(s2)] << 24);
+    t2 = (NvU32)s_InvSbox[B0(s2)] | ((NvU32)s_InvSbox[B1(s1)] << 8) |
+         ((NvU32)s_InvSbox[B2(s0)] << 16) | ((NvU32)s_InvSbox[B3(s3)] << 24);
+    t3 = (NvU32)s_InvSbox[B0(s3)] | ((NvU32)s_InvSbox[B1(s2)] << 8) |
+         ((NvU32)s_InvSbox[B2(s1)] << 16) | ((NvU32)s_InvSbox[B3(s0)] << 24);
+
+    t0 ^= GETWORD(rk +  0);
+    t1 ^= GETWORD(rk +  4);
+    t2 ^= GETWORD(rk +  8);
+    t3 ^= GETWORD(rk + 12);
+
+    PUTWORD(out +  0, t0);
+    PUTWORD(out +  4, t1);
+    PUTWORD(out +  8, t2);
+    PUTWORD(out + 12, t3);
+}
+
+#elif NVBOOT_SW_AES_CT
+
+// encrypt one 128 bit block
+void
+NvAesEncrypt(uint8_t *in, uint8_t *expkey, uint8_t *out, NvBootAesKeySize KeySize)
+{
+    NvU32 q[8];
+
+    // Update parameters Nk and Nr
+    SetAesKeySize(&ctx, KeySize);
+
+    CtLoad(q, in, NULL);
+    CtEncrypt(expkey, ctx.Nr, q);
+    CtStore(q, out, NULL);
+}
+
+void
+NvAesDecrypt(uint8_t *in, uint8_t *expkey, uint8_t *out, NvBootAesKeySize KeySize)
+{
+    NvU32 q[8];
+
+    // Update parameters Nk and Nr
+    SetAesKeySize(&ctx, KeySize);
+
+    CtLoad(q, in, NULL);
+    CtDecrypt(expkey, ctx.Nr, q);
+    CtStore(q, out, NULL);
+}
+
+#else
+
 // encrypt one 128 bit block
 void
 NvAesEncrypt(uint8_t *in, uint8_t *expkey, uint8_t *out, NvBootAesKeySize KeySize)
@@ -687,6 +1515,8 @@ NvAesDecrypt(uint8_t *in, uint8_t *expkey, uint8_t *out, NvBootAesKeySize KeySiz
     memcpy (out, state, sizeof(state));
 }
 
+#endif // NVBOOT_SW_AES_TTABLE / NVBOOT_SW_AES_CT
+
 NvU32
 NvAesGetKeySizeInBytes(NvBootAesKeySize KeySize)
 {
@@ -815,6 +1645,74 @@ NvAesEncryptObject(uint8_t   *KeySchedule,
     }
 }
 
+/*
+ * CBC-decrypt NumAesBlocks blocks from Src to Dst with the given IV. Src
+ * and Dst may be the same buffer. Every block is decrypted independently,
+ * so the bitsliced build decrypts two blocks per pass.
+ */
+void
+NvAesDecryptObject(uint8_t   *KeySchedule,
+                   uint8_t   *Iv,
+                   uint8_t   *Src,
+                   uint8_t   *Dst,
+                   NvU32   NumAesBlocks,
+                   NvBootAesKeySize   KeySize)
+{
+    uint8_t  CbcChainData[NVBOOT_AES_BLOCK_LENGTH_BYTES * 2];
+    uint8_t  TmpData[NVBOOT_AES_BLOCK_LENGTH_BYTES * 2];
+    NvU32 i;
+#if NVBOOT_SW_AES_CT
+    NvU32 q[8];
+#endif
+
+    NV_ASSERT(KeySchedule != NULL);
+    NV_ASSERT(Iv          != NULL);
+    NV_ASSERT(Src         != NULL);
+    NV_ASSERT(Dst         != NULL);
+
+    memcpy(CbcChainData, Iv, NVBOOT_AES_BLOCK_LENGTH_BYTES);
+
+#if NVBOOT_SW_AES_CT
+    SetAesKeySize(&ctx, KeySize);
+
+    for (i = 0; i + 1 < NumAesBlocks; i += 2)
+    {
+        /* Keep the ciphertext for chaining; Src may alias Dst. */
+        memcpy(&CbcChainData[NVBOOT_AES_BLOCK_LENGTH_BYTES], Src,
+               NVBOOT_AES_BLOCK_LENGTH_BYTES);
+        memcpy(TmpData, Src + NVBOOT_AES_BLOCK_LENGTH_BYTES,
+               NVBOOT_AES_BLOCK_LENGTH_BYTES);
+
+        CtLoad(q, Src, Src + NVBOOT_AES_BLOCK_LENGTH_BYTES);
+        CtDecrypt(KeySchedule, ctx.Nr, q);
+        CtStore(q, Dst, Dst + NVBOOT_AES_BLOCK_LENGTH_BYTES);
+
+        ApplyCbcChainData(CbcChainData, Dst, Dst);
+        ApplyCbcChainData(&CbcChainData[NVBOOT_AES_BLOCK_LENGTH_BYTES],
+                          Dst + NVBOOT_AES_BLOCK_LENGTH_BYTES,
+                          Dst + NVBOOT_AES_BLOCK_LENGTH_BYTES);
+
+        memcpy(CbcChainData, TmpData, NVBOOT_AES_BLOCK_LENGTH_BYTES);
+        Src += NVBOOT_AES_BLOCK_LENGTH_BYTES * 2;
+        Dst += NVBOOT_AES_BLOCK_LENGTH_BYTES * 2;
+    }
+#else
+    i = 0;
+#endif
+
+    for (; i < NumAesBlocks; i++)
+    {
+        memcpy(TmpData, Src, NVBOOT_AES_BLOCK_LENGTH_BYTES);
+
+        NvAesDecrypt(Src, KeySchedule, Dst, KeySize);
+        ApplyCbcChainData(CbcChainData, Dst, Dst);
+
+        memcpy(CbcChainData, TmpData, NVBOOT_AES_BLOCK_LENGTH_BYTES);
+        Src += NVBOOT_AES_BLOCK_LENGTH_BYTES;
+        Dst += NVBOOT_AES_BLOCK_LENGTH_BYTES;
+    }
+}
+
 static void
 LeftShiftVector(uint8_t   *In,
           uint8_t   *Out,
@@ -971,3 +1869,138 @@ NvAesCmacSignObject(uint8_t       *Key,
 {
     SignObject(Key, KeySchedule, Src, Dst, NumAesBlocks, KeySize);
 }
+
+/*
+ * Compute both AES-CMAC subkeys (RFC 4493 2.3). K2 is K1 shifted left by
+ * one bit, conditionally xored with Rb, so it costs no extra encryption.
+ */
+void
+NvAesCmacGenerateSubkeys(uint8_t *KeySchedule,
+                         NvBootAesCmacHashParams *Subkeys,
+                         NvBootAesKeySize KeySize)
+{
+    uint8_t *K1;
+    uint8_t *K2;
+
+    NV_ASSERT(KeySchedule != NULL);
+    NV_ASSERT(Subkeys     != NULL);
+
+    K1 = (uint8_t *)Subkeys->K1;
+    K2 = (uint8_t *)Subkeys->K2;
+
+    NvAesCmacGenerateSubkey(NULL, KeySchedule, K1, KeySize);
+
+    LeftShiftVector(K1, K2, NVBOOT_AES_BLOCK_LENGTH_BYTES);
+
+    if ( (K1[0] >> 7) != 0 ) // get MSB of K1
+        K2[NVBOOT_AES_BLOCK_LENGTH_BYTES-1] ^= NVBOOT_AES_CMAC_CONST_RB;
+}
+
+/*
+ * Start an incremental AES-CMAC. If Subkeys is NULL they are derived from
+ * KeySchedule; callers that MAC several objects under one key can compute
+ * them once with NvAesCmacGenerateSubkeys() and pass them in.
+ * KeySchedule must stay valid until NvAesCmacFinal().
+ */
+void
+NvAesCmacInit(NvBootAesCmacContext *Context,
+              uint8_t *KeySchedule,
+              const NvBootAesCmacHashParams *Subkeys,
+              NvBootAesKeySize KeySize)
+{
+    NV_ASSERT(Context     != NULL);
+    NV_ASSERT(KeySchedule != NULL);
+
+    if (Subkeys != NULL)
+        memcpy(&Context->Subkeys, Subkeys, sizeof(Context->Subkeys));
+    else
+        NvAesCmacGenerateSubkeys(KeySchedule, &Context->Subkeys, KeySize);
+
+    Context->KeySchedule  = KeySchedule;
+    Context->KeySize      = KeySize;
+    Context->PendingBytes = 0;
+    memset(Context->Chain, 0, sizeof(Context->Chain));
+}
+
+/*
+ * Add Len bytes of message to the MAC. Chunks may be of any size. A full
+ * block is only chained in once more data shows it is not the last one.
+ */
+void
+NvAesCmacUpdate(NvBootAesCmacContext *Context,
+                const uint8_t *Src,
+                NvU32 Len)
+{
+    uint8_t *Chain;
+    uint8_t *Pending;
+    NvU32 Bytes;
+
+    NV_ASSERT(Context != NULL);
+    NV_ASSERT((Src != NULL) || (Len == 0));
+
+    Chain   = (uint8_t *)Context->Chain;
+    Pending = (uint8_t *)Context->Pending;
+
+    while (Len > 0)
+    {
+        if (Context->PendingBytes == NVBOOT_AES_BLOCK_LENGTH_BYTES)
+        {
+            ApplyCbcChainData(Chain, Pending, Chain);
+            NvAesEncrypt(Chain, Context->KeySchedule, Chain, Context->KeySize);
+            Context->PendingBytes = 0;
+        }
+
+        /* Chain whole blocks directly from Src while more data follows. */
+        while ((Context->PendingBytes == 0) &&
+               (Len > NVBOOT_AES_BLOCK_LENGTH_BYTES))
+        {
+            ApplyCbcChainData(Chain, (uint8_t *)Src, Chain);
+            NvAesEncrypt(Chain, Context->KeySchedule, Chain, Context->KeySize);
+            Src += NVBOOT_AES_BLOCK_LENGTH_BYTES;
+            Len -= NVBOOT_AES_BLOCK_LENGTH_BYTES;
+        }
+
+        Bytes = NV_MIN(Len, NVBOOT_AES_BLOCK_LENGTH_BYTES -
+                            Context->PendingBytes);
+        memcpy(&Pending[Context->PendingBytes], Src, Bytes);
+        Context->PendingBytes += Bytes;
+        Src += Bytes;
+        Len -= Bytes;
+    }
+}
+
+/*
+ * Finish the MAC into Dst. A complete last block is xored with K1; a
+ * partial one (or an empty message) is padded with 10* and xored with K2.
+ * The context is cleared, as it holds key-derived data.
+ */
+void
+NvAesCmacFinal(NvBootAesCmacContext *Context, uint8_t *Dst)
+{
+    uint8_t *Chain;
+    uint8_t *Pending;
+    NvU32 i;
+
+    NV_ASSERT(Context != NULL);
+    NV_ASSERT(Dst     != NULL);
+
+    Chain   = (uint8_t *)Context->Chain;
+    Pending = (uint8_t *)Context->Pending;
+
+    if (Context->PendingBytes == NVBOOT_AES_BLOCK_LENGTH_BYTES)
+    {
+        ApplyCbcChainData(Pending, (uint8_t *)Context->Subkeys.K1, Pending);
+    }
+    else
+    {
+        Pending[Context->PendingBytes] = 0x80;
+        for (i = Context->PendingBytes + 1; i < NVBOOT_AES_BLOCK_LENGTH_BYTES; i++)
+            Pending[i] = 0;
+        ApplyCbcChainData(Pending, (uint8_t *)Context->Subkeys.K2, Pending);
+    }
+
+    ApplyCbcChainData(Chain, Pending, Chain);
+    NvAesEncrypt(Chain, Context->KeySchedule, Dst, Context->KeySize);
+
+    memset(Context, 0, sizeof(*Context));
+}
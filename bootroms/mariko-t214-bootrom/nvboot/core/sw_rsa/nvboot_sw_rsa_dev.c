@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * nvboot_sw_rsa_dev.c - Software RSA public key device for the RSA device
+ * manager.
+ *
+ * Modular exponentiation uses Montgomery multiplication (CIOS, 32-bit
+ * limbs). R^2 mod n and -n^-1 mod 2^32 are computed once when a key is
+ * loaded, and kept when the same key is loaded again. The public exponent
+ * 0x10001 takes a dedicated path of one conversion into Montgomery form,
+ * 16 squarings and one multiply by the plain base, which also converts the
+ * result back out. Other exponents use left-to-right square-and-multiply.
+ *
+ * This only handles public keys, so no attempt is made to be constant
+ * time.
+ *
+ * Only built when NVENABLE_SW_RSA_SUPPORT=1 and the sw_rsa core library is
+ * enabled; otherwise the NvBootRsaDevice_SW slot stays empty.
+ */
+
+#include <stdbool.h>
+#include "nvtypes.h"
+#include "nvboot_error.h"
+#include "nvboot_sw_rsa_dev_int.h"
+#include "nvboot_crypto_rsa_param.h"
+#include "nvboot_util_int.h"
+
+typedef struct NvBootSwRsaKeySlotRec
+{
+    /// Specifies the key size in bits, 0 if the slot is empty.
+    NvBootCryptoRsaKeySize KeySize;
+    NvU32 NumWords;
+    NvU32 Modulus[NVBOOT_SW_RSA_MAX_MODULUS_SIZE_WORDS];
+    NvU32 Exponent[NVBOOT_SW_RSA_MAX_MODULUS_SIZE_WORDS];
+    /// Specifies R^2 mod n, R = 2^(32 * NumWords).
+    NvU32 R2[NVBOOT_SW_RSA_MAX_MODULUS_SIZE_WORDS];
+    /// Specifies -n^-1 mod 2^32.
+    NvU32 N0Inv;
+    /// Specifies whether the exponent is 0x10001.
+    bool IsF4;
+} NvBootSwRsaKeySlot;
+
+static NvBootSwRsaKeySlot s_SwRsaKeySlots[NVBOOT_SW_RSA_NUM_KEY_SLOTS];
+
+/* Working storage of the exponentiation; the CIOS accumulator is 2 longer. */
+static NvU32 s_MontBase[NVBOOT_SW_RSA_MAX_MODULUS_SIZE_WORDS];
+static NvU32 s_MontAcc[NVBOOT_SW_RSA_MAX_MODULUS_SIZE_WORDS];
+static NvU32 s_MontTmp[NVBOOT_SW_RSA_MAX_MODULUS_SIZE_WORDS + 2];
+
+/* A >= B for NumWords word little-endian integers. */
+static bool BigIntGe(const NvU32 *A, const NvU32 *B, NvU32 NumWords)
+{
+    NvU32 i;
+
+    for (i = NumWords; i > 0; i--)
+    {
+        if (A[i - 1] != B[i - 1])
+            return A[i - 1] > B[i - 1];
+    }
+    return true;
+}
+
+/* A -= B, returning the borrow. */
+static NvU32 BigIntSub(NvU32 *A, const NvU32 *B, NvU32 NumWords)
+{
+    NvU64 Diff;
+    NvU32 Borrow = 0;
+    NvU32 i;
+
+    for (i = 0; i < NumWords; i++)
+    {
+        Diff = (NvU64)A[i] - B[i] - Borrow;
+        A[i] = (NvU32)Diff;
+        Borrow = (NvU32)(Diff >> 32) & 1;
+    }
+    return Borrow;
+}
+
+/*
+ * Result = A * B * R^-1 mod n, CIOS method. Result may alias A or B.
+ * A and B must be smaller than n.
+ */
+static void MontMul(NvU32 *Result,
+                    const NvU32 *A,
+                    const NvU32 *B,
+                    const NvBootSwRsaKeySlot *Slot)
+{
+    const NvU32 *N = Slot->Modulus;
+    const NvU32 s = Slot->NumWords;
+    NvU32 *t = s_MontTmp;
+    NvU64 Sum;
+    NvU32 Carry;
+    NvU32 m;
+    NvU32 i;
+    NvU32 j;
+
+    for (j = 0; j < s + 2; j++)
+        t[j] = 0;
+
+    for (i = 0; i < s; i++)
+    {
+        // t += A * B[i]
+        Carry = 0;
+        for (j = 0; j < s; j++)
+        {
+            Sum = (NvU64)A[j] * B[i] + t[j] + Carry;
+            t[j] = (NvU32)Sum;
+            Carry = (NvU32)(Sum >> 32);
+        }
+        Sum = (NvU64)t[s] + Carry;
+        t[s] = (NvU32)Sum;
+        t[s + 1] = (NvU32)(Sum >> 32);
+
+        // t = (t + m * N) / 2^32, with m chosen so the low word is zero.
+        m = t[0] * Slot->N0Inv;
+        Sum = (NvU64)m * N[0] + t[0];
+        Carry = (NvU32)(Sum >> 32);
+        for (j = 1; j < s; j++)
+        {
+            Sum = (NvU64)m * N[j] + t[j] + Carry;
+            t[j - 1] = (NvU32)Sum;
+            Carry = (NvU32)(Sum >> 32);
+        }
+        Sum = (NvU64)t[s] + Carry;
+        t[s - 1] = (NvU32)Sum;
+        t[s] = t[s + 1] + (NvU32)(Sum >> 32);
+    }
+
+    // t < 2n here; one conditional subtraction brings it below n.
+    if ((t[s] != 0) || BigIntGe(t, N, s))
+        BigIntSub(t, N, s);
+
+    for (j = 0; j < s; j++)
+        Result[j] = t[j];
+}
+
+/* -N0^-1 mod 2^32 by Newton iteration; each step doubles the valid bits. */
+static NvU32 ComputeN0Inv(NvU32 N0)
+{
+    NvU32 Inv = N0; // Valid to 3 bits for odd N0.
+    NvU32 i;
+
+    for (i = 0; i < 4; i++)
+        Inv *= 2 - N0 * Inv;
+
+    return (NvU32)0 - Inv;
+}
+
+/*
+ * R^2 mod n. Start from R mod n = R - n (n has its top bit set) and double
+ * it modulo n another 32 * NumWords times.
+ */
+static void ComputeR2(NvBootSwRsaKeySlot *Slot)
+{
+    const NvU32 s = Slot->NumWords;
+    NvU32 *R2 = Slot->R2;
+    NvU32 Top;
+    NvU32 i;
+    NvU32 j;
+
+    for (j = 0; j < s; j++)
+        R2[j] = 0;
+    BigIntSub(R2, Slot->Modulus, s);
+
+    for (i = 0; i < 32 * s; i++)
+    {
+        Top = R2[s - 1] >> 31;
+        for (j = s - 1; j > 0; j--)
+            R2[j] = (R2[j] << 1) | (R2[j - 1] >> 31);
+        R2[0] <<= 1;
+
+        if ((Top != 0) || BigIntGe(R2, Slot->Modulus, s))
+            BigIntSub(R2, Slot->Modulus, s);
+    }
+}
+
+NvBootError NvBootSwRsaDevInit(void)
+{
+    NvBootUtilMemset(s_SwRsaKeySlots, 0, sizeof(s_SwRsaKeySlots));
+
+    return NvBootError_Success;
+}
+
+uint8_t NvBootSwRsaDevNumKeySlots(void)
+{
+    return (uint8_t) NVBOOT_SW_RSA_NUM_KEY_SLOTS;
+}
+
+bool NvBootSwRsaDevIsValidKeySlot(uint8_t KeySlot)
+{
+    if(KeySlot < NvBootSwRsaDevNumKeySlots())
+        return true;
+    else
+        return false;
+}
+
+bool NvBootSwRsaDevIsValidKeySize(NvBootCryptoRsaKeySize KeySize)
+{
+    if((KeySize == RSA_KEY_2048) || (KeySize == RSA_KEY_3072))
+        return true;
+    else
+        return false;
+}
+
+NvBootError NvBootSwRsaDevGetKey(NvBootCryptoRsaKey *Key,
+                                 const uint8_t KeySlot,
+                                 const NvBootCryptoRsaKeySize KeySize)
+{
+    NvBootCryptoRsaKey3072NvU32 *KeyData;
+    NvBootSwRsaKeySlot *Slot;
+
+    if(NvBootSwRsaDevIsValidKeySlot(KeySlot) == false)
+        return NvBootError_InvalidSeKeySlotNum;
+
+    Slot = &s_SwRsaKeySlots[KeySlot];
+    if((NvBootSwRsaDevIsValidKeySize(KeySize) == false) ||
+       (Slot->KeySize != KeySize))
+        return NvBootError_InvalidSeKeySize;
+
+    // Exponent follows a KeySize modulus, see NvBootSwRsaDevSetKey().
+    KeyData = (NvBootCryptoRsaKey3072NvU32 *)&Key->KeyData;
+    NvBootUtilMemcpy(KeyData->Modulus, Slot->Modulus, KeySize / 8);
+    NvBootUtilMemcpy(&KeyData->Modulus[Slot->NumWords], Slot->Exponent, KeySize / 8);
+
+    Key->KeySize = KeySize;
+
+    return NvBootError_Success;
+}
+
+/* Is Key (modulus followed by exponent) the key loaded in Slot? */
+static bool IsResidentKey(const NvBootSwRsaKeySlot *Slot,
+                          NvBootCryptoRsaKeySize KeySize,
+                          const NvU32 *Key)
+{
+    NvU32 i;
+
+    if(Slot->KeySize != KeySize)
+        return false;
+
+    for(i = 0; i < Slot->NumWords; i++)
+    {
+        if((Slot->Modulus[i] != Key[i]) ||
+           (Slot->Exponent[i] != Key[Slot->NumWords + i]))
+            return false;
+    }
+
+    return true;
+}
+
+NvBootError NvBootSwRsaDevSetKey(const NvBootCryptoRsaKey *Key,
+                                 const uint8_t KeySlot)
+{
+    const NvBootCryptoRsaKey3072NvU32 *KeyData;
+    NvBootSwRsaKeySlot *Slot;
+    NvU32 NumWords;
+    NvU32 i;
+
+    if(NvBootSwRsaDevIsValidKeySlot(KeySlot) == false)
+        return NvBootError_InvalidSeKeySlotNum;
+
+    if(NvBootSwRsaDevIsValidKeySize(Key->KeySize) == false)
+        return NvBootError_InvalidSeKeySize;
+
+    // The modulus and exponent are both KeySize bits long and stored back to
+    // back, as in the NvBootCryptoRsaKey2048NvU32 and
+    // NvBootCryptoRsaKey3072NvU32 layouts.
+    KeyData = (const NvBootCryptoRsaKey3072NvU32 *)&Key->KeyData;
+    NumWords = Key->KeySize / 32;
+
+    if(((KeyData->Modulus[0] & 1) == 0) ||
+       ((KeyData->Modulus[NumWords - 1] >> 31) == 0))
+        return NvBootError_IllegalParameter;
+
+    Slot = &s_SwRsaKeySlots[KeySlot];
+
+    // Reloading the key already resident in the slot keeps its Montgomery
+    // constants, so verifying many images with one key computes R^2 once.
+    if(IsResidentKey(Slot, Key->KeySize, KeyData->Modulus))
+        return NvBootError_Success;
+
+    Slot->KeySize = RSA_KEY_INVALID;
+    Slot->NumWords = NumWords;
+    NvBootUtilMemcpy(Slot->Modulus, KeyData->Modulus, NumWords * 4);
+    NvBootUtilMemcpy(Slot->Exponent, &KeyData->Modulus[NumWords], NumWords * 4);
+
+    Slot->IsF4 = (Slot->Exponent[0] == NVBOOT_RSA_DEFAULT_PUBLIC_EXPONENT);
+    for(i = 1; i < NumWords; i++)
+    {
+        if(Slot->Exponent[i] != 0)
+            Slot->IsF4 = false;
+    }
+
+    Slot->N0Inv = ComputeN0Inv(Slot->Modulus[0]);
+    ComputeR2(Slot);
+    Slot->KeySize = Key->KeySize;
+
+    return NvBootError_Success;
+}
+
+NvBootError NvBootSwRsaDevModularExponentiation(const uint32_t *Base,
+                                                uint32_t *Result,
+                                                const uint8_t KeySlot,
+                                                const NvBootCryptoRsaKeySize KeySize)
+{
+    NvBootSwRsaKeySlot *Slot;
+    NvU32 NumWords;
+    NvU32 Bit;
+    NvU32 i;
+
+    if(NvBootSwRsaDevIsValidKeySlot(KeySlot) == false)
+        return NvBootError_InvalidSeKeySlotNum;
+
+    Slot = &s_SwRsaKeySlots[KeySlot];
+    if((NvBootSwRsaDevIsValidKeySize(KeySize) == false) ||
+       (Slot->KeySize != KeySize))
+        return NvBootError_InvalidSeKeySize;
+
+    NumWords = Slot->NumWords;
+
+    // Base * R mod n.
+    MontMul(s_MontBase, Base, Slot->R2, Slot);
+
+    if(Slot->IsF4)
+    {
+        // (Base^(2^16) * R) * Base * R^-1 = Base^0x10001 mod n.
+        MontMul(s_MontAcc, s_MontBase, s_MontBase, Slot);
+        for(i = 1; i < 16; i++)
+            MontMul(s_MontAcc, s_MontAcc, s_MontAcc, Slot);
+        MontMul(Result, s_MontAcc, Base, Slot);
+        return NvBootError_Success;
+    }
+
+    // Skip to the top set bit of the exponent, which seeds the accumulator.
+    for(Bit = 32 * NumWords; Bit > 0; Bit--)
+    {
+        if((Slot->Exponent[(Bit - 1) / 32] >> ((Bit - 1) % 32)) & 1)
+            break;
+    }
+
+    if(Bit == 0)
+    {
+        // Base^0 = 1.
+        for(i = 0; i < NumWords; i++)
+            Result[i] = 0;
+        Result[0] = 1;
+        return NvBootError_Success;
+    }
+
+    NvBootUtilMemcpy(s_MontAcc, s_MontBase, NumWords * 4);
+    for(Bit--; Bit > 0; Bit--)
+    {
+        MontMul(s_MontAcc, s_MontAcc, s_MontAcc, Slot);
+        if((Slot->Exponent[(Bit - 1) / 32] >> ((Bit - 1) % 32)) & 1)
+            MontMul(s_MontAcc, s_MontAcc, s_MontBase, Slot);
+    }
+
+    // Multiplying by 1 takes the accumulator out of Montgomery form.
+    for(i = 0; i < NumWords; i++)
+        s_MontBase[i] = 0;
+    s_MontBase[0] = 1;
+    MontMul(Result, s_MontAcc, s_MontBase, Slot);
+
+    return NvBootError_Success;
+}
+
+bool NvBootSwRsaDevIsEngineBusy(void)
+{
+    return false;
+}
+
+void NvBootSwRsaDevShutdown(void)
+{
+    NvBootUtilMemset(s_SwRsaKeySlots, 0, sizeof(s_SwRsaKeySlots));
+}
@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * nvboot_sw_sha_dev.c - Software SHA-2 (FIPS 180-4) device for the SHA
+ * device manager.
+ *
+ * The compression functions keep a 16 entry rolling message schedule and
+ * are unrolled eight rounds at a time, so the working variables rotate by
+ * renaming instead of by copies. Blocks are loaded a word at a time when
+ * the input is word aligned, which is the case for every caller in the
+ * boot flow.
+ *
+ * Only built when NVENABLE_SW_SHA_SUPPORT=1 and the sw_sha core library is
+ * enabled; otherwise the NvBootShaDevice_SW slot stays empty.
+ */
+
+#include <stdbool.h>
+#include "nvtypes.h"
+#include "nvboot_error.h"
+#include "nvboot_sw_sha_dev_int.h"
+#include "nvboot_crypto_sha_param.h"
+#include "nvboot_util_int.h"
+
+#define SHA256_BLOCK_BYTES 64
+#define SHA512_BLOCK_BYTES 128
+
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define ROTR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+#define CH(x, y, z)  (((x) & ((y) ^ (z))) ^ (z))
+#define MAJ(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+
+#define SHA256_S0(x) (ROTR32(x, 2)  ^ ROTR32(x, 13) ^ ROTR32(x, 22))
+#define SHA256_S1(x) (ROTR32(x, 6)  ^ ROTR32(x, 11) ^ ROTR32(x, 25))
+#define SHA256_s0(x) (ROTR32(x, 7)  ^ ROTR32(x, 18) ^ ((x) >> 3))
+#define SHA256_s1(x) (ROTR32(x, 17) ^ ROTR32(x, 19) ^ ((x) >> 10))
+
+#define SHA512_S0(x) (ROTR64(x, 28) ^ ROTR64(x, 34) ^ ROTR64(x, 39))
+#define SHA512_S1(x) (ROTR64(x, 14) ^ ROTR64(x, 18) ^ ROTR64(x, 41))
+#define SHA512_s0(x) (ROTR64(x, 1)  ^ ROTR64(x, 8)  ^ ((x) >> 7))
+#define SHA512_s1(x) (ROTR64(x, 19) ^ ROTR64(x, 61) ^ ((x) >> 6))
+
+/* Next entry of the rolling message schedule, for rounds 16 and up. */
+#define SCHEDULE(W, i, s0, s1) \
+    (W[(i) & 15] += s1(W[((i) - 2) & 15]) + W[((i) - 7) & 15] + \
+                    s0(W[((i) - 15) & 15]))
+
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, k, w)                      \
+    do {                                                                \
+        T1 = (h) + SHA256_S1(e) + CH(e, f, g) + (k) + (w);              \
+        (d) += T1;                                                      \
+        (h) = T1 + SHA256_S0(a) + MAJ(a, b, c);                         \
+    } while (0)
+
+#define SHA512_ROUND(a, b, c, d, e, f, g, h, k, w)                      \
+    do {                                                                \
+        T1 = (h) + SHA512_S1(e) + CH(e, f, g) + (k) + (w);              \
+        (d) += T1;                                                      \
+        (h) = T1 + SHA512_S0(a) + MAJ(a, b, c);                         \
+    } while (0)
+
+/* Eight rounds starting at round i, Wt(j) yielding the schedule word. */
+#define SHA256_8ROUNDS(i, Wt)                                           \
+    do {                                                                \
+        SHA256_ROUND(a, b, c, d, e, f, g, h, s_Sha256K[(i) + 0], Wt((i) + 0)); \
+        SHA256_ROUND(h, a, b, c, d, e, f, g, s_Sha256K[(i) + 1], Wt((i) + 1)); \
+        SHA256_ROUND(g, h, a, b, c, d, e, f, s_Sha256K[(i) + 2], Wt((i) + 2)); \
+        SHA256_ROUND(f, g, h, a, b, c, d, e, s_Sha256K[(i) + 3], Wt((i) + 3)); \
+        SHA256_ROUND(e, f, g, h, a, b, c, d, s_Sha256K[(i) + 4], Wt((i) + 4)); \
+        SHA256_ROUND(d, e, f, g, h, a, b, c, s_Sha256K[(i) + 5], Wt((i) + 5)); \
+        SHA256_ROUND(c, d, e, f, g, h, a, b, s_Sha256K[(i) + 6], Wt((i) + 6)); \
+        SHA256_ROUND(b, c, d, e, f, g, h, a, s_Sha256K[(i) + 7], Wt((i) + 7)); \
+    } while (0)
+
+#define SHA512_8ROUNDS(i, Wt)                                           \
+    do {                                                                \
+        SHA512_ROUND(a, b, c, d, e, f, g, h, s_Sha512K[(i) + 0], Wt((i) + 0)); \
+        SHA512_ROUND(h, a, b, c, d, e, f, g, s_Sha512K[(i) + 1], Wt((i) + 1)); \
+        SHA512_ROUND(g, h, a, b, c, d, e, f, s_Sha512K[(i) + 2], Wt((i) + 2)); \
+        SHA512_ROUND(f, g, h, a, b, c, d, e, s_Sha512K[(i) + 3], Wt((i) + 3)); \
+        SHA512_ROUND(e, f, g, h, a, b, c, d, s_Sha512K[(i) + 4], Wt((i) + 4)); \
+        SHA512_ROUND(d, e, f, g, h, a, b, c, s_Sha512K[(i) + 5], Wt((i) + 5)); \
+        SHA512_ROUND(c, d, e, f, g, h, a, b, s_Sha512K[(i) + 6], Wt((i) + 6)); \
+        SHA512_ROUND(b, c, d, e, f, g, h, a, s_Sha512K[(i) + 7], Wt((i) + 7)); \
+    } while (0)
+
+#define SHA256_W_LOAD(i)  (W[i])
+#define SHA256_W_NEXT(i)  SCHEDULE(W, i, SHA256_s0, SHA256_s1)
+#define SHA512_W_LOAD(i)  (W[i])
+#define SHA512_W_NEXT(i)  SCHEDULE(W, i, SHA512_s0, SHA512_s1)
+
+static const NvU32 s_Sha256K[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static const NvU64 s_Sha512K[80] =
+{
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+static const NvU32 s_Sha256Iv[8] =
+{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+static const NvU64 s_Sha384Iv[8] =
+{
+    0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL, 0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+    0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL, 0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL,
+};
+
+static const NvU64 s_Sha512Iv[8] =
+{
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL,
+};
+
+static NvU32 LoadBe32(const uint8_t *p)
+{
+    return ((NvU32)p[0] << 24) | ((NvU32)p[1] << 16) |
+           ((NvU32)p[2] << 8)  |  (NvU32)p[3];
+}
+
+static void StoreBe32(uint8_t *p, NvU32 x)
+{
+    p[0] = (uint8_t)(x >> 24);
+    p[1] = (uint8_t)(x >> 16);
+    p[2] = (uint8_t)(x >> 8);
+    p[3] = (uint8_t)x;
+}
+
+/*
+ * Load the 16 big-endian words of a block. Aligned blocks take one word
+ * load and a byte reverse per word (the cores are little-endian).
+ */
+static void LoadBlock32(NvU32 *W, const uint8_t *Block)
+{
+    NvU32 i;
+
+    if (((uintptr_t)Block & 3) == 0)
+    {
+        const NvU32 *Words = (const NvU32 *)Block;
+
+        for (i = 0; i < 16; i++)
+            W[i] = __builtin_bswap32(Words[i]);
+    }
+    else
+    {
+        for (i = 0; i < 16; i++)
+            W[i] = LoadBe32(&Block[4 * i]);
+    }
+}
+
+static void Sha256Block(NvU32 *State, const uint8_t *Block)
+{
+    NvU32 W[16];
+    NvU32 a, b, c, d, e, f, g, h;
+    NvU32 T1;
+
+    LoadBlock32(W, Block);
+
+    a = State[0]; b = State[1]; c = State[2]; d = State[3];
+    e = State[4]; f = State[5]; g = State[6]; h = State[7];
+
+    SHA256_8ROUNDS(0,  SHA256_W_LOAD);
+    SHA256_8ROUNDS(8,  SHA256_W_LOAD);
+    SHA256_8ROUNDS(16, SHA256_W_NEXT);
+    SHA256_8ROUNDS(24, SHA256_W_NEXT);
+    SHA256_8ROUNDS(32, SHA256_W_NEXT);
+    SHA256_8ROUNDS(40, SHA256_W_NEXT);
+    SHA256_8ROUNDS(48, SHA256_W_NEXT);
+    SHA256_8ROUNDS(56, SHA256_W_NEXT);
+
+    State[0] += a; State[1] += b; State[2] += c; State[3] += d;
+    State[4] += e; State[5] += f; State[6] += g; State[7] += h;
+}
+
+static void Sha512Block(NvU64 *State, const uint8_t *Block)
+{
+    NvU32 Half[32];
+    NvU64 W[16];
+    NvU64 a, b, c, d, e, f, g, h;
+    NvU64 T1;
+    NvU32 i;
+
+    /* Two 16 word loads give the 16 big-endian doublewords. */
+    LoadBlock32(&Half[0], Block);
+    LoadBlock32(&Half[16], Block + SHA256_BLOCK_BYTES);
+    for (i = 0; i < 16; i++)
+        W[i] = ((NvU64)Half[2 * i] << 32) | Half[2 * i + 1];
+
+    a = State[0]; b = State[1]; c = State[2]; d = State[3];
+    e = State[4]; f = State[5]; g = State[6]; h = State[7];
+
+    SHA512_8ROUNDS(0,  SHA512_W_LOAD);
+    SHA512_8ROUNDS(8,  SHA512_W_LOAD);
+    for (i = 16; i < 80; i += 16)
+    {
+        SHA512_8ROUNDS(i,     SHA512_W_NEXT);
+        SHA512_8ROUNDS(i + 8, SHA512_W_NEXT);
+    }
+
+    State[0] += a; State[1] += b; State[2] += c; State[3] += d;
+    State[4] += e; State[5] += f; State[6] += g; State[7] += h;
+}
+
+/*
+ * Hash the message, then pad the remainder into one or two final blocks:
+ * 0x80, zeros, and the bit length in the last 8 (SHA-256) or 16 (SHA-512)
+ * bytes. The length is at most 2^35 bits, so only the low 8 bytes of the
+ * length field are non-zero.
+ */
+static void Sha256(const uint8_t *Message, NvU32 Length, uint8_t *Digest)
+{
+    uint8_t Tail[2 * SHA256_BLOCK_BYTES];
+    NvU32 State[8];
+    NvU32 Rest;
+    NvU32 TailBytes;
+    NvU64 Bits = (NvU64)Length * 8;
+    NvU32 i;
+
+    for (i = 0; i < 8; i++)
+        State[i] = s_Sha256Iv[i];
+
+    for (; Length >= SHA256_BLOCK_BYTES; Length -= SHA256_BLOCK_BYTES)
+    {
+        Sha256Block(State, Message);
+        Message += SHA256_BLOCK_BYTES;
+    }
+
+    Rest = Length;
+    TailBytes = (Rest < SHA256_BLOCK_BYTES - 8) ? SHA256_BLOCK_BYTES :
+                                                  2 * SHA256_BLOCK_BYTES;
+    NvBootUtilMemset(Tail, 0, TailBytes);
+    NvBootUtilMemcpy(Tail, Message, Rest);
+    Tail[Rest] = 0x80;
+    StoreBe32(&Tail[TailBytes - 8], (NvU32)(Bits >> 32));
+    StoreBe32(&Tail[TailBytes - 4], (NvU32)Bits);
+
+    for (i = 0; i < TailBytes; i += SHA256_BLOCK_BYTES)
+        Sha256Block(State, &Tail[i]);
+
+    for (i = 0; i < 8; i++)
+        StoreBe32(&Digest[4 * i], State[i]);
+}
+
+static void Sha512(const uint8_t *Message, NvU32 Length, uint8_t *Digest,
+                   const NvU64 *Iv, NvU32 DigestBytes)
+{
+    uint8_t Tail[2 * SHA512_BLOCK_BYTES];
+    NvU64 State[8];
+    NvU32 Rest;
+    NvU32 TailBytes;
+    NvU64 Bits = (NvU64)Length * 8;
+    NvU32 i;
+
+    for (i = 0; i < 8; i++)
+        State[i] = Iv[i];
+
+    for (; Length >= SHA512_BLOCK_BYTES; Length -= SHA512_BLOCK_BYTES)
+    {
+        Sha512Block(State, Message);
+        Message += SHA512_BLOCK_BYTES;
+    }
+
+    Rest = Length;
+    TailBytes = (Rest < SHA512_BLOCK_BYTES - 16) ? SHA512_BLOCK_BYTES :
+                                                   2 * SHA512_BLOCK_BYTES;
+    NvBootUtilMemset(Tail, 0, TailBytes);
+    NvBootUtilMemcpy(Tail, Message, Rest);
+    Tail[Rest] = 0x80;
+    StoreBe32(&Tail[TailBytes - 8], (NvU32)(Bits >> 32));
+    StoreBe32(&Tail[TailBytes - 4], (NvU32)Bits);
+
+    for (i = 0; i < TailBytes; i += SHA512_BLOCK_BYTES)
+        Sha512Block(State, &Tail[i]);
+
+    for (i = 0; i < DigestBytes / 8; i++)
+    {
+        StoreBe32(&Digest[8 * i],     (NvU32)(State[i] >> 32));
+        StoreBe32(&Digest[8 * i + 4], (NvU32)State[i]);
+    }
+}
+
+NvBootError NvBootSwShaDevInit(NvBootCryptoShaConfig *ShaConfig)
+{
+    ShaConfig->ShaDigestSize = SHA_256;
+    ShaConfig->ShaFamily = SHA2;
+
+    return NvBootError_Success;
+}
+
+NvBootCryptoShaFamily NvBootSwShaGetShaFamily(NvBootCryptoShaConfig *ShaConfig)
+{
+    return ShaConfig->ShaFamily;
+}
+
+bool NvBootSwShaSetShaFamily(NvBootCryptoShaConfig *ShaConfig, NvBootCryptoShaFamily ShaFamily)
+{
+    if (NvBootSwShaIsValidShaFamily(ShaFamily) == false)
+        return false;
+
+    ShaConfig->ShaFamily = ShaFamily;
+    return true;
+}
+
+NvBootCryptoShaDigestSize NvBootSwShaGetDigestSize(NvBootCryptoShaConfig *ShaConfig)
+{
+    return ShaConfig->ShaDigestSize;
+}
+
+bool NvBootSwShaSetShaDigestSize(NvBootCryptoShaConfig *ShaConfig, NvBootCryptoShaDigestSize DigestSize)
+{
+    if (NvBootSwShaIsValidShaDigestSize(DigestSize) == false)
+        return false;
+
+    ShaConfig->ShaDigestSize = DigestSize;
+    return true;
+}
+
+bool NvBootSwShaIsValidShaFamily(NvBootCryptoShaFamily ShaFamily)
+{
+    switch(ShaFamily)
+    {
+        case SHA2:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool NvBootSwShaIsValidShaDigestSize(NvBootCryptoShaDigestSize DigestSize)
+{
+    switch(DigestSize)
+    {
+        case SHA_256:
+        case SHA_384:
+        case SHA_512:
+            return true;
+        default:
+            return false;
+    }
+}
+
+NvBootError NvBootSwShaDevShaHash(const uint32_t *InputMessage, uint32_t InputMessageLength, uint32_t *Hash, NvBootCryptoShaConfig *ShaConfig)
+{
+    const uint8_t *Message = (const uint8_t *)InputMessage;
+    uint8_t *Digest = (uint8_t *)Hash;
+
+    if(NvBootSwShaIsValidShaFamily(ShaConfig->ShaFamily) == false)
+        return NvBootError_Unsupported_SHA_Family;
+
+    if(NvBootSwShaIsValidShaDigestSize(ShaConfig->ShaDigestSize) == false)
+        return NvBootError_Unsupported_SHA_DigestSize;
+
+    switch(ShaConfig->ShaDigestSize)
+    {
+        case SHA_384:
+            Sha512(Message, InputMessageLength, Digest, s_Sha384Iv, SHA_384 / 8);
+            break;
+        case SHA_512:
+            Sha512(Message, InputMessageLength, Digest, s_Sha512Iv, SHA_512 / 8);
+            break;
+        default:
+            Sha256(Message, InputMessageLength, Digest);
+            break;
+    }
+
+    return NvBootError_Success;
+}
+
+/**
+ *  Shutdown the SHA device and clean up state.
+ */
+void NvBootSwShaDeviceShutdown(void)
+{
+    return;
+}
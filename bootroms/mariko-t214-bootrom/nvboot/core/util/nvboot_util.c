@@ -188,10 +188,60 @@ NvBool NvBootUtilCompareBytes(NvU8 *Value1, NvU8 *Value2, NvU32 ValueSizeBytes)
     return NV_TRUE;
 }
 
-FI_bool __attribute__((optimize("O0"))) NvBootUtilCompareConstTimeFI(const void *Buffer1, const void *Buffer2, size_t length)
+/*
+ * OR together the XOR of every byte of the two buffers. When both buffers
+ * are 32-bit aligned they are compared a word at a time and the tail byte
+ * by byte, else byte by byte. The choice depends on the addresses only, so
+ * the run time for a given length and alignment does not depend on the data.
+ *
+ * pCompared is incremented for every byte compared, apart from the loop
+ * indexes. It is volatile so that the compiler can neither fold it into the
+ * loops nor drop the callers' check that it ended up at length.
+ */
+static uint32_t
+CompareConstTimeDiff(
+    const void *Buffer1,
+    const void *Buffer2,
+    size_t length,
+    volatile size_t *pCompared)
+{
+    const uint8_t *Buf1 = (const uint8_t *) Buffer1;
+    const uint8_t *Buf2 = (const uint8_t *) Buffer2;
+    uint32_t result = 0;
+    size_t i = 0;
+
+    *pCompared = 0;
+
+    if ((((uintptr_t)Buf1 | (uintptr_t)Buf2) & 3) == 0)
+    {
+        const uint32_t *Word1 = (const uint32_t *) Buf1;
+        const uint32_t *Word2 = (const uint32_t *) Buf2;
+        size_t Words = length / sizeof(uint32_t);
+        size_t w;
+
+        for (w = 0; w < Words; w++)
+        {
+            result |= Word1[w] ^ Word2[w];
+            *pCompared += sizeof(uint32_t);
+        }
+        i = Words * sizeof(uint32_t);
+    }
+
+    for (; i < length; i++)
+    {
+        result |= Buf1[i] ^ Buf2[i];
+        *pCompared += 1;
+    }
+
+    return result;
+}
+
+FI_bool NvBootUtilCompareConstTimeFI(const void *Buffer1, const void *Buffer2, size_t length)
 {
     const uint8_t *Buf1 = (const uint8_t *) Buffer1;
     const uint8_t *Buf2 = (const uint8_t *) Buffer2;
+    volatile size_t Compared = 0;
+    volatile uint32_t result;
 
 #if 1
     NV_WRITE32(0x7000e400 + 0x2f0, (uint32_t) Buf2);
@@ -204,43 +254,39 @@ FI_bool __attribute__((optimize("O0"))) NvBootUtilCompareConstTimeFI(const void
     if(length == 0)
         return FI_FALSE;
 
-    uint8_t result = 0;
-    uint32_t i;
+    result = CompareConstTimeDiff(Buf1, Buf2, length, &Compared);
 
-    for (i = 0; i < length; i++)
-    {
-        result |= Buf1[i] ^ Buf2[i];
-    }
-    // FI enhancement. Double check that loop actually looped the proper number
-    // of times. Requires optimization level O0 or else compilier will optimize it out.
-    if(i != length)
+    // FI enhancement. Double check that every byte was actually compared,
+    // and test the result twice, so that one skipped instruction cannot turn
+    // a mismatch into FI_TRUE. Compared and result are volatile, so each
+    // test reloads them and none is optimized out.
+    if(Compared != length)
         return FI_FALSE;
 
-    // If result is 0, Buffer1 and Buffer 2 are identical, return true.
-    // Otherwise, return false.
-    return (result == 0) ? FI_TRUE : FI_FALSE;
+    if(result != 0)
+        return FI_FALSE;
+
+    if((Compared == length) && (result == 0))
+        return FI_TRUE;
+
+    return FI_FALSE;
 }
 
 bool NvBootUtilCompareConstTime(const void *Buffer1, const void *Buffer2, size_t length)
 {
-    const uint8_t *Buf1 = (const uint8_t *) Buffer1;
-    const uint8_t *Buf2 = (const uint8_t *) Buffer2;
+    volatile size_t Compared = 0;
+    uint32_t result;
 
     // length = 0 should not return true, in case a malicious actor can
     // manipulate the input parameter prior to the function call.
     if(length == 0)
         return false;
 
-    uint8_t result = 0;
-
-    for (uint32_t i = 0; i < length; i++)
-    {
-        result |= Buf1[i] ^ Buf2[i];
-    }
+    result = CompareConstTimeDiff(Buffer1, Buffer2, length, &Compared);
 
     // If result is 0, Buffer1 and Buffer 2 are identical, return true.
     // Otherwise, return false.
-    return (result == 0) ? true : false;
+    return ((result == 0) && (Compared == length)) ? true : false;
 }
 
 /**
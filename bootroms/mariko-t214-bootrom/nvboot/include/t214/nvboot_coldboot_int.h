@@ -23,10 +23,14 @@ extern "C"
 {
 #endif
 
-#define TASK_ENTRY 8
+/// sizeof(NvBootTask)
+#define TASK_ENTRY 16
 
 NvBootError NvBootColdBootInit();
-NvBootError NvBootColdBootSetupSdram();
+NvBootError NvBootColdBootSdramBegin();
+NvBootError NvBootColdBootSdramPoll();
+NvBootError NvBootColdBootSdramComplete();
+NvBootError NvBootColdBootPrefetchBl();
 NvBootError NvBootColdBootReadBct();
 NvBootError NvBootColdBootMtsInit();
 NvBootError NvBootColdBootReInit();
@@ -55,6 +55,42 @@ extern "C"
 #define NVBOOT_MAX_BUFFER_SIZE \
   (NVBOOT_BUFFER_LENGTH * NVBOOT_READER_NUM_BUFFERS)
 
+/*
+ * Configuration data for the device manager read-ahead cache.
+ *
+ * Reads that fit in the cache are widened by up to
+ * NVBOOT_DEVMGR_READ_AHEAD_PAGES pages and the data is kept in IRAM, so
+ * that a following read of the adjacent pages (e.g. the bootloader after
+ * its OEM boot binary header) is served by a copy instead of the device.
+ * The cache must hold at least two pages of the largest secondary boot
+ * device page size.
+ */
+#define NVBOOT_DEVMGR_READ_AHEAD_PAGES 8
+#define NVBOOT_DEVMGR_CACHE_SIZE \
+  (NVBOOT_MAX_SECONDARY_BOOT_DEVICE_PAGE_SIZE * 2)
+
+/*
+ * Selects the software AES implementation in nvboot_sw_aes.c.
+ * 0: byte-oriented (s_Xtime* tables, 1.5KB).
+ * 1: word-oriented T-table, one 1KB table each for encrypt and decrypt
+ *    with rotates for the other rows.
+ * The build may preset it.
+ */
+#ifndef NVBOOT_SW_AES_TTABLE
+#define NVBOOT_SW_AES_TTABLE 0
+#endif
+
+/*
+ * Set to 1 to build the software AES as a bitsliced, constant-time core
+ * that processes two blocks per pass (exclusive with NVBOOT_SW_AES_TTABLE).
+ * Slower per single block, but free of data-dependent table lookups. The
+ * key schedule buffer then holds the bitsliced round keys, built once by
+ * NvAesExpandKey().
+ */
+#ifndef NVBOOT_SW_AES_CT
+#define NVBOOT_SW_AES_CT 0
+#endif
+
 #define NVBOOT_DEFAULT_BOOT_DEVICE NvBootFuseBootDevice_Sdmmc;
 
 #if defined(__cplusplus)
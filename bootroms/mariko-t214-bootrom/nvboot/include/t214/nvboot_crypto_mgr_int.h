@@ -48,6 +48,13 @@ typedef enum
 
 static const uint8_t CRYPTOMGR_RSA_PUBLIC_KEY_SLOT = 0;
 
+/**
+ * Chunk size of NvBootCryptoMgrAuthDecryptBlPackage(). A multiple of the
+ * SHA-256 and AES block sizes, and small enough for a single SE linked
+ * list buffer.
+ */
+enum {NVBOOT_CRYPTO_BL_PIPELINE_CHUNK_BYTES = 64 * 1024};
+
 typedef struct NvBootCryptoMgrBuffersRec
 {
     uint32_t FusePcpHashBuf[NVBOOT_SHA256_LENGTH_WORDS];
@@ -55,6 +62,7 @@ typedef struct NvBootCryptoMgrBuffersRec
     NvBootCryptoRsaSsaPssContext RsaPssContext;
     NvBootSha256HashDigest OemBootBinaryHash;
     NvBootSha256HashDigest Calculated_BlHash;
+    NvBootSha256HashDigest Calculated_RcmHash;
     NvBootAesDeviceCmacContext AesCmacContext;
     uint32_t AesCmacHashResult[NVBOOT_AES_BLOCK_LENGTH_WORDS];
     uint32_t CmacK1[NVBOOT_AES_BLOCK_LENGTH_WORDS];
@@ -71,6 +79,18 @@ typedef enum
     OEM_HEADER_FORCE32 = 0x7FFFFFFF,
 } OemHeaderEnum;
 
+// State of the RCM message hash computed while the message is received.
+// Random 32-bit integers instead of bool, as a fault injection
+// countermeasure.
+typedef enum
+{
+    RCM_HASH_NONE = 0x4B1D62E3,
+    RCM_HASH_STREAMING = 0x5C93A70D,
+    RCM_HASH_DONE = 0x63E8D4B9,
+
+    RCM_HASH_FORCE32 = 0x7FFFFFFF,
+} RcmHashEnum;
+
 typedef struct CryptoMgrContextRec
 {
     NvU32 TaskId;
@@ -105,6 +125,11 @@ typedef struct CryptoMgrContextRec
 
 
     uint32_t IsOemBootBinaryHeaderAuthenticated;
+
+    // Hash of the RCM message computed while it is received.
+    uint32_t RcmHashState;
+    uint32_t RcmHashLength;
+    uint32_t RcmHashedBytes;
 } NvBootCryptoMgrContext __attribute__((aligned(NVBOOT_CRYPTO_BUFFER_ALIGNMENT)));
 
 /**
@@ -472,6 +497,23 @@ NvBootError NvBootCryptoMgrAuthBlPackage(const NvBootOemBootBinaryHeader *OemHea
  */
 NvBootError NvBootCryptoMgrDecryptBlPackage(const NvBootOemBootBinaryHeader *OemHeader, uint32_t *BlBinary);
 
+/**
+ * Authenticate and decrypt the BL binary on both SE instances at once.
+ * SE1 hashes the ciphertext chunk by chunk while SE2 decrypts, in place,
+ * the chunks SE1 has already hashed. If the hash does not match, the whole
+ * package is zeroed so no unauthenticated plaintext is left behind.
+ *
+ * Unencrypted and FSKP packages fall back to NvBootCryptoMgrAuthBlPackage()
+ * followed by NvBootCryptoMgrDecryptBlPackage().
+ *
+ * @param OemHeader Pointer to the NvBootOemBootBinaryHeader struct.
+ * @param BlBinary Pointer to the BL1 binary.
+ *
+ * @return NvBootError NvBootError_Success if authentication and decryption
+ *         are successful.
+ */
+NvBootError NvBootCryptoMgrAuthDecryptBlPackage(const NvBootOemBootBinaryHeader *OemHeader, uint32_t *BlBinary);
+
 /**
  * Perform authentication of the SC7 firmware using the OEM authentication key.
  * Cryptomgr automatically detects which key and authentication scheme
@@ -528,6 +570,26 @@ NvBootError NvBootCryptoMgrNvDecryptSc7Fw(const NvBinarySignHeader *NvHeader);
 
 
 
+/**
+ * Hash-while-receive for the RCM message. Start is called once the RCM
+ * header is in, Update after every USB read with the number of message
+ * bytes received so far, and Finish once the whole message is in.
+ *
+ * Update starts the SHA-256 of the signed section on SE1 over the 64-byte
+ * blocks that have arrived, without waiting for it, and skips a round if
+ * the SE is still busy. The last bytes of the message are always left to
+ * Finish, which waits for the digest. NvBootCryptoMgrOemAuthRcmPayload()
+ * then uses the digest instead of hashing the message again.
+ *
+ * Only the RSASSA-PSS scheme is streamed. In other modes the functions do
+ * nothing and authentication hashes the whole message as before.
+ */
+void NvBootCryptoMgrOemRcmHashStart(const NvBootRcmMsg *RcmMsg);
+
+void NvBootCryptoMgrOemRcmHashUpdate(const NvBootRcmMsg *RcmMsg, uint32_t BytesReceived);
+
+void NvBootCryptoMgrOemRcmHashFinish(const NvBootRcmMsg *RcmMsg);
+
 NvBootError NvBootCryptoMgrOemAuthRcmPayload(const NvBootRcmMsg *RcmMsg);
 
 NvBootError NvBootCryptoMgrOemDecryptRcmPayload(const NvBootRcmMsg *RcmMsg);
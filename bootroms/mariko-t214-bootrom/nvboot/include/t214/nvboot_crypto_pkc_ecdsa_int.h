@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+#ifndef NVBOOT_INCLUDE_T214_NVBOOT_CRYPTO_PKC_ECDSA_INT_H_
+#define NVBOOT_INCLUDE_T214_NVBOOT_CRYPTO_PKC_ECDSA_INT_H_
+
+#include <stdbool.h>
+#include "nvboot_crypto_param.h"
+#include "nvboot_crypto_ecc_param.h"
+#include "nvboot_sha_devmgr_int.h"
+#include "nvboot_util_int.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/**
+ * Context of an ECDSA verification over the NIST P-256 curve.
+ *
+ * The public key coordinates and the signature integers r and s are
+ * little-endian octet strings, the same layout as the curve parameters in
+ * EccPrimeFieldParamsP256_NIST_P256. Only the first 32 bytes of r and s in
+ * NvBootEcdsaSig are used.
+ */
+typedef struct NvBootCryptoEcdsaContextRec
+{
+    // Public key Q.
+    const NvBootEcPoint256 *PublicKey;
+    // InputMessage to be hashed
+    uint32_t *InputMessage;
+
+    // InputMessageIsHashed == true means the hash of the InputMessage has already been pre-computed.
+    bool InputMessageIsHashed;
+    uint32_t *InputMessageShaHash; // Must be a valid address if InputMessageIsHashed == true.
+
+    uint32_t InputMessageLengthBytes;
+    const NvBootEcdsaSig *InputSignature;
+} NvBootCryptoEcdsaContext;
+
+/**
+ *  This function runs an ECDSA signature verification over NIST P-256 per
+ *  FIPS 186-4 section 6.4, in software. The message digest is SHA-256,
+ *  computed with ShaDevMgr unless InputMessageIsHashed is set.
+ *
+ *  @param[in] EcdsaContext Pointer to NvBootCryptoEcdsaContext.
+ *  @param[in] ShaDevMgr Pointer to NvBootShaDevMgr, for SHA2 operations.
+ *
+ *  @return NvBootError_Success if the signature is valid.
+ *          NvBootError_IllegalParameter if the public key is not a point
+ *          on the curve.
+ *          NvBootError_CryptoMgr_Ecdsa_R_S_Out_Of_Range if r or s is not in
+ *          [1, n-1].
+ *          NvBootError_CryptoMgr_Ecdsa_Invalid_R_is_O if u1G + u2Q is the
+ *          point at infinity.
+ *          NvBootError_CryptoMgr_Ecdsa_Invalid_Sig if the signature does
+ *          not match.
+ */
+NvBootError NvBootCryptoEcdsaVerify(NvBootCryptoEcdsaContext *EcdsaContext, NvBootShaDevMgr *ShaDevMgr);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* NVBOOT_INCLUDE_T214_NVBOOT_CRYPTO_PKC_ECDSA_INT_H_ */
@@ -66,15 +66,18 @@ typedef struct NvBootCryptoRsaSsaPssContextRec
 NvBootError NvBootCryptoRsaSsaPssInit(void);
 
 /**
- * This is the mask generation function as specified in the RSASSA-PSS specification.
+ * This is the mask generation function as specified in the RSASSA-PSS
+ * specification, fused with the unmasking step: the mask is not returned,
+ * each block of it is xored with maskedDB into DB as it is generated.
  * @param[in] mgfSeed is a pointer to H.
  * @param[in] maskLen = emLen - hLen - 1.
- * @param[in] dbMaskBuffer, the output of the mask generation function.
+ * @param[in] maskedDBBuffer, maskLen bytes of maskedDB.
+ * @param[out] DBBuffer, receives maskedDB xor MGF(mgfSeed, maskLen).
  * @param[in] Pinter to a SHA device manager.
  *
  * @return NvBootError_Success if no error. Any other value, see nvboot_error.h
  */
-NvBootError NvBootCryptoRsaSsaPssMGF(uint8_t *mgfSeed, uint32_t maskLen, uint8_t *dbMaskBuffer, NvBootShaDevMgr *ShaDevMgr);
+NvBootError NvBootCryptoRsaSsaPssMGF(uint8_t *mgfSeed, uint32_t maskLen, const uint8_t *maskedDBBuffer, uint8_t *DBBuffer, NvBootShaDevMgr *ShaDevMgr);
 
 /**
  *  This function runs a RSASSA-PSS-VERIFY signature verification operation per
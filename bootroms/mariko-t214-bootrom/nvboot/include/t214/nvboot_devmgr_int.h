@@ -35,6 +35,9 @@
 #include "nvboot_usb3_int.h"
 #endif
 #include "nvboot_prod_uart_int.h"
+#if NVENABLE_HOST_FILE_SUPPORT
+#include "nvboot_host_file_int.h"
+#endif
 
 #if defined(__cplusplus)
 extern "C"
@@ -57,6 +60,9 @@ typedef union
     NvBootSpiFlashContext      SpiFlashContext;
     NvBootSataContext    SataContext;
     NvBootProdUartContext      ProdUartContext;
+#if NVENABLE_HOST_FILE_SUPPORT
+    NvBootHostFileContext      HostFileContext;
+#endif
 } NvBootDevContext;
 
 typedef struct NvBootDevMgrCallbacksRec
@@ -85,6 +91,16 @@ NvBootDevMgrCallbacks UfsDeviceCallback;
 NvBootDevMgrCallbacks FoosDeviceCallback;
 NvBootDevMgrCallbacks ProdUartDeviceCallback;
 
+/*
+ * NvBootDevMgrCache: State of the read-ahead cache.
+ */
+typedef struct NvBootDevMgrCacheRec
+{
+    NvU32                   StartPage;    /* First cached page, counted from
+                                           * block 0, page 0. */
+    NvU32                   NumBytes;     /* Valid bytes; 0 if empty. */
+} NvBootDevMgrCache;
+
 /*
  * NvBootDevMgr: State & data used by the device manager.
  */
@@ -94,6 +110,7 @@ typedef struct NvBootDevMgrRec
     NvU32                   BlockSizeLog2;
     NvU32                   PageSizeLog2;
     const NvBootDevMgrCallbacks  *Callbacks;    /* Callbacks to the chosen driver. */
+    NvBootDevMgrCache       Cache;
 } NvBootDevMgr;
 
 
@@ -122,6 +139,30 @@ NvBootDevMgrReinitDevice(NvBootDevMgr    *DevMgr,
 			 const uint8_t       ParamCount,
                          const uint8_t       DeviceStraps);
 
+/*
+ * NvBootDevMgrRead(): Read Len bytes starting at Block/Page into Dest and
+ * wait for completion. Pages held by the read-ahead cache are copied out of
+ * it; small reads refill the cache with the pages that follow them.
+ */
+NvBootError
+NvBootDevMgrRead(NvBootDevMgr *DevMgr,
+                 const NvU32   Block,
+                 const NvU32   Page,
+                 const NvU32   Len,
+                 uint8_t      *Dest);
+
+/*
+ * NvBootDevMgrPrefetch(): Fill the read-ahead cache with the pages holding
+ * Len bytes starting at Block/Page, so that a later NvBootDevMgrRead() of
+ * them is served without touching the device. Read failures only leave the
+ * cache empty; they are reported by the later read.
+ */
+NvBootError
+NvBootDevMgrPrefetch(NvBootDevMgr *DevMgr,
+                     const NvU32   Block,
+                     const NvU32   Page,
+                     const NvU32   Len);
+
 /*
  * NvBootDevMgrShutdown(): Shutdown the device and the device manager.
  */
@@ -13,6 +13,7 @@
 
 #include <nvboot_section_defs.h>
 #include <nvboot_error.h>
+#include "nvtypes.h"
 
 #if defined(__cplusplus)
 extern "C"
@@ -43,9 +44,33 @@ typedef enum {
     NvBootTaskListId_Force32=0x7FFFFFFF
 } NvBootTaskListId;
 
+/**
+ * Task dependencies for the secure dispatcher.
+ *
+ * A task whose depMask is 0 (all legacy entries) is a barrier: it starts only
+ * after every earlier task of its list has completed, which is the original
+ * in-order behavior. Otherwise depMask must include TASK_DEPS_VALID, and the
+ * task starts as soon as the tasks whose list indices are set in the low
+ * bits have completed. TASK_DEPS_NONE starts a task without waiting.
+ *
+ * A task with a pollPtr is not complete when funcPtr returns. The dispatcher
+ * runs other ready tasks and calls pollPtr between them; the task completes
+ * once pollPtr returns NvBootError_Success. NvBootError_Busy means still
+ * waiting, any other value fails the task list.
+ */
+#define TASK_DEPS_VALID     0x80000000
+#define TASK_DEPS(mask)     (TASK_DEPS_VALID | (mask))
+#define TASK_DEPS_NONE      TASK_DEPS(0)
+#define TASK_DEP(index)     (1U << (index))
+
+/// Explicit dependencies are limited to the first 31 tasks of a list.
+#define TASK_MAX_PER_LIST   31
+
 typedef struct _TaskRec {
     NvBootError (*funcPtr)();
     int checkPoint;
+    NvU32 depMask;
+    NvBootError (*pollPtr)(void);
 } NvBootTask, * NvBootTaskPtr;
 
 typedef struct _TaskListsRec {
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * nvboot_host_file_int.h - Declarations for the file-backed host device.
+ */
+
+#ifndef INCLUDED_NVBOOT_HOST_FILE_INT_H
+#define INCLUDED_NVBOOT_HOST_FILE_INT_H
+
+#include "nvtypes.h"
+#include "nvboot_error.h"
+#include "nvboot_bct.h"
+#include "nvboot_device_int.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/**
+ * Device type of the file-backed host device. It is not a BCT device type:
+ * it takes the device manager's callback slot after the last one, so
+ * NvBootColdBootReInit() rejects it as a secondary device.
+ */
+#define NvBootDevType_HostFile ((NvBootDevType)NvBootDevType_Max)
+
+/// Default geometry: 512 byte pages, 16KB blocks (same as foos).
+#define HOST_FILE_PAGESIZELOG2  9
+#define HOST_FILE_BLOCKSIZELOG2 14
+
+/// Maximum number of injected bit flips.
+#define HOST_FILE_MAX_BIT_FLIPS  16
+
+/// Maximum number of injected bad blocks.
+#define HOST_FILE_MAX_BAD_BLOCKS 16
+
+/**
+ * Parameters of the host device. They must fit in NvBootDevParams so that
+ * a BCT prepared for the host device can reinitialize it.
+ */
+typedef struct NvBootHostFileParamsRec
+{
+    NvU32 PageSizeLog2;
+    NvU32 BlockSizeLog2;
+
+    /// Fixed latency of every read, in microseconds.
+    NvU32 ReadLatencyUs;
+
+    /// Additional latency per page read, in microseconds.
+    NvU32 PageLatencyUs;
+} NvBootHostFileParams;
+
+typedef struct NvBootHostFileBitFlipRec
+{
+    NvU32 Offset;   /* Byte offset in the image. */
+    NvU32 Bit;      /* Bit within the byte, 0 - 7. */
+} NvBootHostFileBitFlip;
+
+typedef struct NvBootHostFileContextRec
+{
+    NvU32 PageSizeLog2;
+    NvU32 BlockSizeLog2;
+    NvU32 ReadLatencyUs;
+    NvU32 PageLatencyUs;
+
+    /// Time at which the pending read completes.
+    NvU64 ReadDoneUs;
+
+    /// Status reported once the pending read completes.
+    NvBootDeviceStatus ReadStatus;
+
+    /// Statistics for benchmarking.
+    NvU32 NumReads;
+    NvU64 BytesRead;
+} NvBootHostFileContext;
+
+/*
+ * Host-side setup. These are called by the host program before
+ * NvBootDevMgrInit() selects NvBootDevType_HostFile.
+ */
+
+/**
+ * NvBootHostFileOpen(): Map a storage image and set the parameters returned
+ * by NvBootHostFileGetParams(). Clears any injected faults.
+ *
+ * @param[in] Path Path of the image file
+ * @param[in] Params Geometry and latency of the device
+ *
+ * @retval NvBootError_Success The image is mapped.
+ * @retval NvBootError_DeviceNotResponding The image could not be mapped.
+ */
+NvBootError
+NvBootHostFileOpen(
+    const char *Path,
+    const NvBootHostFileParams *Params);
+
+/**
+ * NvBootHostFileClose(): Unmap the storage image.
+ */
+void
+NvBootHostFileClose(void);
+
+/**
+ * NvBootHostFileInjectBitFlip(): Flip a bit of the data returned by every
+ * later read covering the byte. The image itself is not modified.
+ *
+ * @retval NvBootError_Success The bit flip was recorded.
+ * @retval NvBootError_IllegalParameter Bit > 7 or the table is full.
+ */
+NvBootError
+NvBootHostFileInjectBitFlip(
+    const NvU32 Offset,
+    const NvU32 Bit);
+
+/**
+ * NvBootHostFileInjectBadBlock(): Make every later read touching Block
+ * complete with NvBootDeviceStatus_ReadFailure.
+ *
+ * @retval NvBootError_Success The bad block was recorded.
+ * @retval NvBootError_IllegalParameter The table is full.
+ */
+NvBootError
+NvBootHostFileInjectBadBlock(
+    const NvU32 Block);
+
+/*
+ * Device driver interface.
+ */
+void
+NvBootHostFileGetParams(
+    const NvU32 ParamIndex,
+    NvBootHostFileParams **Params);
+
+NvBool
+NvBootHostFileValidateParams(
+    const NvBootHostFileParams *Params);
+
+void
+NvBootHostFileGetBlockSizes(
+    const NvBootHostFileParams *Params,
+    NvU32 *BlockSizeLog2,
+    NvU32 *PageSizeLog2);
+
+NvBootError
+NvBootHostFileInit(
+    const NvBootHostFileParams *Params,
+    NvBootHostFileContext *pHostFileContext);
+
+NvBootError
+NvBootHostFileReadPage(
+    const NvU32 Block,
+    const NvU32 Page,
+    const NvU32 Len,
+    uint8_t *Dest);
+
+NvBootDeviceStatus
+NvBootHostFileQueryStatus(void);
+
+void
+NvBootHostFileShutdown(void);
+
+NvBootError
+NvBootHostFileGetReaderBuffersBase(
+    uint8_t** ReaderBuffersBase,
+    const NvU32 Alignment,
+    const NvU32 Bytes);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* #ifndef INCLUDED_NVBOOT_HOST_FILE_INT_H */
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * nvboot_host_rcm_int.h - Declarations for the socket-backed host RCM port.
+ */
+
+#ifndef INCLUDED_NVBOOT_HOST_RCM_INT_H
+#define INCLUDED_NVBOOT_HOST_RCM_INT_H
+
+#include "nvtypes.h"
+#include "nvboot_error.h"
+#include "nvboot_car_int.h"
+#include "nvboot_fuse.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/**
+ * Statistics kept by the host RCM port for benchmarking. Times are from
+ * CLOCK_MONOTONIC, in microseconds.
+ */
+typedef struct NvBootHostRcmStatsRec
+{
+    NvU32 NumReceives;
+    NvU64 BytesReceived;
+    NvU32 NumTransfers;
+    NvU64 BytesTransferred;
+    NvU32 NumErrors;
+
+    /// Time of the first and of the latest completed receive.
+    NvU64 FirstReceiveUs;
+    NvU64 LastReceiveUs;
+} NvBootHostRcmStats;
+
+/*
+ * Host-side setup. These are called by the host program before
+ * NvBootRCMInit() selects RCM_HOST.
+ */
+
+/**
+ * NvBootHostRcmOpen(): Connect the port to the Unix stream socket at Path,
+ * on which the RCM client listens.
+ *
+ * @retval NvBootError_Success The socket is connected.
+ * @retval NvBootError_DeviceNotResponding The socket could not be connected.
+ */
+NvBootError
+NvBootHostRcmOpen(
+    const char *Path);
+
+/**
+ * NvBootHostRcmOpenFd(): Use a connected stream socket or pipe end, e.g.
+ * one end of a socketpair() whose other end is given to the client calls
+ * below. The port takes ownership of Fd.
+ */
+NvBootError
+NvBootHostRcmOpenFd(
+    int Fd);
+
+/**
+ * NvBootHostRcmClose(): Close the port and clear the statistics.
+ */
+void
+NvBootHostRcmClose(void);
+
+/**
+ * NvBootHostRcmGetStats(): Copy out the statistics of the port.
+ */
+void
+NvBootHostRcmGetStats(
+    NvBootHostRcmStats *pStats);
+
+/*
+ * Host-side RCM client. Fd is the client end of the connection. Messages
+ * are sent as given: building and signing them is left to the caller.
+ */
+
+/**
+ * NvBootHostRcmClientReadUniqueId(): Read the ECID the Boot ROM sends
+ * once it is connected.
+ *
+ * @retval NvBootError_Success The ECID was read.
+ * @retval NvBootError_DeviceNotResponding The connection was closed.
+ */
+NvBootError
+NvBootHostRcmClientReadUniqueId(
+    int Fd,
+    NvBootECID *pUniqueId);
+
+/**
+ * NvBootHostRcmClientSendMessage(): Send an RCM message of Length bytes
+ * and wait for the response code that follows it.
+ *
+ * @retval NvBootError_Success The message was sent and *pResponse is set.
+ * @retval NvBootError_DeviceNotResponding The connection was closed.
+ */
+NvBootError
+NvBootHostRcmClientSendMessage(
+    int Fd,
+    const void *Msg,
+    NvU32 Length,
+    NvU32 *pResponse);
+
+/*
+ * RCM port interface.
+ */
+void
+NvBootHostRcmGetClockTable(
+    void **ClockTable,
+    ClockTableType *Id);
+
+NvBootError
+NvBootHostRcmInit(void);
+
+NvBootError
+NvBootHostRcmConnect(
+    uint8_t *OptionalBuffer);
+
+NvBootError
+NvBootHostRcmReceiveStart(
+    uint8_t *Buffer,
+    NvU32 Bytes);
+
+NvBootError
+NvBootHostRcmReceivePoll(
+    NvU32 *pBytesReceived,
+    NvU32 TimeoutUs,
+    uint8_t *OptionalBuffer);
+
+NvBootError
+NvBootHostRcmReceive(
+    uint8_t *Buffer,
+    NvU32 Bytes,
+    NvU32 *pBytesReceived);
+
+NvBootError
+NvBootHostRcmTransferStart(
+    uint8_t *Buffer,
+    NvU32 Bytes);
+
+NvBootError
+NvBootHostRcmTransferPoll(
+    NvU32 *pBytesTransferred,
+    NvU32 TimeoutUs,
+    uint8_t *OptionalBuffer);
+
+NvBootError
+NvBootHostRcmTransfer(
+    uint8_t *Buffer,
+    NvU32 Bytes,
+    NvU32 *pBytesTransferred);
+
+NvBootError
+NvBootHostRcmHandleError(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* #ifndef INCLUDED_NVBOOT_HOST_RCM_INT_H */
@@ -19,7 +19,10 @@
 typedef enum
 {
     RCM_USB_OTG,
-    RCM_XUSB
+    RCM_XUSB,
+#if NVENABLE_HOST_RCM_SUPPORT
+    RCM_HOST,
+#endif
 }
 NvBootRCMPortID_T;
 
@@ -22,6 +22,9 @@ extern "C"
 #include "nvboot_crypto_rsa_param.h"
 #include "nvboot_rsa_device_int.h"
 #include "nvboot_se_rsa_dev_int.h"
+#if NVENABLE_SW_RSA_SUPPORT
+#include "nvboot_sw_rsa_dev_int.h"
+#endif
 
 #if defined(__cplusplus)
 extern "C"
@@ -45,7 +48,7 @@ typedef enum
 {
     NvBootRsaDevice_SE0,
     NvBootRsaDevice_PKA1,
-    // NvBootRsaDevice_SW,
+    NvBootRsaDevice_SW,
 
     NvBootRsaDevice_Num,
 } NvBootRsaDeviceList;
@@ -217,6 +217,28 @@ void NvBootSeInstanceParseDecryptedContext(
             NvBootSeInstance    Instance,
             void *SeDecryptedContext,
             NvBootSeContextStickyBitsRegBuf *pNvBootSeContextStickyBitsRegBuf);
+/**
+ * Build an SE input linked list covering several memory segments, for
+ * example a message split between IRAM and SDRAM, so that it can be
+ * processed by a single SE operation (see pInputLinkedList of
+ * NvBootSeSHAHash). The segments are processed in order. Segments larger
+ * than NVBOOT_SE_LL_MAX_BUFFER_SIZE_BYTES take several linked list buffers.
+ *
+ * @param pLinkedList Linked list to fill in.
+ * @param pSegments Array of NumSegments segments (address and size in bytes).
+ * @param NumSegments Number of segments.
+ * @param pMessageSizeBytes Returns the total size of all segments.
+ *
+ * @return NvBootError_IllegalParameter if there are no segments, a segment
+ *         is empty, or more than NVBOOT_SE_LL_MAX_NUM_BUFFERS buffers would
+ *         be needed. NvBootError_Success otherwise.
+ */
+NvBootError NvBootSeGenerateScatterLinkedList(
+        SeLinkedList *pLinkedList,
+        const SeLinkedListElement *pSegments,
+        NvU32 NumSegments,
+        NvU32 *pMessageSizeBytes);
+
 /**
  * 
  * SHA Hash interface
@@ -227,7 +249,34 @@ void NvBootSeInstanceParseDecryptedContext(
  *
  *      9,202,000 = (0x) 50 69 8C. 
  */
-void NvBootSeSHAHash(NvU32 *pInputMessage, NvU32 InputMessageSizeBytes, NvU32 *pInputLinkedList, NvU32 *pOutputDestination, NvU8 HashAlgorithm);
+NvBootError NvBootSeSHAHash(NvU32 *pInputMessage, NvU32 InputMessageSizeBytes, NvU32 *pInputLinkedList, NvU32 *pOutputDestination, NvU8 HashAlgorithm);
+
+/**
+ * Non blocking and instanced SHA-256 of one chunk of a larger message.
+ * The intermediate hash is kept in the SE_HASH_RESULT registers of
+ * SeInstance between chunks, so no other SHA operation may run on that
+ * instance until the last chunk is done.
+ *
+ * @param SeInstance Instance number of SE engine
+ * @param pChunk Pointer to the chunk.
+ * @param ChunkSizeBytes Chunk size. Must be a multiple of the SHA-256
+ *                       block size (64 bytes) unless this is the last chunk.
+ * @param MessageSizeBytes Size of the whole message.
+ * @param MessageBytesLeft Bytes of the message not yet hashed, including
+ *                         this chunk. The first chunk is the one where it
+ *                         equals MessageSizeBytes and the last the one where
+ *                         it equals ChunkSizeBytes.
+ * @param pOutputDestination Digest buffer, written by the last chunk.
+ *
+ * The caller must check if the SE is idle first.
+ */
+void NvBootSeInstanceSHA256HashChunkStart(
+        NvBootSeInstance SeInstance,
+        NvU32   *pChunk,
+        NvU32    ChunkSizeBytes,
+        NvU32    MessageSizeBytes,
+        NvU32    MessageBytesLeft,
+        NvU32   *pOutputDestination);
 
 
 /**
@@ -288,7 +337,8 @@ void NvBootSeAesCmacGenerateSubkey (
  * @param NumBlocks Message size specified in AES blocks.
  * @param FirstChunk TRUE if this is the first chunk to be processed.
  * @param LastChunk TRUE if this is the last chunk to be processed.
- * @return void
+ * @return NvBootError_IllegalParameter if no input linked list could be
+ *         built for the blocks, NvBootError_Success otherwise.
  *
  * Note: This implementation requires the message size to be in multiples of AES
  *       block size (16 bytes).
@@ -296,7 +346,7 @@ void NvBootSeAesCmacGenerateSubkey (
  *       This is more than enough to handle the maximum IRAM buffer size
  *       (see nvboot_buffers_int.h).
  */
-void NvBootSeAesCmacHashBlocks (
+NvBootError NvBootSeAesCmacHashBlocks (
         NvU32 *pK1,
         NvU32 *pK2,
         NvU32 *pInputMessage,
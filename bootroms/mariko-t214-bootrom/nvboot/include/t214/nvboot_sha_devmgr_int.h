@@ -20,6 +20,9 @@ extern "C"
 #include "nvboot_error.h"
 #include "nvboot_sha_device_int.h"
 #include "nvboot_se_sha_dev_int.h"
+#if NVENABLE_SW_SHA_SUPPORT
+#include "nvboot_sw_sha_dev_int.h"
+#endif
 
 #if defined(__cplusplus)
 extern "C"
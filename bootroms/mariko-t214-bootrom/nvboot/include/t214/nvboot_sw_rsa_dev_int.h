@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+#ifndef NVBOOT_INCLUDE_T214_NVBOOT_SW_RSA_DEV_INT_H_
+#define NVBOOT_INCLUDE_T214_NVBOOT_SW_RSA_DEV_INT_H_
+
+#include <stdbool.h>
+#include "nvboot_crypto_param.h"
+#include "nvboot_crypto_rsa_param.h"
+#include "nvboot_error.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/**
+ * Number of key slots of the software RSA device. Slot 0 is the slot used
+ * by the crypto manager for the OEM public key.
+ */
+#define NVBOOT_SW_RSA_NUM_KEY_SLOTS 1
+
+/**
+ * Largest modulus supported by the software RSA device, in words.
+ */
+#define NVBOOT_SW_RSA_MAX_MODULUS_SIZE_WORDS NVBOOT_RSA_3072_MODULUS_SIZE_WORDS
+
+/**
+ * Software implementation of the NvBootRsaDeviceInit function of the
+ * nvboot_rsa_device_int.h interface. Invalidates all key slots.
+ *
+ * @return NvBootError.
+ */
+NvBootError NvBootSwRsaDevInit(void);
+
+/**
+ * Software implementation of the NvBootRsaDeviceNumKeySlots function
+ * of the nvboot_rsa_device_int.h interface.
+ *
+ * @return The number of RSA key slots.
+ */
+uint8_t NvBootSwRsaDevNumKeySlots(void);
+
+/**
+ * Software implementation of the NvBootRsaDeviceIsValidKeySlot function
+ * of the nvboot_rsa_device_int.h interface.
+ *
+ * @param[in] KeySlot The KeySlot number to validate.
+ *
+ * @return true if KeySlot is a valid key slot number. false otherwise.
+ */
+bool NvBootSwRsaDevIsValidKeySlot(uint8_t KeySlot);
+
+/**
+ * Software implementation of the NvBootRsaDeviceIsValidKeySize function
+ * of the nvboot_rsa_device_int.h interface.
+ *
+ * @param[in] KeySize The RSA key size to validate.
+ *
+ * @return true for RSA_KEY_2048 and RSA_KEY_3072. false otherwise.
+ */
+bool NvBootSwRsaDevIsValidKeySize(NvBootCryptoRsaKeySize KeySize);
+
+/**
+ * Read back the RSA key held in a key slot.
+ * @param[out] Key The buffer to read the RSA key into.
+ * @param[in] KeySlot The key slot number.
+ * @param[in] The key size to read.
+ *
+ * @return NvBootError_InvalidSeKeySlotNum or NvBootError_InvalidSeKeySize
+ * for an invalid slot or size, NvBootError_Success otherwise.
+ */
+NvBootError NvBootSwRsaDevGetKey(NvBootCryptoRsaKey *Key,
+                                 const uint8_t KeySlot,
+                                 const NvBootCryptoRsaKeySize KeySize);
+
+/**
+ * Load an RSA public key into a key slot and precompute its Montgomery
+ * constants. If the slot already holds the same key, the constants are
+ * kept and nothing is recomputed. This is the only key-resident session
+ * there is: a caller verifying many images with one key calls SetKey and
+ * NvBootCryptoRsaSsaPssVerify() per image.
+ * @param[in] Key The RSA key to load into the key slot. A 3072-bit key
+ *            uses the NvBootCryptoRsaKey3072NvU32 layout for KeyData, so
+ *            its storage must be large enough for that layout.
+ * @param[in] KeySlot The key slot number.
+ *
+ * @return NvBootError_InvalidSeKeySlotNum or NvBootError_InvalidSeKeySize
+ * for an invalid slot or size, NvBootError_IllegalParameter if the modulus
+ * is even or not KeySize bits long, NvBootError_Success otherwise.
+ */
+NvBootError NvBootSwRsaDevSetKey(const NvBootCryptoRsaKey *Key,
+                                 const uint8_t KeySlot);
+
+/**
+ * Calculate Result = Base ^ e (mod m) with the key in KeySlot. Base and
+ * Result are little-endian integers of KeySize bits, as for the SE, and
+ * Base must be smaller than the modulus. The operation completes before
+ * the function returns.
+ *
+ * @param[in] Base, what is to be repeatedly multiplied
+ * @param[out] Result he result of the calculation.
+ * @param[in] KeySlot The key slot number of the RSA key to use, which specifies
+ *                    the modulus and exponent.
+ * @param[in] KeySize A valid RSA key size, matching the loaded key.
+ */
+NvBootError NvBootSwRsaDevModularExponentiation(const uint32_t *Base,
+                                                uint32_t *Result,
+                                                const uint8_t KeySlot,
+                                                const NvBootCryptoRsaKeySize KeySize);
+
+/**
+ * The software device is never busy.
+ *
+ * @return false.
+ */
+bool NvBootSwRsaDevIsEngineBusy(void);
+
+/**
+ *  Shutdown the Rsa device and clear the key slots.
+ */
+void NvBootSwRsaDevShutdown(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* NVBOOT_INCLUDE_T214_NVBOOT_SW_RSA_DEV_INT_H_ */
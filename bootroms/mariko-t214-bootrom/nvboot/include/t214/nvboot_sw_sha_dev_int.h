@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+#ifndef NVBOOT_INCLUDE_T214_NVBOOT_SW_SHA_DEV_INT_H_
+#define NVBOOT_INCLUDE_T214_NVBOOT_SW_SHA_DEV_INT_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "nvboot_error.h"
+#include "nvboot_crypto_sha_param.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/*
+ * Software SHA-2 device for the SHA device manager. Supports SHA-256,
+ * SHA-384 and SHA-512 and has no hardware dependencies, so it can be used
+ * as a fallback for the SE and in host builds of the crypto code.
+ */
+
+/**
+ * Initialize the software SHA device. Defaults to SHA2, 256-bit digests.
+ *
+ * @param[in] ShaConfig Pointer to a ShaConfig struct.
+ *
+ * @return NvBootError.
+ */
+NvBootError NvBootSwShaDevInit(NvBootCryptoShaConfig *ShaConfig);
+
+/**
+ * Get the currently configured SHA family.
+ *
+ * @param[in] ShaConfig Pointer to a ShaConfig struct.
+ *
+ * @return NvBootCryptoShaFamily.
+ */
+NvBootCryptoShaFamily NvBootSwShaGetShaFamily(NvBootCryptoShaConfig *ShaConfig);
+
+/**
+ * Set the SHA family. Only SHA2 is supported.
+ *
+ * @param[in] ShaConfig Pointer to a ShaConfig struct.
+ * @param[in] ShaFamily Prospective SHA family.
+ *
+ * @return bool Returns true if the ShaFamily is supported. false otherwise.
+ */
+bool NvBootSwShaSetShaFamily(NvBootCryptoShaConfig *ShaConfig, NvBootCryptoShaFamily ShaFamily);
+
+/**
+ * Get the currently configured digest size.
+ *
+ * @param[in] ShaConfig Pointer to a ShaConfig struct.
+ *
+ * @return NvBootCryptoShaDigestSize.
+ */
+NvBootCryptoShaDigestSize NvBootSwShaGetDigestSize(NvBootCryptoShaConfig *ShaConfig);
+
+/**
+ * Set the SHA digest size.
+ *
+ * @param[in] ShaConfig Pointer to a ShaConfig struct.
+ * @param[in] DigestSize Prospective digest size.
+ *
+ * @return bool Returns true if the digest size is supported. false otherwise.
+ */
+bool NvBootSwShaSetShaDigestSize(NvBootCryptoShaConfig *ShaConfig, NvBootCryptoShaDigestSize DigestSize);
+
+/**
+ * Check if a particular SHA family is supported.
+ *
+ * @param[in] ShaFamily SHA family i.e. SHA2, SHA3.
+ *
+ * @return bool Returns true if the SHA family is supported. false otherwise.
+ */
+bool NvBootSwShaIsValidShaFamily(NvBootCryptoShaFamily ShaFamily);
+
+/**
+ * Check if a particular SHA digest size is supported. SHA_256, SHA_384
+ * and SHA_512 are.
+ *
+ * @param[in] DigestSize Digest size in bits.
+ *
+ * @return bool Returns true if the digest size is supported. false otherwise.
+ */
+bool NvBootSwShaIsValidShaDigestSize(NvBootCryptoShaDigestSize DigestSize);
+
+/**
+ * Calculate the SHA2 hash of an input message.
+ *
+ * @param[in] InputMessage Pointer to the input message buffer. Need not be
+ *            word aligned.
+ * @param[in] InputMessageLength Length in bytes of the input message.
+ * @param[out] Hash The resulting hash, in FIPS 180-4 byte order (the same
+ *             layout as the SE output). Must hold DigestSize / 8 bytes.
+ * @param[in] ShaConfig Pointer to a ShaConfig struct.
+ *
+ * @return NvBootError_Success, or NvBootError_Unsupported_SHA_Family /
+ * NvBootError_Unsupported_SHA_DigestSize for an invalid configuration.
+ */
+NvBootError NvBootSwShaDevShaHash(const uint32_t *InputMessage, uint32_t InputMessageLength, uint32_t *Hash, NvBootCryptoShaConfig *ShaConfig);
+
+/**
+ *  Shutdown the SHA device and clean up state.
+ */
+void NvBootSwShaDeviceShutdown(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* NVBOOT_INCLUDE_T214_NVBOOT_SW_SHA_DEV_INT_H_ */
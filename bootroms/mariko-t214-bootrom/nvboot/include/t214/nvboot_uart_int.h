@@ -67,6 +67,70 @@ typedef struct {
     NvU32 UniqueId3 ;
 } NvBootUart_Header ;
 
+/*
+ * Block protocol
+ *
+ * A host that sets NVBOOT_UART_BLOCK_MODE_FLAG in MainLength follows the
+ * header with an NvBootUart_BlockRequest instead of the payload. MainLength
+ * then holds the payload length alone, with no trailing checksum.
+ *
+ * 1. The Boot ROM answers with an NvBootUart_BlockReply at 115200. If the
+ *    request is accepted and ClockDivisor is not NVBOOT_UART_BLOCK_KEEP_BAUD,
+ *    the Boot ROM then switches to OscKhz * 125 / (ClockDivisor + 2) baud,
+ *    the fastest rate the oscillator gives that is not above the requested
+ *    BaudRate. The host switches too.
+ * 2. The Boot ROM sends an NvBootUart_BlockStatus, at the new rate, with a
+ *    bit set for each block still missing (all of them at first).
+ * 3. The host sends a frame for every missing block, in ascending order:
+ *    the block index (NvU32), NVBOOT_UART_BLOCK_SIZE bytes of payload (less
+ *    for the last block) and the CRC32 of the index and payload. Blocks are
+ *    received in place at their offset in the payload.
+ * 4. A block with a bad CRC stays missing. A line error, timeout or
+ *    unexpected index ends the pass: the Boot ROM drops what is left of it
+ *    and waits for the line to go idle.
+ * 5. Steps 2 to 4 repeat until no block is missing, up to
+ *    NVBOOT_UART_BLOCK_MAX_PASSES passes, after which the download fails.
+ *    A failed download sends "Fail" at 115200, before the next prompt, so
+ *    the host switches back too.
+ *
+ * The CRC32 is the IEEE 802.3 one, as computed by zlib's crc32(). The CRCs
+ * of the request and reply cover the structure up to the Crc32 field; the
+ * request's also covers the NvBootUart_Header in front of it.
+ */
+#define NVBOOT_UART_BLOCK_MODE_FLAG     0x80000000
+#define NVBOOT_UART_BLOCK_MAGIC         0x4B4C4255 // "UBLK"
+#define NVBOOT_UART_BLOCK_ACK           0x00000000
+#define NVBOOT_UART_BLOCK_NAK           0xFFFFFFFF
+#define NVBOOT_UART_BLOCK_KEEP_BAUD     0xFFFFFFFF
+#define NVBOOT_UART_BLOCK_SIZE_LOG2     12
+#define NVBOOT_UART_BLOCK_SIZE          (1 << NVBOOT_UART_BLOCK_SIZE_LOG2)
+// Enough blocks to cover all of IRAM.
+#define NVBOOT_UART_BLOCK_MAX_BLOCKS    64
+#define NVBOOT_UART_BLOCK_BITMAP_WORDS  (NVBOOT_UART_BLOCK_MAX_BLOCKS / 32)
+#define NVBOOT_UART_BLOCK_MAX_PASSES    8
+
+typedef struct {
+    NvU32 Magic ;         // NVBOOT_UART_BLOCK_MAGIC
+    NvU32 BaudRate ;      // Requested rate in bits/s, 0 to stay at 115200
+    NvU32 Crc32 ;
+} NvBootUart_BlockRequest ;
+
+typedef struct {
+    NvU32 Magic ;         // NVBOOT_UART_BLOCK_MAGIC
+    NvU32 Status ;        // NVBOOT_UART_BLOCK_ACK or NVBOOT_UART_BLOCK_NAK
+    NvU32 OscKhz ;        // UART clock source frequency
+    NvU32 ClockDivisor ;  // UART clock divisor in 15.1 format, or KEEP_BAUD
+    NvU32 NumBlocks ;
+    NvU32 Crc32 ;
+} NvBootUart_BlockReply ;
+
+typedef struct {
+    NvU32 Magic ;         // NVBOOT_UART_BLOCK_MAGIC
+    NvU32 NumMissing ;
+    NvU32 Missing[NVBOOT_UART_BLOCK_BITMAP_WORDS] ;
+    NvU32 Crc32 ;
+} NvBootUart_BlockStatus ;
+
 #if defined(__cplusplus)
 extern "C"
 {
@@ -116,6 +180,48 @@ NvBootUartPollingWrite(const uint8_t *pSrc, size_t BytesRequested,
 NvBootError FT_NONSECURE
 NvBootUartPollingRead2(uint8_t *pDest, size_t *BytesRead, uint32_t timeout);
 
+/**
+ *  \brief Uart polling read with a running CRC32 and an inter-byte timeout
+ *  \param pDest Buffer
+ *  \param BytesRequested Bytes to read
+ *  \param pCrc CRC32 to update with the bytes read
+ *  \param timeout Longest wait for any one byte, in us
+ *  \return NvBootError_HwTimeOut if a byte did not arrive in time,
+ *          NvBootError_ValidationFailure on a line error
+ */
+NvBootError FT_NONSECURE
+NvBootUartPollingReadCrc32(uint8_t *pDest, size_t BytesRequested,
+    NvU32 *pCrc, uint32_t timeout);
+
+/**
+ *  \brief Read and drop bytes until none has arrived for IdleUs
+ */
+void FT_NONSECURE
+NvBootUartDrainRx(uint32_t IdleUs);
+
+/**
+ *  \brief Update a CRC32, starting from 0, with Bytes bytes at pData
+ */
+NvU32 FT_NONSECURE
+NvBootUartCrc32(NvU32 Crc, const uint8_t *pData, size_t Bytes);
+
+/**
+ *  \brief Find the UART clock divisor for the fastest rate not above BaudRate
+ *  \param pClockDivisor Divisor in 15.1 format, for NvBootUartSetClockDivisor()
+ *  \param pOscKhz Frequency the divisor applies to
+ *  \return NvBootError_DeviceUnsupported if the rate cannot be changed,
+ *          e.g. with the fast UART strap
+ */
+NvBootError FT_NONSECURE
+NvBootUartFindClockDivisor(NvBootClocksOscFreq OscFreq, NvU32 BaudRate,
+    NvU32 *pClockDivisor, NvU32 *pOscKhz);
+
+/**
+ *  \brief Switch the UART clock divisor and flush the FIFOs
+ */
+void FT_NONSECURE
+NvBootUartSetClockDivisor(NvU32 ClockDivisor);
+
 /**
  * NvBootIsFAPreProductionUart : implements the decision process to 
  * to go to preproduction uart and handling failure during download over uart.
@@ -226,7 +226,8 @@ typedef struct NvBootUsb3ContextRec
     NvU8 *BufferData;
     //Required for Read command
     NvU8 LogicalBlkAddr[4];
-    NvU8 TransferLen[2];
+    //Little endian. Bytes 3:2 are only sent by READ(16)
+    NvU8 TransferLen[4];
     // No of device blocks per page;
     //Derived from read capacity response
     NvU16 DeviceNumBlocksPerPage;
@@ -101,10 +101,12 @@ NvBootUsb3Init(
  *          valid range is 0 <= Page < PagesPerBlock.
  * @param Length Length in bytes.
  * @param Dest Buffer to rad the data into. The buffer must be atleast 4 byte 
- *          aligned.
+ *          aligned, and 512 byte aligned if it crosses a 64 KiB boundary.
  *
  * @retval NvBootError_Success Read operation is launched successfully.
  * @retval NvBootError_HwTimeOut Device is not responding.
+ * @retval NvBootError_IllegalParameter Dest crosses a 64 KiB boundary and is
+ *          not 512 byte aligned.
  */
 NvBootError 
 NvBootUsb3Read(
@@ -143,6 +143,8 @@ NvBootUtilCompareBytes(NvU8 *Value1, NvU8 *Value2, NvU32 ValueSizeBytes);
  * Note, timing attack isn't possible when doing public key signature verification
  * (no secret to recover) but we should still use this function anyway.
  * For symmetric based algorithms like AES-CMAC, definitely use this function.
+ * If both buffers are 32-bit aligned they are compared a word at a time, so
+ * the runtime is the same for every call with the same length and alignment.
  *
  * @param Buffer1 pointer to first byte buffer
  * @param Buffer2 pointer to second byte buffer
@@ -169,6 +171,8 @@ typedef enum
  * Note, timing attack isn't possible when doing public key signature verification
  * (no secret to recover) but we should still use this function anyway.
  * For symmetric based algorithms like AES-CMAC, definitely use this function.
+ * If both buffers are 32-bit aligned they are compared a word at a time, so
+ * the runtime is the same for every call with the same length and alignment.
  *
  * @param Buffer1 pointer to first byte buffer
  * @param Buffer2 pointer to second byte buffer
@@ -46,6 +46,7 @@ enum
 {
     INQUIRY_CMD_LEN              = 0x6,
     READ10_CMD_LEN               = 0xA,
+    READ16_CMD_LEN               = 0x10,
     REQUESTSENSE_CMD_LEN         = 0x0C,
     TESTUNITREADY_CMD_LEN        = 0x06,
     READ_CAPACITY_CMD_LEN        = 0xA,
@@ -56,6 +57,7 @@ enum
 {
     INQUIRY_CMD_OPCODE              = 0x12,
     READ10_CMD_OPCODE               = 0x28,
+    READ16_CMD_OPCODE               = 0x88,
     REQUESTSENSE_CMD_OPCODE         = 0x03,
     TESTUNITREADY_CMD_OPCODE        = 0x00,
     READ_CAPACITY_CMD_OPCODE        = 0x25,
@@ -123,6 +125,33 @@ typedef struct Read10CDBRec
     NvU8    Resvd4[2]                  ;
 }__attribute__((packed)) Read10CDB;
 
+//Largest transfer length a READ(10) can carry, in logical blocks
+#define READ10_MAX_TRANSFER_LEN              0xFFFF
+
+//READ CAPACITY(10) reports this last LBA for a device that needs READ(16)
+#define READ_CAPACITY_LBA_OVERFLOW           0xFFFFFFFF
+
+///////////////////////////////////////READ(16) Command ///////////////////////////
+//Same as READ(10) with a 64 bit logical block address and a 32 bit transfer length.
+//Byte 1 carries RDPROTECT/DPO/FUA, so the LUN is only given in the CBW.
+
+typedef struct Read16CDBRec
+{
+    NvU8    opcode                  ;       // should be set to 0x88
+    NvU8    Flags                   ;       // RDPROTECT, DPO, FUA. Set to 0
+    NvU8    LogicalBlkAddr_msb[4]   ;       // bits 63:32 of the logical block address, big endian
+    NvU8    LogicalBlkAddrByte4_msb ;       // bits 31:0 of the logical block address
+    NvU8    LogicalBlkAddrByte3     ;
+    NvU8    LogicalBlkAddrByte2     ;
+    NvU8    LogicalBlkAddrByte1_lsb ;
+    NvU8    TransferLenByte4_msb    ;       // number of contiguous logical blocks to be transferred
+    NvU8    TransferLenByte3        ;
+    NvU8    TransferLenByte2        ;
+    NvU8    TransferLenByte1_lsb    ;
+    NvU8    GroupNum                ;
+    NvU8    Control                 ;
+}__attribute__((packed)) Read16CDB;
+
 ///////////////////////////////////////REQUEST_SENSE Command ///////////////////////////
 //This requests the device to transfer sense data to the host 
 //Whenever an error is reported, host should issue this command to receive the sense data
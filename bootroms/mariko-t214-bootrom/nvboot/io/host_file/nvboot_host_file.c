@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "nvboot_config.h"
+#include "nvboot_config_int.h"
+#include "nvboot_devparams.h"
+#include "nvboot_util_int.h"
+#include "nvboot_host_file_int.h"
+
+/** HostFile is a device backed by a storage image on a Linux host. It allows
+ * running NvBootReadBct() and NvBootLoadBootLoader() off-target to compare
+ * driver and boot flow changes reproducibly.
+ *
+ * 1. To include the host device, Set NVENABLE_HOST_FILE_SUPPORT=1 and build
+ *    the host_file io library with the host compiler.
+ * 2. Call NvBootHostFileOpen() with the image and the device geometry and
+ *    latencies, and optionally inject bit flips and bad blocks.
+ * 3. Call NvBootDevMgrInit() with NvBootDevType_HostFile.
+ *    Note: Bct page and block size should match the geometry given to
+ *    NvBootHostFileOpen() to avoid bct validation error.
+ *
+ * Reads copy the data immediately, but QueryStatus() reports
+ * NvBootDeviceStatus_ReadInProgress until the modelled latency has elapsed.
+ */
+
+NV_CT_ASSERT(sizeof(NvBootHostFileParams) <= sizeof(NvBootDevParams));
+
+static NvBootHostFileContext *s_HostFileContext;
+static NvBootHostFileParams s_HostFileDefaultParams;
+
+/* The mapped image. */
+static const uint8_t *s_Image;
+static size_t s_ImageSize;
+
+/* Injected faults. */
+static NvBootHostFileBitFlip s_BitFlips[HOST_FILE_MAX_BIT_FLIPS];
+static NvU32 s_NumBitFlips;
+static NvU32 s_BadBlocks[HOST_FILE_MAX_BAD_BLOCKS];
+static NvU32 s_NumBadBlocks;
+
+/* Space handed out by NvBootHostFileGetReaderBuffersBase(). */
+static uint8_t s_ReaderBuffers[NVBOOT_MAX_BUFFER_SIZE] __attribute__((aligned(4096)));
+
+static NvU64 GetTimeUs(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return (NvU64)Now.tv_sec * 1000000 + Now.tv_nsec / 1000;
+}
+
+NvBootError
+NvBootHostFileOpen(
+    const char *Path,
+    const NvBootHostFileParams *Params)
+{
+    struct stat Stat;
+    void *Image;
+    int Fd;
+
+    NV_ASSERT(Path != NULL);
+    NV_ASSERT(Params != NULL);
+
+    NvBootHostFileClose();
+
+    Fd = open(Path, O_RDONLY);
+    if (Fd < 0)
+        return NvBootError_DeviceNotResponding;
+
+    if ((fstat(Fd, &Stat) != 0) || (Stat.st_size == 0))
+    {
+        close(Fd);
+        return NvBootError_DeviceNotResponding;
+    }
+
+    Image = mmap(NULL, Stat.st_size, PROT_READ, MAP_PRIVATE, Fd, 0);
+    close(Fd);
+    if (Image == MAP_FAILED)
+        return NvBootError_DeviceNotResponding;
+
+    s_Image = (const uint8_t *)Image;
+    s_ImageSize = Stat.st_size;
+    s_HostFileDefaultParams = *Params;
+    s_NumBitFlips = 0;
+    s_NumBadBlocks = 0;
+
+    return NvBootError_Success;
+}
+
+void
+NvBootHostFileClose(void)
+{
+    if (s_Image != NULL)
+        munmap((void *)s_Image, s_ImageSize);
+
+    s_Image = NULL;
+    s_ImageSize = 0;
+}
+
+NvBootError
+NvBootHostFileInjectBitFlip(
+    const NvU32 Offset,
+    const NvU32 Bit)
+{
+    if ((Bit > 7) || (s_NumBitFlips >= HOST_FILE_MAX_BIT_FLIPS))
+        return NvBootError_IllegalParameter;
+
+    s_BitFlips[s_NumBitFlips].Offset = Offset;
+    s_BitFlips[s_NumBitFlips].Bit = Bit;
+    s_NumBitFlips++;
+
+    return NvBootError_Success;
+}
+
+NvBootError
+NvBootHostFileInjectBadBlock(
+    const NvU32 Block)
+{
+    if (s_NumBadBlocks >= HOST_FILE_MAX_BAD_BLOCKS)
+        return NvBootError_IllegalParameter;
+
+    s_BadBlocks[s_NumBadBlocks++] = Block;
+
+    return NvBootError_Success;
+}
+
+void
+NvBootHostFileGetParams(
+    const NvU32 ParamIndex __attribute__ ((unused)),
+    NvBootHostFileParams **Params)
+{
+    NV_ASSERT(Params != NULL);
+
+    if (s_HostFileDefaultParams.PageSizeLog2 == 0)
+    {
+        s_HostFileDefaultParams.PageSizeLog2  = HOST_FILE_PAGESIZELOG2;
+        s_HostFileDefaultParams.BlockSizeLog2 = HOST_FILE_BLOCKSIZELOG2;
+    }
+    *Params = &s_HostFileDefaultParams;
+}
+
+NvBool
+NvBootHostFileValidateParams(
+    const NvBootHostFileParams *Params)
+{
+    NV_ASSERT(Params != NULL);
+
+    if ((Params->PageSizeLog2  < NVBOOT_MIN_PAGE_SIZE_LOG2)  ||
+        (Params->PageSizeLog2  > NVBOOT_MAX_PAGE_SIZE_LOG2)  ||
+        (Params->BlockSizeLog2 < NVBOOT_MIN_BLOCK_SIZE_LOG2) ||
+        (Params->BlockSizeLog2 > NVBOOT_MAX_BLOCK_SIZE_LOG2) ||
+        (Params->BlockSizeLog2 < Params->PageSizeLog2))
+    {
+        return NV_FALSE;
+    }
+
+    return NV_TRUE;
+}
+
+void
+NvBootHostFileGetBlockSizes(
+    const NvBootHostFileParams *Params __attribute__ ((unused)),
+    NvU32 *BlockSizeLog2,
+    NvU32 *PageSizeLog2)
+{
+    *BlockSizeLog2 = s_HostFileContext->BlockSizeLog2;
+    *PageSizeLog2  = s_HostFileContext->PageSizeLog2;
+}
+
+NvBootError
+NvBootHostFileInit(
+    const NvBootHostFileParams *Params,
+    NvBootHostFileContext *pHostFileContext)
+{
+    NV_ASSERT(Params != NULL);
+    NV_ASSERT(pHostFileContext != NULL);
+
+    if (s_Image == NULL)
+        return NvBootError_DeviceNotResponding;
+
+    s_HostFileContext = pHostFileContext;
+
+    s_HostFileContext->PageSizeLog2  = Params->PageSizeLog2;
+    s_HostFileContext->BlockSizeLog2 = Params->BlockSizeLog2;
+    s_HostFileContext->ReadLatencyUs = Params->ReadLatencyUs;
+    s_HostFileContext->PageLatencyUs = Params->PageLatencyUs;
+    s_HostFileContext->ReadDoneUs    = 0;
+    s_HostFileContext->ReadStatus    = NvBootDeviceStatus_Idle;
+    s_HostFileContext->NumReads      = 0;
+    s_HostFileContext->BytesRead     = 0;
+
+    return NvBootError_Success;
+}
+
+NvBootError
+NvBootHostFileReadPage(
+    const NvU32 Block,
+    const NvU32 Page,
+    const NvU32 Len,
+    uint8_t *Dest)
+{
+    NvU64 Start;
+    NvU64 End;
+    NvU32 NumPages;
+    NvU32 i;
+
+    NV_ASSERT(Dest != NULL);
+    NV_ASSERT(Page < (1 << (s_HostFileContext->BlockSizeLog2 -
+                            s_HostFileContext->PageSizeLog2)));
+
+    Start = ((NvU64)Block << s_HostFileContext->BlockSizeLog2) +
+            ((NvU64)Page << s_HostFileContext->PageSizeLog2);
+    End = Start + Len;
+    NumPages = NV_ICEIL(Len, 1 << s_HostFileContext->PageSizeLog2);
+
+    s_HostFileContext->NumReads++;
+    s_HostFileContext->BytesRead += Len;
+    s_HostFileContext->ReadDoneUs = GetTimeUs() +
+                                    s_HostFileContext->ReadLatencyUs +
+                                    (NvU64)NumPages * s_HostFileContext->PageLatencyUs;
+    s_HostFileContext->ReadStatus = NvBootDeviceStatus_Idle;
+
+    /* Reads past the end of the image fail like reads past the media. */
+    if (End > s_ImageSize)
+    {
+        s_HostFileContext->ReadStatus = NvBootDeviceStatus_ReadFailure;
+        return NvBootError_Success;
+    }
+
+    for (i = 0; i < s_NumBadBlocks; i++)
+    {
+        if ((s_BadBlocks[i] >= (Start >> s_HostFileContext->BlockSizeLog2)) &&
+            (s_BadBlocks[i] <= ((End - 1) >> s_HostFileContext->BlockSizeLog2)))
+        {
+            s_HostFileContext->ReadStatus = NvBootDeviceStatus_ReadFailure;
+            return NvBootError_Success;
+        }
+    }
+
+    NvBootUtilMemcpy(Dest, &s_Image[Start], Len);
+
+    for (i = 0; i < s_NumBitFlips; i++)
+    {
+        if ((s_BitFlips[i].Offset >= Start) && (s_BitFlips[i].Offset < End))
+            Dest[s_BitFlips[i].Offset - Start] ^= (1 << s_BitFlips[i].Bit);
+    }
+
+    return NvBootError_Success;
+}
+
+NvBootDeviceStatus NvBootHostFileQueryStatus(void)
+{
+    if (GetTimeUs() < s_HostFileContext->ReadDoneUs)
+        return NvBootDeviceStatus_ReadInProgress;
+
+    return s_HostFileContext->ReadStatus;
+}
+
+void NvBootHostFileShutdown(void)
+{
+    s_HostFileContext->PageSizeLog2  = 0;
+    s_HostFileContext->BlockSizeLog2 = 0;
+}
+
+NvBootError NvBootHostFileGetReaderBuffersBase(
+                            uint8_t** ReaderBuffersBase,
+                            const NvU32 Alignment,
+                            const NvU32 Bytes)
+{
+    if ((ReaderBuffersBase == NULL) || (*ReaderBuffersBase != NULL))
+        return NvBootError_IllegalParameter;
+
+    if (Bytes > sizeof(s_ReaderBuffers))
+        return NvBootError_MemoryNotAllocated;
+
+    if ((Alignment > 4096) || (Alignment & (Alignment - 1)))
+        return NvBootError_MemoryNotAligned;
+
+    *ReaderBuffersBase = &s_ReaderBuffers[0];
+
+    return NvBootError_Success;
+}
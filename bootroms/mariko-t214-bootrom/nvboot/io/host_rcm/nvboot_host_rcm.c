@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "nvboot_util_int.h"
+#include "nvboot_host_rcm_int.h"
+
+/** HostRcm is an RCM port backed by a Unix stream socket or pipe on a Linux
+ * host. It allows running NvBootRCMProcessMsgs() off-target, fed by the
+ * client calls below, to measure the receive, validate and execute path in
+ * messages/s and MB/s without a USB host attached.
+ *
+ * 1. To include the host port, Set NVENABLE_HOST_RCM_SUPPORT=1 and build
+ *    the host_rcm io library with the host compiler.
+ * 2. Call NvBootHostRcmOpen() or NvBootHostRcmOpenFd() with the port end of
+ *    the connection.
+ * 3. Call NvBootRCMInit(), which selects RCM_HOST, then
+ *    NvBootRCMSendUniqueId() and NvBootRCMProcessMsgs(). The client reads
+ *    the ECID and sends its messages from another thread or process.
+ *    Note: the RCM message and transmit buffers are at their IRAM
+ *    addresses, so the host program must map that range first.
+ *
+ * A stream has no packet boundaries: a receive returns what one read()
+ * gets, which is never more than asked for, just as a short packet ends a
+ * USB transfer early. NvBootHostRcmHandleError() stalls the port, and every
+ * later receive or transfer fails until the port is opened again.
+ */
+
+static int s_Fd = -1;
+static NvBool s_Stalled;
+static NvBootHostRcmStats s_Stats;
+
+/* Window armed by NvBootHostRcmReceiveStart(). */
+static uint8_t *s_ReceiveBuffer;
+static NvU32 s_ReceiveBytes;
+
+/* Bytes written by NvBootHostRcmTransferStart(). */
+static NvU32 s_BytesTransferred;
+
+/* An empty list of clock tables: there are no clocks to set up. */
+static ClockTable s_NoClockTables[1] = { NULL };
+
+static NvU64 GetTimeUs(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return (NvU64)Now.tv_sec * 1000000 + Now.tv_nsec / 1000;
+}
+
+/* One read(), retried only if interrupted. Returns 0 at end of stream. */
+static ssize_t ReadSome(int Fd, void *Buffer, size_t Bytes)
+{
+    ssize_t Got;
+
+    do {
+        Got = read(Fd, Buffer, Bytes);
+    } while ((Got < 0) && (errno == EINTR));
+    return Got;
+}
+
+static NvBootError ReadAll(int Fd, void *Buffer, size_t Bytes)
+{
+    uint8_t *Dst = (uint8_t *)Buffer;
+    ssize_t Got;
+
+    while (Bytes > 0)
+    {
+        Got = ReadSome(Fd, Dst, Bytes);
+        if (Got <= 0)
+            return NvBootError_DeviceNotResponding;
+        Dst += Got;
+        Bytes -= Got;
+    }
+    return NvBootError_Success;
+}
+
+static NvBootError WriteAll(int Fd, const void *Buffer, size_t Bytes)
+{
+    const uint8_t *Src = (const uint8_t *)Buffer;
+    ssize_t Put;
+
+    while (Bytes > 0)
+    {
+        Put = write(Fd, Src, Bytes);
+        if ((Put < 0) && (errno == EINTR))
+            continue;
+        if (Put <= 0)
+            return NvBootError_DeviceNotResponding;
+        Src += Put;
+        Bytes -= Put;
+    }
+    return NvBootError_Success;
+}
+
+NvBootError
+NvBootHostRcmOpen(
+    const char *Path)
+{
+    struct sockaddr_un Addr;
+    int Fd;
+
+    NV_ASSERT(Path != NULL);
+
+    if (strlen(Path) >= sizeof(Addr.sun_path))
+        return NvBootError_IllegalParameter;
+
+    NvBootUtilMemset(&Addr, 0, sizeof(Addr));
+    Addr.sun_family = AF_UNIX;
+    NvBootUtilMemcpy(Addr.sun_path, Path, strlen(Path));
+
+    Fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (Fd < 0)
+        return NvBootError_DeviceNotResponding;
+
+    if (connect(Fd, (struct sockaddr *)&Addr, sizeof(Addr)) != 0)
+    {
+        close(Fd);
+        return NvBootError_DeviceNotResponding;
+    }
+
+    return NvBootHostRcmOpenFd(Fd);
+}
+
+NvBootError
+NvBootHostRcmOpenFd(
+    int Fd)
+{
+    if (Fd < 0)
+        return NvBootError_IllegalParameter;
+
+    NvBootHostRcmClose();
+    s_Fd = Fd;
+
+    return NvBootError_Success;
+}
+
+void
+NvBootHostRcmClose(void)
+{
+    if (s_Fd >= 0)
+        close(s_Fd);
+
+    s_Fd = -1;
+    s_Stalled = NV_FALSE;
+    s_ReceiveBuffer = NULL;
+    s_ReceiveBytes = 0;
+    s_BytesTransferred = 0;
+    NvBootUtilMemset(&s_Stats, 0, sizeof(s_Stats));
+}
+
+void
+NvBootHostRcmGetStats(
+    NvBootHostRcmStats *pStats)
+{
+    NV_ASSERT(pStats != NULL);
+
+    *pStats = s_Stats;
+}
+
+NvBootError
+NvBootHostRcmClientReadUniqueId(
+    int Fd,
+    NvBootECID *pUniqueId)
+{
+    NV_ASSERT(pUniqueId != NULL);
+
+    return ReadAll(Fd, pUniqueId, sizeof(NvBootECID));
+}
+
+NvBootError
+NvBootHostRcmClientSendMessage(
+    int Fd,
+    const void *Msg,
+    NvU32 Length,
+    NvU32 *pResponse)
+{
+    NvBootError e;
+
+    NV_ASSERT(Msg != NULL);
+    NV_ASSERT(pResponse != NULL);
+
+    e = WriteAll(Fd, Msg, Length);
+    if (e != NvBootError_Success)
+        return e;
+
+    return ReadAll(Fd, pResponse, sizeof(NvU32));
+}
+
+void
+NvBootHostRcmGetClockTable(
+    void **ClockTable,
+    ClockTableType *Id)
+{
+    *ClockTable = (void *)s_NoClockTables;
+    *Id = TYPE_MULTI_TABLE;
+}
+
+NvBootError
+NvBootHostRcmInit(void)
+{
+    if (s_Fd < 0)
+        return NvBootError_DeviceNotResponding;
+
+    return NvBootError_Success;
+}
+
+NvBootError
+NvBootHostRcmConnect(
+    uint8_t *OptionalBuffer __attribute__ ((unused)))
+{
+    if (s_Fd < 0)
+        return NvBootError_DeviceNotResponding;
+
+    return NvBootError_Success;
+}
+
+NvBootError
+NvBootHostRcmReceiveStart(
+    uint8_t *Buffer,
+    NvU32 Bytes)
+{
+    NV_ASSERT(Buffer != NULL);
+
+    /* Nothing to prime: the data is read when it is waited for. */
+    s_ReceiveBuffer = Buffer;
+    s_ReceiveBytes = Bytes;
+
+    return NvBootError_Success;
+}
+
+NvBootError
+NvBootHostRcmReceivePoll(
+    NvU32 *pBytesReceived,
+    NvU32 TimeoutUs __attribute__ ((unused)),
+    uint8_t *OptionalBuffer __attribute__ ((unused)))
+{
+    NvBootError e;
+
+    e = NvBootHostRcmReceive(s_ReceiveBuffer, s_ReceiveBytes, pBytesReceived);
+    s_ReceiveBuffer = NULL;
+    s_ReceiveBytes = 0;
+
+    return e;
+}
+
+NvBootError
+NvBootHostRcmReceive(
+    uint8_t *Buffer,
+    NvU32 Bytes,
+    NvU32 *pBytesReceived)
+{
+    ssize_t Got;
+
+    NV_ASSERT(pBytesReceived != NULL);
+
+    *pBytesReceived = 0;
+
+    if (s_Stalled)
+        return NvBootError_TxferFailed;
+
+    if ((Buffer == NULL) || (Bytes == 0))
+        return NvBootError_Success;
+
+    Got = ReadSome(s_Fd, Buffer, Bytes);
+    if (Got <= 0)
+        return NvBootError_DeviceNotResponding;
+
+    *pBytesReceived = (NvU32)Got;
+
+    s_Stats.LastReceiveUs = GetTimeUs();
+    if (s_Stats.NumReceives == 0)
+        s_Stats.FirstReceiveUs = s_Stats.LastReceiveUs;
+    s_Stats.NumReceives++;
+    s_Stats.BytesReceived += Got;
+
+    return NvBootError_Success;
+}
+
+NvBootError
+NvBootHostRcmTransferStart(
+    uint8_t *Buffer,
+    NvU32 Bytes)
+{
+    return NvBootHostRcmTransfer(Buffer, Bytes, &s_BytesTransferred);
+}
+
+NvBootError
+NvBootHostRcmTransferPoll(
+    NvU32 *pBytesTransferred,
+    NvU32 TimeoutUs __attribute__ ((unused)),
+    uint8_t *OptionalBuffer __attribute__ ((unused)))
+{
+    NV_ASSERT(pBytesTransferred != NULL);
+
+    *pBytesTransferred = s_BytesTransferred;
+    s_BytesTransferred = 0;
+
+    return s_Stalled ? NvBootError_TxferFailed : NvBootError_Success;
+}
+
+NvBootError
+NvBootHostRcmTransfer(
+    uint8_t *Buffer,
+    NvU32 Bytes,
+    NvU32 *pBytesTransferred)
+{
+    NvBootError e;
+
+    NV_ASSERT(Buffer != NULL);
+    NV_ASSERT(pBytesTransferred != NULL);
+
+    *pBytesTransferred = 0;
+
+    if (s_Stalled)
+        return NvBootError_TxferFailed;
+
+    e = WriteAll(s_Fd, Buffer, Bytes);
+    if (e != NvBootError_Success)
+        return e;
+
+    *pBytesTransferred = Bytes;
+    s_Stats.NumTransfers++;
+    s_Stats.BytesTransferred += Bytes;
+
+    return NvBootError_Success;
+}
+
+NvBootError
+NvBootHostRcmHandleError(void)
+{
+    s_Stalled = NV_TRUE;
+    s_Stats.NumErrors++;
+
+    return NvBootError_Success;
+}
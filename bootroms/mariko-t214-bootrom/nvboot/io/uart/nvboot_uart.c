@@ -60,6 +60,44 @@ static const VT_NONSECURE uint8_t s_UartDivider115200[(int) NvBootClocksOscFreq_
 	26  // 26 MHz
 };
 
+// Same indexing as s_UartDivider115200.
+static const VT_NONSECURE uint16_t s_UartOscKhz[(int) NvBootClocksOscFreq_MaxVal] =
+{
+	13000,
+	16800,
+	0,
+	0,
+	19200,
+	38400,
+	0,
+	0,
+	12000,
+	48000,
+	0,
+	0,
+	26000
+};
+
+// CRC32 (IEEE 802.3, reflected) a nibble at a time. The 64-byte table keeps
+// the per-byte cost low enough to run while draining the FIFO at Mbaud rates.
+static const VT_NONSECURE NvU32 s_UartCrc32Nibble[16] =
+{
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+#define UART_CRC32_BYTE(Crc, Data)                                   \
+do {                                                                 \
+    (Crc) ^= (Data);                                                 \
+    (Crc) = ((Crc) >> 4) ^ s_UartCrc32Nibble[(Crc) & 0xF];           \
+    (Crc) = ((Crc) >> 4) ^ s_UartCrc32Nibble[(Crc) & 0xF];           \
+} while (0)
+
+#define UART_LSR_LINE_ERRORS (UART_LSR_0_BRK_FIELD  | UART_LSR_0_FERR_FIELD | \
+                              UART_LSR_0_PERR_FIELD | UART_LSR_0_OVRF_FIELD)
+
 // Macro that simplifies pin settings.
 #define SET_PIN(pin, f, v)                                                   \
 do {                                                                     \
@@ -423,6 +461,148 @@ NvBootUartPollingRead2(uint8_t *pDest, size_t *BytesRead, uint32_t timeout)
     return Err;    
 }
 
+NvBootError FT_NONSECURE
+NvBootUartPollingReadCrc32(uint8_t *pDest, size_t BytesRequested,
+    NvU32 *pCrc, uint32_t timeout)
+{
+    uint8_t Status, Data;
+    NvU32 Crc = ~(*pCrc);
+    uint32_t t0 = 0, t1;
+    bool Waiting = false;
+
+    while (BytesRequested)
+    {
+        Status = NV_READ8(NV_UARTA_LSR);
+        if (Status & UART_LSR_LINE_ERRORS)
+        {
+            NvBootUartFifoFlush();
+            *pCrc = ~Crc;
+            return NvBootError_ValidationFailure;
+        }
+        if (NV_DRF_VAL(UART,LSR,RDR,Status) == UART_LSR_0_RDR_DATA_IN_FIFO)
+        {
+            Data = NV_READ8(NV_UARTA_RBR);
+            *pDest++ = Data;
+            UART_CRC32_BYTE(Crc, Data);
+            BytesRequested--;
+            Waiting = false;
+            continue;
+        }
+
+        // Only read the timer while the FIFO is empty.
+        t1 = NvBootUtilGetTimeUS();
+        if (!Waiting)
+        {
+            t0 = t1;
+            Waiting = true;
+        }
+        else if ((t1 - t0) > timeout)
+        {
+            *pCrc = ~Crc;
+            return NvBootError_HwTimeOut;
+        }
+    }
+
+    *pCrc = ~Crc;
+    return NvBootError_Success;
+}
+
+void FT_NONSECURE
+NvBootUartDrainRx(uint32_t IdleUs)
+{
+    uint8_t Status;
+    uint32_t t0, t1;
+
+    t0 = t1 = NvBootUtilGetTimeUS();
+    while ((t1 - t0) <= IdleUs)
+    {
+        Status = NV_READ8(NV_UARTA_LSR);
+        if (Status & UART_LSR_LINE_ERRORS)
+        {
+            NvBootUartFifoFlush();
+            t0 = NvBootUtilGetTimeUS();
+        }
+        else if (NV_DRF_VAL(UART,LSR,RDR,Status) == UART_LSR_0_RDR_DATA_IN_FIFO)
+        {
+            (void) NV_READ8(NV_UARTA_RBR);
+            t0 = NvBootUtilGetTimeUS();
+        }
+        t1 = NvBootUtilGetTimeUS();
+    }
+}
+
+NvU32 FT_NONSECURE
+NvBootUartCrc32(NvU32 Crc, const uint8_t *pData, size_t Bytes)
+{
+    Crc = ~Crc;
+    while (Bytes--)
+    {
+        UART_CRC32_BYTE(Crc, *pData++);
+    }
+    return ~Crc;
+}
+
+NvBootError FT_NONSECURE
+NvBootUartFindClockDivisor(NvBootClocksOscFreq OscFreq, NvU32 BaudRate,
+    NvU32 *pClockDivisor, NvU32 *pOscKhz)
+{
+#if NVBOOT_TARGET_QT
+    // QT runs at a fixed 2400 baud, see NvBootUartInit().
+    return NvBootError_DeviceUnsupported;
+#else
+    NvU32 RegData;
+    NvU32 OscKhz, Divisor;
+
+    // The fast UART strap already runs off PLLC4 at 12 Mbaud.
+    RegData = NV_READ32(NV_ADDRESS_MAP_APB_MISC_BASE +
+                        APB_MISC_PP_STRAPPING_OPT_A_0);
+    if (NV_DRF_VAL(APB_MISC_PP, STRAPPING_OPT_A, BOOT_FAST_UART, RegData) ==
+        APB_MISC_PP_STRAPPING_OPT_A_0_BOOT_FAST_UART_FAST)
+    {
+        return NvBootError_DeviceUnsupported;
+    }
+
+    if ((NvU32) OscFreq >= (NvU32) NvBootClocksOscFreq_MaxVal)
+        return NvBootError_InvalidOscFrequency;
+
+    OscKhz = s_UartOscKhz[(NvU32) OscFreq];
+    if ((OscKhz == 0) || (BaudRate == 0))
+        return NvBootError_IllegalParameter;
+
+    // With CLK_M as source, baud = OscKhz * 1000 / (16 * divisor), and the
+    // 15.1 divisor field N gives a divisor of (N + 2) / 2, so
+    // baud = OscKhz * 125 / (N + 2). Search upward for the first rate not
+    // above BaudRate rather than divide; only step up from 115200.
+    for (Divisor = 0; Divisor < s_UartDivider115200[(NvU32) OscFreq]; Divisor++)
+    {
+        if (OscKhz * 125 <= BaudRate * (Divisor + 2))
+            break;
+    }
+
+    *pClockDivisor = Divisor;
+    *pOscKhz = OscKhz;
+    return NvBootError_Success;
+#endif
+}
+
+void FT_NONSECURE
+NvBootUartSetClockDivisor(NvU32 ClockDivisor)
+{
+    NvU32 RegData;
+
+    // Same method 2 switch as in NvBootUartInit(): CLK_M stays the source,
+    // only the divider changes.
+    RegData = 0;
+    RegData |= NV_DRF_DEF(CLK_RST_CONTROLLER, CLK_SOURCE_UARTA, UARTA_CLK_SRC, CLK_M);
+    RegData |= NV_DRF_DEF(CLK_RST_CONTROLLER, CLK_SOURCE_UARTA, UARTA_DIV_ENB, ENABLE);
+    RegData |= ClockDivisor;
+    NV_WRITE32(NV_ADDRESS_MAP_CAR_BASE+CLK_RST_CONTROLLER_CLK_SOURCE_UARTA_0, RegData);
+    NvBootUtilWaitUS(NVBOOT_CLOCKS_CLOCK_STABILIZATION_TIME);
+
+    // Drop whatever was sampled at the old rate.
+    NvBootUartFifoFlush();
+}
+
 void FT_NONSECURE
 NvBootUartFifoFlush()
 {
@@ -52,6 +52,169 @@ void NvBootUartSetupStack(void);
 
 extern void FT_NONSECURE NvBootUartJump(uintptr_t TargetAddress);
 
+// Block protocol timing. Hosts behind USB serial adapters deliver data in
+// bursts up to a latency timer (16 ms by default) apart.
+#define BLOCK_BYTE_TIMEOUT_US   500000
+#define BLOCK_IDLE_US           50000
+// Time for the host to change its own rate after reading the reply.
+#define BLOCK_SWITCH_DELAY_US   20000
+
+static void FT_NONSECURE
+NvBootUartBlockSendStatus(NvBootUart_BlockStatus *pStatus)
+{
+    size_t nWritten;
+
+    pStatus->Magic = NVBOOT_UART_BLOCK_MAGIC;
+    pStatus->Crc32 = NvBootUartCrc32(0, (const uint8_t *) pStatus,
+                                     offsetof(NvBootUart_BlockStatus, Crc32));
+    (void) NvBootUartPollingWrite((const uint8_t *) pStatus,
+                                  sizeof(NvBootUart_BlockStatus), &nWritten);
+}
+
+// Receive one pass of frames for the blocks still missing in pStatus.
+// Returns at the end of the pass or at the first frame that is not
+// received whole; blocks received with a good CRC are marked present.
+static void FT_NONSECURE
+NvBootUartBlockReceivePass(NvU8 *pPayload,
+                           NvU32 Length,
+                           NvU32 NumBlocks,
+                           NvBootUart_BlockStatus *pStatus)
+{
+    NvU32 Index, FrameIndex, BlockBytes;
+    NvU32 Crc, RxCrc, Dummy;
+    NvU32 Mask;
+
+    for (Index = 0; Index < NumBlocks; Index++)
+    {
+        Mask = 1U << (Index & 31);
+        if (!(pStatus->Missing[Index >> 5] & Mask))
+            continue;
+
+        BlockBytes = NVBOOT_UART_BLOCK_SIZE;
+        if (Index == NumBlocks - 1)
+            BlockBytes = Length - (Index << NVBOOT_UART_BLOCK_SIZE_LOG2);
+
+        Crc = 0;
+        if (NvBootUartPollingReadCrc32((NvU8 *) &FrameIndex, sizeof(FrameIndex),
+                                       &Crc, BLOCK_BYTE_TIMEOUT_US))
+            break;
+
+        // The host sends the missing blocks in order; anything else means
+        // the frames are out of step with the status it answers.
+        if (FrameIndex != Index)
+            break;
+
+        if (NvBootUartPollingReadCrc32(
+                pPayload + (Index << NVBOOT_UART_BLOCK_SIZE_LOG2),
+                BlockBytes, &Crc, BLOCK_BYTE_TIMEOUT_US))
+            break;
+
+        Dummy = 0;
+        if (NvBootUartPollingReadCrc32((NvU8 *) &RxCrc, sizeof(RxCrc),
+                                       &Dummy, BLOCK_BYTE_TIMEOUT_US))
+            break;
+
+        if (RxCrc == Crc)
+        {
+            pStatus->Missing[Index >> 5] &= ~Mask;
+            pStatus->NumMissing--;
+        }
+    }
+
+    if (Index < NumBlocks)
+    {
+        // Let the host finish sending the rest of the pass.
+        NvBootUartDrainRx(BLOCK_IDLE_US);
+    }
+}
+
+// Block protocol download, see nvboot_uart_int.h. The header has been
+// received at pHeader; the payload goes right after it.
+static NvBootError FT_NONSECURE
+NvBootUartBlockDownload(NvBootClocksOscFreq OscFreq,
+                        NvBootUart_Header *pHeader,
+                        NvU32 MaxLength)
+{
+    NvBootUart_BlockRequest Request;
+    NvBootUart_BlockReply Reply;
+    NvBootUart_BlockStatus Status;
+    NvU32 Length, NumBlocks, Crc, Dummy, i;
+    NvU32 ClockDivisor, OscKhz;
+    NvBool Accepted;
+    NvBootError e;
+    size_t nWritten;
+
+    Crc = NvBootUartCrc32(0, (const uint8_t *) pHeader,
+                          sizeof(NvBootUart_Header));
+    e = NvBootUartPollingReadCrc32((NvU8 *) &Request,
+                                   offsetof(NvBootUart_BlockRequest, Crc32),
+                                   &Crc, BLOCK_BYTE_TIMEOUT_US);
+    if (e == NvBootError_Success)
+    {
+        Dummy = 0;
+        e = NvBootUartPollingReadCrc32((NvU8 *) &Request.Crc32,
+                                       sizeof(Request.Crc32),
+                                       &Dummy, BLOCK_BYTE_TIMEOUT_US);
+    }
+
+    Length = pHeader->MainLength & ~NVBOOT_UART_BLOCK_MODE_FLAG;
+    NumBlocks = (Length + NVBOOT_UART_BLOCK_SIZE - 1) >>
+                NVBOOT_UART_BLOCK_SIZE_LOG2;
+
+    Accepted = (NvBool) ((e == NvBootError_Success) &&
+                         (Request.Magic == NVBOOT_UART_BLOCK_MAGIC) &&
+                         (Request.Crc32 == Crc) &&
+                         (Length != 0) &&
+                         (Length <= MaxLength) &&
+                         (NumBlocks <= NVBOOT_UART_BLOCK_MAX_BLOCKS));
+
+    ClockDivisor = NVBOOT_UART_BLOCK_KEEP_BAUD;
+    OscKhz = 0;
+    if (Accepted && (Request.BaudRate != 0) &&
+        (NvBootUartFindClockDivisor(OscFreq, Request.BaudRate,
+                                    &ClockDivisor, &OscKhz) != NvBootError_Success))
+    {
+        ClockDivisor = NVBOOT_UART_BLOCK_KEEP_BAUD;
+        OscKhz = 0;
+    }
+
+    Reply.Magic        = NVBOOT_UART_BLOCK_MAGIC;
+    Reply.Status       = Accepted ? NVBOOT_UART_BLOCK_ACK : NVBOOT_UART_BLOCK_NAK;
+    Reply.OscKhz       = OscKhz;
+    Reply.ClockDivisor = ClockDivisor;
+    Reply.NumBlocks    = NumBlocks;
+    Reply.Crc32        = NvBootUartCrc32(0, (const uint8_t *) &Reply,
+                                         offsetof(NvBootUart_BlockReply, Crc32));
+    (void) NvBootUartPollingWrite((const uint8_t *) &Reply, sizeof(Reply),
+                                  &nWritten);
+    if (!Accepted)
+        return NvBootError_ValidationFailure;
+
+    if (ClockDivisor != NVBOOT_UART_BLOCK_KEEP_BAUD)
+    {
+        NvBootUartSetClockDivisor(ClockDivisor);
+        NvBootUtilWaitUS(BLOCK_SWITCH_DELAY_US);
+    }
+
+    for (i = 0; i < NVBOOT_UART_BLOCK_BITMAP_WORDS; i++)
+        Status.Missing[i] = 0;
+    for (i = 0; i < NumBlocks; i++)
+        Status.Missing[i >> 5] |= 1U << (i & 31);
+    Status.NumMissing = NumBlocks;
+
+    for (i = 0; ; i++)
+    {
+        NvBootUartBlockSendStatus(&Status);
+        if (Status.NumMissing == 0)
+            return NvBootError_Success;
+        if (i == NVBOOT_UART_BLOCK_MAX_PASSES)
+            return NvBootError_TxferFailed;
+
+        NvBootUartBlockReceivePass((NvU8 *) pHeader + sizeof(NvBootUart_Header),
+                                   Length, NumBlocks, &Status);
+    }
+}
+
 
 // function that implements the download protocol
 void FT_NONSECURE NvBootUartDownload_internal (NvBootClocksOscFreq OscFreq)
@@ -64,6 +227,7 @@ void FT_NONSECURE NvBootUartDownload_internal (NvBootClocksOscFreq OscFreq)
     NvU32 Checksum, RxChecksum;
     NvU32 i;
     NvBool Success;
+    NvBool Failed = NV_FALSE;
     NvBootUart_Header *pHeader;
     NvBootECID Uid;
 
@@ -94,6 +258,11 @@ void FT_NONSECURE NvBootUartDownload_internal (NvBootClocksOscFreq OscFreq)
         NvBootUartInit(OscFreq, NV_FALSE);
         Success = NV_TRUE;
 
+        // Report the previous attempt only now: a block mode download may
+        // have left the UART at a faster rate, which the init undoes.
+        if (Failed)
+            (void) NvBootUartPollingWrite (FailMsg, sizeof(FailMsg)-1, &nWritten);
+
         // send the prompt
         // Ignore error code here, rely on checksum to force retry later on
         (void) NvBootUartPollingWrite(PromptMsg, sizeof(PromptMsg), &nWritten);
@@ -112,25 +281,36 @@ void FT_NONSECURE NvBootUartDownload_internal (NvBootClocksOscFreq OscFreq)
         // is not availible outside NVIDIA.
         const NvU32 stackSpace = 0x2000;
         NvU32 maxLength = (NVBOOT_BL_IRAM_END - stackSpace) - (NvU32) RxBuf;
-        if (length > maxLength) {
-            length = maxLength;
+
+        if (length & NVBOOT_UART_BLOCK_MODE_FLAG)
+        {
+            // framed blocks, each checked with its own CRC32
+            Success = (NvBool) (NvBootUartBlockDownload(OscFreq, pHeader,
+                                    maxLength - sizeof(NvBootUart_Header)) ==
+                                NvBootError_Success);
         }
+        else
+        {
+            if (length > maxLength) {
+                length = maxLength;
+            }
 
-        // ignore error code here, rely on checksum
-        (void) NvBootUartPollingRead((RxBuf + sizeof(NvBootUart_Header)), length, &nRead);
+            // ignore error code here, rely on checksum
+            (void) NvBootUartPollingRead((RxBuf + sizeof(NvBootUart_Header)), length, &nRead);
 
-        // check checksum
-        // the checksum is a 1's complement of the sum of all but the last 4 bytes
-        RxBuf = (NvU8 *) &BootConfigTable;
-        Checksum = 0;
-        for (i=0; i < length+sizeof(NvBootUart_Header) - sizeof(Checksum); i++)
-        {
-            Checksum += RxBuf[i];
+            // check checksum
+            // the checksum is a 1's complement of the sum of all but the last 4 bytes
+            RxBuf = (NvU8 *) &BootConfigTable;
+            Checksum = 0;
+            for (i=0; i < length+sizeof(NvBootUart_Header) - sizeof(Checksum); i++)
+            {
+                Checksum += RxBuf[i];
+            }
+            Checksum = ~Checksum;
+            RxChecksum = *((NvU32 *) & RxBuf[length + sizeof(NvBootUart_Header) -
+                                      sizeof(Checksum)]);
+            Success = Success && ((NvBool) (RxChecksum == Checksum));
         }
-        Checksum = ~Checksum;
-        RxChecksum = *((NvU32 *) & RxBuf[length + sizeof(NvBootUart_Header) -
-                                  sizeof(Checksum)]);
-        Success = Success && ((NvBool) (RxChecksum == Checksum));
 
         // Check UID if in FA mode
         if (NvBootFuseIsFailureAnalysisMode())
@@ -152,7 +332,7 @@ void FT_NONSECURE NvBootUartDownload_internal (NvBootClocksOscFreq OscFreq)
             break;
         } else
         {
-            (void) NvBootUartPollingWrite (FailMsg, sizeof(FailMsg)-1, &nWritten);
+            Failed = NV_TRUE;
         }
     };
     // FI mitigation; recheck state of chip before jumping to UART payload.
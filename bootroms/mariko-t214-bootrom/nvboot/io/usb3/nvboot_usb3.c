@@ -829,6 +829,8 @@ void NvBootXusbUpdateEpContext( NvBootUsb3Context *Context, USB_Endpoint_Type Ep
     // clear status
     EpContext->EpDw6.Status                 = 0;
     EpContext->EpDw7.DataOffset             = 0;
+    // bytes transferred, accumulated by the controller for this transfer
+    EpContext->EpDw5.EDTLA                  = 0;
 
     //This field represents the endpoint number on the device for which we need to do the transfer.
     //For control endpoint, DCI should be 1. For Bulk IN/OUT endpoints it should
@@ -941,6 +943,83 @@ void NvBootXusbUpdateWorkQ(NvBootUsb3Context *Context)
 }
 //_________________________________________________________________________________________________
 
+/**
+ * Pop, in one pass, the completion queue entries the BI posts for a
+ * transfer: any EPT_NRDY entries, the completion itself, then the
+ * NO_ACTIVITY entry that ends the transfer.
+ *
+ * Each pop is a fresh read-modify-write of CNTRL, as the hardware may
+ * update CNTRL while the entry is read. The trailing entry is read
+ * straight from DWRD0 without a VALID poll of its own.
+ *
+ * @param pSubKind SUBKIND of the completion
+ *
+ * @retval NvBootError_HwTimeOut No completion, or no trailing entry, in 1 s
+ * @retval NvBootError_XusbEpNotReady Nothing followed EPT_NRDY in 1 s
+ */
+static NvBootError
+NvBootXusbDrainCompQ(
+    NvBootUsb3Context *Context,
+    NvU32 BusInstanceOffset,
+    NvU32 *pSubKind)
+{
+    NvU32 CntrlOffset = 0, Dwrd0Offset = 0;
+    NvU32 Cntrl = 0, value = 0;
+    NvU32 SubKind = XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_EPT_NRDY;
+    NvU32 timeout = 0;
+    NvBool NotReady = NV_FALSE;
+
+    NV_XUSB_CSB_EXPAND(HS_BI_COMPLQ_CNTRL, CntrlOffset);
+    NV_XUSB_CSB_EXPAND(HS_BI_COMPLQ_DWRD0, Dwrd0Offset);
+    CntrlOffset += BusInstanceOffset;
+    Dwrd0Offset += BusInstanceOffset;
+
+    while(SubKind == XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_EPT_NRDY)
+    {
+        // while debugging on fpga this code timeout.. hence increasing this to 1 sec.
+        timeout = CONTROLLER_HW_RETRIES_1SEC;
+        while(timeout)
+        {
+            PciRegUpdate(Context, CntrlOffset, XUSB_READ, &Cntrl);
+            if(NV_PF_VAL(XUSB_CSB_HS_BI_COMPLQ_CNTRL_0, VALID , Cntrl))
+                break;
+            timeout--;
+            NvBootUtilWaitUS(TIMEOUT_1US);
+        }
+        if(!timeout)
+            return NotReady ? NvBootError_XusbEpNotReady : NvBootError_HwTimeOut;
+
+        PciRegUpdate(Context, Dwrd0Offset, XUSB_READ, &value);
+        SubKind = NV_PF_VAL(XUSB_CSB_HS_BI_COMPLQ_DWRD0_0, SUBKIND , value);
+        //Program the NV_PROJ__XUSB_CSB_HS_BI_COMPLQ_CNTRL_POP bit to '1'.
+        PciRegUpdate(Context, CntrlOffset, XUSB_READ, &Cntrl);
+        Cntrl = NV_FLD_SET_DRF_DEF(XUSB_CSB, HS_BI_COMPLQ_CNTRL, POP, SET, Cntrl);
+        PciRegUpdate(Context, CntrlOffset, XUSB_WRITE, &Cntrl);
+        NotReady = NV_TRUE;
+    }
+    *pSubKind = SubKind;
+
+    timeout = CONTROLLER_HW_RETRIES_1SEC;
+    while(timeout)
+    {
+        PciRegUpdate(Context, Dwrd0Offset, XUSB_READ, &value);
+
+        // check value for no activity!!
+        value = NV_PF_VAL(XUSB_CSB_HS_BI_COMPLQ_DWRD0_0, SUBKIND , value);
+        if(value == XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_NO_ACTIVITY)
+        {
+            //Program the NV_PROJ__XUSB_CSB_HS_BI_COMPLQ_CNTRL_POP bit to '1'.
+            PciRegUpdate(Context, CntrlOffset, XUSB_READ, &Cntrl);
+            Cntrl = NV_FLD_SET_DRF_DEF(XUSB_CSB, HS_BI_COMPLQ_CNTRL, POP, SET, Cntrl);
+            PciRegUpdate(Context, CntrlOffset, XUSB_WRITE, &Cntrl);
+            return NvBootError_Success;
+        }
+        timeout--;
+        NvBootUtilWaitUS(TIMEOUT_1US);
+    }
+    return NvBootError_HwTimeOut;
+}
+
 NvBootError NvBootXusbCheckCompQ(NvBootUsb3Context *Context)
 {
     NvBootError e = NvBootError_Success;
@@ -951,6 +1030,7 @@ NvBootError NvBootXusbCheckCompQ(NvBootUsb3Context *Context)
     USB_Endpoint_Type EpType = USB_NOT_VALID;
     EP *EndPtContext = Context->EndPtContext;
     NvU32 StallErr = 0;
+    NvU32 SubKind = 0;
 
     // Port0,1 => Bus Instance 0
     // Port 2 => Bus Instance 1
@@ -991,186 +1071,45 @@ NvBootError NvBootXusbCheckCompQ(NvBootUsb3Context *Context)
     {
         StallErr = 1;
     }
-    // The FW should check the NV_PROJ__XUSB_CSB_HSBI_COMPLQ_CNTRL_VALID bit
-
-   // while debugging on fpga this code timeout.. hence increasing this to 1 sec.
-    timeout = CONTROLLER_HW_RETRIES_1SEC;
-    while(timeout)
-    {
-        NV_XUSB_CSB_EXPAND(HS_BI_COMPLQ_CNTRL, RegOffset);
-        PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_READ, &value);
-        value = NV_PF_VAL(XUSB_CSB_HS_BI_COMPLQ_CNTRL_0, VALID , value);
-        if(value)
-            break;
-        timeout--;
-        NvBootUtilWaitUS(TIMEOUT_1US);
-    }
-
-    if((!value) && (!timeout))
+    // The FW should check the NV_PROJ__XUSB_CSB_HSBI_COMPLQ_CNTRL_VALID bit,
+    // then pop the completion and the entry that ends the transfer.
+    e = NvBootXusbDrainCompQ(Context, BusInstanceOffset, &SubKind);
+    if(e != NvBootError_Success)
     {
         // update another status entry for NvBootXusbStatus_CompQPollError
         Context->Usb3BitInfo->XusbDriverStatus = NvBootXusbStatus_CompQPollError;
-        return NvBootError_HwTimeOut;
+        return e;
     }
+    Context->Usb3BitInfo->XusbDriverStatus = NvBootXusbStatus_CompQPollEnd;
 
-    // check COMPLQ_DWRD0_SUBKIND until SUBKIND_OP_DONE || SUBKIND_EPT_ERROR || SUBKIND_EPT_DONE
-    //NV_PROJ__XUSB_CSB_HS_BI_COMPLQ_DWRD0_SUBKIND
-    NV_XUSB_CSB_EXPAND(HS_BI_COMPLQ_DWRD0, RegOffset);
-    PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_READ, &value);
-    value = NV_PF_VAL(XUSB_CSB_HS_BI_COMPLQ_DWRD0_0, SUBKIND , value);
-
-    //Program the NV_PROJ__XUSB_CSB_HS_BI_COMPLQ_CNTRL_POP bit to '1'.
-
-    if(value == XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_EPT_NRDY)
-    {
-        e = NvBootError_XusbEpNotReady;
-        NV_XUSB_CSB_EXPAND(HS_BI_COMPLQ_CNTRL, RegOffset);
-        PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_READ, &value);
-        value = NV_FLD_SET_DRF_DEF(XUSB_CSB, HS_BI_COMPLQ_CNTRL,POP, SET, value);
-        PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_WRITE , &value);
-        Context->Usb3BitInfo->XusbDriverStatus = NvBootXusbStatus_CompQPollEnd;
-
-        // while debugging on fpga this code timeout.. hence increasing this to 1 sec.
-        timeout = CONTROLLER_HW_RETRIES_1SEC;
-        while(timeout)
-        {
-            NV_XUSB_CSB_EXPAND(HS_BI_COMPLQ_DWRD0, RegOffset);
-            PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_READ, &value);
-
-            // check value for no activity!!
-            value = NV_PF_VAL(XUSB_CSB_HS_BI_COMPLQ_DWRD0_0, SUBKIND , value);
-
-            if(value != XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_EPT_NRDY)
-            {
-                //Program the NV_PROJ__XUSB_CSB_HS_BI_COMPLQ_CNTRL_POP bit to '1'.
-                NV_XUSB_CSB_EXPAND(HS_BI_COMPLQ_CNTRL, RegOffset);
-                PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_READ, &value);
-                value = NV_FLD_SET_DRF_DEF(XUSB_CSB, HS_BI_COMPLQ_CNTRL,POP, SET, value);
-                PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_WRITE , &value);
-                break;
-            }
-            timeout--;
-            NvBootUtilWaitUS(TIMEOUT_10US);
-        }
-        if(!timeout)
-        {
-            e = NvBootError_XusbEpNotReady;
-        }
-    else
-    {
-           e = NvBootError_Success;
-    }
-    }
-    else if((value == XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_OP_ERROR) ||
-        (value == XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_STOPREQ))
+    if((SubKind == XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_OP_ERROR) ||
+        (SubKind == XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_STOPREQ))
     {
         e =  NvBootError_DeviceResponseError;// should be controller specific CHECK
     }
-    else if (value == XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_EPT_ERROR)
+    else if (SubKind == XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_EPT_ERROR)
     {
         // only on XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_EPT_ERROR perform error handling!!
         e = NvBootError_XusbEpError;// perform error handling!!
     }
-
-    // readh NV_PROJ__XUSB_CSB_HS_BI_COMPLQ_DWRD1
-    // NV_PROJ__XUSB_CSB_HS_BI_COMPLQ_DWRD1_EPT_PTRLO
-    // NV_PROJ__XUSB_CSB_HS_BI_COMPLQ_DWRD1_EPT_PTRHI
-    if(value == XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_EPT_DONE)
+    else if(SubKind == XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_EPT_DONE)
     {
-        //Program the NV_PROJ__XUSB_CSB_HS_BI_COMPLQ_CNTRL_POP bit to '1'.
-        NV_XUSB_CSB_EXPAND(HS_BI_COMPLQ_CNTRL, RegOffset);
-        PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_READ, &value);
-        value = NV_FLD_SET_DRF_DEF(XUSB_CSB, HS_BI_COMPLQ_CNTRL,POP, SET, value);
-        PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_WRITE , &value);
-        Context->Usb3BitInfo->XusbDriverStatus = NvBootXusbStatus_CompQPollEnd;
-
-        e = NvBootError_Success;
-
-        // while debugging on fpga this code timeout.. hence increasing this to 1 sec.
-        timeout = CONTROLLER_HW_RETRIES_1SEC;
-        while(timeout)
-        {
-            NV_XUSB_CSB_EXPAND(HS_BI_COMPLQ_DWRD0, RegOffset);
-            PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_READ, &value);
-
-            // check value for no activity!!
-            value = NV_PF_VAL(XUSB_CSB_HS_BI_COMPLQ_DWRD0_0, SUBKIND , value);
-
-            if(value == XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_NO_ACTIVITY)
-            {
-                //Program the NV_PROJ__XUSB_CSB_HS_BI_COMPLQ_CNTRL_POP bit to '1'.
-                NV_XUSB_CSB_EXPAND(HS_BI_COMPLQ_CNTRL, RegOffset);
-                PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_READ, &value);
-                value = NV_FLD_SET_DRF_DEF(XUSB_CSB, HS_BI_COMPLQ_CNTRL,POP, SET, value);
-                PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_WRITE , &value);
-                break;
-            }
-            timeout--;
-            NvBootUtilWaitUS(TIMEOUT_1US);
-        }
+        //update sequence no.,
+        EpType = (USB_Endpoint_Type)(EndPtContext->EpDw1.EPType);
 
-        if(!timeout)
-        {
-            e = NvBootError_HwTimeOut;
-        }
-        else
+        if(EpType == USB_BULK_OUT)
         {
-            //update sequence no.,
-            EpType = (USB_Endpoint_Type)(EndPtContext->EpDw1.EPType);
-
-            if(EpType == USB_BULK_OUT)
-            {
-                if(StallErr)
-                    Context->BulkSeqNumOut = 0;
-                else
-                    Context->BulkSeqNumOut = (NvU32)(EndPtContext->EpDw5.SEQNUM);
-            }
-            else if (EpType == USB_BULK_IN)
-            {
-                if(StallErr)
-                    Context->BulkSeqNumIn = 0;
-                else
-                    Context->BulkSeqNumIn= (NvU32)(EndPtContext->EpDw5.SEQNUM);
-            }
-        }
-    }
-    else
-    {
-        // should not be here..
-        Context->Usb3BitInfo->XusbDriverStatus = NvBootXusbStatus_CompQPollError;
-        //Program the NV_PROJ__XUSB_CSB_HS_BI_COMPLQ_CNTRL_POP bit to '1'.
-        NV_XUSB_CSB_EXPAND(HS_BI_COMPLQ_CNTRL, RegOffset);
-        PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_READ, &value);
-        value = NV_FLD_SET_DRF_DEF(XUSB_CSB, HS_BI_COMPLQ_CNTRL,POP, SET, value);
-        PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_WRITE , &value);
-        Context->Usb3BitInfo->XusbDriverStatus = NvBootXusbStatus_CompQPollEnd;
-
-        // while debugging on fpga this code timeout.. hence increasing this to 1 sec.
-        timeout = CONTROLLER_HW_RETRIES_1SEC;
-        while(timeout)
-        {
-            NV_XUSB_CSB_EXPAND(HS_BI_COMPLQ_DWRD0, RegOffset);
-            PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_READ, &value);
-
-            // check value for no activity!!
-            value = NV_PF_VAL(XUSB_CSB_HS_BI_COMPLQ_DWRD0_0, SUBKIND , value);
-
-            if(value == XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_NO_ACTIVITY)
-            {
-                //Program the NV_PROJ__XUSB_CSB_HS_BI_COMPLQ_CNTRL_POP bit to '1'.
-                NV_XUSB_CSB_EXPAND(HS_BI_COMPLQ_CNTRL, RegOffset);
-                PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_READ, &value);
-                value = NV_FLD_SET_DRF_DEF(XUSB_CSB, HS_BI_COMPLQ_CNTRL,POP, SET, value);
-                PciRegUpdate(Context, RegOffset + BusInstanceOffset, XUSB_WRITE , &value);
-                break;
-            }
-            timeout--;
-            NvBootUtilWaitUS(TIMEOUT_1US);
+            if(StallErr)
+                Context->BulkSeqNumOut = 0;
+            else
+                Context->BulkSeqNumOut = (NvU32)(EndPtContext->EpDw5.SEQNUM);
         }
-
-        if(!timeout)
+        else if (EpType == USB_BULK_IN)
         {
-            e = NvBootError_HwTimeOut;
+            if(StallErr)
+                Context->BulkSeqNumIn = 0;
+            else
+                Context->BulkSeqNumIn= (NvU32)(EndPtContext->EpDw5.SEQNUM);
         }
     }
     // delay between ep status done to iram content access
@@ -2314,13 +2253,37 @@ NvBootUsb3Read(
     NvBootUsb3Context *Context = s_Usb3Context;
     NvU32 RetryCount = USB_MAX_TXFR_RETRIES;
     NvU32 LogicalBlkAddr;
-    uint16_t numPages;
+    NvU32 numPages;
+    uint8_t ReadOpcode;
 
     NV_ASSERT(Page < (1 << (s_Usb3Context->BlockSizeLog2) - (s_Usb3Context->PageSizeLog2)));
     NV_ASSERT(Dest != NULL);
     PRINT_USBH_MESSAGES("\r\nRead Block=%d, Page=%d", Block, Page);
 
-    //**************************READ ONE PAGE*************************
+    //**************************READ ALL PAGES*************************
+    //All Length bytes are read with one command, so the CBW and CSW stages are
+    //paid once per read however many pages it covers. READ(16) is used when
+    //the page count does not fit READ(10), or when the device is too large for
+    //READ CAPACITY(10) to report and so expects 16 byte commands.
+    numPages = CEIL_PAGE(Length, (1<<Context->PageSizeLog2));
+
+    //The data stage is split into TRBs at the 64 KiB boundaries of Dest,
+    //each a whole number of packets but the last, so a Dest that crosses
+    //one must be packet aligned.
+    if ((((NvU32)Dest & (USB_TRB_MAX_TFR_LENGTH - 1)) +
+         (numPages << Context->PageSizeLog2) > USB_TRB_MAX_TFR_LENGTH) &&
+        ((NvU32)Dest & (USB_TRB_AVERAGE_BULK_LENGTH - 1)))
+    {
+        Context->Usb3BitInfo->ReadPageReturnVal = NvBootError_IllegalParameter;
+        Context->Usb3BitInfo->DeviceStatus = NvBootDeviceStatus_ReadFailure;
+        return NvBootError_IllegalParameter;
+    }
+
+    if ((numPages > READ10_MAX_TRANSFER_LEN) ||
+        (Context->Usb3BitInfo->LastLogicalBlkAddr == READ_CAPACITY_LBA_OVERFLOW))
+        ReadOpcode = READ16_CMD_OPCODE;
+    else
+        ReadOpcode = READ10_CMD_OPCODE;
 
     //Before issuing READ10 command, need to test with TEST_UNIT_READY command for device readyness.
     //This if required can be guarded by CYA bit!
@@ -2337,13 +2300,12 @@ NvBootUsb3Read(
     {
             LogicalBlkAddr = ((Block << (Context->BlockSizeLog2 - (Context->PageSizeLog2))) + Page );
             INT_TO_BYTE_ARRAY(LogicalBlkAddr, Context->LogicalBlkAddr);
-            numPages = CEIL_PAGE(Length, (1<<Context->PageSizeLog2));
-            SHORT_TO_BYTE_ARRAY(numPages, Context->TransferLen);
+            INT_TO_BYTE_ARRAY(numPages, Context->TransferLen);
 
             //Make sure BufferData variable is initialized to requested destination address before issuing READ command
             Context->BufferData = Dest;
             //Send Read command
-            ErrorCode = NvBootXusbMscBotProcessRequest(Context, READ10_CMD_OPCODE);
+            ErrorCode = NvBootXusbMscBotProcessRequest(Context, ReadOpcode);
 
             if (ErrorCode == NvBootError_Success)
             {
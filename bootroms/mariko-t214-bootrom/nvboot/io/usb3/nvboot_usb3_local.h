@@ -130,6 +130,11 @@ enum { USB_HS_CONTROL_MAX_PACKETSIZE = 64,
 enum { USB_TRB_AVERAGE_CONTROL_LENGTH = 8,
             USB_TRB_AVERAGE_BULK_LENGTH = 512};
 
+/* Largest data buffer of one normal TRB, which must not cross a boundary of
+ * this size either (xHCI 4.11.7.1). Longer MSC data stages are received as a
+ * series of TRBs split at these boundaries. */
+enum { USB_TRB_MAX_TFR_LENGTH = 0x10000};
+
 /* Define for TR and data bufer memory location */
 enum { SYSTEM_MEM = 0, // iram
             DDIRECT = 1};       // dram
@@ -213,8 +213,10 @@ NvBootError NvBootXusbMscPrepareCDB(NvBootUsb3Context *Context)
     CommandBlockWrapper *BufferCBW = ((CommandBlockWrapper *)BufferXusbCmd);
     uint8_t *BufferCDB = BufferCBW->CBWCB;
     uint16_t TransferLen;
+    NvU32 TransferLen32;
 
     BYTE_ARRAY_TO_SHORT(Context->TransferLen, TransferLen);
+    BYTE_ARRAY_TO_INT(Context->TransferLen, TransferLen32);
 
     switch(BufferCBW->CBWTag)
     {
@@ -238,6 +240,19 @@ NvBootError NvBootXusbMscPrepareCDB(NvBootUsb3Context *Context)
                                         ((Read10CDB *)BufferCDB)->TransferLen_msb         = Context->TransferLen[1];
                                         ((Read10CDB *)BufferCDB)->TransferLen_lsb         = Context->TransferLen[0];
                                         break;
+        case READ16_CMD_OPCODE      :   // Upper 32 bits of the LBA stay 0: the reader addresses pages with 32 bits
+                                        BufferCBW->CBWDataTransferLength                = TransferLen32 << Context->PageSizeLog2;
+                                        BufferCBW->CBWFlags                             = CBWFlags_DATA_DIR_IN;
+                                        BufferCBW->CBWCBLength              = READ16_CMD_LEN;
+                                        ((Read16CDB *)BufferCDB)->LogicalBlkAddrByte4_msb = Context->LogicalBlkAddr[3];
+                                        ((Read16CDB *)BufferCDB)->LogicalBlkAddrByte3     = Context->LogicalBlkAddr[2];
+                                        ((Read16CDB *)BufferCDB)->LogicalBlkAddrByte2     = Context->LogicalBlkAddr[1];
+                                        ((Read16CDB *)BufferCDB)->LogicalBlkAddrByte1_lsb = Context->LogicalBlkAddr[0];
+                                        ((Read16CDB *)BufferCDB)->TransferLenByte4_msb    = Context->TransferLen[3];
+                                        ((Read16CDB *)BufferCDB)->TransferLenByte3        = Context->TransferLen[2];
+                                        ((Read16CDB *)BufferCDB)->TransferLenByte2        = Context->TransferLen[1];
+                                        ((Read16CDB *)BufferCDB)->TransferLenByte1_lsb    = Context->TransferLen[0];
+                                        break;
         case REQUESTSENSE_CMD_OPCODE :  BufferCBW->CBWDataTransferLength                = sizeof(RequestSenseResponse);
                                         BufferCBW->CBWCBLength              = REQUESTSENSE_CMD_LEN;
                                         BufferCBW->CBWFlags                             = CBWFlags_DATA_DIR_IN;
@@ -277,7 +292,9 @@ NvBootError NvBootXusbMscPrepareCDB(NvBootUsb3Context *Context)
     {
         //offset of opcode and LogicalUnitNum for all command types are same so it's ok to initialize in the end
         ((InquiryCDB *)BufferCDB)->opcode                           = BufferCBW->CBWTag;
-        ((InquiryCDB *)BufferCDB)->LogicalUnitNum                   = Context->stEnumerationInfo.LUN;
+        //except for READ(16), whose byte 1 holds flags
+        if (BufferCBW->CBWTag != READ16_CMD_OPCODE)
+            ((InquiryCDB *)BufferCDB)->LogicalUnitNum               = Context->stEnumerationInfo.LUN;
     }
     return ErrorCode;
 }
@@ -339,6 +356,7 @@ void NvBootXusbMscBotAnalyzeReceiveData(NvBootUsb3Context *Context, uint8_t opco
         case INQUIRY_CMD_OPCODE     :   Context->Usb3BitInfo->PeripheralDevTyp = ((InquiryResponse *)BufferXusbData)->PeripheralDevTyp;
                                         break;
         case READ10_CMD_OPCODE      :   //Handled in Read Page function 
+        case READ16_CMD_OPCODE      :
                                         break;
         case REQUESTSENSE_CMD_OPCODE :  Context->Usb3BitInfo->SenseKey =  ((RequestSenseResponse *)BufferXusbData)->SenseKey; //log the sense info in BIT
                                         break;
@@ -459,8 +477,10 @@ NvBootError NvBootXusbMscBotReceiveCSW(NvBootUsb3Context *Context)
 NvBootError NvBootXusbMscBotReceiveData(NvBootUsb3Context *Context, uint8_t opcode)
 {
     NvBootError ErrorCode = NvBootError_Success;
+    NvU32 Remaining, TRBTfrLen;
+    uint8_t *DataBuffer;
 
-    if((opcode != READ10_CMD_OPCODE)  && (opcode != WRITE10_CMD_OPCODE))
+    if((opcode != READ10_CMD_OPCODE) && (opcode != READ16_CMD_OPCODE) && (opcode != WRITE10_CMD_OPCODE))
     {
         //BufferXusbData is 16 byte aligned global memory area of size 128 bytes. 
         //This buffer is good enough for receiving reponses for commands other than READ and WRITE 
@@ -471,23 +491,56 @@ NvBootError NvBootXusbMscBotReceiveData(NvBootUsb3Context *Context, uint8_t opco
         Context->BufferData = (uint8_t*)((NvU32)BufferXusbData);
     }
 
-    //Refer to section 6.4.1 of Data Structures chapter of XHCI spec for more details about structure of normal TRB
-    // Compensate for XUSB vs R5 view of Sysram (T18x only)
-    //NvBootXusbPrepareNormalTRB(Context,Context->BufferData-SYSRAM_DIFFERENCE,((CommandBlockWrapper *)(BufferXusbCmd))->CBWDataTransferLength);
-    NvBootXusbPrepareNormalTRB(Context,Context->BufferData,((CommandBlockWrapper *)(BufferXusbCmd))->CBWDataTransferLength);
+    //A data stage longer than one TRB can describe is received as a series of
+    //TRBs, each submitted on its own, under the same CBW. The device streams
+    //the data stage regardless of how the host splits its bulk IN requests.
+    //A TRB buffer must not cross a 64 KiB boundary (xHCI 4.11.7.1), so each
+    //TRB ends at the next one, rounded down to whole packets of the size the
+    //endpoint context is given: only the last TRB may end in a short packet.
+    //A device may still end the data stage early with a short packet. The
+    //CSW comes next then, so no further TRB is queued, which would take it in.
+    Remaining  = ((CommandBlockWrapper *)(BufferXusbCmd))->CBWDataTransferLength;
+    DataBuffer = Context->BufferData;
+    do
+    {
+        TRBTfrLen = USB_TRB_MAX_TFR_LENGTH -
+                    ((NvU32)DataBuffer & (USB_TRB_MAX_TFR_LENGTH - 1));
+        if (TRBTfrLen < Remaining)
+        {
+            TRBTfrLen &= ~(USB_TRB_AVERAGE_BULK_LENGTH - 1);
+            //NvBootUsb3Read() only lets a packet aligned destination cross
+            //a boundary.
+            NV_ASSERT(TRBTfrLen != 0);
+        }
+        TRBTfrLen = NV_MIN(Remaining, TRBTfrLen);
 
-    NvBootXusbPrepareEndTRB(Context);
+        //Refer to section 6.4.1 of Data Structures chapter of XHCI spec for more details about structure of normal TRB
+        // Compensate for XUSB vs R5 view of Sysram (T18x only)
+        //NvBootXusbPrepareNormalTRB(Context,Context->BufferData-SYSRAM_DIFFERENCE,((CommandBlockWrapper *)(BufferXusbCmd))->CBWDataTransferLength);
+        NvBootXusbPrepareNormalTRB(Context,DataBuffer,TRBTfrLen);
 
-    // Update endpoint context structure
-    // For the endpoint context, refer to section 6.2.3 and please also refer to section 5.4.5.9 of the USB3 Frontend IAS at 
-    // https://p4viewer.nvidia.com/get///dev/stdif/usb3/1.0/doc/IAS/USB3_Frontend_IAS.doc
-    if (opcode == WRITE10_CMD_OPCODE)
-        NvBootXusbUpdateEpContext( Context, USB_BULK_OUT);
-    else 
-        NvBootXusbUpdateEpContext( Context, USB_BULK_IN);
+        NvBootXusbPrepareEndTRB(Context);
+
+        // Update endpoint context structure
+        // For the endpoint context, refer to section 6.2.3 and please also refer to section 5.4.5.9 of the USB3 Frontend IAS at 
+        // https://p4viewer.nvidia.com/get///dev/stdif/usb3/1.0/doc/IAS/USB3_Frontend_IAS.doc
+        if (opcode == WRITE10_CMD_OPCODE)
+            NvBootXusbUpdateEpContext( Context, USB_BULK_OUT);
+        else 
+            NvBootXusbUpdateEpContext( Context, USB_BULK_IN);
+
+        //Submit the request to workQ and wait for it to be completed by checking compQ
+        ErrorCode = NvBootXusbUpdWorkQAndChkCompQ(Context);
+
+        //EDTLA holds the bytes the TRB took; fewer than asked for is a short packet.
+        if((ErrorCode == NvBootError_Success) &&
+           (Context->EndPtContext->EpDw5.EDTLA < TRBTfrLen))
+            break;
+
+        DataBuffer += TRBTfrLen;
+        Remaining  -= TRBTfrLen;
+    } while((ErrorCode == NvBootError_Success) && (Remaining != 0));
 
-    //Submit the request to workQ and wait for it to be completed by checking compQ
-    ErrorCode = NvBootXusbUpdWorkQAndChkCompQ(Context);
     return ErrorCode;
 }
 //_________________________________________________________________________________________________
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Prints the task timing table of a BIT dump.
+ *
+ *   bit_decode FILE [OFFSET]
+ *
+ * FILE holds the BIT at OFFSET (default 0), e.g. a dump of IRAM from
+ * 0x40000000. One line per checkpoint, in the order the checkpoints
+ * first ran; poll hook waits are marked "wait" and overlap the tasks
+ * that ran meanwhile.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvboot_bit.h"
+#include "bit_layout.h"
+
+int main(int argc, char **argv)
+{
+    NvU8 Bit[NVBOOT_BIT_REQUIRED_SIZE];
+    NvBootTaskTiming Timing[NVBOOT_TASK_TIMING_DEPTH];
+    const NvBootTaskTiming *t;
+    NvU32 Dropped;
+    long Offset = 0;
+    FILE *f;
+    int i;
+
+    if (argc < 2 || argc > 3)
+    {
+        fprintf(stderr, "usage: %s FILE [OFFSET]\n", argv[0]);
+        return 2;
+    }
+    if (argc == 3)
+        Offset = strtol(argv[2], NULL, 0);
+
+    f = fopen(argv[1], "rb");
+    if (f == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    if (fseek(f, Offset, SEEK_SET) != 0 ||
+        fread(Bit, 1, sizeof(Bit), f) != sizeof(Bit))
+    {
+        fprintf(stderr, "%s: no BIT at offset %ld\n", argv[1], Offset);
+        fclose(f);
+        return 1;
+    }
+    fclose(f);
+
+    memcpy(&Dropped, &Bit[BIT_TASK_TIMING_DROPPED_OFFSET], sizeof(Dropped));
+    memcpy(Timing, &Bit[BIT_TASK_TIMING_OFFSET], sizeof(Timing));
+
+    printf("checkpoint      count    min us    max us   last us\n");
+    for (i = 0; i < NVBOOT_TASK_TIMING_DEPTH; i++)
+    {
+        t = &Timing[i];
+        if (t->Count == 0)
+            break;
+
+        printf("    0x%04x %-4s %6u %9u %9u %9u\n",
+               t->CheckPoint & ~NVBOOT_TASK_TIMING_POLL_WAIT,
+               (t->CheckPoint & NVBOOT_TASK_TIMING_POLL_WAIT) ? "wait" : "",
+               t->Count, t->MinUs, t->MaxUs, t->LastUs);
+    }
+    printf("%d of %d entries used, %u runs dropped\n", i,
+           NVBOOT_TASK_TIMING_DEPTH, Dropped);
+
+    return 0;
+}
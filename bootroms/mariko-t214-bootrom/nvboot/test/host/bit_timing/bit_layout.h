@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * bit_layout.h - Offsets of the task timing fields in a BIT dump.
+ *
+ * NvBootInfoTable holds pointers, so the host layout differs from the
+ * Boot ROM one. The timing fields are the last ones of the BIT and hold
+ * no pointers; their Boot ROM offsets follow from the BIT size.
+ * layout_probe.c checks these against the 32-bit layout.
+ */
+
+#ifndef INCLUDED_BIT_LAYOUT_H
+#define INCLUDED_BIT_LAYOUT_H
+
+#define BIT_TASK_TIMING_OFFSET                                          \
+    (NVBOOT_BIT_REQUIRED_SIZE -                                         \
+     NVBOOT_TASK_TIMING_DEPTH * sizeof(NvBootTaskTiming))
+#define BIT_TASK_TIMING_DROPPED_OFFSET  (BIT_TASK_TIMING_OFFSET - 4)
+
+#endif // INCLUDED_BIT_LAYOUT_H
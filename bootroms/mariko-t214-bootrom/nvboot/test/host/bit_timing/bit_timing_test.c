@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of the task timing table both dispatchers keep in the BIT.
+ *
+ * A non-secure list and a secure list with a poll hook run twice, at two
+ * task costs, on the simulated clock. The table must hold one entry per
+ * checkpoint with exact min/max/last times, and one for the poll wait.
+ * The table is then written as a BIT dump, bit_timing.img, in the Boot
+ * ROM layout for bit_decode. A list with more checkpoints than entries
+ * must count its overflow in TaskTimingDropped instead of wrapping.
+ */
+
+#include "host_tasks.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "nvboot_bit.h"
+#include "host_clock.h"
+#include "bit_layout.h"
+
+#define IMAGE_PATH  "bit_timing.img"
+
+/* Cost of the SDRAM-like task's wait for its hardware. */
+#define LOCK_US     50
+
+NvBootInfoTable BootInfoTable;
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "bit_timing: %s:%d: %s\n", __FILE__,        \
+                    __LINE__, #Cond);                                   \
+        }                                                               \
+    } while (0)
+
+/* Task costs in us, multiplied by s_Scale. */
+static const NvU32 s_Cost[] = { 5, 7, 10, 30, 20, 5 };
+static NvU32 s_Scale = 1;
+static NvU32 s_LockDeadline;
+
+#define TASK(i)                                                         \
+    static NvBootError T##i(void)                                       \
+    {                                                                   \
+        HostClockAdvance(s_Cost[i] * s_Scale);                          \
+        return NvBootError_Success;                                     \
+    }
+TASK(0) TASK(1) TASK(2) TASK(4) TASK(5)
+
+/* Starts the hardware; PollLock() finds it ready LOCK_US later. */
+static NvBootError T3(void)
+{
+    HostClockAdvance(s_Cost[3] * s_Scale);
+    s_LockDeadline = HostClockNow() + LOCK_US;
+    return NvBootError_Success;
+}
+
+static NvBootError PollLock(void)
+{
+    HostClockAdvance(1);
+    return (HostClockNow() < s_LockDeadline) ? NvBootError_Busy :
+                                               NvBootError_Success;
+}
+
+static NvBootError Tick(void)
+{
+    HostClockAdvance(1);
+    return NvBootError_Success;
+}
+
+static const NvBootTask s_ListNS[] = {
+    { &T0, 0x01 },
+    { &T1, 0x02 },
+};
+
+static const NvBootTask s_List[] = {
+    { &T2, 0x101 },
+    { &T3, 0x102, 0, &PollLock },
+    { &T4, 0x103, TASK_DEPS_NONE },
+    { &T5, 0x104 },
+};
+
+static const NvBootTaskTiming *Find(NvU32 CheckPoint)
+{
+    int i;
+
+    for (i = 0; i < NVBOOT_TASK_TIMING_DEPTH; i++)
+    {
+        if (BootInfoTable.TaskTiming[i].Count != 0 &&
+            BootInfoTable.TaskTiming[i].CheckPoint == CheckPoint)
+            return &BootInfoTable.TaskTiming[i];
+    }
+    return NULL;
+}
+
+static void CheckEntry(NvU32 CheckPoint, NvU32 Count, NvU32 MinUs,
+                       NvU32 MaxUs, NvU32 LastUs)
+{
+    const NvBootTaskTiming *t = Find(CheckPoint);
+
+    CHECK(t != NULL);
+    if (t == NULL)
+        return;
+    CHECK(t->Count == Count);
+    CHECK(t->MinUs == MinUs);
+    CHECK(t->MaxUs == MaxUs);
+    CHECK(t->LastUs == LastUs);
+}
+
+static int Used(void)
+{
+    int i;
+
+    for (i = 0; i < NVBOOT_TASK_TIMING_DEPTH; i++)
+    {
+        if (BootInfoTable.TaskTiming[i].Count == 0)
+            break;
+    }
+    return i;
+}
+
+static void Boot(NvU32 Scale)
+{
+    s_Scale = Scale;
+    CHECK(NvBootNonsecureDispatcher() == 0);
+    CHECK(NvBootSecureDispatcher(NvBootTaskListId_ColdBoot) ==
+          NvBootError_Success);
+}
+
+static int WriteImage(void)
+{
+    static NvU8 Bit[NVBOOT_BIT_REQUIRED_SIZE];
+    FILE *f;
+
+    memcpy(&Bit[BIT_TASK_TIMING_DROPPED_OFFSET],
+           &BootInfoTable.TaskTimingDropped, 4);
+    memcpy(&Bit[BIT_TASK_TIMING_OFFSET], BootInfoTable.TaskTiming,
+           sizeof(BootInfoTable.TaskTiming));
+
+    f = fopen(IMAGE_PATH, "wb");
+    if (f == NULL || fwrite(Bit, 1, sizeof(Bit), f) != sizeof(Bit))
+    {
+        perror(IMAGE_PATH);
+        return 1;
+    }
+    fclose(f);
+    return 0;
+}
+
+static void CheckTimings(void)
+{
+    HostClockInit();
+    HostTasksSetNS(s_ListNS, 2);
+    HostTasksSet(s_List, 4);
+
+    /*
+     * The non-secure dispatcher restarts the table, so run it once and
+     * then the secure list twice, as a coldboot and a retry would.
+     */
+    Boot(1);
+    s_Scale = 2;
+    CHECK(NvBootSecureDispatcher(NvBootTaskListId_ColdBoot) ==
+          NvBootError_Success);
+
+    CheckEntry(0x01, 1, 5, 5, 5);
+    CheckEntry(0x02, 1, 7, 7, 7);
+    CheckEntry(0x101, 2, 10, 20, 20);
+    CheckEntry(0x102, 2, 30, 60, 60);
+    CheckEntry(0x103, 2, 20, 40, 40);
+    CheckEntry(0x104, 2, 5, 10, 10);
+
+    /*
+     * The wait runs from the return of 0x102 to the poll that finds the
+     * lock, whatever ran in between.
+     */
+    CheckEntry(0x102 | NVBOOT_TASK_TIMING_POLL_WAIT, 2, LOCK_US, LOCK_US,
+               LOCK_US);
+    CHECK(Used() == 7);
+    CHECK(BootInfoTable.TaskTimingDropped == 0);
+}
+
+static void CheckOverflow(void)
+{
+    static NvBootTask List[TASK_MAX_PER_LIST];
+    int i;
+
+    for (i = 0; i < TASK_MAX_PER_LIST; i++)
+    {
+        List[i].funcPtr = &Tick;
+        List[i].checkPoint = 0x200 + i;
+    }
+
+    /* The non-secure dispatcher starts the table from scratch. */
+    CHECK(NvBootNonsecureDispatcher() == 0);
+    CHECK(Used() == 2);
+
+    HostTasksSet(List, TASK_MAX_PER_LIST);
+    CHECK(NvBootSecureDispatcher(NvBootTaskListId_ColdBoot) ==
+          NvBootError_Success);
+    CHECK(Used() == NVBOOT_TASK_TIMING_DEPTH);
+    CHECK(BootInfoTable.TaskTimingDropped ==
+          2 + TASK_MAX_PER_LIST - NVBOOT_TASK_TIMING_DEPTH);
+
+    /* Checkpoints already in the table keep counting, nothing wraps. */
+    CHECK(NvBootSecureDispatcher(NvBootTaskListId_ColdBoot) ==
+          NvBootError_Success);
+    CheckEntry(0x200, 2, 1, 1, 1);
+    CHECK(Find(0x200 + TASK_MAX_PER_LIST - 1) == NULL);
+    CHECK(BootInfoTable.TaskTimingDropped ==
+          2 * (2 + TASK_MAX_PER_LIST - NVBOOT_TASK_TIMING_DEPTH));
+    CHECK(BootInfoTable.TaskTiming[0].CheckPoint == 0x01);
+}
+
+int main(void)
+{
+    CHECK(sizeof(NvBootTaskTiming) == 16);
+
+    CheckTimings();
+    if (WriteImage())
+        return 1;
+    CheckOverflow();
+
+    printf("bit_timing: %u checks, %u failures\n", s_Cases, s_Failures);
+    return s_Failures != 0;
+}
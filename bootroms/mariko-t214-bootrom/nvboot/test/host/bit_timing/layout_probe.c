@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * IRAM layout probe, compiled for 32-bit and never linked.
+ *
+ * It fails to compile if the BIT, the BCT and the crypto manager buffers
+ * do not fit the 16 KB .IRAM region of nvboot.ld, or if the timing fields
+ * are not where bit_decode looks for them. The objects below carry the
+ * sizes, which "make bench" prints from the symbol table.
+ */
+
+#include <stddef.h>
+
+#include "nvboot_bit.h"
+#include "nvboot_bct.h"
+#include "nvboot_crypto_mgr_int.h"
+#include "bit_layout.h"
+
+NV_CT_ASSERT(sizeof(NvBootInfoTable) == NVBOOT_BIT_REQUIRED_SIZE);
+NV_CT_ASSERT(sizeof(NvBootInfoTable) <= 0x700);
+NV_CT_ASSERT(sizeof(NvBootInfoTable) + sizeof(NvBootConfigTable) +
+             sizeof(NvBootCryptoMgrBuffers) <= 0x4000);
+
+NV_CT_ASSERT(offsetof(NvBootInfoTable, TaskTiming) == BIT_TASK_TIMING_OFFSET);
+NV_CT_ASSERT(offsetof(NvBootInfoTable, TaskTimingDropped) ==
+             BIT_TASK_TIMING_DROPPED_OFFSET);
+
+char IramBit[sizeof(NvBootInfoTable)];
+char IramBct[sizeof(NvBootConfigTable)];
+char IramCryptoBuffers[sizeof(NvBootCryptoMgrBuffers)];
@@ -0,0 +1,5 @@
+/*
+ * The host has no 32-bit C library headers. layout_probe.c is built
+ * freestanding, and nvcommon.h only needs the fixed-width types.
+ */
+#include <stdint.h>
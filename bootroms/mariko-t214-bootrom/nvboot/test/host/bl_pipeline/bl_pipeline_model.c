@@ -0,0 +1,572 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Model of the two SE instances under the BL package authentication and
+ * decryption of core/cryptomgr/nvboot_crypto_mgr.c.
+ *
+ * nvboot_crypto_mgr.c is built unchanged. The SE driver functions it calls
+ * are replaced by a model of each instance: its AES key slots, and one
+ * operation at a time that takes SETUP_US plus its bytes at the engine's
+ * rate on the simulated TMRUS (common/host_clock.c). An operation does its
+ * memory access when the driver polls it done: a SHA reads its chunk, an
+ * AES-CBC decrypt reads and writes its blocks, with the software SHA and
+ * AES code. The sequential path reaches SE1 through ShaDevMgr and
+ * AesDevMgr, which the model points at blocking calls on the same
+ * instance.
+ *
+ * The model checks the driver contract as it goes: no operation is started
+ * on a busy instance, and no two operations in flight touch the same bytes
+ * where either writes them.
+ *
+ * "check" runs packages of several lengths through the pipeline and the
+ * sequential path, tampered ones, and the cases that fall back or fail.
+ * "bench" prints the crypto time of each path. The rates are assumptions,
+ * not measurements; the gain depends on their ratio, so both equal rates
+ * and an AES at half the SHA rate are shown.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "nvboot_crypto_mgr_int.h"
+#include "nvboot_aes_devmgr_int.h"
+#include "nvboot_sha_devmgr_int.h"
+#include "nvboot_se_int.h"
+#include "nvboot_context_int.h"
+#include "nvboot_config.h"
+#include "nvboot_sw_aes_int.h"
+#include "arse.h"
+#include "host_clock.h"
+
+/* The package is loaded at the start of SDRAM, which the model maps. */
+#define PACKAGE_ADDRESS     NVBOOT_BL_SDRAM_START
+#define MAX_PACKAGE         (2 * 1024 * 1024)
+
+/* Assumed engine costs: a start, and bytes per microsecond. */
+#define SETUP_US            2
+#define SHA_BYTES_PER_US    400
+
+#define NUM_INSTANCES       2
+#define BLOCK               NVBOOT_AES_BLOCK_LENGTH_BYTES
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "bl_pipeline: %s:%d: %s\n", __FILE__,       \
+                    __LINE__, #Cond);                                   \
+        }                                                               \
+    } while (0)
+
+NvBootContext Context;
+int32_t FI_counter1;
+
+/* The crypto manager state, not declared by its header. */
+extern NvBootCryptoMgrContext s_CryptoMgrContext;
+extern NvBootCryptoMgrBuffers s_CryptoMgr_Buffers;
+extern NvBootShaDevMgr ShaDevMgr;
+extern NvBootAesDevMgr AesDevMgr;
+
+typedef enum
+{
+    Op_Idle,
+    Op_Sha,
+    Op_Decrypt,
+} ModelOp;
+
+typedef struct
+{
+    NvU8 Key[32];
+    NvU8 OriginalIv[BLOCK];
+    NvU8 UpdatedIv[BLOCK];
+} ModelKeySlot;
+
+typedef struct
+{
+    ModelKeySlot Slots[NvBootSeAesKeySlot_Num];
+
+    /* The operation in flight and what it touches. */
+    ModelOp Op;
+    NvU32 DoneUs;
+    NvU8 *Src;
+    NvU8 *Dst;
+    NvU32 Bytes;
+    NvU8 KeySlot;
+    NvU8 KeySize;
+    NvBool First;
+    NvBool Last;
+    NvU32 *Digest;
+
+    /* The message the SHA has read so far. */
+    NvU8 Message[MAX_PACKAGE];
+    NvU32 MessageBytes;
+
+    NvU32 Ops;
+    NvU32 BusyUs;
+} ModelSe;
+
+static ModelSe s_Se[NUM_INSTANCES];
+static NvU32 s_AesBytesPerUs = SHA_BYTES_PER_US;
+static unsigned s_Conflicts;
+static NvBootShaDevMgr s_SwSha;
+
+static NvBootAesKeySize ModelKeySize(NvU8 KeySize)
+{
+    switch (KeySize)
+    {
+        case SE_MODE_PKT_AESMODE_KEY192:
+            return AES_KEY_192;
+        case SE_MODE_PKT_AESMODE_KEY256:
+            return AES_KEY_256;
+        default:
+            return AES_KEY_128;
+    }
+}
+
+static NvBool Overlaps(const NvU8 *a, const NvU8 *b, NvU32 Bytes)
+{
+    return a && b && (a < b + Bytes) && (b < a + Bytes);
+}
+
+/* Starts an operation on an idle instance, and checks it against the other. */
+static void ModelStart(NvBootSeInstance Instance, ModelOp Op, NvU8 *Src,
+                       NvU8 *Dst, NvU32 Bytes)
+{
+    ModelSe *Se = &s_Se[Instance];
+    ModelSe *Other = &s_Se[!Instance];
+    NvU32 Rate = (Op == Op_Sha) ? SHA_BYTES_PER_US : s_AesBytesPerUs;
+    NvU32 Us = SETUP_US + (Bytes + Rate - 1) / Rate;
+
+    CHECK(Se->Op == Op_Idle);
+    if (Other->Op != Op_Idle)
+    {
+        /* Both may read the same bytes; neither may write the other's. */
+        if (Overlaps(Dst, Other->Src, Bytes) ||
+            Overlaps(Dst, Other->Dst, Bytes) ||
+            Overlaps(Src, Other->Dst, Bytes))
+            s_Conflicts++;
+    }
+
+    Se->Op = Op;
+    Se->Src = Src;
+    Se->Dst = Dst;
+    Se->Bytes = Bytes;
+    Se->DoneUs = HostClockNow() + Us;
+    Se->Ops++;
+    Se->BusyUs += Us;
+}
+
+/* Waits for the operation in flight and does its memory access. */
+static void ModelFinish(NvBootSeInstance Instance)
+{
+    ModelSe *Se = &s_Se[Instance];
+    ModelKeySlot *Slot = &Se->Slots[Se->KeySlot];
+    NvU8 Ks[NVBOOT_AES_MAX_KEYSCHED_BYTES] __attribute__((aligned(16)));
+    NvU8 LastBlock[BLOCK];
+    NvBootAesKeySize KeySize;
+
+    if (Se->Op == Op_Idle)
+        return;
+    if (HostClockNow() < Se->DoneUs)
+        HostClockAdvance(Se->DoneUs - HostClockNow());
+
+    if (Se->Op == Op_Sha)
+    {
+        if (Se->First)
+            Se->MessageBytes = 0;
+        memcpy(&Se->Message[Se->MessageBytes], Se->Src, Se->Bytes);
+        Se->MessageBytes += Se->Bytes;
+        if (Se->Last)
+            s_SwSha.ShaDevMgrCallbacks->ShaHash((uint32_t *)Se->Message,
+                                                Se->MessageBytes, Se->Digest,
+                                                &s_SwSha.ShaConfig);
+    }
+    else
+    {
+        /* The updated IV is the last ciphertext block, read before an
+         * in-place decrypt overwrites it. */
+        KeySize = ModelKeySize(Se->KeySize);
+        memcpy(LastBlock, Se->Src + Se->Bytes - BLOCK, BLOCK);
+        NvAesExpandKey(Slot->Key, Ks, KeySize);
+        NvAesDecryptObject(Ks, Se->First ? Slot->OriginalIv : Slot->UpdatedIv,
+                           Se->Src, Se->Dst, Se->Bytes / BLOCK, KeySize);
+        memcpy(Slot->UpdatedIv, LastBlock, BLOCK);
+    }
+    Se->Op = Op_Idle;
+}
+
+uint32_t NvBootSeKeySizeConv(NvBootAesKeySize KeySize)
+{
+    switch (KeySize)
+    {
+        case AES_KEY_192:
+            return SE_MODE_PKT_AESMODE_KEY192;
+        case AES_KEY_256:
+            return SE_MODE_PKT_AESMODE_KEY256;
+        default:
+            return SE_MODE_PKT_AESMODE_KEY128;
+    }
+}
+
+void NvBootSeInstanceKeySlotWriteKeyIV(NvBootSeInstance Instance, NvU8 KeySlot,
+                                       NvU8 KeySize, NvU8 KeyType,
+                                       NvU32 *KeyData)
+{
+    ModelKeySlot *Slot = &s_Se[Instance].Slots[KeySlot];
+    NvU8 *Words;
+
+    (void)KeySize;
+    switch (KeyType)
+    {
+        case SE_CRYPTO_KEYIV_PKT_WORD_QUAD_KEYS_0_3:
+            Words = &Slot->Key[0];
+            break;
+        case SE_CRYPTO_KEYIV_PKT_WORD_QUAD_KEYS_4_7:
+            Words = &Slot->Key[16];
+            break;
+        case SE_CRYPTO_KEYIV_PKT_WORD_QUAD_ORIGINAL_IVS:
+            Words = Slot->OriginalIv;
+            break;
+        default:
+            Words = Slot->UpdatedIv;
+            break;
+    }
+    if (KeyData)
+        memcpy(Words, KeyData, 16);
+    else
+        memset(Words, 0, 16);
+}
+
+void NvBootSeInstanceSHA256HashChunkStart(NvBootSeInstance SeInstance,
+                                          NvU32 *pChunk, NvU32 ChunkSizeBytes,
+                                          NvU32 MessageSizeBytes,
+                                          NvU32 MessageBytesLeft,
+                                          NvU32 *pOutputDestination)
+{
+    ModelSe *Se = &s_Se[SeInstance];
+    NvBool Last = (ChunkSizeBytes == MessageBytesLeft);
+
+    /* The engine keeps its state between chunks only on whole blocks. */
+    CHECK(ChunkSizeBytes <= MessageBytesLeft);
+    CHECK(Last || ((ChunkSizeBytes % 64) == 0));
+    CHECK(MessageSizeBytes <= MAX_PACKAGE);
+
+    ModelStart(SeInstance, Op_Sha, (NvU8 *)pChunk, NULL, ChunkSizeBytes);
+    Se->First = (MessageBytesLeft == MessageSizeBytes);
+    Se->Last = Last;
+    Se->Digest = pOutputDestination;
+}
+
+void NvBootSeInstanceAesDecryptStart(NvBootSeInstance SeInstance, NvU8 KeySlot,
+                                     NvU8 KeySize, NvBool First,
+                                     NvU32 NumBlocks, NvU8 *Src, NvU8 *Dst)
+{
+    ModelSe *Se = &s_Se[SeInstance];
+
+    CHECK(NumBlocks > 0);
+    CHECK(KeySlot < NvBootSeAesKeySlot_Num);
+
+    ModelStart(SeInstance, Op_Decrypt, Src, Dst, NumBlocks * BLOCK);
+    Se->KeySlot = KeySlot;
+    Se->KeySize = KeySize;
+    Se->First = First;
+}
+
+NvBool NvBootSeInstanceIsEngineBusy(NvBootSeInstance Instance, NvU8 *DestAddr)
+{
+    (void)DestAddr;
+    ModelFinish(Instance);
+    return NV_FALSE;
+}
+
+/* ShaDevMgr and AesDevMgr of the sequential path: blocking calls on SE1. */
+static NvBootError ModelShaHash(const uint32_t *InputMessage,
+                                uint32_t InputMessageLength, uint32_t *Hash,
+                                NvBootCryptoShaConfig *ShaConfig)
+{
+    (void)ShaConfig;
+    NvBootSeInstanceSHA256HashChunkStart(NvBootSeInstance_Se1,
+                                         (NvU32 *)InputMessage,
+                                         InputMessageLength,
+                                         InputMessageLength,
+                                         InputMessageLength, Hash);
+    ModelFinish(NvBootSeInstance_Se1);
+    return NvBootError_Success;
+}
+
+static NvBootError ModelClearOriginalIv(uint8_t KeySlot)
+{
+    memset(s_Se[NvBootSeInstance_Se1].Slots[KeySlot].OriginalIv, 0, BLOCK);
+    return NvBootError_Success;
+}
+
+static NvBootError ModelClearUpdatedIv(uint8_t KeySlot)
+{
+    memset(s_Se[NvBootSeInstance_Se1].Slots[KeySlot].UpdatedIv, 0, BLOCK);
+    return NvBootError_Success;
+}
+
+static NvBootError ModelDecryptCBC(const uint8_t *Ciphertext,
+                                   uint8_t *Plaintext, uint8_t KeySlot,
+                                   NvBootAesKeySize KeySize,
+                                   size_t NumBytes)
+{
+    NvBootSeInstanceAesDecryptStart(NvBootSeInstance_Se1, KeySlot,
+                                    NvBootSeKeySizeConv(KeySize), NV_TRUE,
+                                    (NumBytes + BLOCK - 1) / BLOCK,
+                                    (NvU8 *)Ciphertext, Plaintext);
+    ModelFinish(NvBootSeInstance_Se1);
+    return NvBootError_Success;
+}
+
+static NvBootShaDevMgrCallbacks s_ModelShaCallbacks;
+static NvBootAesDevMgrCallbacks s_ModelAesCallbacks;
+
+/* The package under test, its plaintext and the key. */
+static NvU8 *const s_Package = (NvU8 *)PACKAGE_ADDRESS;
+static NvU8 s_Plain[MAX_PACKAGE];
+static NvU8 s_Key[16];
+static NvBootOemBootBinaryHeader s_Header;
+static NvU32 s_Rand = 1;
+
+static NvU32 Xorshift(void)
+{
+    s_Rand ^= s_Rand << 13;
+    s_Rand ^= s_Rand >> 17;
+    s_Rand ^= s_Rand << 5;
+    return s_Rand;
+}
+
+static void MapPackage(void)
+{
+    void *p = mmap((void *)PACKAGE_ADDRESS, MAX_PACKAGE,
+                   PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if (p != (void *)PACKAGE_ADDRESS)
+    {
+        fprintf(stderr, "bl_pipeline: cannot map SDRAM at 0x%lx\n",
+                (unsigned long)PACKAGE_ADDRESS);
+        abort();
+    }
+}
+
+/*
+ * Encrypts a fresh package of Length bytes with the BEK, zero IV, and sets
+ * up the crypto manager as after the header was authenticated. The key is
+ * in KeySlot of both instances, as NvBootCryptoMgrLoadOemAesKeys() leaves
+ * the BEK.
+ */
+static void Prepare(NvU32 Length, NvU8 KeySlot)
+{
+    NvU8 Ks[NVBOOT_AES_MAX_KEYSCHED_BYTES] __attribute__((aligned(16)));
+    NvU32 i;
+
+    for (i = 0; i < sizeof(s_Key); i++)
+        s_Key[i] = Xorshift();
+    for (i = 0; i < Length; i++)
+        s_Plain[i] = Xorshift();
+
+    memset(s_Se, 0, sizeof(s_Se));
+    for (i = 0; i < NUM_INSTANCES; i++)
+        memcpy(s_Se[i].Slots[KeySlot].Key, s_Key, sizeof(s_Key));
+
+    NvAesExpandKey(s_Key, Ks, AES_KEY_128);
+    NvAesEncryptObject(Ks, s_Plain, s_Package, Length / BLOCK, AES_KEY_128);
+
+    memset(&s_Header, 0, sizeof(s_Header));
+    s_Header.Length = Length;
+    s_Header.LoadAddress = PACKAGE_ADDRESS;
+
+    s_CryptoMgrContext.EncryptionScheme = CryptoAlgo_AES;
+    s_CryptoMgrContext.AesKeySize = AES_KEY_128;
+    s_CryptoMgrContext.IsOemBootBinaryHeaderAuthenticated =
+        OEM_HEADER_AUTHENTICATED;
+    Context.FactorySecureProvisioningMode = NV_FALSE;
+    s_SwSha.ShaDevMgrCallbacks->ShaHash((uint32_t *)s_Package, Length,
+        (uint32_t *)&s_CryptoMgr_Buffers.OemBootBinaryHash,
+        &s_SwSha.ShaConfig);
+
+    s_Conflicts = 0;
+    HostClockInit();
+}
+
+static NvBootError RunSequential(void)
+{
+    NvBootError e;
+
+    e = NvBootCryptoMgrAuthBlPackage(&s_Header, (uint32_t *)s_Package);
+    if (e != NvBootError_Success)
+        return e;
+    return NvBootCryptoMgrDecryptBlPackage(&s_Header, (uint32_t *)s_Package);
+}
+
+static NvBootError RunPipelined(void)
+{
+    return NvBootCryptoMgrAuthDecryptBlPackage(&s_Header,
+                                               (uint32_t *)s_Package);
+}
+
+static NvBool IsZero(const NvU8 *p, NvU32 Bytes)
+{
+    NvU32 i;
+
+    for (i = 0; i < Bytes; i++)
+    {
+        if (p[i])
+            return NV_FALSE;
+    }
+    return NV_TRUE;
+}
+
+static const NvU32 s_Lengths[] =
+{
+    16, 4096, 64 * 1024 - 16, 64 * 1024, 64 * 1024 + 16, 100000,
+    256 * 1024, 1024 * 1024 + 4096,
+};
+
+#define NUM_LENGTHS (sizeof(s_Lengths) / sizeof(s_Lengths[0]))
+
+static void CheckPackages(void)
+{
+    NvU32 i, Length, Chunks;
+
+    for (i = 0; i < NUM_LENGTHS; i++)
+    {
+        Length = s_Lengths[i];
+        Chunks = (Length + NVBOOT_CRYPTO_BL_PIPELINE_CHUNK_BYTES - 1) /
+                 NVBOOT_CRYPTO_BL_PIPELINE_CHUNK_BYTES;
+
+        Prepare(Length, AES_DEVICE_KEYSLOT_BEK);
+        CHECK(RunPipelined() == NvBootError_Success);
+        CHECK(!memcmp(s_Package, s_Plain, Length));
+        CHECK(s_Conflicts == 0);
+        CHECK(s_Se[NvBootSeInstance_Se1].Ops == Chunks);
+        CHECK(s_Se[NvBootSeInstance_Se2].Ops == Chunks);
+
+        /* A flipped bit anywhere is caught, and nothing is left behind. */
+        Prepare(Length, AES_DEVICE_KEYSLOT_BEK);
+        s_Package[Xorshift() % Length] ^= 1 << (Xorshift() % 8);
+        CHECK(RunPipelined() == NvBootError_CryptoMgr_BlBinaryPackage_Auth_Error);
+        CHECK(IsZero(s_Package, Length));
+
+        Prepare(Length, AES_DEVICE_KEYSLOT_BEK);
+        CHECK(RunSequential() == NvBootError_Success);
+        CHECK(!memcmp(s_Package, s_Plain, Length));
+    }
+}
+
+static void CheckFallbacks(void)
+{
+    /* FSKP decrypts with a key only SE1 has, on the sequential path. */
+    Prepare(256 * 1024, AES_DEVICE_KEYSLOT_FSKP_DECRYPT);
+    memset(s_Se[NvBootSeInstance_Se2].Slots, 0,
+           sizeof(s_Se[NvBootSeInstance_Se2].Slots));
+    Context.FactorySecureProvisioningMode = NV_TRUE;
+    CHECK(RunPipelined() == NvBootError_Success);
+    CHECK(!memcmp(s_Package, s_Plain, 256 * 1024));
+    CHECK(s_Se[NvBootSeInstance_Se2].Ops == 0);
+
+    /* An unencrypted package is hashed and left as it is. */
+    Prepare(4096, AES_DEVICE_KEYSLOT_BEK);
+    memcpy(s_Package, s_Plain, 4096);
+    s_SwSha.ShaDevMgrCallbacks->ShaHash((uint32_t *)s_Package, 4096,
+        (uint32_t *)&s_CryptoMgr_Buffers.OemBootBinaryHash,
+        &s_SwSha.ShaConfig);
+    s_CryptoMgrContext.EncryptionScheme = CryptoAlgo_None;
+    CHECK(RunPipelined() == NvBootError_Success);
+    CHECK(!memcmp(s_Package, s_Plain, 4096));
+    CHECK(s_Se[NvBootSeInstance_Se2].Ops == 0);
+
+    /* Nothing runs before the header is authenticated. */
+    Prepare(4096, AES_DEVICE_KEYSLOT_BEK);
+    s_CryptoMgrContext.IsOemBootBinaryHeaderAuthenticated = 0;
+    CHECK(RunPipelined() ==
+          NvBootError_CryptoMgr_OemBootBinaryHeader_NotAuthenticated);
+    CHECK(s_Se[NvBootSeInstance_Se1].Ops + s_Se[NvBootSeInstance_Se2].Ops == 0);
+
+    /* Nor for a load address outside SDRAM and BL IRAM. */
+    Prepare(4096, AES_DEVICE_KEYSLOT_BEK);
+    s_Header.LoadAddress = NV_ADDRESS_MAP_IROM_BASE;
+    CHECK(RunPipelined() == NvBootError_Invalid_Bl_Size_And_Or_Destination);
+    CHECK(s_Se[NvBootSeInstance_Se1].Ops + s_Se[NvBootSeInstance_Se2].Ops == 0);
+}
+
+static int Check(void)
+{
+    CheckPackages();
+    CheckFallbacks();
+
+    printf("bl_pipeline: %u checks, %u failures\n", s_Cases, s_Failures);
+    return s_Failures != 0;
+}
+
+static int Bench(void)
+{
+    static const NvU32 Rates[] = { SHA_BYTES_PER_US, SHA_BYTES_PER_US / 2 };
+    NvU32 r, i, Length, Seq, Pipe;
+
+    printf("crypto time in us: SHA-256 at %u bytes/us, %u us per start\n",
+           SHA_BYTES_PER_US, SETUP_US);
+    for (r = 0; r < sizeof(Rates) / sizeof(Rates[0]); r++)
+    {
+        s_AesBytesPerUs = Rates[r];
+        printf("AES-CBC at %u bytes/us\n", s_AesBytesPerUs);
+        printf("  %10s %12s %12s %8s\n", "bytes", "sequential", "pipelined",
+               "ratio");
+        for (i = 0; i < NUM_LENGTHS; i++)
+        {
+            Length = s_Lengths[i];
+            Prepare(Length, AES_DEVICE_KEYSLOT_BEK);
+            RunSequential();
+            Seq = HostClockNow();
+            Prepare(Length, AES_DEVICE_KEYSLOT_BEK);
+            RunPipelined();
+            Pipe = HostClockNow();
+            printf("  %10u %12u %12u %8.2f\n", Length, Seq, Pipe,
+                   (double)Pipe / Seq);
+        }
+    }
+    s_AesBytesPerUs = SHA_BYTES_PER_US;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    /* NvBootInitializeNvBootError() reads the clock. */
+    HostClockInit();
+    MapPackage();
+
+    if (NvBootShaDevMgrInit(&s_SwSha, NvBootShaDevice_SW) != NvBootError_Success)
+    {
+        fprintf(stderr, "bl_pipeline: the software SHA device is not built\n");
+        return 1;
+    }
+
+    s_ModelShaCallbacks.ShaHash = ModelShaHash;
+    ShaDevMgr.ShaDevMgrCallbacks = &s_ModelShaCallbacks;
+    ShaDevMgr.ShaConfig = s_SwSha.ShaConfig;
+    s_ModelAesCallbacks.ClearOriginalIv = ModelClearOriginalIv;
+    s_ModelAesCallbacks.ClearUpdatedIv = ModelClearUpdatedIv;
+    s_ModelAesCallbacks.AesDecryptCBC = ModelDecryptCBC;
+    AesDevMgr.AesDevMgrCallbacks = &s_ModelAesCallbacks;
+
+    if ((argc > 1) && !strcmp(argv[1], "bench"))
+        return Bench();
+    return Check();
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * crypto_mgr_stubs.c - The functions nvboot_crypto_mgr.c calls outside the
+ * BL package path: initialization, key loading, fuses and RSA. The model
+ * does not run those parts, so reaching any of these aborts.
+ *
+ * The symbols are defined without their headers, so that one macro fits
+ * all of them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MODEL_STUB(Name)                                        \
+    void Name(void)                                             \
+    {                                                           \
+        fprintf(stderr, "bl_pipeline: %s called\n", #Name);     \
+        abort();                                                \
+    }
+
+MODEL_STUB(NvBootAesDevMgrInit)
+MODEL_STUB(NvBootRsaDevMgrInit)
+MODEL_STUB(NvBootCryptoRsaSsaPssInit)
+MODEL_STUB(NvBootCryptoRsaSsaPssVerify)
+MODEL_STUB(NvBootFuseBootSecurityIsEncryptionEnabled)
+MODEL_STUB(NvBootFuseGetBootSecurityAuthenticationInfo)
+MODEL_STUB(NvBootFuseGetFuseDecryptionKeySelection)
+MODEL_STUB(NvBootFuseGetOemFekBankSelect)
+MODEL_STUB(NvBootFuseGetPcpHash)
+MODEL_STUB(NvBootFuseGetSecureProvisionIndex)
+MODEL_STUB(NvBootFuseGetSecureProvisioningIndexValidity)
+MODEL_STUB(NvBootFuseIsNvProductionMode)
+MODEL_STUB(NvBootFuseIsOemFuseEncryptionEnabled)
+MODEL_STUB(NvBootFuseIsPkcBootMode)
+MODEL_STUB(NvBootPkaHwInit)
+MODEL_STUB(NvBootRngInit)
+MODEL_STUB(NvBootSeDisableAesKeySlotRead)
+MODEL_STUB(NvBootSeInitializeSE)
+MODEL_STUB(NvBootSeInstanceAesDecryptKeyIntoKeySlot)
@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Timing model of the coldboot task list.
+ *
+ * The task lists below have the shape of ColdBootTasks[] in
+ * nvboot_tasks_s.c: before the SDRAM setup was split around the bootloader
+ * header prefetch, split and run in order, and split with the dependencies
+ * and PLLM poll hook the list has now. The boot device reinit follows the
+ * SDRAM init in all of them. They run on the real NvBootSecureDispatcher()
+ * with a simulated TMRUS (common/host_clock.c). The tasks are stand-ins: they
+ * advance the clock by the costs in the table below, except that the boot
+ * device I/O goes through the real device manager and host_file, whose
+ * modelled device time is added to the clock. The read-ahead cache and
+ * its reinit behavior are therefore those of the tree.
+ *
+ * The costs are assumptions, not measurements: only the PLL lock time is
+ * the tree's NVBOOT_CLOCKS_PLL_STABILIZATION_DELAY. Change them to see
+ * how the gain depends on them.
+ *
+ * "bench" prints a timeline of each list and its critical path: from the
+ * last task back, the task or hardware wait that ended when each step
+ * started. The dispatcher runs one task at a time, so that is the step
+ * that held it up.
+ */
+
+#include "host_tasks.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvboot_bit.h"
+#include "nvboot_clocks.h"
+#include "nvboot_devmgr_int.h"
+#include "nvboot_host_file_int.h"
+#include "nvboot_util_int.h"
+#include "host_clock.h"
+
+#define IMAGE_PATH  "coldboot.img"
+#define IMAGE_SIZE  (1024 * 1024)
+
+/* Assumed costs, in microseconds. */
+#define COST_SE_ATOMIC_SAVE     5
+#define COST_COLDBOOT_INIT      200     /* Fuses, straps, device init */
+#define COST_PLLM_START         10
+#define COST_PLLM_LOCK          NVBOOT_CLOCKS_PLL_STABILIZATION_DELAY
+#define COST_SDRAM_INIT         1000    /* EMC programming and BCT waits */
+#define COST_REINIT             100     /* Device clock and bus width */
+#define COST_BL_AUTH            400     /* Header and MB1 hash on the SE */
+#define COST_DEFAULT_SE_KEYS    20
+#define COST_POLL               1       /* One PLL lock register read */
+
+/* Boot device: an eMMC-like cost, as in devmgr_cache. */
+#define DEV_READ_LATENCY_US     100
+#define DEV_PAGE_LATENCY_US     5
+
+/* The sizes of this tree, and an assumed 128KB MB1 in block 4. */
+#define BCT_SIZE                10240
+#define HEADER_SIZE             368
+#define MB1_SIZE                (128 * 1024)
+#define MB1_BLOCK               4
+
+#define MAX_TASKS               16
+
+NvBootInfoTable BootInfoTable;
+extern NvBootDevContext s_DeviceContext;
+
+static NvBootDevMgr s_DevMgr;
+static uint8_t s_Bct[BCT_SIZE];
+static uint8_t s_Header[4096];
+static uint8_t s_Mb1[MB1_SIZE];
+
+static NvU32 s_PllmLockedUs;
+static NvU32 s_LastReads;
+static NvU64 s_LastBytes;
+
+/* Timeline of the current run: task runs, and PLLM waits seen by polls. */
+typedef struct
+{
+    int CheckPoint;
+    NvU32 StartUs;
+    NvU32 EndUs;
+    NvBool Wait;
+} TaskSpan;
+
+static TaskSpan s_Spans[MAX_TASKS];
+static int s_NumSpans;
+static int s_NumRuns;
+
+static void AddSpan(int CheckPoint, NvU32 StartUs, NvBool Wait)
+{
+    if (s_NumSpans < MAX_TASKS)
+    {
+        s_Spans[s_NumSpans].CheckPoint = CheckPoint;
+        s_Spans[s_NumSpans].StartUs = StartUs;
+        s_Spans[s_NumSpans].EndUs = HostClockNow();
+        s_Spans[s_NumSpans].Wait = Wait;
+        s_NumSpans++;
+    }
+}
+
+static void Span(int CheckPoint, NvU32 StartUs)
+{
+    AddSpan(CheckPoint, StartUs, NV_FALSE);
+    s_NumRuns++;
+}
+
+/* Adds the device time of the reads issued since the last call. */
+static void DeviceTime(void)
+{
+    NvBootHostFileContext *Dev = &s_DeviceContext.HostFileContext;
+
+    HostClockAdvance((Dev->NumReads - s_LastReads) * DEV_READ_LATENCY_US +
+                     NV_ICEIL(Dev->BytesRead - s_LastBytes,
+                              1 << Dev->PageSizeLog2) * DEV_PAGE_LATENCY_US);
+    s_LastReads = Dev->NumReads;
+    s_LastBytes = Dev->BytesRead;
+}
+
+/* Waits for PLLM the way the undivided SDRAM setup does. */
+static void WaitPllm(void)
+{
+    if (HostClockNow() < s_PllmLockedUs)
+        HostClockAdvance(s_PllmLockedUs - HostClockNow());
+}
+
+static NvBootError SeEnableAtomicSave(void)
+{
+    NvU32 Start = HostClockNow();
+
+    HostClockAdvance(COST_SE_ATOMIC_SAVE);
+    Span(0x101, Start);
+    return NvBootError_Success;
+}
+
+static NvBootError ColdBootInit(void)
+{
+    NvU32 Start = HostClockNow();
+
+    if (NvBootDevMgrInit(&s_DevMgr, NvBootDevType_HostFile, 0) !=
+        NvBootError_Success)
+        return NvBootError_DeviceError;
+    HostClockAdvance(COST_COLDBOOT_INIT);
+    Span(0x102, Start);
+    return NvBootError_Success;
+}
+
+static NvBootError ColdBootReadBct(void)
+{
+    NvU32 Start = HostClockNow();
+    NvBootError e;
+
+    e = NvBootDevMgrRead(&s_DevMgr, 0, 0, BCT_SIZE, s_Bct);
+    DeviceTime();
+    Span(0x103, Start);
+    return e;
+}
+
+/* Before the split: start PLLM, wait for lock, initialize SDRAM. */
+static NvBootError ColdBootSetupSdram(void)
+{
+    NvU32 Start = HostClockNow();
+
+    HostClockAdvance(COST_PLLM_START);
+    s_PllmLockedUs = HostClockNow() + COST_PLLM_LOCK;
+    WaitPllm();
+    HostClockAdvance(COST_SDRAM_INIT);
+    Span(0x104, Start);
+    return NvBootError_Success;
+}
+
+static NvBootError ColdBootSdramBegin(void)
+{
+    NvU32 Start = HostClockNow();
+
+    HostClockAdvance(COST_PLLM_START);
+    s_PllmLockedUs = HostClockNow() + COST_PLLM_LOCK;
+    Span(0x108, Start);
+    return NvBootError_Success;
+}
+
+/* Poll hook: PLLM is locked once the clock passes the lock time. */
+static NvBootError ColdBootSdramPoll(void)
+{
+    HostClockAdvance(COST_POLL);
+    if (HostClockNow() < s_PllmLockedUs)
+        return NvBootError_Busy;
+
+    AddSpan(0x108, s_PllmLockedUs - COST_PLLM_LOCK, NV_TRUE);
+    return NvBootError_Success;
+}
+
+static NvBootError ColdBootSdramComplete(void)
+{
+    NvU32 Start = HostClockNow();
+
+    WaitPllm();
+    HostClockAdvance(COST_SDRAM_INIT);
+    Span(0x10a, Start);
+    return NvBootError_Success;
+}
+
+static NvBootError ColdBootReInit(void)
+{
+    NvU32 Start = HostClockNow();
+    NvBootDevParams Params;
+    NvBootHostFileParams *HostParams = (NvBootHostFileParams *)&Params;
+    NvBootError e;
+
+    memset(&Params, 0, sizeof(Params));
+    HostParams->PageSizeLog2  = HOST_FILE_PAGESIZELOG2;
+    HostParams->BlockSizeLog2 = HOST_FILE_BLOCKSIZELOG2;
+    e = NvBootDevMgrReinitDevice(&s_DevMgr, &Params, 1, 0);
+    /* Init() clears the read statistics of host_file. */
+    s_LastReads = 0;
+    s_LastBytes = 0;
+    HostClockAdvance(COST_REINIT);
+    Span(0x105, Start);
+    return e;
+}
+
+static NvBootError ColdBootPrefetchBl(void)
+{
+    NvU32 Start = HostClockNow();
+    NvBootError e;
+
+    e = NvBootDevMgrPrefetch(&s_DevMgr, MB1_BLOCK, 0, HEADER_SIZE);
+    DeviceTime();
+    Span(0x109, Start);
+    return e;
+}
+
+/* The reads of LoadOneBootLoader(), then the authentication. */
+static NvBootError ColdBootLoadBl(void)
+{
+    NvU32 Start = HostClockNow();
+    NvU32 PageSize = 1 << s_DevMgr.PageSizeLog2;
+    NvU32 HeaderBytes = ALIGN_ADDR(HEADER_SIZE, PageSize);
+    NvBootError e;
+
+    e = NvBootDevMgrRead(&s_DevMgr, MB1_BLOCK, 0, HeaderBytes, s_Header);
+    if (e == NvBootError_Success)
+        e = NvBootDevMgrRead(&s_DevMgr, MB1_BLOCK, HeaderBytes / PageSize,
+                             MB1_SIZE - (HeaderBytes - HEADER_SIZE), s_Mb1);
+    DeviceTime();
+    HostClockAdvance(COST_BL_AUTH);
+    Span(0x106, Start);
+    return e;
+}
+
+static NvBootError LoadDefaultSEKeys(void)
+{
+    NvU32 Start = HostClockNow();
+
+    HostClockAdvance(COST_DEFAULT_SE_KEYS);
+    Span(0x107, Start);
+    return NvBootError_Success;
+}
+
+/* ColdBootTasks[] before the SDRAM setup was split. */
+static const NvBootTask s_BeforeSplit[] = {
+    { &SeEnableAtomicSave,      0x101 },
+    { &ColdBootInit,            0x102 },
+    { &ColdBootReadBct,         0x103 },
+    { &ColdBootSetupSdram,      0x104 },
+    { &ColdBootReInit,          0x105 },
+    { &ColdBootLoadBl,          0x106 },
+    { &LoadDefaultSEKeys,       0x107 },
+};
+
+/* The split list, run in order: the prefetch hides in the PLLM lock. */
+static const NvBootTask s_Split[] = {
+    { &SeEnableAtomicSave,      0x101 },
+    { &ColdBootInit,            0x102 },
+    { &ColdBootReadBct,         0x103 },
+    { &ColdBootSdramBegin,      0x108 },
+    { &ColdBootPrefetchBl,      0x109 },
+    { &ColdBootSdramComplete,   0x10a },
+    { &ColdBootReInit,          0x105 },
+    { &ColdBootLoadBl,          0x106 },
+    { &LoadDefaultSEKeys,       0x107 },
+};
+
+/* ColdBootTasks[] as it is: the dispatcher runs tasks while PLLM locks. */
+static const NvBootTask s_Scheduled[] = {
+    { &SeEnableAtomicSave,      0x101 },
+    { &ColdBootInit,            0x102 },
+    { &ColdBootReadBct,         0x103 },
+    { &ColdBootSdramBegin,      0x108, 0, &ColdBootSdramPoll },
+    { &ColdBootPrefetchBl,      0x109, TASK_DEPS(TASK_DEP(2)) },
+    { &ColdBootSdramComplete,   0x10a, TASK_DEPS(TASK_DEP(3)) },
+    { &ColdBootReInit,          0x105 },
+    { &ColdBootLoadBl,          0x106 },
+    { &LoadDefaultSEKeys,       0x107 },
+};
+
+static const struct
+{
+    const char *Name;
+    const NvBootTask *List;
+    int Count;
+} s_Lists[] = {
+    { "before split", s_BeforeSplit, sizeof(s_BeforeSplit) / sizeof(NvBootTask) },
+    { "split",        s_Split,       sizeof(s_Split) / sizeof(NvBootTask) },
+    { "scheduled",    s_Scheduled,   sizeof(s_Scheduled) / sizeof(NvBootTask) },
+};
+
+#define NUM_LISTS (int)(sizeof(s_Lists) / sizeof(s_Lists[0]))
+
+static int WriteImage(void)
+{
+    static uint8_t Image[IMAGE_SIZE];
+    NvBootHostFileParams Params;
+    NvU32 i;
+    FILE *f;
+
+    for (i = 0; i < IMAGE_SIZE; i += 4)
+        memcpy(&Image[i], &i, 4);
+
+    f = fopen(IMAGE_PATH, "wb");
+    if (f == NULL || fwrite(Image, 1, IMAGE_SIZE, f) != IMAGE_SIZE)
+    {
+        perror(IMAGE_PATH);
+        return 1;
+    }
+    fclose(f);
+
+    memset(&Params, 0, sizeof(Params));
+    Params.PageSizeLog2  = HOST_FILE_PAGESIZELOG2;
+    Params.BlockSizeLog2 = HOST_FILE_BLOCKSIZELOG2;
+    return NvBootHostFileOpen(IMAGE_PATH, &Params) != NvBootError_Success;
+}
+
+/* Runs list i through the dispatcher; returns the boot time or 0. */
+static NvU32 Run(int i)
+{
+    NvBootError e;
+
+    HostClockInit();
+    memset(&BootInfoTable, 0, sizeof(BootInfoTable));
+    memset(&s_DevMgr, 0, sizeof(s_DevMgr));
+    s_NumSpans = 0;
+    s_NumRuns = 0;
+    HostTasksRandomDelays = 0;
+    s_LastReads = 0;
+    s_LastBytes = 0;
+    s_PllmLockedUs = 0;
+
+    HostTasksSet(s_Lists[i].List, s_Lists[i].Count);
+    e = NvBootSecureDispatcher(NvBootTaskListId_ColdBoot);
+    if (e != NvBootError_Success)
+    {
+        fprintf(stderr, "coldboot: %s: error 0x%x\n", s_Lists[i].Name,
+                (unsigned)e);
+        return 0;
+    }
+
+    /*
+     * Every task ran once with both random delays, and the rest of MB1
+     * came from past its header.
+     */
+    if (s_NumRuns != s_Lists[i].Count ||
+        HostTasksRandomDelays != 2 * (unsigned)s_Lists[i].Count ||
+        *(NvU32 *)s_Mb1 != (MB1_BLOCK << HOST_FILE_BLOCKSIZELOG2) +
+            ALIGN_ADDR(HEADER_SIZE, 1 << HOST_FILE_PAGESIZELOG2))
+    {
+        fprintf(stderr, "coldboot: %s: wrong task runs or data\n",
+                s_Lists[i].Name);
+        return 0;
+    }
+
+    return HostClockNow();
+}
+
+static void PrintTimeline(int i)
+{
+    NvU32 Total = HostClockNow();
+    int t, c;
+
+    printf("%s: %u us, %u bytes served by the read-ahead cache\n",
+           s_Lists[i].Name, Total, BootInfoTable.ReadAheadStatus.BytesSaved);
+    for (t = 0; t < s_NumSpans; t++)
+    {
+        printf("  0x%03x %-4s %5u..%5u |", s_Spans[t].CheckPoint,
+               s_Spans[t].Wait ? "wait" : "", s_Spans[t].StartUs,
+               s_Spans[t].EndUs);
+        for (c = 0; c < 60; c++)
+        {
+            NvU32 At = Total * c / 60;
+            putchar(At >= s_Spans[t].StartUs && At < s_Spans[t].EndUs ? '#' : ' ');
+        }
+        printf("|\n");
+    }
+}
+
+/* The span that ended last at or before Us, other than Skip. */
+static int EndedBefore(NvU32 Us, int Skip)
+{
+    int Best = -1;
+    int t;
+
+    for (t = 0; t < s_NumSpans; t++)
+    {
+        if (t == Skip || s_Spans[t].EndUs > Us)
+            continue;
+        if (Best < 0 || s_Spans[t].EndUs > s_Spans[Best].EndUs)
+            Best = t;
+    }
+    return Best;
+}
+
+static void PrintCriticalPath(void)
+{
+    int Path[MAX_TASKS];
+    int Len = 0;
+    int t;
+
+    t = EndedBefore(HostClockNow(), -1);
+    while (t >= 0 && Len < MAX_TASKS)
+    {
+        Path[Len++] = t;
+        t = EndedBefore(s_Spans[t].StartUs, t);
+    }
+
+    printf("  critical path:");
+    while (Len-- > 0)
+    {
+        t = Path[Len];
+        printf(" 0x%03x%s %u%s", s_Spans[t].CheckPoint,
+               s_Spans[t].Wait ? " wait" : "",
+               s_Spans[t].EndUs - s_Spans[t].StartUs, Len ? " ->" : "\n");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    NvBool Bench = (argc > 1 && !strcmp(argv[1], "bench"));
+    NvU32 Time[NUM_LISTS];
+    int i;
+
+    if (WriteImage())
+        return 1;
+
+    for (i = 0; i < NUM_LISTS; i++)
+    {
+        Time[i] = Run(i);
+        if (Time[i] == 0)
+            return 1;
+        if (Bench)
+        {
+            PrintTimeline(i);
+            PrintCriticalPath();
+        }
+    }
+
+    remove(IMAGE_PATH);
+
+    printf("coldboot: before split %u us, split %u us, scheduled %u us\n",
+           Time[0], Time[1], Time[2]);
+
+    /*
+     * The split hides the prefetch in the PLLM lock, and the reinit keeps
+     * the prefetched header; scheduling may only add the poll granularity
+     * to that.
+     */
+    return (Time[1] < Time[0] && Time[2] <= Time[1] + COST_POLL) ? 0 : 1;
+}
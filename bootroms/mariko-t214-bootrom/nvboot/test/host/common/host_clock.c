@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
+#include "nvtypes.h"
+#include "host_clock.h"
+
+#define HOST_CLOCK_PAGE 4096
+
+static volatile NvU32 *s_Tmrus;
+
+void HostClockInit(void)
+{
+    uintptr_t Page = NV_ADDRESS_MAP_TMRUS_BASE & ~(uintptr_t)(HOST_CLOCK_PAGE - 1);
+    void *p;
+
+    if (s_Tmrus == NULL)
+    {
+        p = mmap((void *)Page, HOST_CLOCK_PAGE, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        if (p != (void *)Page)
+        {
+            fprintf(stderr, "host_clock: cannot map TMRUS at 0x%lx\n",
+                    (unsigned long)Page);
+            abort();
+        }
+        s_Tmrus = (volatile NvU32 *)NV_ADDRESS_MAP_TMRUS_BASE;
+    }
+    *s_Tmrus = 0;
+}
+
+void HostClockAdvance(NvU32 Us)
+{
+    *s_Tmrus += Us;
+}
+
+NvU32 HostClockNow(void)
+{
+    return *s_Tmrus;
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * host_devices.c - Stand-ins for the target device drivers named in the
+ * callback tables of the device, SHA and RSA device managers, so that
+ * nvboot_devmgr.c, nvboot_sha_devmgr.c and nvboot_rsa_devmgr.c link on the
+ * host. Harnesses boot from NvBootDevType_HostFile and use the software
+ * SHA and RSA devices; reaching any of these is a harness bug and aborts.
+ *
+ * The symbols are defined without the driver headers: only their
+ * addresses are taken by the table.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HOST_DEVICE_STUB(Name)                                  \
+    void Name(void)                                             \
+    {                                                           \
+        fprintf(stderr, "host_devices: %s called\n", #Name);    \
+        abort();                                                \
+    }
+
+#define HOST_DEVICE_STUBS(Dev)                                  \
+    HOST_DEVICE_STUB(NvBoot##Dev##GetParams)                    \
+    HOST_DEVICE_STUB(NvBoot##Dev##ValidateParams)               \
+    HOST_DEVICE_STUB(NvBoot##Dev##GetBlockSizes)                \
+    HOST_DEVICE_STUB(NvBoot##Dev##Init)                         \
+    HOST_DEVICE_STUB(NvBoot##Dev##ReadPage)                     \
+    HOST_DEVICE_STUB(NvBoot##Dev##QueryStatus)                  \
+    HOST_DEVICE_STUB(NvBoot##Dev##Shutdown)                     \
+    HOST_DEVICE_STUB(NvBoot##Dev##GetReaderBuffersBase)
+
+HOST_DEVICE_STUBS(SpiFlash)
+HOST_DEVICE_STUBS(Sdmmc)
+HOST_DEVICE_STUBS(ProdUart)
+
+HOST_DEVICE_STUB(NvBootSeShaDevInit)
+HOST_DEVICE_STUB(NvBootSeShaGetShaFamily)
+HOST_DEVICE_STUB(NvBootSeShaSetShaFamily)
+HOST_DEVICE_STUB(NvBootSeShaGetDigestSize)
+HOST_DEVICE_STUB(NvBootSeShaSetShaDigestSize)
+HOST_DEVICE_STUB(NvBootSeShaIsValidShaFamily)
+HOST_DEVICE_STUB(NvBootSeShaIsValidShaDigestSize)
+HOST_DEVICE_STUB(NvBootSeShaDevShaHash)
+HOST_DEVICE_STUB(NvBootSeShaDeviceShutdown)
+
+HOST_DEVICE_STUB(NvBootSeRsaDevInit)
+HOST_DEVICE_STUB(NvBootSeRsaDevNumKeySlots)
+HOST_DEVICE_STUB(NvBootSeRsaDevIsValidKeySlot)
+HOST_DEVICE_STUB(NvBootSeRsaDevIsValidKeySize)
+HOST_DEVICE_STUB(NvBootSeRsaDevGetKey)
+HOST_DEVICE_STUB(NvBootSeRsaDevSetKey)
+HOST_DEVICE_STUB(NvBootSeRsaDevModularExponentiation)
+HOST_DEVICE_STUB(NvBootSeRsaDevIsEngineBusy)
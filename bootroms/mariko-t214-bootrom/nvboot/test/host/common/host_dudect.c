@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_dudect.h"
+
+#define WARM_UP 1000
+
+static int CmpU64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+double HostDudect(const uint64_t *Time, const uint8_t *Class, size_t Count)
+{
+    double Worst = 0, n[2], m[2], m2[2], x, d, t;
+    uint64_t *Sorted, Cut;
+    size_t i;
+    int p, c;
+
+    Sorted = malloc(Count * sizeof(*Sorted));
+    if (Sorted == NULL)
+    {
+        fprintf(stderr, "host_dudect: out of memory\n");
+        abort();
+    }
+    memcpy(Sorted, Time, Count * sizeof(*Sorted));
+    qsort(Sorted, Count, sizeof(*Sorted), CmpU64);
+
+    for (p = 0; p <= 10; p++)
+    {
+        Cut = (p == 10) ? ~0ull :
+              Sorted[(size_t)(Count * (1 - pow(0.5, (p + 1))))];
+        n[0] = n[1] = m[0] = m[1] = m2[0] = m2[1] = 0;
+        for (i = WARM_UP; i < Count; i++)
+        {
+            if (Time[i] > Cut)
+                continue;
+            c = Class[i];
+            x = (double)Time[i];
+            n[c]++;
+            d = x - m[c];
+            m[c] += d / n[c];
+            m2[c] += d * (x - m[c]);
+        }
+        t = (m[0] - m[1]) /
+            sqrt(m2[0] / (n[0] - 1) / n[0] + m2[1] / (n[1] - 1) / n[1]);
+        if (fabs(t) > fabs(Worst))
+            Worst = t;
+    }
+
+    free(Sorted);
+    return Worst;
+}
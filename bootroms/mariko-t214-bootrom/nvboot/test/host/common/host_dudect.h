@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * host_dudect.h - The statistics of a dudect timing-leak test.
+ *
+ * A harness times Count runs of the code under test, each on an input of
+ * class 0 or 1 chosen at random, and hands the times and classes here.
+ * A Welch t-test between the two classes is run on all the samples and on
+ * samples cropped at several percentiles, which drops the long tail of
+ * interrupts and cache misses. |t| above 4.5 means the run time depends on
+ * the class.
+ */
+
+#ifndef INCLUDED_HOST_DUDECT_H
+#define INCLUDED_HOST_DUDECT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/**
+ * Returns the t of largest magnitude over the crops. The first 1000
+ * samples are taken as warm-up and ignored. Sorts a copy of Time, so
+ * allocates Count samples.
+ */
+double HostDudect(const uint64_t *Time, const uint8_t *Class, size_t Count);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // INCLUDED_HOST_DUDECT_H
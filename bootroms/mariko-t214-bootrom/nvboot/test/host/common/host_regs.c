@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvtypes.h"
+#include "nvboot_hardware_access_int.h"
+#include "host_regs.h"
+
+#define HOST_REG_MAX_REGS  4096
+#define HOST_REG_MAX_HOOKS 16
+
+typedef struct
+{
+    NvU32 Addr;
+    NvU32 Data;
+} HostReg;
+
+typedef struct
+{
+    NvU32 Base;
+    NvU32 Size;
+    HostRegReadFn Read;
+    HostRegWriteFn Write;
+} HostRegRange;
+
+static HostReg s_Regs[HOST_REG_MAX_REGS];
+static NvU32 s_NumRegs;
+static HostRegRange s_Hooks[HOST_REG_MAX_HOOKS];
+static NvU32 s_NumHooks;
+
+static HostReg *HostRegFind(NvU32 Addr, NvBool Add)
+{
+    NvU32 i;
+
+    for (i = 0; i < s_NumRegs; i++)
+    {
+        if (s_Regs[i].Addr == Addr)
+            return &s_Regs[i];
+    }
+    if (!Add)
+        return NULL;
+    if (s_NumRegs == HOST_REG_MAX_REGS)
+    {
+        fprintf(stderr, "host_regs: too many registers\n");
+        abort();
+    }
+    s_Regs[s_NumRegs].Addr = Addr;
+    s_Regs[s_NumRegs].Data = 0;
+    return &s_Regs[s_NumRegs++];
+}
+
+static HostRegRange *HostRegFindHook(NvU32 Addr)
+{
+    NvU32 i;
+
+    for (i = 0; i < s_NumHooks; i++)
+    {
+        if (Addr - s_Hooks[i].Base < s_Hooks[i].Size)
+            return &s_Hooks[i];
+    }
+    return NULL;
+}
+
+void HostRegHook(NvU32 Base, NvU32 Size, HostRegReadFn Read, HostRegWriteFn Write)
+{
+    if (s_NumHooks == HOST_REG_MAX_HOOKS)
+    {
+        fprintf(stderr, "host_regs: too many hooks\n");
+        abort();
+    }
+    s_Hooks[s_NumHooks].Base = Base;
+    s_Hooks[s_NumHooks].Size = Size;
+    s_Hooks[s_NumHooks].Read = Read;
+    s_Hooks[s_NumHooks].Write = Write;
+    s_NumHooks++;
+}
+
+NvU32 HostRegPeek(NvU32 Addr)
+{
+    HostReg *pReg = HostRegFind(Addr, NV_FALSE);
+
+    return pReg ? pReg->Data : 0;
+}
+
+void HostRegPoke(NvU32 Addr, NvU32 Data)
+{
+    HostRegFind(Addr, NV_TRUE)->Data = Data;
+}
+
+void HostRegReset(void)
+{
+    s_NumRegs = 0;
+    s_NumHooks = 0;
+}
+
+NvU32 NvRead32(void *addr)
+{
+    NvU32 Addr = (NvU32)(uintptr_t)addr;
+    HostRegRange *pHook;
+
+    if ((uintptr_t)addr < HOST_REG_SPACE_START)
+        return *(volatile NvU32 *)addr;
+
+    pHook = HostRegFindHook(Addr);
+    if (pHook && pHook->Read)
+        return pHook->Read(Addr);
+    return HostRegPeek(Addr);
+}
+
+void NvWrite32(void *addr, NvU32 data)
+{
+    NvU32 Addr = (NvU32)(uintptr_t)addr;
+    HostRegRange *pHook;
+
+    if ((uintptr_t)addr < HOST_REG_SPACE_START)
+    {
+        *(volatile NvU32 *)addr = data;
+        return;
+    }
+
+    pHook = HostRegFindHook(Addr);
+    if (pHook && pHook->Write)
+        pHook->Write(Addr, data);
+    else
+        HostRegPoke(Addr, data);
+}
+
+// Byte accesses go to a hook that covers them, as for the UART registers,
+// and are otherwise on memory.
+NvU8 NvRead08(void *addr)
+{
+    HostRegRange *pHook = NULL;
+
+    if ((uintptr_t)addr >= HOST_REG_SPACE_START)
+        pHook = HostRegFindHook((NvU32)(uintptr_t)addr);
+    if (pHook && pHook->Read)
+        return (NvU8)pHook->Read((NvU32)(uintptr_t)addr);
+    return *(volatile NvU8 *)addr;
+}
+
+void NvWrite08(void *addr, NvU8 data)
+{
+    HostRegRange *pHook = NULL;
+
+    if ((uintptr_t)addr >= HOST_REG_SPACE_START)
+        pHook = HostRegFindHook((NvU32)(uintptr_t)addr);
+    if (pHook && pHook->Write)
+        pHook->Write((NvU32)(uintptr_t)addr, data);
+    else
+        *(volatile NvU8 *)addr = data;
+}
+
+// Narrower and wider accesses are only used on memory.
+NvU16 NvRead16(void *addr) { return *(volatile NvU16 *)addr; }
+NvU64 NvRead64(void *addr) { return *(volatile NvU64 *)addr; }
+void NvWrite16(void *addr, NvU16 data) { *(volatile NvU16 *)addr = data; }
+void NvWrite64(void *addr, NvU64 data) { *(volatile NvU64 *)addr = data; }
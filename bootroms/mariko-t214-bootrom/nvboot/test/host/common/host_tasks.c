@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "nvtypes.h"
+#include "host_tasks.h"
+
+static const NvBootTask *s_List;
+static int s_Count;
+static const NvBootTask *s_ListNS;
+static int s_CountNS;
+
+unsigned HostTasksRandomDelays;
+unsigned HostTasksExceptions;
+jmp_buf *HostTasksExceptionJmp;
+
+void HostTasksSet(const NvBootTask *List, int Count)
+{
+    s_List = List;
+    s_Count = Count;
+}
+
+void HostTasksSetNS(const NvBootTask *List, int Count)
+{
+    s_ListNS = List;
+    s_CountNS = Count;
+}
+
+void *GetPtrTasks(NvBootTaskListId TaskListId)
+{
+    return (void *)s_List;
+}
+
+int GetCntTasks(NvBootTaskListId TaskListId)
+{
+    return s_Count;
+}
+
+NvBootError IsValidTaskListId(NvBootTaskListId TaskListId)
+{
+    return (TaskListId <= NvBootTaskListId_WarmBoot) ?
+           NvBootError_Success : NvBootError_IllegalParameter;
+}
+
+void *GetPtrTasksNS(void)
+{
+    return (void *)s_ListNS;
+}
+
+int GetCntTasksNS(void)
+{
+    return s_CountNS;
+}
+
+// The delay itself is not modelled; harnesses only count the calls.
+void NvBootRngWaitRandomLoop(NvU32 MaxCycles)
+{
+    HostTasksRandomDelays++;
+}
+
+void do_exception(void)
+{
+    HostTasksExceptions++;
+    if (HostTasksExceptionJmp != NULL)
+        longjmp(*HostTasksExceptionJmp, 1);
+
+    fprintf(stderr, "host_tasks: do_exception()\n");
+    abort();
+}
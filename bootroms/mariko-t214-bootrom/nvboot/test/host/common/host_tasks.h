@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * host_tasks.h - What nvboot_dispatcher.c needs besides its own file: the
+ * task tables of nvboot_tasks_s.c and nvboot_tasks_ns.c, the random delay
+ * and do_exception(). A harness hands the dispatcher its own task lists.
+ *
+ * nvboot_dispatcher_int.h declares memcpy() and memset() with an int
+ * size, which clashes with <string.h>; include it through this header.
+ */
+
+#ifndef INCLUDED_HOST_TASKS_H
+#define INCLUDED_HOST_TASKS_H
+
+#include <setjmp.h>
+
+#define memcpy NvBootDispatcherMemcpy
+#define memset NvBootDispatcherMemset
+#include "nvboot_dispatcher_int.h"
+#undef memcpy
+#undef memset
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/** Makes List the task list of every NvBootTaskListId. */
+void HostTasksSet(const NvBootTask *List, int Count);
+
+/** Makes List the non-secure task list. */
+void HostTasksSetNS(const NvBootTask *List, int Count);
+
+/** Calls of NvBootRngWaitRandomLoop() and do_exception() so far. */
+extern unsigned HostTasksRandomDelays;
+extern unsigned HostTasksExceptions;
+
+/**
+ * If set, do_exception() longjmps here with 1. Otherwise it reports the
+ * exception and aborts.
+ */
+extern jmp_buf *HostTasksExceptionJmp;
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // INCLUDED_HOST_TASKS_H
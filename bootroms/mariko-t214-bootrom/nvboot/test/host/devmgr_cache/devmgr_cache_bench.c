@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Trace replay of the device manager read-ahead cache.
+ *
+ * A trace lists the reads the boot flow issues through the device manager:
+ *
+ *   read     <block> <page> <bytes>    NvBootDevMgrRead()
+ *   prefetch <block> <page> <bytes>    NvBootDevMgrPrefetch()
+ *
+ * Each trace is replayed twice against the host_file device: through
+ * nvboot_devmgr.c, and uncached, with one device read per "read" and the
+ * prefetches dropped, as the callers did before the cache. Every read is
+ * compared with the image.
+ *
+ * The time reported is the device time host_file models: ReadLatencyUs
+ * per read plus PageLatencyUs per page. Prefetches run while PLLM locks,
+ * so their device time is reported apart from the time on the boot path.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvboot_bit.h"
+#include "nvboot_devmgr_int.h"
+#include "nvboot_host_file_int.h"
+#include "nvboot_util_int.h"
+
+#define IMAGE_PATH  "devmgr_cache.img"
+#define IMAGE_SIZE  (1024 * 1024)
+#define MAX_READ    (256 * 1024)
+
+NvBootInfoTable BootInfoTable;
+extern NvBootDevContext s_DeviceContext;
+
+static NvBootDevMgr s_DevMgr;
+static uint8_t s_Image[IMAGE_SIZE];
+static uint8_t s_Dest[MAX_READ];
+
+typedef struct
+{
+    NvU32 DeviceReads;
+    NvU32 DevicePages;
+    NvU32 PrefetchReads;
+    NvU32 PrefetchPages;
+    NvU32 Mismatches;
+    NvU32 Failures;
+} ReplayStats;
+
+/* Reads issued by the replay so far, taken from the host_file context. */
+static NvU32 s_LastReads;
+static NvU64 s_LastBytes;
+
+static void Account(NvBootHostFileContext *Dev, NvU32 *Reads, NvU32 *Pages)
+{
+    NvU32 PageSize = 1 << Dev->PageSizeLog2;
+
+    *Reads += Dev->NumReads - s_LastReads;
+    *Pages += NV_ICEIL(Dev->BytesRead - s_LastBytes, PageSize);
+    s_LastReads = Dev->NumReads;
+    s_LastBytes = Dev->BytesRead;
+}
+
+static int WriteImage(void)
+{
+    FILE *f;
+    NvU32 i;
+
+    /* Every word holds its own offset, so a misplaced copy is caught. */
+    for (i = 0; i < IMAGE_SIZE; i += 4)
+        memcpy(&s_Image[i], &i, 4);
+
+    f = fopen(IMAGE_PATH, "wb");
+    if (f == NULL || fwrite(s_Image, 1, IMAGE_SIZE, f) != IMAGE_SIZE)
+    {
+        perror(IMAGE_PATH);
+        return 1;
+    }
+    fclose(f);
+    return 0;
+}
+
+static NvBootError ReadUncached(NvU32 Block, NvU32 Page, NvU32 Len)
+{
+    const NvBootDevMgrCallbacks *Cb = s_DevMgr.Callbacks;
+    NvBootDeviceStatus Status;
+    NvBootError e;
+
+    e = Cb->Read(Block, Page, Len, s_Dest);
+    if (e != NvBootError_Success)
+        return e;
+    while ((Status = Cb->QueryStatus()) == NvBootDeviceStatus_ReadInProgress)
+        ;
+    return (Status == NvBootDeviceStatus_Idle) ? NvBootError_Success :
+                                                 NvBootError_DeviceReadError;
+}
+
+static int Replay(const char *Trace, NvBool Cached,
+                  const NvBootHostFileParams *Params, ReplayStats *Stats)
+{
+    NvBootHostFileContext *Dev = &s_DeviceContext.HostFileContext;
+    char Line[256], Op[16];
+    NvU32 Block, Page, Len, Offset;
+    NvBootError e;
+    FILE *f;
+
+    memset(Stats, 0, sizeof(*Stats));
+    memset(&BootInfoTable, 0, sizeof(BootInfoTable));
+
+    if (NvBootHostFileOpen(IMAGE_PATH, Params) != NvBootError_Success ||
+        NvBootDevMgrInit(&s_DevMgr, NvBootDevType_HostFile, 0) !=
+            NvBootError_Success)
+    {
+        fprintf(stderr, "devmgr_cache: cannot open %s\n", IMAGE_PATH);
+        return 1;
+    }
+    s_LastReads = 0;
+    s_LastBytes = 0;
+
+    f = fopen(Trace, "r");
+    if (f == NULL)
+    {
+        perror(Trace);
+        return 1;
+    }
+
+    while (fgets(Line, sizeof(Line), f) != NULL)
+    {
+        if (sscanf(Line, "%15s %u %u %u", Op, &Block, &Page, &Len) != 4 ||
+            Op[0] == '#')
+            continue;
+
+        if (!strcmp(Op, "prefetch"))
+        {
+            if (Cached)
+                NvBootDevMgrPrefetch(&s_DevMgr, Block, Page, Len);
+            Account(Dev, &Stats->PrefetchReads, &Stats->PrefetchPages);
+            continue;
+        }
+
+        if (Len > MAX_READ)
+        {
+            fprintf(stderr, "%s: read of %u bytes is too large\n", Trace, Len);
+            fclose(f);
+            return 1;
+        }
+
+        memset(s_Dest, 0xA5, Len);
+        if (Cached)
+            e = NvBootDevMgrRead(&s_DevMgr, Block, Page, Len, s_Dest);
+        else
+            e = ReadUncached(Block, Page, Len);
+        Account(Dev, &Stats->DeviceReads, &Stats->DevicePages);
+
+        Offset = (Block << s_DevMgr.BlockSizeLog2) +
+                 (Page << s_DevMgr.PageSizeLog2);
+        if (Offset + Len > IMAGE_SIZE)
+            Stats->Failures += (e == NvBootError_Success);
+        else if (e != NvBootError_Success)
+            Stats->Failures++;
+        else if (memcmp(s_Dest, &s_Image[Offset], Len))
+            Stats->Mismatches++;
+    }
+
+    fclose(f);
+    NvBootDevMgrShutdown(&s_DevMgr);
+    NvBootHostFileClose();
+    return 0;
+}
+
+static NvU32 DeviceUs(const NvBootHostFileParams *Params, NvU32 Reads,
+                      NvU32 Pages)
+{
+    return Reads * Params->ReadLatencyUs + Pages * Params->PageLatencyUs;
+}
+
+int main(int argc, char **argv)
+{
+    NvBootHostFileParams Params;
+    ReplayStats Off, On;
+    NvBootReadAheadStatus *Ra = &BootInfoTable.ReadAheadStatus;
+    NvBool Bench = NV_FALSE;
+    int Bad = 0;
+    int i;
+
+    Params.PageSizeLog2  = HOST_FILE_PAGESIZELOG2;
+    Params.BlockSizeLog2 = HOST_FILE_BLOCKSIZELOG2;
+    Params.ReadLatencyUs = 0;
+    Params.PageLatencyUs = 0;
+
+    i = 1;
+    if (i < argc && !strcmp(argv[i], "bench"))
+    {
+        /* An eMMC-like cost: command overhead, then about 100 MB/s. */
+        Bench = NV_TRUE;
+        Params.ReadLatencyUs = 100;
+        Params.PageLatencyUs = 5;
+        i++;
+    }
+    if (i >= argc)
+    {
+        fprintf(stderr, "usage: %s [bench] TRACE...\n", argv[0]);
+        return 2;
+    }
+
+    if (WriteImage())
+        return 1;
+
+    if (Bench)
+        printf("%-24s %5s %14s %14s %14s %6s %8s\n", "trace", "reads",
+               "uncached us", "cached us", "prefetch us", "hits", "saved");
+
+    for (; i < argc; i++)
+    {
+        if (Replay(argv[i], NV_FALSE, &Params, &Off) ||
+            Replay(argv[i], NV_TRUE, &Params, &On))
+            return 1;
+
+        Bad += Off.Mismatches + Off.Failures + On.Mismatches + On.Failures;
+
+        if (Bench)
+            printf("%-24s %5u %8u (%3u) %8u (%3u) %8u (%3u) %6u %8u\n",
+                   argv[i], Ra->NumReads,
+                   DeviceUs(&Params, Off.DeviceReads, Off.DevicePages),
+                   Off.DeviceReads,
+                   DeviceUs(&Params, On.DeviceReads, On.DevicePages),
+                   On.DeviceReads,
+                   DeviceUs(&Params, On.PrefetchReads, On.PrefetchPages),
+                   On.PrefetchReads, Ra->NumHits, Ra->BytesSaved);
+        else
+            printf("devmgr_cache: %s: %u reads, %u hits, %u mismatches, "
+                   "%u failures\n", argv[i], Ra->NumReads, Ra->NumHits,
+                   Off.Mismatches + On.Mismatches,
+                   Off.Failures + On.Failures);
+    }
+
+    if (Bench)
+        printf("(device reads in parentheses; ReadLatencyUs %u, "
+               "PageLatencyUs %u)\n", Params.ReadLatencyUs,
+               Params.PageLatencyUs);
+
+    remove(IMAGE_PATH);
+    return Bad != 0;
+}
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of the secure dispatcher's dependency scheduling.
+ *
+ * Small task lists run on NvBootSecureDispatcher(): the start order they
+ * must produce, poll hooks, barriers, errors from tasks and polls,
+ * unsatisfiable dependencies, the fault-injection exception path and
+ * the two random delays per task.
+ */
+
+#include "host_tasks.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "nvboot_bit.h"
+#include "nvboot_util_int.h"
+#include "host_clock.h"
+
+NvBootInfoTable BootInfoTable;
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "dispatcher: %s:%d: %s\n", __FILE__,        \
+                    __LINE__, #Cond);                                   \
+        }                                                               \
+    } while (0)
+
+/* Start order of the tasks, as a string of task numbers. */
+static char s_Order[64];
+static int s_OrderLen;
+
+/* Polls left before each poll hook reports completion. */
+static int s_PollsLeft[8];
+static NvBootError s_PollResult[8];
+static NvBootError s_TaskResult[8];
+
+static NvBootError Task(int i)
+{
+    s_Order[s_OrderLen++] = '0' + i;
+    s_Order[s_OrderLen] = '\0';
+    HostClockAdvance(10);
+    return s_TaskResult[i];
+}
+
+static NvBootError Poll(int i)
+{
+    HostClockAdvance(1);
+    if (s_PollsLeft[i] > 0)
+    {
+        s_PollsLeft[i]--;
+        return NvBootError_Busy;
+    }
+    return s_PollResult[i];
+}
+
+#define TASK(i) static NvBootError T##i(void) { return Task(i); }
+TASK(0) TASK(1) TASK(2) TASK(3)
+
+static NvBootError P0(void) { return Poll(0); }
+
+static void Reset(void)
+{
+    int i;
+
+    HostClockInit();
+    memset(&BootInfoTable, 0, sizeof(BootInfoTable));
+    s_OrderLen = 0;
+    s_Order[0] = '\0';
+    for (i = 0; i < 8; i++)
+    {
+        s_PollsLeft[i] = 0;
+        s_PollResult[i] = NvBootError_Success;
+        s_TaskResult[i] = NvBootError_Success;
+    }
+    HostTasksRandomDelays = 0;
+    HostTasksExceptions = 0;
+}
+
+static NvBootError Run(const NvBootTask *List, int Count)
+{
+    HostTasksSet(List, Count);
+    return NvBootSecureDispatcher(NvBootTaskListId_ColdBoot);
+}
+
+/* The flow log wraps and is not restarted per list, so search it. */
+static NvBool Logged(NvU32 Id, NvBootError Status)
+{
+    int i;
+
+    for (i = 0; i < NVBOOT_FLOW_LOG_DEPTH; i++)
+    {
+        if (BootInfoTable.BootFlowLog[i].NvBootFlowFuncId == Id &&
+            BootInfoTable.BootFlowLog[i].NvBootFlowFuncStatus == (NvU32)Status)
+            return NV_TRUE;
+    }
+    return NV_FALSE;
+}
+
+#define COUNT(List) (int)(sizeof(List) / sizeof(List[0]))
+
+static void CheckInOrder(void)
+{
+    static const NvBootTask List[] = {
+        { &T0, 0x10 }, { &T1, 0x11 }, { &T2, 0x12 }, { &T3, 0x13 },
+    };
+
+    Reset();
+    CHECK(Run(List, COUNT(List)) == NvBootError_Success);
+    CHECK(!strcmp(s_Order, "0123"));
+    CHECK(HostTasksRandomDelays == 2 * COUNT(List));
+    CHECK(Logged(0x13, NvBootError_Success));
+}
+
+static void CheckDependencies(void)
+{
+    /* T1 waits for T0's poll; T2 needs nothing and starts meanwhile. */
+    static const NvBootTask Overlap[] = {
+        { &T0, 0x10, 0, &P0 },
+        { &T1, 0x11, TASK_DEPS(TASK_DEP(0)) },
+        { &T2, 0x12, TASK_DEPS_NONE },
+    };
+    /* A legacy entry waits for every earlier task, polls included. */
+    static const NvBootTask Barrier[] = {
+        { &T0, 0x10, 0, &P0 },
+        { &T1, 0x11, TASK_DEPS_NONE },
+        { &T2, 0x12 },
+        { &T3, 0x13, TASK_DEPS_NONE },
+    };
+    /* Dependencies on later tasks are allowed. */
+    static const NvBootTask Forward[] = {
+        { &T0, 0x10, TASK_DEPS(TASK_DEP(2)) },
+        { &T1, 0x11, TASK_DEPS(TASK_DEP(0)) },
+        { &T2, 0x12, TASK_DEPS_NONE },
+    };
+
+    /* A poll that completes at once keeps the list order. */
+    Reset();
+    CHECK(Run(Overlap, COUNT(Overlap)) == NvBootError_Success);
+    CHECK(!strcmp(s_Order, "012"));
+
+    Reset();
+    s_PollsLeft[0] = 3;
+    CHECK(Run(Overlap, COUNT(Overlap)) == NvBootError_Success);
+    CHECK(!strcmp(s_Order, "021"));
+    CHECK(BootInfoTable.TaskTiming[2].CheckPoint ==
+          (0x10 | NVBOOT_TASK_TIMING_POLL_WAIT));
+
+    Reset();
+    s_PollsLeft[0] = 2;
+    CHECK(Run(Barrier, COUNT(Barrier)) == NvBootError_Success);
+    CHECK(!strcmp(s_Order, "0132"));
+
+    Reset();
+    CHECK(Run(Forward, COUNT(Forward)) == NvBootError_Success);
+    CHECK(!strcmp(s_Order, "201"));
+}
+
+static void CheckErrors(void)
+{
+    static const NvBootTask Polled[] = {
+        { &T0, 0x10, 0, &P0 },
+        { &T1, 0x11, TASK_DEPS_NONE },
+        { &T2, 0x12 },
+    };
+    static const NvBootTask Plain[] = {
+        { &T0, 0x10 }, { &T1, 0x11 }, { &T2, 0x12 },
+    };
+    static const NvBootTask Cycle[] = {
+        { &T0, 0x10, TASK_DEPS(TASK_DEP(1)) },
+        { &T1, 0x11, TASK_DEPS(TASK_DEP(0)) },
+    };
+    static NvBootTask Long[TASK_MAX_PER_LIST + 1];
+    int i;
+
+    /* A failed poll fails the list and is logged under its checkpoint. */
+    Reset();
+    s_PollsLeft[0] = 2;
+    s_PollResult[0] = NvBootError_HwTimeOut;
+    CHECK(Run(Polled, COUNT(Polled)) == NvBootError_HwTimeOut);
+    CHECK(!strcmp(s_Order, "01"));
+    CHECK(Logged(0x10, NvBootError_HwTimeOut));
+
+    /* A failed task stops the list. */
+    Reset();
+    s_TaskResult[1] = NvBootError_DeviceReadError;
+    CHECK(Run(Plain, COUNT(Plain)) == NvBootError_DeviceReadError);
+    CHECK(!strcmp(s_Order, "01"));
+    CHECK(Logged(0x11, NvBootError_DeviceReadError));
+
+    Reset();
+    CHECK(Run(Cycle, COUNT(Cycle)) == NvBootError_IllegalParameter);
+    CHECK(s_OrderLen == 0);
+
+    for (i = 0; i < TASK_MAX_PER_LIST + 1; i++)
+    {
+        Long[i].funcPtr = &T0;
+        Long[i].checkPoint = 0x10;
+    }
+    Reset();
+    CHECK(Run(Long, TASK_MAX_PER_LIST + 1) == NvBootError_IllegalParameter);
+    CHECK(s_OrderLen == 0);
+    Reset();
+    CHECK(Run(Long, TASK_MAX_PER_LIST) == NvBootError_Success);
+    CHECK(s_OrderLen == TASK_MAX_PER_LIST);
+
+    Reset();
+    HostTasksSet(Plain, COUNT(Plain));
+    CHECK(NvBootSecureDispatcher(NvBootTaskListId_Force32) ==
+          NvBootError_IllegalParameter);
+    CHECK(s_OrderLen == 0);
+}
+
+static void CheckFaultInjection(void)
+{
+    static const NvBootTask Polled[] = {
+        { &T0, 0x10, 0, &P0 },
+        { &T1, 0x11 },
+    };
+    static const NvBootTask Plain[] = {
+        { &T0, 0x10 }, { &T1, 0x11 },
+    };
+    jmp_buf Jmp;
+
+    HostTasksExceptionJmp = &Jmp;
+
+    Reset();
+    s_TaskResult[0] = NvBootError_Fault_Injection_Detection;
+    if (setjmp(Jmp) == 0)
+    {
+        Run(Plain, COUNT(Plain));
+        CHECK(!"returned after a fault injection detection");
+    }
+    CHECK(HostTasksExceptions == 1);
+    CHECK(!strcmp(s_Order, "0"));
+
+    Reset();
+    s_PollResult[0] = NvBootError_Fault_Injection_Detection;
+    if (setjmp(Jmp) == 0)
+    {
+        Run(Polled, COUNT(Polled));
+        CHECK(!"returned after a fault injection detection");
+    }
+    CHECK(HostTasksExceptions == 1);
+    CHECK(!strcmp(s_Order, "0"));
+
+    HostTasksExceptionJmp = NULL;
+}
+
+int main(void)
+{
+    CheckInOrder();
+    CheckDependencies();
+    CheckErrors();
+    CheckFaultInjection();
+
+    printf("dispatcher: %u checks, %u failures\n", s_Cases, s_Failures);
+    return s_Failures != 0;
+}
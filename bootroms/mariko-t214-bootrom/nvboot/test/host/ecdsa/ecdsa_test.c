@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of ECDSA P-256 verification, core/ecdsa/nvboot_ecdsa.c, on the
+ * software SHA device.
+ *
+ * "check" runs every case of ecdsa.vectors with the digest given, and
+ * again through the SHA device where the line has the message. "bench"
+ * prints the cycles of a pre-hashed verify next to those of the RSA path
+ * the Boot ROM takes today: RSASSA-PSS of the 2048-bit SC7 test vector, on
+ * the software RSA device.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "nvboot_crypto_pkc_ecdsa_int.h"
+#include "nvboot_crypto_pkc_rsassa_pss_int.h"
+#include "nvboot_crypto_signatures.h"
+#include "nvboot_warm_boot_0.h"
+#include "nvboot_rsa_pss_test_vector.h"
+#include "host_clock.h"
+
+#define VECTORS         "ecdsa.vectors"
+#define MAX_MESSAGE     64
+#define RSA_SLOT        0
+#define EXPONENT        0x10001
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "ecdsa: %s:%d: %s\n", __FILE__,             \
+                    __LINE__, #Cond);                                   \
+        }                                                               \
+    } while (0)
+
+typedef struct
+{
+    NvBootEcPoint256 Key;
+    NvBootEcdsaSig Sig;
+    uint32_t Digest[NVBOOT_SHA256_LENGTH_WORDS];
+    uint32_t Message[MAX_MESSAGE / 4];
+    NvU32 MessageBytes;
+    NvBool HaveMessage;
+    NvBootError Result;
+} EcdsaVector;
+
+static const struct
+{
+    const char *Name;
+    NvBootError Result;
+} s_Results[] =
+{
+    { "ok",       NvBootError_Success },
+    { "invalid",  NvBootError_CryptoMgr_Ecdsa_Invalid_Sig },
+    { "range",    NvBootError_CryptoMgr_Ecdsa_R_S_Out_Of_Range },
+    { "badkey",   NvBootError_IllegalParameter },
+    { "infinity", NvBootError_CryptoMgr_Ecdsa_Invalid_R_is_O },
+};
+
+static NvBootShaDevMgr s_Sha;
+
+/* Reads one hex field of at most Max bytes; returns its length or -1. */
+static int ReadHex(const char *Field, uint8_t *Out, size_t Max)
+{
+    size_t Len = strlen(Field), i;
+    unsigned Byte;
+
+    if ((Len & 1) || (Len / 2 > Max))
+        return -1;
+    for (i = 0; i < Len / 2; i++)
+    {
+        if (sscanf(Field + 2 * i, "%2x", &Byte) != 1)
+            return -1;
+        Out[i] = Byte;
+    }
+    return (int)(Len / 2);
+}
+
+/* Parses one line of the vector file; returns 0 for a case. */
+static int ParseVector(char *Line, EcdsaVector *v)
+{
+    char *Field[7];
+    int n = 0, Len;
+    size_t i;
+
+    memset(v, 0, sizeof(*v));
+    for (Field[n] = strtok(Line, " \t\n"); Field[n] && (n < 6);
+         Field[++n] = strtok(NULL, " \t\n"))
+        ;
+    if (n < 6)
+        return -1;
+
+    if ((ReadHex(Field[0], v->Key.x, sizeof(v->Key.x)) != 32) ||
+        (ReadHex(Field[1], v->Key.y, sizeof(v->Key.y)) != 32) ||
+        (ReadHex(Field[2], v->Sig.r, 32) != 32) ||
+        (ReadHex(Field[3], v->Sig.s, 32) != 32) ||
+        (ReadHex(Field[4], (uint8_t *)v->Digest, sizeof(v->Digest)) != 32))
+        return -1;
+
+    for (i = 0; i < sizeof(s_Results) / sizeof(s_Results[0]); i++)
+    {
+        if (!strcmp(Field[5], s_Results[i].Name))
+            break;
+    }
+    if (i == sizeof(s_Results) / sizeof(s_Results[0]))
+        return -1;
+    v->Result = s_Results[i].Result;
+
+    if (Field[6])
+    {
+        Len = ReadHex(Field[6], (uint8_t *)v->Message, sizeof(v->Message));
+        if (Len < 0)
+            return -1;
+        v->MessageBytes = Len;
+        v->HaveMessage = NV_TRUE;
+    }
+    return 0;
+}
+
+static NvBootError Verify(EcdsaVector *v, NvBool Hashed)
+{
+    NvBootCryptoEcdsaContext Context;
+
+    memset(&Context, 0, sizeof(Context));
+    Context.PublicKey = &v->Key;
+    Context.InputMessage = v->Message;
+    Context.InputMessageLengthBytes = v->MessageBytes;
+    Context.InputMessageIsHashed = Hashed;
+    Context.InputMessageShaHash = v->Digest;
+    Context.InputSignature = &v->Sig;
+    return NvBootCryptoEcdsaVerify(&Context, &s_Sha);
+}
+
+static int Check(void)
+{
+    EcdsaVector v;
+    char Line[512];
+    FILE *f;
+    int LineNo = 0;
+    NvBootError e;
+
+    f = fopen(VECTORS, "r");
+    if (!f)
+    {
+        perror("ecdsa: " VECTORS);
+        return 1;
+    }
+    while (fgets(Line, sizeof(Line), f))
+    {
+        LineNo++;
+        if ((Line[0] == '#') || (Line[0] == '\n'))
+            continue;
+        if (ParseVector(Line, &v))
+        {
+            fprintf(stderr, "ecdsa: " VECTORS ":%d: bad line\n", LineNo);
+            s_Failures++;
+            continue;
+        }
+
+        e = Verify(&v, NV_TRUE);
+        CHECK(e == v.Result);
+        if (e != v.Result)
+            fprintf(stderr, "ecdsa: " VECTORS ":%d: got 0x%x\n", LineNo,
+                    (unsigned)e);
+        if (v.HaveMessage)
+            CHECK(Verify(&v, NV_FALSE) == v.Result);
+    }
+    fclose(f);
+
+    printf("ecdsa: %u checks, %u failures\n", s_Cases, s_Failures);
+    return s_Failures != 0;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+static NvBootRsaDevMgr s_Rsa;
+static NvBootCryptoRsaKey s_RsaKey;
+static uint32_t s_RsaHash[NVBOOT_SHA256_LENGTH_WORDS];
+
+static NvBootWb0RecoveryHeader *const s_Header =
+    (NvBootWb0RecoveryHeader *)nvboot_rsa_pss_test_vector;
+
+/* The signed part of the SC7 image, RandomAesBlock to the end. */
+#define SIGNED_OFFSET   offsetof(NvBootWb0RecoveryHeader, RandomAesBlock)
+
+static NvBootError VerifyRsa(void)
+{
+    NvBootCryptoRsaSsaPssContext Context;
+
+    memset(&Context, 0, sizeof(Context));
+    Context.RsaKeySlot = RSA_SLOT;
+    Context.RsaKey = &s_RsaKey;
+    Context.InputMessage = (uint32_t *)((uint8_t *)s_Header + SIGNED_OFFSET);
+    Context.InputMessageLengthBytes = s_Header->LengthInsecure - SIGNED_OFFSET;
+    Context.InputSignature = &s_Header->Signatures.RsaSsaPssSig;
+    Context.InputMessageIsHashed = true;
+    Context.InputMessageShaHash = s_RsaHash;
+    return NvBootCryptoRsaSsaPssVerify(&Context, &s_Sha, &s_Rsa);
+}
+
+static int SetUpRsa(void)
+{
+    if (NvBootRsaDevMgrInit(&s_Rsa, NvBootRsaDevice_SW) != NvBootError_Success)
+        return -1;
+
+    /* The Boot ROM always uses F4; the image leaves the exponent empty. */
+    s_RsaKey = s_Header->Pcp.RsaPublicParams.RsaPublicKey;
+    s_RsaKey.KeyData.RsaKey2048NvU32.Exponent[0] = EXPONENT;
+    if (s_Rsa.RsaDevMgrCallbacks->SetKey(&s_RsaKey, RSA_SLOT) !=
+        NvBootError_Success)
+        return -1;
+
+    NvBootCryptoRsaSsaPssInit();
+    s_Sha.ShaDevMgrCallbacks->ShaHash(
+        (uint32_t *)((uint8_t *)s_Header + SIGNED_OFFSET),
+        s_Header->LengthInsecure - SIGNED_OFFSET, s_RsaHash, &s_Sha.ShaConfig);
+    return VerifyRsa() == NvBootError_Success ? 0 : -1;
+}
+
+/* The first good signature in the vector file, with its digest. */
+static int FirstGood(EcdsaVector *v)
+{
+    char Line[512];
+    FILE *f = fopen(VECTORS, "r");
+    int Found = -1;
+
+    if (!f)
+        return -1;
+    while ((Found != 0) && fgets(Line, sizeof(Line), f))
+    {
+        if ((Line[0] != '#') && (Line[0] != '\n') && !ParseVector(Line, v) &&
+            (v->Result == NvBootError_Success))
+            Found = 0;
+    }
+    fclose(f);
+    return Found;
+}
+
+/* Best of 7 runs, in cycles per call. The two paths take turns. */
+static int Bench(void)
+{
+    uint64_t Best[2] = { ~0ull, ~0ull }, Start, Took;
+    EcdsaVector v;
+    const int Reps = 50;
+    int t, r;
+
+    if (FirstGood(&v) || (Verify(&v, NV_TRUE) != NvBootError_Success))
+    {
+        fprintf(stderr, "ecdsa: no good signature in " VECTORS "\n");
+        return 1;
+    }
+    if (SetUpRsa())
+    {
+        fprintf(stderr, "ecdsa: the RSA-PSS test vector does not verify\n");
+        return 1;
+    }
+
+    for (t = 0; t < 7; t++)
+    {
+        Start = __rdtsc();
+        for (r = 0; r < Reps; r++)
+            Verify(&v, NV_TRUE);
+        Took = __rdtsc() - Start;
+        if (Took < Best[0])
+            Best[0] = Took;
+
+        Start = __rdtsc();
+        for (r = 0; r < Reps; r++)
+            VerifyRsa();
+        Took = __rdtsc() - Start;
+        if (Took < Best[1])
+            Best[1] = Took;
+    }
+
+    printf("cycles per pre-hashed verify\n");
+    printf("  %-24s %10.0f\n", "ECDSA P-256", (double)Best[0] / Reps);
+    printf("  %-24s %10.0f\n", "RSASSA-PSS 2048, F4", (double)Best[1] / Reps);
+    printf("  %-24s %10.1f\n", "ratio", (double)Best[0] / Best[1]);
+    return 0;
+}
+
+#else
+
+static int Bench(void)
+{
+    printf("ecdsa: the benchmark needs an x86 cycle counter\n");
+    return 0;
+}
+
+#endif
+
+int main(int argc, char **argv)
+{
+    /* NvBootInitializeNvBootError() reads the clock. */
+    HostClockInit();
+
+    if (NvBootShaDevMgrInit(&s_Sha, NvBootShaDevice_SW) != NvBootError_Success)
+    {
+        fprintf(stderr, "ecdsa: the software SHA device is not built\n");
+        return 1;
+    }
+
+    if ((argc > 1) && !strcmp(argv[1], "bench"))
+        return Bench();
+    return Check();
+}
@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test and benchmark of the file-backed host device.
+ *
+ * "check" runs the driver directly and through the device manager:
+ * geometry validation, data read back from the image, the modelled read
+ * latency, injected bit flips and bad blocks, and reads past the media.
+ *
+ * "bench" loads a BCT and an MB1 image through the device manager with
+ * the reads NvBootReadBct() and NvBootLoadBootLoader() issue for a boot
+ * from block 0 slot 0, for several device geometries. nvboot_bct.c and
+ * nvboot_bootloader.c themselves need the SE, PKA and PMC register
+ * headers, which this tree lacks, so the reads are issued here.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "nvboot_bit.h"
+#include "nvboot_devmgr_int.h"
+#include "nvboot_host_file_int.h"
+#include "nvboot_util_int.h"
+
+#define IMAGE_PATH  "host_file.img"
+#define IMAGE_SIZE  (4 * 1024 * 1024)
+
+#define BCT_SIZE    10240
+#define HEADER_SIZE 368
+#define MB1_SIZE    (128 * 1024)
+#define MB1_BLOCK   4
+
+NvBootInfoTable BootInfoTable;
+extern NvBootDevContext s_DeviceContext;
+
+static NvBootDevMgr s_DevMgr;
+static uint8_t s_Image[IMAGE_SIZE];
+static uint8_t s_Dest[256 * 1024];
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "host_file: %s:%d: %s\n", __FILE__,         \
+                    __LINE__, #Cond);                                   \
+        }                                                               \
+    } while (0)
+
+static NvU64 NowUs(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return (NvU64)Now.tv_sec * 1000000 + Now.tv_nsec / 1000;
+}
+
+static int WriteImage(void)
+{
+    FILE *f;
+    NvU32 i;
+
+    for (i = 0; i < IMAGE_SIZE; i += 4)
+        memcpy(&s_Image[i], &i, 4);
+
+    f = fopen(IMAGE_PATH, "wb");
+    if (f == NULL || fwrite(s_Image, 1, IMAGE_SIZE, f) != IMAGE_SIZE)
+    {
+        perror(IMAGE_PATH);
+        return 1;
+    }
+    fclose(f);
+    return 0;
+}
+
+static NvBootHostFileParams Geometry(NvU32 PageSizeLog2, NvU32 BlockSizeLog2)
+{
+    NvBootHostFileParams Params;
+
+    memset(&Params, 0, sizeof(Params));
+    Params.PageSizeLog2  = PageSizeLog2;
+    Params.BlockSizeLog2 = BlockSizeLog2;
+    return Params;
+}
+
+/* Reads through the driver callbacks and waits for the read to complete. */
+static NvBootDeviceStatus ReadWait(NvU32 Block, NvU32 Page, NvU32 Len)
+{
+    NvBootDeviceStatus Status;
+
+    memset(s_Dest, 0xA5, Len);
+    if (NvBootHostFileReadPage(Block, Page, Len, s_Dest) != NvBootError_Success)
+        return NvBootDeviceStatus_ReadFailure;
+    while ((Status = NvBootHostFileQueryStatus()) ==
+           NvBootDeviceStatus_ReadInProgress)
+        ;
+    return Status;
+}
+
+static NvBool Matches(NvU32 Offset, NvU32 Len)
+{
+    return memcmp(s_Dest, &s_Image[Offset], Len) == 0;
+}
+
+static void CheckParams(void)
+{
+    NvBootHostFileParams Params;
+
+    Params = Geometry(9, 14);
+    CHECK(NvBootHostFileValidateParams(&Params));
+    Params = Geometry(NVBOOT_MIN_PAGE_SIZE_LOG2 - 1, 14);
+    CHECK(!NvBootHostFileValidateParams(&Params));
+    Params = Geometry(NVBOOT_MAX_PAGE_SIZE_LOG2 + 1, NVBOOT_MAX_BLOCK_SIZE_LOG2);
+    CHECK(!NvBootHostFileValidateParams(&Params));
+    Params = Geometry(9, NVBOOT_MAX_BLOCK_SIZE_LOG2 + 1);
+    CHECK(!NvBootHostFileValidateParams(&Params));
+    Params = Geometry(12, 11);
+    CHECK(!NvBootHostFileValidateParams(&Params));
+
+    /* No image, no device. */
+    Params = Geometry(9, 14);
+    CHECK(NvBootHostFileOpen("does/not/exist.img", &Params) ==
+          NvBootError_DeviceNotResponding);
+    CHECK(NvBootHostFileInit(&Params, &s_DeviceContext.HostFileContext) ==
+          NvBootError_DeviceNotResponding);
+}
+
+static void CheckReads(NvU32 PageSizeLog2, NvU32 BlockSizeLog2)
+{
+    NvBootHostFileParams Params = Geometry(PageSizeLog2, BlockSizeLog2);
+    NvU32 PagesPerBlock = 1 << (BlockSizeLog2 - PageSizeLog2);
+    NvU32 Blocks = IMAGE_SIZE >> BlockSizeLog2;
+    NvU32 Block, Page, Len, i;
+
+    CHECK(NvBootHostFileOpen(IMAGE_PATH, &Params) == NvBootError_Success);
+    CHECK(NvBootHostFileInit(&Params, &s_DeviceContext.HostFileContext) ==
+          NvBootError_Success);
+
+    srand(PageSizeLog2 * 100 + BlockSizeLog2);
+    for (i = 0; i < 200; i++)
+    {
+        Block = rand() % Blocks;
+        Page  = rand() % PagesPerBlock;
+        Len   = 1 + rand() % sizeof(s_Dest);
+        if ((Block << BlockSizeLog2) + (Page << PageSizeLog2) + Len > IMAGE_SIZE)
+            Len = IMAGE_SIZE - (Block << BlockSizeLog2) - (Page << PageSizeLog2);
+        CHECK(ReadWait(Block, Page, Len) == NvBootDeviceStatus_Idle);
+        CHECK(Matches((Block << BlockSizeLog2) + (Page << PageSizeLog2), Len));
+    }
+
+    /* The last page reads; one byte past it fails. */
+    CHECK(ReadWait(Blocks - 1, PagesPerBlock - 1, 1 << PageSizeLog2) ==
+          NvBootDeviceStatus_Idle);
+    CHECK(ReadWait(Blocks - 1, PagesPerBlock - 1, (1 << PageSizeLog2) + 1) ==
+          NvBootDeviceStatus_ReadFailure);
+    CHECK(ReadWait(Blocks, 0, 1) == NvBootDeviceStatus_ReadFailure);
+
+    NvBootHostFileClose();
+}
+
+static void CheckLatency(void)
+{
+    NvBootHostFileParams Params = Geometry(9, 14);
+    NvU64 Start;
+
+    Params.ReadLatencyUs = 2000;
+    Params.PageLatencyUs = 100;
+    CHECK(NvBootHostFileOpen(IMAGE_PATH, &Params) == NvBootError_Success);
+    CHECK(NvBootHostFileInit(&Params, &s_DeviceContext.HostFileContext) ==
+          NvBootError_Success);
+
+    /* 2000us plus 10 pages at 100us. */
+    Start = NowUs();
+    CHECK(NvBootHostFileReadPage(0, 0, 10 * 512, s_Dest) == NvBootError_Success);
+    CHECK(NvBootHostFileQueryStatus() == NvBootDeviceStatus_ReadInProgress);
+    while (NvBootHostFileQueryStatus() == NvBootDeviceStatus_ReadInProgress)
+        ;
+    CHECK(NowUs() - Start >= 3000);
+    CHECK(s_DeviceContext.HostFileContext.NumReads == 1);
+    CHECK(s_DeviceContext.HostFileContext.BytesRead == 10 * 512);
+
+    NvBootHostFileClose();
+}
+
+static void CheckFaults(void)
+{
+    NvBootHostFileParams Params = Geometry(9, 14);
+    NvU32 i;
+
+    CHECK(NvBootHostFileOpen(IMAGE_PATH, &Params) == NvBootError_Success);
+    CHECK(NvBootHostFileInit(&Params, &s_DeviceContext.HostFileContext) ==
+          NvBootError_Success);
+
+    /* A flip shows in every read covering the byte, at the right place. */
+    CHECK(NvBootHostFileInjectBitFlip(1000, 3) == NvBootError_Success);
+    CHECK(NvBootHostFileInjectBitFlip(0, 8) == NvBootError_IllegalParameter);
+    CHECK(ReadWait(0, 0, 2048) == NvBootDeviceStatus_Idle);
+    CHECK(s_Dest[1000] == (s_Image[1000] ^ 0x08));
+    s_Dest[1000] = s_Image[1000];
+    CHECK(Matches(0, 2048));
+    CHECK(ReadWait(0, 1, 512) == NvBootDeviceStatus_Idle);
+    CHECK(s_Dest[1000 - 512] == (s_Image[1000] ^ 0x08));
+    CHECK(ReadWait(0, 2, 512) == NvBootDeviceStatus_Idle);
+    CHECK(Matches(1024, 512));
+
+    /* A bad block fails every read that touches it, and only those. */
+    CHECK(NvBootHostFileInjectBadBlock(3) == NvBootError_Success);
+    CHECK(ReadWait(3, 5, 512) == NvBootDeviceStatus_ReadFailure);
+    CHECK(ReadWait(2, 31, 1024) == NvBootDeviceStatus_ReadFailure);
+    CHECK(ReadWait(2, 31, 512) == NvBootDeviceStatus_Idle);
+    CHECK(ReadWait(4, 0, 512) == NvBootDeviceStatus_Idle);
+
+    for (i = 1; i < HOST_FILE_MAX_BIT_FLIPS; i++)
+        CHECK(NvBootHostFileInjectBitFlip(i, 0) == NvBootError_Success);
+    CHECK(NvBootHostFileInjectBitFlip(0, 0) == NvBootError_IllegalParameter);
+    for (i = 1; i < HOST_FILE_MAX_BAD_BLOCKS; i++)
+        CHECK(NvBootHostFileInjectBadBlock(100 + i) == NvBootError_Success);
+    CHECK(NvBootHostFileInjectBadBlock(0) == NvBootError_IllegalParameter);
+
+    /* Reopening clears the faults; the image was never written. */
+    CHECK(NvBootHostFileOpen(IMAGE_PATH, &Params) == NvBootError_Success);
+    CHECK(NvBootHostFileInit(&Params, &s_DeviceContext.HostFileContext) ==
+          NvBootError_Success);
+    CHECK(ReadWait(0, 0, 2048) == NvBootDeviceStatus_Idle);
+    CHECK(Matches(0, 2048));
+    CHECK(ReadWait(3, 0, 512) == NvBootDeviceStatus_Idle);
+
+    NvBootHostFileClose();
+}
+
+static void CheckDevMgr(void)
+{
+    NvBootHostFileParams Params = Geometry(11, 16);
+    uint8_t *Buffers = NULL;
+
+    CHECK(NvBootHostFileOpen(IMAGE_PATH, &Params) == NvBootError_Success);
+    CHECK(NvBootDevMgrInit(&s_DevMgr, NvBootDevType_HostFile, 0) ==
+          NvBootError_Success);
+    CHECK(s_DevMgr.PageSizeLog2 == 11);
+    CHECK(s_DevMgr.BlockSizeLog2 == 16);
+
+    CHECK(NvBootDevMgrRead(&s_DevMgr, 2, 3, 5000, s_Dest) == NvBootError_Success);
+    CHECK(Matches((2 << 16) + (3 << 11), 5000));
+
+    CHECK(NvBootHostFileInjectBadBlock(5) == NvBootError_Success);
+    CHECK(NvBootDevMgrRead(&s_DevMgr, 5, 0, 512, s_Dest) ==
+          NvBootError_DeviceReadError);
+
+    CHECK(s_DevMgr.Callbacks->GetReaderBuffersBase(&Buffers, 4096, 4096) ==
+          NvBootError_Success);
+    CHECK(Buffers != NULL && ((uintptr_t)Buffers & 4095) == 0);
+    CHECK(s_DevMgr.Callbacks->GetReaderBuffersBase(&Buffers, 4096, 4096) ==
+          NvBootError_IllegalParameter);
+    Buffers = NULL;
+    CHECK(s_DevMgr.Callbacks->GetReaderBuffersBase(&Buffers, 8192, 4096) ==
+          NvBootError_MemoryNotAligned);
+
+    NvBootDevMgrShutdown(&s_DevMgr);
+    NvBootHostFileClose();
+}
+
+/*
+ * The reads of a boot from BCT block 0 slot 0 and MB1 in block MB1_BLOCK:
+ * the BCT, the page holding the OEM boot binary header, then the rest of
+ * MB1. Returns the wall time in microseconds.
+ */
+static NvU64 LoadBctAndMb1(NvU32 *Reads, NvU64 *Bytes)
+{
+    NvU32 PageSize = 1 << s_DevMgr.PageSizeLog2;
+    NvU32 HeaderPages = NV_ICEIL(HEADER_SIZE, PageSize);
+    NvU32 PagesPerBlock = 1 << (s_DevMgr.BlockSizeLog2 - s_DevMgr.PageSizeLog2);
+    NvU32 Mb1Left = MB1_SIZE - (HeaderPages * PageSize - HEADER_SIZE);
+    NvU32 Block = MB1_BLOCK, Page = HeaderPages;
+    NvU64 Start = NowUs();
+
+    if (Page >= PagesPerBlock)
+    {
+        Page -= PagesPerBlock;
+        Block++;
+    }
+
+    CHECK(NvBootDevMgrRead(&s_DevMgr, 0, 0, BCT_SIZE, s_Dest) ==
+          NvBootError_Success);
+    CHECK(NvBootDevMgrRead(&s_DevMgr, MB1_BLOCK, 0, HeaderPages * PageSize,
+                           s_Dest) == NvBootError_Success);
+    CHECK(NvBootDevMgrRead(&s_DevMgr, Block, Page, Mb1Left, s_Dest) ==
+          NvBootError_Success);
+
+    *Reads = s_DeviceContext.HostFileContext.NumReads;
+    *Bytes = s_DeviceContext.HostFileContext.BytesRead;
+    return NowUs() - Start;
+}
+
+static void Bench(void)
+{
+    static const struct
+    {
+        const char *Name;
+        NvU32 PageSizeLog2;
+        NvU32 BlockSizeLog2;
+        NvU32 ReadLatencyUs;
+        NvU32 PageLatencyUs;
+    } Devices[] =
+    {
+        /* Command overhead and about 100 MB/s. */
+        { "eMMC 512B/16KB",   9, 14, 100,  5 },
+        { "eMMC 512B/512KB",  9, 19, 100,  5 },
+        /* Slower command, single-lane transfer of 2KB pages. */
+        { "QSPI 2KB/64KB",   11, 16,  20, 80 },
+        { "QSPI 4KB/64KB",   12, 16,  20, 160 },
+    };
+    NvBootHostFileParams Params;
+    NvU32 Reads;
+    NvU64 Bytes, WallUs, ModelUs;
+    NvU32 i;
+
+    printf("%-18s %6s %10s %10s %10s\n", "device", "reads", "bytes",
+           "model us", "wall us");
+    for (i = 0; i < sizeof(Devices) / sizeof(Devices[0]); i++)
+    {
+        Params = Geometry(Devices[i].PageSizeLog2, Devices[i].BlockSizeLog2);
+        Params.ReadLatencyUs = Devices[i].ReadLatencyUs;
+        Params.PageLatencyUs = Devices[i].PageLatencyUs;
+        CHECK(NvBootHostFileOpen(IMAGE_PATH, &Params) == NvBootError_Success);
+        CHECK(NvBootDevMgrInit(&s_DevMgr, NvBootDevType_HostFile, 0) ==
+              NvBootError_Success);
+
+        WallUs = LoadBctAndMb1(&Reads, &Bytes);
+        ModelUs = (NvU64)Reads * Params.ReadLatencyUs +
+                  NV_ICEIL(Bytes, 1 << Params.PageSizeLog2) *
+                  Params.PageLatencyUs;
+        printf("%-18s %6u %10llu %10llu %10llu\n", Devices[i].Name, Reads,
+               (unsigned long long)Bytes, (unsigned long long)ModelUs,
+               (unsigned long long)WallUs);
+
+        NvBootDevMgrShutdown(&s_DevMgr);
+        NvBootHostFileClose();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (WriteImage())
+        return 1;
+
+    if (argc > 1 && !strcmp(argv[1], "bench"))
+    {
+        Bench();
+    }
+    else
+    {
+        CheckParams();
+        CheckReads(9, 14);
+        CheckReads(11, 16);
+        CheckReads(14, 20);
+        CheckLatency();
+        CheckFaults();
+        CheckDevMgr();
+        printf("host_file: %u checks, %u failures\n", s_Cases, s_Failures);
+    }
+
+    remove(IMAGE_PATH);
+    return s_Failures != 0;
+}
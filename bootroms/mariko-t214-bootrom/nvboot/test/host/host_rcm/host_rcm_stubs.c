@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * host_rcm_stubs.c - The functions nvboot_rcm.c and nvboot_rcm_port.c
+ * reach that the harness never runs: the XUSB port, secure provisioning,
+ * debug features and the reset paths. Reaching any of these aborts.
+ *
+ * The symbols are defined without their headers, so that one macro fits
+ * all of them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MODEL_STUB(Name)                                        \
+    void Name(void)                                             \
+    {                                                           \
+        fprintf(stderr, "host_rcm: %s called\n", #Name);        \
+        abort();                                                \
+    }
+
+MODEL_STUB(NvBootCryptoMgrAuthRcmPayloadFskp)
+MODEL_STUB(NvBootCryptoMgrDecryptRcmPayloadFskp)
+MODEL_STUB(NvBootCryptoMgrFskpInit)
+MODEL_STUB(NvBootDebugSetDebugFeatures)
+MODEL_STUB(NvBootXusbDeviceEnumerate)
+MODEL_STUB(NvBootXusbDeviceGetClockTable)
+MODEL_STUB(NvBootXusbDeviceInit)
+MODEL_STUB(NvBootXusbDeviceReceive)
+MODEL_STUB(NvBootXusbDeviceReceivePoll)
+MODEL_STUB(NvBootXusbDeviceReceiveStart)
+MODEL_STUB(NvBootXusbDeviceTransmit)
+MODEL_STUB(NvBootXusbDeviceTransmitPoll)
+MODEL_STUB(NvBootXusbDeviceTransmitStart)
+MODEL_STUB(NvBootXusbHandleError)
+MODEL_STUB(do_exception)
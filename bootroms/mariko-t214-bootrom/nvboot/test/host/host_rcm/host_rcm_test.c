@@ -0,0 +1,640 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of the socket-backed RCM port, io/host_rcm/nvboot_host_rcm.c,
+ * under the RCM main loop of core/rcm/nvboot_rcm.c: NvBootRCMInit(),
+ * NvBootRCMSendUniqueId() and NvBootRCMProcessMsgs(), which receive,
+ * validate and execute each message.
+ *
+ * The port, nvboot_rcm.c and nvboot_rcm_port.c are built unchanged, with
+ * NVENABLE_HOST_RCM_SUPPORT so that NvBootRCMInit() selects RCM_HOST. Each
+ * session gives the port one end of a socketpair; a client thread reads the
+ * ECID from the other end through the client calls of the port, sends its
+ * messages and collects their responses.
+ *
+ * The crypto manager is a function level stand-in. The "signature" of a
+ * message is the SHA-256 of its signed section, computed with the software
+ * SHA device, in the first bytes of the RSASSA-PSS signature; the stand-in
+ * checks it when the message is authenticated. PCP, decryption and the
+ * streamed RCM hash are not modelled (rcm_hash covers the last).
+ *
+ * "check" sends every opcode the loop handles, in one write and in writes
+ * of random length, a message of each validation error, and a client that
+ * hangs up; after an error the port must be stalled. "bench" sends signed
+ * Sync messages of several lengths and then a DownloadExecute, and prints
+ * messages/s and MB/s from the first to the last receive, with the
+ * receives the port made per message.
+ */
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "nvboot_crypto_mgr_int.h"
+#include "nvboot_sha_devmgr_int.h"
+#include "nvboot_se_int.h"
+#include "nvboot_context_int.h"
+#include "nvboot_config.h"
+#include "nvboot_rcm.h"
+#include "nvboot_rcm_int.h"
+#include "nvboot_version_defs.h"
+#include "nvboot_host_rcm_int.h"
+#include "host_clock.h"
+
+#define SIGNED_OFFSET       offsetof(NvBootRcmMsg, RandomAesBlock)
+#define MAX_MSG             NVBOOT_RCM_MAX_MSG_LENGTH
+
+/* IRAM, which the harness maps at its address. */
+#define IRAM_START          NV_ADDRESS_MAP_IRAM_A_BASE
+#define IRAM_BYTES          (NV_ADDRESS_MAP_IRAM_D_LIMIT + 1 - IRAM_START)
+
+#define MAX_SCRIPT          16
+/* Host write sizes: the whole message through the client call, or random. */
+#define WRITE_WHOLE         0
+#define WRITE_RANDOM        1
+#define BENCH_BYTES         (64 * 1024 * 1024)
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "host_rcm: %s:%d: %s\n", __FILE__,          \
+                    __LINE__, #Cond);                                   \
+        }                                                               \
+    } while (0)
+
+NvBootInfoTable BootInfoTable;
+NvBootContext Context;
+int32_t FI_counter1;
+int32_t FI_IncrDist;
+
+NvU32 NvBootBootromVersionAddress[3] =
+{
+    CONST_NVBOOT_BOOTROM_VERSION,
+    CONST_NVBOOT_RCM_VERSION,
+    CONST_NVBOOT_BOOTDATA_VERSION
+};
+
+/* A message the client sends Repeat times, and the response it expects. */
+typedef struct
+{
+    const NvU8 *Msg;
+    NvU32 Length;
+    NvU32 Repeat;
+    NvU32 Response;
+} ScriptMsg;
+
+/* The client end of a session. */
+typedef struct
+{
+    int Fd;
+    NvU32 WriteMode;
+    NvBool HangUp;
+    ScriptMsg Script[MAX_SCRIPT];
+    NvU32 ScriptLength;
+
+    NvBootECID UniqueId;
+    NvU32 Responses;
+    NvU32 BadResponses;
+    NvBootError Error;
+} Client;
+
+static const NvBootECID s_UniqueId = { 0x12345678, 0x9abcdef0, 0x0fedcba9,
+                                       0x87654321 };
+static NvBootShaDevMgr s_SwSha;
+static Client s_Client;
+static NvU32 s_AuthCalls;
+static NvU32 s_Rand = 1;
+
+static NvU8 s_Msgs[MAX_SCRIPT][MAX_MSG] __attribute__((aligned(4)));
+static NvU8 *const s_Iram = (NvU8 *)IRAM_START;
+
+static NvU32 Xorshift(void)
+{
+    s_Rand ^= s_Rand << 13;
+    s_Rand ^= s_Rand >> 17;
+    s_Rand ^= s_Rand << 5;
+    return s_Rand;
+}
+
+/*
+ * Stand-ins for what NvBootRCMInit() and SendUniqueId() ask of the fuses,
+ * straps, watchdog and clocks: a production-free part in forced recovery
+ * without debug RCM, and a fixed ECID.
+ */
+
+NvBootError NvBootWdtReload(NvU32 WatchdogTimeout)
+{
+    return NvBootError_Success;
+}
+
+NvBool NvBootFuseIsOdmProductionMode(void)
+{
+    return NV_FALSE;
+}
+
+NvBool NvBootStrapIsForceRecoveryMode(void)
+{
+    return NV_TRUE;
+}
+
+NvBool NvBootStrapIsDebugRecoveryMode(void)
+{
+    return NV_FALSE;
+}
+
+NvBootError NvBootClocksEngine(void *Table, ClockTableType Type)
+{
+    return NvBootError_Success;
+}
+
+void NvBootFuseGetUniqueId(NvBootECID *pId)
+{
+    *pId = s_UniqueId;
+}
+
+void NvBootFuseAddAdditionalEcidInfo(NvBootECID *pEcid)
+{
+}
+
+NvBootError NvBootFuseIsSecureProvisioningMode(NvU32 SecProvisioningKeyNum)
+{
+    return NvBootError_SecProvisioningDisabled;
+}
+
+void NvBootRngWaitRandomLoop(NvU32 MaxCycles)
+{
+}
+
+/* The crypto manager, as Validate() drives it for an OEM RCM message. */
+
+NvBootError NvBootCryptoMgrSetOemPcp(NvBootPublicCryptoParameters *Pcp)
+{
+    return NvBootError_CryptoMgr_Pcp_Not_Loaded_Not_PK_Mode;
+}
+
+void NvBootCryptoMgrOemRcmHashStart(const NvBootRcmMsg *RcmMsg)
+{
+}
+
+void NvBootCryptoMgrOemRcmHashUpdate(const NvBootRcmMsg *RcmMsg,
+                                     uint32_t BytesReceived)
+{
+}
+
+void NvBootCryptoMgrOemRcmHashFinish(const NvBootRcmMsg *RcmMsg)
+{
+}
+
+static void Digest(const NvU8 *Msg, NvU32 Length, NvU32 *pDigest)
+{
+    s_SwSha.ShaDevMgrCallbacks->ShaHash((uint32_t *)(Msg + SIGNED_OFFSET),
+                                        Length - SIGNED_OFFSET, pDigest,
+                                        &s_SwSha.ShaConfig);
+}
+
+NvBootError NvBootCryptoMgrOemAuthRcmPayload(const NvBootRcmMsg *RcmMsg)
+{
+    NvU32 Calculated[NVBOOT_SHA256_LENGTH_WORDS];
+
+    s_AuthCalls++;
+    Digest((const NvU8 *)RcmMsg, RcmMsg->LengthInsecure, Calculated);
+    if (memcmp(&RcmMsg->Signatures.RsaSsaPssSig, Calculated,
+               sizeof(Calculated)))
+        return NvBootError_ValidationFailure;
+    return NvBootError_Success;
+}
+
+NvBootError NvBootCryptoMgrOemDecryptRcmPayload(const NvBootRcmMsg *RcmMsg)
+{
+    return NvBootError_Success;
+}
+
+static void MapIram(void)
+{
+    void *p = mmap((void *)IRAM_START, IRAM_BYTES, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if (p != (void *)IRAM_START)
+    {
+        fprintf(stderr, "host_rcm: cannot map IRAM at 0x%x\n", IRAM_START);
+        exit(1);
+    }
+}
+
+/* A valid insecure length with Payload bytes or more after the header. */
+static NvU32 MessageLength(NvU32 Payload)
+{
+    NvU32 Length = sizeof(NvBootRcmMsg) + Payload;
+    NvU32 Mod = SIGNED_OFFSET % NVBOOT_SE_AES_BLOCK_LENGTH_BYTES;
+
+    while (Length % NVBOOT_SE_AES_BLOCK_LENGTH_BYTES != Mod)
+        Length++;
+    while (Length >= MAX_MSG)
+        Length -= NVBOOT_SE_AES_BLOCK_LENGTH_BYTES;
+    return Length;
+}
+
+/*
+ * A signed message of Length bytes in slot Slot: the opcode, PayloadLength
+ * random payload bytes and valid padding around it.
+ */
+static NvU8 *BuildMessage(NvU32 Slot, NvBootRcmOpcode Opcode, NvU32 Length,
+                          NvU32 PayloadLength)
+{
+    NvU8 *Msg = s_Msgs[Slot];
+    NvBootRcmMsg *pMsg = (NvBootRcmMsg *)Msg;
+    NvU32 i;
+
+    memset(Msg, 0, Length);
+    pMsg->LengthInsecure = Length;
+    pMsg->LengthSecure = Length;
+    pMsg->Opcode = Opcode;
+    pMsg->PayloadLength = PayloadLength;
+    pMsg->RcmVersion = CONST_NVBOOT_RCM_VERSION;
+    pMsg->Padding[0] = 0x80;
+    for (i = 0; i < PayloadLength; i++)
+        Msg[sizeof(NvBootRcmMsg) + i] = Xorshift();
+    if (sizeof(NvBootRcmMsg) + PayloadLength < Length)
+        Msg[sizeof(NvBootRcmMsg) + PayloadLength] = 0x80;
+    if (Opcode == NvBootRcmOpcode_DownloadExecute)
+        pMsg->Args.DownloadData.EntryPoint = NVBOOT_BL_IRAM_START;
+    return Msg;
+}
+
+static void Sign(NvU8 *Msg)
+{
+    NvBootRcmMsg *pMsg = (NvBootRcmMsg *)Msg;
+
+    Digest(Msg, pMsg->LengthInsecure, (NvU32 *)&pMsg->Signatures.RsaSsaPssSig);
+}
+
+static void AddMsg(const NvU8 *Msg, NvU32 Repeat, NvU32 Response)
+{
+    ScriptMsg *p = &s_Client.Script[s_Client.ScriptLength++];
+
+    p->Msg = Msg;
+    p->Length = ((const NvBootRcmMsg *)Msg)->LengthInsecure;
+    p->Repeat = Repeat;
+    p->Response = Response;
+}
+
+/* The message in writes of random length, then its response. */
+static NvBootError SendInPieces(int Fd, const NvU8 *Msg, NvU32 Length,
+                                NvU32 *pResponse)
+{
+    NvU32 Sent = 0;
+    NvU32 Got = 0;
+    NvU32 Bytes;
+    ssize_t n;
+
+    while (Sent < Length)
+    {
+        Bytes = 1 + Xorshift() % 20000;
+        n = write(Fd, Msg + Sent, NV_MIN(Bytes, Length - Sent));
+        if (n <= 0)
+            return NvBootError_DeviceNotResponding;
+        Sent += n;
+    }
+    while (Got < sizeof(*pResponse))
+    {
+        n = read(Fd, (NvU8 *)pResponse + Got, sizeof(*pResponse) - Got);
+        if (n <= 0)
+            return NvBootError_DeviceNotResponding;
+        Got += n;
+    }
+    return NvBootError_Success;
+}
+
+static void *ClientThread(void *Arg)
+{
+    Client *c = (Client *)Arg;
+    const ScriptMsg *p;
+    NvU32 Response;
+    NvU32 i, r;
+
+    c->Error = NvBootHostRcmClientReadUniqueId(c->Fd, &c->UniqueId);
+    if ((c->Error != NvBootError_Success) || c->HangUp)
+    {
+        close(c->Fd);
+        c->Fd = -1;
+        return NULL;
+    }
+
+    for (i = 0; i < c->ScriptLength; i++)
+    {
+        p = &c->Script[i];
+        for (r = 0; r < p->Repeat; r++)
+        {
+            if (c->WriteMode == WRITE_RANDOM)
+                c->Error = SendInPieces(c->Fd, p->Msg, p->Length, &Response);
+            else
+                c->Error = NvBootHostRcmClientSendMessage(c->Fd, p->Msg,
+                                                          p->Length, &Response);
+            if (c->Error != NvBootError_Success)
+                return NULL;
+            c->Responses++;
+            if (Response != p->Response)
+            {
+                fprintf(stderr, "host_rcm: message %u: response 0x%x, "
+                        "expected 0x%x\n", i, Response, p->Response);
+                c->BadResponses++;
+            }
+        }
+    }
+    return NULL;
+}
+
+static void NewScript(NvU32 WriteMode)
+{
+    memset(&s_Client, 0, sizeof(s_Client));
+    s_Client.WriteMode = WriteMode;
+}
+
+/*
+ * Runs the RCM loop against the client script until it returns; the port
+ * statistics are left in *pStats and the port is closed.
+ */
+static NvBootError RunSession(NvBootHostRcmStats *pStats)
+{
+    pthread_t Thread;
+    NvBootError e;
+    NvU32 n;
+    int Fds[2];
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, Fds) != 0)
+    {
+        perror("host_rcm: socketpair");
+        exit(1);
+    }
+    NvBootHostRcmOpenFd(Fds[0]);
+    s_Client.Fd = Fds[1];
+    s_AuthCalls = 0;
+    memset(&Context, 0, sizeof(Context));
+    pthread_create(&Thread, NULL, ClientThread, &s_Client);
+
+    e = NvBootRCMInit();
+    if (e == NvBootError_Success)
+        e = NvBootRCMSendUniqueId();
+    if (e == NvBootError_Success)
+        e = NvBootRCMProcessMsgs();
+
+    // After an error response the port is stalled.
+    if ((e != NvBootError_Success) && s_Client.ScriptLength &&
+        !s_Client.HangUp)
+        CHECK(NvBootHostRcmReceive(s_Iram, 4, &n) == NvBootError_TxferFailed);
+
+    NvBootHostRcmGetStats(pStats);
+    NvBootHostRcmClose();
+    pthread_join(Thread, NULL);
+    if (s_Client.Fd >= 0)
+        close(s_Client.Fd);
+    return e;
+}
+
+/* Every opcode the loop handles, ending with a DownloadExecute. */
+static void CheckOpcodes(NvU32 WriteMode)
+{
+    NvBootRcmMsg *pMsg;
+    NvBootHostRcmStats Stats;
+    NvU32 Payload, Length, EntryPoint;
+    NvU8 *Msg;
+    NvBootError e;
+
+    NewScript(WriteMode);
+    Msg = BuildMessage(0, NvBootRcmOpcode_Sync, MessageLength(0), 0);
+    Sign(Msg);
+    AddMsg(Msg, 2, NvBootRcmResponse_Success);
+    Msg = BuildMessage(1, NvBootRcmOpcode_QueryBootRomVersion,
+                       MessageLength(0), 0);
+    Sign(Msg);
+    AddMsg(Msg, 1, CONST_NVBOOT_BOOTROM_VERSION);
+    Msg = BuildMessage(2, NvBootRcmOpcode_QueryRcmVersion, MessageLength(0), 0);
+    Sign(Msg);
+    AddMsg(Msg, 1, CONST_NVBOOT_RCM_VERSION);
+    Msg = BuildMessage(3, NvBootRcmOpcode_QueryBootDataVersion,
+                       MessageLength(0), 0);
+    Sign(Msg);
+    AddMsg(Msg, 1, CONST_NVBOOT_BOOTDATA_VERSION);
+    Msg = BuildMessage(4, NvBootRcmOpcode_ProgramFuseArray, MessageLength(0), 0);
+    Sign(Msg);
+    AddMsg(Msg, 1, NvBootRcmResponse_UnsupportedOpcode);
+    /* Padding past the header is data padding, even without a payload. */
+    Msg = BuildMessage(5, NvBootRcmOpcode_Sync, MessageLength(100000), 0);
+    Sign(Msg);
+    AddMsg(Msg, 3, NvBootRcmResponse_Success);
+
+    /* The entry point is the last word of an applet of 4 bytes or more. */
+    Payload = 4 + Xorshift() % (NVBOOT_BL_IRAM_SIZE - 4);
+    Length = MessageLength(Payload + 1);
+    Payload = NV_MIN(Payload, Length - sizeof(NvBootRcmMsg) - 1);
+    EntryPoint = NVBOOT_BL_IRAM_START + ((Payload - 4) & ~3);
+    Msg = BuildMessage(6, NvBootRcmOpcode_DownloadExecute, Length, Payload);
+    pMsg = (NvBootRcmMsg *)Msg;
+    pMsg->Args.DownloadData.EntryPoint = EntryPoint;
+    Sign(Msg);
+    AddMsg(Msg, 1, NvBootRcmResponse_Success);
+
+    e = RunSession(&Stats);
+    CHECK(e == NvBootError_Success);
+    CHECK(s_Client.Error == NvBootError_Success);
+    CHECK(!memcmp(&s_Client.UniqueId, &s_UniqueId, sizeof(s_UniqueId)));
+    CHECK(s_Client.Responses == 10);
+    CHECK(s_Client.BadResponses == 0);
+    CHECK(s_AuthCalls == 10);
+    CHECK(Stats.NumErrors == 0);
+    CHECK(Stats.NumTransfers == 11);
+    CHECK(BootInfoTable.BootType == NvBootType_Recovery);
+    CHECK(Context.BootLoader == (uint8_t *)EntryPoint);
+    CHECK(!memcmp((NvU8 *)NVBOOT_RCM_MSG_IRAM_START, Msg, Length));
+}
+
+/* A signed message that fails validation with Response. */
+static void CheckError(const char *What, NvU8 *Msg, NvU32 Response,
+                       NvBool Signed)
+{
+    NvBootHostRcmStats Stats;
+    NvBootError e;
+    NvU8 *Sync;
+
+    if (Signed)
+        Sign(Msg);
+    NewScript(WRITE_WHOLE);
+    Sync = BuildMessage(0, NvBootRcmOpcode_Sync, MessageLength(0), 0);
+    Sign(Sync);
+    AddMsg(Sync, 1, NvBootRcmResponse_Success);
+    AddMsg(Msg, 1, Response);
+
+    e = RunSession(&Stats);
+    CHECK(e != NvBootError_Success);
+    CHECK(s_Client.Responses == 2);
+    CHECK(s_Client.BadResponses == 0);
+    CHECK(Stats.NumErrors == 1);
+    if (s_Client.BadResponses)
+        fprintf(stderr, "host_rcm: in the %s case\n", What);
+}
+
+static void CheckErrors(void)
+{
+    NvBootRcmMsg *pMsg;
+    NvU8 *Msg;
+
+    Msg = BuildMessage(1, NvBootRcmOpcode_Sync, MessageLength(4096), 0);
+    Sign(Msg);
+    Msg[MessageLength(4096) - 1] ^= 1;
+    CheckError("signature", Msg, NvBootRcmResponse_HashOrSignatureCheckFailed,
+               NV_FALSE);
+
+    Msg = BuildMessage(1, NvBootRcmOpcode_Sync, MessageLength(4096), 0);
+    ((NvBootRcmMsg *)Msg)->LengthInsecure++;
+    CheckError("insecure length", Msg, NvBootRcmResponse_InvalidInsecureLength,
+               NV_FALSE);
+
+    Msg = BuildMessage(1, NvBootRcmOpcode_Sync, MessageLength(4096), 0);
+    ((NvBootRcmMsg *)Msg)->LengthSecure -= NVBOOT_SE_AES_BLOCK_LENGTH_BYTES;
+    CheckError("length mismatch", Msg, NvBootRcmResponse_LengthMismatch,
+               NV_TRUE);
+
+    Msg = BuildMessage(1, NvBootRcmOpcode_Sync, MessageLength(4096), 0);
+    ((NvBootRcmMsg *)Msg)->Padding[0] = 0;
+    CheckError("message padding", Msg, NvBootRcmResponse_BadMsgPadding,
+               NV_TRUE);
+
+    Msg = BuildMessage(1, NvBootRcmOpcode_Sync, MessageLength(4096), 0);
+    Msg[MessageLength(4096) - 1] = 1;
+    CheckError("data padding", Msg, NvBootRcmResponse_BadDataPadding, NV_TRUE);
+
+    Msg = BuildMessage(1, NvBootRcmOpcode_Sync, MessageLength(4096), 16);
+    CheckError("Sync payload", Msg, NvBootRcmResponse_PayloadTooLarge,
+               NV_TRUE);
+
+    Msg = BuildMessage(1, NvBootRcmOpcode_DownloadExecute, MessageLength(4096),
+                       1024);
+    ((NvBootRcmMsg *)Msg)->PayloadLength =
+        MessageLength(4096) - sizeof(NvBootRcmMsg) + 1;
+    CheckError("payload length", Msg, NvBootRcmResponse_PayloadTooLarge,
+               NV_TRUE);
+
+    Msg = BuildMessage(1, NvBootRcmOpcode_DownloadExecute, MessageLength(4096),
+                       1024);
+    pMsg = (NvBootRcmMsg *)Msg;
+    pMsg->Args.DownloadData.EntryPoint = NVBOOT_BL_IRAM_START + 1024;
+    CheckError("entry point", Msg, NvBootRcmResponse_InvalidEntryPoint,
+               NV_TRUE);
+
+    Msg = BuildMessage(1, NvBootRcmOpcode_Force32, MessageLength(4096), 0);
+    CheckError("opcode", Msg, NvBootRcmResponse_InvalidOpcode, NV_TRUE);
+}
+
+/* A client that hangs up after the ECID ends the loop; nothing stalls. */
+static void CheckHangUp(void)
+{
+    NvBootHostRcmStats Stats;
+    NvBootError e;
+
+    NewScript(WRITE_WHOLE);
+    s_Client.HangUp = NV_TRUE;
+    e = RunSession(&Stats);
+    CHECK(e == NvBootError_DeviceNotResponding);
+    CHECK(s_Client.Error == NvBootError_Success);
+    CHECK(Stats.NumTransfers == 1);
+    CHECK(Stats.NumErrors == 0);
+}
+
+static int Check(void)
+{
+    NvU32 i;
+
+    for (i = 0; i < 20; i++)
+        CheckOpcodes(i % 2 ? WRITE_RANDOM : WRITE_WHOLE);
+    CheckErrors();
+    CheckHangUp();
+
+    printf("host_rcm: %u checks, %u failures\n", s_Cases, s_Failures);
+    return s_Failures != 0;
+}
+
+/*
+ * Signed Sync messages of each length, about BENCH_BYTES of them, then a
+ * DownloadExecute that ends the loop; the rate is taken from the first to
+ * the last receive of the port.
+ */
+static int Bench(void)
+{
+    static const NvU32 Payloads[] = { 0, 4096, 65536, NVBOOT_BL_IRAM_SIZE };
+    NvBootHostRcmStats Stats;
+    NvU32 p, Length, Count;
+    NvU8 *Msg;
+    NvBootError e;
+    double Us;
+
+    printf("Signed Sync messages through NvBootRCMProcessMsgs(), "
+           "socketpair port\n");
+    printf("  %8s %8s %10s %9s %12s\n", "length", "messages", "msg/s", "MB/s",
+           "receives/msg");
+    for (p = 0; p < sizeof(Payloads) / sizeof(Payloads[0]); p++)
+    {
+        Length = MessageLength(Payloads[p]);
+        Count = NV_MIN(BENCH_BYTES / Length, 100000);
+
+        NewScript(WRITE_WHOLE);
+        Msg = BuildMessage(0, NvBootRcmOpcode_Sync, Length, 0);
+        Sign(Msg);
+        AddMsg(Msg, Count, NvBootRcmResponse_Success);
+        Msg = BuildMessage(1, NvBootRcmOpcode_DownloadExecute,
+                           MessageLength(0) + 16, 4);
+        Sign(Msg);
+        AddMsg(Msg, 1, NvBootRcmResponse_Success);
+
+        e = RunSession(&Stats);
+        if ((e != NvBootError_Success) || s_Client.BadResponses ||
+            (s_Client.Responses != Count + 1))
+        {
+            fprintf(stderr, "host_rcm: session failed\n");
+            return 1;
+        }
+        Us = Stats.LastReceiveUs - Stats.FirstReceiveUs;
+        printf("  %8u %8u %10.0f %9.1f %12.2f\n", Length, Count,
+               (Count + 1) / (Us / 1e6), Stats.BytesReceived / Us,
+               (double)Stats.NumReceives / (Count + 1));
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    /* NvBootInitializeNvBootError() reads the clock. */
+    HostClockInit();
+    MapIram();
+    /* A client write after the port has closed must fail, not kill us. */
+    signal(SIGPIPE, SIG_IGN);
+
+    if (NvBootShaDevMgrInit(&s_SwSha, NvBootShaDevice_SW) != NvBootError_Success)
+    {
+        fprintf(stderr, "host_rcm: no software SHA device\n");
+        return 1;
+    }
+
+    if ((argc > 1) && !strcmp(argv[1], "bench"))
+        return Bench();
+    return Check();
+}
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * arahb_arbc.h - Host stand-in for the generated AHB arbiter header, with
+ * only the fields the host builds use.
+ */
+
+#ifndef INCLUDED_ARAHB_ARBC_H
+#define INCLUDED_ARAHB_ARBC_H
+
+#define ARAHB_MST_ID_SE                                         14
+#define ARAHB_MST_ID_SE2                                        25
+
+#endif // INCLUDED_ARAHB_ARBC_H
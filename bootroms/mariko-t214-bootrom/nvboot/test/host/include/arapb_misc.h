@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * arapb_misc.h - Host stand-in for the generated APB_MISC register header,
+ * with only the fields the host builds use. No harness reads the FEK, so
+ * its offsets only need to differ from each other; the strap and pinmux
+ * entries follow the T210 layout.
+ */
+
+#ifndef INCLUDED_ARAPB_MISC_H
+#define INCLUDED_ARAPB_MISC_H
+
+#define APB_MISC_PP_STRAPPING_OPT_A_0                           0x008
+#define APB_MISC_PP_STRAPPING_OPT_A_0_BOOT_FAST_UART_RANGE      17:17
+#define APB_MISC_PP_STRAPPING_OPT_A_0_BOOT_FAST_UART_FAST       1
+
+#define PINMUX_AUX_UART1_TX_0                                   0x30e4
+#define PINMUX_AUX_UART1_RX_0                                   0x30e8
+#define PINMUX_AUX_UART1_TX_0_PM_RANGE                          1:0
+#define PINMUX_AUX_UART1_TX_0_PM_DEFAULT                        0
+#define PINMUX_AUX_UART1_TX_0_PUPD_RANGE                        3:2
+#define PINMUX_AUX_UART1_TX_0_PUPD_PULL_UP                      2
+#define PINMUX_AUX_UART1_TX_0_TRISTATE_RANGE                    4:4
+#define PINMUX_AUX_UART1_TX_0_TRISTATE_PASSTHROUGH              0
+#define PINMUX_AUX_UART1_TX_0_E_INPUT_RANGE                     6:6
+#define PINMUX_AUX_UART1_TX_0_E_INPUT_ENABLE                    1
+#define PINMUX_AUX_UART1_RX_0_PM_RANGE                          1:0
+#define PINMUX_AUX_UART1_RX_0_PM_DEFAULT                        0
+#define PINMUX_AUX_UART1_RX_0_PUPD_RANGE                        3:2
+#define PINMUX_AUX_UART1_RX_0_PUPD_PULL_UP                      2
+#define PINMUX_AUX_UART1_RX_0_TRISTATE_RANGE                    4:4
+#define PINMUX_AUX_UART1_RX_0_TRISTATE_PASSTHROUGH              0
+#define PINMUX_AUX_UART1_RX_0_E_INPUT_RANGE                     6:6
+#define PINMUX_AUX_UART1_RX_0_E_INPUT_ENABLE                    1
+
+#define APB_MISC_PP_FEK_RD_DIS_0                                0xc30
+#define APB_MISC_PP_FEK_RD_DIS_0_FEK_RD_DIS_RANGE               0:0
+
+#define FEK_FUSEROMENCRYPTIONNVKEY0_0_0                         0xc00
+#define FEK_FUSEROMENCRYPTIONNVKEY1_0_0                         0xc10
+#define FEK_FUSEROMENCRYPTIONTESTKEY0_0_0                       0xc20
+#define FEK_FUSEROMENCRYPTIONTESTKEY1_0_0                       0xc28
+
+#endif // INCLUDED_ARAPB_MISC_H
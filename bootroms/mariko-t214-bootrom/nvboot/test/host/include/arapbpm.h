@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * arapbpm.h - Host stand-in for the generated PMC register header, with
+ * only the fields the host builds use. The offsets follow the T210
+ * layout; no host model decodes them.
+ */
+
+#ifndef INCLUDED_ARAPBPM_H
+#define INCLUDED_ARAPBPM_H
+
+#define APBDEV_PMC_SECURE_SCRATCH4_0                            0x0c0
+#define APBDEV_PMC_SECURE_SCRATCH5_0                            0x0c4
+#define APBDEV_PMC_SECURE_SCRATCH6_0                            0x224
+#define APBDEV_PMC_SECURE_SCRATCH7_0                            0x228
+#define APBDEV_PMC_SEC_DISABLE8_0                               0x5c0
+#define APBDEV_PMC_SEC_DISABLE8_0_WRITE116_RANGE                9:9
+#define APBDEV_PMC_SEC_DISABLE8_0_WRITE116_ON                   1
+#define APBDEV_PMC_SEC_DISABLE8_0_WRITE117_RANGE                11:11
+#define APBDEV_PMC_SEC_DISABLE8_0_WRITE117_ON                   1
+#define APBDEV_PMC_SEC_DISABLE8_NS_0                            0x5c4
+#define APBDEV_PMC_SEC_DISABLE8_NS_0_WRITE116_RANGE             9:9
+#define APBDEV_PMC_SEC_DISABLE8_NS_0_WRITE116_ON                1
+#define APBDEV_PMC_SEC_DISABLE8_NS_0_WRITE117_RANGE             11:11
+#define APBDEV_PMC_SEC_DISABLE8_NS_0_WRITE117_ON                1
+#define APBDEV_PMC_SECURE_SCRATCH116_0                          0xb28
+#define APBDEV_PMC_SECURE_SCRATCH117_0                          0xb2c
+#define APBDEV_PMC_SECURE_SCRATCH120_0                          0xb38
+#define APBDEV_PMC_SECURE_SCRATCH121_0                          0xb3c
+#define APBDEV_PMC_SECURE_SCRATCH122_0                          0xb40
+#define APBDEV_PMC_SECURE_SCRATCH123_0                          0xb44
+
+#endif // INCLUDED_ARAPBPM_H
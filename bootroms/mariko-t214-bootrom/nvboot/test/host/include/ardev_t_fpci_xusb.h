@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * ardev_t_fpci_xusb.h - Host stand-in for the generated FPCI register
+ * header of the XUSB host controller. nvboot_usb3.c uses no register of
+ * it; see ardev_t_fpci_xusb_0.h.
+ */
+
+#ifndef INCLUDED_ARDEV_T_FPCI_XUSB_H
+#define INCLUDED_ARDEV_T_FPCI_XUSB_H
+
+
+#endif // INCLUDED_ARDEV_T_FPCI_XUSB_H
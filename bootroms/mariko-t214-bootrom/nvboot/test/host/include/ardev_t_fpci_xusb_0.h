@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * ardev_t_fpci_xusb_0.h - Host stand-in for the generated FPCI
+ * configuration register header of the XUSB host controller. CSB
+ * registers are reached through a 0x200 byte window at CSB_ADDR, onto the
+ * page set in ARU_C11_CSBRANGE; the usb3 harness models that window.
+ */
+
+#ifndef INCLUDED_ARDEV_T_FPCI_XUSB_0_H
+#define INCLUDED_ARDEV_T_FPCI_XUSB_0_H
+
+#define XUSB_CFG_1_0                                            0x004
+#define XUSB_CFG_1_0_MEMORY_SPACE_RANGE                         1:1
+#define XUSB_CFG_1_0_MEMORY_SPACE_ENABLED                       1
+#define XUSB_CFG_1_0_BUS_MASTER_RANGE                           2:2
+#define XUSB_CFG_1_0_BUS_MASTER_ENABLED                         1
+#define XUSB_CFG_ARU_C11_CSBRANGE_0                             0x41c
+#define XUSB_CFG_CSB_ADDR_0                                     0x800
+
+#endif // INCLUDED_ARDEV_T_FPCI_XUSB_0_H
@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * ardev_t_fpci_xusb_dev_0.h - Host stand-in for the generated FPCI configuration register header of the XUSB device.
+ * Only nvboot_xusb_dev_hw.c uses its registers, and the host builds model
+ * that file instead of building it.
+ */
+
+#ifndef INCLUDED_ARDEV_T_FPCI_XUSB_DEV_0_H
+#define INCLUDED_ARDEV_T_FPCI_XUSB_DEV_0_H
+
+#endif // INCLUDED_ARDEV_T_FPCI_XUSB_DEV_0_H
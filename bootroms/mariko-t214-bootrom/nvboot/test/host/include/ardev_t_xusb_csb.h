@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * ardev_t_xusb_csb.h - Host stand-in for the generated CSB register header
+ * of the XUSB host controller, with only the fields nvboot_usb3.c uses.
+ * The usb3 harness models the bus instance queues by these addresses; the
+ * others only need to differ from each other. Port registers are 0x10
+ * apart per port, and the registers of bus instance 1 are 0x200 above
+ * those of bus instance 0, as nvboot_usb3.c assumes.
+ */
+
+#ifndef INCLUDED_ARDEV_T_XUSB_CSB_H
+#define INCLUDED_ARDEV_T_XUSB_CSB_H
+
+#define XUSB_CSB_ARU_CTRL_0                                     0x101000
+#define XUSB_CSB_ARU_CTRL_0_MFCOUNT_RANGE                       8:8
+#define XUSB_CSB_ARU_CTRL_0_MFCOUNT_RUN                         1
+
+#define XUSB_CSB_EVENTQ_CNTRL1_0                                0x101204
+#define XUSB_CSB_EVENTQ_CNTRL1_0_VALID_RANGE                    0:0
+#define XUSB_CSB_EVENTQ_CNTRL1_0_POP_RANGE                      1:1
+#define XUSB_CSB_EVENTQ_CNTRL1_0_POP_SET                        1
+#define XUSB_CSB_EVENTQ_TRBDWRD0_0                              0x101210
+#define XUSB_CSB_EVENTQ_TRBDWRD1_0                              0x101214
+#define XUSB_CSB_EVENTQ_TRBDWRD2_0                              0x101218
+#define XUSB_CSB_EVENTQ_TRBDWRD3_0                              0x10121c
+
+#define XUSB_CSB_HS_BI_WORKQ_DWRD0_0                            0x110000
+#define XUSB_CSB_HS_BI_WORKQ_DWRD1_0                            0x110004
+#define XUSB_CSB_HS_BI_WORKQ_DWRD2_0                            0x110008
+#define XUSB_CSB_HS_BI_WORKQ_DWRD3_0                            0x11000c
+#define XUSB_CSB_HS_BI_WORKQ_DWRD4_0                            0x110010
+#define XUSB_CSB_HS_BI_WORKQ_DWRD0_0_KIND_EPTLIST_BULK_INOUT    5
+#define XUSB_CSB_HS_BI_COMPLQ_CNTRL_0                           0x110080
+#define XUSB_CSB_HS_BI_COMPLQ_CNTRL_0_VALID_RANGE               0:0
+#define XUSB_CSB_HS_BI_COMPLQ_CNTRL_0_POP_RANGE                 1:1
+#define XUSB_CSB_HS_BI_COMPLQ_CNTRL_0_POP_SET                   1
+#define XUSB_CSB_HS_BI_COMPLQ_DWRD0_0                           0x110084
+#define XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_RANGE             3:0
+#define XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_NO_ACTIVITY       0
+#define XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_EPT_DONE          1
+#define XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_EPT_ERROR         2
+#define XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_EPT_NRDY          3
+#define XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_OP_ERROR          4
+#define XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_STOPREQ           5
+
+#define XUSB_CSB_SS_BI_COMPLQ_DWRD3_0_STATUS_NONE               0
+#define XUSB_CSB_SS_BI_COMPLQ_DWRD3_0_STATUS_COMPL_RETIRE       1
+#define XUSB_CSB_SS_BI_COMPLQ_DWRD3_0_STATUS_ERR_STALL          4
+#define XUSB_CSB_SS_BI_COMPLQ_DWRD3_0_STATUS_RESCH_CSW          8
+
+#define XUSB_CSB_HSPI_PVTPORTSC1_0                              0x120000
+#define XUSB_CSB_HSPI_PVTPORTSC1_0_PLS_CNTRL_RANGE              3:0
+#define XUSB_CSB_HSPI_PVTPORTSC1_0_PLS_CNTRL_DISCONNECTED       1
+#define XUSB_CSB_HSPI_PVTPORTSC1_0_PLS_CNTRL_RESET              5
+#define XUSB_CSB_HSPI_PVTPORTSC1_0_PLS_VALID_RANGE              4:4
+#define XUSB_CSB_HSPI_PVTPORTSC1_0_PLS_VALID_SET                1
+#define XUSB_CSB_HSPI_PVTPORTSC2_0                              0x120004
+#define XUSB_CSB_HSPI_PVTPORTSC2_0_CSC_RANGE                    1:1
+#define XUSB_CSB_HSPI_PVTPORTSC2_0_CSC_CLEAR                    1
+#define XUSB_CSB_HSPI_PVTPORTSC3_0                              0x120008
+#define XUSB_CSB_HSPI_PVTPORTSC3_0_CCS_RANGE                    0:0
+#define XUSB_CSB_HSPI_PVTPORTSC3_0_CCS_DEV                      1
+#define XUSB_CSB_HSPI_PVTPORTSC3_0_PLS_STATUS_RANGE             7:4
+#define XUSB_CSB_HSPI_PVTPORTSC3_0_PLS_STATUS_ENABLED           0
+#define XUSB_CSB_HSPI_PVTPORTSC3_0_PLS_STATUS_FS_MODE           8
+
+#define XUSB_CSB_FSPI_PVTPORTSC1_0                              0x124000
+#define XUSB_CSB_FSPI_PVTPORTSC1_0_PLS_CNTRL_RANGE              3:0
+#define XUSB_CSB_FSPI_PVTPORTSC1_0_PLS_CNTRL_DISCONNECTED       1
+#define XUSB_CSB_FSPI_PVTPORTSC1_0_PLS_CNTRL_RESET              5
+#define XUSB_CSB_FSPI_PVTPORTSC1_0_PLS_VALID_RANGE              4:4
+#define XUSB_CSB_FSPI_PVTPORTSC1_0_PLS_VALID_SET                1
+#define XUSB_CSB_FSPI_PVTPORTSC2_0                              0x124004
+#define XUSB_CSB_FSPI_PVTPORTSC2_0_CSC_RANGE                    1:1
+#define XUSB_CSB_FSPI_PVTPORTSC2_0_CSC_CLEAR                    1
+#define XUSB_CSB_FSPI_PVTPORTSC3_0                              0x124008
+#define XUSB_CSB_FSPI_PVTPORTSC3_0_CCS_RANGE                    0:0
+#define XUSB_CSB_FSPI_PVTPORTSC3_0_CCS_DEV                      1
+#define XUSB_CSB_FSPI_PVTPORTSC3_0_PLS_STATUS_RANGE             7:4
+#define XUSB_CSB_FSPI_PVTPORTSC3_0_PLS_STATUS_ENABLED           0
+#define XUSB_CSB_FSPI_PVTPORTSC3_0_PLS_STATUS_FS_MODE           8
+
+#endif // INCLUDED_ARDEV_T_XUSB_CSB_H
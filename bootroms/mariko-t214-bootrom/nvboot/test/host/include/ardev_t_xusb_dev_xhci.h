@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * ardev_t_xusb_dev_xhci.h - Host stand-in for the generated XUSB device
+ * controller register header, with only the registers nvboot_xusb_dev.c
+ * and its hardware macros use. The xusb harness hooks them by these
+ * offsets, so they only need to differ from each other.
+ */
+
+#ifndef INCLUDED_ARDEV_T_XUSB_DEV_XHCI_H
+#define INCLUDED_ARDEV_T_XUSB_DEV_XHCI_H
+
+#define XUSB_DEV_XHCI_ECPLO_0                                   0x024
+#define XUSB_DEV_XHCI_CTRL_0                                    0x030
+#define XUSB_DEV_XHCI_CTRL_0_DEVADR_RANGE                       30:24
+#define XUSB_DEV_XHCI_EP_PAUSE_0                                0x054
+
+#endif // INCLUDED_ARDEV_T_XUSB_DEV_XHCI_H
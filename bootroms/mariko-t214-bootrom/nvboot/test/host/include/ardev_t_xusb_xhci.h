@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * ardev_t_xusb_xhci.h - Host stand-in for the generated xHCI register
+ * header of the XUSB host controller. The Boot ROM drives the controller
+ * without firmware, through the CSB registers, and uses none of these.
+ */
+
+#ifndef INCLUDED_ARDEV_T_XUSB_XHCI_H
+#define INCLUDED_ARDEV_T_XUSB_XHCI_H
+
+
+#endif // INCLUDED_ARDEV_T_XUSB_XHCI_H
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * arfuse.h - Host stand-in for the generated fuse register header, with
+ * only the fields the host builds use. No harness reads the key fuses,
+ * so the offsets only need to differ from each other.
+ */
+
+#ifndef INCLUDED_ARFUSE_H
+#define INCLUDED_ARFUSE_H
+
+#define FUSE_PRIVATE_KEY0_0                                     0x1a4
+#define FUSE_USB_CALIB_0                                        0x1f0
+#define FUSE_KEK00_0                                            0x2d0
+#define FUSE_BEK0_0                                             0x2e0
+#define FUSE_USB_CALIB_EXT_0                                    0x350
+
+#endif // INCLUDED_ARFUSE_H
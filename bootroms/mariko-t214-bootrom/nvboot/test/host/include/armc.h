@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * armc.h - Host stand-in for the generated memory controller register header.
+ * Only nvboot_xusb_dev_hw.c uses its registers, and the host builds model
+ * that file instead of building it.
+ */
+
+#ifndef INCLUDED_ARMC_H
+#define INCLUDED_ARMC_H
+
+#endif // INCLUDED_ARMC_H
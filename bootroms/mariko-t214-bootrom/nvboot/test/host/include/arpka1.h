@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * arpka1.h - Host stand-in for the generated PKA1 register header, with
+ * only the fields the host builds use. The offsets only fill the sticky
+ * bit table of nvboot_se_lp0_context.h and are never accessed.
+ */
+
+#ifndef INCLUDED_ARPKA1_H
+#define INCLUDED_ARPKA1_H
+
+#define PKA1_PKA1_SECURITY_PERKEY(i)                            (0x8000 + 4 * (i))
+#define PKA1_PKA1_KEYTABLE_ACCESS(i)                            (0x8010 + 4 * (i))
+#define PKA1_PKA1_SECURITY                                      0x8020
+#define PKA1_PKA1_NVSECURE_GROUP                                0x8024
+#define PKA1_CTRL_PKA_MUTEX_RR_TMOUT                            0x8028
+#define PKA1_CTRL_PKA_MUTEX_RR_TMOUT_VAL                        11:0
+#define PKA1_CTRL_PKA_MUTEX_RR_TMOUT_LOCK                       12:12
+#define PKA1_CTRL_CG                                            0x802c
+
+#endif // INCLUDED_ARPKA1_H
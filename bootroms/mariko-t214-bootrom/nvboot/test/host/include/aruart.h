@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * aruart.h - Host stand-in for the generated UART register header, with
+ * only the fields the host builds use. The offsets and fields follow the
+ * 16550 layout of the Tegra UART, one register per word.
+ */
+
+#ifndef INCLUDED_ARUART_H
+#define INCLUDED_ARUART_H
+
+#define UART_THR_DLAB_0_0                                       0x00
+#define UART_IER_DLAB_0_0                                       0x04
+#define UART_IIR_FCR_0                                          0x08
+#define UART_LCR_0                                              0x0c
+#define UART_MCR_0                                              0x10
+#define UART_LSR_0                                              0x14
+#define UART_MSR_0                                              0x18
+#define UART_SPR_0                                              0x1c
+#define UART_IRDA_CSR_0                                         0x20
+
+#define UART_IIR_FCR_0_FCR_EN_FIFO_RANGE                        0:0
+#define UART_IIR_FCR_0_FCR_EN_FIFO_ENABLE                       1
+#define UART_IIR_FCR_0_RX_CLR_RANGE                             1:1
+#define UART_IIR_FCR_0_RX_CLR_CLEAR                             1
+#define UART_IIR_FCR_0_TX_CLR_RANGE                             2:2
+#define UART_IIR_FCR_0_TX_CLR_CLEAR                             1
+
+#define UART_LCR_0_WD_SIZE_RANGE                                1:0
+#define UART_LCR_0_WD_SIZE_WORD_LENGTH_8                        3
+#define UART_LCR_0_STOP_RANGE                                   2:2
+#define UART_LCR_0_STOP_ENABLE                                  1
+#define UART_LCR_0_PAR_RANGE                                    3:3
+#define UART_LCR_0_PAR_NO_PARITY                                0
+
+#define UART_MCR_0_RTS_RANGE                                    1:1
+#define UART_MCR_0_RTS_FORCE_RTS_HI                             0
+
+#define UART_LSR_0_RDR_RANGE                                    0:0
+#define UART_LSR_0_RDR_FIELD                                    (0x1 << 0)
+#define UART_LSR_0_RDR_DATA_IN_FIFO                             1
+#define UART_LSR_0_OVRF_FIELD                                   (0x1 << 1)
+#define UART_LSR_0_PERR_FIELD                                   (0x1 << 2)
+#define UART_LSR_0_FERR_FIELD                                   (0x1 << 3)
+#define UART_LSR_0_BRK_FIELD                                    (0x1 << 4)
+#define UART_LSR_0_THRE_RANGE                                   5:5
+#define UART_LSR_0_THRE_FIELD                                   (0x1 << 5)
+#define UART_LSR_0_THRE_EMPTY                                   1
+#define UART_LSR_0_TMTY_RANGE                                   6:6
+#define UART_LSR_0_TMTY_FIELD                                   (0x1 << 6)
+#define UART_LSR_0_TMTY_EMPTY                                   1
+#define UART_LSR_0_FIFOE_RANGE                                  7:7
+#define UART_LSR_0_FIFOE_ERR                                    1
+
+#endif // INCLUDED_ARUART_H
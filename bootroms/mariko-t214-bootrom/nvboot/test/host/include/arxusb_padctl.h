@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * arxusb_padctl.h - Host stand-in for the generated XUSB pad control register header,
+ * with only the fields nvboot_usb3.c uses. No harness models the pads, so
+ * the offsets only need to differ from each other.
+ */
+
+#ifndef INCLUDED_ARXUSB_PADCTL_H
+#define INCLUDED_ARXUSB_PADCTL_H
+
+#define XUSB_PADCTL_USB2_PAD_MUX_0                              0x004
+#define XUSB_PADCTL_USB2_PAD_MUX_0_USB2_OTG_PAD_PORT0_RANGE     1:0
+#define XUSB_PADCTL_USB2_PAD_MUX_0_USB2_OTG_PAD_PORT0_XUSB      1
+#define XUSB_PADCTL_USB2_PAD_MUX_0_USB2_OTG_PAD_PORT1_RANGE     3:2
+#define XUSB_PADCTL_USB2_PAD_MUX_0_USB2_OTG_PAD_PORT1_XUSB      1
+#define XUSB_PADCTL_USB2_PAD_MUX_0_USB2_OTG_PAD_PORT2_RANGE     5:4
+#define XUSB_PADCTL_USB2_PAD_MUX_0_USB2_OTG_PAD_PORT2_XUSB      1
+#define XUSB_PADCTL_USB2_PAD_MUX_0_USB2_OTG_PAD_PORT3_RANGE     7:6
+#define XUSB_PADCTL_USB2_PAD_MUX_0_USB2_OTG_PAD_PORT3_XUSB      1
+#define XUSB_PADCTL_USB2_PAD_MUX_0_USB2_BIAS_PAD_RANGE          19:18
+#define XUSB_PADCTL_USB2_PAD_MUX_0_USB2_BIAS_PAD_XUSB           1
+#define XUSB_PADCTL_USB2_PORT_CAP_0                             0x008
+#define XUSB_PADCTL_USB2_PORT_CAP_0_PORT0_CAP_RANGE             1:0
+#define XUSB_PADCTL_USB2_PORT_CAP_0_PORT1_CAP_RANGE             5:4
+#define XUSB_PADCTL_USB2_PORT_CAP_0_PORT2_CAP_RANGE             9:8
+#define XUSB_PADCTL_USB2_PORT_CAP_0_PORT3_CAP_RANGE             13:12
+#define XUSB_PADCTL_USB2_OC_MAP_0                               0x010
+#define XUSB_PADCTL_USB2_OC_MAP_0_PORT0_OC_PIN_RANGE            3:0
+#define XUSB_PADCTL_USB2_OC_MAP_0_PORT1_OC_PIN_RANGE            7:4
+#define XUSB_PADCTL_USB2_OC_MAP_0_PORT2_OC_PIN_RANGE            11:8
+#define XUSB_PADCTL_USB2_OC_MAP_0_PORT3_OC_PIN_RANGE            15:12
+#define XUSB_PADCTL_VBUS_OC_MAP_0                               0x018
+#define XUSB_PADCTL_VBUS_OC_MAP_0_VBUS_ENABLE0_RANGE            0:0
+#define XUSB_PADCTL_VBUS_OC_MAP_0_VBUS_ENABLE0_NO               0
+#define XUSB_PADCTL_VBUS_OC_MAP_0_VBUS_ENABLE0_YES              1
+#define XUSB_PADCTL_VBUS_OC_MAP_0_VBUS_ENABLE0_OC_MAP_RANGE     4:1
+#define XUSB_PADCTL_VBUS_OC_MAP_0_VBUS_ENABLE0_OC_MAP_OC_DETECTED_VBUS_PAD0 4
+#define XUSB_PADCTL_VBUS_OC_MAP_0_VBUS_ENABLE0_OC_MAP_OC_DETECTED_VBUS_PAD1 5
+#define XUSB_PADCTL_VBUS_OC_MAP_0_VBUS_ENABLE1_RANGE            5:5
+#define XUSB_PADCTL_VBUS_OC_MAP_0_VBUS_ENABLE1_NO               0
+#define XUSB_PADCTL_VBUS_OC_MAP_0_VBUS_ENABLE1_YES              1
+#define XUSB_PADCTL_VBUS_OC_MAP_0_VBUS_ENABLE1_OC_MAP_RANGE     9:6
+#define XUSB_PADCTL_OC_DET_0                                    0x01c
+#define XUSB_PADCTL_OC_DET_0_SET_OC_DETECTED0_RANGE             0:0
+#define XUSB_PADCTL_OC_DET_0_SET_OC_DETECTED0_YES               1
+#define XUSB_PADCTL_OC_DET_0_SET_OC_DETECTED1_RANGE             1:1
+#define XUSB_PADCTL_OC_DET_0_SET_OC_DETECTED1_YES               1
+#define XUSB_PADCTL_OC_DET_0_SET_OC_DETECTED2_RANGE             2:2
+#define XUSB_PADCTL_OC_DET_0_SET_OC_DETECTED2_YES               1
+#define XUSB_PADCTL_OC_DET_0_SET_OC_DETECTED3_RANGE             3:3
+#define XUSB_PADCTL_OC_DET_0_SET_OC_DETECTED3_YES               1
+#define XUSB_PADCTL_OC_DET_0_OC_DETECTED_VBUS_PAD0_RANGE        12:12
+#define XUSB_PADCTL_OC_DET_0_OC_DETECTED_VBUS_PAD0_YES          1
+#define XUSB_PADCTL_OC_DET_0_OC_DETECTED_VBUS_PAD1_RANGE        13:13
+#define XUSB_PADCTL_OC_DET_0_OC_DETECTED_VBUS_PAD1_YES          1
+#define XUSB_PADCTL_OC_DET_0_OC_DETECTED_VBUS_PAD2_RANGE        14:14
+#define XUSB_PADCTL_OC_DET_0_OC_DETECTED_VBUS_PAD2_YES          1
+#define XUSB_PADCTL_OC_DET_0_OC_DETECTED_VBUS_PAD3_RANGE        15:15
+#define XUSB_PADCTL_OC_DET_0_OC_DETECTED_VBUS_PAD3_YES          1
+#define XUSB_PADCTL_BOOT_MEDIA_0                                0x030
+#define XUSB_PADCTL_BOOT_MEDIA_0_BOOT_PORT_RANGE                3:0
+#define XUSB_PADCTL_BOOT_MEDIA_0_BOOT_MEDIA_ENABLE_RANGE        4:4
+#define XUSB_PADCTL_BOOT_MEDIA_0_BOOT_MEDIA_ENABLE_YES          1
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD0_CTL0_0            0x080
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD0_CTL0_0_PD_CHG_RANGE 0:0
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD0_CTL0_0_PD_CHG_NO  0
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD0_CTL1_0            0x084
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD0_CTL1_0_PD_VREG_RANGE 6:6
+#define XUSB_PADCTL_USB2_OTG_PAD0_CTL_0_0                       0x088
+#define XUSB_PADCTL_USB2_OTG_PAD0_CTL_0_0_HS_CURR_LEVEL_RANGE   5:0
+#define XUSB_PADCTL_USB2_OTG_PAD0_CTL_0_0_PD_RANGE              26:26
+#define XUSB_PADCTL_USB2_OTG_PAD0_CTL_0_0_PD_SW_DEFAULT         0
+#define XUSB_PADCTL_USB2_OTG_PAD0_CTL_0_0_PD_ZI_RANGE           29:29
+#define XUSB_PADCTL_USB2_OTG_PAD0_CTL_0_0_PD_ZI_SW_DEFAULT      0
+#define XUSB_PADCTL_USB2_OTG_PAD0_CTL_1_0                       0x08c
+#define XUSB_PADCTL_USB2_OTG_PAD0_CTL_1_0_PD_DR_RANGE           2:2
+#define XUSB_PADCTL_USB2_OTG_PAD0_CTL_1_0_PD_DR_SW_DEFAULT      0
+#define XUSB_PADCTL_USB2_OTG_PAD0_CTL_1_0_TERM_RANGE_ADJ_RANGE  6:3
+#define XUSB_PADCTL_USB2_OTG_PAD0_CTL_1_0_RPD_CTRL_RANGE        30:26
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD1_CTL0_0            0x0c0
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD1_CTL0_0_PD_CHG_RANGE 0:0
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD1_CTL0_0_PD_CHG_NO  0
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD1_CTL1_0            0x0c4
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD1_CTL1_0_PD_VREG_RANGE 6:6
+#define XUSB_PADCTL_USB2_OTG_PAD1_CTL_0_0                       0x0c8
+#define XUSB_PADCTL_USB2_OTG_PAD1_CTL_0_0_HS_CURR_LEVEL_RANGE   5:0
+#define XUSB_PADCTL_USB2_OTG_PAD1_CTL_0_0_PD_RANGE              26:26
+#define XUSB_PADCTL_USB2_OTG_PAD1_CTL_0_0_PD_SW_DEFAULT         0
+#define XUSB_PADCTL_USB2_OTG_PAD1_CTL_0_0_PD_ZI_RANGE           29:29
+#define XUSB_PADCTL_USB2_OTG_PAD1_CTL_0_0_PD_ZI_SW_DEFAULT      0
+#define XUSB_PADCTL_USB2_OTG_PAD1_CTL_1_0                       0x0cc
+#define XUSB_PADCTL_USB2_OTG_PAD1_CTL_1_0_PD_DR_RANGE           2:2
+#define XUSB_PADCTL_USB2_OTG_PAD1_CTL_1_0_PD_DR_SW_DEFAULT      0
+#define XUSB_PADCTL_USB2_OTG_PAD1_CTL_1_0_TERM_RANGE_ADJ_RANGE  6:3
+#define XUSB_PADCTL_USB2_OTG_PAD1_CTL_1_0_RPD_CTRL_RANGE        30:26
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD2_CTL0_0            0x100
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD2_CTL0_0_PD_CHG_RANGE 0:0
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD2_CTL0_0_PD_CHG_NO  0
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD2_CTL1_0            0x104
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD2_CTL1_0_PD_VREG_RANGE 6:6
+#define XUSB_PADCTL_USB2_OTG_PAD2_CTL_0_0                       0x108
+#define XUSB_PADCTL_USB2_OTG_PAD2_CTL_0_0_HS_CURR_LEVEL_RANGE   5:0
+#define XUSB_PADCTL_USB2_OTG_PAD2_CTL_0_0_PD_RANGE              26:26
+#define XUSB_PADCTL_USB2_OTG_PAD2_CTL_0_0_PD_SW_DEFAULT         0
+#define XUSB_PADCTL_USB2_OTG_PAD2_CTL_0_0_PD_ZI_RANGE           29:29
+#define XUSB_PADCTL_USB2_OTG_PAD2_CTL_0_0_PD_ZI_SW_DEFAULT      0
+#define XUSB_PADCTL_USB2_OTG_PAD2_CTL_1_0                       0x10c
+#define XUSB_PADCTL_USB2_OTG_PAD2_CTL_1_0_PD_DR_RANGE           2:2
+#define XUSB_PADCTL_USB2_OTG_PAD2_CTL_1_0_PD_DR_SW_DEFAULT      0
+#define XUSB_PADCTL_USB2_OTG_PAD2_CTL_1_0_TERM_RANGE_ADJ_RANGE  6:3
+#define XUSB_PADCTL_USB2_OTG_PAD2_CTL_1_0_RPD_CTRL_RANGE        30:26
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD3_CTL0_0            0x140
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD3_CTL0_0_PD_CHG_RANGE 0:0
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD3_CTL0_0_PD_CHG_NO  0
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD3_CTL1_0            0x144
+#define XUSB_PADCTL_USB2_BATTERY_CHRG_OTGPAD3_CTL1_0_PD_VREG_RANGE 6:6
+#define XUSB_PADCTL_USB2_OTG_PAD3_CTL_0_0                       0x148
+#define XUSB_PADCTL_USB2_OTG_PAD3_CTL_0_0_HS_CURR_LEVEL_RANGE   5:0
+#define XUSB_PADCTL_USB2_OTG_PAD3_CTL_0_0_PD_RANGE              26:26
+#define XUSB_PADCTL_USB2_OTG_PAD3_CTL_0_0_PD_SW_DEFAULT         0
+#define XUSB_PADCTL_USB2_OTG_PAD3_CTL_0_0_PD_ZI_RANGE           29:29
+#define XUSB_PADCTL_USB2_OTG_PAD3_CTL_0_0_PD_ZI_SW_DEFAULT      0
+#define XUSB_PADCTL_USB2_OTG_PAD3_CTL_1_0                       0x14c
+#define XUSB_PADCTL_USB2_OTG_PAD3_CTL_1_0_PD_DR_RANGE           2:2
+#define XUSB_PADCTL_USB2_OTG_PAD3_CTL_1_0_PD_DR_SW_DEFAULT      0
+#define XUSB_PADCTL_USB2_OTG_PAD3_CTL_1_0_TERM_RANGE_ADJ_RANGE  6:3
+#define XUSB_PADCTL_USB2_OTG_PAD3_CTL_1_0_RPD_CTRL_RANGE        30:26
+#define XUSB_PADCTL_USB2_BIAS_PAD_CTL_0_0                       0x284
+#define XUSB_PADCTL_USB2_BIAS_PAD_CTL_0_0_PD_RANGE              11:11
+#define XUSB_PADCTL_USB2_BIAS_PAD_CTL_0_0_PD_SW_DEFAULT         0
+
+#endif // INCLUDED_ARXUSB_PADCTL_H
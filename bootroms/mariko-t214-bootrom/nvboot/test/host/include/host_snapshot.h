@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * host_snapshot.h - Forced into every host harness build.
+ *
+ * This tree is a snapshot: some generated headers are missing and
+ * nvboot_error.h predates a few error codes the sources use. The host
+ * build defines them here. Drop an entry once the real header has it.
+ */
+
+#ifndef INCLUDED_HOST_SNAPSHOT_H
+#define INCLUDED_HOST_SNAPSHOT_H
+
+// Error codes used by the sources but missing from nvboot_error.h. The
+// values only need to differ from each other and from the enum.
+#define NvBootError_Fault_Injection_Detection                0x1000
+#define NvBootError_UnsupportedShaVariant                    0x1001
+#define NvBootError_XusbCswStatusCmdGood                     0x1002
+
+// Boot type used by the sources but missing from nvboot_bit.h.
+#define NvBootType_Sc7                                       0x100
+
+// Address map entries from the missing generated headers.
+#define NV_ADDRESS_MAP_IROM_BASE                             0x00100000
+#define NV_ADDRESS_MAP_IRAM_A_BASE                           0x40000000
+#define NV_ADDRESS_MAP_IRAM_B_BASE                           0x40010000
+#define NV_ADDRESS_MAP_IRAM_D_LIMIT                          0x4003ffff
+#define NV_ADDRESS_MAP_TMRUS_BASE                            0x60005010
+#define NV_ADDRESS_MAP_CAR_BASE                              0x60006000
+#define NV_ADDRESS_MAP_CLK_RST_BASE                          0x60006000
+#define NV_ADDRESS_MAP_PPSB_CLK_RST_BASE                     0x60006000
+#define NV_ADDRESS_MAP_APB_MISC_BASE                         0x70000000
+#define NV_ADDRESS_MAP_MISC_BASE                             0x70000000
+#define NV_ADDRESS_MAP_APB_UARTA_BASE                        0x70006000
+#define NV_ADDRESS_MAP_PMC_BASE                              0x7000e400
+#define NV_ADDRESS_MAP_FUSE_BASE                             0x7000f800
+#define NV_ADDRESS_MAP_SE_BASE                               0x70012000
+#define NV_XUSB_HOST_APB_DFPCI_CFG                           0x70098000
+#define NV_ADDRESS_MAP_XUSB_PADCTL_BASE                      0x7009f000
+#define NV_ADDRESS_MAP_XUSB_DEV_BASE                         0x700d0000
+#define NV_ADDRESS_MAP_SE2_BASE                              0x70412000
+#define NV_ADDRESS_MAP_TZRAM_BASE                            0x7c010000
+#define NV_ADDRESS_MAP_EMEM_LO_SIZE                          0x80000000
+
+#endif // INCLUDED_HOST_SNAPSHOT_H
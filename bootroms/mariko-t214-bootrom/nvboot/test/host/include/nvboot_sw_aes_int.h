@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * nvboot_sw_aes_int.h - Host stand-in for the software AES header the
+ * tree lacks, declaring the entry points of core/sw_aes/nvboot_sw_aes.c.
+ */
+
+#ifndef INCLUDED_NVBOOT_SW_AES_INT_H
+#define INCLUDED_NVBOOT_SW_AES_INT_H
+
+#include "nvtypes.h"
+#include "nvboot_crypto_aes_param.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+void NvAesExpandKey(uint8_t *key, uint8_t *expkey, NvBootAesKeySize KeySize);
+void NvAesEncrypt(uint8_t *in, uint8_t *expkey, uint8_t *out,
+                  NvBootAesKeySize KeySize);
+void NvAesDecrypt(uint8_t *in, uint8_t *expkey, uint8_t *out,
+                  NvBootAesKeySize KeySize);
+NvU32 NvAesGetKeySizeInBytes(NvBootAesKeySize KeySize);
+void NvAesGenerateKeySchedule(uint8_t *Key, uint8_t *KeySchedule,
+                              NvBool EncryptData, NvBootAesKeySize KeySize);
+void NvAesEncryptObject(uint8_t *KeySchedule, uint8_t *Src, uint8_t *Dst,
+                        NvU32 NumAesBlocks, NvBootAesKeySize KeySize);
+void NvAesDecryptObject(uint8_t *KeySchedule, uint8_t *Iv, uint8_t *Src,
+                        uint8_t *Dst, NvU32 NumAesBlocks,
+                        NvBootAesKeySize KeySize);
+void NvAesCmacGenerateSubkey(uint8_t *Key, uint8_t *KeySchedule,
+                             uint8_t *pK1, NvBootAesKeySize KeySize);
+void NvAesCmacSignObject(uint8_t *Key, uint8_t *KeySchedule, uint8_t *Src,
+                         uint8_t *Dst, NvU32 NumAesBlocks,
+                         NvBootAesKeySize KeySize);
+void NvAesCmacGenerateSubkeys(uint8_t *KeySchedule,
+                              NvBootAesCmacHashParams *Subkeys,
+                              NvBootAesKeySize KeySize);
+void NvAesCmacInit(NvBootAesCmacContext *Context, uint8_t *KeySchedule,
+                   const NvBootAesCmacHashParams *Subkeys,
+                   NvBootAesKeySize KeySize);
+void NvAesCmacUpdate(NvBootAesCmacContext *Context, const uint8_t *Src,
+                     NvU32 Len);
+void NvAesCmacFinal(NvBootAesCmacContext *Context, uint8_t *Dst);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // INCLUDED_NVBOOT_SW_AES_INT_H
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * project.h - Host stand-in for the generated per-project header. The
+ * definitions a harness needs are in host_snapshot.h.
+ */
+
+#ifndef INCLUDED_PROJECT_H
+#define INCLUDED_PROJECT_H
+
+#endif // INCLUDED_PROJECT_H
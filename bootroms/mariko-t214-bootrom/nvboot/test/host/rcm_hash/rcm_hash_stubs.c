@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * rcm_hash_stubs.c - The functions nvboot_rcm.c and nvboot_crypto_mgr.c
+ * call outside ReceiveMessage() and the RCM hash: RCM and crypto manager
+ * initialization, fuses, straps, key loading and the FSKP payload. The
+ * harness runs none of those, so reaching any of these aborts.
+ *
+ * The symbols are defined without their headers, so that one macro fits
+ * all of them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MODEL_STUB(Name)                                        \
+    void Name(void)                                             \
+    {                                                           \
+        fprintf(stderr, "rcm_hash: %s called\n", #Name);        \
+        abort();                                                \
+    }
+
+MODEL_STUB(NvBootAesDevMgrInit)
+MODEL_STUB(NvBootClocksEngine)
+MODEL_STUB(NvBootCryptoRsaSsaPssInit)
+MODEL_STUB(NvBootDebugSetDebugFeatures)
+MODEL_STUB(NvBootFuseAddAdditionalEcidInfo)
+MODEL_STUB(NvBootFuseBootSecurityIsEncryptionEnabled)
+MODEL_STUB(NvBootFuseGetBootSecurityAuthenticationInfo)
+MODEL_STUB(NvBootFuseGetFuseDecryptionKeySelection)
+MODEL_STUB(NvBootFuseGetOemFekBankSelect)
+MODEL_STUB(NvBootFuseGetPcpHash)
+MODEL_STUB(NvBootFuseGetSecureProvisionIndex)
+MODEL_STUB(NvBootFuseGetSecureProvisioningIndexValidity)
+MODEL_STUB(NvBootFuseGetUniqueId)
+MODEL_STUB(NvBootFuseIsNvProductionMode)
+MODEL_STUB(NvBootFuseIsOdmProductionMode)
+MODEL_STUB(NvBootFuseIsOemFuseEncryptionEnabled)
+MODEL_STUB(NvBootFuseIsPkcBootMode)
+MODEL_STUB(NvBootFuseIsSecureProvisioningMode)
+MODEL_STUB(NvBootPkaHwInit)
+MODEL_STUB(NvBootRcmSetupPortHandle)
+MODEL_STUB(NvBootRngInit)
+MODEL_STUB(NvBootRsaDevMgrInit)
+MODEL_STUB(NvBootSeDisableAesKeySlotRead)
+MODEL_STUB(NvBootSeInitializeSE)
+MODEL_STUB(NvBootSeInstanceAesDecryptKeyIntoKeySlot)
+MODEL_STUB(NvBootSeInstanceAesDecryptStart)
+MODEL_STUB(NvBootSeInstanceKeySlotWriteKeyIV)
+MODEL_STUB(NvBootSeKeySizeConv)
+MODEL_STUB(NvBootStrapIsDebugRecoveryMode)
+MODEL_STUB(NvBootStrapIsForceRecoveryMode)
+MODEL_STUB(NvBootWdtReload)
@@ -0,0 +1,596 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of the SHA-256 of the RCM message computed while it is
+ * received: ReceiveMessage() of core/rcm/nvboot_rcm.c and
+ * NvBootCryptoMgrOemRcmHash*() of core/cryptomgr/nvboot_crypto_mgr.c.
+ *
+ * Both files are built unchanged. The USB port is a loopback that lands
+ * the host's message where ReceiveMessage() asks, one read of a chosen or
+ * random size at a time. SE1 is a function level model of
+ * NvBootSeInstanceSHA256HashChunkStart(): it reads its chunk when it is
+ * started, keeps the engine busy for SETUP_NS plus the chunk at its rate,
+ * and hashes the gathered message with the software SHA on the last chunk.
+ * NvBootCryptoRsaSsaPssVerify() only records what it is handed.
+ *
+ * The model checks the streaming contract as it goes: no chunk is started
+ * on a busy engine, chunks follow each other over the signed section with
+ * consistent lengths, every chunk but the last is whole SHA blocks, and no
+ * chunk reads bytes the port has not landed yet.
+ *
+ * Time is kept in nanoseconds on one timeline: the host sends at the USB
+ * rate, from when the device asks for data until the rest of the message
+ * is armed on the port, and then without a break. The rates are
+ * assumptions, not measurements.
+ *
+ * "check" receives random messages with random read splits, with the SE
+ * untimed and timed, and checks the digest and that RSASSA-PSS is handed
+ * it once; then failed receives and the AES-CMAC scheme, which is not
+ * streamed. "bench" prints the time from the last byte to the digest,
+ * streamed and hashed after the receive.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <sys/mman.h>
+
+#include "nvboot_crypto_mgr_int.h"
+#include "nvboot_sha_devmgr_int.h"
+#include "nvboot_se_int.h"
+#include "nvboot_context_int.h"
+#include "nvboot_config.h"
+#include "nvboot_rcm.h"
+#include "nvboot_rcm_port_int.h"
+#include "host_clock.h"
+
+#define MSG_ADDRESS         NVBOOT_RCM_MSG_IRAM_START
+#define SIGNED_OFFSET       offsetof(NvBootRcmMsg, RandomAesBlock)
+#define SHA_BLOCK           NVBOOT_SHA256_BLOCK_BYTES
+
+/* IRAM, which the model maps at its address. */
+#define IRAM_START          NV_ADDRESS_MAP_IRAM_A_BASE
+#define IRAM_BYTES          (NV_ADDRESS_MAP_IRAM_D_LIMIT + 1 - IRAM_START)
+
+/* Assumed costs: a chunk start, and a poll of a busy engine. */
+#define SETUP_NS            2000
+#define POLL_NS             20
+#define USB_RATE            40      /* MB/s */
+
+#define NUM_RANDOM          2000
+#define RANDOM_READS        0
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "rcm_hash: %s:%d: %s\n", __FILE__,          \
+                    __LINE__, #Cond);                                   \
+        }                                                               \
+    } while (0)
+
+NvBootInfoTable BootInfoTable;
+NvBootContext Context;
+int32_t FI_counter1;
+int32_t FI_IncrDist;
+
+/* Defined by startup/start.S; only the version query reads it. */
+NvU32 NvBootBootromVersionAddress;
+
+/* The crypto manager state, not declared by its header. */
+extern NvBootCryptoMgrContext s_CryptoMgrContext;
+extern NvBootCryptoMgrBuffers s_CryptoMgr_Buffers;
+
+/* Not declared by a header either. */
+NvBootError ReceiveMessage(NvBootRcmMsg *pRcmMsgHeader);
+
+/* Loopback port: the host side and the timeline of the bus. */
+typedef struct
+{
+    NvU32 Length;
+    NvU32 Pos;
+    NvU32 ReadBytes;        /* bytes per read, RANDOM_READS for random */
+    NvU32 FailAt;           /* fail the read that reaches it, 0 never */
+    NvU32 UsbRate;          /* MB/s, 0 for no time on the bus */
+    NvBool Armed;
+    NvU32 ArmPos;
+    NvU64 ArmNs;
+    NvU64 LastByteNs;
+    NvU32 Reads;
+    NvU32 Errors;
+} LoopbackPort;
+
+/* SE1 as the RCM hash drives it. */
+typedef struct
+{
+    NvU32 Rate;             /* MB/s, 0 to finish every chunk at once */
+    NvU64 BusyUntil;
+    NvU64 DoneNs;           /* when the last chunk completes */
+    NvU32 Ops;
+    NvU32 BusyFaults;
+    NvU32 Errors;
+
+    /* The message the SHA has read so far. */
+    NvU8 Message[NVBOOT_RCM_MAX_MSG_LENGTH];
+    NvU32 MessageBytes;
+} ModelSha;
+
+/* What NvBootCryptoRsaSsaPssVerify() was handed. */
+typedef struct
+{
+    NvU32 Calls;
+    NvBool IsHashed;
+    NvU32 Digest[NVBOOT_SHA256_LENGTH_WORDS];
+    const uint32_t *Message;
+    NvU32 MessageBytes;
+} VerifyRecord;
+
+static LoopbackPort s_Loop;
+static ModelSha s_Sha;
+static VerifyRecord s_Verify;
+static NvBootRCMPort_T s_Port;
+static NvBootShaDevMgr s_SwSha;
+static NvU64 s_Now;
+
+static NvBootRcmMsg *const s_Msg = (NvBootRcmMsg *)MSG_ADDRESS;
+static NvU8 s_HostMsg[NVBOOT_RCM_MAX_MSG_LENGTH];
+static NvU32 s_Expected[NVBOOT_SHA256_LENGTH_WORDS];
+static NvU32 s_Rand = 1;
+
+static NvU32 Xorshift(void)
+{
+    s_Rand ^= s_Rand << 13;
+    s_Rand ^= s_Rand >> 17;
+    s_Rand ^= s_Rand << 5;
+    return s_Rand;
+}
+
+static void AdvanceTo(NvU64 Ns)
+{
+    if (s_Now < Ns)
+        s_Now = Ns;
+}
+
+static void ModelError(NvU32 *pErrors, const char *What)
+{
+    fprintf(stderr, "rcm_hash: model: %s\n", What);
+    (*pErrors)++;
+}
+
+void NvBootSeInstanceSHA256HashChunkStart(NvBootSeInstance SeInstance,
+                                          NvU32 *pChunk, NvU32 ChunkSizeBytes,
+                                          NvU32 MessageSizeBytes,
+                                          NvU32 MessageBytesLeft,
+                                          NvU32 *pOutputDestination)
+{
+    const NvU8 *Signed = (const NvU8 *)MSG_ADDRESS + SIGNED_OFFSET;
+    NvBool Last = (ChunkSizeBytes == MessageBytesLeft);
+
+    if (s_Now < s_Sha.BusyUntil)
+    {
+        s_Sha.BusyFaults++;
+        s_Now = s_Sha.BusyUntil;
+    }
+    if (MessageBytesLeft == MessageSizeBytes)
+        s_Sha.MessageBytes = 0;
+
+    if (SeInstance != NvBootSeInstance_Se1)
+        ModelError(&s_Sha.Errors, "not SE1");
+    if (MessageSizeBytes != s_Loop.Length - SIGNED_OFFSET)
+        ModelError(&s_Sha.Errors, "message size is not the signed section");
+    if (MessageBytesLeft != MessageSizeBytes - s_Sha.MessageBytes)
+        ModelError(&s_Sha.Errors, "bytes left do not follow the last chunk");
+    if ((const NvU8 *)pChunk != Signed + s_Sha.MessageBytes)
+        ModelError(&s_Sha.Errors, "chunk does not follow the last chunk");
+    if (ChunkSizeBytes > MessageBytesLeft)
+        ModelError(&s_Sha.Errors, "chunk past the end of the message");
+    if (!Last && ((ChunkSizeBytes % SHA_BLOCK) != 0))
+        ModelError(&s_Sha.Errors, "partial block before the last chunk");
+    if (SIGNED_OFFSET + s_Sha.MessageBytes + ChunkSizeBytes > s_Loop.Pos)
+        ModelError(&s_Sha.Errors, "chunk reads bytes not yet received");
+    if (s_Sha.Errors)
+        return;
+
+    memcpy(&s_Sha.Message[s_Sha.MessageBytes], pChunk, ChunkSizeBytes);
+    s_Sha.MessageBytes += ChunkSizeBytes;
+
+    s_Sha.BusyUntil = s_Now;
+    if (s_Sha.Rate)
+        s_Sha.BusyUntil += SETUP_NS +
+                           (NvU64)ChunkSizeBytes * 1000 / s_Sha.Rate;
+    s_Sha.Ops++;
+
+    if (Last)
+    {
+        s_SwSha.ShaDevMgrCallbacks->ShaHash((uint32_t *)s_Sha.Message,
+                                            s_Sha.MessageBytes,
+                                            pOutputDestination,
+                                            &s_SwSha.ShaConfig);
+        s_Sha.DoneNs = s_Sha.BusyUntil;
+    }
+}
+
+NvBool NvBootSeInstanceIsEngineBusy(NvBootSeInstance Instance, NvU8 *DestAddr)
+{
+    (void)DestAddr;
+    if (s_Now >= s_Sha.BusyUntil)
+        return NV_FALSE;
+    s_Now += POLL_NS;
+    return NV_TRUE;
+}
+
+NvBootError NvBootCryptoRsaSsaPssVerify(NvBootCryptoRsaSsaPssContext *RsaSsaPssContext,
+                                        NvBootShaDevMgr *ShaDevMgr,
+                                        NvBootRsaDevMgr *RsaDevMgr)
+{
+    s_Verify.Calls++;
+    s_Verify.IsHashed = RsaSsaPssContext->InputMessageIsHashed;
+    if (s_Verify.IsHashed)
+        memcpy(s_Verify.Digest, RsaSsaPssContext->InputMessageShaHash,
+               sizeof(s_Verify.Digest));
+    s_Verify.Message = RsaSsaPssContext->InputMessage;
+    s_Verify.MessageBytes = RsaSsaPssContext->InputMessageLengthBytes;
+    return NvBootError_Success;
+}
+
+/* A read size: mostly packets and port chunks, sometimes odd bytes. */
+static NvU32 RandomReadBytes(void)
+{
+    switch (Xorshift() % 6)
+    {
+        case 0:  return 1 + Xorshift() % (SHA_BLOCK - 1);
+        case 1:  return 1 + Xorshift() % 4096;
+        case 2:  return 512 * (1 + Xorshift() % 32);
+        case 3:  return 16384;
+        default: return 65536;
+    }
+}
+
+static NvBootError LoopReceiveStart(uint8_t *Buffer, NvU32 Bytes)
+{
+    if ((Buffer != (uint8_t *)MSG_ADDRESS + s_Loop.Pos) ||
+        (s_Loop.Pos + Bytes != s_Loop.Length))
+        ModelError(&s_Loop.Errors, "armed window is not the rest of the message");
+    s_Loop.Armed = NV_TRUE;
+    s_Loop.ArmPos = s_Loop.Pos;
+    s_Loop.ArmNs = s_Now;
+    return NvBootError_Success;
+}
+
+static NvBootError LoopReceive(uint8_t *Buffer, NvU32 Bytes,
+                               NvU32 *pBytesReceived)
+{
+    NvU32 n;
+
+    *pBytesReceived = 0;
+    if (Buffer != (uint8_t *)MSG_ADDRESS + s_Loop.Pos)
+        ModelError(&s_Loop.Errors, "read does not follow the last one");
+    if (s_Loop.Pos == s_Loop.Length)
+        return NvBootError_HwTimeOut;
+
+    n = s_Loop.ReadBytes ? s_Loop.ReadBytes : RandomReadBytes();
+    n = NV_MIN(n, NV_MIN(Bytes, s_Loop.Length - s_Loop.Pos));
+    if (s_Loop.FailAt && (s_Loop.Pos + n >= s_Loop.FailAt))
+        return NvBootError_TxferFailed;
+
+    memcpy(Buffer, s_HostMsg + s_Loop.Pos, n);
+    s_Loop.Pos += n;
+    s_Loop.Reads++;
+
+    // Once armed, the host sends the rest without waiting for the reads.
+    if (s_Loop.UsbRate && s_Loop.Armed)
+        AdvanceTo(s_Loop.ArmNs + (NvU64)(s_Loop.Pos - s_Loop.ArmPos) * 1000 /
+                                 s_Loop.UsbRate);
+    else if (s_Loop.UsbRate)
+        s_Now += (NvU64)n * 1000 / s_Loop.UsbRate;
+    if (s_Loop.Pos == s_Loop.Length)
+        s_Loop.LastByteNs = s_Now;
+
+    *pBytesReceived = n;
+    return NvBootError_Success;
+}
+
+static NvBootError LoopTransfer(uint8_t *Buffer, NvU32 Bytes,
+                                NvU32 *pBytesTransferred)
+{
+    *pBytesTransferred = Bytes;
+    return NvBootError_Success;
+}
+
+static NvBootError LoopHandleError(void)
+{
+    return NvBootError_Success;
+}
+
+NvBootRCMPort_T *NvBootRcmGetPortHandle(void)
+{
+    return &s_Port;
+}
+
+static void MapIram(void)
+{
+    void *p = mmap((void *)IRAM_START, IRAM_BYTES, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if (p != (void *)IRAM_START)
+    {
+        fprintf(stderr, "rcm_hash: cannot map IRAM at 0x%x\n", IRAM_START);
+        exit(1);
+    }
+}
+
+/*
+ * A message of Length bytes in s_HostMsg, and the SHA-256 of its signed
+ * section in s_Expected. Length must be a valid insecure length.
+ */
+static void BuildMessage(NvU32 Length)
+{
+    NvBootRcmMsg *pMsg = (NvBootRcmMsg *)s_HostMsg;
+    NvU32 i;
+
+    for (i = 0; i < Length; i++)
+        s_HostMsg[i] = Xorshift();
+    pMsg->LengthInsecure = Length;
+    s_SwSha.ShaDevMgrCallbacks->ShaHash((uint32_t *)(s_HostMsg + SIGNED_OFFSET),
+                                        Length - SIGNED_OFFSET, s_Expected,
+                                        &s_SwSha.ShaConfig);
+}
+
+/* A valid insecure length with Payload bytes or fewer after the header. */
+static NvU32 MessageLength(NvU32 Payload)
+{
+    NvU32 Length = sizeof(NvBootRcmMsg) + Payload;
+
+    Length -= (Length - SIGNED_OFFSET) % NVBOOT_SE_AES_BLOCK_LENGTH_BYTES;
+    while (Length >= NVBOOT_RCM_MAX_MSG_LENGTH)
+        Length -= NVBOOT_SE_AES_BLOCK_LENGTH_BYTES;
+    return Length;
+}
+
+static NvBootError Receive(NvU32 ReadBytes, NvU32 SeRate, NvU32 UsbRate,
+                           NvU32 FailAt)
+{
+    memset(&s_Loop, 0, sizeof(s_Loop));
+    s_Loop.Length = ((NvBootRcmMsg *)s_HostMsg)->LengthInsecure;
+    s_Loop.ReadBytes = ReadBytes;
+    s_Loop.UsbRate = UsbRate;
+    s_Loop.FailAt = FailAt;
+
+    // A failed receive may leave the engine busy for the next one.
+    s_Sha.Rate = SeRate;
+    s_Sha.Ops = 0;
+    s_Sha.BusyFaults = 0;
+    s_Sha.Errors = 0;
+    s_Sha.DoneNs = 0;
+    memset(&s_Verify, 0, sizeof(s_Verify));
+
+    memset(s_Msg, 0, sizeof(NvBootRcmMsg));
+    return ReceiveMessage(s_Msg);
+}
+
+/* The receive of s_HostMsg streamed its signed section into the digest. */
+static void CheckStreamed(NvBootError e)
+{
+    CHECK(e == NvBootError_Success);
+    CHECK(s_Loop.Errors == 0);
+    CHECK(s_Sha.Errors == 0);
+    CHECK(s_Sha.BusyFaults == 0);
+    CHECK(s_Sha.MessageBytes == s_Loop.Length - SIGNED_OFFSET);
+    CHECK(s_CryptoMgrContext.RcmHashState == RCM_HASH_DONE);
+    CHECK(!memcmp(&s_CryptoMgr_Buffers.Calculated_RcmHash, s_Expected,
+                  sizeof(s_Expected)));
+}
+
+/* RSASSA-PSS is handed the digest once, then hashes the message itself. */
+static void CheckAuth(void)
+{
+    NvBootError e;
+
+    e = NvBootCryptoMgrOemAuthRcmPayload(s_Msg);
+    CHECK(e == NvBootError_Success);
+    CHECK(s_Verify.Calls == 1);
+    CHECK(s_Verify.IsHashed);
+    CHECK(!memcmp(s_Verify.Digest, s_Expected, sizeof(s_Expected)));
+    CHECK((const NvU8 *)s_Verify.Message == (NvU8 *)s_Msg + SIGNED_OFFSET);
+    CHECK(s_Verify.MessageBytes == s_Loop.Length - SIGNED_OFFSET);
+
+    e = NvBootCryptoMgrOemAuthRcmPayload(s_Msg);
+    CHECK(e == NvBootError_Success);
+    CHECK(s_Verify.Calls == 2);
+    CHECK(!s_Verify.IsHashed);
+}
+
+static void CheckRandom(void)
+{
+    static const NvU32 SeRates[] = { 0, 100, 400 };
+    NvU32 i, Length, SeRate, UsbRate;
+    NvBootError e;
+
+    s_CryptoMgrContext.AuthenticationScheme = CryptoAlgo_RSA_RSASSA_PSS;
+    for (i = 0; i < NUM_RANDOM; i++)
+    {
+        Length = MessageLength(Xorshift() % NVBOOT_BL_IRAM_SIZE);
+        SeRate = SeRates[i % 3];
+        UsbRate = SeRate ? USB_RATE : 0;
+        BuildMessage(Length);
+
+        e = Receive(RANDOM_READS, SeRate, UsbRate, 0);
+        CheckStreamed(e);
+        if (e != NvBootError_Success || s_Sha.Errors)
+            fprintf(stderr, "rcm_hash: message %u, %u bytes, SE %u MB/s: "
+                    "error 0x%x\n", i, Length, SeRate, (unsigned)e);
+        CheckAuth();
+    }
+}
+
+/*
+ * Fixed read sizes over the largest message, with an engine that is never
+ * busy: the digest is fed after every read that completes a block, so
+ * only the reads after the last whole block are left to the finish.
+ */
+static void CheckSplits(void)
+{
+    static const NvU32 ReadSizes[] = { 1, 63, 64, 100, 4096, 65536 };
+    NvU32 r, Length, Reads;
+
+    s_CryptoMgrContext.AuthenticationScheme = CryptoAlgo_RSA_RSASSA_PSS;
+    Length = MessageLength(NVBOOT_BL_IRAM_SIZE);
+    BuildMessage(Length);
+    for (r = 0; r < sizeof(ReadSizes) / sizeof(ReadSizes[0]); r++)
+    {
+        CheckStreamed(Receive(ReadSizes[r], 0, 0, 0));
+        Reads = (Length + ReadSizes[r] - 1) / ReadSizes[r];
+        if (ReadSizes[r] >= SHA_BLOCK)
+            CHECK(s_Sha.Ops + 1 >= Reads - (sizeof(NvBootRcmMsg) +
+                                            ReadSizes[r] - 1) / ReadSizes[r]);
+        else
+            CHECK(s_Sha.Ops >= (Length - sizeof(NvBootRcmMsg)) / SHA_BLOCK);
+        CheckAuth();
+    }
+}
+
+/*
+ * A receive that fails part way leaves a chunk running and no digest; the
+ * next message waits for the engine, starts clean and is verified with its
+ * own digest.
+ */
+static void CheckFailedReceive(void)
+{
+    NvU32 Length;
+    NvBootError e;
+
+    s_CryptoMgrContext.AuthenticationScheme = CryptoAlgo_RSA_RSASSA_PSS;
+    Length = MessageLength(NVBOOT_BL_IRAM_SIZE);
+    BuildMessage(Length);
+    e = Receive(65536, 100, USB_RATE, Length / 2);
+    CHECK(e != NvBootError_Success);
+    CHECK(s_Sha.Ops > 0);
+    CHECK(s_Now < s_Sha.BusyUntil);
+    CHECK(s_CryptoMgrContext.RcmHashState != RCM_HASH_DONE);
+    e = NvBootCryptoMgrOemAuthRcmPayload(s_Msg);
+    CHECK(!s_Verify.IsHashed);
+
+    BuildMessage(MessageLength(20000));
+    CheckStreamed(Receive(4096, 100, USB_RATE, 0));
+    CheckAuth();
+}
+
+/* Other schemes are not streamed; a changed length drops the digest. */
+static void CheckOthers(void)
+{
+    NvBootError e;
+
+    s_CryptoMgrContext.AuthenticationScheme = CryptoAlgo_AES_CMAC;
+    BuildMessage(MessageLength(100000));
+    e = Receive(4096, 100, USB_RATE, 0);
+    CHECK(e == NvBootError_Success);
+    CHECK(s_Sha.Ops == 0);
+    CHECK(s_CryptoMgrContext.RcmHashState == RCM_HASH_NONE);
+
+    s_CryptoMgrContext.AuthenticationScheme = CryptoAlgo_RSA_RSASSA_PSS;
+    CheckStreamed(Receive(4096, 100, USB_RATE, 0));
+    s_Msg->LengthInsecure -= NVBOOT_SE_AES_BLOCK_LENGTH_BYTES;
+    e = NvBootCryptoMgrOemAuthRcmPayload(s_Msg);
+    CHECK(s_Verify.Calls == 1);
+    CHECK(!s_Verify.IsHashed);
+}
+
+static int Check(void)
+{
+    CheckRandom();
+    CheckSplits();
+    CheckFailedReceive();
+    CheckOthers();
+
+    printf("rcm_hash: %u checks, %u failures\n", s_Cases, s_Failures);
+    return s_Failures != 0;
+}
+
+/*
+ * The time from the last byte on the bus to the digest for the largest
+ * message: streamed, and with the whole signed section hashed in one
+ * chunk once the message is in, as authentication does without it.
+ */
+static int Bench(void)
+{
+    static const NvU32 SeRates[] = { 100, 400 };
+    static const NvU32 ReadSizes[] = { 4096, 16384, 65536 };
+    NvU32 s, r, Length, Streamed, After, Chunks;
+    NvBootError e;
+
+    Length = MessageLength(NVBOOT_BL_IRAM_SIZE);
+    BuildMessage(Length);
+
+    printf("SHA-256 end after the last byte, %u-byte message at %u MB/s USB\n",
+           Length, USB_RATE);
+    printf("  %8s %10s %12s %14s %8s\n", "SE MB/s", "read size",
+           "streamed us", "after recv us", "chunks");
+    for (s = 0; s < sizeof(SeRates) / sizeof(SeRates[0]); s++)
+    for (r = 0; r < sizeof(ReadSizes) / sizeof(ReadSizes[0]); r++)
+    {
+        s_CryptoMgrContext.AuthenticationScheme = CryptoAlgo_RSA_RSASSA_PSS;
+        e = Receive(ReadSizes[r], SeRates[s], USB_RATE, 0);
+        if ((e != NvBootError_Success) || s_Sha.Errors || s_Loop.Errors)
+        {
+            fprintf(stderr, "rcm_hash: streamed receive failed\n");
+            return 1;
+        }
+        Streamed = s_Sha.DoneNs - s_Loop.LastByteNs;
+        Chunks = s_Sha.Ops;
+
+        s_CryptoMgrContext.AuthenticationScheme = CryptoAlgo_AES_CMAC;
+        e = Receive(ReadSizes[r], SeRates[s], USB_RATE, 0);
+        NvBootSeInstanceSHA256HashChunkStart(NvBootSeInstance_Se1,
+            (NvU32 *)((NvU8 *)s_Msg + SIGNED_OFFSET), Length - SIGNED_OFFSET,
+            Length - SIGNED_OFFSET, Length - SIGNED_OFFSET,
+            (NvU32 *)&s_CryptoMgr_Buffers.Calculated_RcmHash);
+        if ((e != NvBootError_Success) || s_Sha.Errors)
+        {
+            fprintf(stderr, "rcm_hash: receive failed\n");
+            return 1;
+        }
+        After = s_Sha.DoneNs - s_Loop.LastByteNs;
+
+        printf("  %8u %10u %12.1f %14.1f %8u\n", SeRates[s], ReadSizes[r],
+               Streamed / 1000.0, After / 1000.0, Chunks);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    /* NvBootInitializeNvBootError() reads the clock. */
+    HostClockInit();
+    MapIram();
+
+    if (NvBootShaDevMgrInit(&s_SwSha, NvBootShaDevice_SW) != NvBootError_Success)
+    {
+        fprintf(stderr, "rcm_hash: no software SHA device\n");
+        return 1;
+    }
+
+    s_Port.Context.Initialized = NV_TRUE;
+    s_Port.Context.Connected = NV_TRUE;
+    s_Port.ReceiveStart = LoopReceiveStart;
+    s_Port.Receive = LoopReceive;
+    s_Port.Transfer = LoopTransfer;
+    s_Port.HandleError = LoopHandleError;
+
+    if ((argc > 1) && !strcmp(argv[1], "bench"))
+        return Bench();
+    return Check();
+}
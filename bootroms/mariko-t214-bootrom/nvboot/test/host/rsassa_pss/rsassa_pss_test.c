@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of RSASSA-PSS verification, core/rsassa_pss/nvboot_rsassa_pss.c,
+ * on the software SHA and RSA devices.
+ *
+ * nvboot_rsa_pss_test_vector.h is a signed SC7 firmware image: its header
+ * carries the 2048-bit modulus and the signature of everything from
+ * RandomAesBlock on. "check" verifies it, with the message and with its
+ * hash, then flips every bit of the signed part and of the signature, all
+ * of which must fail. NvBootCryptoRsaSsaPssMGF() is checked on its own
+ * against MGF1 built here from the SHA device, for every mask length up to
+ * the largest a 2048-bit key gives.
+ *
+ * With OLD_REV the file at that revision is built too, as OldRsaSsaPss*,
+ * and must return the same status for every case. "bench" prints the
+ * cycles of a verify with each, and of verify steps 7 and 8 alone: MGF1
+ * and the unmasking of DB for a 2048-bit key.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "nvboot_crypto_pkc_rsassa_pss_int.h"
+#include "nvboot_crypto_signatures.h"
+#include "nvboot_warm_boot_0.h"
+#include "nvboot_rsa_pss_test_vector.h"
+#include "host_clock.h"
+
+#define RSA_SLOT    0
+#define EXPONENT    0x10001
+
+#ifndef HOST_HAVE_OLD
+#define HOST_HAVE_OLD 0
+#endif
+
+#if HOST_HAVE_OLD
+NvBootError OldRsaSsaPssInit(void);
+NvBootError OldRsaSsaPssVerify(NvBootCryptoRsaSsaPssContext *Context,
+                               NvBootShaDevMgr *ShaDevMgr,
+                               NvBootRsaDevMgr *RsaDevMgr);
+NvBootError OldRsaSsaPssMGF(uint8_t *mgfSeed, uint32_t maskLen,
+                            uint8_t *dbMaskBuffer, NvBootShaDevMgr *ShaDevMgr);
+#endif
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "rsassa_pss: %s:%d: %s\n", __FILE__,        \
+                    __LINE__, #Cond);                                   \
+        }                                                               \
+    } while (0)
+
+typedef NvBootError (*VerifyFn)(NvBootCryptoRsaSsaPssContext *,
+                                NvBootShaDevMgr *, NvBootRsaDevMgr *);
+
+static NvBootShaDevMgr s_Sha;
+static NvBootRsaDevMgr s_Rsa;
+static NvBootCryptoRsaKey s_Key;
+
+static NvBootWb0RecoveryHeader *const s_Header =
+    (NvBootWb0RecoveryHeader *)nvboot_rsa_pss_test_vector;
+
+/* The signed part of the image, RandomAesBlock to the end. */
+#define SIGNED_OFFSET   offsetof(NvBootWb0RecoveryHeader, RandomAesBlock)
+#define SIGNED_BYTES    (s_Header->LengthInsecure - SIGNED_OFFSET)
+
+static uint8_t *Signed(void)
+{
+    return (uint8_t *)s_Header + SIGNED_OFFSET;
+}
+
+static NvBootError Verify(VerifyFn Fn, NvBool Hashed)
+{
+    static uint32_t Hash[NVBOOT_SHA256_LENGTH_WORDS];
+    NvBootCryptoRsaSsaPssContext Context;
+
+    memset(&Context, 0, sizeof(Context));
+    Context.RsaKeySlot = RSA_SLOT;
+    Context.RsaKey = &s_Key;
+    Context.InputMessage = (uint32_t *)Signed();
+    Context.InputMessageLengthBytes = SIGNED_BYTES;
+    Context.InputSignature = &s_Header->Signatures.RsaSsaPssSig;
+    if (Hashed)
+    {
+        s_Sha.ShaDevMgrCallbacks->ShaHash(Context.InputMessage,
+                                          Context.InputMessageLengthBytes,
+                                          Hash, &s_Sha.ShaConfig);
+        Context.InputMessageIsHashed = true;
+        Context.InputMessageShaHash = Hash;
+    }
+    return Fn(&Context, &s_Sha, &s_Rsa);
+}
+
+/* Runs the current verify, and the old one if built, which must agree. */
+static NvBootError VerifyBoth(NvBool Hashed)
+{
+    NvBootError e = Verify(&NvBootCryptoRsaSsaPssVerify, Hashed);
+
+#if HOST_HAVE_OLD
+    CHECK(Verify(&OldRsaSsaPssVerify, Hashed) == e);
+#endif
+    return e;
+}
+
+static void CheckVector(void)
+{
+    uint8_t *Sig = s_Header->Signatures.RsaSsaPssSig.RsaSsaPssSigNvU8.RsaSsaPssSig;
+    uint8_t Saved[NVBOOT_RSA_2048_MODULUS_SIZE_BYTES];
+    NvU32 i;
+    int b;
+
+    CHECK(VerifyBoth(NV_FALSE) == NvBootError_Success);
+    CHECK(VerifyBoth(NV_TRUE) == NvBootError_Success);
+
+    for (i = 0; i < SIGNED_BYTES; i++)
+    {
+        for (b = 0; b < 8; b++)
+        {
+            Signed()[i] ^= 1 << b;
+            CHECK(VerifyBoth(NV_FALSE) == NvBootError_RsaPssVerify_Inconsistent_5);
+            Signed()[i] ^= 1 << b;
+        }
+    }
+
+    /* Any change to the signature breaks the encoding somewhere. */
+    for (i = 0; i < NVBOOT_RSA_2048_MODULUS_SIZE_BYTES; i++)
+    {
+        for (b = 0; b < 8; b++)
+        {
+            Sig[i] ^= 1 << b;
+            CHECK(VerifyBoth(NV_FALSE) != NvBootError_Success);
+            Sig[i] ^= 1 << b;
+        }
+    }
+
+    /* s must be below the modulus. */
+    memcpy(Saved, Sig, sizeof(Saved));
+    memcpy(Sig, s_Key.KeyData.RsaKey2048NvU8.Modulus,
+           NVBOOT_RSA_2048_MODULUS_SIZE_BYTES);
+    CHECK(VerifyBoth(NV_FALSE) == NvBootError_RSA_SSA_PSS_Signature_Out_Of_Range);
+    memcpy(Sig, Saved, sizeof(Saved));
+    CHECK(VerifyBoth(NV_FALSE) == NvBootError_Success);
+}
+
+/* MGF1 over the SHA device: DB = maskedDB ^ Hash(Seed || 0) || ... */
+static void Mgf1(const uint8_t *Seed, NvU32 MaskLen, const uint8_t *MaskedDB,
+                 uint8_t *DB)
+{
+    uint8_t In[NVBOOT_SHA256_LENGTH_BYTES + 4] __attribute__((aligned(4)));
+    uint8_t T[NVBOOT_SHA256_LENGTH_BYTES] __attribute__((aligned(4)));
+    NvU32 Counter, i;
+
+    memcpy(In, Seed, NVBOOT_SHA256_LENGTH_BYTES);
+    for (Counter = 0; Counter * sizeof(T) < MaskLen; Counter++)
+    {
+        In[32] = Counter >> 24;
+        In[33] = Counter >> 16;
+        In[34] = Counter >> 8;
+        In[35] = Counter;
+        s_Sha.ShaDevMgrCallbacks->ShaHash((uint32_t *)In, sizeof(In),
+                                          (uint32_t *)T, &s_Sha.ShaConfig);
+        for (i = 0; i < sizeof(T) && Counter * sizeof(T) + i < MaskLen; i++)
+            DB[Counter * sizeof(T) + i] = MaskedDB[Counter * sizeof(T) + i] ^ T[i];
+    }
+}
+
+#define MAX_MASK_LEN    (NVBOOT_RSA_2048_MODULUS_SIZE_BYTES - \
+                         NVBOOT_SHA256_LENGTH_BYTES - 1)
+
+static void CheckMgf(void)
+{
+    static uint8_t Seed[NVBOOT_SHA256_LENGTH_BYTES] __attribute__((aligned(4)));
+    static uint8_t MaskedDB[MAX_MASK_LEN + 1];
+    static uint8_t DB[MAX_MASK_LEN + 1], Want[MAX_MASK_LEN + 1];
+    NvU32 MaskLen, i;
+
+    srand(1);
+    for (MaskLen = 1; MaskLen <= MAX_MASK_LEN; MaskLen++)
+    {
+        for (i = 0; i < sizeof(Seed); i++)
+            Seed[i] = rand();
+        for (i = 0; i < sizeof(MaskedDB); i++)
+            MaskedDB[i] = rand();
+        memset(DB, 0xa5, sizeof(DB));
+        memset(Want, 0xa5, sizeof(Want));
+
+        Mgf1(Seed, MaskLen, MaskedDB, Want);
+        CHECK(NvBootCryptoRsaSsaPssMGF(Seed, MaskLen, MaskedDB, DB, &s_Sha) ==
+              NvBootError_Success);
+        /* The byte after the mask is left alone. */
+        CHECK(!memcmp(DB, Want, MaskLen + 1));
+    }
+}
+
+static int Check(void)
+{
+    CheckVector();
+    CheckMgf();
+
+    printf("rsassa_pss: %u checks, %u failures\n", s_Cases, s_Failures);
+    return s_Failures != 0;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+typedef enum
+{
+    Op_Verify,
+    Op_Unmask,
+} BenchOp;
+
+static uint8_t s_Seed[NVBOOT_SHA256_LENGTH_BYTES] __attribute__((aligned(4)));
+static uint8_t s_MaskedDB[NVBOOT_RSA_2048_MODULUS_SIZE_BYTES];
+static uint8_t s_DB[NVBOOT_RSA_2048_MODULUS_SIZE_BYTES];
+
+/* Verify steps 7 and 8 of a 2048-bit key, as each revision does them. */
+static void Unmask(NvBool Old)
+{
+#if HOST_HAVE_OLD
+    static uint8_t DbMask[NVBOOT_RSA_2048_MODULUS_SIZE_BYTES];
+    NvU32 i;
+
+    if (Old)
+    {
+        memset(DbMask, 0, sizeof(DbMask));
+        OldRsaSsaPssMGF(s_Seed, MAX_MASK_LEN, DbMask, &s_Sha);
+        for (i = 0; i < MAX_MASK_LEN; i++)
+            s_DB[i] = s_MaskedDB[i] ^ DbMask[i];
+        return;
+    }
+#endif
+    memset(s_DB, 0, sizeof(s_DB));
+    NvBootCryptoRsaSsaPssMGF(s_Seed, MAX_MASK_LEN, s_MaskedDB, s_DB, &s_Sha);
+}
+
+/*
+ * Best of 7 runs, in cycles per call. The builds take turns within each
+ * run so that both see the same clock speed.
+ */
+static void Cycles(BenchOp Op, int Reps, double *Cur, double *Old)
+{
+    uint64_t Best[2] = { ~0ull, ~0ull }, Start, Took;
+    int t, r, v;
+
+    for (t = 0; t < 7; t++)
+    {
+        for (v = 0; v < 1 + HOST_HAVE_OLD; v++)
+        {
+            Start = __rdtsc();
+            for (r = 0; r < Reps; r++)
+            {
+                if (Op == Op_Unmask)
+                    Unmask(v == 1);
+#if HOST_HAVE_OLD
+                else if (v == 1)
+                    Verify(&OldRsaSsaPssVerify, NV_TRUE);
+#endif
+                else
+                    Verify(&NvBootCryptoRsaSsaPssVerify, NV_TRUE);
+            }
+            Took = __rdtsc() - Start;
+            if (Took < Best[v])
+                Best[v] = Took;
+        }
+    }
+    *Cur = (double)Best[0] / Reps;
+    *Old = (double)Best[1] / Reps;
+}
+
+static void Print(const char *Name, double Cur, double Old)
+{
+    printf("  %-20s %10.0f", Name, Cur);
+    if (HOST_HAVE_OLD)
+        printf(" %10.0f", Old);
+    printf("\n");
+}
+
+static int Bench(void)
+{
+    double Cur, Old;
+
+    printf("cycles per call %17s%s\n", "current", HOST_HAVE_OLD ?
+           "    OLD_REV" : "");
+    Cycles(Op_Verify, 200, &Cur, &Old);
+    Print("verify, pre-hashed", Cur, Old);
+    Cycles(Op_Unmask, 20000, &Cur, &Old);
+    Print("MGF1 and unmask", Cur, Old);
+    return 0;
+}
+
+#else
+
+static int Bench(void)
+{
+    printf("rsassa_pss: the benchmark needs an x86 cycle counter\n");
+    return 0;
+}
+
+#endif
+
+int main(int argc, char **argv)
+{
+    /* NvBootInitializeNvBootError() reads the clock. */
+    HostClockInit();
+
+    if ((NvBootShaDevMgrInit(&s_Sha, NvBootShaDevice_SW) !=
+         NvBootError_Success) ||
+        (NvBootRsaDevMgrInit(&s_Rsa, NvBootRsaDevice_SW) !=
+         NvBootError_Success))
+    {
+        fprintf(stderr, "rsassa_pss: the software devices are not built\n");
+        return 1;
+    }
+
+    /* The Boot ROM always uses F4; the image leaves the exponent empty. */
+    s_Key = s_Header->Pcp.RsaPublicParams.RsaPublicKey;
+    s_Key.KeyData.RsaKey2048NvU32.Exponent[0] = EXPONENT;
+    if (s_Rsa.RsaDevMgrCallbacks->SetKey(&s_Key, RSA_SLOT) !=
+        NvBootError_Success)
+    {
+        fprintf(stderr, "rsassa_pss: the test vector key is refused\n");
+        return 1;
+    }
+
+    NvBootCryptoRsaSsaPssInit();
+#if HOST_HAVE_OLD
+    OldRsaSsaPssInit();
+#endif
+
+    if ((argc > 1) && !strcmp(argv[1], "bench"))
+        return Bench();
+    return Check();
+}
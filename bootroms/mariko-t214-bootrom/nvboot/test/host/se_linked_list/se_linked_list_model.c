@@ -0,0 +1,580 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Register model of SE1 under the SHA-256 paths of core/se/nvboot_se.c.
+ *
+ * nvboot_se.c is built unchanged. Its register accesses reach the model
+ * through a host_regs hook on the SE aperture. On START the model decodes
+ * SE_CONFIG, SE_SHA_CONFIG and the SHA length registers, walks the input
+ * linked list at SE_IN_LL_ADDR, and hashes what it read with the software
+ * SHA code once SE_SHA_MSG_LEFT says the message is complete. The digest
+ * goes to SE_HASH_RESULT or through the output linked list.
+ *
+ * The model checks the driver as it goes: no START on a busy engine, the
+ * SHA mode and algorithm, the message length bookkeeping across
+ * operations, and whole blocks in every operation but the last.
+ *
+ * Time is counted in SE clock cycles on one timeline: each register access
+ * costs REG_CYCLES, an operation START_CYCLES plus LL_ENTRY_CYCLES per
+ * linked list buffer and SHA_BLOCK_CYCLES per block, and a poll of a busy
+ * engine waits for it. These costs are assumptions, not measurements.
+ *
+ * "check" hashes contiguous messages in one operation, messages scattered
+ * over IRAM and SDRAM through NvBootSeGenerateScatterLinkedList(), and the
+ * same messages restarted every 64 KB chunk, and checks the builder's
+ * splitting and errors. "bench" prints operations, register accesses and
+ * cycles of each path from 64 KB to 4 MB.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "nvcommon.h"
+#include "nvrm_drf.h"
+#include "nvboot_error.h"
+#include "nvboot_se_int.h"
+#include "nvboot_se_defs.h"
+#include "nvboot_bit.h"
+#include "nvboot_context_int.h"
+#include "nvboot_crypto_mgr_int.h"
+#include "nvboot_sha_devmgr_int.h"
+#include "nvboot_hardware_access_int.h"
+#include "arse.h"
+#include "host_regs.h"
+
+/* Assumed SE costs, in SE clock cycles. */
+#define REG_CYCLES          20
+#define START_CYCLES        800
+#define LL_ENTRY_CYCLES     32
+#define SHA_BLOCK_CYCLES    64
+
+#define SHA_BLOCK           64
+#define SE_APERTURE         0x1000
+#define SE_REG(Reg)         (NV_ADDRESS_MAP_SE_BASE + (Reg))
+
+/* IRAM and the start of SDRAM, which the model maps at their addresses. */
+#define IRAM_START          NV_ADDRESS_MAP_IRAM_A_BASE
+#define IRAM_BYTES          (NV_ADDRESS_MAP_IRAM_D_LIMIT + 1 - IRAM_START)
+#define SDRAM_START         NVBOOT_BL_SDRAM_START
+#define SDRAM_BYTES         (40 * 1024 * 1024)
+
+/* The largest message the model gathers: all of SDRAM plus all of IRAM. */
+#define MAX_MESSAGE         (SDRAM_BYTES + IRAM_BYTES)
+
+#define CHUNK               NVBOOT_CRYPTO_BL_PIPELINE_CHUNK_BYTES
+#define MIN_BENCH           (64 * 1024)
+#define MAX_BENCH           (4 * 1024 * 1024)
+
+/* A BL header-sized piece left in IRAM, ahead of the body in SDRAM. */
+#define IRAM_PIECE          2048
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "se_linked_list: %s:%d: %s\n", __FILE__,    \
+                    __LINE__, #Cond);                                   \
+        }                                                               \
+    } while (0)
+
+NvBootInfoTable BootInfoTable;
+NvBootContext Context;
+int32_t FI_counter1;
+
+typedef struct
+{
+    /* Counters of the current run. */
+    NvU32 Ops;
+    NvU32 RegAccesses;
+    NvU32 Buffers;
+    NvU64 Cycles;
+    NvU32 Errors;
+
+    NvU64 BusyUntil;
+
+    /* The message the SHA has read so far, and its digest. */
+    NvU8 *Message;
+    NvU32 MessageBytes;
+    NvU32 Digest[NVBOOT_SHA256_LENGTH_WORDS];
+    NvBool HaveDigest;
+} ModelSe;
+
+static ModelSe s_Se;
+static NvBootShaDevMgr s_SwSha;
+
+static NvU8 *const s_Iram = (NvU8 *)IRAM_START;
+static NvU8 *const s_Sdram = (NvU8 *)SDRAM_START;
+
+/* Lists and digests the driver is handed; static, so below 4GB. */
+static SeLinkedList s_List;
+static NvU32 s_Digest[NVBOOT_SHA256_LENGTH_WORDS];
+static NvU32 s_Expected[NVBOOT_SHA256_LENGTH_WORDS];
+
+static void ModelError(const char *What)
+{
+    fprintf(stderr, "se_linked_list: model: %s\n", What);
+    s_Se.Errors++;
+}
+
+static NvU32 Reg(NvU32 Offset)
+{
+    return HostRegPeek(SE_REG(Offset));
+}
+
+/* Runs the operation the driver just started, and schedules its end. */
+static void ModelStart(void)
+{
+    NvU32 Config = Reg(SE_CONFIG_0);
+    NvU32 Dst = NV_DRF_VAL(SE, CONFIG, DST, Config);
+    NvU64 Length = ((NvU64)Reg(SE_SHA_MSG_LENGTH_1) << 32) |
+                   Reg(SE_SHA_MSG_LENGTH_0);
+    NvU64 Left = ((NvU64)Reg(SE_SHA_MSG_LEFT_1) << 32) |
+                 Reg(SE_SHA_MSG_LEFT_0);
+    const NvU32 *List = (const NvU32 *)(uintptr_t)Reg(SE_IN_LL_ADDR_0);
+    const NvU32 *Out;
+    NvU32 Last, i, Bytes = 0, Blocks;
+
+    if (s_Se.Cycles < s_Se.BusyUntil)
+        ModelError("START on a busy engine");
+    if ((NV_DRF_VAL(SE, CONFIG, ENC_ALG, Config) != SE_CONFIG_0_ENC_ALG_SHA) ||
+        (NV_DRF_VAL(SE, CONFIG, DEC_ALG, Config) != SE_CONFIG_0_DEC_ALG_NOP) ||
+        (NV_DRF_VAL(SE, CONFIG, ENC_MODE, Config) !=
+         SE_MODE_PKT_SHAMODE_SHA256))
+    {
+        ModelError("not a SHA-256 operation");
+        return;
+    }
+    if (Reg(SE_SHA_MSG_LENGTH_2) || Reg(SE_SHA_MSG_LENGTH_3) ||
+        Reg(SE_SHA_MSG_LEFT_2) || Reg(SE_SHA_MSG_LEFT_3))
+        ModelError("message length above 2^64 bits");
+
+    if (NV_DRF_VAL(SE, SHA_CONFIG, HW_INIT_HASH, Reg(SE_SHA_CONFIG_0)) ==
+        SE_SHA_CONFIG_0_HW_INIT_HASH_ENABLE)
+        s_Se.MessageBytes = 0;
+    if ((Length % 8) || (Left % 8) ||
+        ((NvU64)s_Se.MessageBytes * 8 + Left != Length) ||
+        (Length / 8 > MAX_MESSAGE))
+    {
+        ModelError("SHA_MSG_LENGTH and SHA_MSG_LEFT disagree");
+        return;
+    }
+
+    Last = List[0];
+    if (Last >= NVBOOT_SE_LL_MAX_NUM_BUFFERS)
+    {
+        ModelError("linked list too long");
+        return;
+    }
+    for (i = 0; i <= Last; i++)
+    {
+        NvU32 Address = List[1 + 2 * i];
+        NvU32 Size = List[2 + 2 * i];
+
+        if ((NvU64)Bytes + Size > Left / 8)
+        {
+            ModelError("linked list runs past SHA_MSG_LEFT");
+            return;
+        }
+        memcpy(&s_Se.Message[s_Se.MessageBytes + Bytes],
+               (const void *)(uintptr_t)Address, Size);
+        Bytes += Size;
+    }
+    s_Se.MessageBytes += Bytes;
+    s_Se.Buffers += Last + 1;
+
+    Blocks = (Bytes + SHA_BLOCK - 1) / SHA_BLOCK;
+    if (Bytes == Left / 8)
+    {
+        /* The padding block, then the digest. */
+        Blocks++;
+        s_SwSha.ShaDevMgrCallbacks->ShaHash((uint32_t *)s_Se.Message,
+                                            s_Se.MessageBytes, s_Se.Digest,
+                                            &s_SwSha.ShaConfig);
+        s_Se.HaveDigest = NV_TRUE;
+        if (Dst == SE_CONFIG_0_DST_HASH_REG)
+        {
+            for (i = 0; i < NVBOOT_SHA256_LENGTH_WORDS; i++)
+                HostRegPoke(SE_REG(SE_HASH_RESULT_0 + 4 * i), s_Se.Digest[i]);
+        }
+        else if (Dst == SE_CONFIG_0_DST_MEMORY)
+        {
+            Out = (const NvU32 *)(uintptr_t)Reg(SE_OUT_LL_ADDR_0);
+            if ((Out[0] != 0) ||
+                (Out[2] != NVBOOT_SHA256_LENGTH_BYTES))
+                ModelError("bad output linked list");
+            else
+                memcpy((void *)(uintptr_t)Out[1], s_Se.Digest,
+                       NVBOOT_SHA256_LENGTH_BYTES);
+        }
+        else
+        {
+            ModelError("bad SE_CONFIG.DST");
+        }
+    }
+    else if (Bytes % SHA_BLOCK)
+    {
+        ModelError("partial block before the end of the message");
+    }
+    else if (Dst != SE_CONFIG_0_DST_HASH_REG)
+    {
+        ModelError("intermediate result not kept in SE_HASH_RESULT");
+    }
+
+    s_Se.Ops++;
+    s_Se.BusyUntil = s_Se.Cycles + START_CYCLES +
+                     (Last + 1) * LL_ENTRY_CYCLES + Blocks * SHA_BLOCK_CYCLES;
+}
+
+static NvU32 ModelRead(NvU32 Addr)
+{
+    NvU32 Status;
+
+    s_Se.RegAccesses++;
+    s_Se.Cycles += REG_CYCLES;
+    if (Addr != SE_REG(SE_STATUS_0))
+        return HostRegPeek(Addr);
+
+    /* A poll of a busy engine spins until it is done. */
+    if (s_Se.Cycles < s_Se.BusyUntil)
+    {
+        s_Se.Cycles = s_Se.BusyUntil;
+        Status = NV_DRF_DEF(SE, STATUS, STATE, BUSY);
+    }
+    else
+    {
+        Status = NV_DRF_DEF(SE, STATUS, STATE, IDLE);
+    }
+    return Status;
+}
+
+static void ModelWrite(NvU32 Addr, NvU32 Data)
+{
+    s_Se.RegAccesses++;
+    s_Se.Cycles += REG_CYCLES;
+    HostRegPoke(Addr, Data);
+    if ((Addr == SE_REG(SE_OPERATION_0)) &&
+        (NV_DRF_VAL(SE, OPERATION, OP, Data) == SE_OPERATION_0_OP_START))
+        ModelStart();
+}
+
+static void ModelReset(void)
+{
+    NvU8 *Message = s_Se.Message;
+
+    memset(&s_Se, 0, sizeof(s_Se));
+    s_Se.Message = Message;
+}
+
+static void MapMemory(void *Address, size_t Bytes, const char *Name)
+{
+    void *p = mmap(Address, Bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if (p != Address)
+    {
+        fprintf(stderr, "se_linked_list: cannot map %s at %p\n", Name,
+                Address);
+        abort();
+    }
+}
+
+static void Fill(NvU8 *Buffer, NvU32 Bytes, NvU32 Seed)
+{
+    NvU32 i;
+
+    for (i = 0; i < Bytes; i++)
+    {
+        Seed ^= Seed << 13;
+        Seed ^= Seed >> 17;
+        Seed ^= Seed << 5;
+        Buffer[i] = Seed;
+    }
+}
+
+/* The digest of the segments, concatenated, with the software SHA. */
+static void Expect(const SeLinkedListElement *Segments, NvU32 NumSegments)
+{
+    static NvU8 *s_Joined;
+    NvU32 i, Bytes = 0;
+
+    if (!s_Joined)
+        s_Joined = malloc(MAX_MESSAGE);
+    for (i = 0; i < NumSegments; i++)
+    {
+        memcpy(s_Joined + Bytes,
+               (const void *)(uintptr_t)Segments[i].StartByteAddress,
+               Segments[i].BufferByteSize);
+        Bytes += Segments[i].BufferByteSize;
+    }
+    s_SwSha.ShaDevMgrCallbacks->ShaHash((uint32_t *)s_Joined, Bytes,
+                                        s_Expected, &s_SwSha.ShaConfig);
+}
+
+static NvBool HashRegMatches(void)
+{
+    NvU32 i;
+
+    for (i = 0; i < NVBOOT_SHA256_LENGTH_WORDS; i++)
+    {
+        if (Reg(SE_HASH_RESULT_0 + 4 * i) != s_Expected[i])
+            return NV_FALSE;
+    }
+    return NV_TRUE;
+}
+
+/* The message in one operation, on the list NvBootSeSHAHash() builds. */
+static NvBootError HashContiguous(const NvU8 *Message, NvU32 Bytes)
+{
+    ModelReset();
+    return NvBootSeSHAHash((NvU32 *)Message, Bytes, NULL, NULL,
+                           SE_MODE_PKT_SHAMODE_SHA256);
+}
+
+/* The segments in one operation, on a scatter list. */
+static NvBootError HashScattered(const SeLinkedListElement *Segments,
+                                 NvU32 NumSegments)
+{
+    NvU32 Bytes;
+    NvBootError e;
+
+    ModelReset();
+    e = NvBootSeGenerateScatterLinkedList(&s_List, Segments, NumSegments,
+                                          &Bytes);
+    if (e != NvBootError_Success)
+        return e;
+    return NvBootSeSHAHash((NvU32 *)(uintptr_t)Segments[0].StartByteAddress,
+                           Bytes, (NvU32 *)&s_List, NULL,
+                           SE_MODE_PKT_SHAMODE_SHA256);
+}
+
+/* The message restarted every CHUNK bytes, as the BL pipeline hashes it. */
+static void HashChunked(const NvU8 *Message, NvU32 Bytes)
+{
+    NvU32 Offset, ChunkBytes;
+
+    ModelReset();
+    memset(s_Digest, 0, sizeof(s_Digest));
+    for (Offset = 0; Offset < Bytes; Offset += ChunkBytes)
+    {
+        ChunkBytes = NV_MIN(Bytes - Offset, CHUNK);
+        NvBootSeInstanceSHA256HashChunkStart(NvBootSeInstance_Se1,
+                                             (NvU32 *)(Message + Offset),
+                                             ChunkBytes, Bytes,
+                                             Bytes - Offset, s_Digest);
+        while (NvBootSeInstanceIsEngineBusy(NvBootSeInstance_Se1, NULL))
+            ;
+    }
+}
+
+static void CheckContiguous(void)
+{
+    static const NvU32 Lengths[] =
+    {
+        1, 63, 64, 65, 4096, CHUNK - 1, CHUNK, CHUNK + 1, 100000,
+        1024 * 1024, MAX_BENCH,
+    };
+    SeLinkedListElement Segment;
+    NvU32 i;
+
+    for (i = 0; i < sizeof(Lengths) / sizeof(Lengths[0]); i++)
+    {
+        Fill(s_Sdram, Lengths[i], i + 1);
+        Segment.StartByteAddress = SDRAM_START;
+        Segment.BufferByteSize = Lengths[i];
+        Expect(&Segment, 1);
+
+        CHECK(HashContiguous(s_Sdram, Lengths[i]) == NvBootError_Success);
+        CHECK(s_Se.Errors == 0);
+        CHECK(s_Se.Ops == 1);
+        CHECK(s_Se.Buffers == 1);
+        CHECK(HashRegMatches());
+
+        HashChunked(s_Sdram, Lengths[i]);
+        CHECK(s_Se.Errors == 0);
+        CHECK(s_Se.Ops == NV_ICEIL(Lengths[i], CHUNK));
+        CHECK(!memcmp(s_Digest, s_Expected, sizeof(s_Expected)));
+    }
+}
+
+static void CheckScattered(void)
+{
+    SeLinkedListElement Segments[NVBOOT_SE_LL_MAX_NUM_BUFFERS + 1];
+    NvU32 i;
+
+    /* A header piece in IRAM, the body in SDRAM, a trailer in IRAM. */
+    Fill(s_Iram, IRAM_BYTES, 7);
+    Fill(s_Sdram, MAX_BENCH, 8);
+    Segments[0].StartByteAddress = IRAM_START + 0x1000;
+    Segments[0].BufferByteSize = IRAM_PIECE;
+    Segments[1].StartByteAddress = SDRAM_START;
+    Segments[1].BufferByteSize = MAX_BENCH;
+    Segments[2].StartByteAddress = IRAM_START + 0x20000;
+    Segments[2].BufferByteSize = 100;
+    Expect(Segments, 3);
+    CHECK(HashScattered(Segments, 3) == NvBootError_Success);
+    CHECK(s_Se.Errors == 0);
+    CHECK(s_Se.Ops == 1);
+    CHECK(s_Se.Buffers == 3);
+    CHECK(HashRegMatches());
+
+    /* Pieces that are not whole blocks are fine inside one operation. */
+    Segments[0].BufferByteSize = 13;
+    Segments[1].BufferByteSize = 65537;
+    Expect(Segments, 3);
+    CHECK(HashScattered(Segments, 3) == NvBootError_Success);
+    CHECK(s_Se.Errors == 0);
+    CHECK(s_Se.Ops == 1);
+    CHECK(HashRegMatches());
+
+    /* A segment over one buffer takes consecutive buffers. */
+    Fill(s_Sdram, SDRAM_BYTES, 9);
+    Segments[1].BufferByteSize = SDRAM_BYTES;
+    Expect(Segments, 3);
+    CHECK(HashScattered(Segments, 3) == NvBootError_Success);
+    CHECK(s_Se.Errors == 0);
+    CHECK(s_Se.Ops == 1);
+    CHECK(s_Se.Buffers == 2 + NV_ICEIL(SDRAM_BYTES,
+                                       NVBOOT_SE_LL_MAX_BUFFER_SIZE_BYTES));
+    CHECK(HashRegMatches());
+    CHECK(s_List.LastBufferNumber == s_Se.Buffers - 1);
+    for (i = 1; i < s_Se.Buffers - 1; i++)
+    {
+        CHECK(s_List.LLElement[i].StartByteAddress ==
+              SDRAM_START + (i - 1) * NVBOOT_SE_LL_MAX_BUFFER_SIZE_BYTES);
+        CHECK(s_List.LLElement[i].BufferByteSize ==
+              NV_MIN(SDRAM_BYTES - (i - 1) * NVBOOT_SE_LL_MAX_BUFFER_SIZE_BYTES,
+                     NVBOOT_SE_LL_MAX_BUFFER_SIZE_BYTES));
+    }
+
+    /* Up to the list size, one buffer per segment. */
+    for (i = 0; i < NVBOOT_SE_LL_MAX_NUM_BUFFERS + 1; i++)
+    {
+        Segments[i].StartByteAddress = SDRAM_START + i * 4096;
+        Segments[i].BufferByteSize = 1000 + i;
+    }
+    Expect(Segments, NVBOOT_SE_LL_MAX_NUM_BUFFERS);
+    CHECK(HashScattered(Segments, NVBOOT_SE_LL_MAX_NUM_BUFFERS) ==
+          NvBootError_Success);
+    CHECK(s_Se.Errors == 0);
+    CHECK(s_Se.Ops == 1);
+    CHECK(s_Se.Buffers == NVBOOT_SE_LL_MAX_NUM_BUFFERS);
+    CHECK(HashRegMatches());
+}
+
+/* Lists that cannot be built never reach the engine. */
+static void CheckErrors(void)
+{
+    SeLinkedListElement Segments[NVBOOT_SE_LL_MAX_NUM_BUFFERS + 1];
+    NvU32 i;
+
+    for (i = 0; i < NVBOOT_SE_LL_MAX_NUM_BUFFERS + 1; i++)
+    {
+        Segments[i].StartByteAddress = SDRAM_START + i * 4096;
+        Segments[i].BufferByteSize = 1000;
+    }
+    CHECK(HashScattered(Segments, NVBOOT_SE_LL_MAX_NUM_BUFFERS + 1) ==
+          NvBootError_IllegalParameter);
+    CHECK(s_Se.Ops == 0);
+
+    CHECK(HashScattered(Segments, 0) == NvBootError_IllegalParameter);
+    CHECK(s_Se.Ops == 0);
+
+    Segments[1].BufferByteSize = 0;
+    CHECK(HashScattered(Segments, 3) == NvBootError_IllegalParameter);
+    CHECK(s_Se.Ops == 0);
+
+    /* Too many buffers through one oversized segment. */
+    Segments[0].StartByteAddress = SDRAM_START;
+    Segments[0].BufferByteSize = NVBOOT_SE_LL_MAX_SIZE_BYTES + 1;
+    CHECK(HashScattered(Segments, 1) == NvBootError_IllegalParameter);
+    CHECK(s_Se.Ops == 0);
+}
+
+static int Check(void)
+{
+    CheckContiguous();
+    CheckScattered();
+    CheckErrors();
+
+    printf("se_linked_list: %u checks, %u failures\n", s_Cases, s_Failures);
+    return s_Failures != 0;
+}
+
+static void PrintRun(const char *Path)
+{
+    printf("  %-22s %6u %8u %10llu\n", Path, s_Se.Ops, s_Se.RegAccesses,
+           (unsigned long long)s_Se.Cycles);
+}
+
+static int Bench(void)
+{
+    SeLinkedListElement Segments[2];
+    NvU64 One, Chunked;
+    NvU32 Bytes;
+
+    printf("SE cycles: %u per register access, %u per start, %u per list "
+           "buffer, %u per SHA block\n", REG_CYCLES, START_CYCLES,
+           LL_ENTRY_CYCLES, SHA_BLOCK_CYCLES);
+    Fill(s_Iram, IRAM_PIECE, 1);
+    Fill(s_Sdram, MAX_BENCH, 2);
+    for (Bytes = MIN_BENCH; Bytes <= MAX_BENCH; Bytes *= 4)
+    {
+        printf("%u bytes\n", Bytes);
+        printf("  %-22s %6s %8s %10s\n", "path", "ops", "accesses", "cycles");
+
+        HashContiguous(s_Sdram, Bytes);
+        One = s_Se.Cycles;
+        PrintRun("one list");
+
+        HashChunked(s_Sdram, Bytes);
+        Chunked = s_Se.Cycles;
+        PrintRun("64 KB chunks");
+
+        /* The same bytes, with the first IRAM_PIECE of them in IRAM. */
+        Segments[0].StartByteAddress = IRAM_START;
+        Segments[0].BufferByteSize = IRAM_PIECE;
+        Segments[1].StartByteAddress = SDRAM_START + IRAM_PIECE;
+        Segments[1].BufferByteSize = Bytes - IRAM_PIECE;
+        HashScattered(Segments, 2);
+        PrintRun("IRAM + SDRAM list");
+
+        printf("  %-22s %6s %8s %10.3f\n", "chunks / one list", "", "",
+               (double)Chunked / One);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    MapMemory(s_Iram, IRAM_BYTES, "IRAM");
+    MapMemory(s_Sdram, SDRAM_BYTES, "SDRAM");
+    s_Se.Message = malloc(MAX_MESSAGE);
+    if (!s_Se.Message)
+        return 1;
+    HostRegHook(NV_ADDRESS_MAP_SE_BASE, SE_APERTURE, ModelRead, ModelWrite);
+
+    if (NvBootShaDevMgrInit(&s_SwSha, NvBootShaDevice_SW) != NvBootError_Success)
+    {
+        fprintf(stderr, "se_linked_list: the software SHA device is not built\n");
+        return 1;
+    }
+
+    if ((argc > 1) && !strcmp(argv[1], "bench"))
+        return Bench();
+    return Check();
+}
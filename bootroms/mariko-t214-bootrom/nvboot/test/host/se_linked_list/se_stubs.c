@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * se_stubs.c - The functions nvboot_se.c calls outside its SHA paths:
+ * clocks, resets, fuses, the PKA, the RNG and the AHB coherency wait. The
+ * model does not run those parts, so reaching any of these aborts.
+ *
+ * The symbols are defined without their headers, so that one macro fits
+ * all of them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MODEL_STUB(Name)                                        \
+    void Name(void)                                             \
+    {                                                           \
+        fprintf(stderr, "se_linked_list: %s called\n", #Name);  \
+        abort();                                                \
+    }
+
+MODEL_STUB(NvBootAhbCheckIsExtMemAddr)
+MODEL_STUB(NvBootAhbWaitCoherency)
+MODEL_STUB(NvBootClocksConfigureClock)
+MODEL_STUB(NvBootClocksSetEnable)
+MODEL_STUB(NvBootFuseIsSeContextAtomicSaveEnabled)
+MODEL_STUB(NvBootGetSwCYA)
+MODEL_STUB(NvBootKcvComputeKcvSE)
+MODEL_STUB(NvBootPkaClearAllKeySlots)
+MODEL_STUB(NvBootPkaDisablePka)
+MODEL_STUB(NvBootPkaGetPka0Reg)
+MODEL_STUB(NvBootPkaReadKeySlot)
+MODEL_STUB(NvBootPkaSetPka0Reg)
+MODEL_STUB(NvBootPkaWriteKeySlot)
+MODEL_STUB(NvBootResetSetEnable)
+MODEL_STUB(NvBootRngWaitRandomLoop)
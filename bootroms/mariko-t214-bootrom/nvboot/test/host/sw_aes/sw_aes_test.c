@@ -0,0 +1,556 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of the software AES in core/sw_aes/nvboot_sw_aes.c.
+ *
+ * The file is built once per implementation it can select, and the entry
+ * points of each build are renamed (NvAesEncrypt to ByteAesEncrypt,
+ * TTableAesEncrypt, ...) so that all of them link into this test:
+ *
+ *   Byte     the default byte-oriented implementation
+ *   TTable   NVBOOT_SW_AES_TTABLE=1
+ *   Ct       NVBOOT_SW_AES_CT=1, bitsliced and constant-time
+ *
+ * "check" runs the FIPS-197 known answers, the vectors of
+ * nvboot_aes_test_vectors.h and the RFC 4493 AES-CMAC examples on every
+ * implementation, streamed in every chunk size, then compares each
+ * against the byte-oriented one on random keys and data. "bench" prints
+ * the cycles per byte of each, the cost of a CMAC over a whole object
+ * against one streamed as it is read, and runs a dudect timing-leak test of
+ * single-block encryption and decryption: a fixed input against random
+ * inputs under one key. |t| above 4.5 means the run time depends on the
+ * data.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "nvboot_sw_aes_int.h"
+#include "nvboot_aes_test_vectors.h"
+#include "host_dudect.h"
+
+#define AES_API(Prefix)                                                     \
+    void Prefix##AesExpandKey(uint8_t *, uint8_t *, NvBootAesKeySize);      \
+    void Prefix##AesEncrypt(uint8_t *, uint8_t *, uint8_t *,                \
+                            NvBootAesKeySize);                              \
+    void Prefix##AesDecrypt(uint8_t *, uint8_t *, uint8_t *,                \
+                            NvBootAesKeySize);                              \
+    void Prefix##AesEncryptObject(uint8_t *, uint8_t *, uint8_t *, NvU32,   \
+                                  NvBootAesKeySize);                        \
+    void Prefix##AesDecryptObject(uint8_t *, uint8_t *, uint8_t *,          \
+                                  uint8_t *, NvU32, NvBootAesKeySize);      \
+    void Prefix##AesCmacSignObject(uint8_t *, uint8_t *, uint8_t *,         \
+                                   uint8_t *, NvU32, NvBootAesKeySize);     \
+    void Prefix##AesCmacGenerateSubkeys(uint8_t *, NvBootAesCmacHashParams *,\
+                                        NvBootAesKeySize);                  \
+    void Prefix##AesCmacInit(NvBootAesCmacContext *, uint8_t *,             \
+                             const NvBootAesCmacHashParams *,               \
+                             NvBootAesKeySize);                             \
+    void Prefix##AesCmacUpdate(NvBootAesCmacContext *, const uint8_t *,     \
+                               NvU32);                                      \
+    void Prefix##AesCmacFinal(NvBootAesCmacContext *, uint8_t *);
+
+#define AES_IMPL(Prefix)                                                    \
+    { #Prefix, Prefix##AesExpandKey, Prefix##AesEncrypt,                    \
+      Prefix##AesDecrypt, Prefix##AesEncryptObject,                         \
+      Prefix##AesDecryptObject, Prefix##AesCmacSignObject,                  \
+      Prefix##AesCmacGenerateSubkeys, Prefix##AesCmacInit,                  \
+      Prefix##AesCmacUpdate, Prefix##AesCmacFinal }
+
+AES_API(Byte)
+AES_API(TTable)
+AES_API(Ct)
+
+typedef struct
+{
+    const char *Name;
+    void (*ExpandKey)(uint8_t *, uint8_t *, NvBootAesKeySize);
+    void (*Encrypt)(uint8_t *, uint8_t *, uint8_t *, NvBootAesKeySize);
+    void (*Decrypt)(uint8_t *, uint8_t *, uint8_t *, NvBootAesKeySize);
+    void (*EncryptObject)(uint8_t *, uint8_t *, uint8_t *, NvU32,
+                          NvBootAesKeySize);
+    void (*DecryptObject)(uint8_t *, uint8_t *, uint8_t *, uint8_t *, NvU32,
+                          NvBootAesKeySize);
+    void (*SignObject)(uint8_t *, uint8_t *, uint8_t *, uint8_t *, NvU32,
+                       NvBootAesKeySize);
+    void (*CmacSubkeys)(uint8_t *, NvBootAesCmacHashParams *,
+                        NvBootAesKeySize);
+    void (*CmacInit)(NvBootAesCmacContext *, uint8_t *,
+                     const NvBootAesCmacHashParams *, NvBootAesKeySize);
+    void (*CmacUpdate)(NvBootAesCmacContext *, const uint8_t *, NvU32);
+    void (*CmacFinal)(NvBootAesCmacContext *, uint8_t *);
+} AesImpl;
+
+/* The first entry is the reference for the random comparisons. */
+static const AesImpl s_Impls[] =
+{
+    AES_IMPL(Byte),
+    AES_IMPL(TTable),
+    AES_IMPL(Ct),
+};
+
+#define NUM_IMPLS   (int)(sizeof(s_Impls) / sizeof(s_Impls[0]))
+#define BLOCK       NVBOOT_AES_BLOCK_LENGTH_BYTES
+#define MAX_BLOCKS  256
+
+static const NvBootAesKeySize s_KeySizes[] = { AesKey128, AesKey192, AesKey256 };
+static const char *const s_KeyNames[] = { "128", "192", "256" };
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+static void Expect(const AesImpl *Impl, const char *What, const uint8_t *Got,
+                   const uint8_t *Want, size_t Len)
+{
+    s_Cases++;
+    if (memcmp(Got, Want, Len))
+    {
+        s_Failures++;
+        fprintf(stderr, "sw_aes: %s: %s mismatch\n", Impl->Name, What);
+    }
+}
+
+/* FIPS-197 appendix B and C.1 to C.3. */
+static void CheckFips197(const AesImpl *Impl)
+{
+    static const uint8_t KeyB[16] =
+    {
+        0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+        0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+    };
+    static const uint8_t PlainB[16] =
+    {
+        0x32, 0x43, 0xf6, 0xa8, 0x88, 0x5a, 0x30, 0x8d,
+        0x31, 0x31, 0x98, 0xa2, 0xe0, 0x37, 0x07, 0x34,
+    };
+    static const uint8_t CipherB[16] =
+    {
+        0x39, 0x25, 0x84, 0x1d, 0x02, 0xdc, 0x09, 0xfb,
+        0xdc, 0x11, 0x85, 0x97, 0x19, 0x6a, 0x0b, 0x32,
+    };
+    static const uint8_t CipherC[3][16] =
+    {
+        { 0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+          0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a },
+        { 0xdd, 0xa9, 0x7c, 0xa4, 0x86, 0x4c, 0xdf, 0xe0,
+          0x6e, 0xaf, 0x70, 0xa0, 0xec, 0x0d, 0x71, 0x91 },
+        { 0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+          0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89 },
+    };
+    uint8_t Ks[NVBOOT_AES_MAX_KEYSCHED_BYTES] __attribute__((aligned(16)));
+    uint8_t Key[32], Plain[16], Out[16], Back[16];
+    int i, k;
+
+    memcpy(Key, KeyB, sizeof(KeyB));
+    memcpy(Plain, PlainB, sizeof(PlainB));
+    Impl->ExpandKey(Key, Ks, AesKey128);
+    Impl->Encrypt(Plain, Ks, Out, AesKey128);
+    Expect(Impl, "FIPS-197 B encrypt", Out, CipherB, 16);
+    Impl->Decrypt(Out, Ks, Back, AesKey128);
+    Expect(Impl, "FIPS-197 B decrypt", Back, PlainB, 16);
+
+    for (i = 0; i < 32; i++)
+        Key[i] = i;
+    for (i = 0; i < 16; i++)
+        Plain[i] = i * 0x11;
+    for (k = 0; k < 3; k++)
+    {
+        Impl->ExpandKey(Key, Ks, s_KeySizes[k]);
+        Impl->Encrypt(Plain, Ks, Out, s_KeySizes[k]);
+        Expect(Impl, "FIPS-197 C encrypt", Out, CipherC[k], 16);
+        Impl->Decrypt(Out, Ks, Back, s_KeySizes[k]);
+        Expect(Impl, "FIPS-197 C decrypt", Back, Plain, 16);
+    }
+}
+
+/* CBC with a zero IV, as NvAesEncryptObject() chains. */
+static void CheckBootVectors(const AesImpl *Impl)
+{
+    uint8_t Ks[NVBOOT_AES_MAX_KEYSCHED_BYTES] __attribute__((aligned(16)));
+    uint8_t Iv[16] = { 0 };
+    uint8_t Out[32], Back[32];
+
+    Impl->ExpandKey(aes_key_128, Ks, AesKey128);
+    Impl->EncryptObject(Ks, aes_plaintext_key128, Out, 2, AesKey128);
+    Expect(Impl, "aes_ciphertext_key128", Out, aes_ciphertext_key128, 32);
+    Impl->DecryptObject(Ks, Iv, Out, Back, 2, AesKey128);
+    Expect(Impl, "aes_plaintext_key128", Back, aes_plaintext_key128, 32);
+
+    Impl->ExpandKey(aes_key_256, Ks, AesKey256);
+    Impl->EncryptObject(Ks, aes_plaintext_key256, Out, 2, AesKey256);
+    Expect(Impl, "aes_ciphertext_key256", Out, aes_ciphertext_key256, 32);
+    Impl->DecryptObject(Ks, Iv, Out, Back, 2, AesKey256);
+    Expect(Impl, "aes_plaintext_key256", Back, aes_plaintext_key256, 32);
+}
+
+/* MAC of Len bytes of Src, streamed in Chunk-byte updates. */
+static void Cmac(const AesImpl *Impl, uint8_t *Ks,
+                 const NvBootAesCmacHashParams *Subkeys, const uint8_t *Src,
+                 NvU32 Len, NvU32 Chunk, NvBootAesKeySize KeySize,
+                 uint8_t *Mac)
+{
+    NvBootAesCmacContext Context;
+    NvU32 Done, Bytes;
+
+    Impl->CmacInit(&Context, Ks, Subkeys, KeySize);
+    for (Done = 0; Done < Len; Done += Bytes)
+    {
+        Bytes = (Len - Done < Chunk) ? Len - Done : Chunk;
+        Impl->CmacUpdate(&Context, Src + Done, Bytes);
+    }
+    Impl->CmacFinal(&Context, Mac);
+}
+
+/* RFC 4493 section 4: the subkeys and examples 1 to 4. */
+static void CheckRfc4493(const AesImpl *Impl)
+{
+    static const uint8_t Mac3[16] =
+    {
+        0xdf, 0xa6, 0x67, 0x47, 0xde, 0x9a, 0xe6, 0x30,
+        0x30, 0xca, 0x32, 0x61, 0x14, 0x97, 0xc8, 0x27,
+    };
+    static const struct
+    {
+        NvU32 Len;
+        const uint8_t *Mac;
+    } Examples[] =
+    {
+        { 0,  NIST_AES_CMAC_Empty_String_MAC_Key128 },
+        { 16, NIST_AES_CMAC_Message2_MAC_Key128 },
+        { 40, Mac3 },
+        { 64, NIST_AES_CMAC_Message4_Signature_Key128 },
+    };
+    uint8_t Ks[NVBOOT_AES_MAX_KEYSCHED_BYTES] __attribute__((aligned(16)));
+    NvBootAesCmacHashParams Subkeys;
+    uint8_t Mac[16];
+    NvU32 Chunk;
+    unsigned e;
+
+    Impl->ExpandKey(NIST_Key_128, Ks, AesKey128);
+    Impl->CmacSubkeys(Ks, &Subkeys, AesKey128);
+    Expect(Impl, "RFC 4493 K1", (uint8_t *)Subkeys.K1, NIST_AES_CMAC_K1, 16);
+    Expect(Impl, "RFC 4493 K2", (uint8_t *)Subkeys.K2, NIST_AES_CMAC_K2, 16);
+
+    /* Example 3 is a prefix of example 4. */
+    for (e = 0; e < sizeof(Examples) / sizeof(Examples[0]); e++)
+    {
+        for (Chunk = 1; Chunk <= 65; Chunk++)
+        {
+            Cmac(Impl, Ks, (Chunk & 1) ? &Subkeys : NULL,
+                 NIST_AES_CMAC_Message4_Key128, Examples[e].Len, Chunk,
+                 AesKey128, Mac);
+            Expect(Impl, "RFC 4493 streamed", Mac, Examples[e].Mac, 16);
+        }
+    }
+
+    Impl->SignObject(NIST_Key_128, Ks, NIST_AES_CMAC_Message2_Key128, Mac, 1,
+                     AesKey128);
+    Expect(Impl, "RFC 4493 example 2", Mac, NIST_AES_CMAC_Message2_MAC_Key128,
+           16);
+    Impl->SignObject(NIST_Key_128, Ks, NIST_AES_CMAC_Message4_Key128, Mac, 4,
+                     AesKey128);
+    Expect(Impl, "RFC 4493 example 4", Mac,
+           NIST_AES_CMAC_Message4_Signature_Key128, 16);
+}
+
+static void Random(uint8_t *Buf, size_t Len)
+{
+    while (Len--)
+        *Buf++ = rand();
+}
+
+/* Every entry point against the byte-oriented build on random input. */
+static void CheckRandom(const AesImpl *Impl)
+{
+    static uint8_t Src[MAX_BLOCKS * BLOCK], Want[MAX_BLOCKS * BLOCK],
+                   Got[MAX_BLOCKS * BLOCK];
+    const AesImpl *Ref = &s_Impls[0];
+    uint8_t RefKs[NVBOOT_AES_MAX_KEYSCHED_BYTES] __attribute__((aligned(16)));
+    uint8_t Ks[NVBOOT_AES_MAX_KEYSCHED_BYTES] __attribute__((aligned(16)));
+    uint8_t Key[32], Iv[16];
+    NvBootAesKeySize KeySize;
+    NvU32 Blocks, Len;
+    int Round;
+
+    srand(1);
+    for (Round = 0; Round < 300; Round++)
+    {
+        KeySize = s_KeySizes[Round % 3];
+        Blocks = 1 + rand() % 9;
+        Random(Key, sizeof(Key));
+        Random(Iv, sizeof(Iv));
+        Random(Src, Blocks * BLOCK);
+        Ref->ExpandKey(Key, RefKs, KeySize);
+        Impl->ExpandKey(Key, Ks, KeySize);
+
+        Ref->Encrypt(Src, RefKs, Want, KeySize);
+        Impl->Encrypt(Src, Ks, Got, KeySize);
+        Expect(Impl, "random encrypt", Got, Want, BLOCK);
+
+        Ref->Decrypt(Src, RefKs, Want, KeySize);
+        Impl->Decrypt(Src, Ks, Got, KeySize);
+        Expect(Impl, "random decrypt", Got, Want, BLOCK);
+
+        Ref->EncryptObject(RefKs, Src, Want, Blocks, KeySize);
+        Impl->EncryptObject(Ks, Src, Got, Blocks, KeySize);
+        Expect(Impl, "random CBC encrypt", Got, Want, Blocks * BLOCK);
+
+        /* Decrypt in place as the boot flow does. */
+        Ref->DecryptObject(RefKs, Iv, Src, Want, Blocks, KeySize);
+        memcpy(Got, Src, Blocks * BLOCK);
+        Impl->DecryptObject(Ks, Iv, Got, Got, Blocks, KeySize);
+        Expect(Impl, "random CBC decrypt", Got, Want, Blocks * BLOCK);
+
+        Ref->SignObject(Key, RefKs, Src, Want, Blocks, KeySize);
+        Impl->SignObject(Key, Ks, Src, Got, Blocks, KeySize);
+        Expect(Impl, "random CMAC", Got, Want, BLOCK);
+
+        /* A streamed MAC of whole blocks equals the one-shot one. */
+        Cmac(Impl, Ks, NULL, Src, Blocks * BLOCK, 1 + rand() % 40, KeySize,
+             Got);
+        Expect(Impl, "random streamed CMAC", Got, Want, BLOCK);
+
+        Len = rand() % (Blocks * BLOCK + 1);
+        Cmac(Ref, RefKs, NULL, Src, Len, Len + 1, KeySize, Want);
+        Cmac(Impl, Ks, NULL, Src, Len, 1 + rand() % 40, KeySize, Got);
+        Expect(Impl, "random padded CMAC", Got, Want, BLOCK);
+    }
+}
+
+static int Check(void)
+{
+    int i;
+
+    for (i = 0; i < NUM_IMPLS; i++)
+    {
+        CheckFips197(&s_Impls[i]);
+        CheckBootVectors(&s_Impls[i]);
+        CheckRfc4493(&s_Impls[i]);
+        if (i > 0)
+            CheckRandom(&s_Impls[i]);
+    }
+
+    printf("sw_aes: %u checks, %u failures\n", s_Cases, s_Failures);
+    return s_Failures != 0;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+typedef enum
+{
+    Op_ExpandKey,
+    Op_Encrypt,
+    Op_Decrypt,
+    Op_CbcEncrypt,
+    Op_CbcDecrypt,
+} AesOp;
+
+static uint8_t s_Buf[MAX_BLOCKS * BLOCK] __attribute__((aligned(64)));
+
+/* Best of 7 runs; cycles per byte, or per call for the key expansion. */
+static double Cycles(const AesImpl *Impl, AesOp Op, NvBootAesKeySize KeySize)
+{
+    uint8_t Ks[NVBOOT_AES_MAX_KEYSCHED_BYTES] __attribute__((aligned(16)));
+    uint8_t Key[32] = { 0 }, Iv[16] = { 0 };
+    uint64_t Best = ~0ull, Start, Took;
+    int Reps, t, r;
+    NvU32 Bytes;
+
+    Impl->ExpandKey(Key, Ks, KeySize);
+    Bytes = (Op == Op_CbcEncrypt || Op == Op_CbcDecrypt) ? sizeof(s_Buf) :
+            (Op == Op_ExpandKey) ? 1 : BLOCK;
+    Reps = (Bytes > BLOCK) ? 20 : 2000;
+
+    for (t = 0; t < 7; t++)
+    {
+        Start = __rdtsc();
+        for (r = 0; r < Reps; r++)
+        {
+            switch (Op)
+            {
+                case Op_ExpandKey:
+                    Impl->ExpandKey(Key, Ks, KeySize);
+                    break;
+                case Op_Encrypt:
+                    Impl->Encrypt(s_Buf, Ks, s_Buf, KeySize);
+                    break;
+                case Op_Decrypt:
+                    Impl->Decrypt(s_Buf, Ks, s_Buf, KeySize);
+                    break;
+                case Op_CbcEncrypt:
+                    Impl->EncryptObject(Ks, s_Buf, s_Buf, MAX_BLOCKS, KeySize);
+                    break;
+                case Op_CbcDecrypt:
+                    Impl->DecryptObject(Ks, Iv, s_Buf, s_Buf, MAX_BLOCKS,
+                                        KeySize);
+                    break;
+            }
+            __asm__ volatile("" ::: "memory");
+        }
+        Took = __rdtsc() - Start;
+        if (Took < Best)
+            Best = Took;
+    }
+    return (double)Best / Reps / Bytes;
+}
+
+/*
+ * MAC of an object read from the boot device in pages: into a buffer and
+ * then in one NvAesCmacSignObject() call, which derives K1 again, or
+ * streamed page by page as it is read, with the subkeys derived once per
+ * key. The reads are memcpy()s from a source image.
+ */
+#define OBJECT_BYTES    (64 * 1024)
+#define PAGE_BYTES      512
+
+static uint8_t s_Image[OBJECT_BYTES];
+static uint8_t s_Object[OBJECT_BYTES] __attribute__((aligned(64)));
+
+static double CmacCycles(const AesImpl *Impl, NvBool Streamed)
+{
+    uint8_t Ks[NVBOOT_AES_MAX_KEYSCHED_BYTES] __attribute__((aligned(16)));
+    uint8_t Key[16] = { 0 }, Mac[BLOCK];
+    NvBootAesCmacHashParams Subkeys;
+    NvBootAesCmacContext Context;
+    uint64_t Best = ~0ull, Start, Took;
+    NvU32 Page;
+    int t;
+
+    Impl->ExpandKey(Key, Ks, AesKey128);
+    Impl->CmacSubkeys(Ks, &Subkeys, AesKey128);
+
+    for (t = 0; t < 7; t++)
+    {
+        Start = __rdtsc();
+        if (Streamed)
+        {
+            Impl->CmacInit(&Context, Ks, &Subkeys, AesKey128);
+            for (Page = 0; Page < OBJECT_BYTES; Page += PAGE_BYTES)
+            {
+                memcpy(s_Object, &s_Image[Page], PAGE_BYTES);
+                Impl->CmacUpdate(&Context, s_Object, PAGE_BYTES);
+            }
+            Impl->CmacFinal(&Context, Mac);
+        }
+        else
+        {
+            for (Page = 0; Page < OBJECT_BYTES; Page += PAGE_BYTES)
+                memcpy(&s_Object[Page], &s_Image[Page], PAGE_BYTES);
+            Impl->SignObject(Key, Ks, s_Object, Mac, OBJECT_BYTES / BLOCK,
+                             AesKey128);
+        }
+        __asm__ volatile("" ::: "memory");
+        Took = __rdtsc() - Start;
+        if (Took < Best)
+            Best = Took;
+    }
+    return (double)Best / OBJECT_BYTES;
+}
+
+#define NUM_MEAS 300000
+static uint64_t s_Time[NUM_MEAS];
+static uint8_t s_Class[NUM_MEAS];
+static uint8_t s_In[NUM_MEAS][BLOCK];
+
+static double Dudect(const AesImpl *Impl, NvBool Decrypt)
+{
+    uint8_t Ks[NVBOOT_AES_MAX_KEYSCHED_BYTES] __attribute__((aligned(16)));
+    uint8_t Key[16], Out[BLOCK];
+    uint64_t Start;
+    unsigned Aux;
+    size_t i;
+
+    Random(Key, sizeof(Key));
+    Impl->ExpandKey(Key, Ks, AesKey128);
+    for (i = 0; i < NUM_MEAS; i++)
+    {
+        s_Class[i] = rand() & 1;
+        if (s_Class[i])
+            Random(s_In[i], BLOCK);
+        else
+            memset(s_In[i], 0, BLOCK);
+    }
+    for (i = 0; i < NUM_MEAS; i++)
+    {
+        Start = __rdtscp(&Aux);
+        if (Decrypt)
+            Impl->Decrypt(s_In[i], Ks, Out, AesKey128);
+        else
+            Impl->Encrypt(s_In[i], Ks, Out, AesKey128);
+        s_Time[i] = __rdtscp(&Aux) - Start;
+    }
+    return HostDudect(s_Time, s_Class, NUM_MEAS);
+}
+
+static int Bench(void)
+{
+    int i, k;
+
+    printf("cycles per byte, one block and %d-byte CBC; key expansion in "
+           "cycles per call\n", MAX_BLOCKS * BLOCK);
+    printf("%-8s %4s %10s %10s %10s %10s %10s\n", "impl", "key", "expand",
+           "encrypt", "decrypt", "cbc enc", "cbc dec");
+    for (i = 0; i < NUM_IMPLS; i++)
+    {
+        for (k = 0; k < 3; k++)
+        {
+            printf("%-8s %4s %10.0f %10.1f %10.1f %10.1f %10.1f\n",
+                   s_Impls[i].Name, s_KeyNames[k],
+                   Cycles(&s_Impls[i], Op_ExpandKey, s_KeySizes[k]),
+                   Cycles(&s_Impls[i], Op_Encrypt, s_KeySizes[k]),
+                   Cycles(&s_Impls[i], Op_Decrypt, s_KeySizes[k]),
+                   Cycles(&s_Impls[i], Op_CbcEncrypt, s_KeySizes[k]),
+                   Cycles(&s_Impls[i], Op_CbcDecrypt, s_KeySizes[k]));
+        }
+    }
+
+    printf("CMAC of a %d KB object read in %d-byte pages, cycles per byte\n",
+           OBJECT_BYTES / 1024, PAGE_BYTES);
+    printf("%-8s %12s %12s\n", "impl", "read + sign", "streamed");
+    Random(s_Image, sizeof(s_Image));
+    for (i = 0; i < NUM_IMPLS; i++)
+    {
+        printf("%-8s %12.1f %12.1f\n", s_Impls[i].Name,
+               CmacCycles(&s_Impls[i], NV_FALSE),
+               CmacCycles(&s_Impls[i], NV_TRUE));
+    }
+
+    printf("dudect max |t| over crops, %d samples, 128-bit key "
+           "(> 4.5 is a leak)\n", NUM_MEAS);
+    srand(1);
+    for (i = 0; i < NUM_IMPLS; i++)
+    {
+        printf("  %-8s encrypt: %8.2f   decrypt: %8.2f\n", s_Impls[i].Name,
+               Dudect(&s_Impls[i], NV_FALSE), Dudect(&s_Impls[i], NV_TRUE));
+    }
+    return 0;
+}
+
+#else
+
+static int Bench(void)
+{
+    printf("sw_aes: the benchmark needs an x86 cycle counter\n");
+    return 0;
+}
+
+#endif
+
+int main(int argc, char **argv)
+{
+    if ((argc > 1) && !strcmp(argv[1], "bench"))
+        return Bench();
+    return Check();
+}
@@ -0,0 +1,513 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of the software RSA device, core/sw_rsa/nvboot_sw_rsa_dev.c,
+ * reached through the RSA device manager as NvBootRsaDevice_SW.
+ *
+ * "check" raises a base to the power e twenty times over, each result
+ * being the next base, for 2048- and 3072-bit moduli and for e = 0x10001
+ * (the dedicated path), e = 3 and a random full-length e. The last result
+ * is compared with one computed once with another bignum library. The
+ * moduli, bases and exponents come from a xorshift generator, so only the
+ * results are kept here. It also checks exponents 0 and 1, bases 0, 1 and
+ * n - 1, and the key and slot checks. "bench" prints modular
+ * exponentiations, i.e. signature verifies, per second, and the time per
+ * image of SetKey and one verify with the key left resident in the slot
+ * and with the key changing on every call.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "nvboot_rsa_devmgr_int.h"
+
+#define RSA_SLOT    0
+#define ITERATIONS  20
+#define F4          0x10001
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "sw_rsa: %s:%d: %s\n", __FILE__,            \
+                    __LINE__, #Cond);                                   \
+        }                                                               \
+    } while (0)
+
+#define MAX_WORDS   NVBOOT_RSA_3072_MODULUS_SIZE_WORDS
+
+/*
+ * NvBootCryptoRsaKey only has room for 2048 bits. The device reads the
+ * key data as NvBootCryptoRsaKey3072NvU32, so give it the room.
+ */
+typedef struct
+{
+    NvBootCryptoRsaKeySize KeySize;
+    NvU32 Reserved_Padding[3];
+    NvBootCryptoRsaKey3072NvU32 KeyData;
+} Key3072;
+
+static NvBootRsaDevMgr s_Rsa;
+static Key3072 s_Key;
+static NvU32 s_Base[MAX_WORDS];
+static NvU32 s_Result[MAX_WORDS];
+
+static NvU32 s_Xorshift;
+
+static NvU32 Next(void)
+{
+    s_Xorshift ^= s_Xorshift << 13;
+    s_Xorshift ^= s_Xorshift >> 17;
+    s_Xorshift ^= s_Xorshift << 5;
+    return s_Xorshift;
+}
+
+/* Modulus, base and exponent of a size, in that order from the seed. */
+static void Generate(NvBootCryptoRsaKeySize KeySize, NvU32 *Exponent)
+{
+    NvU32 NumWords = KeySize / 32;
+    NvU32 i;
+
+    memset(&s_Key, 0, sizeof(s_Key));
+    s_Key.KeySize = KeySize;
+    s_Xorshift = KeySize;
+    for (i = 0; i < NumWords; i++)
+        s_Key.KeyData.Modulus[i] = Next();
+    s_Key.KeyData.Modulus[0] |= 1;
+    s_Key.KeyData.Modulus[NumWords - 1] |= 0x80000000;
+    for (i = 0; i < NumWords; i++)
+        s_Base[i] = Next();
+    s_Base[NumWords - 1] &= 0x7fffffff;
+    for (i = 0; i < NumWords; i++)
+        Exponent[i] = Next();
+}
+
+/* Loads the generated modulus with Exponent, KeySize / 32 words long. */
+static NvBootError SetKey(const NvU32 *Exponent)
+{
+    NvU32 NumWords = s_Key.KeySize / 32;
+
+    /* The device takes the exponent right after a KeySize modulus. */
+    memcpy(&s_Key.KeyData.Modulus[NumWords], Exponent, NumWords * 4);
+    return s_Rsa.RsaDevMgrCallbacks->SetKey((NvBootCryptoRsaKey *)&s_Key,
+                                            RSA_SLOT);
+}
+
+static NvBootError ModExp(const NvU32 *Base, NvU32 *Result)
+{
+    return s_Rsa.RsaDevMgrCallbacks->RsaModularExponentiation(
+        Base, Result, RSA_SLOT, s_Key.KeySize);
+}
+
+static NvBool IsWord(const NvU32 *x, NvU32 Value)
+{
+    NvU32 i;
+
+    if (x[0] != Value)
+        return NV_FALSE;
+    for (i = 1; i < s_Key.KeySize / 32; i++)
+    {
+        if (x[i] != 0)
+            return NV_FALSE;
+    }
+    return NV_TRUE;
+}
+
+/*
+ * ITERATIONS chained exponentiations from the generated base, for e =
+ * 0x10001, 3 and the generated exponent.
+ */
+static const NvU32 s_Chained2048F4[] = {
+    0xf57a8749, 0x5551a5a5, 0xb85f32d9, 0x945b0bd9, 0x79c10fcd, 0x10279272,
+    0x0f0db65b, 0x0337e066, 0xdb9dc422, 0x78ef11e0, 0x1bfa94ce, 0x0aecd77b,
+    0x4a338d10, 0x5cd3e3c1, 0x906a4f44, 0x0acca943, 0x6e6cd84c, 0x0144bd0d,
+    0xc9262684, 0x9213f054, 0x25ee3d0c, 0x10d45399, 0xf448ddd4, 0x9c2758ff,
+    0x18f368de, 0xc64d9eed, 0xec60b32d, 0x6fc99903, 0xfc8cfc72, 0xa3622eb7,
+    0x50c32713, 0x2abc6197, 0x7dafd594, 0x7aac19cf, 0xb32afe1a, 0x64ae3763,
+    0xdaf75026, 0x5d4d9c32, 0xf265eb0e, 0x79bfbd29, 0xc39433c5, 0x0d9a8326,
+    0x0f69f1f1, 0x6fa87a99, 0xa700408a, 0x5dc70ec4, 0x7158b279, 0x6d336f70,
+    0xdfe55068, 0xd6f4d3f5, 0x37604861, 0xc59210c0, 0x1f9327f8, 0xc976abb6,
+    0x185b2e12, 0x91fa4a94, 0x38ef62f2, 0x51855f71, 0x7d84a059, 0xc0a13cd0,
+    0x731e4302, 0x8488816d, 0x58614c73, 0x257338cf,
+};
+
+static const NvU32 s_Chained20483[] = {
+    0x9b085fd3, 0xdc665dd7, 0x408e1ebe, 0xeab4190b, 0xb584b775, 0x2f8ad8d8,
+    0x0fc33fcf, 0x8f41b276, 0x5567a904, 0xbb141cb8, 0x8d063455, 0x5a35f6f9,
+    0xb42a8ae1, 0x4860966f, 0xbaff1e84, 0x1d659d54, 0x205973d0, 0xf6242919,
+    0xbc6d2bed, 0x5893d45b, 0x62c1aed2, 0x0f7ee4b0, 0x10c179a2, 0x20a50657,
+    0x5bdb8b6b, 0xdffc892c, 0xaa9b488f, 0xdb7ee2e8, 0x036de0ce, 0x79daccfa,
+    0xb96fb7f6, 0x6d9ee0b2, 0x401c7c2d, 0x26667b6e, 0x02c998ee, 0xe5615664,
+    0xfed66e63, 0xee3ba3d5, 0x8ab0d9ba, 0x94f2be8c, 0xd6d23060, 0x129ecd2c,
+    0xda56095b, 0x3d743ff7, 0x92d6485f, 0xdcd035fc, 0xf7be3518, 0xdb019f25,
+    0x07a0e4b9, 0xf1cba5a9, 0x9d91da21, 0x628923ec, 0x5aceaa59, 0x459da0bc,
+    0xbf360b5b, 0xe97c5be9, 0x0e0c2bc5, 0x9ccafb1e, 0x153e2b8a, 0xd0c80edb,
+    0x7a960e17, 0x37f931a7, 0xd5c4f344, 0x8a83e298,
+};
+
+static const NvU32 s_Chained2048Full[] = {
+    0xd012f665, 0xc22e3615, 0xaf79c8f8, 0x1676fd2b, 0x2daaab3e, 0x8a743f6e,
+    0x3d8baa88, 0xf51a75f5, 0xb1faa9fc, 0x62b0e764, 0xbbdc6c91, 0xf9a011bd,
+    0x81946698, 0xa541ab17, 0xcb12c27d, 0xfd487b3a, 0xca22dd6e, 0x7fdfa594,
+    0x9d637904, 0x75a7cc9c, 0x93a502bd, 0x7725beed, 0x187cfa22, 0x4ed95f53,
+    0xe3afe7be, 0x19ed4bde, 0xa66b7a12, 0x087db9e8, 0x2262f527, 0xfab014fd,
+    0xd537d296, 0x63fbdc56, 0x22b02585, 0x569dabfa, 0xae286e80, 0xd08c53e5,
+    0x9ed803e2, 0x0536e08e, 0xe532b5b7, 0x4c02f28c, 0x6d455e7e, 0x832b0c73,
+    0x081af4aa, 0x12ed6837, 0xba0a6ce6, 0x368b8980, 0xb570f19d, 0x19008d81,
+    0x89381e8e, 0x2c26905e, 0x30169905, 0x6d31bb36, 0xbe0ff85c, 0x608b17d7,
+    0xc27006bd, 0x0d054125, 0x5f916e10, 0x830690b7, 0x3cb61667, 0xb7f298d2,
+    0x33e7957a, 0x67e9e262, 0x4186d13f, 0xa14057e8,
+};
+
+static const NvU32 s_Chained3072F4[] = {
+    0x6b35a2dd, 0x726989b4, 0xe984e6d0, 0xa40553f4, 0x615c97ac, 0x701e2414,
+    0x42dddf8a, 0x0fa75db3, 0x21d8412e, 0xf2abafa9, 0x37ba78ef, 0xeaf45d92,
+    0xa76ec23f, 0xfe4091dd, 0x6ce34797, 0xfe78a300, 0x9e2e730e, 0x4c80a353,
+    0x16a90c18, 0xf6f36ce9, 0x029f8cb3, 0xf9213244, 0x678a7ec5, 0xb85051b3,
+    0x02c0fbbf, 0xaebb8134, 0x8018b7f6, 0x1321a905, 0xefc7311f, 0xc529b899,
+    0xad24e5dc, 0x32746c36, 0x838d118c, 0x5c14e6fd, 0xb8ead5a2, 0xf39c2d77,
+    0x92a13b3b, 0x2efdca07, 0x32fe5dac, 0xd02ab361, 0x82e1644b, 0x65495e05,
+    0x5efb4d26, 0xc78129fd, 0x4151a3a6, 0x1248f35b, 0xbc8d02e3, 0x6f5e570f,
+    0xae333611, 0x1113434c, 0xfde5558e, 0xb1f3cc11, 0xf2c4fb12, 0x9244cd64,
+    0x3d1b9eab, 0xe9749738, 0x9040811d, 0x8e30e8ca, 0x2722541a, 0xafd87dec,
+    0x9b84baae, 0x3880f409, 0x7f4ac08b, 0x26aba5a6, 0xbde94d0b, 0x0a04ac07,
+    0xa18e2981, 0x9867b51d, 0x83e58593, 0x074a3091, 0x4a20179a, 0x84bfd91c,
+    0x2fec3525, 0x81ca22c1, 0xbeb1a879, 0x3f33ba81, 0xe71436c7, 0xb7489e03,
+    0x55198ea5, 0x37e820ee, 0x12259735, 0x71ba773b, 0xcd968fd6, 0x30e8a70f,
+    0xbacf4d4a, 0xdff23a7a, 0x042de904, 0xa703e16e, 0x341ce620, 0x757f592e,
+    0xbd62bf50, 0x4e6975ef, 0xbfdab7a9, 0xa1d2de16, 0x53bf1682, 0x5a2bc186,
+};
+
+static const NvU32 s_Chained30723[] = {
+    0x7974898e, 0xa48b0b32, 0xb25a639b, 0x45b0b337, 0xc5be116f, 0x812e14b2,
+    0x8346ccad, 0xda781225, 0xf36aa57b, 0xa4cb8283, 0xbc886914, 0x3b502dd1,
+    0xa0f09cab, 0x53ad691a, 0x9d4a04ad, 0xd8ef0357, 0x622ac200, 0x335970b3,
+    0x4abc3ea0, 0x5f900ee5, 0x13d97214, 0x7d86ff8c, 0xc4068dde, 0x0b8ba3cc,
+    0x81317e53, 0xddf90c78, 0x89b565c7, 0x8d4a8095, 0xbc33fbf9, 0x916d82d9,
+    0x77e84e4a, 0x21e17f5a, 0xf05b5f66, 0xdc10d0ef, 0x319e7b22, 0xa611a059,
+    0x312043e2, 0x305a2db7, 0xa47e9a91, 0xab1c82e5, 0xb8a27464, 0x8c6df65d,
+    0x2be350cb, 0x5fc8d3d0, 0xb59e813c, 0x20784aa3, 0x078e24ba, 0x3d11f441,
+    0xc84d5376, 0x5f53066b, 0x010f16a4, 0x787a08ba, 0xc654effd, 0x261b8df9,
+    0xe31ed364, 0xc98f985c, 0xd745c655, 0x84e54c26, 0x4cf0adad, 0x36deaf5e,
+    0x74d4c6e6, 0xc6e2bbb0, 0xf9e61c0e, 0x6f03b9a5, 0x594d6c8f, 0x009d6bf2,
+    0xa6909c85, 0xb0bba5c9, 0xad51968a, 0x2bce6c0c, 0x74ea57fe, 0xc7df17b6,
+    0x70587d83, 0xfacb94ef, 0x10027c7b, 0xd4a52021, 0xcffa6432, 0xa5202c19,
+    0x9005e011, 0x528d3d33, 0xefcb329e, 0x1a7fe4f5, 0x319f6d39, 0x76011937,
+    0x54e14cde, 0x5d000385, 0x258230ce, 0x8bf7f94e, 0xdf647ef1, 0xa17f8512,
+    0x315e2e47, 0x0d552951, 0x8da3ced4, 0xe9f4af05, 0xd30d5c6c, 0x44d53e02,
+};
+
+static const NvU32 s_Chained3072Full[] = {
+    0xd75c03f9, 0xbb363c3f, 0x3782c3d6, 0x01c9631b, 0xa1d255f0, 0xdb2b79af,
+    0xb5182b52, 0xa10f70d7, 0x65d8b8e1, 0x7520aa85, 0x7d149e47, 0x521c3867,
+    0x0ac2e5a6, 0xce108b02, 0x355c3eac, 0x2a1dd01f, 0x87a11f7e, 0xc65f35a2,
+    0xd7e5f9f4, 0x57b8d4c3, 0x9a2ee7ee, 0xcdff97d2, 0x9c47bbd6, 0xfd53f32a,
+    0x30f31a23, 0xd80b66e4, 0x73af1db7, 0x2a3e5341, 0x7de387e5, 0x40a2032b,
+    0x632c9f48, 0x07d0d2a3, 0x576727d6, 0x3b23b22b, 0xa4d1128c, 0x76ec0c9d,
+    0x71899e76, 0xf656b570, 0x2f79b287, 0xca8b709d, 0x6cb4e818, 0x88044c9f,
+    0xbf6b1793, 0x0a3b1920, 0xa8975eaa, 0x8ede98f3, 0x4e9897c6, 0x6cd4a277,
+    0xbdd18182, 0xae859853, 0x75cee00c, 0x42255551, 0xef484054, 0x6772ed8d,
+    0x7b8b6543, 0xfb69b0f5, 0xb2f5fb58, 0xe45d6311, 0x2e48ae1f, 0x3cfee38e,
+    0x6635b1bd, 0x0914d779, 0xa558886e, 0x5e8e74ab, 0xcdf0ef44, 0x9dc85db4,
+    0x73e91258, 0xab62f13f, 0xa6239df3, 0xb08d4954, 0x324e59ba, 0x8b84fbb1,
+    0x07e274c5, 0xa2a83544, 0x9a56127e, 0x2c7ef820, 0xcdb6cc96, 0x96113f1f,
+    0xad35ee73, 0x22393750, 0x5cac0ee3, 0xaf915eb9, 0xea5bf729, 0x5e2c51dc,
+    0xa4d892c0, 0xfc54c36d, 0xf8dafefe, 0xc4b112b5, 0x2a7c0d44, 0x36ea5ee4,
+    0x9122f434, 0x8ab65b02, 0xbdc6cdf3, 0x9c35e6c0, 0x12ff7866, 0x3c70b9ce,
+};
+
+static void CheckChained(NvBootCryptoRsaKeySize KeySize, const NvU32 *Want[3])
+{
+    NvU32 Random[MAX_WORDS], Exponent[MAX_WORDS];
+    NvU32 x[MAX_WORDS];
+    NvU32 NumWords = KeySize / 32;
+    int e, i;
+
+    Generate(KeySize, Random);
+    for (e = 0; e < 3; e++)
+    {
+        memset(Exponent, 0, sizeof(Exponent));
+        if (e == 0)
+            Exponent[0] = F4;
+        else if (e == 1)
+            Exponent[0] = 3;
+        else
+            memcpy(Exponent, Random, NumWords * 4);
+        CHECK(SetKey(Exponent) == NvBootError_Success);
+
+        memcpy(x, s_Base, NumWords * 4);
+        for (i = 0; i < ITERATIONS; i++)
+        {
+            CHECK(ModExp(x, s_Result) == NvBootError_Success);
+            memcpy(x, s_Result, NumWords * 4);
+        }
+        CHECK(!memcmp(x, Want[e], NumWords * 4));
+    }
+}
+
+static void CheckEdges(NvBootCryptoRsaKeySize KeySize)
+{
+    NvU32 Random[MAX_WORDS], Exponent[MAX_WORDS];
+    NvU32 NumWords = KeySize / 32;
+    NvU32 Base[MAX_WORDS];
+
+    Generate(KeySize, Random);
+    memset(Exponent, 0, sizeof(Exponent));
+
+    /* x^0 = 1 and x^1 = x. */
+    CHECK(SetKey(Exponent) == NvBootError_Success);
+    CHECK(ModExp(s_Base, s_Result) == NvBootError_Success);
+    CHECK(IsWord(s_Result, 1));
+    Exponent[0] = 1;
+    CHECK(SetKey(Exponent) == NvBootError_Success);
+    CHECK(ModExp(s_Base, s_Result) == NvBootError_Success);
+    CHECK(!memcmp(s_Result, s_Base, NumWords * 4));
+
+    /* 0 and 1 are fixed points, n - 1 is -1. */
+    Exponent[0] = F4;
+    CHECK(SetKey(Exponent) == NvBootError_Success);
+    memset(Base, 0, sizeof(Base));
+    CHECK(ModExp(Base, s_Result) == NvBootError_Success);
+    CHECK(IsWord(s_Result, 0));
+    Base[0] = 1;
+    CHECK(ModExp(Base, s_Result) == NvBootError_Success);
+    CHECK(IsWord(s_Result, 1));
+    memcpy(Base, s_Key.KeyData.Modulus, NumWords * 4);
+    Base[0]--;
+    CHECK(ModExp(Base, s_Result) == NvBootError_Success);
+    CHECK(!memcmp(s_Result, Base, NumWords * 4));
+    Exponent[0] = 2;
+    CHECK(SetKey(Exponent) == NvBootError_Success);
+    CHECK(ModExp(Base, s_Result) == NvBootError_Success);
+    CHECK(IsWord(s_Result, 1));
+}
+
+static void CheckKeys(void)
+{
+    NvBootRsaDevMgr Mgr;
+    Key3072 Read;
+    NvU32 Random[MAX_WORDS], Exponent[MAX_WORDS] = { F4 };
+
+    CHECK(NvBootRsaDevMgrInit(&Mgr, NvBootRsaDevice_PKA1) ==
+          NvBootError_DeviceUnsupported);
+    CHECK(NvBootRsaDevMgrInit(&Mgr, NvBootRsaDevice_Num) ==
+          NvBootError_DeviceUnsupported);
+
+    /* A freshly initialized device has no key to use. */
+    CHECK(NvBootRsaDevMgrInit(&s_Rsa, NvBootRsaDevice_SW) ==
+          NvBootError_Success);
+    CHECK(ModExp(s_Base, s_Result) == NvBootError_InvalidSeKeySize);
+
+    CHECK(s_Rsa.RsaDevMgrCallbacks->GetNumKeySlots() == 1);
+    CHECK(!s_Rsa.RsaDevMgrCallbacks->IsValidKeySlot(1));
+    CHECK(s_Rsa.RsaDevMgrCallbacks->IsValidKeySize(RSA_KEY_2048));
+    CHECK(s_Rsa.RsaDevMgrCallbacks->IsValidKeySize(RSA_KEY_3072));
+    CHECK(!s_Rsa.RsaDevMgrCallbacks->IsValidKeySize(1024));
+
+    Generate(RSA_KEY_2048, Random);
+    CHECK(SetKey(Exponent) == NvBootError_Success);
+    CHECK(s_Rsa.RsaDevMgrCallbacks->SetKey((NvBootCryptoRsaKey *)&s_Key, 1) ==
+          NvBootError_InvalidSeKeySlotNum);
+    CHECK(s_Rsa.RsaDevMgrCallbacks->RsaModularExponentiation(
+              s_Base, s_Result, 1, RSA_KEY_2048) ==
+          NvBootError_InvalidSeKeySlotNum);
+    CHECK(s_Rsa.RsaDevMgrCallbacks->RsaModularExponentiation(
+              s_Base, s_Result, RSA_SLOT, RSA_KEY_3072) ==
+          NvBootError_InvalidSeKeySize);
+
+    /* The key reads back as it went in. */
+    memset(&Read, 0, sizeof(Read));
+    CHECK(s_Rsa.RsaDevMgrCallbacks->GetKey((NvBootCryptoRsaKey *)&Read,
+                                           RSA_SLOT, RSA_KEY_2048) ==
+          NvBootError_Success);
+    CHECK(Read.KeySize == RSA_KEY_2048);
+    CHECK(!memcmp(&Read.KeyData, &s_Key.KeyData, 2 * RSA_KEY_2048 / 8));
+    CHECK(s_Rsa.RsaDevMgrCallbacks->GetKey((NvBootCryptoRsaKey *)&Read,
+                                           RSA_SLOT, RSA_KEY_3072) ==
+          NvBootError_InvalidSeKeySize);
+
+    /* Even moduli and short ones have no Montgomery form here. */
+    s_Key.KeyData.Modulus[0] &= ~1;
+    CHECK(SetKey(Exponent) == NvBootError_IllegalParameter);
+    s_Key.KeyData.Modulus[0] |= 1;
+    s_Key.KeyData.Modulus[RSA_KEY_2048 / 32 - 1] &= 0x7fffffff;
+    CHECK(SetKey(Exponent) == NvBootError_IllegalParameter);
+    s_Key.KeySize = 1024;
+    CHECK(SetKey(Exponent) == NvBootError_InvalidSeKeySize);
+}
+
+/* Reloading the key already in the slot keeps its results right. */
+static void CheckResident(void)
+{
+    NvU32 Random[MAX_WORDS], Exponent[MAX_WORDS] = { F4 };
+
+    Generate(RSA_KEY_2048, Random);
+    CHECK(SetKey(Exponent) == NvBootError_Success);
+    CHECK(ModExp(s_Base, s_Result) == NvBootError_Success);
+    CHECK(SetKey(Exponent) == NvBootError_Success);
+    CHECK(ModExp(s_Result, s_Result) == NvBootError_Success);
+    CHECK(SetKey(Exponent) == NvBootError_Success);
+
+    /* The base may also be the result. */
+    CHECK(ModExp(s_Base, s_Base) == NvBootError_Success);
+    CHECK(ModExp(s_Base, s_Base) == NvBootError_Success);
+    CHECK(!memcmp(s_Base, s_Result, RSA_KEY_2048 / 8));
+}
+
+/* Another key in the slot replaces the kept constants, and back again. */
+static void CheckKeyChange(void)
+{
+    NvU32 Random[MAX_WORDS], Exponent[MAX_WORDS] = { F4 };
+    NvU32 First[MAX_WORDS], Other[MAX_WORDS];
+    Key3072 Key;
+
+    Generate(RSA_KEY_2048, Random);
+    Key = s_Key;
+    CHECK(SetKey(Exponent) == NvBootError_Success);
+    CHECK(ModExp(s_Base, First) == NvBootError_Success);
+
+    s_Key.KeyData.Modulus[1] ^= 0x5a5a5a5a;
+    CHECK(SetKey(Exponent) == NvBootError_Success);
+    CHECK(ModExp(s_Base, Other) == NvBootError_Success);
+    CHECK(memcmp(First, Other, RSA_KEY_2048 / 8));
+
+    s_Key = Key;
+    CHECK(SetKey(Exponent) == NvBootError_Success);
+    CHECK(ModExp(s_Base, s_Result) == NvBootError_Success);
+    CHECK(!memcmp(First, s_Result, RSA_KEY_2048 / 8));
+
+    /* The same modulus with another exponent. */
+    Exponent[0] = 3;
+    CHECK(SetKey(Exponent) == NvBootError_Success);
+    CHECK(ModExp(s_Base, s_Result) == NvBootError_Success);
+    CHECK(memcmp(First, s_Result, RSA_KEY_2048 / 8));
+}
+
+static int Check(void)
+{
+    static const NvU32 *Want2048[] = {
+        s_Chained2048F4, s_Chained20483, s_Chained2048Full,
+    };
+    static const NvU32 *Want3072[] = {
+        s_Chained3072F4, s_Chained30723, s_Chained3072Full,
+    };
+
+    CheckKeys();
+    CheckChained(RSA_KEY_2048, Want2048);
+    CheckChained(RSA_KEY_3072, Want3072);
+    CheckEdges(RSA_KEY_2048);
+    CheckEdges(RSA_KEY_3072);
+    CheckResident();
+    CheckKeyChange();
+
+    printf("sw_rsa: %u checks, %u failures\n", s_Cases, s_Failures);
+    return s_Failures != 0;
+}
+
+/* Modular exponentiations per second, over at least half a second. */
+static double PerSecond(NvBootCryptoRsaKeySize KeySize, NvU32 e)
+{
+    NvU32 Random[MAX_WORDS], Exponent[MAX_WORDS] = { e };
+    struct timespec Start, Now;
+    double Took;
+    long n = 0;
+    int i;
+
+    Generate(KeySize, Random);
+    SetKey(Exponent);
+    clock_gettime(CLOCK_MONOTONIC, &Start);
+    do
+    {
+        for (i = 0; i < 100; i++)
+            ModExp(s_Base, s_Result);
+        n += 100;
+        clock_gettime(CLOCK_MONOTONIC, &Now);
+        Took = (Now.tv_sec - Start.tv_sec) + (Now.tv_nsec - Start.tv_nsec) * 1e-9;
+    } while (Took < 0.5);
+    return n / Took;
+}
+
+/*
+ * Microseconds per image for SetKey and one exponentiation, over at least
+ * half a second. With Resident false the image alternates between two
+ * keys, so every SetKey recomputes the Montgomery constants.
+ */
+static double UsPerImage(NvBootCryptoRsaKeySize KeySize, NvBool Resident)
+{
+    NvU32 Random[MAX_WORDS], Exponent[MAX_WORDS] = { F4 };
+    Key3072 Keys[2];
+    struct timespec Start, Now;
+    double Took;
+    long n = 0;
+    int i;
+
+    Generate(KeySize, Random);
+    Keys[0] = s_Key;
+    Keys[1] = s_Key;
+    Keys[1].KeyData.Modulus[1] ^= 0x5a5a5a5a;
+    clock_gettime(CLOCK_MONOTONIC, &Start);
+    do
+    {
+        for (i = 0; i < 100; i++)
+        {
+            s_Key = Keys[Resident ? 0 : (i & 1)];
+            SetKey(Exponent);
+            ModExp(s_Base, s_Result);
+        }
+        n += 100;
+        clock_gettime(CLOCK_MONOTONIC, &Now);
+        Took = (Now.tv_sec - Start.tv_sec) + (Now.tv_nsec - Start.tv_nsec) * 1e-9;
+    } while (Took < 0.5);
+    return Took * 1e6 / n;
+}
+
+static int Bench(void)
+{
+    NvBootCryptoRsaKeySize Sizes[] = { RSA_KEY_2048, RSA_KEY_3072 };
+    int i;
+
+    /* 0x10003 takes the generic path with the same 16 squarings. */
+    printf("modular exponentiations per second\n");
+    printf("%-6s %12s %18s\n", "key", "e = 0x10001", "e = 0x10003");
+    for (i = 0; i < 2; i++)
+    {
+        printf("%-6d %12.0f %18.0f\n", Sizes[i], PerSecond(Sizes[i], F4),
+               PerSecond(Sizes[i], 0x10003));
+    }
+
+    printf("microseconds per image, SetKey and one verify, e = 0x10001\n");
+    printf("%-6s %12s %18s\n", "key", "resident", "changing key");
+    for (i = 0; i < 2; i++)
+    {
+        printf("%-6d %12.1f %18.1f\n", Sizes[i],
+               UsPerImage(Sizes[i], NV_TRUE), UsPerImage(Sizes[i], NV_FALSE));
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (NvBootRsaDevMgrInit(&s_Rsa, NvBootRsaDevice_SW) != NvBootError_Success)
+    {
+        fprintf(stderr, "sw_rsa: NvBootRsaDevice_SW is not built\n");
+        return 1;
+    }
+
+    if ((argc > 1) && !strcmp(argv[1], "bench"))
+        return Bench();
+    return Check();
+}
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of the software SHA-2 device, core/sw_sha/nvboot_sw_sha_dev.c,
+ * reached through the SHA device manager as NvBootShaDevice_SW.
+ *
+ * "check" runs the vectors of nvboot_sha2_test_vectors.h and the FIPS 180
+ * examples for SHA-384 and SHA-512, then hashes every length from 0 to 299
+ * bytes and a few longer ones at each byte offset from a word boundary.
+ * The digests of those are hashed together and compared with a value
+ * computed once with another SHA-2 implementation. "bench" prints the
+ * cycles per byte of each digest size, on word-aligned and unaligned input.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "nvboot_sha_devmgr_int.h"
+#include "nvboot_sha2_test_vectors.h"
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "sw_sha: %s:%d: %s\n", __FILE__,            \
+                    __LINE__, #Cond);                                   \
+        }                                                               \
+    } while (0)
+
+#define COUNT(List) (int)(sizeof(List) / sizeof(List[0]))
+
+#define MAX_DIGEST  (SHA_512 / 8)
+
+static const NvBootCryptoShaDigestSize s_Sizes[] = { SHA_256, SHA_384, SHA_512 };
+
+static NvBootShaDevMgr s_Sha;
+
+/* The message and digest buffers are word aligned, as in the boot flow. */
+static uint8_t s_Msg[(1 << 20) + 4] __attribute__((aligned(64)));
+static uint8_t s_Digest[MAX_DIGEST + 16] __attribute__((aligned(64)));
+
+static NvBootError Hash(NvBootCryptoShaDigestSize Size, const uint8_t *Msg,
+                        NvU32 Len)
+{
+    CHECK(s_Sha.ShaDevMgrCallbacks->SetDigestSize(&s_Sha.ShaConfig, Size));
+    return s_Sha.ShaDevMgrCallbacks->ShaHash((const uint32_t *)Msg, Len,
+                                             (uint32_t *)s_Digest,
+                                             &s_Sha.ShaConfig);
+}
+
+static void CheckHash(NvBootCryptoShaDigestSize Size, const char *Msg,
+                      NvU32 Len, const char *Hex)
+{
+    uint8_t Want[MAX_DIGEST];
+    unsigned i, x;
+
+    for (i = 0; i < Size / 8; i++)
+    {
+        sscanf(&Hex[2 * i], "%2x", &x);
+        Want[i] = x;
+    }
+    memcpy(s_Msg, Msg, Len);
+    memset(s_Digest, 0xa5, sizeof(s_Digest));
+    CHECK(Hash(Size, s_Msg, Len) == NvBootError_Success);
+    CHECK(!memcmp(s_Digest, Want, Size / 8));
+
+    /* Nothing is written past the digest. */
+    for (i = Size / 8; i < sizeof(s_Digest); i++)
+        CHECK(s_Digest[i] == 0xa5);
+}
+
+static void CheckVectors(void)
+{
+    static const char Long[] =
+        "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+        "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+    int i;
+
+    for (i = 0; i < COUNT(sha256_test_input_len); i++)
+    {
+        memcpy(s_Msg, sha256_test_input[i], sha256_test_input_len[i]);
+        CHECK(Hash(SHA_256, s_Msg, sha256_test_input_len[i]) ==
+              NvBootError_Success);
+        CHECK(!memcmp(s_Digest, sha256_test_digests[i], SHA_256 / 8));
+    }
+
+    CheckHash(SHA_384, "abc", 3,
+              "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded163"
+              "1a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7");
+    CheckHash(SHA_384, Long, 112,
+              "09330c33f71147e83d192fc782cd1b4753111b173b3b05d2"
+              "2fa08086e3b0f712fcc7c71a557e2db966c3e9fa91746039");
+    CheckHash(SHA_512, "abc", 3,
+              "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+              "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+    CheckHash(SHA_512, Long, 112,
+              "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018"
+              "501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909");
+}
+
+/*
+ * Every padding case of both block sizes, and whole blocks, at each byte
+ * offset. Message byte i is (31 * i + 7) & 0xff. The expected values are
+ * the digest, at the same size, of all the digests in length order.
+ */
+#define MAX_LEN     5000
+
+static const NvU32 s_Lengths[] = { 1000, 4096, MAX_LEN };
+
+static const uint8_t s_Chained256[] = {
+    0xb0, 0x92, 0x15, 0xbb, 0xb3, 0x9c, 0x31, 0xf1,
+    0xf5, 0x08, 0xf2, 0x48, 0x6c, 0xb8, 0xa8, 0xd3,
+    0x81, 0x3d, 0xe6, 0x96, 0x19, 0x6b, 0xed, 0x46,
+    0xbd, 0x40, 0x75, 0x43, 0x11, 0x08, 0xd2, 0x15,
+};
+
+static const uint8_t s_Chained384[] = {
+    0x9b, 0xb4, 0xb8, 0xd3, 0xdf, 0xd2, 0x37, 0x5f,
+    0xd3, 0xc2, 0xca, 0x80, 0x8b, 0xbd, 0xc8, 0x38,
+    0x4c, 0x79, 0xb2, 0x47, 0xf5, 0x98, 0x2b, 0xdc,
+    0x43, 0x28, 0x2c, 0x46, 0xb7, 0x26, 0xb5, 0x89,
+    0x36, 0x67, 0x23, 0x94, 0xb5, 0x85, 0x6c, 0x74,
+    0xc3, 0x12, 0xbe, 0xc4, 0x02, 0x6c, 0xa2, 0x46,
+};
+
+static const uint8_t s_Chained512[] = {
+    0x4b, 0x72, 0xa0, 0x43, 0xe9, 0x2e, 0xd6, 0xa3,
+    0x8a, 0xd4, 0xaf, 0xb9, 0x9f, 0x28, 0x33, 0x9d,
+    0xc2, 0x79, 0x99, 0x78, 0x22, 0xed, 0x42, 0x3b,
+    0xaa, 0x68, 0x1e, 0x26, 0xca, 0xa2, 0xb0, 0xe6,
+    0x0e, 0x4a, 0x14, 0x26, 0x17, 0xe9, 0x00, 0x28,
+    0x3c, 0xc3, 0xbb, 0x1f, 0xd7, 0x2f, 0x19, 0x4c,
+    0x0c, 0x09, 0x66, 0x3e, 0x19, 0xe5, 0x17, 0x8c,
+    0x33, 0x50, 0xd0, 0xed, 0xfe, 0x90, 0xdb, 0x2e,
+};
+
+static void CheckChained(NvBootCryptoShaDigestSize Size, const uint8_t *Want)
+{
+    static uint8_t Digests[(300 + COUNT(s_Lengths)) * MAX_DIGEST]
+        __attribute__((aligned(4)));
+    NvU32 Bytes = Size / 8;
+    NvU32 Len, n, i;
+    int Offset;
+
+    for (Offset = 0; Offset < 4; Offset++)
+    {
+        for (i = 0; i < MAX_LEN; i++)
+            s_Msg[Offset + i] = (uint8_t)(31 * i + 7);
+
+        for (n = 0; n < 300 + COUNT(s_Lengths); n++)
+        {
+            Len = (n < 300) ? n : s_Lengths[n - 300];
+            CHECK(Hash(Size, &s_Msg[Offset], Len) == NvBootError_Success);
+            memcpy(&Digests[n * Bytes], s_Digest, Bytes);
+        }
+        CHECK(Hash(Size, Digests, n * Bytes) == NvBootError_Success);
+        CHECK(!memcmp(s_Digest, Want, Bytes));
+    }
+}
+
+static void CheckConfig(void)
+{
+    NvBootShaDevMgr Mgr;
+
+    CHECK(NvBootShaDevMgrInit(&Mgr, NvBootShaDevice_Num) ==
+          NvBootError_DeviceUnsupported);
+
+    CHECK(s_Sha.ShaDevMgrCallbacks->GetShaFamily(&s_Sha.ShaConfig) == SHA2);
+    CHECK(!s_Sha.ShaDevMgrCallbacks->IsValidShaFamily(SHA3));
+    CHECK(!s_Sha.ShaDevMgrCallbacks->SetShaFamily(&s_Sha.ShaConfig, SHA3));
+    CHECK(!s_Sha.ShaDevMgrCallbacks->IsValidDigestSize(SHA_INVALID_DIGEST));
+    CHECK(!s_Sha.ShaDevMgrCallbacks->SetDigestSize(&s_Sha.ShaConfig,
+                                                   SHA_INVALID_DIGEST));
+    CHECK(s_Sha.ShaDevMgrCallbacks->SetDigestSize(&s_Sha.ShaConfig, SHA_384));
+    CHECK(s_Sha.ShaDevMgrCallbacks->GetDigestSize(&s_Sha.ShaConfig) ==
+          SHA_384);
+
+    /* A config the setters would refuse is refused by the hash too. */
+    s_Sha.ShaConfig.ShaDigestSize = SHA_INVALID_DIGEST;
+    CHECK(s_Sha.ShaDevMgrCallbacks->ShaHash((const uint32_t *)s_Msg, 3,
+                                            (uint32_t *)s_Digest,
+                                            &s_Sha.ShaConfig) ==
+          NvBootError_Unsupported_SHA_DigestSize);
+    s_Sha.ShaConfig.ShaDigestSize = SHA_256;
+    s_Sha.ShaConfig.ShaFamily = SHA3;
+    CHECK(s_Sha.ShaDevMgrCallbacks->ShaHash((const uint32_t *)s_Msg, 3,
+                                            (uint32_t *)s_Digest,
+                                            &s_Sha.ShaConfig) ==
+          NvBootError_Unsupported_SHA_Family);
+    s_Sha.ShaConfig.ShaFamily = SHA2;
+}
+
+static int Check(void)
+{
+    CheckVectors();
+    CheckChained(SHA_256, s_Chained256);
+    CheckChained(SHA_384, s_Chained384);
+    CheckChained(SHA_512, s_Chained512);
+    CheckConfig();
+
+    printf("sw_sha: %u checks, %u failures\n", s_Cases, s_Failures);
+    return s_Failures != 0;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/* Best of 7 runs, in cycles per byte. */
+static double Cycles(NvBootCryptoShaDigestSize Size, int Offset, NvU32 Len)
+{
+    uint64_t Best = ~0ull, Start, Took;
+    int Reps = (Len > 4096) ? 4 : 20000;
+    int t, r;
+
+    s_Sha.ShaDevMgrCallbacks->SetDigestSize(&s_Sha.ShaConfig, Size);
+    for (t = 0; t < 7; t++)
+    {
+        Start = __rdtsc();
+        for (r = 0; r < Reps; r++)
+        {
+            s_Sha.ShaDevMgrCallbacks->ShaHash(
+                (const uint32_t *)&s_Msg[Offset], Len, (uint32_t *)s_Digest,
+                &s_Sha.ShaConfig);
+            __asm__ volatile("" ::: "memory");
+        }
+        Took = __rdtsc() - Start;
+        if (Took < Best)
+            Best = Took;
+    }
+    return (double)Best / Reps / Len;
+}
+
+static int Bench(void)
+{
+    int i;
+
+    memset(s_Msg, 0x5a, sizeof(s_Msg));
+    printf("cycles per byte, word-aligned and offset by one byte\n");
+    printf("%-8s %10s %10s %10s %10s\n", "digest", "64 B", "64 B +1",
+           "1 MB", "1 MB +1");
+    for (i = 0; i < COUNT(s_Sizes); i++)
+    {
+        printf("SHA-%-4d %10.1f %10.1f %10.2f %10.2f\n", s_Sizes[i],
+               Cycles(s_Sizes[i], 0, 64), Cycles(s_Sizes[i], 1, 64),
+               Cycles(s_Sizes[i], 0, 1 << 20),
+               Cycles(s_Sizes[i], 1, 1 << 20));
+    }
+    return 0;
+}
+
+#else
+
+static int Bench(void)
+{
+    printf("sw_sha: the benchmark needs an x86 cycle counter\n");
+    return 0;
+}
+
+#endif
+
+int main(int argc, char **argv)
+{
+    if (NvBootShaDevMgrInit(&s_Sha, NvBootShaDevice_SW) !=
+        NvBootError_Success)
+    {
+        fprintf(stderr, "sw_sha: NvBootShaDevice_SW is not built\n");
+        return 1;
+    }
+
+    if ((argc > 1) && !strcmp(argv[1], "bench"))
+        return Bench();
+    return Check();
+}
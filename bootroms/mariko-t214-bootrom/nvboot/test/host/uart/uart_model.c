@@ -0,0 +1,450 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * uart_model.c - Register level model of UARTA over a pty. See
+ * uart_model.h.
+ *
+ * The receive side holds one byte, not a FIFO: the Boot ROM polls LSR for
+ * every byte it takes, and a line error or an overrun loses the byte it
+ * comes with. Line errors are reported once, by the LSR read that finds
+ * them, as on a 16550.
+ *
+ * Bytes in flight are tagged with the divisor they were sent at, in a ring
+ * indexed by their position in the stream; each end compares the tag with
+ * its own divisor when it takes the byte.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "nvcommon.h"
+#include "nvrm_drf.h"
+#include "arclk_rst.h"
+#include "aruart.h"
+#include "host_clock.h"
+#include "host_regs.h"
+#include "uart_model.h"
+
+#define UART_BASE           NV_ADDRESS_MAP_APB_UARTA_BASE
+#define UART_REG_BYTES      0x100
+#define UART_CLK_SOURCE     (NV_ADDRESS_MAP_CAR_BASE + \
+                             CLK_RST_CONTROLLER_CLK_SOURCE_UARTA_0)
+/* A divisor no host runs at: the UART is in reset or off CLK_M. */
+#define NO_DIVISOR          0xffff
+
+/* Larger than the bytes a pty holds plus one host write chunk. */
+#define TAG_RING            (1 << 20)
+#define HOST_CHUNK          4096
+#define HOST_TIMEOUT_MS     5000
+/* LSR reads with nothing received, once the host is gone, taken to be a
+ * Boot ROM waiting on it. */
+#define HUNG_UP_POLLS       1000
+
+static UartModelLine s_Line;
+static UartModelStats s_Stats;
+static NvU64 s_Now;
+static NvU32 s_Rand;
+
+static int s_DevFd = -1;
+static int s_HostFd = -1;
+
+static NvU32 s_Regs[UART_REG_BYTES / 4];
+static NvU32 s_DevDivisor;
+static NvU8 s_Rx;
+static NvBool s_RxValid;
+static NvU8 s_RxErrors;
+static NvU32 s_GonePolls;
+
+static NvU32 s_HostDivisor;
+static NvU32 s_FlipPpm;
+static NvU32 s_OverrunPpm;
+
+/* Shared by the two ends, under s_Lock. */
+static pthread_mutex_t s_Lock = PTHREAD_MUTEX_INITIALIZER;
+/* Signalled whenever the host end sends, takes, waits or goes. */
+static pthread_cond_t s_HostMoved = PTHREAD_COND_INITIALIZER;
+static NvU16 s_ToDevTag[TAG_RING];
+static NvU16 s_ToHostTag[TAG_RING];
+static NvU32 s_HostSent;
+static NvU32 s_DevTaken;
+static NvU32 s_DevSent;
+static NvU32 s_HostTaken;
+static NvBool s_HostWaiting;
+static NvBool s_HostGone;
+
+static void Advance(NvU64 Ns)
+{
+    s_Now += Ns;
+    if (s_Now / 1000 > HostClockNow())
+        HostClockAdvance((NvU32)(s_Now / 1000 - HostClockNow()));
+}
+
+/* 11 bits a character: start, 8 data bits and 2 stop bits. */
+static NvU64 CharNs(NvU32 Divisor)
+{
+    return 88000000ULL * (Divisor + 2) / s_Line.OscKhz;
+}
+
+static NvU32 Xorshift(void)
+{
+    s_Rand ^= s_Rand << 13;
+    s_Rand ^= s_Rand >> 17;
+    s_Rand ^= s_Rand << 5;
+    return s_Rand;
+}
+
+static NvBool Chance(NvU32 Ppm)
+{
+    return Ppm && (Xorshift() % 1000000 < Ppm);
+}
+
+/*
+ * Takes the next byte off the line, or lets time pass if there is none.
+ * With no byte to take, this waits until the host either sends one or
+ * waits on the Boot ROM with every byte taken both ways; only then does
+ * the Boot ROM spin, so how far the timer moves does not depend on how
+ * the host thread is scheduled.
+ */
+static void Receive(void)
+{
+    struct pollfd Fd;
+    NvU32 Seq;
+    NvU8 Data;
+
+    pthread_mutex_lock(&s_Lock);
+    while (read(s_DevFd, &Data, 1) != 1)
+    {
+        if (s_DevTaken != s_HostSent)
+        {
+            /* On its way through the pty. */
+            pthread_mutex_unlock(&s_Lock);
+            Fd.fd = s_DevFd;
+            Fd.events = POLLIN;
+            (void)poll(&Fd, 1, 1);
+            pthread_mutex_lock(&s_Lock);
+        }
+        else if (s_HostGone)
+        {
+            /* Nothing more is coming; the Boot ROM may still poll LSR on
+             * its way out, but must not wait on the line. */
+            pthread_mutex_unlock(&s_Lock);
+            if (++s_GonePolls == HUNG_UP_POLLS)
+            {
+                fprintf(stderr, "uart: model: the host hung up\n");
+                abort();
+            }
+            return;
+        }
+        else if (s_HostWaiting && (s_HostTaken == s_DevSent))
+        {
+            pthread_mutex_unlock(&s_Lock);
+            Advance(UART_MODEL_IDLE_US * 1000ULL);
+            return;
+        }
+        else
+        {
+            pthread_cond_wait(&s_HostMoved, &s_Lock);
+        }
+    }
+
+    Seq = s_DevTaken++;
+    pthread_mutex_unlock(&s_Lock);
+    Advance(CharNs(s_DevDivisor));
+    s_Stats.BytesFromHost++;
+
+    if (s_ToDevTag[Seq % TAG_RING] != s_DevDivisor)
+    {
+        s_Stats.FramingErrors++;
+        s_RxErrors |= UART_LSR_0_FERR_FIELD;
+        return;
+    }
+    if (Chance(__atomic_load_n(&s_OverrunPpm, __ATOMIC_RELAXED)))
+    {
+        s_Stats.Overruns++;
+        s_RxErrors |= UART_LSR_0_OVRF_FIELD;
+        return;
+    }
+    if (Chance(__atomic_load_n(&s_FlipPpm, __ATOMIC_RELAXED)))
+    {
+        s_Stats.Flips++;
+        Data ^= 1 << (Xorshift() & 7);
+    }
+    s_Rx = Data;
+    s_RxValid = NV_TRUE;
+}
+
+static void Transmit(NvU8 Data)
+{
+    struct pollfd Fd;
+
+    pthread_mutex_lock(&s_Lock);
+    s_ToHostTag[s_DevSent % TAG_RING] = (NvU16)s_DevDivisor;
+    s_DevSent++;
+    pthread_mutex_unlock(&s_Lock);
+    Advance(CharNs(s_DevDivisor));
+    s_Stats.BytesToHost++;
+
+    while (write(s_DevFd, &Data, 1) != 1)
+    {
+        if (errno != EAGAIN)
+        {
+            fprintf(stderr, "uart: model: pty write failed\n");
+            abort();
+        }
+        Fd.fd = s_DevFd;
+        Fd.events = POLLOUT;
+        (void)poll(&Fd, 1, 1);
+    }
+}
+
+static NvU32 ReadReg(NvU32 Addr)
+{
+    NvU32 Offset = Addr - UART_BASE;
+    NvU32 Lsr;
+
+    switch (Offset)
+    {
+        case UART_THR_DLAB_0_0:
+            s_RxValid = NV_FALSE;
+            return s_Rx;
+
+        case UART_LSR_0:
+            if (!s_RxValid && !s_RxErrors)
+                Receive();
+            Lsr = UART_LSR_0_THRE_FIELD | UART_LSR_0_TMTY_FIELD | s_RxErrors;
+            if (s_RxValid)
+                Lsr |= UART_LSR_0_RDR_FIELD;
+            s_RxErrors = 0;
+            return Lsr;
+
+        default:
+            return s_Regs[Offset / 4];
+    }
+}
+
+static void WriteReg(NvU32 Addr, NvU32 Data)
+{
+    NvU32 Offset = Addr - UART_BASE;
+
+    switch (Offset)
+    {
+        case UART_THR_DLAB_0_0:
+            Transmit((NvU8)Data);
+            break;
+
+        case UART_IIR_FCR_0:
+            if (NV_DRF_VAL(UART, IIR_FCR, RX_CLR, Data) ==
+                UART_IIR_FCR_0_RX_CLR_CLEAR)
+            {
+                s_RxValid = NV_FALSE;
+                s_Stats.RxFlushes++;
+            }
+            break;
+
+        default:
+            s_Regs[Offset / 4] = Data;
+            break;
+    }
+}
+
+static void WriteClkSource(NvU32 Addr, NvU32 Data)
+{
+    NvU32 Divisor = NO_DIVISOR;
+
+    HostRegPoke(Addr, Data);
+    if ((NV_DRF_VAL(CLK_RST_CONTROLLER, CLK_SOURCE_UARTA, UARTA_CLK_SRC,
+                    Data) == CLK_RST_CONTROLLER_CLK_SOURCE_UARTA_0_UARTA_CLK_SRC_CLK_M) &&
+        (NV_DRF_VAL(CLK_RST_CONTROLLER, CLK_SOURCE_UARTA, UARTA_DIV_ENB,
+                    Data) == CLK_RST_CONTROLLER_CLK_SOURCE_UARTA_0_UARTA_DIV_ENB_ENABLE))
+    {
+        Divisor = NV_DRF_VAL(CLK_RST_CONTROLLER, CLK_SOURCE_UARTA,
+                             UARTA_CLK_DIVISOR, Data);
+    }
+    if (Divisor != s_DevDivisor)
+    {
+        s_DevDivisor = Divisor;
+        s_Stats.DivisorChanges++;
+    }
+}
+
+void UartModelReset(const UartModelLine *pLine)
+{
+    struct termios Tio;
+
+    UartModelClose();
+    if (openpty(&s_HostFd, &s_DevFd, NULL, NULL, NULL) != 0)
+    {
+        fprintf(stderr, "uart: model: cannot open a pty\n");
+        abort();
+    }
+    tcgetattr(s_DevFd, &Tio);
+    cfmakeraw(&Tio);
+    tcsetattr(s_DevFd, TCSANOW, &Tio);
+    fcntl(s_DevFd, F_SETFL, fcntl(s_DevFd, F_GETFL) | O_NONBLOCK);
+
+    s_Line = *pLine;
+    memset(&s_Stats, 0, sizeof(s_Stats));
+    memset(s_Regs, 0, sizeof(s_Regs));
+    s_Now = (NvU64)HostClockNow() * 1000;
+    s_Rand = pLine->Seed ? pLine->Seed : 1;
+    s_DevDivisor = NO_DIVISOR;
+    s_RxValid = NV_FALSE;
+    s_RxErrors = 0;
+    s_GonePolls = 0;
+    s_HostDivisor = pLine->HostDivisor;
+    s_FlipPpm = s_OverrunPpm = 0;
+    s_HostSent = s_DevTaken = s_DevSent = s_HostTaken = 0;
+    s_HostWaiting = s_HostGone = NV_FALSE;
+
+    HostRegReset();
+    HostRegHook(UART_BASE, UART_REG_BYTES, ReadReg, WriteReg);
+    HostRegHook(UART_CLK_SOURCE, 4, NULL, WriteClkSource);
+}
+
+void UartModelClose(void)
+{
+    if (s_DevFd >= 0)
+        close(s_DevFd);
+    if (s_HostFd >= 0)
+        close(s_HostFd);
+    s_DevFd = s_HostFd = -1;
+}
+
+void UartModelSetErrors(NvU32 FlipPpm, NvU32 OverrunPpm)
+{
+    __atomic_store_n(&s_FlipPpm, FlipPpm, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_OverrunPpm, OverrunPpm, __ATOMIC_RELAXED);
+}
+
+NvU32 UartModelDivisor(void)
+{
+    return s_DevDivisor;
+}
+
+NvU32 UartModelBaud(NvU32 Divisor)
+{
+    return s_Line.OscKhz * 125 / (Divisor + 2);
+}
+
+NvU32 UartModelNow(void)
+{
+    return HostClockNow();
+}
+
+const UartModelStats *UartModelGetStats(void)
+{
+    return &s_Stats;
+}
+
+void UartModelHostSetDivisor(NvU32 Divisor)
+{
+    s_HostDivisor = Divisor;
+}
+
+void UartModelHostWrite(const void *pSrc, NvU32 Bytes)
+{
+    const NvU8 *p = pSrc;
+    NvU32 Chunk, i;
+    ssize_t n;
+
+    while (Bytes)
+    {
+        Chunk = NV_MIN(Bytes, HOST_CHUNK);
+
+        /* Counted as sent first, so the Boot ROM end never sees an idle
+         * line while the bytes are on their way. */
+        pthread_mutex_lock(&s_Lock);
+        for (i = 0; i < Chunk; i++)
+            s_ToDevTag[(s_HostSent + i) % TAG_RING] = (NvU16)s_HostDivisor;
+        s_HostSent += Chunk;
+        pthread_cond_signal(&s_HostMoved);
+        pthread_mutex_unlock(&s_Lock);
+
+        Bytes -= Chunk;
+        while (Chunk)
+        {
+            n = write(s_HostFd, p, Chunk);
+            if (n <= 0)
+                return;
+            p += n;
+            Chunk -= n;
+        }
+    }
+}
+
+NvBool UartModelHostRead(void *pDst, NvU32 Bytes)
+{
+    NvU8 *p = pDst;
+    struct pollfd Fd;
+    NvU32 Got = 0;
+    ssize_t n, i;
+
+    pthread_mutex_lock(&s_Lock);
+    s_HostWaiting = NV_TRUE;
+    pthread_cond_signal(&s_HostMoved);
+    pthread_mutex_unlock(&s_Lock);
+
+    while (Got < Bytes)
+    {
+        Fd.fd = s_HostFd;
+        Fd.events = POLLIN;
+        if (poll(&Fd, 1, HOST_TIMEOUT_MS) <= 0)
+            break;
+        n = read(s_HostFd, p + Got, Bytes - Got);
+        if (n <= 0)
+            break;
+
+        pthread_mutex_lock(&s_Lock);
+        for (i = 0; i < n; i++)
+        {
+            if (s_ToHostTag[(s_HostTaken + i) % TAG_RING] != s_HostDivisor)
+                p[Got + i] = ~p[Got + i];
+        }
+        s_HostTaken += n;
+        Got += n;
+        /* Done waiting before the last byte counts as taken. */
+        if (Got == Bytes)
+            s_HostWaiting = NV_FALSE;
+        pthread_cond_signal(&s_HostMoved);
+        pthread_mutex_unlock(&s_Lock);
+    }
+
+    pthread_mutex_lock(&s_Lock);
+    s_HostWaiting = NV_FALSE;
+    pthread_cond_signal(&s_HostMoved);
+    pthread_mutex_unlock(&s_Lock);
+    return Got == Bytes;
+}
+
+void UartModelHostHangUp(void)
+{
+    pthread_mutex_lock(&s_Lock);
+    s_HostGone = NV_TRUE;
+    pthread_cond_signal(&s_HostMoved);
+    pthread_mutex_unlock(&s_Lock);
+}
+
+/* Linked in place of NvBootUtilWaitUS(): the wait moves the model clock. */
+void __wrap_NvBootUtilWaitUS(NvU32 Us)
+{
+    Advance((NvU64)Us * 1000);
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * uart_model.h - Model of UARTA over a pty, for the host harness of the
+ * UART download.
+ *
+ * The UART registers and the UARTA clock source of the CAR are hooked in
+ * host_regs. Bytes written to THR go out on the pty; bytes the host writes
+ * to the other end are received one at a time through LSR and RBR. Each
+ * byte moves the host_clock timer by its 11-bit character time at the
+ * divisor the Boot ROM has set.
+ *
+ * Each end has its own divisor. A byte sent at one divisor and received at
+ * another is a framing error on the Boot ROM end and arrives inverted at
+ * the host end. The line can flip a bit of, or overrun, the bytes the
+ * Boot ROM receives at a given rate.
+ *
+ * The host end is driven from a thread of its own. An LSR read with
+ * nothing received waits for the host to send a byte, or to wait to read
+ * with no byte in flight either way; in the latter case it moves the timer
+ * by UART_MODEL_IDLE_US, the time of a turn of the Boot ROM polling loop.
+ * Boot ROM timeouts so run in model time, and the timer does not depend on
+ * how the threads are scheduled.
+ */
+
+#ifndef INCLUDED_UART_MODEL_H
+#define INCLUDED_UART_MODEL_H
+
+#include "nvcommon.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define UART_MODEL_IDLE_US          1
+
+typedef struct
+{
+    /* UART clock source, CLK_M, in kHz. */
+    NvU32 OscKhz;
+    /* Divisor the host starts at, in the 15.1 format of CLK_SOURCE_UARTA. */
+    NvU32 HostDivisor;
+    /* Seed of the line errors. */
+    NvU32 Seed;
+} UartModelLine;
+
+typedef struct
+{
+    NvU32 BytesToHost;
+    NvU32 BytesFromHost;
+    NvU32 FramingErrors;
+    NvU32 Overruns;
+    NvU32 Flips;
+    NvU32 RxFlushes;
+    NvU32 DivisorChanges;
+} UartModelStats;
+
+/** Opens the pty and hooks the registers. Aborts if the pty cannot be had. */
+void UartModelReset(const UartModelLine *pLine);
+
+/** Closes the pty; a host read or write blocked on it then fails. */
+void UartModelClose(void);
+
+/**
+ * Chance per byte the Boot ROM receives that one of its bits flips, and
+ * that it is lost to an overrun, in parts per million.
+ */
+void UartModelSetErrors(NvU32 FlipPpm, NvU32 OverrunPpm);
+
+/** Divisor the Boot ROM runs at, and bits/s for a divisor. */
+NvU32 UartModelDivisor(void);
+NvU32 UartModelBaud(NvU32 Divisor);
+
+/** Model time, in microseconds. */
+NvU32 UartModelNow(void);
+
+const UartModelStats *UartModelGetStats(void);
+
+/* Host end, from the host thread. */
+void UartModelHostSetDivisor(NvU32 Divisor);
+void UartModelHostWrite(const void *pSrc, NvU32 Bytes);
+/** Fails if the Boot ROM sends nothing for a few seconds of host time. */
+NvBool UartModelHostRead(void *pDst, NvU32 Bytes);
+/** Ends the host; the Boot ROM end aborts if it then waits on a byte. */
+void UartModelHostHangUp(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // INCLUDED_UART_MODEL_H
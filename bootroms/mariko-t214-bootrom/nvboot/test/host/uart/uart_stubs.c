@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * uart_stubs.c - The functions nvboot_uart.c and nvboot_uart_boot.c reach
+ * that the harness never runs: the fast UART strap setup on PLLC4, the
+ * stack switch of NvBootUartDownload() and the exception path. Reaching
+ * any of these aborts.
+ *
+ * The symbols are defined without their headers, so that one macro fits
+ * all of them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MODEL_STUB(Name)                                        \
+    void Name(void)                                             \
+    {                                                           \
+        fprintf(stderr, "uart: %s called\n", #Name);            \
+        abort();                                                \
+    }
+
+MODEL_STUB(NvBootClocksGetPllMiscParams)
+MODEL_STUB(NvBootClocksIsPllC4Stable)
+MODEL_STUB(NvBootClocksStartPllC4)
+MODEL_STUB(NvBootUartSetupStack)
+MODEL_STUB(do_exception)
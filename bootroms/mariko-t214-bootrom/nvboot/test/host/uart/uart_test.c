@@ -0,0 +1,734 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of the UART download, io/uart/nvboot_uart_boot.c over the
+ * driver of io/uart/nvboot_uart.c, both built unchanged over the pty model
+ * of uart_model.c.
+ *
+ * Each session runs NvBootUartDownload_internal() until it jumps to the
+ * image, which NvBootUartJump() here turns into a longjmp back to the
+ * session. A host thread on the other end of the pty reads each prompt and
+ * makes the attempts of the session in turn: the legacy protocol, or the
+ * block protocol of nvboot_uart_int.h with its step-up, frames, CRC32s and
+ * resends. Every attempt but the last is expected to fail, and the host
+ * then expects "Fail" at 115200 before the next prompt.
+ *
+ * "check" checks the CRC32 and the divisor search of nvboot_uart.c on
+ * their own, then runs sessions for each step of the block protocol:
+ * rates, lengths around the block size and IRAM, rejected requests, bit
+ * flips, overruns, a stalled and a reordered frame, a download that runs
+ * out of passes, and the unique id of failure analysis mode. "bench"
+ * prints the model time of a 200 KB image with the legacy protocol and
+ * with the block protocol at several rates and line error rates.
+ */
+
+#include <pthread.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/mman.h>
+
+#include "nvboot_bit.h"
+#include "nvboot_config.h"
+#include "nvboot_clocks_int.h"
+#include "nvboot_error.h"
+#include "nvboot_fuse_int.h"
+#include "nvboot_reset_int.h"
+#include "nvboot_uart_int.h"
+#include "nvboot_version_defs.h"
+#include "arapb_misc.h"
+#include "host_clock.h"
+#include "host_regs.h"
+#include "uart_model.h"
+
+/* IRAM, which the harness maps at its address. */
+#define IRAM_START          NV_ADDRESS_MAP_IRAM_A_BASE
+#define IRAM_BYTES          (NV_ADDRESS_MAP_IRAM_D_LIMIT + 1 - IRAM_START)
+/* Where the Makefile places BootConfigTable, and the room after it. */
+#define IRAM_BCT            (IRAM_START + 0x700)
+#define MAX_LENGTH          ((NVBOOT_BL_IRAM_END - 0x2000) - IRAM_BCT)
+#define MAX_BLOCK_LENGTH    NV_MIN(MAX_LENGTH - sizeof(NvBootUart_Header), \
+                                   NVBOOT_UART_BLOCK_MAX_BLOCKS *          \
+                                   NVBOOT_UART_BLOCK_SIZE)
+
+#define OSC_FREQ            NvBootClocksOscFreq_38_4
+#define OSC_KHZ             38400
+#define DIVISOR_115200      39
+#define MAX_ATTEMPTS        4
+#define BENCH_LENGTH        (200 * 1024)
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "uart: %s:%d: %s\n", __FILE__, __LINE__,    \
+                    #Cond);                                             \
+        }                                                               \
+    } while (0)
+
+typedef enum
+{
+    Fault_None,
+    /* A request whose CRC32 does not match. */
+    Fault_RequestCrc,
+    /* A legacy image whose checksum does not match. */
+    Fault_Checksum,
+    /* Half a frame, then nothing until the next status. */
+    Fault_Stall,
+    /* The second missing block sent first. */
+    Fault_Order,
+    /* A header with another unique id. */
+    Fault_Uid,
+} Fault;
+
+typedef struct
+{
+    NvBool Block;
+    NvU32 Length;
+    /* Rate requested by a block mode attempt. */
+    NvU32 BaudRate;
+    /* Line errors while the frames are sent, in parts per million. */
+    NvU32 FlipPpm;
+    NvU32 OverrunPpm;
+    /* On the first pass only. */
+    Fault Fault;
+} Attempt;
+
+typedef struct
+{
+    const char *Name;
+    Attempt Attempts[MAX_ATTEMPTS];
+    NvU32 NumAttempts;
+    NvBool FailureAnalysis;
+} Session;
+
+/* What the host saw of an attempt. */
+typedef struct
+{
+    NvBootUart_BlockReply Reply;
+    /* Passes of frames sent, and the frames in them. */
+    NvU32 Passes;
+    NvU32 Frames;
+    NvBool Done;
+} AttemptResult;
+
+/* Defined by the Boot ROM proper, which the harness does not build. */
+NvBootInfoTable BootInfoTable;
+
+NvU32 NvBootBootromVersionAddress[3] =
+{
+    CONST_NVBOOT_BOOTROM_VERSION,
+    CONST_NVBOOT_RCM_VERSION,
+    CONST_NVBOOT_BOOTDATA_VERSION
+};
+
+static const NvBootECID s_Ecid = { 0x11223344, 0x55667788, 0x99aabbcc, 0x0d };
+
+static const Session *s_Session;
+static NvBool s_FailureAnalysis;
+static AttemptResult s_Results[MAX_ATTEMPTS];
+static jmp_buf s_Jump;
+static uintptr_t s_JumpTarget;
+
+static NvU8 s_Image[MAX_LENGTH];
+static NvU8 *const s_Iram = (NvU8 *)IRAM_START;
+
+void NvBootUartDownload_internal(NvBootClocksOscFreq OscFreq);
+
+void NvBootUartJump(uintptr_t TargetAddress)
+{
+    s_JumpTarget = TargetAddress;
+    longjmp(s_Jump, 1);
+}
+
+NvBool NvBootFuseIsFailureAnalysisMode(void)
+{
+    return s_FailureAnalysis;
+}
+
+NvBool NvBootFuseIsPreproductionMode(void)
+{
+    return !s_FailureAnalysis;
+}
+
+void NvBootFuseGetUniqueId(NvBootECID *pId)
+{
+    *pId = s_Ecid;
+}
+
+/* The model does not gate the UART on its clock or reset. */
+void NvBootClocksSetEnable(NvBootClocksClockId ClockId, NvBool Enable)
+{
+}
+
+void NvBootResetSetEnable(const NvBootResetDeviceId DeviceId,
+                          const NvBool Enable)
+{
+}
+
+static void MapIram(void)
+{
+    void *p = mmap((void *)IRAM_START, IRAM_BYTES, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if (p != (void *)IRAM_START)
+    {
+        fprintf(stderr, "uart: cannot map IRAM at 0x%x\n", IRAM_START);
+        exit(1);
+    }
+}
+
+/* Bitwise CRC32, as zlib's crc32() computes it. */
+static NvU32 Crc32(NvU32 Crc, const void *pData, NvU32 Bytes)
+{
+    const NvU8 *p = pData;
+    NvU32 i;
+
+    Crc = ~Crc;
+    while (Bytes--)
+    {
+        Crc ^= *p++;
+        for (i = 0; i < 8; i++)
+            Crc = (Crc >> 1) ^ (0xEDB88320 & -(Crc & 1));
+    }
+    return ~Crc;
+}
+
+static void BuildImage(NvU32 Length)
+{
+    NvU32 i;
+
+    for (i = 0; i < Length; i++)
+        s_Image[i] = rand();
+}
+
+static NvBool HostExpect(const void *pText, NvU32 Bytes)
+{
+    NvU8 Got[32];
+
+    return UartModelHostRead(Got, Bytes) && !memcmp(Got, pText, Bytes);
+}
+
+static NvBool HostPrompt(void)
+{
+    char Prompt[27];
+
+    snprintf(Prompt, sizeof(Prompt), "\n\rNV Boot T214 %04X.%04X\n\r",
+             CONST_NVBOOT_BOOTROM_VERSION >> 16,
+             CONST_NVBOOT_BOOTROM_VERSION & 0xffff);
+    return HostExpect(Prompt, 26);
+}
+
+static void HostHeader(const Attempt *pAttempt, NvBootUart_Header *pHeader)
+{
+    memset(pHeader, 0, sizeof(*pHeader));
+    pHeader->EntryInstruction = 0xea000000;
+    pHeader->UniqueId0 = s_Ecid.ECID_0;
+    pHeader->UniqueId1 = s_Ecid.ECID_1;
+    pHeader->UniqueId2 = s_Ecid.ECID_2;
+    pHeader->UniqueId3 = s_Ecid.ECID_3;
+    if (pAttempt->Fault == Fault_Uid)
+        pHeader->UniqueId3 ^= 1;
+}
+
+static NvBool HostLegacy(const Attempt *pAttempt)
+{
+    NvBootUart_Header Header;
+    NvU32 Checksum = 0;
+    NvU32 i;
+
+    HostHeader(pAttempt, &Header);
+    Header.MainLength = pAttempt->Length + sizeof(Checksum);
+    for (i = 0; i < sizeof(Header); i++)
+        Checksum += ((NvU8 *)&Header)[i];
+    for (i = 0; i < pAttempt->Length; i++)
+        Checksum += s_Image[i];
+    Checksum = ~Checksum;
+    if (pAttempt->Fault == Fault_Checksum)
+        Checksum ^= 1;
+
+    UartModelHostWrite(&Header, sizeof(Header));
+    UartModelHostWrite(s_Image, pAttempt->Length);
+    UartModelHostWrite(&Checksum, sizeof(Checksum));
+    return NV_TRUE;
+}
+
+static void HostFrame(NvU32 Index, NvU32 Length, NvBool Half)
+{
+    NvU32 Offset = Index * NVBOOT_UART_BLOCK_SIZE;
+    NvU32 Bytes = NV_MIN(Length - Offset, NVBOOT_UART_BLOCK_SIZE);
+    NvU32 Crc;
+
+    Crc = Crc32(Crc32(0, &Index, sizeof(Index)), s_Image + Offset, Bytes);
+    UartModelHostWrite(&Index, sizeof(Index));
+    if (Half)
+    {
+        UartModelHostWrite(s_Image + Offset, Bytes / 2);
+        return;
+    }
+    UartModelHostWrite(s_Image + Offset, Bytes);
+    UartModelHostWrite(&Crc, sizeof(Crc));
+}
+
+static NvBool IsMissing(const NvBootUart_BlockStatus *pStatus, NvU32 Index)
+{
+    return (pStatus->Missing[Index >> 5] >> (Index & 31)) & 1;
+}
+
+/*
+ * The host side of a block mode attempt. Returns NV_FALSE if the host
+ * cannot go on; pResult->Done tells whether the download went through.
+ */
+static NvBool HostBlock(const Attempt *pAttempt, AttemptResult *pResult)
+{
+    NvBootUart_Header Header;
+    NvBootUart_BlockRequest Request;
+    NvBootUart_BlockReply *pReply = &pResult->Reply;
+    NvBootUart_BlockStatus Status;
+    NvU32 Index, First, Second;
+    Fault Fault = pAttempt->Fault;
+
+    HostHeader(pAttempt, &Header);
+    Header.MainLength = NVBOOT_UART_BLOCK_MODE_FLAG | pAttempt->Length;
+    Request.Magic = NVBOOT_UART_BLOCK_MAGIC;
+    Request.BaudRate = pAttempt->BaudRate;
+    Request.Crc32 = Crc32(Crc32(0, &Header, sizeof(Header)), &Request,
+                          offsetof(NvBootUart_BlockRequest, Crc32));
+    if (Fault == Fault_RequestCrc)
+        Request.Crc32 ^= 1;
+    UartModelHostWrite(&Header, sizeof(Header));
+    UartModelHostWrite(&Request, sizeof(Request));
+
+    CHECK(UartModelHostRead(pReply, sizeof(*pReply)));
+    CHECK(pReply->Magic == NVBOOT_UART_BLOCK_MAGIC);
+    CHECK(pReply->Crc32 == Crc32(0, pReply,
+                                 offsetof(NvBootUart_BlockReply, Crc32)));
+    if (pReply->Status != NVBOOT_UART_BLOCK_ACK)
+        return NV_TRUE;
+    if (pReply->ClockDivisor != NVBOOT_UART_BLOCK_KEEP_BAUD)
+        UartModelHostSetDivisor(pReply->ClockDivisor);
+    UartModelSetErrors(pAttempt->FlipPpm, pAttempt->OverrunPpm);
+
+    for (;;)
+    {
+        if (!UartModelHostRead(&Status, sizeof(Status)))
+            return NV_FALSE;
+        CHECK(Status.Magic == NVBOOT_UART_BLOCK_MAGIC);
+        CHECK(Status.Crc32 == Crc32(0, &Status,
+                                    offsetof(NvBootUart_BlockStatus, Crc32)));
+        if (Status.NumMissing == 0)
+        {
+            pResult->Done = NV_TRUE;
+            break;
+        }
+        if (pResult->Passes == NVBOOT_UART_BLOCK_MAX_PASSES)
+            break;
+        pResult->Passes++;
+
+        First = Second = pReply->NumBlocks;
+        for (Index = 0; Index < pReply->NumBlocks; Index++)
+        {
+            if (!IsMissing(&Status, Index))
+                continue;
+            if (First == pReply->NumBlocks)
+                First = Index;
+            else if (Second == pReply->NumBlocks)
+                Second = Index;
+        }
+
+        for (Index = 0; Index < pReply->NumBlocks; Index++)
+        {
+            if (!IsMissing(&Status, Index))
+                continue;
+            if ((Fault == Fault_Order) && (Index == First) &&
+                (Second < pReply->NumBlocks))
+            {
+                HostFrame(Second, pAttempt->Length, NV_FALSE);
+                pResult->Frames++;
+            }
+            if ((Fault == Fault_Order) && (Index == Second))
+                continue;
+            HostFrame(Index, pAttempt->Length, Fault == Fault_Stall);
+            pResult->Frames++;
+            if (Fault == Fault_Stall)
+                break;
+        }
+        Fault = Fault_None;
+    }
+
+    UartModelSetErrors(0, 0);
+    return NV_TRUE;
+}
+
+static void *HostThread(void *Arg)
+{
+    const Attempt *pAttempt;
+    AttemptResult *pResult;
+    NvBool Last, Ok;
+    NvU32 i;
+
+    for (i = 0; i < s_Session->NumAttempts; i++)
+    {
+        pAttempt = &s_Session->Attempts[i];
+        pResult = &s_Results[i];
+        Last = (i == s_Session->NumAttempts - 1);
+
+        /* A failed attempt is reported at 115200, whatever its rate. */
+        if (i > 0)
+        {
+            UartModelHostSetDivisor(DIVISOR_115200);
+            if (!HostExpect("Fail\n\r", 6))
+                break;
+        }
+        if (!HostPrompt())
+            break;
+
+        BuildImage(pAttempt->Length);
+        if (pAttempt->Block)
+        {
+            Ok = HostBlock(pAttempt, pResult);
+        }
+        else
+        {
+            UartModelSetErrors(pAttempt->FlipPpm, pAttempt->OverrunPpm);
+            Ok = HostLegacy(pAttempt);
+            pResult->Done = Last;
+        }
+        if (!Ok)
+            break;
+        if (Last && pResult->Done && HostExpect("Boot\n\r", 6))
+            i++;
+        if (Last)
+            break;
+    }
+
+    if (i < s_Session->NumAttempts)
+    {
+        fprintf(stderr, "uart: %s: the host stopped at attempt %u\n",
+                s_Session->Name, i);
+        CHECK(!"host attempts");
+    }
+    UartModelHostHangUp();
+    return NULL;
+}
+
+/*
+ * Runs a session to the jump to the image. Returns the model time it took,
+ * in microseconds.
+ */
+static NvU32 RunSession(const Session *pSession, NvU32 Seed)
+{
+    const Attempt *pLast = &pSession->Attempts[pSession->NumAttempts - 1];
+    UartModelLine Line;
+    pthread_t Host;
+
+    s_Session = pSession;
+    s_FailureAnalysis = pSession->FailureAnalysis;
+    memset(s_Results, 0, sizeof(s_Results));
+    memset(s_Iram, 0, IRAM_BYTES);
+    memset(&BootInfoTable, 0, sizeof(BootInfoTable));
+    s_JumpTarget = 0;
+
+    HostClockInit();
+    Line.OscKhz = OSC_KHZ;
+    Line.HostDivisor = DIVISOR_115200;
+    Line.Seed = Seed;
+    UartModelReset(&Line);
+
+    pthread_create(&Host, NULL, HostThread, NULL);
+    if (!setjmp(s_Jump))
+        NvBootUartDownload_internal(OSC_FREQ);
+    pthread_join(Host, NULL);
+    UartModelClose();
+
+    CHECK(s_JumpTarget == IRAM_BCT);
+    CHECK(!memcmp(s_Iram + (IRAM_BCT - IRAM_START) + sizeof(NvBootUart_Header),
+                  s_Image, pLast->Length));
+    CHECK(BootInfoTable.BootType == NvBootType_Uart);
+    CHECK(BootInfoTable.SafeStartAddr == IRAM_BCT);
+    return UartModelNow();
+}
+
+static void CheckCrc32(void)
+{
+    static const NvU8 Digits[] = "123456789";
+    NvU8 Buffer[1000];
+    NvU32 i, Split;
+
+    CHECK(NvBootUartCrc32(0, Digits, 9) == 0xCBF43926);
+    for (i = 0; i < sizeof(Buffer); i++)
+        Buffer[i] = rand();
+    for (Split = 0; Split <= sizeof(Buffer); Split += 111)
+    {
+        CHECK(NvBootUartCrc32(NvBootUartCrc32(0, Buffer, Split),
+                              Buffer + Split, sizeof(Buffer) - Split) ==
+              Crc32(0, Buffer, sizeof(Buffer)));
+    }
+}
+
+/* Each rate found is the fastest not above the request, but not below 115200. */
+static void CheckDivisor(void)
+{
+    static const NvBootClocksOscFreq Freqs[] =
+    {
+        NvBootClocksOscFreq_13, NvBootClocksOscFreq_16_8,
+        NvBootClocksOscFreq_19_2, NvBootClocksOscFreq_38_4,
+        NvBootClocksOscFreq_12, NvBootClocksOscFreq_48,
+        NvBootClocksOscFreq_26
+    };
+    static const NvU32 Rates[] =
+    {
+        9600, 115200, 230400, 460800, 921600, 1000000, 1500000, 3000000,
+        4000000, 12000000
+    };
+    NvU32 f, r, Divisor, Slowest, OscKhz, Baud;
+    NvU32 Strap;
+
+    HostRegReset();
+    for (f = 0; f < sizeof(Freqs) / sizeof(Freqs[0]); f++)
+    {
+        CHECK(NvBootUartFindClockDivisor(Freqs[f], 115200, &Slowest,
+                                         &OscKhz) == NvBootError_Success);
+        Baud = OscKhz * 125 / (Slowest + 2);
+        CHECK((Baud > 115200 * 95 / 100) && (Baud < 115200 * 105 / 100));
+
+        for (r = 0; r < sizeof(Rates) / sizeof(Rates[0]); r++)
+        {
+            CHECK(NvBootUartFindClockDivisor(Freqs[f], Rates[r], &Divisor,
+                                             &OscKhz) == NvBootError_Success);
+            CHECK(Divisor <= Slowest);
+            CHECK((Divisor == Slowest) ||
+                  (OscKhz * 125 <= Rates[r] * (Divisor + 2)));
+            CHECK((Divisor == 0) ||
+                  (OscKhz * 125 > Rates[r] * (Divisor + 1)));
+        }
+    }
+
+    CHECK(NvBootUartFindClockDivisor(2, 115200, &Divisor, &OscKhz) ==
+          NvBootError_IllegalParameter);
+    CHECK(NvBootUartFindClockDivisor(OSC_FREQ, 0, &Divisor, &OscKhz) ==
+          NvBootError_IllegalParameter);
+    CHECK(NvBootUartFindClockDivisor(NvBootClocksOscFreq_MaxVal, 115200,
+                                     &Divisor, &OscKhz) ==
+          NvBootError_InvalidOscFrequency);
+
+    /* The fast UART strap keeps its own 12 Mbaud setup. */
+    Strap = NV_DRF_DEF(APB_MISC_PP, STRAPPING_OPT_A, BOOT_FAST_UART, FAST);
+    HostRegPoke(NV_ADDRESS_MAP_APB_MISC_BASE + APB_MISC_PP_STRAPPING_OPT_A_0,
+                Strap);
+    CHECK(NvBootUartFindClockDivisor(OSC_FREQ, 3000000, &Divisor, &OscKhz) ==
+          NvBootError_DeviceUnsupported);
+    HostRegReset();
+}
+
+#define LEGACY(Length, Fault)                                           \
+    { NV_FALSE, (Length), 0, 0, 0, (Fault) }
+#define BLOCK(Length, Baud, Flip, Overrun, Fault)                       \
+    { NV_TRUE, (Length), (Baud), (Flip), (Overrun), (Fault) }
+
+static void CheckSessions(void)
+{
+    static const Session Sessions[] =
+    {
+        { "legacy", { LEGACY(5000, Fault_None) }, 1 },
+        { "legacy checksum",
+          { LEGACY(5000, Fault_Checksum), LEGACY(5000, Fault_None) }, 2 },
+        { "115200", { BLOCK(10000, 0, 0, 0, Fault_None) }, 1 },
+        { "below 115200", { BLOCK(10000, 9600, 0, 0, Fault_None) }, 1 },
+        { "960000", { BLOCK(50000, 1000000, 0, 0, Fault_None) }, 1 },
+        { "2.4M", { BLOCK(200 * 1024, 3000000, 0, 0, Fault_None) }, 1 },
+        { "1 byte", { BLOCK(1, 3000000, 0, 0, Fault_None) }, 1 },
+        { "5 bytes", { BLOCK(5, 3000000, 0, 0, Fault_None) }, 1 },
+        { "block - 1",
+          { BLOCK(NVBOOT_UART_BLOCK_SIZE - 1, 3000000, 0, 0, Fault_None) }, 1 },
+        { "block",
+          { BLOCK(NVBOOT_UART_BLOCK_SIZE, 3000000, 0, 0, Fault_None) }, 1 },
+        { "block + 1",
+          { BLOCK(NVBOOT_UART_BLOCK_SIZE + 1, 3000000, 0, 0, Fault_None) }, 1 },
+        { "2 blocks",
+          { BLOCK(2 * NVBOOT_UART_BLOCK_SIZE, 3000000, 0, 0, Fault_None) }, 1 },
+        { "longest",
+          { BLOCK(MAX_BLOCK_LENGTH, 3000000, 0, 0, Fault_None) }, 1 },
+        { "too long",
+          { BLOCK(MAX_BLOCK_LENGTH + 1, 3000000, 0, 0, Fault_None),
+            BLOCK(0, 3000000, 0, 0, Fault_None),
+            BLOCK(1000, 3000000, 0, 0, Fault_None) }, 3 },
+        { "request CRC",
+          { BLOCK(10000, 3000000, 0, 0, Fault_RequestCrc),
+            BLOCK(10000, 3000000, 0, 0, Fault_None) }, 2 },
+        { "flips",
+          { BLOCK(200 * 1024, 3000000, 100, 0, Fault_None) }, 1 },
+        { "overruns",
+          { BLOCK(200 * 1024, 3000000, 0, 10, Fault_None) }, 1 },
+        { "stall",
+          { BLOCK(50000, 3000000, 0, 0, Fault_Stall) }, 1 },
+        { "order",
+          { BLOCK(50000, 3000000, 0, 0, Fault_Order) }, 1 },
+        { "out of passes",
+          { BLOCK(50000, 3000000, 3000, 0, Fault_None),
+            LEGACY(5000, Fault_None) }, 2 },
+        { "unique id",
+          { BLOCK(10000, 3000000, 0, 0, Fault_Uid),
+            BLOCK(10000, 3000000, 0, 0, Fault_None) }, 2, NV_TRUE },
+    };
+    const UartModelStats *pStats = UartModelGetStats();
+    const Session *pSession;
+    const Attempt *pAttempt;
+    const AttemptResult *pResult;
+    NvU32 s, a, Us, Blocks;
+
+    for (s = 0; s < sizeof(Sessions) / sizeof(Sessions[0]); s++)
+    {
+        pSession = &Sessions[s];
+        Us = RunSession(pSession, s + 1);
+
+        for (a = 0; a < pSession->NumAttempts; a++)
+        {
+            pAttempt = &pSession->Attempts[a];
+            pResult = &s_Results[a];
+            if (!pAttempt->Block)
+                continue;
+
+            Blocks = (pAttempt->Length + NVBOOT_UART_BLOCK_SIZE - 1) /
+                     NVBOOT_UART_BLOCK_SIZE;
+            if ((Blocks == 0) || (pAttempt->Length > MAX_BLOCK_LENGTH) ||
+                (pAttempt->Fault == Fault_RequestCrc))
+            {
+                CHECK(pResult->Reply.Status == NVBOOT_UART_BLOCK_NAK);
+                continue;
+            }
+            CHECK(pResult->Reply.Status == NVBOOT_UART_BLOCK_ACK);
+            CHECK(pResult->Reply.NumBlocks == Blocks);
+            if (pAttempt->BaudRate == 0)
+            {
+                CHECK(pResult->Reply.ClockDivisor ==
+                      NVBOOT_UART_BLOCK_KEEP_BAUD);
+                CHECK(pResult->Reply.OscKhz == 0);
+            }
+            else
+            {
+                CHECK(pResult->Reply.OscKhz == OSC_KHZ);
+                CHECK(UartModelBaud(pResult->Reply.ClockDivisor) <=
+                      NV_MAX(pAttempt->BaudRate,
+                             UartModelBaud(DIVISOR_115200)));
+            }
+
+            /* A clean line takes one pass, and a bad frame one more. */
+            if ((pAttempt->FlipPpm == 0) && (pAttempt->OverrunPpm == 0))
+            {
+                CHECK(pResult->Done);
+                CHECK(pResult->Passes ==
+                      (((pAttempt->Fault == Fault_Stall) ||
+                        (pAttempt->Fault == Fault_Order)) ? 2 : 1));
+            }
+        }
+
+        pResult = &s_Results[pSession->NumAttempts - 1];
+        pAttempt = &pSession->Attempts[pSession->NumAttempts - 1];
+        if (!strcmp(pSession->Name, "2.4M"))
+        {
+            CHECK(pResult->Reply.ClockDivisor == 0);
+            CHECK(UartModelDivisor() == 0);
+            CHECK(pResult->Frames == 50);
+            CHECK(pStats->FramingErrors == 0);
+        }
+        if (!strcmp(pSession->Name, "below 115200"))
+            CHECK(pResult->Reply.ClockDivisor == DIVISOR_115200);
+        if (!strcmp(pSession->Name, "960000"))
+            CHECK(UartModelBaud(pResult->Reply.ClockDivisor) == 960000);
+        if (!strcmp(pSession->Name, "flips"))
+        {
+            CHECK(pStats->Flips != 0);
+            CHECK(pResult->Passes > 1);
+            CHECK(pResult->Frames > 50);
+        }
+        if (!strcmp(pSession->Name, "overruns"))
+        {
+            CHECK(pStats->Overruns != 0);
+            CHECK(pResult->Passes > 1);
+        }
+        /* The stalled frame times out after half a second. */
+        if (!strcmp(pSession->Name, "stall"))
+            CHECK(Us > 500000);
+        if (!strcmp(pSession->Name, "out of passes"))
+            CHECK(s_Results[0].Passes == NVBOOT_UART_BLOCK_MAX_PASSES);
+    }
+}
+
+static int Check(void)
+{
+    CheckCrc32();
+    CheckDivisor();
+    CheckSessions();
+
+    printf("uart: %u checks, %u failures\n", s_Cases, s_Failures);
+    return s_Failures != 0;
+}
+
+/* Model time of one image, legacy and block mode at several rates. */
+static int Bench(void)
+{
+    static const Session Sessions[] =
+    {
+        { "legacy", { LEGACY(BENCH_LENGTH, Fault_None) }, 1 },
+        { "block", { BLOCK(BENCH_LENGTH, 0, 0, 0, Fault_None) }, 1 },
+        { "block", { BLOCK(BENCH_LENGTH, 1000000, 0, 0, Fault_None) }, 1 },
+        { "block", { BLOCK(BENCH_LENGTH, 3000000, 0, 0, Fault_None) }, 1 },
+        { "block", { BLOCK(BENCH_LENGTH, 3000000, 10, 0, Fault_None) }, 1 },
+        { "block", { BLOCK(BENCH_LENGTH, 3000000, 100, 0, Fault_None) }, 1 },
+        { "block", { BLOCK(BENCH_LENGTH, 3000000, 0, 10, Fault_None) }, 1 },
+        { "block", { BLOCK(BENCH_LENGTH, 3000000, 100, 10, Fault_None) }, 1 },
+    };
+    const Attempt *pAttempt;
+    const AttemptResult *pResult = &s_Results[0];
+    NvU32 s, Us, Divisor;
+    unsigned Failures = s_Failures;
+
+    printf("uart: %u-byte image, %u kHz oscillator, model time\n",
+           BENCH_LENGTH, OSC_KHZ);
+    printf("  %-7s %8s %7s %7s %9s %7s %7s %7s\n", "mode", "baud",
+           "flip", "overrun", "seconds", "KB/s", "passes", "resent");
+    for (s = 0; s < sizeof(Sessions) / sizeof(Sessions[0]); s++)
+    {
+        pAttempt = &Sessions[s].Attempts[0];
+        Us = RunSession(&Sessions[s], s + 1);
+        if (s_Failures != Failures)
+        {
+            fprintf(stderr, "uart: %s download failed\n", Sessions[s].Name);
+            return 1;
+        }
+        Divisor = DIVISOR_115200;
+        if (pAttempt->Block &&
+            (pResult->Reply.ClockDivisor != NVBOOT_UART_BLOCK_KEEP_BAUD))
+            Divisor = pResult->Reply.ClockDivisor;
+        printf("  %-7s %8u %5uppm %5uppm %9.2f %7.1f %7u %7u\n",
+               Sessions[s].Name, UartModelBaud(Divisor), pAttempt->FlipPpm,
+               pAttempt->OverrunPpm, Us / 1e6,
+               BENCH_LENGTH / 1024.0 / (Us / 1e6), pResult->Passes,
+               pAttempt->Block ? pResult->Frames - pResult->Reply.NumBlocks : 0);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    MapIram();
+    if ((argc > 1) && !strcmp(argv[1], "bench"))
+        return Bench();
+    return Check();
+}
@@ -0,0 +1,586 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * usb3_model.c - Model of the XUSB host controller BI queues. See
+ * usb3_model.h.
+ *
+ * The model counts as errors what the driver must never make the
+ * controller do: ring the doorbell with no transfer set up or with the
+ * work queue half written, overflow a queue, write a queue control
+ * register other than as a read-modify-write, as the hardware updates it
+ * meanwhile, or reach a CSB register the model does not know; and what it must never make the mass storage device
+ * see: a TRB over 64 KiB or across a 64 KiB boundary, a packet split
+ * between TRBs, a bulk IN after the CSW, a CBW out of turn or not matching its command, or a bulk
+ * sequence number that was not carried over.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "nvcommon.h"
+#include "nvboot_usb3_context.h"
+#include "nvboot_usb3_local.h"
+#include "ardev_t_xusb_csb.h"
+#include "ardev_t_fpci_xusb_0.h"
+#include "host_clock.h"
+#include "host_regs.h"
+#include "usb3_model.h"
+
+#define CFG_BYTES           0x1000
+#define CSB_PAGE_BYTES      0x200
+#define BI_COUNT            2
+#define BI_STRIDE           0x200
+
+#define CNTRL_VALID         (1 << 0)
+#define CNTRL_POP           (1 << 1)
+/* DWRD0 of an empty queue. */
+#define EMPTY_DWRD0         0xffffffff
+/* s_LastCsbRead after a CSB write. */
+#define NO_CSB_READ         0xffffffff
+
+/* As the bulk-only device decodes them. */
+#define CBW_BYTES           31
+#define CSW_BYTES           13
+#define CBW_SIGNATURE       0x43425355
+#define CSW_SIGNATURE       0x53425355
+#define SCSI_READ10         0x28
+#define SCSI_READ16         0x88
+#define TRB_BOUNDARY        0x10000
+#define MAX_PACKET          512
+#define SEQNUM_COUNT        32
+
+typedef enum
+{
+    Msc_Cbw,
+    Msc_Data,
+    Msc_Csw,
+} MscStep;
+
+typedef struct
+{
+    NvU32 Due;
+    NvU32 Dwrd[4];
+} QueueEntry;
+
+typedef struct
+{
+    QueueEntry Entries[USB3_MODEL_QUEUE_ENTRIES];
+    /* Free running; the ring index is taken modulo its size. */
+    NvU32 Head;
+    NvU32 Tail;
+} Queue;
+
+typedef struct
+{
+    NvU32 WorkQ[3];
+    NvBool KindWritten;
+    Queue CompQ;
+} BusInstance;
+
+static Usb3ModelStats s_Stats;
+static NvU32 s_Page;
+/* CSB register of the last CSB access, if it was a read. */
+static NvU32 s_LastCsbRead;
+
+static BusInstance s_Bi[BI_COUNT];
+static Queue s_EventQ;
+static NvU32 s_LastBi;
+
+static Usb3ModelTransfer s_Next;
+static NvBool s_NextQueued;
+
+static NvBool s_MscAttached;
+static MscStep s_MscStep;
+static NvU32 s_MscTag;
+static NvU64 s_MscOffset;
+static NvU64 s_MscLeft;
+/* Bytes of the command's data stage the device does not send. */
+static NvU32 s_MscResidue;
+/* Set by Usb3ModelMscEndDataEarly() for the next command. */
+static NvBool s_MscEndEarly;
+static NvU32 s_MscEndAfter;
+static NvBool s_MscSeeking;
+/* Sequence number of bulk OUT and bulk IN after their last transfer. */
+static NvU32 s_MscSeqNum[2];
+
+/* Completion status not yet written to the endpoint context. */
+static EP *s_Ep;
+static NvBool s_EpPending;
+static NvU32 s_EpDue;
+static NvU32 s_EpStatus;
+static NvU32 s_EpSeqNum;
+static NvU32 s_EpBytes;
+
+static void ModelError(const char *What)
+{
+    s_Stats.Errors++;
+    fprintf(stderr, "usb3: model: %s\n", What);
+}
+
+static NvU32 Later(NvU32 From, NvU32 Us)
+{
+    if ((From == USB3_MODEL_NEVER) || (Us == USB3_MODEL_NEVER) ||
+        (Us >= USB3_MODEL_NEVER - From))
+        return USB3_MODEL_NEVER;
+    return From + Us;
+}
+
+static void Post(Queue *pQ, NvU32 Due, const NvU32 *pDwrd)
+{
+    QueueEntry *pEntry;
+
+    if (Due == USB3_MODEL_NEVER)
+        return;
+    if (pQ->Tail - pQ->Head == USB3_MODEL_QUEUE_ENTRIES)
+    {
+        ModelError("queue overflow");
+        return;
+    }
+    pEntry = &pQ->Entries[pQ->Tail % USB3_MODEL_QUEUE_ENTRIES];
+    pEntry->Due = Due;
+    memcpy(pEntry->Dwrd, pDwrd, sizeof(pEntry->Dwrd));
+    pQ->Tail++;
+}
+
+static const QueueEntry *Head(const Queue *pQ)
+{
+    const QueueEntry *pEntry;
+
+    if (pQ->Head == pQ->Tail)
+        return NULL;
+    pEntry = &pQ->Entries[pQ->Head % USB3_MODEL_QUEUE_ENTRIES];
+    return (pEntry->Due <= HostClockNow()) ? pEntry : NULL;
+}
+
+static void Pop(Queue *pQ, NvU32 *pPops)
+{
+    if (Head(pQ) == NULL)
+    {
+        s_Stats.EmptyPops++;
+        return;
+    }
+    pQ->Head++;
+    (*pPops)++;
+}
+
+/* Writes the completion to the endpoint context once it is due. */
+static void Update(void)
+{
+    if (s_EpPending && (s_EpDue <= HostClockNow()))
+    {
+        s_Ep->EpDw5.SEQNUM = s_EpSeqNum;
+        s_Ep->EpDw5.EDTLA = s_EpBytes;
+        s_Ep->EpDw6.Status = s_EpStatus;
+        s_EpPending = NV_FALSE;
+    }
+}
+
+static NvU32 Be32(const NvU8 *p)
+{
+    return ((NvU32)p[0] << 24) | ((NvU32)p[1] << 16) |
+           ((NvU32)p[2] << 8) | p[3];
+}
+
+static NvBool MscCommand(const NvU8 *pCbw, NvU32 Bytes)
+{
+    const NvU8 *pCb = pCbw + 15;
+    NvU32 Signature, DataLength;
+
+    memcpy(&Signature, pCbw, 4);
+    memcpy(&s_MscTag, pCbw + 4, 4);
+    memcpy(&DataLength, pCbw + 8, 4);
+    if ((Bytes != CBW_BYTES) || (Signature != CBW_SIGNATURE))
+    {
+        ModelError("CBW not valid");
+        return NV_FALSE;
+    }
+    if (pCb[0] == SCSI_READ10)
+    {
+        s_Stats.MscRead10s++;
+        s_MscOffset = Be32(pCb + 2);
+        s_MscLeft = ((NvU32)pCb[7] << 8) | pCb[8];
+    }
+    else if (pCb[0] == SCSI_READ16)
+    {
+        s_Stats.MscRead16s++;
+        s_MscOffset = ((NvU64)Be32(pCb + 2) << 32) | Be32(pCb + 6);
+        s_MscLeft = Be32(pCb + 10);
+    }
+    else
+    {
+        ModelError("command not modelled");
+        return NV_FALSE;
+    }
+    s_MscOffset *= USB3_MODEL_MSC_BLOCK;
+    s_MscLeft *= USB3_MODEL_MSC_BLOCK;
+    if (s_MscLeft != DataLength)
+    {
+        ModelError("CBW length differs from its command");
+        return NV_FALSE;
+    }
+    s_MscResidue = 0;
+    if (s_MscEndEarly && (s_MscEndAfter < s_MscLeft))
+    {
+        s_MscResidue = (NvU32)s_MscLeft - s_MscEndAfter;
+        s_MscLeft = s_MscEndAfter;
+    }
+    s_MscEndEarly = NV_FALSE;
+    s_MscStep = (s_MscLeft || s_MscResidue) ? Msc_Data : Msc_Csw;
+    s_MscSeeking = NV_TRUE;
+    return NV_TRUE;
+}
+
+static NvU32 MscData(NvU8 *pBuf, NvU32 Bytes)
+{
+    NvU32 Sent = (NvU32)NV_MIN((NvU64)Bytes, s_MscLeft);
+    NvU32 i;
+
+    if ((Bytes < s_MscLeft) && (Bytes % MAX_PACKET))
+        ModelError("packet split between TRBs");
+    for (i = 0; i < Sent; i++)
+        pBuf[i] = Usb3ModelMscByte(s_MscOffset + i);
+    s_MscOffset += Sent;
+    s_MscLeft -= Sent;
+    /* A data stage ended early ends with a short packet, zero-length if
+     * it has filled the TRB. */
+    if ((s_MscLeft == 0) && (!s_MscResidue || (Sent < Bytes)))
+        s_MscStep = Msc_Csw;
+    return Sent;
+}
+
+static void MscStatus(NvU8 *pBuf, NvU32 Bytes)
+{
+    NvU8 Csw[CSW_BYTES];
+    NvU32 Word;
+
+    Word = CSW_SIGNATURE;
+    memcpy(Csw, &Word, 4);
+    memcpy(Csw + 4, &s_MscTag, 4);
+    memcpy(Csw + 8, &s_MscResidue, 4);
+    /* A data stage ended early fails the command. */
+    Csw[12] = s_MscResidue ? 1 : 0;
+    memcpy(pBuf, Csw, NV_MIN(Bytes, sizeof(Csw)));
+    s_MscStep = Msc_Cbw;
+}
+
+/*
+ * Runs the transfer of the TRB the endpoint context points to on the
+ * mass storage device, and fills in its outcome.
+ */
+static NvBool MscTransfer(const EP *pEp, Usb3ModelTransfer *pT)
+{
+    const NormalTRB *pTrb = (const NormalTRB *)(pEp->EpDw2.TRDequeuePtrLo << 4);
+    NvU8 *pBuf = (NvU8 *)pTrb->DataBufferLo;
+    NvU32 Bytes = pTrb->TRBTfrLen;
+    NvU32 Type = pEp->EpDw1.EPType;
+    NvU32 Dir = (Type == USB_BULK_IN);
+    NvU32 Sent = Bytes;
+    NvU32 Us = 0;
+
+    memset(pT, 0, sizeof(*pT));
+    pT->SubKind = XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_EPT_DONE;
+    pT->EpStatus = XUSB_CSB_SS_BI_COMPLQ_DWRD3_0_STATUS_COMPL_RETIRE;
+
+    if (Type == USB_CONTROL_BI)
+    {
+        s_Stats.MscControls++;
+        s_MscStep = Msc_Cbw;
+        pT->CompletionUs = 1;
+        pT->Bytes = Bytes;
+        return NV_TRUE;
+    }
+    if ((Type != USB_BULK_OUT) && (Type != USB_BULK_IN))
+    {
+        ModelError("endpoint type not modelled");
+        return NV_FALSE;
+    }
+    if (pEp->EpDw5.SEQNUM != s_MscSeqNum[Dir])
+        ModelError("sequence number not carried over");
+    if ((Bytes > TRB_BOUNDARY) ||
+        ((pTrb->DataBufferLo & (TRB_BOUNDARY - 1)) + Bytes > TRB_BOUNDARY))
+        ModelError("TRB over 64 KiB or across a 64 KiB boundary");
+
+    if (Type == USB_BULK_OUT)
+    {
+        if (s_MscStep != Msc_Cbw)
+            ModelError("CBW out of turn");
+        if (!MscCommand(pBuf, Bytes))
+            return NV_FALSE;
+    }
+    else if (s_MscStep == Msc_Data)
+    {
+        if (s_MscSeeking)
+            Us = USB3_MODEL_MSC_COMMAND_US;
+        s_MscSeeking = NV_FALSE;
+        Sent = MscData(pBuf, Bytes);
+        s_Stats.MscDataTrbs++;
+    }
+    else if (s_MscStep == Msc_Csw)
+    {
+        if (s_MscSeeking)
+            Us = USB3_MODEL_MSC_COMMAND_US;
+        s_MscSeeking = NV_FALSE;
+        MscStatus(pBuf, Bytes);
+        Sent = NV_MIN(Bytes, CSW_BYTES);
+    }
+    else
+    {
+        ModelError("bulk IN after the CSW, or with no command");
+        return NV_FALSE;
+    }
+
+    s_MscSeqNum[Dir] = (s_MscSeqNum[Dir] +
+                        NV_MAX(1, (Sent + MAX_PACKET - 1) / MAX_PACKET)) %
+                       SEQNUM_COUNT;
+    pT->SeqNum = s_MscSeqNum[Dir];
+    pT->Bytes = Sent;
+    pT->CompletionUs = Us + 1 + Sent / USB3_MODEL_MSC_BYTES_PER_US;
+    return NV_TRUE;
+}
+
+static void Doorbell(NvU32 Bi)
+{
+    BusInstance *pBi = &s_Bi[Bi];
+    Usb3ModelTransfer T;
+    EventTRB Event;
+    NvU32 Dwrd[4] = { 0, 0, 0, 0 };
+    NvU32 Now = HostClockNow();
+    NvU32 Done;
+    NvU32 i;
+
+    s_Stats.Doorbells++;
+    s_LastBi = Bi;
+    if (!pBi->KindWritten ||
+        (pBi->WorkQ[0] != XUSB_CSB_HS_BI_WORKQ_DWRD0_0_KIND_EPTLIST_BULK_INOUT) ||
+        (pBi->WorkQ[2] != 0))
+        ModelError("doorbell with the work queue half written");
+    pBi->KindWritten = NV_FALSE;
+    if (s_NextQueued)
+    {
+        T = s_Next;
+        s_NextQueued = NV_FALSE;
+    }
+    else if (!s_MscAttached)
+    {
+        ModelError("doorbell with no transfer queued");
+        return;
+    }
+    else if (!MscTransfer((const EP *)pBi->WorkQ[1], &T))
+    {
+        return;
+    }
+
+    Dwrd[0] = XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_EPT_NRDY;
+    for (i = 0; i < T.NotReady; i++)
+        Post(&pBi->CompQ, Later(Now, (i + 1) * T.NotReadyUs), Dwrd);
+
+    Done = Later(Now, T.CompletionUs);
+    if (Done == USB3_MODEL_NEVER)
+        return;
+
+    s_Ep = (EP *)pBi->WorkQ[1];
+    s_EpPending = NV_TRUE;
+    s_EpDue = Done;
+    s_EpStatus = T.EpStatus;
+    s_EpSeqNum = T.SeqNum;
+    s_EpBytes = T.Bytes;
+
+    Dwrd[0] = T.SubKind;
+    Post(&pBi->CompQ, Done, Dwrd);
+    if (T.SubKind == XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_EPT_ERROR)
+    {
+        memset(&Event, 0, sizeof(Event));
+        Event.DataBufferLo = pBi->WorkQ[1];
+        Event.ComplCode = T.ComplCode;
+        Event.TRBType = T.EventTrbType;
+        Post(&s_EventQ, Done, (const NvU32 *)&Event);
+    }
+
+    Dwrd[0] = XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_NO_ACTIVITY;
+    Post(&pBi->CompQ, Later(Done, T.TrailUs), Dwrd);
+}
+
+static NvU32 CsbRead(NvU32 Csb)
+{
+    const QueueEntry *pEntry;
+    NvU32 Bi = (Csb & BI_STRIDE) ? 1 : 0;
+    NvU32 BiReg = Csb & ~BI_STRIDE;
+
+    if (BiReg == XUSB_CSB_HS_BI_COMPLQ_CNTRL_0)
+        return Head(&s_Bi[Bi].CompQ) ? CNTRL_VALID : 0;
+    if (BiReg == XUSB_CSB_HS_BI_COMPLQ_DWRD0_0)
+    {
+        pEntry = Head(&s_Bi[Bi].CompQ);
+        return pEntry ? pEntry->Dwrd[0] : EMPTY_DWRD0;
+    }
+    if (Csb == XUSB_CSB_EVENTQ_CNTRL1_0)
+        return Head(&s_EventQ) ? CNTRL_VALID : 0;
+    if ((Csb >= XUSB_CSB_EVENTQ_TRBDWRD0_0) &&
+        (Csb <= XUSB_CSB_EVENTQ_TRBDWRD3_0))
+    {
+        pEntry = Head(&s_EventQ);
+        return pEntry ? pEntry->Dwrd[(Csb - XUSB_CSB_EVENTQ_TRBDWRD0_0) / 4] :
+                        EMPTY_DWRD0;
+    }
+    ModelError("read of a CSB register not modelled");
+    return 0;
+}
+
+static void CsbWrite(NvU32 Csb, NvU32 Data)
+{
+    NvU32 Bi = (Csb & BI_STRIDE) ? 1 : 0;
+    NvU32 BiReg = Csb & ~BI_STRIDE;
+
+    if (((BiReg == XUSB_CSB_HS_BI_COMPLQ_CNTRL_0) ||
+         (Csb == XUSB_CSB_EVENTQ_CNTRL1_0)) &&
+        (s_LastCsbRead != Csb))
+        ModelError("queue control written without reading it first");
+
+    switch (BiReg)
+    {
+        case XUSB_CSB_HS_BI_WORKQ_DWRD0_0:
+            s_Bi[Bi].WorkQ[0] = Data;
+            s_Bi[Bi].KindWritten = NV_TRUE;
+            return;
+        case XUSB_CSB_HS_BI_WORKQ_DWRD2_0:
+            s_Bi[Bi].WorkQ[2] = Data;
+            return;
+        case XUSB_CSB_HS_BI_WORKQ_DWRD1_0:
+            s_Bi[Bi].WorkQ[1] = Data;
+            Doorbell(Bi);
+            return;
+        case XUSB_CSB_HS_BI_COMPLQ_CNTRL_0:
+            if (Data & CNTRL_POP)
+                Pop(&s_Bi[Bi].CompQ, &s_Stats.CompQPops);
+            return;
+        default:
+            break;
+    }
+    if (Csb == XUSB_CSB_EVENTQ_CNTRL1_0)
+    {
+        if (Data & CNTRL_POP)
+            Pop(&s_EventQ, &s_Stats.EventQPops);
+        return;
+    }
+    ModelError("write of a CSB register not modelled");
+}
+
+static NvU32 ReadCfg(NvU32 Addr)
+{
+    NvU32 Offset = Addr - NV_XUSB_HOST_APB_DFPCI_CFG;
+
+    if ((Offset >= XUSB_CFG_CSB_ADDR_0) &&
+        (Offset < XUSB_CFG_CSB_ADDR_0 + CSB_PAGE_BYTES))
+    {
+        Update();
+        s_Stats.CsbReads++;
+        s_LastCsbRead = s_Page * CSB_PAGE_BYTES + Offset - XUSB_CFG_CSB_ADDR_0;
+        return CsbRead(s_LastCsbRead);
+    }
+    return HostRegPeek(Addr);
+}
+
+static void WriteCfg(NvU32 Addr, NvU32 Data)
+{
+    NvU32 Offset = Addr - NV_XUSB_HOST_APB_DFPCI_CFG;
+
+    if ((Offset >= XUSB_CFG_CSB_ADDR_0) &&
+        (Offset < XUSB_CFG_CSB_ADDR_0 + CSB_PAGE_BYTES))
+    {
+        Update();
+        s_Stats.CsbWrites++;
+        CsbWrite(s_Page * CSB_PAGE_BYTES + Offset - XUSB_CFG_CSB_ADDR_0, Data);
+        s_LastCsbRead = NO_CSB_READ;
+        return;
+    }
+    if (Offset == XUSB_CFG_ARU_C11_CSBRANGE_0)
+    {
+        s_Page = Data;
+        s_Stats.PageSwitches++;
+    }
+    HostRegPoke(Addr, Data);
+}
+
+void Usb3ModelReset(void)
+{
+    memset(&s_Stats, 0, sizeof(s_Stats));
+    memset(s_Bi, 0, sizeof(s_Bi));
+    memset(&s_EventQ, 0, sizeof(s_EventQ));
+    s_Page = 0;
+    s_LastCsbRead = NO_CSB_READ;
+    s_LastBi = 0;
+    s_NextQueued = NV_FALSE;
+    s_EpPending = NV_FALSE;
+    s_MscAttached = NV_FALSE;
+
+    HostRegReset();
+    HostRegHook(NV_XUSB_HOST_APB_DFPCI_CFG, CFG_BYTES, ReadCfg, WriteCfg);
+}
+
+void Usb3ModelMscAttach(void)
+{
+    s_MscAttached = NV_TRUE;
+    s_MscEndEarly = NV_FALSE;
+    s_MscStep = Msc_Cbw;
+    s_MscSeqNum[0] = s_MscSeqNum[1] = 0;
+}
+
+void Usb3ModelMscEndDataEarly(NvU32 Bytes)
+{
+    s_MscEndEarly = NV_TRUE;
+    s_MscEndAfter = Bytes;
+}
+
+NvU8 Usb3ModelMscByte(NvU64 Offset)
+{
+    NvU64 x = (Offset >> 2) * 0x9e3779b97f4a7c15ull;
+
+    return (NvU8)(x >> 56) ^ (NvU8)Offset;
+}
+
+void Usb3ModelQueue(const Usb3ModelTransfer *pTransfer)
+{
+    s_Next = *pTransfer;
+    s_NextQueued = NV_TRUE;
+}
+
+NvU32 Usb3ModelCompQEntries(void)
+{
+    return (s_Bi[0].CompQ.Tail - s_Bi[0].CompQ.Head) +
+           (s_Bi[1].CompQ.Tail - s_Bi[1].CompQ.Head);
+}
+
+NvU32 Usb3ModelEventQEntries(void)
+{
+    return s_EventQ.Tail - s_EventQ.Head;
+}
+
+NvU32 Usb3ModelLastBi(void)
+{
+    return s_LastBi;
+}
+
+const Usb3ModelStats *Usb3ModelGetStats(void)
+{
+    return &s_Stats;
+}
+
+void Usb3ModelClearStats(void)
+{
+    memset(&s_Stats, 0, sizeof(s_Stats));
+}
+
+/* Linked in place of NvBootUtilWaitUS(): the wait moves the timer. */
+void __wrap_NvBootUtilWaitUS(NvU32 Us)
+{
+    HostClockAdvance(Us);
+    Update();
+}
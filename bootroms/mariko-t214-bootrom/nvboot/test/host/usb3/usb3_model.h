@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * usb3_model.h - Model of the bus instance queues of the XUSB host
+ * controller behind io/usb3/nvboot_usb3.c in the host harness.
+ *
+ * Without firmware the controller has no event ring in memory. The Boot
+ * ROM submits one transfer at a time through the work queue of a bus
+ * instance (BI) and takes its outcome from the BI completion queue, both
+ * reached through the CSB window of the XUSB PCI configuration space:
+ * ARU_C11_CSBRANGE selects a page of 0x200 bytes, and CSB_ADDR onwards
+ * maps it. The model hooks that space and counts the CSB accesses.
+ *
+ * The write of WORKQ_DWRD1 rings the doorbell. The model then runs the
+ * Usb3ModelTransfer queued for it: it posts the EPT_NRDY entries, the
+ * completion, and the NO_ACTIVITY entry that ends the transfer to the
+ * completion queue of the BI, each at its time after the doorbell. With
+ * the completion it writes the status, sequence number and bytes taken
+ * (EDTLA) to the endpoint context, and with an EPT_ERROR completion it posts a transfer event TRB
+ * to the event queue. Both queues are rings of USB3_MODEL_QUEUE_ENTRIES,
+ * so a run of transfers wraps them.
+ *
+ * With a mass storage device attached, a doorbell with no transfer queued
+ * goes to a bulk-only device instead, through the TRB at the dequeue
+ * pointer of the endpoint context. It takes a CBW on bulk OUT, streams
+ * the data stage of a READ(10) or READ(16) into the bulk IN TRBs that
+ * follow, however the driver splits them, and then returns the CSW. Each
+ * TRB must keep to 64 KiB and a 64 KiB boundary, and each but the last of
+ * a data stage must be whole packets. Told to, the device ends the data
+ * stage of a command early: with a short packet, or a zero-length one if
+ * it ends on a TRB, and then a CSW that fails the command and reports the
+ * rest as residue. The device checks the sequence
+ * number of each bulk endpoint carries over from its last transfer. A
+ * control transfer, as for a CLEAR_FEATURE, puts it back to wait for a
+ * CBW. The byte at offset o of the medium is Usb3ModelMscByte(o).
+ *
+ * Time is kept in microseconds by host_clock and moves only with the
+ * waits of the driver. A device transfer completes after its bytes at
+ * USB3_MODEL_MSC_BYTES_PER_US, the first of a command
+ * USB3_MODEL_MSC_COMMAND_US later still for the device to seek; both are
+ * assumptions for a high-speed flash drive, not measurements.
+ */
+
+#ifndef INCLUDED_USB3_MODEL_H
+#define INCLUDED_USB3_MODEL_H
+
+#include "nvcommon.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define USB3_MODEL_QUEUE_ENTRIES    8
+#define USB3_MODEL_NEVER            0xffffffff
+#define USB3_MODEL_MSC_BLOCK        512
+#define USB3_MODEL_MSC_BYTES_PER_US 40
+#define USB3_MODEL_MSC_COMMAND_US   250
+
+typedef struct
+{
+    /* EPT_NRDY entries before the completion, NotReadyUs apart. */
+    NvU32 NotReady;
+    NvU32 NotReadyUs;
+    /* Completion entry, from the doorbell or USB3_MODEL_NEVER. */
+    NvU32 SubKind;
+    NvU32 CompletionUs;
+    /* Endpoint context status and SEQNUM written with the completion. */
+    NvU32 EpStatus;
+    NvU32 SeqNum;
+    /* NO_ACTIVITY entry, from the completion or USB3_MODEL_NEVER. */
+    NvU32 TrailUs;
+    /* Event TRB posted with an EPT_ERROR completion. */
+    NvU32 EventTrbType;
+    NvU32 ComplCode;
+    /* Endpoint context EDTLA written with the completion. */
+    NvU32 Bytes;
+} Usb3ModelTransfer;
+
+typedef struct
+{
+    NvU32 CsbReads;
+    NvU32 CsbWrites;
+    NvU32 PageSwitches;
+    NvU32 Doorbells;
+    /* Entries popped from the completion and event queues. */
+    NvU32 CompQPops;
+    NvU32 EventQPops;
+    /* Pops with no valid entry at the head. */
+    NvU32 EmptyPops;
+    /* Mass storage commands taken, by opcode, and their data TRBs. */
+    NvU32 MscRead10s;
+    NvU32 MscRead16s;
+    NvU32 MscDataTrbs;
+    NvU32 MscControls;
+    /* Contract violations found by the model; see usb3_model.c. */
+    NvU32 Errors;
+} Usb3ModelStats;
+
+/** Empties the queues and hooks the registers. */
+void Usb3ModelReset(void);
+
+/** Attaches the mass storage device, until the next reset. */
+void Usb3ModelMscAttach(void);
+
+/**
+ * Ends the data stage of the next command after Bytes, a whole number of
+ * packets, if it is longer.
+ */
+void Usb3ModelMscEndDataEarly(NvU32 Bytes);
+
+/** Byte at Offset of the medium. */
+NvU8 Usb3ModelMscByte(NvU64 Offset);
+
+/** Queues the transfer the next doorbell runs. */
+void Usb3ModelQueue(const Usb3ModelTransfer *pTransfer);
+
+/** Entries posted to the completion and event queues and not popped. */
+NvU32 Usb3ModelCompQEntries(void);
+NvU32 Usb3ModelEventQEntries(void);
+
+/** Bus instance the last doorbell was rung on. */
+NvU32 Usb3ModelLastBi(void);
+
+const Usb3ModelStats *Usb3ModelGetStats(void);
+void Usb3ModelClearStats(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // INCLUDED_USB3_MODEL_H
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * usb3_stubs.c - The functions nvboot_usb3.c calls outside the transfers
+ * through the BI queues: clocks, resets, pads, the ARC and USB2 tracking
+ * at controller bring-up. The harness runs none of those, so reaching any
+ * of these aborts.
+ *
+ * The symbols are defined without their headers, so that one macro fits
+ * all of them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MODEL_STUB(Name)                                        \
+    void Name(void)                                             \
+    {                                                           \
+        fprintf(stderr, "usb3: %s called\n", #Name);            \
+        abort();                                                \
+    }
+
+MODEL_STUB(NvBootArcEnable)
+MODEL_STUB(NvBootClocksGetOscFreq)
+MODEL_STUB(NvBootClocksSetEnable)
+MODEL_STUB(NvBootPadsConfigForBootDevice)
+MODEL_STUB(NvBootResetSetEnable)
+MODEL_STUB(NvBootXusbDevicePerformTracking)
@@ -0,0 +1,569 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of the transfers of io/usb3/nvboot_usb3.c through the BI work
+ * and completion queues: NvBootXusbUpdateEpContext() and then
+ * NvBootXusbUpdWorkQAndChkCompQ(), as the control and MSC code issue
+ * every transfer.
+ *
+ * The driver is built unchanged over the queue model of usb3_model.c.
+ * "check" runs each outcome the BI can post for a transfer on both bus
+ * instances and for control, bulk IN and bulk OUT endpoints, with the
+ * entries posted at once and late: a completion, an endpoint error with
+ * its event TRB, controller errors, EPT_NRDY entries ahead of the
+ * completion, and no completion or no trailing entry. It checks the result,
+ * the bulk sequence numbers, and that each transfer leaves both queues
+ * empty. It then runs random transfers back to back, which wraps the
+ * queue rings. Last it reads through NvBootUsb3Read() from the mass
+ * storage device of the model: lengths on both sides of the 64 KiB TRB
+ * limit and of the READ(10) page count, into destinations at and off a
+ * 64 KiB boundary, and from a device too large for READ CAPACITY(10). It
+ * checks every byte, the bytes around the destination, and that each read
+ * is one command. A device that ends the data stage early must have its
+ * CSW taken, not a further data TRB queued into it, and the read retried.
+ * "bench" prints the CSB accesses and model time of each
+ * outcome, and the commands, TRBs and time of reading a bootloader in one
+ * call, in 64 KiB calls and a page per call.
+ *
+ * Built with HOST_OLD, the harness runs the same transfers over the driver
+ * of OLD_REV, which pops the completion queue entry by entry, times out
+ * on a completion that follows EPT_NRDY, and after two EPT_NRDY entries
+ * leaves the completion queued for the next transfer. Reads are then
+ * checked only where the old code sends one TRB of at most 64 KiB.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "nvcommon.h"
+#include "nvboot_error.h"
+#include "nvboot_bit.h"
+#include "nvboot_usb3_context.h"
+#include "nvboot_usb3_int.h"
+#include "nvboot_usb3_local.h"
+#include "ardev_t_xusb_csb.h"
+#include "host_clock.h"
+#include "usb3_model.h"
+
+#define IRAM_START          NV_ADDRESS_MAP_IRAM_A_BASE
+#define IRAM_BYTES          (NV_ADDRESS_MAP_IRAM_D_LIMIT + 1 - IRAM_START)
+#define RANDOM_TRANSFERS    1000
+/* A root port on each bus instance. */
+#define PORT_BI0            0
+#define PORT_BI1            2
+#define EP_OUT              1
+#define EP_IN               2
+
+/* 32 pages of 512 bytes per block, as the reader uses them. */
+#define PAGE_LOG2           9
+#define BLOCK_LOG2          14
+#define PAGE_BYTES          (1 << PAGE_LOG2)
+#define PAGES_PER_BLOCK     (1 << (BLOCK_LOG2 - PAGE_LOG2))
+#define TRB_WINDOW          0x10000
+#define GUARD_BYTES         TRB_WINDOW
+#define MAX_READ            (40 * 1024 * 1024)
+#define START_PAGE          37
+#define BENCH_BYTES         (4 * 1024 * 1024)
+#define CANARY              0xa5
+
+#define SUBKIND(x)          XUSB_CSB_HS_BI_COMPLQ_DWRD0_0_SUBKIND_##x
+#define STATUS(x)           XUSB_CSB_SS_BI_COMPLQ_DWRD3_0_STATUS_##x
+#define NEVER               USB3_MODEL_NEVER
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "usb3: %s:%d: %s\n", __FILE__, __LINE__,    \
+                    #Cond);                                             \
+        }                                                               \
+    } while (0)
+
+typedef struct
+{
+    const char *Name;
+    Usb3ModelTransfer Transfer;
+    NvBootError Expected;
+    /* Completion queue entries the transfer leaves behind. */
+    NvU32 Left;
+} Outcome;
+
+static const Outcome s_Outcomes[] =
+{
+    { "EPT_DONE",
+      { 0, 0, SUBKIND(EPT_DONE), 0, STATUS(COMPL_RETIRE), 1, 0, 0, 0 },
+      NvBootError_Success },
+    { "EPT_DONE, late",
+      { 0, 0, SUBKIND(EPT_DONE), 300, STATUS(COMPL_RETIRE), 1, 0, 0, 0 },
+      NvBootError_Success },
+    { "EPT_DONE, NO_ACTIVITY late",
+      { 0, 0, SUBKIND(EPT_DONE), 0, STATUS(COMPL_RETIRE), 1, 40, 0, 0 },
+      NvBootError_Success },
+    { "EPT_DONE, stalled",
+      { 0, 0, SUBKIND(EPT_DONE), 0, STATUS(ERR_STALL), 1, 0, 0, 0 },
+      NvBootError_XusbEpStalled },
+    { "EPT_ERROR, stall event",
+      { 0, 0, SUBKIND(EPT_ERROR), 0, STATUS(COMPL_RETIRE), 0, 0,
+        NvBootTRB_EventData, NvBootComplqCode_STALL_ERR },
+      NvBootError_XusbEpStalled },
+    { "EPT_ERROR, transaction event",
+      { 0, 0, SUBKIND(EPT_ERROR), 0, STATUS(COMPL_RETIRE), 0, 0,
+        NvBootTRB_EventData, NvBootComplqCode_USB_TRANS_ERR },
+      NvBootError_XusbEpRetry },
+    { "EPT_ERROR, other TRB type",
+      { 0, 0, SUBKIND(EPT_ERROR), 0, STATUS(COMPL_RETIRE), 0, 0,
+        NvBootTRB_TransferEvent, NvBootComplqCode_STALL_ERR },
+      NvBootError_XusbEpRetry },
+    { "OP_ERROR",
+      { 0, 0, SUBKIND(OP_ERROR), 0, STATUS(COMPL_RETIRE), 0, 0, 0, 0 },
+      NvBootError_XusbEpRetry },
+    { "STOPREQ",
+      { 0, 0, SUBKIND(STOPREQ), 0, STATUS(COMPL_RETIRE), 0, 0, 0, 0 },
+      NvBootError_XusbEpRetry },
+    { "EPT_NRDY, EPT_DONE",
+      { 1, 5, SUBKIND(EPT_DONE), 20, STATUS(COMPL_RETIRE), 1, 0, 0, 0 },
+#if HOST_OLD
+      NvBootError_XusbEpRetry },
+#else
+      NvBootError_Success },
+#endif
+    { "EPT_NRDY x2, EPT_DONE",
+      { 2, 5, SUBKIND(EPT_DONE), 20, STATUS(COMPL_RETIRE), 1, 0, 0, 0 },
+#if HOST_OLD
+      /* Stuck on the second EPT_NRDY, then on the completion. */
+      NvBootError_XusbEpRetry, 2 },
+#else
+      NvBootError_Success },
+#endif
+    { "EPT_NRDY only",
+      { 1, 5, 0, NEVER, 0, 0, 0, 0, 0 },
+      NvBootError_XusbEpRetry },
+    { "no completion",
+      { 0, 0, 0, NEVER, 0, 0, 0, 0, 0 },
+      NvBootError_XusbEpRetry },
+    { "EPT_DONE, no NO_ACTIVITY",
+      { 0, 0, SUBKIND(EPT_DONE), 0, STATUS(COMPL_RETIRE), 1, NEVER, 0, 0 },
+      NvBootError_XusbEpRetry },
+};
+
+#define OUTCOMES    (sizeof(s_Outcomes) / sizeof(s_Outcomes[0]))
+
+/* Defined by nvboot_usb3.c, in IRAM. */
+extern EP *EpContext;
+extern TRB *TRBRing;
+/* Static in nvboot_usb3.c; the Makefile makes it global. */
+extern NvBootUsb3Context *s_Usb3Context;
+
+NvBootInfoTable BootInfoTable;
+
+/* The reader logs each read; the harness keeps no log. */
+NvU32 NvBootLog_printf(int Id, ...)
+{
+    return 0;
+}
+
+static NvBootUsb3Context s_Context;
+
+/* The buffers stay in static storage, below 4GB; see host.mk. */
+static NvU8 s_Dest[GUARD_BYTES + TRB_WINDOW + MAX_READ + GUARD_BYTES]
+    __attribute__((aligned(TRB_WINDOW)));
+
+static void MapIram(void)
+{
+    void *p = mmap((void *)IRAM_START, IRAM_BYTES, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if (p != (void *)IRAM_START)
+    {
+        fprintf(stderr, "usb3: cannot map IRAM at 0x%x\n", IRAM_START);
+        exit(1);
+    }
+}
+
+/* Sets up the context as InitializeDataStructures() and enumeration do. */
+static void Attach(NvU8 RootPortNum)
+{
+    Usb3ModelReset();
+
+    memset(&s_Context, 0, sizeof(s_Context));
+    memset(EpContext, 0, sizeof(EP));
+    s_Context.Usb3BitInfo =
+        (NvBootUsb3Status *)&BootInfoTable.SecondaryDevStatus[0];
+    s_Context.EndPtContext = EpContext;
+    s_Context.TRBRingEnquePtr = &TRBRing[0];
+    s_Context.TRBRingCtrlEnquePtr = &TRBRing[0];
+    s_Context.RootPortNum = RootPortNum;
+    s_Context.stEnumerationInfo.bMaxPacketSize0 = 64;
+    s_Context.EPNumAndPacketSize[USB_DIR_OUT].EndpointNumber = EP_OUT;
+    s_Context.EPNumAndPacketSize[USB_DIR_IN].EndpointNumber = EP_IN;
+}
+
+static NvBootError Transfer(USB_Endpoint_Type EpType,
+                            const Usb3ModelTransfer *pTransfer)
+{
+    Usb3ModelQueue(pTransfer);
+    NvBootXusbUpdateEpContext(&s_Context, EpType);
+    return NvBootXusbUpdWorkQAndChkCompQ(&s_Context);
+}
+
+static NvU32 SeqNum(USB_Endpoint_Type EpType)
+{
+    if (EpType == USB_BULK_OUT)
+        return s_Context.BulkSeqNumOut;
+    if (EpType == USB_BULK_IN)
+        return s_Context.BulkSeqNumIn;
+    return 0;
+}
+
+static void CheckOutcomes(void)
+{
+    static const NvU8 Ports[] = { PORT_BI0, PORT_BI1 };
+    static const USB_Endpoint_Type EpTypes[] =
+    {
+        USB_CONTROL_BI, USB_BULK_IN, USB_BULK_OUT
+    };
+    const Usb3ModelStats *pStats = Usb3ModelGetStats();
+    const Outcome *pOutcome;
+    Usb3ModelTransfer T;
+    NvU32 o, p, t;
+    NvU32 Seq;
+    NvBootError e;
+
+    for (o = 0; o < OUTCOMES; o++)
+    for (p = 0; p < sizeof(Ports) / sizeof(Ports[0]); p++)
+    for (t = 0; t < sizeof(EpTypes) / sizeof(EpTypes[0]); t++)
+    {
+        pOutcome = &s_Outcomes[o];
+        T = pOutcome->Transfer;
+        /* A sequence number the context does not start with. */
+        T.SeqNum = T.SeqNum ? 5 + p + t : 0;
+
+        Attach(Ports[p]);
+        s_Context.BulkSeqNumOut = s_Context.BulkSeqNumIn = 3;
+        e = Transfer(EpTypes[t], &T);
+
+        CHECK(e == pOutcome->Expected);
+        if (e != pOutcome->Expected)
+            fprintf(stderr, "usb3: %s: got 0x%x\n", pOutcome->Name,
+                    (unsigned)e);
+        CHECK(pStats->Errors == 0);
+        CHECK(pStats->Doorbells == 1);
+        CHECK(Usb3ModelLastBi() == (Ports[p] == PORT_BI1));
+        CHECK(Usb3ModelCompQEntries() == pOutcome->Left);
+        CHECK(Usb3ModelEventQEntries() == 0);
+        if (EpTypes[t] == USB_CONTROL_BI)
+            continue;
+        if (e == NvBootError_Success)
+            Seq = T.SeqNum;
+        else if (e == NvBootError_XusbEpStalled &&
+                 T.SubKind == SUBKIND(EPT_DONE))
+            Seq = 0;
+        else
+            Seq = 3;
+        CHECK(SeqNum(EpTypes[t]) == Seq);
+    }
+}
+
+/*
+ * Random transfers back to back on one bus instance, with the entries
+ * posted at random times; the queue rings wrap many times over.
+ */
+static void CheckBackToBack(NvU8 RootPortNum)
+{
+    static const NvU32 Picks[] = { 0, 1, 2, 4, 5, 7, 9 };
+    static const USB_Endpoint_Type EpTypes[] =
+    {
+        USB_CONTROL_BI, USB_BULK_IN, USB_BULK_OUT
+    };
+    const Usb3ModelStats *pStats = Usb3ModelGetStats();
+    const Outcome *pOutcome;
+    Usb3ModelTransfer T;
+    USB_Endpoint_Type EpType;
+    NvU32 i, Picked;
+    NvU32 Good = 0;
+    NvBootError e;
+
+    Attach(RootPortNum);
+    for (i = 0; i < RANDOM_TRANSFERS; i++)
+    {
+        Picked = Picks[rand() % (sizeof(Picks) / sizeof(Picks[0]))];
+#if HOST_OLD
+        /* The old driver times out on a completion after EPT_NRDY. */
+        if (Picked == 9)
+            Picked = 0;
+#endif
+        pOutcome = &s_Outcomes[Picked];
+        T = pOutcome->Transfer;
+        T.NotReadyUs = 1 + rand() % 50;
+        T.CompletionUs = T.NotReady * T.NotReadyUs + rand() % 100;
+        T.TrailUs = rand() % 50;
+        T.SeqNum = rand() % 32;
+        EpType = EpTypes[rand() % 3];
+
+        e = Transfer(EpType, &T);
+        if ((e == pOutcome->Expected) &&
+            (Usb3ModelCompQEntries() == 0) &&
+            (Usb3ModelEventQEntries() == 0) &&
+            ((e != NvBootError_Success) || (EpType == USB_CONTROL_BI) ||
+             (SeqNum(EpType) == T.SeqNum)))
+            Good++;
+    }
+    CHECK(Good == RANDOM_TRANSFERS);
+    CHECK(pStats->Doorbells == RANDOM_TRANSFERS);
+    CHECK(pStats->Errors == 0);
+    CHECK(pStats->EmptyPops == 0);
+}
+
+/* Sets up the context as NvBootUsb3Init() leaves it for the reader. */
+static void AttachMsc(NvU32 LastLba)
+{
+    Attach(PORT_BI0);
+    Usb3ModelMscAttach();
+    s_Context.PageSizeLog2 = PAGE_LOG2;
+    s_Context.BlockSizeLog2 = BLOCK_LOG2;
+    s_Context.Usb3BitInfo->LastLogicalBlkAddr = LastLba;
+    s_Usb3Context = &s_Context;
+}
+
+/* Reads Bytes from Page on as the reader does, in calls of up to Chunk. */
+static NvBootError Read(NvU32 Page, NvU8 *pDst, NvU32 Bytes, NvU32 Chunk)
+{
+    NvBootError e = NvBootError_Success;
+    NvU32 Done, n;
+
+    for (Done = 0; (Done < Bytes) && (e == NvBootError_Success); Done += n)
+    {
+        n = NV_MIN(Chunk, Bytes - Done);
+        e = NvBootUsb3Read(Page / PAGES_PER_BLOCK, Page % PAGES_PER_BLOCK, n,
+                           pDst + Done);
+        Page += n / PAGE_BYTES;
+    }
+    return e;
+}
+
+static NvBool IsRead(NvU32 Page, const NvU8 *p, NvU32 Bytes)
+{
+    NvU64 Offset = (NvU64)Page * PAGE_BYTES;
+    NvU32 i;
+
+    for (i = 0; i < Bytes; i++)
+    {
+        if (p[i] != Usb3ModelMscByte(Offset + i))
+            return NV_FALSE;
+    }
+    return NV_TRUE;
+}
+
+static NvBool IsGuardIntact(const NvU8 *p, NvU32 Bytes)
+{
+    NvU32 i;
+
+    for (i = 0; i < Bytes; i++)
+    {
+        if (p[i] != CANARY)
+            return NV_FALSE;
+    }
+    return NV_TRUE;
+}
+
+static void CheckRead(NvU32 LastLba, NvU32 Page, NvU32 Offset, NvU32 Bytes)
+{
+    const Usb3ModelStats *pStats = Usb3ModelGetStats();
+    NvU8 *pDst = s_Dest + GUARD_BYTES + Offset;
+    NvU32 Window = Offset % TRB_WINDOW;
+    NvBool Crosses = Window + Bytes > TRB_WINDOW;
+    NvBool Read16;
+    NvBootError e;
+
+#if HOST_OLD
+    if (Crosses || (LastLba == 0xffffffff))
+        return;
+#endif
+    Read16 = (Bytes / PAGE_BYTES > 0xffff) || (LastLba == 0xffffffff);
+    memset(s_Dest, CANARY, GUARD_BYTES + Offset + Bytes + GUARD_BYTES);
+    AttachMsc(LastLba);
+    e = Read(Page, pDst, Bytes, Bytes);
+
+    CHECK(pStats->Errors == 0);
+    CHECK(Usb3ModelCompQEntries() == 0);
+    if (Crosses && (Offset % PAGE_BYTES))
+    {
+        CHECK(e == NvBootError_IllegalParameter);
+        CHECK(pStats->Doorbells == 0);
+        CHECK(IsGuardIntact(s_Dest, GUARD_BYTES + Offset + Bytes));
+        return;
+    }
+    CHECK(e == NvBootError_Success);
+    CHECK(IsRead(Page, pDst, Bytes));
+    CHECK(IsGuardIntact(s_Dest, GUARD_BYTES + Offset));
+    CHECK(IsGuardIntact(pDst + Bytes, GUARD_BYTES));
+    CHECK(pStats->MscRead10s == !Read16);
+    CHECK(pStats->MscRead16s == Read16);
+    CHECK(pStats->MscDataTrbs == (Window + Bytes + TRB_WINDOW - 1) / TRB_WINDOW);
+    CHECK(pStats->MscControls == 0);
+}
+
+static void CheckReads(void)
+{
+    static const NvU32 Lengths[] =
+    {
+        PAGE_BYTES, 16 * 1024, TRB_WINDOW - PAGE_BYTES, TRB_WINDOW,
+        TRB_WINDOW + PAGE_BYTES, 3 * TRB_WINDOW - PAGE_BYTES, 1024 * 1024,
+        BENCH_BYTES
+    };
+    static const NvU32 Offsets[] =
+    {
+        0, PAGE_BYTES, TRB_WINDOW - PAGE_BYTES, 4
+    };
+    NvU32 l, o;
+
+    for (l = 0; l < sizeof(Lengths) / sizeof(Lengths[0]); l++)
+    for (o = 0; o < sizeof(Offsets) / sizeof(Offsets[0]); o++)
+        CheckRead(0x3fffff, START_PAGE, Offsets[o], Lengths[l]);
+
+    /* Over the READ(10) page count, and a device past 2 TiB. */
+    CheckRead(0x3fffff, 3, PAGE_BYTES, MAX_READ);
+    CheckRead(0xffffffff, 0xfff00000, 0, TRB_WINDOW + PAGE_BYTES);
+}
+
+/*
+ * The device ends the data stage of the first command after EndAfter of
+ * Bytes and fails it in the CSW. The retry reads the pages whole.
+ */
+static void CheckEarlyEnd(NvU32 Bytes, NvU32 EndAfter)
+{
+    const Usb3ModelStats *pStats = Usb3ModelGetStats();
+    NvU8 *pDst = s_Dest + GUARD_BYTES;
+    NvU32 Start;
+    NvBootError e;
+
+#if HOST_OLD
+    if (Bytes > TRB_WINDOW)
+        return;
+#endif
+    memset(s_Dest, CANARY, GUARD_BYTES + Bytes + GUARD_BYTES);
+    AttachMsc(0x3fffff);
+    Usb3ModelMscEndDataEarly(EndAfter);
+    Start = HostClockNow();
+    e = Read(START_PAGE, pDst, Bytes, Bytes);
+
+    CHECK(e == NvBootError_Success);
+    /* Nothing waited out the 1 s completion timeout. */
+    CHECK(HostClockNow() - Start < 1000000);
+    CHECK(pStats->Errors == 0);
+    CHECK(Usb3ModelCompQEntries() == 0);
+    CHECK(IsRead(START_PAGE, pDst, Bytes));
+    CHECK(IsGuardIntact(s_Dest, GUARD_BYTES));
+    CHECK(IsGuardIntact(pDst + Bytes, GUARD_BYTES));
+    CHECK(pStats->MscRead10s == 2);
+    /* The short TRB, zero-length on a TRB boundary, ends the first. */
+    CHECK(pStats->MscDataTrbs == EndAfter / TRB_WINDOW + 1 +
+                                 (Bytes + TRB_WINDOW - 1) / TRB_WINDOW);
+}
+
+static void CheckEarlyEnds(void)
+{
+    CheckEarlyEnd(16 * 1024, 4 * 1024);
+    CheckEarlyEnd(16 * 1024, 0);
+    CheckEarlyEnd(3 * TRB_WINDOW - PAGE_BYTES, TRB_WINDOW + 2048);
+    CheckEarlyEnd(3 * TRB_WINDOW - PAGE_BYTES, TRB_WINDOW);
+    CheckEarlyEnd(3 * TRB_WINDOW - PAGE_BYTES, 0);
+}
+
+static int Check(const char *Label)
+{
+    CheckOutcomes();
+    CheckBackToBack(PORT_BI0);
+    CheckBackToBack(PORT_BI1);
+    CheckReads();
+    CheckEarlyEnds();
+
+    printf("%s: %u checks, %u failures\n", Label, s_Cases, s_Failures);
+    return s_Failures != 0;
+}
+
+/*
+ * CSB accesses and model time of a bulk IN transfer for each outcome, on
+ * bus instance 0 and after a transfer that has set the CSB page.
+ */
+static int Bench(const char *Label)
+{
+    static const Usb3ModelTransfer Warm =
+        { 0, 0, SUBKIND(EPT_DONE), 0, STATUS(COMPL_RETIRE), 1, 0, 0, 0 };
+    const Usb3ModelStats *pStats = Usb3ModelGetStats();
+    NvU32 o, Start;
+    NvBootError e;
+
+    printf("%s: bulk IN transfer on BI 0, one outcome per line\n", Label);
+    printf("  %-30s %6s %5s %6s %5s %5s %9s\n", "outcome", "result",
+           "reads", "writes", "pages", "pops", "us");
+    for (o = 0; o < OUTCOMES; o++)
+    {
+        Attach(PORT_BI0);
+        Transfer(USB_BULK_IN, &Warm);
+        Usb3ModelClearStats();
+        Start = HostClockNow();
+        e = Transfer(USB_BULK_IN, &s_Outcomes[o].Transfer);
+        printf("  %-30s %6s %5u %6u %5u %5u %9u\n", s_Outcomes[o].Name,
+               e == NvBootError_Success ? "ok" :
+               e == NvBootError_XusbEpStalled ? "stall" : "retry",
+               pStats->CsbReads, pStats->CsbWrites, pStats->PageSwitches,
+               pStats->CompQPops + pStats->EventQPops,
+               HostClockNow() - Start);
+    }
+
+    /* A bootloader into a 64 KiB aligned buffer, the way readers call. */
+    static const NvU32 Chunks[] = { BENCH_BYTES, TRB_WINDOW, PAGE_BYTES };
+    static const char *ChunkNames[] = { "one call", "64 KiB calls", "page calls" };
+    NvU32 c;
+    NvBool Good;
+
+    printf("%s: %u-byte read from page %u, %u MB/s, %u us per command\n",
+           Label, BENCH_BYTES, START_PAGE, USB3_MODEL_MSC_BYTES_PER_US,
+           USB3_MODEL_MSC_COMMAND_US);
+    printf("  %-14s %6s %8s %8s %8s %9s %9s %7s\n", "reads", "result",
+           "commands", "data TRBs", "doorbells", "CSB", "us", "MB/s");
+    for (c = 0; c < sizeof(Chunks) / sizeof(Chunks[0]); c++)
+    {
+        memset(s_Dest, 0, BENCH_BYTES);
+        AttachMsc(0x3fffff);
+        Start = HostClockNow();
+        e = Read(START_PAGE, s_Dest, BENCH_BYTES, Chunks[c]);
+        Good = (e == NvBootError_Success) && (pStats->Errors == 0) &&
+               IsRead(START_PAGE, s_Dest, BENCH_BYTES);
+        printf("  %-14s %6s %8u %9u %9u %9u %9u", ChunkNames[c],
+               Good ? "ok" : "FAILED", pStats->MscRead10s + pStats->MscRead16s,
+               pStats->MscDataTrbs, pStats->Doorbells,
+               pStats->CsbReads + pStats->CsbWrites, HostClockNow() - Start);
+        if (Good)
+            printf(" %7.1f\n", (double)BENCH_BYTES / (HostClockNow() - Start));
+        else
+            printf(" %7s\n", "-");
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    MapIram();
+    HostClockInit();
+
+    if ((argc > 1) && !strcmp(argv[1], "bench"))
+        return Bench(argc > 2 ? argv[2] : "usb3");
+    return Check(argc > 2 ? argv[2] : "usb3");
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of the constant-time compares in nvboot_util.c.
+ *
+ * "check" compares every alignment pair, length 0 to 72 and mismatch
+ * position against memcmp. "bench" prints the cycles per call and runs a
+ * dudect timing-leak test: a Welch t-test between inputs that differ only
+ * in their first byte and inputs that differ only in their last, cropped
+ * at several percentiles. |t| above 4.5 means the run time leaks where
+ * the buffers differ; an early-exit compare is run as the control.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "nvboot_util_int.h"
+#include "host_dudect.h"
+
+#if HOST_HAVE_OLD
+FI_bool OldCompareConstTimeFI(const void *, const void *, size_t);
+bool OldCompareConstTime(const void *, const void *, size_t);
+#endif
+
+static uint8_t s_A[4096 + 8] __attribute__((aligned(64)));
+static uint8_t s_B[4096 + 8] __attribute__((aligned(64)));
+
+static int Check(void)
+{
+    unsigned Cases = 0, Bad = 0;
+    int OffA, OffB, Pos;
+    size_t Len, i;
+    bool Equal;
+
+    srand(1);
+    for (OffA = 0; OffA < 4; OffA++)
+    for (OffB = 0; OffB < 4; OffB++)
+    for (Len = 0; Len <= 72; Len++)
+    for (Pos = -1; Pos < (int)Len; Pos++)
+    {
+        for (i = 0; i < Len; i++)
+            s_A[OffA + i] = s_B[OffB + i] = rand();
+        if (Pos >= 0)
+            s_B[OffB + Pos] ^= 1 << (rand() & 7);
+        // A zero length is rejected.
+        Equal = Len && !memcmp(s_A + OffA, s_B + OffB, Len);
+        Cases++;
+        Bad += NvBootUtilCompareConstTime(s_A + OffA, s_B + OffB, Len) != Equal;
+        Bad += NvBootUtilCompareConstTimeFI(s_A + OffA, s_B + OffB, Len) !=
+               (Equal ? FI_TRUE : FI_FALSE);
+    }
+    printf("util_compare: %u cases, %u mismatches\n", Cases, Bad);
+    return Bad != 0;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+typedef int (*CompareFn)(const void *, const void *, size_t);
+
+static int New(const void *a, const void *b, size_t n)
+{
+    return NvBootUtilCompareConstTime(a, b, n);
+}
+static int NewFI(const void *a, const void *b, size_t n)
+{
+    return NvBootUtilCompareConstTimeFI(a, b, n) == FI_TRUE;
+}
+#if HOST_HAVE_OLD
+static int Old(const void *a, const void *b, size_t n)
+{
+    return OldCompareConstTime(a, b, n);
+}
+static int OldFI(const void *a, const void *b, size_t n)
+{
+    return OldCompareConstTimeFI(a, b, n) == FI_TRUE;
+}
+#endif
+static int EarlyExit(const void *a, const void *b, size_t n)
+{
+    const uint8_t *x = a, *y = b;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        if (x[i] != y[i])
+            return 0;
+    return 1;
+}
+
+// Best of 7 runs, equal buffers, B aligned and A at offset Off.
+static double Cycles(CompareFn Fn, size_t Len, int Off)
+{
+    int Reps = 2000000 / (Len + 16) + 2000;
+    uint64_t Best = ~0ull, Start, Took;
+    int t, r;
+
+    memset(s_A, 0x5a, sizeof(s_A));
+    memset(s_B, 0x5a, sizeof(s_B));
+    for (t = 0; t < 7; t++)
+    {
+        Start = __rdtsc();
+        for (r = 0; r < Reps; r++)
+        {
+            if (!Fn(s_A + Off, s_B, Len))
+                abort();
+            __asm__ volatile("" ::: "memory");
+        }
+        Took = __rdtsc() - Start;
+        if (Took < Best)
+            Best = Took;
+    }
+    return (double)Best / Reps;
+}
+
+#define NUM_MEAS 2000000
+static uint64_t s_Time[NUM_MEAS];
+static uint8_t s_Class[NUM_MEAS];
+static uint8_t s_In[NUM_MEAS][2][32];
+
+static double Dudect(CompareFn Fn, size_t Len)
+{
+    unsigned Aux;
+    uint64_t Start;
+    size_t i, j;
+
+    for (i = 0; i < NUM_MEAS; i++)
+    {
+        s_Class[i] = rand() & 1;
+        for (j = 0; j < Len; j++)
+            s_In[i][0][j] = rand();
+        memcpy(s_In[i][1], s_In[i][0], Len);
+        s_In[i][1][s_Class[i] ? Len - 1 : 0] ^= 1 + (rand() % 255);
+    }
+    for (i = 0; i < NUM_MEAS; i++)
+    {
+        Start = __rdtscp(&Aux);
+        Fn(s_In[i][0], s_In[i][1], Len);
+        s_Time[i] = __rdtscp(&Aux) - Start;
+    }
+    return HostDudect(s_Time, s_Class, NUM_MEAS);
+}
+
+static int Bench(void)
+{
+    static const size_t Lens[] = { 16, 32, 64, 256, 4096 };
+    static const struct { const char *Name; CompareFn Fn; } Fns[] =
+    {
+        { "early exit", EarlyExit },
+#if HOST_HAVE_OLD
+        { "old", Old },
+        { "old FI", OldFI },
+#endif
+        { "new", New },
+        { "new FI", NewFI },
+    };
+    unsigned i;
+
+    printf("cycles per call, equal buffers\n");
+    printf("%6s", "len");
+#if HOST_HAVE_OLD
+    printf(" %10s %10s", "old", "old FI");
+#endif
+    printf(" %10s %10s %14s\n", "new", "new FI", "new FI unal");
+    for (i = 0; i < sizeof(Lens) / sizeof(Lens[0]); i++)
+    {
+        printf("%6zu", Lens[i]);
+#if HOST_HAVE_OLD
+        printf(" %10.1f %10.1f", Cycles(Old, Lens[i], 0), Cycles(OldFI, Lens[i], 0));
+#endif
+        printf(" %10.1f %10.1f %14.1f\n", Cycles(New, Lens[i], 0),
+               Cycles(NewFI, Lens[i], 0), Cycles(NewFI, Lens[i], 1));
+    }
+
+    printf("dudect max |t| over crops, %d samples (> 4.5 is a leak)\n", NUM_MEAS);
+    srand(1);
+    for (i = 0; i < sizeof(Fns) / sizeof(Fns[0]); i++)
+    {
+        printf("  %-12s len 16: %8.2f   len 32: %8.2f\n", Fns[i].Name,
+               Dudect(Fns[i].Fn, 16), Dudect(Fns[i].Fn, 32));
+    }
+    return 0;
+}
+
+#else
+
+static int Bench(void)
+{
+    printf("util_compare: the benchmark needs an x86 cycle counter\n");
+    return 0;
+}
+
+#endif
+
+int main(int argc, char **argv)
+{
+    if ((argc > 1) && !strcmp(argv[1], "bench"))
+        return Bench();
+    return Check();
+}
@@ -0,0 +1,620 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * xusb_model.c - Function level model of io/xusb_dev/nvboot_xusb_dev_hw.c
+ * and the controller behind it. See xusb_model.h.
+ *
+ * The model counts as errors what the driver must never make the
+ * controller do: run out of event ring, queue a TRB shorter than a packet
+ * that is sent into it, take an interrupt with no event posted, or wait
+ * for an event that can no longer come.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "nvcommon.h"
+#include "nvboot_error.h"
+#include "nvboot_xusb_dev.h"
+#include "nvboot_xusb_dev_hw.h"
+#include "ardev_t_xusb_dev_xhci.h"
+#include "host_clock.h"
+#include "host_regs.h"
+#include "xusb_model.h"
+
+#define XUSB_REG_BYTES      0x10000
+
+/* As nvboot_xusb_dev.c decodes them. */
+#define HIGH_SPEED          3
+#define SETUP_VALUE         2
+#define HOST2DEV_DEVICE     0x00
+#define SET_ADDRESS         5
+#define SET_CONFIGURATION   9
+
+/* The enumeration the host runs, one step per completed status stage. */
+typedef enum
+{
+    Enum_Idle,
+    Enum_Connected,
+    Enum_Address,
+    Enum_Configuration,
+    Enum_Done,
+} EnumStep;
+
+typedef struct
+{
+    NvU32 Dequeue;
+    NvU32 Ccs;
+    NvBool Loaded;
+    /* Set by a doorbell, cleared when the ring is found empty. */
+    NvBool Armed;
+    /* Bytes the current TRB holds so far. */
+    NvU32 Filled;
+    /* Set by a short packet in a chained TRB, until the TD ends. */
+    NvBool Skipping;
+} ModelRing;
+
+typedef struct
+{
+    const NvU8 *Data;
+    NvU32 Bytes;
+} HostWrite;
+
+static XusbModelLink s_Link;
+static XusbModelStats s_Stats;
+static NvU64 s_Now;
+
+static ModelRing s_Rings[EP1_IN + 1];
+static NvU32 s_Paused;
+
+static NvU32 s_EventBase;
+static NvU32 s_EventTrbs;
+static NvU32 s_EventEnqueue;
+static NvU32 s_EventPcs;
+static NvU32 s_EventDequeue;
+static NvBool s_Interrupt;
+
+static EnumStep s_Enum;
+
+static HostWrite s_Writes[XUSB_MODEL_MAX_WRITES];
+static NvU32 s_NumWrites;
+static NvU32 s_Write;
+static NvU32 s_Sent;
+/* When the link is free, and when the host has its next write ready. */
+static NvU64 s_LinkFree;
+static NvU64 s_HostReady;
+static NvBool s_HeldOff;
+static NvU64 s_HeldOffSince;
+
+static void ModelError(const char *What)
+{
+    s_Stats.Errors++;
+    fprintf(stderr, "xusb: model: %s\n", What);
+}
+
+static void Advance(NvU64 Ns)
+{
+    s_Now += Ns;
+    if (s_Now / 1000 > HostClockNow())
+        HostClockAdvance((NvU32)(s_Now / 1000 - HostClockNow()));
+}
+
+static EpContext_T *Context(Endpoint_T Ep)
+{
+    NvU32 Base = HostRegPeek(XUSB_BASE + XUSB_DEV_XHCI_ECPLO_0);
+
+    return (EpContext_T *)(uintptr_t)Base + Ep;
+}
+
+static NvU32 PacketNs(NvU32 Bytes)
+{
+    return (NvU32)((NvU64)Bytes * 1000 / s_Link.RateMBps);
+}
+
+static NvBool HostHasData(void)
+{
+    return s_Write < s_NumWrites;
+}
+
+/* Loads the dequeue pointer and cycle state of Ep from its context. */
+static void LoadRing(Endpoint_T Ep)
+{
+    EpContext_T *pContext = Context(Ep);
+    ModelRing *pRing = &s_Rings[Ep];
+
+    pRing->Dequeue = pContext->TRDequeuePtrLo << 4;
+    pRing->Ccs = pContext->DCS;
+    pRing->Loaded = NV_TRUE;
+    pRing->Armed = NV_FALSE;
+    pRing->Filled = 0;
+    pRing->Skipping = NV_FALSE;
+}
+
+/* The TRB at the dequeue pointer after any link TRB, or NULL if none. */
+static DataTRB_T *FetchTrb(ModelRing *pRing)
+{
+    DataTRB_T *pTrb;
+    LinkTRB_T *pLink;
+
+    for (;;)
+    {
+        pTrb = (DataTRB_T *)(uintptr_t)pRing->Dequeue;
+        if (pTrb->C != pRing->Ccs)
+            return NULL;
+        if (pTrb->TRBType != LINK_TRB)
+            return pTrb;
+        pLink = (LinkTRB_T *)pTrb;
+        pRing->Dequeue = pLink->RingSegPtrLo << 4;
+        if (pLink->TC)
+            pRing->Ccs ^= 1;
+    }
+}
+
+static void NextTrb(ModelRing *pRing)
+{
+    pRing->Dequeue += sizeof(DataTRB_T);
+    pRing->Filled = 0;
+}
+
+/*
+ * The TRB the next packet goes to, or NULL if none is queued. What is left
+ * of a TD that a short packet ended is skipped on the way.
+ */
+static DataTRB_T *FetchDataTrb(ModelRing *pRing)
+{
+    DataTRB_T *pTrb;
+
+    while (((pTrb = FetchTrb(pRing)) != NULL) && pRing->Skipping)
+    {
+        pRing->Skipping = pTrb->CH;
+        NextTrb(pRing);
+    }
+    return pTrb;
+}
+
+/* The next free event TRB, cleared, or NULL if the ring is full. */
+static EventTRB_T *NewEvent(void)
+{
+    EventTRB_T *pEvent = (EventTRB_T *)(uintptr_t)s_EventEnqueue;
+    NvU32 Next = s_EventEnqueue + sizeof(EventTRB_T);
+
+    if (Next == s_EventBase + s_EventTrbs * sizeof(EventTRB_T))
+        Next = s_EventBase;
+    if (Next == s_EventDequeue)
+    {
+        ModelError("event ring full");
+        return NULL;
+    }
+    memset((void *)pEvent, 0, sizeof(EventTRB_T));
+    return pEvent;
+}
+
+/* Hands the event to the driver: cycle bit last, then the interrupt. */
+static void PostEvent(EventTRB_T *pEvent)
+{
+    pEvent->C = s_EventPcs;
+    s_EventEnqueue += sizeof(EventTRB_T);
+    if (s_EventEnqueue == s_EventBase + s_EventTrbs * sizeof(EventTRB_T))
+    {
+        s_EventEnqueue = s_EventBase;
+        s_EventPcs ^= 1;
+    }
+    s_Interrupt = NV_TRUE;
+}
+
+static void PostTransferEvent(NvU32 Trb, NvU32 Remaining, NvU32 Code,
+                              Endpoint_T Ep)
+{
+    TransferEventTRB_T *pEvent = (TransferEventTRB_T *)NewEvent();
+
+    if (pEvent == NULL)
+        return;
+    pEvent->TRBPointerLo = Trb;
+    pEvent->TRBTxLen = Remaining;
+    pEvent->CompCode = Code;
+    pEvent->TRBType = TRANSFER_EVENT_TRB;
+    pEvent->EndptId = Ep;
+    PostEvent((EventTRB_T *)pEvent);
+}
+
+static void PostSetup(NvU8 Request, NvU8 Value)
+{
+    static NvU16 s_SeqNum;
+    SetupEventTRB_T *pEvent = (SetupEventTRB_T *)NewEvent();
+    NvU8 Setup[8] = { HOST2DEV_DEVICE, Request };
+
+    if (pEvent == NULL)
+        return;
+    Setup[SETUP_VALUE] = Value;
+    memcpy((void *)pEvent->Data, Setup, sizeof(Setup));
+    pEvent->CtrlSeqNum = s_SeqNum++;
+    pEvent->CompCode = SUCCESS_ERR_CODE;
+    pEvent->TRBType = SETUP_EVENT_TRB;
+    pEvent->EndptId = EP0_IN;
+    PostEvent((EventTRB_T *)pEvent);
+}
+
+static void PostPortStatusChange(void)
+{
+    EventTRB_T *pEvent = NewEvent();
+
+    if (pEvent == NULL)
+        return;
+    pEvent->CompCode = SUCCESS_ERR_CODE;
+    pEvent->TRBType = PORT_STATUS_CHANGE_TRB;
+    PostEvent(pEvent);
+}
+
+/*
+ * Moves the bulk OUT link up to the model clock: every packet that ends by
+ * then is delivered, in order. The packet fills the TRB found at its start.
+ */
+static void Run(void)
+{
+    ModelRing *pRing = &s_Rings[EP1_OUT];
+    const HostWrite *pWrite;
+    DataTRB_T *pTrb;
+    NvU64 Start, End;
+    NvU32 Bytes, Room, Remaining;
+    NvBool Short;
+
+    while (HostHasData() && !s_HeldOff && !(s_Paused & (1 << EP1_OUT)))
+    {
+        pWrite = &s_Writes[s_Write];
+        Bytes = NV_MIN(s_Link.MaxPacket, pWrite->Bytes - s_Sent);
+        Start = NV_MAX(s_LinkFree, s_HostReady);
+        End = Start + PacketNs(Bytes);
+        if (End > s_Now)
+            break;
+
+        pTrb = pRing->Armed ? FetchDataTrb(pRing) : NULL;
+        if (pTrb == NULL)
+        {
+            pRing->Armed = NV_FALSE;
+            s_HeldOff = NV_TRUE;
+            s_HeldOffSince = Start;
+            s_Stats.HoldOffs++;
+            break;
+        }
+
+        Room = pTrb->TRBTxLen - pRing->Filled;
+        if (Bytes > Room)
+            ModelError("packet overruns the TRB");
+        memcpy((NvU8 *)(uintptr_t)pTrb->DataBufPtrLo + pRing->Filled,
+               pWrite->Data + s_Sent, NV_MIN(Bytes, Room));
+        pRing->Filled += NV_MIN(Bytes, Room);
+
+        if (s_Stats.Packets == 0)
+            s_Stats.FirstPacketNs = Start;
+        s_Stats.LastPacketNs = End;
+        s_Stats.Packets++;
+        s_Stats.BytesAccepted += NV_MIN(Bytes, Room);
+        s_LinkFree = End;
+        s_Sent += Bytes;
+        if (s_Sent == pWrite->Bytes)
+        {
+            s_Write++;
+            s_Sent = 0;
+            s_HostReady = End + s_Link.HostGapNs;
+        }
+
+        Short = Bytes < s_Link.MaxPacket;
+        Remaining = pTrb->TRBTxLen - pRing->Filled;
+        if ((Remaining == 0) || Short)
+        {
+            if ((Remaining == 0) ? pTrb->IOC : pTrb->ISP)
+            {
+                PostTransferEvent(pRing->Dequeue, Remaining,
+                    Remaining ? SHORT_PKT_ERR_CODE : SUCCESS_ERR_CODE,
+                    EP1_OUT);
+                s_Stats.Events++;
+            }
+            pRing->Skipping = Short && pTrb->CH;
+            NextTrb(pRing);
+        }
+    }
+}
+
+/* Completes the control stages queued on EP0, and steps the enumeration. */
+static void RunControl(void)
+{
+    ModelRing *pRing = &s_Rings[EP0_IN];
+    DataTRB_T *pTrb;
+
+    if (!pRing->Loaded)
+        LoadRing(EP0_IN);
+    while ((pTrb = FetchTrb(pRing)) != NULL)
+    {
+        if (pTrb->TRBType != STATUS_STAGE_TRB)
+            ModelError("control stage other than status");
+        PostTransferEvent(pRing->Dequeue, 0, SUCCESS_ERR_CODE, EP0_IN);
+        NextTrb(pRing);
+
+        if (s_Enum == Enum_Address)
+        {
+            s_Enum = Enum_Configuration;
+            PostSetup(SET_CONFIGURATION, 1);
+        }
+        else if (s_Enum == Enum_Configuration)
+        {
+            s_Enum = Enum_Done;
+        }
+    }
+}
+
+static NvU32 ReadReg(NvU32 Addr)
+{
+    Advance(XUSB_MODEL_REG_NS);
+    Run();
+    return HostRegPeek(Addr);
+}
+
+static void WriteReg(NvU32 Addr, NvU32 Data)
+{
+    Advance(XUSB_MODEL_REG_NS);
+    Run();
+    if (Addr == XUSB_BASE + XUSB_DEV_XHCI_EP_PAUSE_0)
+    {
+        // The link picks up where it was held when the endpoint resumes.
+        if ((s_Paused & ~Data) & (1 << EP1_OUT))
+            s_LinkFree = NV_MAX(s_LinkFree, s_Now);
+        s_Paused = Data;
+    }
+    HostRegPoke(Addr, Data);
+}
+
+void XusbModelReset(const XusbModelLink *pLink)
+{
+    s_Link = *pLink;
+    memset(&s_Stats, 0, sizeof(s_Stats));
+    memset(s_Rings, 0, sizeof(s_Rings));
+    s_Paused = 0;
+    s_EventBase = s_EventTrbs = s_EventEnqueue = s_EventDequeue = 0;
+    s_EventPcs = 1;
+    s_Interrupt = NV_FALSE;
+    s_Enum = Enum_Idle;
+    s_NumWrites = s_Write = s_Sent = 0;
+    s_LinkFree = s_HostReady = s_Now;
+    s_HeldOff = NV_FALSE;
+
+    HostRegHook(XUSB_BASE, XUSB_REG_BYTES, ReadReg, WriteReg);
+}
+
+void XusbModelSetLink(const XusbModelLink *pLink)
+{
+    s_Link = *pLink;
+}
+
+void XusbModelHostWrite(const NvU8 *Data, NvU32 Bytes)
+{
+    if (HostHasData() && (s_NumWrites == XUSB_MODEL_MAX_WRITES))
+    {
+        fprintf(stderr, "xusb: too many host writes\n");
+        abort();
+    }
+    if (!HostHasData())
+    {
+        s_NumWrites = s_Write = 0;
+        s_HostReady = NV_MAX(s_HostReady, s_Now);
+    }
+    s_Writes[s_NumWrites].Data = Data;
+    s_Writes[s_NumWrites].Bytes = Bytes;
+    s_NumWrites++;
+    if (Bytes && (Bytes % s_Link.MaxPacket == 0))
+        XusbModelHostWrite(Data + Bytes, 0);
+}
+
+NvU32 XusbModelHostPending(void)
+{
+    NvU32 Pending = 0;
+    NvU32 i;
+
+    for (i = s_Write; i < s_NumWrites; i++)
+        Pending += s_Writes[i].Bytes;
+    return Pending - s_Sent;
+}
+
+void XusbModelClearStats(void)
+{
+    memset(&s_Stats, 0, sizeof(s_Stats));
+}
+
+const XusbModelStats *XusbModelGetStats(void)
+{
+    return &s_Stats;
+}
+
+NvU64 XusbModelNow(void)
+{
+    return s_Now;
+}
+
+/* The functions of nvboot_xusb_dev_hw.c that nvboot_xusb_dev.c calls. */
+
+NvBootError NvBootXusbDeviceInitializeEventRing(NvU32 EventRing, NvU32 NumTRB)
+{
+    XUSBDeviceContext_T *pXUSBDeviceContext = &XUSBDeviceContext;
+
+    memset((void *)(uintptr_t)EventRing, 0, NumTRB * sizeof(EventTRB_T));
+    s_EventBase = s_EventEnqueue = s_EventDequeue = EventRing;
+    s_EventTrbs = NumTRB;
+    s_EventPcs = 1;
+
+    pXUSBDeviceContext->EventDequeuePtr =
+    pXUSBDeviceContext->EventEnqueuePtr = EventRing;
+    pXUSBDeviceContext->EventCCS = 1;
+    Advance(8 * XUSB_MODEL_REG_NS);
+    return NvBootError_Success;
+}
+
+/*
+ * Polls the interrupt pending bit one register read at a time, and clears
+ * it. A wait that nothing can end any more is reported as a timeout.
+ */
+NvBootError NvBootXusbDevicePollforInterrupt(NvU32 Timeout, NvU32 *EventEnqueuePtr)
+{
+    NvU64 Start = s_Now;
+
+    for (;;)
+    {
+        Advance(XUSB_MODEL_REG_NS);
+        Run();
+        if (s_Interrupt)
+            break;
+        if (!HostHasData() || s_HeldOff || (s_Paused & (1 << EP1_OUT)))
+        {
+            ModelError("driver waits for an event that cannot come");
+            return NvBootError_HwTimeOut;
+        }
+        if (s_Now - Start >= (NvU64)Timeout * 1000)
+            return NvBootError_HwTimeOut;
+    }
+
+    s_Interrupt = NV_FALSE;
+    *EventEnqueuePtr = s_EventEnqueue;
+    Advance(2 * XUSB_MODEL_REG_NS + XUSB_MODEL_EVENT_NS);
+    return NvBootError_Success;
+}
+
+void NvBootXusbDeviceUpdateEventDequeuePtr(NvU32 EventDequeuePtr)
+{
+    Advance(2 * XUSB_MODEL_REG_NS);
+    Run();
+    s_EventDequeue = EventDequeuePtr;
+}
+
+void NvBootXusbDeviceRingDoor(Endpoint_T EpIndex, NvU32 CntrlSeqNum)
+{
+    ModelRing *pRing = &s_Rings[EpIndex];
+
+    Advance(XUSB_MODEL_REG_NS);
+    Run();
+    if (EpIndex == EP0_IN)
+    {
+        RunControl();
+        return;
+    }
+    if (EpIndex != EP1_OUT)
+    {
+        ModelError("doorbell for an endpoint the harness does not run");
+        return;
+    }
+    if (!pRing->Loaded)
+        ModelError("doorbell before the endpoint context is loaded");
+
+    s_Stats.Doorbells++;
+    pRing->Armed = NV_TRUE;
+    if (s_HeldOff)
+    {
+        s_HeldOff = NV_FALSE;
+        s_LinkFree = NV_MAX(s_LinkFree, s_Now + s_Link.RecoveryNs);
+        s_Stats.HeldOffNs += s_LinkFree - s_HeldOffSince;
+    }
+}
+
+NvBootError NvBootXusbDeviceReloadContext(Endpoint_T EpIndex)
+{
+    Advance(2 * XUSB_MODEL_REG_NS);
+    Run();
+    if (EpIndex == EP1_OUT)
+    {
+        // A held off host stays held off until the next doorbell.
+        LoadRing(EpIndex);
+    }
+    return NvBootError_Success;
+}
+
+NvBootError NvBootXusbDeviceHaltEp(Endpoint_T EpIndex, NvU32 Halt)
+{
+    Advance(2 * XUSB_MODEL_REG_NS);
+    Run();
+    if (Halt)
+        ModelError("endpoint halted");
+    return NvBootError_Success;
+}
+
+NvBootError NvBootXusbDeviceStallEndpoint(Endpoint_T EpIndex, NvU32 Stall)
+{
+    ModelError("endpoint stalled");
+    return NvBootError_Success;
+}
+
+/* The host connects at high speed, and enumerates once that is seen. */
+void NvBootXusbDeviceEnumerateHw(void)
+{
+    s_Enum = Enum_Connected;
+    PostPortStatusChange();
+}
+
+NvBootError NvBootXusbDeviceHandlePortStatusChange(void)
+{
+    XUSBDeviceContext_T *pXUSBDeviceContext = &XUSBDeviceContext;
+
+    Advance(4 * XUSB_MODEL_REG_NS);
+    if (s_Enum != Enum_Connected)
+    {
+        ModelError("port status change out of order");
+        return NvBootError_Success;
+    }
+    pXUSBDeviceContext->PortSpeed = HIGH_SPEED;
+    pXUSBDeviceContext->DeviceState = CONNECTED;
+    s_Enum = Enum_Address;
+    PostSetup(SET_ADDRESS, 1);
+    return NvBootError_Success;
+}
+
+/* Set up, clocks and pads: nothing the model keeps. */
+void NvBootXusbDeviceSetPadOwnership(void)
+{
+}
+
+NvBootError NvBootXusbDeviceSetupStaticParamsPad(void)
+{
+    return NvBootError_Success;
+}
+
+NvBootError NvBootXusbDeviceRemovePowerDownPad(void)
+{
+    return NvBootError_Success;
+}
+
+NvBootError NvBootXusbDevicePerformTracking(NvBootClocksOscFreq OscFreq)
+{
+    return NvBootError_Success;
+}
+
+void NvBootXusbDeviceBusInit(void)
+{
+}
+
+void NvBootXusbDeviceInterruptSetup(void)
+{
+}
+
+void NvBootXusbDeviceSetRunStatus(NvU32 Run)
+{
+    Advance(2 * XUSB_MODEL_REG_NS);
+}
+
+NvBootClocksOscFreq NvBootClocksGetOscFreq(void)
+{
+    return NvBootClocksOscFreq_38_4;
+}
+
+const ClockTable XusbClockTables[1];
+
+/* Linked in place of NvBootUtilWaitUS(): the wait moves the model clock. */
+void __wrap_NvBootUtilWaitUS(NvU32 Us)
+{
+    Advance((NvU64)Us * 1000);
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * xusb_model.h - The XUSB device controller model behind
+ * io/xusb_dev/nvboot_xusb_dev.c in the host harness.
+ *
+ * xusb_model.c stands in for nvboot_xusb_dev_hw.c, whose register headers
+ * are not in the tree, at the level of its functions, and hooks the
+ * registers nvboot_xusb_dev.c writes itself. Behind them it runs the
+ * controller side of the rings: it follows the transfer rings from the
+ * endpoint contexts, link TRBs and cycle bits, fetches TRBs only after a
+ * doorbell, and posts transfer and setup events to the event ring.
+ *
+ * A host on the other side of a high-speed link enumerates the device,
+ * then sends its bulk OUT writes in max packets at the link rate. A packet
+ * fills the TRB at the dequeue pointer, and a full TRB or a short packet
+ * completes it. TRBs chained by their CH bit make one TD, and a short
+ * packet skips what is left of its TD; the next packet goes to the TRB
+ * after it. When no TRB is queued the host is held off, and resumes
+ * XusbModelLink.RecoveryNs after the doorbell, for the NAK and PING rounds.
+ *
+ * Time is kept in nanoseconds. The CPU side moves it by XUSB_MODEL_REG_NS
+ * per register access of the modelled functions, by XUSB_MODEL_EVENT_NS per
+ * interrupt taken, and by the waits of the driver; host_clock follows it.
+ * The costs are assumptions, not measurements.
+ */
+
+#ifndef INCLUDED_XUSB_MODEL_H
+#define INCLUDED_XUSB_MODEL_H
+
+#include "nvcommon.h"
+#include "nvboot_xusb_dev.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define XUSB_MODEL_REG_NS       100
+#define XUSB_MODEL_EVENT_NS     1000
+#define XUSB_MODEL_MAX_WRITES   16
+
+typedef struct
+{
+    /* Link rate in MB/s, and the max packet size. */
+    NvU32 RateMBps;
+    NvU32 MaxPacket;
+    /* From a doorbell on a held off endpoint to the next packet. */
+    NvU32 RecoveryNs;
+    /* From the end of one host write to the start of the next. */
+    NvU32 HostGapNs;
+} XusbModelLink;
+
+typedef struct
+{
+    /* Bulk OUT bytes the device accepted, and its packets. */
+    NvU32 BytesAccepted;
+    NvU32 Packets;
+    /* Bulk OUT doorbells, and transfer events posted for EP1 OUT. */
+    NvU32 Doorbells;
+    NvU32 Events;
+    /* Times the host was held off, and how long in all. */
+    NvU32 HoldOffs;
+    NvU64 HeldOffNs;
+    /* Start of the first and end of the last bulk OUT packet. */
+    NvU64 FirstPacketNs;
+    NvU64 LastPacketNs;
+    /* Contract violations found by the model; see xusb_model.c. */
+    NvU32 Errors;
+} XusbModelStats;
+
+/**
+ * Resets the controller, the link and the counters, and hooks the XUSB
+ * device registers. The harness calls it before the port's Init().
+ */
+void XusbModelReset(const XusbModelLink *pLink);
+
+/** Changes the link between messages; the controller state is kept. */
+void XusbModelSetLink(const XusbModelLink *pLink);
+
+/**
+ * Queues a host bulk OUT write of Bytes from Data, sent after the rest. A
+ * write that is a multiple of the max packet ends with a zero length
+ * packet, so that a device that reads more sees where it ends.
+ */
+void XusbModelHostWrite(const NvU8 *Data, NvU32 Bytes);
+
+/** Host bytes not yet accepted by the device. */
+NvU32 XusbModelHostPending(void);
+
+/** Forgets the counters, not the state of the controller or the link. */
+void XusbModelClearStats(void);
+
+const XusbModelStats *XusbModelGetStats(void);
+
+/** The model clock. */
+NvU64 XusbModelNow(void);
+
+/** The driver context of nvboot_xusb_dev.c, which no header declares. */
+extern XUSBDeviceContext_T XUSBDeviceContext;
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // INCLUDED_XUSB_MODEL_H
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+
+/*
+ * xusb_stubs.c - The functions nvboot_xusb_dev.c and nvboot_rcm.c call
+ * outside enumeration by SET_ADDRESS and SET_CONFIGURATION and the bulk
+ * OUT receive: descriptor and endpoint status requests, RCM message
+ * processing, fuses, straps and clocks. The harness runs none of those,
+ * so reaching any of these aborts.
+ *
+ * The symbols are defined without their headers, so that one macro fits
+ * all of them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MODEL_STUB(Name)                                        \
+    void Name(void)                                             \
+    {                                                           \
+        fprintf(stderr, "xusb: %s called\n", #Name);            \
+        abort();                                                \
+    }
+
+MODEL_STUB(NvBootClocksEngine)
+MODEL_STUB(NvBootCryptoMgrAuthRcmPayloadFskp)
+MODEL_STUB(NvBootCryptoMgrDecryptRcmPayloadFskp)
+MODEL_STUB(NvBootCryptoMgrFskpInit)
+MODEL_STUB(NvBootCryptoMgrOemAuthRcmPayload)
+MODEL_STUB(NvBootCryptoMgrOemDecryptRcmPayload)
+MODEL_STUB(NvBootCryptoMgrSetOemPcp)
+MODEL_STUB(NvBootDebugSetDebugFeatures)
+MODEL_STUB(NvBootFuseAddAdditionalEcidInfo)
+MODEL_STUB(NvBootFuseGetUniqueId)
+MODEL_STUB(NvBootFuseIsOdmProductionMode)
+MODEL_STUB(NvBootFuseIsSecureProvisioningMode)
+MODEL_STUB(NvBootStrapIsDebugRecoveryMode)
+MODEL_STUB(NvBootStrapIsForceRecoveryMode)
+MODEL_STUB(NvBootWdtReload)
+MODEL_STUB(NvBootXusbDeviceEPGetStatus)
+MODEL_STUB(NvBootXusbDeviceSetPidRev)
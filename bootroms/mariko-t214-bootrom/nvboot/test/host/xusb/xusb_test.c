@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2016 NVIDIA Corporation.  All rights reserved.
+ *
+ * NVIDIA Corporation and its licensors retain all intellectual property
+ * and proprietary rights in and to this software and related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA Corporation is strictly prohibited.
+ */
+
+/*
+ * Host test of the bulk OUT receive of io/xusb_dev/nvboot_xusb_dev.c under
+ * ReceiveMessage() of core/rcm/nvboot_rcm.c, through the RCM port of
+ * core/rcm/nvboot_rcm_port.c.
+ *
+ * The three files are built unchanged, over the controller model of
+ * xusb_model.c. The device is enumerated once, as the Boot ROM does, and
+ * then receives message after message. The RCM hash is left out: the
+ * rcm_hash harness covers it.
+ *
+ * "check" sends random messages in one or more host writes, with and
+ * without gaps between the writes, and checks that ReceiveMessage() gets
+ * every byte in place and that the model saw no contract violation.
+ * "bench" prints the time from the first packet of the largest message to
+ * the return of ReceiveMessage() at high speed, for several hold off
+ * recoveries.
+ *
+ * Built with HOST_OLD, the harness runs the same messages over the driver
+ * and RCM code of OLD_REV.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <sys/mman.h>
+
+#include "nvboot_error.h"
+#include "nvboot_se_int.h"
+#include "nvboot_context_int.h"
+#include "nvboot_config.h"
+#include "nvboot_rcm.h"
+#include "nvboot_rcm_port_int.h"
+#include "nvboot_xusb_dev.h"
+#include "host_clock.h"
+#include "xusb_model.h"
+
+#define MSG_ADDRESS         NVBOOT_RCM_MSG_IRAM_START
+#define SIGNED_OFFSET       offsetof(NvBootRcmMsg, RandomAesBlock)
+/* What ReceiveMessage() reads at most until it has the header. */
+#define HEADER_READ_END     (64 * 1024 + 1)
+
+/* IRAM, which the harness maps at its address. */
+#define IRAM_START          NV_ADDRESS_MAP_IRAM_A_BASE
+#define IRAM_BYTES          (NV_ADDRESS_MAP_IRAM_D_LIMIT + 1 - IRAM_START)
+
+/* High speed; the Boot ROM builds the driver without SuperSpeed. */
+#define LINK_RATE           40      /* MB/s */
+#define MAX_PACKET          512
+
+#define NUM_RANDOM          400
+
+#define CHECK(Cond)                                                     \
+    do {                                                                \
+        s_Cases++;                                                      \
+        if (!(Cond))                                                    \
+        {                                                               \
+            s_Failures++;                                               \
+            fprintf(stderr, "xusb: %s:%d: %s\n", __FILE__,              \
+                    __LINE__, #Cond);                                   \
+        }                                                               \
+    } while (0)
+
+static unsigned s_Cases;
+static unsigned s_Failures;
+
+NvBootInfoTable BootInfoTable;
+NvBootContext Context;
+int32_t FI_counter1;
+int32_t FI_IncrDist;
+
+/* Defined by startup/start.S; only the version query reads it. */
+NvU32 NvBootBootromVersionAddress;
+
+/* Not declared by a header. */
+NvBootError ReceiveMessage(NvBootRcmMsg *pRcmMsgHeader);
+
+static NvBootRcmMsg *const s_Msg = (NvBootRcmMsg *)MSG_ADDRESS;
+static NvU8 s_HostMsg[NVBOOT_RCM_MAX_MSG_LENGTH];
+static NvU32 s_Rand = 1;
+
+static NvU32 Xorshift(void)
+{
+    s_Rand ^= s_Rand << 13;
+    s_Rand ^= s_Rand >> 17;
+    s_Rand ^= s_Rand << 5;
+    return s_Rand;
+}
+
+/* The RCM hash runs in the rcm_hash harness; here it does nothing. */
+void NvBootCryptoMgrOemRcmHashStart(const NvBootRcmMsg *RcmMsg)
+{
+}
+
+void NvBootCryptoMgrOemRcmHashUpdate(const NvBootRcmMsg *RcmMsg,
+                                     uint32_t BytesReceived)
+{
+}
+
+void NvBootCryptoMgrOemRcmHashFinish(const NvBootRcmMsg *RcmMsg)
+{
+}
+
+static void MapIram(void)
+{
+    void *p = mmap((void *)IRAM_START, IRAM_BYTES, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if (p != (void *)IRAM_START)
+    {
+        fprintf(stderr, "xusb: cannot map IRAM at 0x%x\n", IRAM_START);
+        exit(1);
+    }
+}
+
+static void SetLink(NvU32 RecoveryNs, NvU32 HostGapNs)
+{
+    XusbModelLink Link;
+
+    Link.RateMBps = LINK_RATE;
+    Link.MaxPacket = MAX_PACKET;
+    Link.RecoveryNs = RecoveryNs;
+    Link.HostGapNs = HostGapNs;
+    XusbModelSetLink(&Link);
+}
+
+/* A message of Length bytes in s_HostMsg; Length must be valid. */
+static void BuildMessage(NvU32 Length)
+{
+    NvU32 i;
+
+    for (i = 0; i < Length; i++)
+        s_HostMsg[i] = Xorshift();
+    ((NvBootRcmMsg *)s_HostMsg)->LengthInsecure = Length;
+}
+
+/* A valid insecure length with Payload bytes or fewer after the header. */
+static NvU32 MessageLength(NvU32 Payload)
+{
+    NvU32 Length = sizeof(NvBootRcmMsg) + Payload;
+
+    Length -= (Length - SIGNED_OFFSET) % NVBOOT_SE_AES_BLOCK_LENGTH_BYTES;
+    while (Length >= NVBOOT_RCM_MAX_MSG_LENGTH)
+        Length -= NVBOOT_SE_AES_BLOCK_LENGTH_BYTES;
+    return Length;
+}
+
+/*
+ * Receives s_HostMsg, sent by the host in NumWrites writes that end at the
+ * offsets in Ends, the last of them the message length.
+ */
+static NvBootError Receive(const NvU32 *Ends, NvU32 NumWrites)
+{
+    NvU32 i, Start = 0;
+
+    memset(s_Msg, 0, ((NvBootRcmMsg *)s_HostMsg)->LengthInsecure);
+    XusbModelClearStats();
+    for (i = 0; i < NumWrites; i++)
+    {
+        XusbModelHostWrite(s_HostMsg + Start, Ends[i] - Start);
+        Start = Ends[i];
+    }
+    return ReceiveMessage(s_Msg);
+}
+
+static void CheckReceived(NvBootError e, NvU32 Length)
+{
+    const XusbModelStats *pStats = XusbModelGetStats();
+
+    CHECK(e == NvBootError_Success);
+    CHECK(pStats->Errors == 0);
+    CHECK(XusbModelHostPending() == 0);
+    CHECK(pStats->BytesAccepted == Length);
+    CHECK(!memcmp(s_Msg, s_HostMsg, Length));
+}
+
+static void CheckEnumerated(void)
+{
+    CHECK(XUSBDeviceContext.DeviceState == CONFIGURED);
+    CHECK(XUSBDeviceContext.PortSpeed == 3);
+    CHECK(XusbModelGetStats()->Errors == 0);
+}
+
+/* Whole messages in one write, from the shortest to the longest. */
+static void CheckLengths(void)
+{
+    static const NvU32 Payloads[] = {
+        0, 1, 496, 497, 16384, 65536 - 1024, 65536, 65536 + 512, 100000,
+        NVBOOT_RCM_MAX_MSG_LENGTH
+    };
+    NvU32 i, Length;
+
+    SetLink(30000, 0);
+    for (i = 0; i < sizeof(Payloads) / sizeof(Payloads[0]); i++)
+    {
+        Length = MessageLength(Payloads[i]);
+        BuildMessage(Length);
+        CheckReceived(Receive(&Length, 1), Length);
+    }
+}
+
+/*
+ * Random messages in up to four writes. Writes that are not a multiple of
+ * the max packet end in a short packet, inside the header, inside a
+ * 64KB read or on a 16KB boundary; the next write follows at once or after
+ * a gap.
+ *
+ * After a write that ends inside the header, ReceiveMessage() reads up to
+ * HEADER_READ_END in one TRB, which then is not a multiple of the max
+ * packet. A later write that crosses it would overrun the TRB, so the next
+ * write ends there at the latest.
+ */
+static void CheckRandom(void)
+{
+    static const NvU32 Recoveries[] = { 5000, 30000, 125000 };
+    static const NvU32 Gaps[] = { 0, 2000, 50000 };
+    NvU32 Ends[5];
+    NvU32 i, w, NumWrites, Length;
+
+    for (i = 0; i < NUM_RANDOM; i++)
+    {
+        SetLink(Recoveries[Xorshift() % 3], Gaps[Xorshift() % 3]);
+        Length = MessageLength(Xorshift() % NVBOOT_RCM_MAX_MSG_LENGTH);
+        BuildMessage(Length);
+
+        NumWrites = 1 + Xorshift() % 4;
+        for (w = 0; w < NumWrites - 1; w++)
+        {
+            switch (Xorshift() % 3)
+            {
+                case 0:
+                    Ends[w] = 1 + Xorshift() % (Length - 1);
+                    break;
+                case 1:
+                    Ends[w] = 16384 * (1 + Xorshift() % 12);
+                    break;
+                default:
+                    Ends[w] = 1 + Xorshift() % sizeof(NvBootRcmMsg);
+                    break;
+            }
+            if (w && (Ends[w] <= Ends[w - 1]))
+                Ends[w] = Ends[w - 1] + 1;
+            if (w && (Ends[w - 1] < sizeof(NvBootRcmMsg)))
+                Ends[w] = NV_MIN(Ends[w], HEADER_READ_END);
+            if (Ends[w] >= Length)
+                break;
+        }
+        if (w && (Ends[w - 1] < sizeof(NvBootRcmMsg)) &&
+            (Length > HEADER_READ_END))
+            Ends[w++] = HEADER_READ_END;
+        NumWrites = w + 1;
+        Ends[w] = Length;
+
+        CheckReceived(Receive(Ends, NumWrites), Length);
+    }
+}
+
+static int Check(void)
+{
+    CheckEnumerated();
+    CheckLengths();
+    CheckRandom();
+
+    printf("xusb: %u checks, %u failures\n", s_Cases, s_Failures);
+    return s_Failures ? 1 : 0;
+}
+
+static int Bench(const char *Label)
+{
+    static const NvU32 Recoveries[] = { 5000, 30000, 125000 };
+    const XusbModelStats *pStats = XusbModelGetStats();
+    NvU32 r, Length;
+    NvU64 Ns;
+    NvBootError e;
+
+    Length = MessageLength(NVBOOT_RCM_MAX_MSG_LENGTH);
+    BuildMessage(Length);
+
+    printf("%s: %u-byte message in one write, %u MB/s high speed\n",
+           Label, Length, LINK_RATE);
+    printf("  %11s %10s %8s %14s %9s %7s\n", "recovery us", "receive us",
+           "MB/s", "held off us", "doorbells", "events");
+    for (r = 0; r < sizeof(Recoveries) / sizeof(Recoveries[0]); r++)
+    {
+        SetLink(Recoveries[r], 0);
+        e = Receive(&Length, 1);
+        if ((e != NvBootError_Success) || pStats->Errors ||
+            memcmp(s_Msg, s_HostMsg, Length))
+        {
+            fprintf(stderr, "xusb: receive failed\n");
+            return 1;
+        }
+        Ns = XusbModelNow() - pStats->FirstPacketNs;
+        printf("  %11u %10.1f %8.1f %14.1f %9u %7u\n", Recoveries[r] / 1000,
+               Ns / 1000.0, Length * 1000.0 / Ns, pStats->HeldOffNs / 1000.0,
+               pStats->Doorbells, pStats->Events);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    NvBootRCMPort_T *pPort;
+    XusbModelLink Link = { LINK_RATE, MAX_PACKET, 0, 0 };
+
+    HostClockInit();
+    MapIram();
+    XusbModelReset(&Link);
+
+    if ((NvBootRcmSetupPortHandle(RCM_XUSB) != NvBootError_Success) ||
+        ((pPort = NvBootRcmGetPortHandle())->Init() != NvBootError_Success) ||
+        (pPort->Connect(NULL) != NvBootError_Success))
+    {
+        fprintf(stderr, "xusb: enumeration failed\n");
+        return 1;
+    }
+
+    if ((argc > 1) && !strcmp(argv[1], "bench"))
+        return Bench(argc > 2 ? argv[2] : "xusb");
+    return Check();
+}